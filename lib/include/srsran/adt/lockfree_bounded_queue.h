@@ -0,0 +1,200 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_LOCKFREE_BOUNDED_QUEUE_H
+#define SRSRAN_LOCKFREE_BOUNDED_QUEUE_H
+
+#include "srsran/support/srsran_assert.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace srsran {
+
+/**
+ * Bounded queue where producers and consumers never take a lock (D. Vyukov's bounded MPMC algorithm).
+ * - Every cell carries a sequence number telling whether it is free or holds an element for the current lap, so
+ *   producers and consumers only contend on the tail and head indexes, respectively
+ * - Several elements can be pushed with a single reservation of the tail via try_push_batch(...)
+ * - One allocation, done in the constructor or in set_size(...)
+ * - apply_first(...) and try_call_on_front(...) access elements in place, so they must not run concurrently with
+ *   other consumers
+ * @tparam T value type stored by the queue
+ */
+template <typename T>
+class lockfree_bounded_queue
+{
+  struct cell_t {
+    std::atomic<size_t> seq{0};
+    T                   value;
+  };
+
+public:
+  explicit lockfree_bounded_queue(size_t size = 0) { set_size(size); }
+  lockfree_bounded_queue(const lockfree_bounded_queue&) = delete;
+  lockfree_bounded_queue& operator=(const lockfree_bounded_queue&) = delete;
+
+  /// Changes the capacity. It is not thread-safe and requires an empty queue
+  void set_size(size_t size)
+  {
+    srsran_assert(empty(), "Dynamic resizes not supported when queue is not empty");
+    cells.reset(size > 0 ? new cell_t[size] : nullptr);
+    cap = size;
+    for (size_t i = 0; i < cap; ++i) {
+      cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+    head.store(0, std::memory_order_relaxed);
+    tail.store(0, std::memory_order_relaxed);
+  }
+
+  /// Pushes an element if there is space. The element is only moved from on success
+  bool try_push(T&& t) { return try_push_batch(&t, 1) == 1; }
+
+  /// Pushes the first elements of items that fit in the queue, reserving their cells at once
+  /// @return number of elements pushed, which are moved from
+  size_t try_push_batch(T* items, size_t nof_items)
+  {
+    if (cap == 0 or nof_items == 0) {
+      return 0;
+    }
+    size_t pos = tail.load(std::memory_order_relaxed);
+    while (true) {
+      // Count the cells that are free for this lap
+      size_t nof_free = 0;
+      for (; nof_free < nof_items and nof_free < cap; ++nof_free) {
+        size_t seq = cells[(pos + nof_free) % cap].seq.load(std::memory_order_acquire);
+        if (seq != pos + nof_free) {
+          break;
+        }
+      }
+      if (nof_free == 0) {
+        intptr_t diff = (intptr_t)cells[pos % cap].seq.load(std::memory_order_acquire) - (intptr_t)pos;
+        if (diff < 0) {
+          // The cell still holds an element from the previous lap
+          return 0;
+        }
+        // Another producer took this position
+        pos = tail.load(std::memory_order_relaxed);
+        continue;
+      }
+      if (tail.compare_exchange_weak(pos, pos + nof_free, std::memory_order_relaxed)) {
+        for (size_t i = 0; i < nof_free; ++i) {
+          cell_t& cell = cells[(pos + i) % cap];
+          cell.value   = std::move(items[i]);
+          cell.seq.store(pos + i + 1, std::memory_order_release);
+        }
+        return nof_free;
+      }
+    }
+  }
+
+  bool try_pop(T& obj)
+  {
+    if (cap == 0) {
+      return false;
+    }
+    size_t pos = head.load(std::memory_order_relaxed);
+    while (true) {
+      cell_t&  cell = cells[pos % cap];
+      intptr_t diff = (intptr_t)cell.seq.load(std::memory_order_acquire) - (intptr_t)(pos + 1);
+      if (diff == 0) {
+        if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          obj = std::move(cell.value);
+          cell.seq.store(pos + cap, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        // Empty, or the producer of this cell did not finish writing it yet
+        return false;
+      } else {
+        pos = head.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// Calls func on the published elements from the front until it returns true
+  template <typename F>
+  bool apply_first(const F& func)
+  {
+    size_t end = tail.load(std::memory_order_acquire);
+    for (size_t pos = head.load(std::memory_order_relaxed); pos != end; ++pos) {
+      cell_t& cell = cells[pos % cap];
+      if (cell.seq.load(std::memory_order_acquire) != pos + 1) {
+        break;
+      }
+      if (func(cell.value)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <typename F>
+  bool try_call_on_front(const F& func)
+  {
+    if (cap == 0) {
+      return false;
+    }
+    size_t  pos  = head.load(std::memory_order_relaxed);
+    cell_t& cell = cells[pos % cap];
+    if (cell.seq.load(std::memory_order_acquire) != pos + 1) {
+      return false;
+    }
+    func(cell.value);
+    return true;
+  }
+
+  /// Number of reserved cells, including the ones a producer is still writing
+  size_t size() const
+  {
+    size_t h = head.load(std::memory_order_acquire);
+    size_t t = tail.load(std::memory_order_acquire);
+    return t > h ? std::min(t - h, cap) : 0;
+  }
+  bool empty() const { return size() == 0; }
+  /// True if the next push fails. A consumer advances the head before it releases the cell, so the number of reserved
+  /// cells alone could report room that a producer is not yet able to use
+  bool full() const
+  {
+    if (cap == 0) {
+      return true;
+    }
+    size_t pos = tail.load(std::memory_order_acquire);
+    return (intptr_t)cells[pos % cap].seq.load(std::memory_order_acquire) - (intptr_t)pos < 0;
+  }
+  size_t max_size() const { return cap; }
+
+private:
+  // Keep producer and consumer indexes in different cache lines
+  static const size_t cache_line_size = 64;
+
+  std::atomic<size_t>       head{0};
+  char                      pad0[cache_line_size - sizeof(std::atomic<size_t>)];
+  std::atomic<size_t>       tail{0};
+  char                      pad1[cache_line_size - sizeof(std::atomic<size_t>)];
+  size_t                    cap = 0;
+  std::unique_ptr<cell_t[]> cells;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_LOCKFREE_BOUNDED_QUEUE_H
@@ -92,6 +92,9 @@ public:
 
   size_t size() { return allocated_blocks.size(); }
 
+  /// Number of free blocks in the central cache. The blocks kept in the thread local caches are not counted
+  size_t nof_available_blocks() const { return central_mem_cache.size(); }
+
   void* allocate_node(size_t sz)
   {
     srsran_assert(sz <= ObjSize, "Allocated node size=%zd exceeds max object size=%zd", sz, ObjSize);
@@ -99,7 +99,13 @@ public:
 #endif
   }
 
-  uint32_t nof_available_pdus() { return free_list.size(); }
+  uint32_t nof_available_pdus()
+  {
+    pthread_mutex_lock(&mutex);
+    uint32_t nof_available = free_list.size();
+    pthread_mutex_unlock(&mutex);
+    return nof_available;
+  }
 
   bool is_almost_empty() { return free_list.size() < capacity / 20; }
 
@@ -0,0 +1,156 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_BYTE_BUFFER_SLICE_H
+#define SRSRAN_BYTE_BUFFER_SLICE_H
+
+#include "srsran/common/byte_buffer.h"
+#include "srsran/support/srsran_assert.h"
+#include <algorithm>
+#include <atomic>
+
+namespace srsran {
+
+/**
+ * Intrusive reference counter of a buffer whose contents are shared by several byte_buffer_slice objects. The owner
+ * of the buffer gets it back through release_buffer() when the last reference is dropped.
+ */
+class shared_buffer_ref
+{
+public:
+  void add_ref() { nof_refs.fetch_add(1, std::memory_order_relaxed); }
+  void remove_ref()
+  {
+    if (nof_refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      release_buffer();
+    }
+  }
+  uint32_t use_count() const { return nof_refs.load(std::memory_order_relaxed); }
+
+protected:
+  virtual ~shared_buffer_ref() = default;
+  virtual void release_buffer() = 0;
+
+  std::atomic<uint32_t> nof_refs{0};
+};
+
+/**
+ * View of a region of a reference-counted buffer, typically an RLC PDU inside a received transport block. Copying a
+ * slice only takes a new reference, so that upper layers can keep the bytes of a TB without copying them out of it.
+ * A slice built without a reference counter is a plain view of memory owned by the caller, and has to be passed
+ * through retain_slice() to be kept after the call.
+ */
+class byte_buffer_slice
+{
+public:
+  using iterator = uint8_t*;
+
+  byte_buffer_slice() = default;
+  byte_buffer_slice(shared_buffer_ref* ref_, uint8_t* ptr_, uint32_t len_) : ref(ref_), ptr(ptr_), len(len_)
+  {
+    if (ref != nullptr) {
+      ref->add_ref();
+    }
+  }
+  byte_buffer_slice(const byte_buffer_slice& other) : byte_buffer_slice(other.ref, other.ptr, other.len) {}
+  byte_buffer_slice(byte_buffer_slice&& other) noexcept : ref(other.ref), ptr(other.ptr), len(other.len)
+  {
+    other.ref = nullptr;
+    other.ptr = nullptr;
+    other.len = 0;
+  }
+  ~byte_buffer_slice() { reset(); }
+
+  byte_buffer_slice& operator=(const byte_buffer_slice& other)
+  {
+    if (&other != this) {
+      *this = byte_buffer_slice(other);
+    }
+    return *this;
+  }
+  byte_buffer_slice& operator=(byte_buffer_slice&& other) noexcept
+  {
+    if (&other != this) {
+      reset();
+      std::swap(ref, other.ref);
+      std::swap(ptr, other.ptr);
+      std::swap(len, other.len);
+    }
+    return *this;
+  }
+
+  /// Drops the reference to the buffer
+  void reset()
+  {
+    if (ref != nullptr) {
+      ref->remove_ref();
+    }
+    ref = nullptr;
+    ptr = nullptr;
+    len = 0;
+  }
+
+  /// Returns a slice of nof_bytes starting at offset, sharing the same buffer
+  byte_buffer_slice subslice(uint32_t offset, uint32_t nof_bytes) const
+  {
+    srsran_assert(
+        offset + nof_bytes <= len, "Invalid subslice of %d B at offset %d of a %d B slice", nof_bytes, offset, len);
+    return byte_buffer_slice(ref, ptr + offset, nof_bytes);
+  }
+
+  /// Removes the first nof_bytes of the slice, e.g. a header that has already been processed
+  void advance(uint32_t nof_bytes)
+  {
+    nof_bytes = std::min(nof_bytes, len);
+    ptr += nof_bytes;
+    len -= nof_bytes;
+  }
+
+  /// Whether the slice keeps its buffer alive
+  bool is_shared() const { return ref != nullptr; }
+
+  uint8_t* data() const { return ptr; }
+  uint32_t size() const { return len; }
+  bool     empty() const { return len == 0; }
+  iterator begin() const { return ptr; }
+  iterator end() const { return ptr + len; }
+
+private:
+  shared_buffer_ref* ref = nullptr;
+  uint8_t*           ptr = nullptr;
+  uint32_t           len = 0;
+};
+
+/**
+ * Makes a byte buffer shareable by slices, without copying its contents. The returned slice spans the whole buffer,
+ * which is returned to the byte buffer pool once the slice and all the slices taken from it are destroyed.
+ */
+byte_buffer_slice make_shared_slice(unique_byte_buffer_t buf);
+
+/**
+ * Returns a slice that can be kept after the caller returns: the slice itself if it is shared, or otherwise a copy of
+ * its contents in a new byte buffer. The returned slice is empty if the copy cannot be allocated.
+ */
+byte_buffer_slice retain_slice(byte_buffer_slice slice);
+
+} // namespace srsran
+
+#endif // SRSRAN_BYTE_BUFFER_SLICE_H
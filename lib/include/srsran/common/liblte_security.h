@@ -329,6 +329,33 @@ liblte_security_milenage_f1_star(uint8* k, uint8* op, uint8* rand, uint8* sqn, u
 LIBLTE_ERROR_ENUM
 liblte_security_milenage_f2345(uint8* k, uint8* op, uint8* rand, uint8* res, uint8* ck, uint8* ik, uint8* ak);
 
+/*********************************************************************
+    Name: liblte_security_milenage_f12345
+
+    Description: Milenage security functions F1, F2, F3, F4, and F5
+                 for a batch of authentication vectors sharing the
+                 same key K. RAND, SQN and the outputs are packed
+                 one vector after the other.
+
+    Document Reference: 35.206 v10.0.0 Annex 3
+*********************************************************************/
+// Defines
+#define LIBLTE_SECURITY_MILENAGE_MAX_BATCH 32
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_security_milenage_f12345(uint8* k,
+                                                  uint8* op_c,
+                                                  uint32 nof_vectors,
+                                                  uint8* rand,
+                                                  uint8* sqn,
+                                                  uint8* amf,
+                                                  uint8* mac_a,
+                                                  uint8* res,
+                                                  uint8* ck,
+                                                  uint8* ik,
+                                                  uint8* ak);
+
 /*********************************************************************
     Name: liblte_security_milenage_f5_star
 
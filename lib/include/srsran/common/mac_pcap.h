@@ -24,6 +24,7 @@
 
 #include "srsran/common/common.h"
 #include "srsran/common/mac_pcap_base.h"
+#include "srsran/common/pcap_file_writer.h"
 #include "srsran/srsran.h"
 
 namespace srsran {
@@ -32,15 +33,15 @@ class mac_pcap : public mac_pcap_base
 public:
   mac_pcap();
   ~mac_pcap();
-  uint32_t open(std::string filename, uint32_t ue_id = 0);
+  uint32_t open(std::string filename, uint32_t ue_id = 0, const pcap_file_args_t& args = {});
   uint32_t close();
 
 private:
-  void write_pdu(srsran::mac_pcap_base::pcap_pdu_t& pdu);
+  bool write_pdu(srsran::mac_pcap_base::pcap_pdu_t& pdu);
 
-  FILE*       pcap_file = nullptr;
-  uint32_t    dlt       = 0; // The DLT used for the PCAP file
-  std::string filename;
+  pcap_file_writer pcap_file;
+  uint32_t         dlt = 0; // The DLT used for the PCAP file
+  std::string      filename;
 };
 } // namespace srsran
 
@@ -22,17 +22,25 @@
 #ifndef SRSRAN_MAC_PCAP_BASE_H
 #define SRSRAN_MAC_PCAP_BASE_H
 
-#include "srsran/adt/circular_buffer.h"
+#include "srsran/adt/lockfree_bounded_queue.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/common/pcap.h"
+#include "srsran/common/pcap_metrics.h"
 #include "srsran/common/threads.h"
 #include "srsran/srslog/srslog.h"
+#include <condition_variable>
 #include <mutex>
 #include <stdint.h>
+#include <sys/time.h>
 #include <thread>
 
 namespace srsran {
+
+/**
+ * Base class of the MAC PCAP writers. The PDUs are copied into a lock-free queue by the PHY/MAC threads, and
+ * the writer thread drains it in batches, taking the writer lock once per batch
+ */
 class mac_pcap_base : protected srsran::thread
 {
 public:
@@ -49,6 +57,11 @@ public:
 
   void set_ue_id(uint16_t ue_id);
 
+  /// Limits the bytes of each PDU copied into the capture, e.g. to keep only the MAC headers. 0 keeps the full PDU
+  void set_max_payload_len(uint32_t max_payload_len);
+
+  void get_metrics(pcap_metrics_t& metrics) const;
+
   // EUTRA
   void
   write_ul_crnti(uint8_t* pdu, uint32_t pdu_len_bytes, uint16_t crnti, uint32_t reTX, uint32_t tti, uint8_t cc_idx);
@@ -102,20 +115,42 @@ protected:
     srsran::srsran_rat_t  rat;
     MAC_Context_Info_t    context;
     mac_nr_context_info_t context_nr;
+    timeval               ts;
+    uint32_t              orig_len; // PDU length before truncation
     unique_byte_buffer_t  pdu;
   } pcap_pdu_t;
 
-  virtual void write_pdu(pcap_pdu_t& pdu) = 0;
+  /// Writes a PDU to the capture, returns false if it could not be written
+  virtual bool write_pdu(pcap_pdu_t& pdu) = 0;
   void         run_thread() final;
-
-  std::mutex                              mutex;
-  srslog::basic_logger&                   logger;
-  std::atomic<bool>                       running = {false};
-  static_blocking_queue<pcap_pdu_t, 1024> queue;
-  uint16_t                                ue_id                = 0;
-  int                                     emergency_handler_id = -1;
+  /// Wakes up the writer thread if it is waiting for PDUs
+  void wake_up_writer();
+
+  static const uint32_t queue_size     = 4096;
+  static const uint32_t max_batch_size = 256;
+  /// Bounds the wait of the writer thread, in case a wake-up races with it going to sleep
+  static const uint32_t max_wait_ms = 10;
+
+  std::mutex                         mutex;
+  srslog::basic_logger&              logger;
+  std::atomic<bool>                  running = {false};
+  lockfree_bounded_queue<pcap_pdu_t> queue;
+  uint16_t                           ue_id                = 0;
+  int                                emergency_handler_id = -1;
+  std::atomic<uint32_t>              max_payload_len      = {0};
+
+  // the writer thread sleeps while the queue is empty
+  std::mutex              writer_mutex;
+  std::condition_variable writer_cvar;
+  std::atomic<bool>       writer_waiting = {false};
+
+  // metrics
+  std::atomic<uint64_t> nof_written_pdus  = {0};
+  std::atomic<uint64_t> nof_written_bytes = {0};
+  std::atomic<uint64_t> nof_dropped_pdus  = {0};
 
 private:
+  bool alloc_and_queue(pcap_pdu_t& pdu, const uint8_t* payload, uint32_t payload_len);
   void pack_and_queue(uint8_t* payload,
                       uint32_t payload_len,
                       uint16_t ue_id,
@@ -41,9 +41,9 @@ public:
   uint32_t close();
 
 private:
-  void write_pdu(srsran::mac_pcap_base::pcap_pdu_t& pdu);
-  void write_mac_lte_pdu_to_net(srsran::mac_pcap_base::pcap_pdu_t& pdu);
-  void write_mac_nr_pdu_to_net(srsran::mac_pcap_base::pcap_pdu_t& pdu);
+  bool write_pdu(srsran::mac_pcap_base::pcap_pdu_t& pdu);
+  bool write_mac_lte_pdu_to_net(srsran::mac_pcap_base::pcap_pdu_t& pdu);
+  bool write_mac_nr_pdu_to_net(srsran::mac_pcap_base::pcap_pdu_t& pdu);
 
   srsran::unique_socket socket;
   struct sockaddr_in    client_addr;
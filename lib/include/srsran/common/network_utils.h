@@ -128,9 +128,10 @@ protected:
 };
 
 /**
- * Description - Instantiates a thread that will block waiting for IO from multiple sockets, via a select
+ * Description - Instantiates a thread that will block waiting for IO from multiple sockets, via epoll
  *               The user can register their own (socket fd, data handler) in this class via the
- *               add_socket_handler(fd, task) API or its other variants
+ *               add_socket_handler(fd, task) API or its other variants. Each wakeup only visits the
+ *               sockets with pending data, and there is no limit in the fd values or number of sockets
  */
 class socket_manager final : public thread, public socket_manager_itf
 {
@@ -148,9 +149,10 @@ public:
   void run_thread() override;
 
 private:
-  const int thread_prio = 65;
+  const int        thread_prio   = 65;
+  static const int max_rx_events = 64;
 
-  // used to unlock select
+  // used to unlock epoll_wait
   struct ctrl_cmd_t {
     enum class cmd_id_t { EXIT, NEW_FD, RM_FD };
     cmd_id_t cmd;
@@ -158,13 +160,14 @@ private:
     bool     signal_rm_complete;
     ctrl_cmd_t() { bzero(this, sizeof(ctrl_cmd_t)); }
   };
-  std::map<int, recv_callback_t>::iterator remove_socket_unprotected(int fd, fd_set* total_fd_set, int* max_fd);
+  void remove_socket_unprotected(int fd);
 
   // state
   std::mutex                     socket_mutex;
   std::map<int, recv_callback_t> active_sockets;
   std::atomic<bool>              running   = {false};
   int                            pipefd[2] = {-1, -1};
+  int                            epoll_fd  = -1;
   std::vector<int>               rem_fd_tmp_list;
   std::condition_variable        rem_cvar;
 };
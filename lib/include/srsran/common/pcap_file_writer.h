@@ -0,0 +1,94 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_PCAP_FILE_WRITER_H
+#define SRSRAN_PCAP_FILE_WRITER_H
+
+#include "srsran/common/pcap.h"
+#include <chrono>
+#include <string>
+#include <sys/time.h>
+
+namespace srsran {
+
+/// Parameters of the capture files
+struct pcap_file_args_t {
+  uint32_t max_file_size_mb  = 0; ///< The file is rotated when it reaches this size. 0 disables it
+  uint32_t rotation_period_s = 0; ///< The file is rotated after this time. 0 disables it
+  uint32_t max_payload_len   = 0; ///< Bytes of each PDU kept in the capture. 0 keeps the full PDU
+};
+
+/**
+ * PCAP file writer that copies the packet records into memory mapped segments of the output file, so that
+ * writing a batch of packets does not require any system call until a segment is full.
+ * The first file takes the given name, and the files opened on rotation add a counter before the extension,
+ * e.g. enb_mac.1.pcap. The blocks of each segment are reserved before it is mapped, and the file is closed when they
+ * cannot be, e.g. with a full disk. It is not thread-safe.
+ */
+class pcap_file_writer
+{
+public:
+  pcap_file_writer() = default;
+  ~pcap_file_writer() { close(); }
+  pcap_file_writer(const pcap_file_writer&) = delete;
+  pcap_file_writer& operator=(const pcap_file_writer&) = delete;
+
+  bool open(const std::string& filename, uint32_t dlt, const pcap_file_args_t& args = {});
+  void close();
+  bool is_open() const { return fd >= 0; }
+
+  /// Writes one packet made of the pseudo header and the payload
+  /// @param orig_payload_len payload length before it was truncated by the producer
+  bool write_packet(const timeval& ts,
+                    const uint8_t* header,
+                    uint32_t       header_len,
+                    const uint8_t* payload,
+                    uint32_t       payload_len,
+                    uint32_t       orig_payload_len);
+
+  uint32_t    get_nof_files() const { return file_idx + (is_open() ? 1 : 0); }
+  std::string get_filename() const { return make_filename(file_idx); }
+
+private:
+  static const size_t segment_size = 4 * 1024 * 1024;
+
+  std::string make_filename(uint32_t idx) const;
+  bool        open_file();
+  void        close_file();
+  bool        map_segment(size_t offset);
+  bool        append(const void* data, size_t len);
+
+  std::string      base_filename;
+  uint32_t         dlt = 0;
+  pcap_file_args_t args;
+
+  int      fd        = -1;
+  uint32_t file_idx  = 0;
+  size_t   file_len  = 0;       ///< bytes written to the current file
+  uint8_t* segment   = nullptr; ///< mapped region of the file starting at seg_start
+  size_t   seg_start = 0;
+
+  std::chrono::steady_clock::time_point file_start;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_PCAP_FILE_WRITER_H
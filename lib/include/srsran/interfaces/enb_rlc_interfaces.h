@@ -23,6 +23,7 @@
 #define SRSRAN_ENB_RLC_INTERFACES_H
 
 #include "srsran/common/byte_buffer.h"
+#include "srsran/common/byte_buffer_slice.h"
 #include "srsran/interfaces/rlc_interface_types.h"
 
 namespace srsenb {
@@ -38,6 +39,9 @@ public:
   /* MAC calls RLC to push an RLC PDU. This function is called from an independent MAC thread.
    * PDU gets placed into the buffer and higher layer thread gets notified. */
   virtual void write_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes) = 0;
+
+  /* Same as write_pdu(), with the PDU as a slice of the received TB, which RLC can keep without copying it. */
+  virtual void write_pdu_slice(uint16_t rnti, uint32_t lcid, srsran::byte_buffer_slice pdu) = 0;
 };
 
 // RLC interface for PDCP
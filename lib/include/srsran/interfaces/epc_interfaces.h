@@ -118,13 +118,13 @@ public:
   virtual bool delete_gtpc_tunnel(in_addr_t ue_ipv4)                                                              = 0;
   virtual void send_all_queued_packets(srsran::gtp_fteid_t                       dw_user_fteid,
                                        std::queue<srsran::unique_byte_buffer_t>& pkt_queue)                       = 0;
+  virtual bool send_downlink_pdu(in_addr_t ue_ipv4, srsran::byte_buffer_t* msg)                                   = 0;
 };
 
 class gtpc_interface_gtpu // GTP-U -> GTP-C
 {
 public:
-  virtual bool queue_downlink_packet(uint32_t spgw_ctr_teid, srsran::unique_byte_buffer_t msg) = 0;
-  virtual bool send_downlink_data_notification(uint32_t spgw_ctr_teid)                         = 0;
+  virtual void handle_idle_ue_downlink_packet(uint32_t spgw_ctr_teid, srsran::unique_byte_buffer_t msg) = 0;
 };
 
 } // namespace srsepc
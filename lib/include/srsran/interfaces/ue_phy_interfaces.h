@@ -104,6 +104,7 @@ struct phy_args_t {
   uint32_t    intra_freq_meas_period_ms    = 200;
   float       force_ul_amplitude           = 0.0f;
   bool        detect_cp                    = false;
+  bool        cell_search_single_pass      = false;
 
   bool nr_store_pdsch_ko = false;
 
@@ -22,6 +22,7 @@
 #ifndef SRSRAN_UE_RLC_INTERFACES_H
 #define SRSRAN_UE_RLC_INTERFACES_H
 
+#include "srsran/common/byte_buffer_slice.h"
 #include "srsran/common/interfaces_common.h"
 #include "srsran/interfaces/rlc_interface_types.h"
 
@@ -87,6 +88,9 @@ public:
   virtual void write_pdu_bcch_dlsch(uint8_t* payload, uint32_t nof_bytes)         = 0;
   virtual void write_pdu_pcch(srsran::unique_byte_buffer_t payload)               = 0;
   virtual void write_pdu_mch(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes) = 0;
+
+  /* Same as write_pdu(), with the PDU as a slice of the received TB, which RLC can keep without copying it. */
+  virtual void write_pdu_slice(uint32_t lcid, srsran::byte_buffer_slice pdu) = 0;
 };
 
 } // namespace srsue
@@ -24,6 +24,7 @@
 
 #include "srsran/common/byte_buffer.h"
 #include "srsran/common/common.h"
+#include "srsran/common/interfaces_common.h"
 #include "srsran/config.h"
 #include "srsran/srslog/srslog.h"
 #include <memory>
@@ -221,6 +222,10 @@ public:
   uint32_t add_lbsr_ce(const std::array<mac_sch_subpdu_nr::lcg_bsr_t, mac_sch_subpdu_nr::max_num_lcg_lbsr> bsr_);
   uint32_t add_ue_con_res_id_ce(const mac_sch_subpdu_nr::ue_con_res_id_t id);
 
+  // Reads an SDU of up to requested_bytes from sdu_itf straight into the PDU buffer, after its subheader.
+  // Returns the SDU length, 0 if there was nothing to read or SRSRAN_ERROR otherwise
+  int add_sdu(const uint32_t lcid_, const uint32_t requested_bytes_, read_pdu_interface* sdu_itf_);
+
   uint32_t get_remaing_len();
 
   void to_string(fmt::memory_buffer& buffer);
@@ -25,6 +25,7 @@
 #include "srsran/adt/circular_buffer.h"
 #include "srsran/common/block_queue.h"
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/byte_buffer_slice.h"
 #include "srsran/common/timers.h"
 #include "srsran/mac/pdu.h"
 
@@ -49,6 +50,10 @@ public:
   void     deallocate(const uint8_t* pdu);
   void     push(const uint8_t* ptr, uint32_t len, channel_t channel = DCH, int ul_nof_prbs = -1);
 
+  // Returns a slice of nof_bytes at ptr inside a requested PDU. The PDU buffer is not returned to the pool until it
+  // has been deallocated and all its slices have been destroyed.
+  byte_buffer_slice make_slice(const uint8_t* pdu, uint8_t* ptr, uint32_t nof_bytes);
+
   bool process_pdus();
 
   void reset();
@@ -57,16 +62,38 @@ private:
   const static int DEFAULT_POOL_SIZE = 128;            // Number of PDU buffers in total
   const static int MAX_PDU_LEN       = 150 * 1024 / 8; // ~ 150 Mbps
 
-  typedef struct {
+  struct pdu_t;
+
+  // Reference count of a PDU buffer. The MAC holds one reference from request() to deallocate()
+  class pdu_ref final : public shared_buffer_ref
+  {
+  public:
+    void init(pdu_queue* parent_, pdu_t* pdu_)
+    {
+      parent = parent_;
+      pdu    = pdu_;
+      nof_refs.store(1, std::memory_order_relaxed);
+    }
+
+  private:
+    void release_buffer() override { parent->release(pdu); }
+
+    pdu_queue* parent = nullptr;
+    pdu_t*     pdu    = nullptr;
+  };
+
+  struct pdu_t {
     uint8_t   ptr[MAX_PDU_LEN];
     uint32_t  len;
     channel_t channel;
     int       grant_nof_prbs;
+    pdu_ref   ref;
 #ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
     char debug_name[128];
 #endif
+  };
 
-  } pdu_t;
+  void release(pdu_t* pdu);
 
   buffer_pool<pdu_t>                               pool;
   static_blocking_queue<pdu_t*, DEFAULT_POOL_SIZE> pdu_q;
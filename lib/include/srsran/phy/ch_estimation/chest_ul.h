@@ -109,6 +109,16 @@ SRSRAN_API int srsran_chest_ul_estimate_pusch(srsran_chest_ul_t*     q,
                                               cf_t*                  input,
                                               srsran_chest_ul_res_t* res);
 
+/* Estimates the PUSCH channel from the DMRS of the slots up to slot_idx, the later slots do not need to be received.
+ * The estimates of the first slot only use its own DMRS, so its data can be demodulated while the second slot is being
+ * received. The estimates of the last slot are the ones of srsran_chest_ul_estimate_pusch(). */
+SRSRAN_API int srsran_chest_ul_estimate_pusch_slot(srsran_chest_ul_t*     q,
+                                                   srsran_ul_sf_cfg_t*    sf,
+                                                   srsran_pusch_cfg_t*    cfg,
+                                                   cf_t*                  input,
+                                                   uint32_t               slot_idx,
+                                                   srsran_chest_ul_res_t* res);
+
 SRSRAN_API int srsran_chest_ul_estimate_pucch(srsran_chest_ul_t*     q,
                                               srsran_ul_sf_cfg_t*    sf,
                                               srsran_pucch_cfg_t*    cfg,
@@ -78,6 +78,14 @@ typedef struct SRSRAN_API {
   /// Channel estimates, size coreset_sz
   cf_t* ce;
 
+  /// Number of CCE in the CORESET and the RBs of every CCE, the REG bundles of a CCE span all the CORESET symbols
+  uint32_t nof_cce;
+  uint32_t cce_nof_rb[SRSRAN_CORESET_MAX_NOF_CCE];
+  uint16_t cce_rb[SRSRAN_CORESET_MAX_NOF_CCE][6];
+
+  /// Pilots power of every CCE, candidates without power are discarded from it
+  float cce_power[SRSRAN_CORESET_MAX_NOF_CCE];
+
   /// Frequency domain smoothing filter
   float*   filter;
   uint32_t filter_len;
@@ -173,6 +181,21 @@ SRSRAN_API int srsran_dmrs_pdcch_get_measure(const srsran_dmrs_pdcch_estimator_t
                                              const srsran_dci_location_t*         location,
                                              srsran_dmrs_pdcch_measure_t*         measure);
 
+/**
+ * @brief Computes the PDCCH DMRS EPRE of a given DCI location from the pilots power of every CCE
+ *
+ * It gives the same EPRE as srsran_dmrs_pdcch_get_measure() at a fraction of its cost, so it is suitable for
+ * discarding empty candidates before measuring them.
+ *
+ * @param[in] q provides PDCCH DMRS estimator object
+ * @param[in] location Provides the aggregation level and CCE resource
+ * @param[out] epre_dBfs Energy per resource element in dBfs
+ * @return SRSRAN_SUCCESS if the configurations are valid, otherwise it returns an SRSRAN_ERROR code
+ */
+SRSRAN_API int srsran_dmrs_pdcch_get_epre(const srsran_dmrs_pdcch_estimator_t* q,
+                                          const srsran_dci_location_t*         location,
+                                          float*                               epre_dBfs);
+
 /**
  * @brief Extracts PDCCH DMRS channel estimates of a given PDCCH candidate for an aggregation level
  *
@@ -0,0 +1,99 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**********************************************************************************************
+ *  File:         wiener_ul.h
+ *
+ *  Description:  Frequency domain Wiener (MMSE) filter for the LTE uplink DMRS.
+ *                Each subcarrier is estimated from a window of adjacent least square pilot
+ *                estimates. The filter coefficients only depend on the window length, which is
+ *                given by the allocation size, and on the SNR, so they are computed for a set of
+ *                SNR bins during the initialization and no matrix inversion is done at runtime.
+ *                The estimators share a single filter bank for the default delay spread.
+ *                The filters assume a uniform power delay profile centered at zero delay, so the
+ *                caller shall remove the mean delay (i.e. timing error) of the estimates first.
+ *
+ *  Reference:
+ *********************************************************************************************/
+
+#ifndef SRSRAN_WIENER_UL_H
+#define SRSRAN_WIENER_UL_H
+
+#include "srsran/config.h"
+#include "srsran/phy/common/phy_common.h"
+
+// Maximum filter window length in subcarriers, allocations of a single PRB use a window of SRSRAN_NRE
+#define SRSRAN_WIENER_UL_MAX_TAPS (2U * SRSRAN_NRE)
+#define SRSRAN_WIENER_UL_NOF_WINDOWS (SRSRAN_WIENER_UL_MAX_TAPS / SRSRAN_NRE)
+
+// SNR bins the filters are designed for: SRSRAN_WIENER_UL_SNR_MIN_DB + i * SRSRAN_WIENER_UL_SNR_STEP_DB
+#define SRSRAN_WIENER_UL_NOF_SNR_BINS (8U)
+#define SRSRAN_WIENER_UL_SNR_MIN_DB (-5.0f)
+#define SRSRAN_WIENER_UL_SNR_STEP_DB (5.0f)
+
+// Default delay spread the filters are designed for, 1.5 times the normal cyclic prefix length. The profile is not
+// symmetric after removing the mean delay, so it needs some margin on either side
+#define SRSRAN_WIENER_UL_DEFAULT_DELAY_SPREAD_US (7.0f)
+
+typedef struct {
+  uint32_t nof_taps; // Window length in subcarriers
+  // Row d holds the coefficients estimating the subcarrier at offset d of the window
+  cf_t filter[SRSRAN_WIENER_UL_MAX_TAPS][SRSRAN_WIENER_UL_MAX_TAPS];
+} srsran_wiener_ul_filter_t;
+
+typedef struct {
+  float                     delay_spread_us;
+  srsran_wiener_ul_filter_t filters[SRSRAN_WIENER_UL_NOF_SNR_BINS][SRSRAN_WIENER_UL_NOF_WINDOWS];
+} srsran_wiener_ul_t;
+
+/**
+ * @brief Initialises the filter bank, computing the Wiener filters for every window length and SNR bin
+ * @param q Object
+ * @param delay_spread_us Length of the uniform power delay profile the filters are designed for
+ * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_wiener_ul_init(srsran_wiener_ul_t* q, float delay_spread_us);
+
+/**
+ * @brief Gets the filter bank for SRSRAN_WIENER_UL_DEFAULT_DELAY_SPREAD_US, shared by all the estimators. It is
+ * computed once, by the first caller
+ * @return The shared filter bank, NULL if it could not be computed
+ */
+SRSRAN_API const srsran_wiener_ul_t* srsran_wiener_ul_get_default(void);
+
+/**
+ * @brief Filters the least square estimates of a contiguous allocation
+ * @param q Object
+ * @param pilots Least square estimates, one per subcarrier, without mean delay
+ * @param estimated Filtered estimates, it must not overlap with pilots
+ * @param nof_re Number of subcarriers of the allocation, it must be a multiple of SRSRAN_NRE
+ * @param snr_lin Linear SNR of the estimates, selects the filter SNR bin
+ * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_wiener_ul_run(const srsran_wiener_ul_t* q,
+                                    const cf_t*               pilots,
+                                    cf_t*                     estimated,
+                                    uint32_t                  nof_re,
+                                    float                     snr_lin);
+
+SRSRAN_API void srsran_wiener_ul_free(srsran_wiener_ul_t* q);
+
+#endif // SRSRAN_WIENER_UL_H
@@ -49,6 +49,8 @@ public:
     // Fading options
     bool        fading_enable = false;
     std::string fading_model  = "none";
+    std::string fading_corr   = "none";
+    bool        fading_uplink = false; ///< The eNodeB receives, it selects the side of the correlation coefficients
 
     // High Speed Train options
     bool  hst_enable      = false;
@@ -69,25 +71,31 @@ public:
     uint32_t rlf_t_off_ms = 2000;
   };
 
-  channel(const args_t& channel_args, uint32_t _nof_channels, srslog::basic_logger& logger);
+  channel(const args_t& channel_args, uint32_t _nof_channels, srslog::basic_logger& logger, uint32_t _nof_ports = 1);
   ~channel();
   void set_srate(uint32_t srate);
   void set_signal_power_dBfs(float power_dBfs);
   void run(cf_t* in[SRSRAN_MAX_CHANNELS], cf_t* out[SRSRAN_MAX_CHANNELS], uint32_t len, const srsran_timestamp_t& t);
 
 private:
-  srslog::basic_logger&    logger;
-  float                    hst_init_phase              = 0.0f;
-  srsran_channel_fading_t* fading[SRSRAN_MAX_CHANNELS] = {};
-  srsran_channel_delay_t*  delay[SRSRAN_MAX_CHANNELS]  = {};
-  srsran_channel_awgn_t*   awgn                        = nullptr;
-  srsran_channel_hst_t*    hst                         = nullptr;
-  srsran_channel_rlf_t*    rlf                         = nullptr;
-  cf_t*                    buffer_in                   = nullptr;
-  cf_t*                    buffer_out                  = nullptr;
-  uint32_t                 nof_channels                = 0;
-  uint32_t                 current_srate               = 0;
-  args_t                   args                        = {};
+  void run_pre_fading(uint32_t len, const srsran_timestamp_t& t);
+  void run_post_fading(uint32_t i, uint32_t len, const srsran_timestamp_t& t);
+
+  srslog::basic_logger&         logger;
+  float                         hst_init_phase                   = 0.0f;
+  srsran_channel_fading_t*      fading[SRSRAN_MAX_CHANNELS]      = {};
+  srsran_channel_fading_mimo_t* fading_mimo[SRSRAN_MAX_CHANNELS] = {}; ///< One per group of nof_ports channels
+  srsran_channel_delay_t*       delay[SRSRAN_MAX_CHANNELS]       = {};
+  srsran_channel_awgn_t*        awgn                             = nullptr;
+  srsran_channel_hst_t*         hst                              = nullptr;
+  srsran_channel_rlf_t*         rlf                              = nullptr;
+  cf_t*                         buffer_in                        = nullptr;
+  cf_t*                         buffer_out                       = nullptr;
+  cf_t*                         buffer_mimo[SRSRAN_MAX_CHANNELS] = {};
+  uint32_t                      nof_channels                     = 0;
+  uint32_t                      nof_ports                        = 1;
+  uint32_t                      current_srate                    = 0;
+  args_t                        args                             = {};
 };
 
 typedef std::unique_ptr<channel> channel_ptr;
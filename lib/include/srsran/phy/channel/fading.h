@@ -26,10 +26,13 @@
 #include "srsran/phy/common/timestamp.h"
 #include "srsran/phy/dft/dft.h"
 #include <inttypes.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 #define SRSRAN_CHANNEL_FADING_MAXTAPS 9
 #define SRSRAN_CHANNEL_FADING_NTERMS 16
+#define SRSRAN_CHANNEL_FADING_MIMO_MAX_ANT 4
+#define SRSRAN_CHANNEL_FADING_MIMO_MAX_PATHS (SRSRAN_CHANNEL_FADING_MIMO_MAX_ANT * SRSRAN_CHANNEL_FADING_MIMO_MAX_ANT)
 
 typedef enum {
   srsran_channel_fading_model_none = 0,
@@ -66,6 +69,67 @@ typedef struct {
   cf_t* state; // To save impulse response of the filter
 } srsran_channel_fading_t;
 
+/*
+ * Spatial correlation levels as defined in TS 36.101 Annex B.2.3.1
+ */
+typedef enum {
+  srsran_channel_fading_corr_none = 0,
+  srsran_channel_fading_corr_low,
+  srsran_channel_fading_corr_medium,
+  srsran_channel_fading_corr_high,
+} srsran_channel_fading_corr_t;
+
+typedef struct {
+  // Configuration parameters
+  float                         srate;     // Sampling rate
+  srsran_channel_fading_model_t model;     // None, EPA, EVA, ETU
+  float                         doppler;   // Maximum doppler
+  srsran_channel_fading_corr_t  corr;      // Spatial correlation level
+  bool                          uplink;    // The UE transmits, the eNodeB correlation applies to the receive side
+  uint32_t                      nof_tx;    // Number of transmit antennas
+  uint32_t                      nof_rx;    // Number of receive antennas
+  uint32_t                      nof_paths; // Number of Tx x Rx paths, path index is tx * nof_rx + rx
+
+  // Internal tap parametrisation
+  uint32_t N;          // FFT size
+  uint32_t path_delay; // Path delay
+  uint32_t nof_taps;   // Number of taps of the model
+  uint32_t update_len; // Number of samples between tap updates (N / 2)
+  uint32_t nof_coeff;  // Number of Jakes terms for all taps and paths (nof_taps x nof_paths x NTERMS)
+
+  float corr_sqrt[SRSRAN_CHANNEL_FADING_MIMO_MAX_PATHS][SRSRAN_CHANNEL_FADING_MIMO_MAX_PATHS]; // Cholesky factor
+
+  // Jakes terms, layout [tap][path][term]. Each term is kept as a rotating phasor
+  float* phasor_a_re; // Real part terms, exp(j(w * t + a)), real part
+  float* phasor_a_im; // Real part terms, exp(j(w * t + a)), imaginary part
+  float* phasor_b_re; // Imaginary part terms, exp(j(w * t + b)), real part
+  float* phasor_b_im; // Imaginary part terms, exp(j(w * t + b)), imaginary part
+  float* rot_re;      // Rotation for one update period, exp(j * w * update_len / srate), real part
+  float* rot_im;      // Rotation for one update period, exp(j * w * update_len / srate), imaginary part
+  float* omega;       // Angular doppler frequency of each term
+  float* coeff_a;     // Random phase
+  float* coeff_b;     // Random phase
+
+  // Tap gains, layout [tap][path]
+  cf_t gain[SRSRAN_CHANNEL_FADING_MAXTAPS][SRSRAN_CHANNEL_FADING_MIMO_MAX_PATHS];
+
+  cf_t* h_tap[SRSRAN_CHANNEL_FADING_MAXTAPS];         // Static tap signal in frequency domain
+  cf_t* h_freq[SRSRAN_CHANNEL_FADING_MIMO_MAX_PATHS]; // Frequency response for each path
+
+  // Utils
+  srsran_dft_plan_t fft;                                      // DFT to frequency domain
+  srsran_dft_plan_t ifft;                                     // DFT to time domain
+  cf_t*             x_freq[SRSRAN_CHANNEL_FADING_MIMO_MAX_ANT]; // Frequency domain input for each transmit antenna
+  cf_t*             y_freq;                                   // Frequency domain output accumulator
+  cf_t*             temp;                                     // Temporal buffer, length fft_size
+
+  // State variables
+  cf_t*    window[SRSRAN_CHANNEL_FADING_MIMO_MAX_ANT]; // Overlap-save input window for each transmit antenna
+  uint64_t update_idx;                                 // Index of the current tap update
+  uint32_t nof_rotations;                              // Phasor rotations since the last exact evaluation
+  bool     taps_valid;                                 // Indicates if the tap gains are computed for update_idx
+} srsran_channel_fading_mimo_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -80,6 +144,46 @@ SRSRAN_API double srsran_channel_fading_execute(srsran_channel_fading_t* q,
                                                 uint32_t                 nof_samples,
                                                 double                   init_time);
 
+/**
+ * @brief Initialises a multiple antenna fading channel emulator. All Tx x Rx paths share the same delay profile and
+ * are spatially correlated using the Kronecker model from TS 36.101 Annex B.2.3
+ * @param q Object
+ * @param srate Sampling rate in Hz
+ * @param model Fading model + maximum doppler (E.g. none, epa5, eva70, etu300, etc)
+ * @param corr Spatial correlation: none, low, medium or high
+ * @param uplink Set if the UE transmits and the eNodeB receives, it selects the side of each correlation coefficient
+ * @param nof_tx Number of transmit antennas
+ * @param nof_rx Number of receive antennas
+ * @param seed Random generator seed
+ * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_channel_fading_mimo_init(srsran_channel_fading_mimo_t* q,
+                                               double                        srate,
+                                               const char*                   model,
+                                               const char*                   corr,
+                                               bool                          uplink,
+                                               uint32_t                      nof_tx,
+                                               uint32_t                      nof_rx,
+                                               uint32_t                      seed);
+
+SRSRAN_API void srsran_channel_fading_mimo_free(srsran_channel_fading_mimo_t* q);
+
+/**
+ * @brief Runs the multiple antenna fading channel. Every receive antenna output is the sum of all transmit antenna
+ * inputs filtered by their respective path
+ * @param q Object
+ * @param in Input buffer for each transmit antenna
+ * @param out Output buffer for each receive antenna
+ * @param nof_samples Number of samples to process
+ * @param init_time Time of the first sample in seconds
+ * @return The time of the next sample in seconds
+ */
+SRSRAN_API double srsran_channel_fading_mimo_execute(srsran_channel_fading_mimo_t* q,
+                                                     const cf_t* const*            in,
+                                                     cf_t**                        out,
+                                                     uint32_t                      nof_samples,
+                                                     double                        init_time);
+
 #ifdef __cplusplus
 }
 #endif
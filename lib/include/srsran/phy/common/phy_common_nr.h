@@ -427,6 +427,11 @@ typedef struct SRSRAN_API {
  */
 #define SRSRAN_CORESET_FREQ_DOMAIN_RES_SIZE 45
 
+/**
+ * @brief Max number of CCE in a control resource set, every frequency resource and symbol holds one CCE
+ */
+#define SRSRAN_CORESET_MAX_NOF_CCE (SRSRAN_CORESET_FREQ_DOMAIN_RES_SIZE * SRSRAN_CORESET_DURATION_MAX)
+
 /**
  * @brief Max value for shift index
  */
@@ -128,6 +128,11 @@ SRSRAN_API void srsran_ofdm_rx_free(srsran_ofdm_t* q);
 
 SRSRAN_API void srsran_ofdm_rx_sf(srsran_ofdm_t* q);
 
+/* Demodulates a single slot of the subframe held in the input buffer. Calling it for every slot of the subframe is
+ * equivalent to srsran_ofdm_rx_sf(), which allows demodulating the first slot while the second is still being received.
+ */
+SRSRAN_API void srsran_ofdm_rx_slot(srsran_ofdm_t* q, uint32_t slot_in_sf);
+
 SRSRAN_API void srsran_ofdm_rx_sf_ng(srsran_ofdm_t* q, cf_t* input, cf_t* output);
 
 SRSRAN_API int
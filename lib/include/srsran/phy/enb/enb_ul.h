@@ -54,6 +54,7 @@ typedef struct SRSRAN_API {
 
   cf_t*                 sf_symbols;
   cf_t*                 in_buffer;
+  bool                  sf_symbols_shared;
   srsran_chest_ul_res_t chest_res;
 
   srsran_ofdm_t     fft;
@@ -66,6 +67,11 @@ typedef struct SRSRAN_API {
 /* This function shall be called just after the initial synchronization */
 SRSRAN_API int srsran_enb_ul_init(srsran_enb_ul_t* q, cf_t* in_buffer, uint32_t max_prb);
 
+/* Initialises an object that decodes PUCCH/PUSCH from the resource grid demodulated by another srsran_enb_ul_t object.
+ * Each object keeps its own estimator and decoders, so several UEs can be decoded concurrently after a single FFT. The
+ * OFDM demodulator of the shared object is not used. */
+SRSRAN_API int srsran_enb_ul_init_shared(srsran_enb_ul_t* q, srsran_enb_ul_t* src, uint32_t max_prb);
+
 SRSRAN_API void srsran_enb_ul_free(srsran_enb_ul_t* q);
 
 SRSRAN_API int srsran_enb_ul_set_cell(srsran_enb_ul_t*                   q,
@@ -75,6 +81,8 @@ SRSRAN_API int srsran_enb_ul_set_cell(srsran_enb_ul_t*                   q,
 
 SRSRAN_API void srsran_enb_ul_fft(srsran_enb_ul_t* q);
 
+SRSRAN_API void srsran_enb_ul_fft_slot(srsran_enb_ul_t* q, uint32_t slot_idx);
+
 SRSRAN_API int srsran_enb_ul_get_pucch(srsran_enb_ul_t*    q,
                                        srsran_ul_sf_cfg_t* ul_sf,
                                        srsran_pucch_cfg_t* cfg,
@@ -85,4 +93,21 @@ SRSRAN_API int srsran_enb_ul_get_pusch(srsran_enb_ul_t*    q,
                                        srsran_pusch_cfg_t* cfg,
                                        srsran_pusch_res_t* res);
 
+/* Estimates the channel and demodulates the PUSCH of a single slot into the soft bits buffer llr, which holds the soft
+ * bits of the whole grant. The first slot can be demodulated before the second one is received. Once both slots are
+ * demodulated, srsran_enb_ul_decode_pusch_llr() decodes them as srsran_enb_ul_get_pusch() does. The soft bits do not
+ * belong to the object, so the slots may be demodulated by different objects. */
+SRSRAN_API int srsran_enb_ul_get_pusch_slot(srsran_enb_ul_t*    q,
+                                            srsran_ul_sf_cfg_t* ul_sf,
+                                            srsran_pusch_cfg_t* cfg,
+                                            uint32_t            slot_idx,
+                                            void*               llr,
+                                            srsran_pusch_res_t* res);
+
+SRSRAN_API int srsran_enb_ul_decode_pusch_llr(srsran_enb_ul_t*    q,
+                                              srsran_ul_sf_cfg_t* ul_sf,
+                                              srsran_pusch_cfg_t* cfg,
+                                              void*               llr,
+                                              srsran_pusch_res_t* res);
+
 #endif // SRSRAN_ENB_UL_H
@@ -45,15 +45,29 @@ typedef enum SRSRAN_API {
   SRSRAN_POLAR_DECODER_SSC_S = 1, /*!< \brief Fixed-point (16 bit) Simplified Successive Cancellation (SSC) decoder. */
   SRSRAN_POLAR_DECODER_SSC_C = 2, /*!< \brief Fixed-point (8 bit) Simplified Successive Cancellation (SSC) decoder. */
   SRSRAN_POLAR_DECODER_SSC_C_AVX2 =
-      3 /*!< \brief Fixed-point (8 bit, avx2) Simplified Successive Cancellation (SSC) decoder. */
+      3, /*!< \brief Fixed-point (8 bit, avx2) Simplified Successive Cancellation (SSC) decoder. */
+  SRSRAN_POLAR_DECODER_SCL_C        = 4, /*!< \brief Fixed-point (8 bit) Fast-SSC List (SCL) decoder. */
+  SRSRAN_POLAR_DECODER_SCL_C_AVX2   = 5, /*!< \brief Fixed-point (8 bit, avx2) Fast-SSC List (SCL) decoder. */
+  SRSRAN_POLAR_DECODER_SCL_C_AVX512 = 6  /*!< \brief Fixed-point (8 bit, avx512) Fast-SSC List (SCL) decoder. */
 } srsran_polar_decoder_type_t;
 
+/*!
+ * \brief Maximum number of candidate paths kept by the list decoders.
+ */
+#define SRSRAN_POLAR_DECODER_LIST_SIZE_MAX 8
+
+/*!
+ * \brief List size of the list decoders initialized with srsran_polar_decoder_init().
+ */
+#define SRSRAN_POLAR_DECODER_LIST_SIZE_DEFAULT 8
+
 /*!
  * \brief Describes a polar decoder.
  */
 typedef struct SRSRAN_API {
-  void*   ptr;  /*!< \brief Pointer to the actual polar decoder structure. */
-  uint8_t nMax; /*!< \brief Maximum \f$log_2(code_size)\f$. */
+  void*   ptr;       /*!< \brief Pointer to the actual polar decoder structure. */
+  uint8_t nMax;      /*!< \brief Maximum \f$log_2(code_size)\f$. */
+  uint8_t list_size; /*!< \brief Number of candidates returned by srsran_polar_decoder_decode_list_c(). */
   int (*decode_f)(void*           ptr,
                   const float*    symbols,
                   uint8_t*        data_decoded,
@@ -72,7 +86,13 @@ typedef struct SRSRAN_API {
                   const uint8_t   n,
                   const uint16_t* frozen_set,
                   const uint16_t  frozen_set_size); /*!< \brief Pointer to the decoder function (8-bit version). */
-  void (*free)(void*);                             /*!< \brief Pointer to a "destructor". */
+  int (*decode_list_c)(void*           ptr,
+                       const int8_t*   symbols,
+                       uint8_t*        data_decoded,
+                       const uint8_t   n,
+                       const uint16_t* frozen_set,
+                       const uint16_t  frozen_set_size); /*!< \brief Pointer to the list decoder function (8-bit). */
+  void (*free)(void*);                                  /*!< \brief Pointer to a "destructor". */
 } srsran_polar_decoder_t;
 
 /*!
@@ -87,6 +107,20 @@ SRSRAN_API int srsran_polar_decoder_init(srsran_polar_decoder_t*     q,
                                          srsran_polar_decoder_type_t polar_decoder_type,
                                          const uint8_t               code_size_log);
 
+/*!
+ * Initializes a polar decoder like srsran_polar_decoder_init(), selecting the list size of the list decoders.
+ * \param[out] q A pointer to the initialized polar decoder.
+ * \param[in] polar_decoder_type Polar decoder type.
+ * \param[in] code_size_log The \f$ log_2\f$ of the number of bits of the decoder input/output vector.
+ * \param[in] list_size Number of paths of the list decoders, from 1 to \ref SRSRAN_POLAR_DECODER_LIST_SIZE_MAX. It is
+ * ignored by the SSC decoders, which always give a single candidate.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+SRSRAN_API int srsran_polar_decoder_init_list(srsran_polar_decoder_t*     q,
+                                              srsran_polar_decoder_type_t polar_decoder_type,
+                                              const uint8_t               code_size_log,
+                                              const uint8_t               list_size);
+
 /*!
  * The polar decoder "destructor": it frees all the resources.
  * \param[in, out] q A pointer to the dismantled decoder.
@@ -145,4 +179,24 @@ SRSRAN_API int srsran_polar_decoder_decode_c(srsran_polar_decoder_t* q,
                                              const uint16_t*         frozen_set,
                                              const uint16_t          frozen_set_size);
 
+/*!
+ * Decodes the input (int8_t) codeword and returns all the candidate messages, so that the caller can pick the first
+ * one passing its CRC check (CRC-aided list decoding).
+ * \param[in] q A pointer to the desired polar decoder.
+ * \param[in] input_llr The decoder LLR input vector.
+ * \param[out] data_decoded The candidate messages, the i-th one starts at position \f$ i \times 2^n \f$. It must
+ * fit q->list_size messages.
+ * \param[in] code_size_log The \f$ log_2\f$ of the number of bits of the decoder input/output vector.
+ * \param[in] frozen_set The position of the frozen bits in increasing order.
+ * \param[in] frozen_set_size The size of the frozen_set.
+ * \return The number of candidates, sorted from the most to the least likely, or -1 if an error occurs. SSC decoders
+ * give one candidate.
+ */
+SRSRAN_API int srsran_polar_decoder_decode_list_c(srsran_polar_decoder_t* q,
+                                                  const int8_t*           input_llr,
+                                                  uint8_t*                data_decoded,
+                                                  const uint8_t           code_size_log,
+                                                  const uint16_t*         frozen_set,
+                                                  const uint16_t          frozen_set_size);
+
 #endif // SRSRAN_POLARDECODER_H
@@ -32,12 +32,36 @@
 #define SRSRAN_SOFTBUFFER_H
 
 #include "srsran/config.h"
+#include <pthread.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#define SRSRAN_SOFTBUFFER_SLAB_MAX_SEGMENTS 16
+
+/**
+ * Code block storage shared by several Rx soft-buffers. Every block holds the soft bits and the decoded data of one
+ * code block. The slab starts with one segment of blocks and allocates a new segment whenever it runs out of blocks,
+ * up to max_segments. Blocks are handed out and returned with a mutex held, so the slab can be shared by soft-buffers
+ * reset and released from different threads.
+ */
+typedef struct SRSRAN_API {
+  uint32_t        max_cb_size;  // Number of soft bits per block
+  uint32_t        llr_size;     // Bytes per soft bit, 1 or 2
+  uint32_t        block_size;   // Bytes per block, soft bits and decoded data
+  uint32_t        segment_len;  // Blocks per segment
+  uint32_t        max_segments; // Maximum number of segments
+  uint32_t        nof_segments; // Number of allocated segments
+  uint8_t*        segments[SRSRAN_SOFTBUFFER_SLAB_MAX_SEGMENTS];
+  uint8_t**       free_list;    // Stack of free blocks
+  uint32_t        nof_free;     // Number of blocks in the stack
+  uint32_t        max_used;     // Maximum number of blocks used at the same time
+  pthread_mutex_t mutex;
+} srsran_softbuffer_slab_t;
+
 typedef struct SRSRAN_API {
   uint32_t  max_cb;
   uint32_t  max_cb_size;
@@ -45,6 +69,10 @@ typedef struct SRSRAN_API {
   uint8_t** data;
   bool*     cb_crc;
   bool      tb_crc;
+
+  uint32_t                  llr_size;     // Bytes per soft bit, 2 unless initialised for 8-bit soft bits
+  srsran_softbuffer_slab_t* slab;         // Code block storage, NULL if the soft-buffer owns its code blocks
+  uint32_t                  nof_attached; // Number of code blocks taken from the slab
 } srsran_softbuffer_rx_t;
 
 typedef struct SRSRAN_API {
@@ -67,6 +95,30 @@ SRSRAN_API int srsran_softbuffer_rx_init(srsran_softbuffer_rx_t* q, uint32_t nof
  */
 SRSRAN_API int srsran_softbuffer_rx_init_guru(srsran_softbuffer_rx_t* q, uint32_t max_cb, uint32_t max_cb_size);
 
+/**
+ * @brief Initialises Rx soft-buffer with 8-bit soft bits, as used by the NR shared channel decoder, halving the memory
+ * of srsran_softbuffer_rx_init_guru()
+ * @param q The Rx soft-buffer pointer
+ * @param max_cb The maximum number of code blocks to allocate
+ * @param max_cb_size The code block size to allocate
+ * @return It returns SRSRAN_SUCCESS if it allocates the soft-buffer successfully, otherwise it returns SRSRAN_ERROR
+ * code
+ */
+SRSRAN_API int srsran_softbuffer_rx_init_guru_8bit(srsran_softbuffer_rx_t* q, uint32_t max_cb, uint32_t max_cb_size);
+
+/**
+ * @brief Initialises Rx soft-buffer that takes its code blocks from a slab on demand. No code block is attached until
+ * srsran_softbuffer_rx_reset_tbs() or srsran_softbuffer_rx_reset_cb() give the number of code blocks of the TB, and
+ * srsran_softbuffer_rx_reset() and srsran_softbuffer_rx_release() return them to the slab
+ * @param q The Rx soft-buffer pointer
+ * @param max_cb The maximum number of code blocks
+ * @param slab Initialised slab, it must outlive the soft-buffer
+ * @return It returns SRSRAN_SUCCESS if it initialises the soft-buffer successfully, otherwise it returns SRSRAN_ERROR
+ * code
+ */
+SRSRAN_API int
+srsran_softbuffer_rx_init_slab(srsran_softbuffer_rx_t* q, uint32_t max_cb, srsran_softbuffer_slab_t* slab);
+
 SRSRAN_API void srsran_softbuffer_rx_reset(srsran_softbuffer_rx_t* p);
 
 SRSRAN_API void srsran_softbuffer_rx_reset_tbs(srsran_softbuffer_rx_t* q, uint32_t tbs);
@@ -75,6 +127,20 @@ SRSRAN_API void srsran_softbuffer_rx_reset_cb(srsran_softbuffer_rx_t* q, uint32_
 
 SRSRAN_API void srsran_softbuffer_rx_free(srsran_softbuffer_rx_t* p);
 
+/**
+ * @brief Returns the code blocks of a slab soft-buffer to the slab, for instance once the TB is decoded. It does
+ * nothing for soft-buffers that own their code blocks
+ * @param q Rx soft-buffer object
+ */
+SRSRAN_API void srsran_softbuffer_rx_release(srsran_softbuffer_rx_t* q);
+
+/**
+ * @brief Gets the soft bit and decoded data memory currently held by the soft-buffer
+ * @param q Rx soft-buffer object
+ * @return Memory in bytes
+ */
+SRSRAN_API size_t srsran_softbuffer_rx_mem_size(const srsran_softbuffer_rx_t* q);
+
 /**
  * @brief Resets a number of CB CRCs
  * @note This function is intended to be used if all CB CRC have matched but the TB CRC failed. In this case, all CB
@@ -84,6 +150,33 @@ SRSRAN_API void srsran_softbuffer_rx_free(srsran_softbuffer_rx_t* p);
  */
 SRSRAN_API void srsran_softbuffer_rx_reset_cb_crc(srsran_softbuffer_rx_t* q, uint32_t nof_cb);
 
+/**
+ * @brief Initialises a slab of code blocks for Rx soft-buffers
+ * @param q The slab pointer
+ * @param segment_len Number of code blocks allocated at once
+ * @param max_segments Maximum number of segments, up to SRSRAN_SOFTBUFFER_SLAB_MAX_SEGMENTS
+ * @param max_cb_size The code block size
+ * @param llr_size Bytes per soft bit, 1 for 8-bit soft bits and 2 for 16-bit soft bits
+ * @return It returns SRSRAN_SUCCESS if it allocates the first segment successfully, otherwise it returns SRSRAN_ERROR
+ * code
+ */
+SRSRAN_API int srsran_softbuffer_slab_init(srsran_softbuffer_slab_t* q,
+                                           uint32_t                  segment_len,
+                                           uint32_t                  max_segments,
+                                           uint32_t                  max_cb_size,
+                                           uint32_t                  llr_size);
+
+SRSRAN_API void srsran_softbuffer_slab_free(srsran_softbuffer_slab_t* q);
+
+/// Number of code blocks currently taken by Rx soft-buffers
+SRSRAN_API uint32_t srsran_softbuffer_slab_nof_used(srsran_softbuffer_slab_t* q);
+
+/// Maximum number of code blocks taken at the same time since the initialisation
+SRSRAN_API uint32_t srsran_softbuffer_slab_max_used(srsran_softbuffer_slab_t* q);
+
+/// Memory in bytes allocated by the slab
+SRSRAN_API size_t srsran_softbuffer_slab_mem_size(srsran_softbuffer_slab_t* q);
+
 SRSRAN_API int srsran_softbuffer_tx_init(srsran_softbuffer_tx_t* q, uint32_t nof_prb);
 
 /**
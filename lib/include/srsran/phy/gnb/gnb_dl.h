@@ -30,12 +30,18 @@
 #include "srsran/phy/phch/pdsch_nr.h"
 #include "srsran/phy/sync/ssb.h"
 
+/**
+ * @brief Maximum number of PDSCH encoders of a gNb DL object, they limit how many PDSCH can be encoded concurrently
+ */
+#define SRSRAN_GNB_DL_MAX_PDSCH_ENCODERS 8
+
 typedef struct SRSRAN_API {
   srsran_pdsch_nr_args_t      pdsch;
   srsran_pdcch_nr_args_t      pdcch;
   uint32_t                    nof_tx_antennas;
-  uint32_t                    nof_max_prb; ///< Maximum number of allocated RB
-  double                      srate_hz;    ///< Fix sampling rate, set to 0 for minimum to fit nof_max_prb
+  uint32_t                    nof_max_prb;        ///< Maximum number of allocated RB
+  double                      srate_hz;           ///< Fix sampling rate, set to 0 for minimum to fit nof_max_prb
+  uint32_t                    nof_pdsch_encoders; ///< Number of PDSCH encoders, set to 0 for 1
   srsran_subcarrier_spacing_t scs;
 } srsran_gnb_dl_args_t;
 
@@ -50,7 +56,8 @@ typedef struct SRSRAN_API {
   srsran_ofdm_t fft[SRSRAN_MAX_PORTS];
 
   cf_t*             sf_symbols[SRSRAN_MAX_PORTS];
-  srsran_pdsch_nr_t pdsch;
+  srsran_pdsch_nr_t pdsch[SRSRAN_GNB_DL_MAX_PDSCH_ENCODERS]; ///< Each encoder keeps its own codeword buffers
+  uint32_t          nof_pdsch_encoders;
   srsran_dmrs_sch_t dmrs;
 
   srsran_dci_nr_t   dci; ///< Stores DCI configuration
@@ -87,11 +94,36 @@ SRSRAN_API int srsran_gnb_dl_pdsch_put(srsran_gnb_dl_t*           q,
                                        const srsran_sch_cfg_nr_t* cfg,
                                        uint8_t*                   data[SRSRAN_MAX_TB]);
 
+/**
+ * @brief Puts a PDSCH transmission in the resource grid using the given PDSCH encoder
+ *
+ * @remark PDSCH transmissions with non-overlapping grants can be put concurrently from different threads as long as
+ * they use different encoders. The rest of the resource grid operations must not run concurrently with them.
+ *
+ * @param q gNb DL object
+ * @param encoder_idx PDSCH encoder index, lower than the number of encoders given at initialisation
+ * @param slot Slot configuration
+ * @param cfg PDSCH configuration, including the grant
+ * @param data Transport block data
+ * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_gnb_dl_pdsch_put_encoder(srsran_gnb_dl_t*           q,
+                                               uint32_t                   encoder_idx,
+                                               const srsran_slot_cfg_t*   slot,
+                                               const srsran_sch_cfg_nr_t* cfg,
+                                               uint8_t*                   data[SRSRAN_MAX_TB]);
+
 SRSRAN_API float srsran_gnb_dl_get_maximum_signal_power_dBfs(uint32_t nof_prb);
 
 SRSRAN_API int
 srsran_gnb_dl_pdsch_info(const srsran_gnb_dl_t* q, const srsran_sch_cfg_nr_t* cfg, char* str, uint32_t str_len);
 
+SRSRAN_API int srsran_gnb_dl_pdsch_encoder_info(const srsran_gnb_dl_t*     q,
+                                                uint32_t                   encoder_idx,
+                                                const srsran_sch_cfg_nr_t* cfg,
+                                                char*                      str,
+                                                uint32_t                   str_len);
+
 SRSRAN_API int
 srsran_gnb_dl_pdcch_dl_info(const srsran_gnb_dl_t* q, const srsran_dci_dl_nr_t* dci, char* str, uint32_t str_len);
 
@@ -23,7 +23,7 @@
  *  File:         demod_soft.h
  *
  *  Description:  Soft demodulator.
- *                Supports BPSK, QPSK, 16QAM and 64QAM.
+ *                Supports BPSK, QPSK, 16QAM, 64QAM and 256QAM.
  *
  *  Reference:    3GPP TS 36.211 version 10.0.0 Release 10 Sec. 7.1
  *****************************************************************************/
@@ -42,4 +42,36 @@ SRSRAN_API int srsran_demod_soft_demodulate_s(srsran_mod_t modulation, const cf_
 
 SRSRAN_API int srsran_demod_soft_demodulate_b(srsran_mod_t modulation, const cf_t* symbols, int8_t* llr, int nsymbols);
 
+/**
+ * @brief Soft demodulates into max-log LLR scaled by the noise variance
+ *
+ * Unlike the functions above, which output the simplified Tosato-Bisaglia metrics, these compute the exact max-log LLR
+ * of each bit as a piecewise linear function of the symbol. The LLR is positive when the bit is more likely to be 1.
+ * The integer variants round and saturate the LLR to the output range.
+ *
+ * @param modulation Modulation of the symbols
+ * @param symbols Equalized symbols, normalized to unit average energy
+ * @param llr Output LLR, nsymbols times the number of bits per symbol
+ * @param nsymbols Number of symbols
+ * @param noise_var Noise variance of the equalized symbols, it must be greater than zero
+ * @return SRSRAN_SUCCESS if the inputs are valid, SRSRAN_ERROR_INVALID_INPUTS otherwise
+ */
+SRSRAN_API int srsran_demod_soft_demodulate_scaled(srsran_mod_t modulation,
+                                                   const cf_t*  symbols,
+                                                   float*       llr,
+                                                   int          nsymbols,
+                                                   float        noise_var);
+
+SRSRAN_API int srsran_demod_soft_demodulate_scaled_s(srsran_mod_t modulation,
+                                                     const cf_t*  symbols,
+                                                     short*       llr,
+                                                     int          nsymbols,
+                                                     float        noise_var);
+
+SRSRAN_API int srsran_demod_soft_demodulate_scaled_b(srsran_mod_t modulation,
+                                                     const cf_t*  symbols,
+                                                     int8_t*      llr,
+                                                     int          nsymbols,
+                                                     float        noise_var);
+
 #endif // SRSRAN_DEMOD_SOFT_H
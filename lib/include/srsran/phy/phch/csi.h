@@ -130,4 +130,26 @@ SRSRAN_API uint32_t srsran_csi_str(const srsran_csi_report_cfg_t*   report_cfg,
                                    char*                            str,
                                    uint32_t                         str_len);
 
+/**
+ * @brief Configures the subbands of a subband CSI report for a given BWP, as described in TS 38.214 Section 5.2.1.4
+ * @param cfg CSI report configuration
+ * @param bwp_start First common resource block of the BWP
+ * @param bwp_nof_prb Number of PRB of the BWP
+ * @param large_subbands Set to true for the largest subband size of TS 38.214 Table 5.2.1.4-2 (subbandSize value2)
+ * @return SRSRAN_SUCCESS if the BWP supports subband reports, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_csi_set_subbands(srsran_csi_hl_report_cfg_t* cfg,
+                                       uint32_t                    bwp_start,
+                                       uint32_t                    bwp_nof_prb,
+                                       bool                        large_subbands);
+
+/**
+ * @brief Computes the CQI of a subband from a subband CSI report value, applying the subband differential CQI offset
+ * levels of TS 38.214 Table 5.2.2.1-1
+ * @param value Subband CSI report value
+ * @param subband_idx Subband index
+ * @return The subband CQI
+ */
+SRSRAN_API uint32_t srsran_csi_subband_cqi(const srsran_csi_report_value_t* value, uint32_t subband_idx);
+
 #endif // SRSRAN_CSI_NR_H
@@ -57,6 +57,12 @@
  */
 #define SRSRAN_CSI_MAX_NOF_CSI_IM_RESOURCE_SETS_X_CONFIG 12
 
+/**
+ * @brief Maximum number of CSI subbands, given by the smallest subband size of TS 38.214 Table 5.2.1.4-2 for a BWP of
+ * 275 PRB
+ */
+#define SRSRAN_CSI_MAX_NOF_SUBBANDS 19
+
 /**
  * @brief CSI report types defined in TS 38.331 CSI-ReportConfig
  */
@@ -122,9 +128,11 @@ typedef struct SRSRAN_API {
     srsran_csi_periodic_report_cfg_t periodic; ///< Used for periodic reporting
     // ... add here other types
   };
-  srsran_csi_report_quantity_t quantity;  ///< Report quantity
-  srsran_csi_cqi_table_t       cqi_table; ///< CQI table selection
-  srsran_csi_report_freq_t     freq_cfg;  ///< Determine whether it is wideband or subband
+  srsran_csi_report_quantity_t quantity;     ///< Report quantity
+  srsran_csi_cqi_table_t       cqi_table;    ///< CQI table selection
+  srsran_csi_report_freq_t     freq_cfg;     ///< Determine whether it is wideband or subband
+  uint32_t                     subband_size; ///< Subband size in PRB, only for subband reports
+  uint32_t                     nof_subbands; ///< Number of subbands in the BWP, only for subband reports
 } srsran_csi_hl_report_cfg_t;
 
 /**
@@ -169,6 +177,10 @@ typedef struct SRSRAN_API {
   float    wideband_epre_dBm; ///< Measured EPRE
   float    wideband_snr_db;   ///< SNR calculated from NZP-CSI-RS RSRP and EPRE (Ignore for IM-CSI-RS)
 
+  // Subband measurements
+  float    subband_snr_db[SRSRAN_CSI_MAX_NOF_SUBBANDS]; ///< SNR of each subband (Ignore for IM-CSI-RS)
+  uint32_t nof_subbands;                                ///< Number of measured subbands, 0 if only wideband
+
   // Resource set context
   uint32_t nof_ports; ///< Number of antenna ports
   uint32_t K_csi_rs;  ///< Number of CSI-RS in the corresponding resource set
@@ -196,6 +208,16 @@ typedef struct SRSRAN_API {
   uint32_t cqi;
 } srsran_csi_report_wideband_cri_ri_pmi_cqi_t;
 
+/**
+ * @brief Subband CSI report values
+ */
+typedef struct SRSRAN_API {
+  uint32_t ri;
+  uint32_t pmi;
+  uint32_t cqi;                                          ///< Wideband CQI
+  uint8_t  subband_diff_cqi[SRSRAN_CSI_MAX_NOF_SUBBANDS]; ///< Subband differential CQI, TS 38.214 Table 5.2.2.1-1
+} srsran_csi_report_subband_cri_ri_pmi_cqi_t;
+
 /**
  * @brief Unified CSI report values
  */
@@ -204,6 +226,7 @@ typedef struct SRSRAN_API {
   union {
     void*                                       none;
     srsran_csi_report_wideband_cri_ri_pmi_cqi_t wideband_cri_ri_pmi_cqi;
+    srsran_csi_report_subband_cri_ri_pmi_cqi_t  subband_cri_ri_pmi_cqi;
   };
 } srsran_csi_report_value_t;
 
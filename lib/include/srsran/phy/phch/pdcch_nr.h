@@ -45,11 +45,33 @@
  * @brief PDCCH configuration initialization arguments
  */
 typedef struct {
-  bool disable_simd;
-  bool measure_evm;
-  bool measure_time;
+  bool     disable_simd;
+  bool     measure_evm;
+  bool     measure_time;
+  uint32_t polar_list_size; ///< Polar decoder list size, 0 or 1 for the SSC decoder, up to 8 for the CRC-aided SCL
 } srsran_pdcch_nr_args_t;
 
+/**
+ * @brief Maximum number of slots in a radio frame for the PDCCH numerologies
+ */
+#define SRSRAN_PDCCH_NR_MAX_NOF_SLOTS SRSRAN_NSLOTS_PER_FRAME_NR(srsran_subcarrier_spacing_120kHz)
+
+/**
+ * @brief Number of PDCCH data resource elements in a REG, the rest are DMRS
+ */
+#define SRSRAN_PDCCH_NR_RE_X_REG (SRSRAN_NRE - 3U)
+
+/**
+ * @brief PDCCH candidate locations of a search space for every slot in a radio frame and a given RNTI
+ */
+typedef struct SRSRAN_API {
+  uint16_t rnti;      ///< RNTI the locations were computed for
+  uint32_t nof_slots; ///< Number of slots with locations, 1 if they do not depend on the slot, 0 if not computed
+  uint32_t nof_candidates[SRSRAN_SEARCH_SPACE_NOF_AGGREGATION_LEVELS_NR];
+  uint8_t  ncce[SRSRAN_PDCCH_NR_MAX_NOF_SLOTS][SRSRAN_SEARCH_SPACE_NOF_AGGREGATION_LEVELS_NR]
+             [SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR];
+} srsran_pdcch_nr_locations_t;
+
 /**
  * @brief PDCCH Attributes and objects required to encode/decode NR PDCCH
  */
@@ -65,7 +87,7 @@ typedef struct SRSRAN_API {
   uint8_t*               c;         // Message bits with attached CRC
   uint8_t*               d;         // encoded bits
   uint8_t*               f;         // bits at the Rate matching output
-  uint8_t*               allocated; // Allocated polar bit buffer, encoder input, decoder output
+  uint8_t*               allocated; // Allocated polar bit buffer, encoder input, decoder output (one per candidate)
   cf_t*                  symbols;
   srsran_modem_table_t   modem_table;
   srsran_evm_buffer_t*   evm_buffer;
@@ -74,6 +96,14 @@ typedef struct SRSRAN_API {
   uint32_t               K;
   uint32_t               M;
   uint32_t               E;
+  uint32_t               code_K; // Payload size the polar code was last built for
+  uint32_t               code_E; // Number of rate-matched bits the polar code was last built for
+
+  /// Equalized symbols and soft bits of the CORESET REGs, reused by all the candidates of a slot
+  cf_t*   reg_symbols;
+  int8_t* reg_llr;
+  cf_t*   reg_ce;
+  bool    reg_valid[SRSRAN_CORESET_DURATION_MAX][SRSRAN_MAX_PRB_NR];
 } srsran_pdcch_nr_t;
 
 /**
@@ -105,6 +135,24 @@ int srsran_pdcch_nr_locations_coreset(const srsran_coreset_t*      coreset,
                                       uint32_t                     slot_idx,
                                       uint32_t locations[SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR]);
 
+/**
+ * @brief Computes the PDCCH candidate locations of a search space for all the slots in a radio frame
+ *
+ * The locations of common search spaces do not depend on the slot or the RNTI, so they are computed for one slot only.
+ *
+ * @param coreset is the coreset configuration provided from higher layers
+ * @param search_space is the Search Space configuration provided from higher layers
+ * @param rnti UE temporal identifier, unused for common search spaces
+ * @param scs Subcarrier spacing of the carrier, it gives the number of slots in a radio frame
+ * @param[out] locations Destination table
+ * @return SRSRAN_SUCCESS if the provided parameters are valid, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_pdcch_nr_locations_table(const srsran_coreset_t*      coreset,
+                                               const srsran_search_space_t* search_space,
+                                               uint16_t                     rnti,
+                                               srsran_subcarrier_spacing_t  scs,
+                                               srsran_pdcch_nr_locations_t* locations);
+
 SRSRAN_API int srsran_pdcch_nr_max_candidates_coreset(const srsran_coreset_t* coreset, uint32_t aggregation_level);
 
 /**
@@ -154,6 +202,37 @@ SRSRAN_API int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
                                       srsran_dci_msg_nr_t*    dci_msg,
                                       srsran_pdcch_nr_res_t*  res);
 
+/**
+ * @brief Invalidates the REG soft bits that srsran_pdcch_nr_decode_reg() keeps between candidates
+ *
+ * It shall be called every time the resource grid or the CORESET channel estimates change, typically once per slot.
+ * Changing the CORESET with srsran_pdcch_nr_set_carrier() also invalidates them.
+ *
+ * @param[in,out] q PDCCH decoder object
+ */
+SRSRAN_API void srsran_pdcch_nr_reset_reg(srsran_pdcch_nr_t* q);
+
+/**
+ * @brief Decodes a DCI like srsran_pdcch_nr_decode(), demodulating only the REGs that no previous candidate used
+ *
+ * The channel estimates are taken from the CORESET estimator instead of being extracted for every candidate. Since the
+ * PDCCH is zero-forcing equalized, the soft bits of a REG are the same for every candidate, aggregation level and DCI
+ * size that contains it.
+ *
+ * @param[in,out] q provides PDCCH decoder object
+ * @param[in] slot_symbols provides slot resource grid
+ * @param[in] estimator CORESET channel estimator, it must have estimated the current slot
+ * @param[in,out] dci_msg Provides with the DCI message location, RNTI, RNTI type and so on. Also, the message data
+ * buffer
+ * @param[out] res Provides the PDCCH result information
+ * @return SRSRAN_SUCCESS if the configurations are valid, otherwise it returns an SRSRAN_ERROR code
+ */
+SRSRAN_API int srsran_pdcch_nr_decode_reg(srsran_pdcch_nr_t*                   q,
+                                          cf_t*                                slot_symbols,
+                                          const srsran_dmrs_pdcch_estimator_t* estimator,
+                                          srsran_dci_msg_nr_t*                 dci_msg,
+                                          srsran_pdcch_nr_res_t*               res);
+
 /**
  * @brief Stringifies NR PDCCH decoding information from the latest encoded/decoded transmission
  *
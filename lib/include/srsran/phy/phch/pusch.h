@@ -119,6 +119,40 @@ SRSRAN_API int srsran_pusch_decode(srsran_pusch_t*        q,
                                    cf_t*                  sf_symbols,
                                    srsran_pusch_res_t*    data);
 
+/**
+ * Equalizes and demodulates the PUSCH resource elements of a single slot into the soft bits buffer. Demodulating both
+ * slots and then calling srsran_pusch_decode_llr() is equivalent to srsran_pusch_decode(), which allows demodulating
+ * the first slot while the second one is still being received.
+ *
+ * @param q PUSCH object
+ * @param sf Uplink subframe configuration
+ * @param cfg PUSCH configuration
+ * @param channel Channel estimates, only the ones of the given slot are used
+ * @param sf_symbols Resource grid, only the given slot needs to be demodulated
+ * @param slot_idx Slot in the subframe
+ * @param llr Soft bits of the whole grant (int8_t if q->llr_is_8bit, int16_t otherwise), its size must be at least the
+ * number of coded bits of the grant
+ * @param data EPRE and EVM measurements, they are accumulated over the slots
+ * @return SRSRAN_SUCCESS if the slot is demodulated, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_pusch_demod_slot(srsran_pusch_t*        q,
+                                       srsran_ul_sf_cfg_t*    sf,
+                                       srsran_pusch_cfg_t*    cfg,
+                                       srsran_chest_ul_res_t* channel,
+                                       cf_t*                  sf_symbols,
+                                       uint32_t               slot_idx,
+                                       void*                  llr,
+                                       srsran_pusch_res_t*    data);
+
+/**
+ * Descrambles and decodes the soft bits of both slots demodulated by srsran_pusch_demod_slot()
+ */
+SRSRAN_API int srsran_pusch_decode_llr(srsran_pusch_t*     q,
+                                       srsran_ul_sf_cfg_t* sf,
+                                       srsran_pusch_cfg_t* cfg,
+                                       void*               llr,
+                                       srsran_pusch_res_t* data);
+
 SRSRAN_API uint32_t srsran_pusch_grant_tx_info(srsran_pusch_grant_t* grant,
                                                srsran_uci_cfg_t*     uci_cfg,
                                                srsran_uci_value_t*   uci_data,
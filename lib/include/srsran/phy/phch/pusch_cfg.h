@@ -83,6 +83,8 @@ typedef struct SRSRAN_API {
   bool meas_ta_en;
   bool meas_evm_en;
 
+  bool wiener_en; // Use the Wiener filter instead of pilot averaging for estimating the channel
+
 } srsran_pusch_cfg_t;
 
 #endif // SRSRAN_PUSCH_CFG_H
@@ -38,9 +38,10 @@
  * @brief NR-UCI Encoder/decoder initialization arguments
  */
 typedef struct {
-  bool  disable_simd;         ///< Disable Polar code SIMD
-  float block_code_threshold; ///< Set normalised block code threshold (receiver only)
-  float one_bit_threshold;    ///< Decode threshold for 1 bit (receiver only)
+  bool     disable_simd;         ///< Disable Polar code SIMD
+  float    block_code_threshold; ///< Set normalised block code threshold (receiver only)
+  float    one_bit_threshold;    ///< Decode threshold for 1 bit (receiver only)
+  uint32_t polar_list_size;      ///< Polar decoder list size, 0 or 1 for SSC, up to 8 for CRC-aided SCL (receiver only)
 } srsran_uci_nr_args_t;
 
 typedef struct {
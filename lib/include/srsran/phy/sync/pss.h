@@ -88,6 +88,7 @@ typedef struct SRSRAN_API {
   float  ema_alpha;
   float* conv_output_avg;
   float  peak_value;
+  float  peak_value_all[SRSRAN_NOF_NID_2]; // Absolute peak value of each N_id_2 in srsran_pss_find_pss_all()
 
   bool              filter_pss_enable;
   srsran_dft_plan_t dftp_input;
@@ -137,6 +138,11 @@ SRSRAN_API int srsran_pss_set_N_id_2(srsran_pss_t* q, uint32_t N_id_2);
 
 SRSRAN_API int srsran_pss_find_pss(srsran_pss_t* q, const cf_t* input, float* corr_peak_value);
 
+SRSRAN_API int srsran_pss_find_pss_all(srsran_pss_t* q,
+                                       const cf_t*   input,
+                                       uint32_t      corr_peak_pos[SRSRAN_NOF_NID_2],
+                                       float         corr_peak_value[SRSRAN_NOF_NID_2]);
+
 SRSRAN_API int srsran_pss_chest(srsran_pss_t* q, const cf_t* input, cf_t ce[SRSRAN_PSS_LEN]);
 
 SRSRAN_API float srsran_pss_cfo_compute(srsran_pss_t* q, const cf_t* pss_recv);
@@ -35,6 +35,10 @@ typedef struct {
   cf_t*                correlation;
   srsran_conv_fft_cc_t conv_fft_cc;
 
+  // Frequency domain correlation windows of the buffer, shared by all the cells of srsran_refsignal_dl_sync_run_batch()
+  cf_t*    input_fft;
+  uint32_t input_fft_max_len;
+
   // Results
   bool     found;
   float    rsrp_dBfs;
@@ -44,6 +48,16 @@ typedef struct {
   uint32_t peak_index;
 } srsran_refsignal_dl_sync_t;
 
+typedef struct {
+  uint32_t pci;
+  bool     found;
+  float    rsrp_dBfs;
+  float    rssi_dBfs;
+  float    rsrq_dB;
+  float    cfo_Hz;
+  uint32_t peak_index;
+} srsran_refsignal_dl_sync_meas_t;
+
 SRSRAN_API int srsran_refsignal_dl_sync_init(srsran_refsignal_dl_sync_t* q, srsran_cp_t cp);
 
 SRSRAN_API int srsran_refsignal_dl_sync_set_cell(srsran_refsignal_dl_sync_t* q, srsran_cell_t cell);
@@ -52,6 +66,28 @@ SRSRAN_API void srsran_refsignal_dl_sync_free(srsran_refsignal_dl_sync_t* q);
 
 SRSRAN_API int srsran_refsignal_dl_sync_run(srsran_refsignal_dl_sync_t* q, cf_t* buffer, uint32_t nsamples);
 
+/**
+ * Measures several cells in the same buffer. It is equivalent to setting each PCI and running
+ * srsran_refsignal_dl_sync_run(), but the buffer is transformed to frequency domain once and every cell correlates
+ * against the same transform.
+ *
+ * @param q Object
+ * @param cell Cell configuration shared by all the cells, the cell identifier is ignored
+ * @param pci List of the physical cell identifiers to measure
+ * @param nof_pci Number of cells to measure
+ * @param buffer Baseband samples
+ * @param nsamples Number of samples in the buffer
+ * @param meas Provides the measurement of each cell, nof_pci elements
+ * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_refsignal_dl_sync_run_batch(srsran_refsignal_dl_sync_t*      q,
+                                                  srsran_cell_t                    cell,
+                                                  const uint32_t*                  pci,
+                                                  uint32_t                         nof_pci,
+                                                  cf_t*                            buffer,
+                                                  uint32_t                         nsamples,
+                                                  srsran_refsignal_dl_sync_meas_t* meas);
+
 SRSRAN_API void srsran_refsignal_dl_sync_measure_sf(srsran_refsignal_dl_sync_t* q,
                                                     cf_t*                       buffer,
                                                     uint32_t                    sf_idx,
@@ -40,6 +40,7 @@
 
 #define SRSRAN_SSS_N 31
 #define SRSRAN_SSS_LEN 2 * SRSRAN_SSS_N
+#define SRSRAN_SSS_N_PAD 32 // Row length of the transposed correlation tables, multiple of any SIMD width
 
 typedef struct SRSRAN_API {
   int z1[SRSRAN_SSS_N][SRSRAN_SSS_N];
@@ -53,8 +54,10 @@ typedef struct SRSRAN_API {
 typedef struct SRSRAN_API {
   float z1[SRSRAN_SSS_N][SRSRAN_SSS_N];
   float c[2][SRSRAN_SSS_N];
-  float s[SRSRAN_SSS_N][SRSRAN_SSS_N];
-  float sd[SRSRAN_SSS_N][SRSRAN_SSS_N - 1];
+  // Sequences s_m and their differential products, transposed (element k of sequence m is at [k][m]) so that the
+  // correlation with all the m is computed with contiguous vector operations
+  float s[SRSRAN_SSS_N][SRSRAN_SSS_N_PAD];
+  float sd[SRSRAN_SSS_N - 1][SRSRAN_SSS_N_PAD];
 } srsran_sss_fc_tables_t;
 
 /* Low-level API */
@@ -132,6 +132,20 @@ typedef enum {
   SRSRAN_SYNC_ERROR         = -1
 } srsran_sync_find_ret_t;
 
+/* Result of the search of one N_id_2 by srsran_sync_find_all() */
+typedef struct SRSRAN_API {
+  srsran_sync_find_ret_t ret;          // Same meaning as the value returned by srsran_sync_find()
+  uint32_t               peak_pos;     // Position of the PSS correlation peak
+  float                  peak_value;   // PSS correlation peak value, as returned by srsran_pss_find_pss()
+  float                  peak_abs;     // Absolute value of the PSS correlation peak
+  bool                   sss_detected; // If true, N_id_1 and sf_idx are valid
+  uint32_t               N_id_1;
+  uint32_t               sf_idx;
+  srsran_cp_t            cp;
+  srsran_frame_type_t    frame_type;
+  float                  cfo; // Normalised by the subcarrier spacing
+} srsran_sync_find_all_res_t;
+
 SRSRAN_API int srsran_sync_init(srsran_sync_t* q, uint32_t frame_size, uint32_t max_offset, uint32_t fft_size);
 
 SRSRAN_API int
@@ -149,6 +163,12 @@ SRSRAN_API srsran_sync_find_ret_t srsran_sync_find(srsran_sync_t* q,
                                                    uint32_t       find_offset,
                                                    uint32_t*      peak_position);
 
+/* Finds the correlation peak of the three N_id_2 in one pass and detects the SSS of each */
+SRSRAN_API int srsran_sync_find_all(srsran_sync_t*             q,
+                                    const cf_t*                input,
+                                    uint32_t                   find_offset,
+                                    srsran_sync_find_all_res_t res[SRSRAN_NOF_NID_2]);
+
 /* Estimates the CP length */
 SRSRAN_API srsran_cp_t srsran_sync_detect_cp(srsran_sync_t* q, const cf_t* input, uint32_t peak_pos);
 
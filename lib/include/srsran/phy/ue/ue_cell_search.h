@@ -32,6 +32,13 @@
  *                (SRSRAN_CS_SAMP_FREQ constant) before calling to
  *                srsran_ue_cellsearch_scan() functions.
  *
+ *                srsran_ue_cellsearch_scan() searches each N_id_2 on its own
+ *                frames. srsran_ue_cellsearch_scan_single_pass() searches the
+ *                three N_id_2 on the same frames, so it receives up to three
+ *                times fewer samples. srsran_ue_cellsearch_scan_buffer() does
+ *                the same on samples captured beforehand, which allows capturing
+ *                the next frequency while the previous one is processed.
+ *
  *  Reference:
  *****************************************************************************/
 
@@ -73,7 +80,7 @@ typedef struct SRSRAN_API {
   uint32_t *mode_ntimes;
   uint8_t*  mode_counted;
 
-  srsran_ue_cellsearch_result_t* candidates;
+  srsran_ue_cellsearch_result_t* candidates; // max_frames candidates for each N_id_2
 } srsran_ue_cellsearch_t;
 
 SRSRAN_API int srsran_ue_cellsearch_init(srsran_ue_cellsearch_t* q,
@@ -97,6 +104,16 @@ SRSRAN_API int srsran_ue_cellsearch_scan(srsran_ue_cellsearch_t*       q,
                                          srsran_ue_cellsearch_result_t found_cells[3],
                                          uint32_t*                     max_N_id_2);
 
+SRSRAN_API int srsran_ue_cellsearch_scan_single_pass(srsran_ue_cellsearch_t*       q,
+                                                     srsran_ue_cellsearch_result_t found_cells[3],
+                                                     uint32_t*                     max_N_id_2);
+
+SRSRAN_API int srsran_ue_cellsearch_scan_buffer(srsran_ue_cellsearch_t*       q,
+                                                const cf_t*                   buffer,
+                                                uint32_t                      nof_samples,
+                                                srsran_ue_cellsearch_result_t found_cells[3],
+                                                uint32_t*                     max_N_id_2);
+
 SRSRAN_API int srsran_ue_cellsearch_set_nof_valid_frames(srsran_ue_cellsearch_t* q, uint32_t nof_frames);
 
 SRSRAN_API void srsran_set_detect_cp(srsran_ue_cellsearch_t* q, bool enable);
@@ -175,6 +175,9 @@ SRSRAN_API void srsran_ue_dl_set_mi_auto(srsran_ue_dl_t* q);
 /* Perform signal demodulation and channel estimation and store signals in the object */
 SRSRAN_API int srsran_ue_dl_decode_fft_estimate(srsran_ue_dl_t* q, srsran_dl_sf_cfg_t* sf, srsran_ue_dl_cfg_t* cfg);
 
+/* Perform channel estimation on the resource grid already stored in the object sf_symbols, skipping the FFT */
+SRSRAN_API int srsran_ue_dl_decode_estimate(srsran_ue_dl_t* q, srsran_dl_sf_cfg_t* sf, srsran_ue_dl_cfg_t* cfg);
+
 SRSRAN_API int srsran_ue_dl_decode_fft_estimate_noguru(srsran_ue_dl_t*     q,
                                                        srsran_dl_sf_cfg_t* sf,
                                                        srsran_ue_dl_cfg_t* cfg,
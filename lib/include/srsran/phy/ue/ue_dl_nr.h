@@ -72,7 +72,10 @@ typedef struct SRSRAN_API {
 
   srsran_dmrs_pdcch_estimator_t dmrs_pdcch[SRSRAN_UE_DL_NR_MAX_NOF_CORESET];
   srsran_pdcch_nr_t             pdcch;
-  srsran_dmrs_pdcch_ce_t*       pdcch_ce;
+
+  /// PDCCH candidate locations of every search space for a whole frame, computed again only if the RNTI changes
+  srsran_pdcch_nr_locations_t* ss_locations[SRSRAN_UE_DL_NR_MAX_NOF_SEARCH_SPACE];
+  srsran_pdcch_nr_locations_t* ra_ss_locations;
 
   /// Store Blind-search information from all possible candidate locations for debug purposes
   srsran_ue_dl_nr_pdcch_info_t pdcch_info[SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR];
@@ -77,6 +77,7 @@ public:
   void     write_pdu_bcch_dlsch(uint8_t* payload, uint32_t nof_bytes);
   void     write_pdu_pcch(srsran::unique_byte_buffer_t pdu);
   void     write_pdu_mch(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes);
+  void     write_pdu_slice(uint32_t lcid, srsran::byte_buffer_slice pdu);
 
   // RRC interface
   bool is_suspended(const uint32_t lcid);
@@ -99,6 +99,7 @@ public:
   uint32_t read_pdu(uint8_t* payload, uint32_t nof_bytes) final;
 
   void write_pdu(uint8_t* payload, uint32_t nof_bytes) final;
+  void write_pdu_slice(byte_buffer_slice pdu) final;
 
   /****************************************************************************
    * Metrics
@@ -178,14 +179,16 @@ public:
     explicit rlc_am_base_rx(rlc_am* parent_, srslog::basic_logger& logger_) : parent(parent_), logger(logger_) {}
     virtual ~rlc_am_base_rx() = default;
 
-    virtual bool     configure(const rlc_config_t& cfg_)                   = 0;
-    virtual void     handle_data_pdu(uint8_t* payload, uint32_t nof_bytes) = 0;
-    virtual void     reestablish()                                         = 0;
-    virtual void     stop()                                                = 0;
-    virtual uint32_t get_sdu_rx_latency_ms()                               = 0;
-    virtual uint32_t get_rx_buffered_bytes()                               = 0;
+    // The PDU passed to handle_data_pdu() is a plain view of the caller memory when it is not shared, so it has to
+    // be retained to be buffered
+    virtual bool     configure(const rlc_config_t& cfg_)    = 0;
+    virtual void     handle_data_pdu(byte_buffer_slice pdu) = 0;
+    virtual void     reestablish()                          = 0;
+    virtual void     stop()                                 = 0;
+    virtual uint32_t get_sdu_rx_latency_ms()                = 0;
+    virtual uint32_t get_rx_buffered_bytes()                = 0;
 
-    void write_pdu(uint8_t* payload, uint32_t nof_bytes);
+    void write_pdu(byte_buffer_slice pdu);
 
     srslog::basic_logger& logger;
     byte_buffer_pool*     pool   = nullptr;
@@ -26,6 +26,7 @@
 #include "srsran/adt/circular_map.h"
 #include "srsran/adt/intrusive_list.h"
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/byte_buffer_slice.h"
 #include <array>
 #include <list>
 #include <vector>
@@ -246,14 +247,15 @@ struct rlc_ringbuffer_t : public rlc_ringbuffer_base<T> {
   {
     uint32_t buff_size = 0;
     for (const auto& pdu : window) {
-      if (pdu.second.buf != nullptr) {
-        buff_size += pdu.second.buf->N_bytes;
-      }
+      buff_size += nof_bytes(pdu.second.buf);
     }
     return buff_size;
   }
 
 private:
+  static uint32_t nof_bytes(const unique_byte_buffer_t& buf) { return buf != nullptr ? buf->N_bytes : 0; }
+  static uint32_t nof_bytes(const byte_buffer_slice& buf) { return buf.size(); }
+
   srsran::static_circular_map<uint32_t, T, WINDOW_SIZE> window;
 };
 
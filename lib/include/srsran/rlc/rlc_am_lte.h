@@ -182,9 +182,9 @@ public:
   bool get_do_status();
 
 private:
-  void handle_data_pdu(uint8_t* payload, uint32_t nof_bytes) final;
-  void handle_data_pdu_full(uint8_t* payload, uint32_t nof_bytes, rlc_amd_pdu_header_t& header);
-  void handle_data_pdu_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_pdu_header_t& header);
+  void handle_data_pdu(byte_buffer_slice pdu) final;
+  void handle_data_pdu_full(byte_buffer_slice payload, rlc_amd_pdu_header_t& header);
+  void handle_data_pdu_segment(byte_buffer_slice payload, rlc_amd_pdu_header_t& header);
   void reassemble_rx_sdus();
   bool inside_rx_window(const int16_t sn);
   void debug_state();
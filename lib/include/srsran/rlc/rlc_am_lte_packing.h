@@ -35,9 +35,10 @@ struct rlc_sn_info_t {
 };
 
 struct rlc_amd_rx_pdu {
-  rlc_amd_pdu_header_t header;
-  unique_byte_buffer_t buf;
-  uint32_t             rlc_sn = 0;
+  rlc_amd_pdu_header_t                           header;
+  byte_buffer_slice                              buf; ///< Payload, without the header
+  std::chrono::high_resolution_clock::time_point rx_time;
+  uint32_t                                       rlc_sn = 0;
 
   rlc_amd_rx_pdu() = default;
   explicit rlc_amd_rx_pdu(uint32_t rlc_sn_) : rlc_sn(rlc_sn_) {}
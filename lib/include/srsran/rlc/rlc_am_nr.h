@@ -236,7 +236,7 @@ public:
   void set_tx(rlc_am_nr_tx* tx_) { tx = tx_; }
   bool configure(const rlc_config_t& cfg_) final;
 
-  void handle_data_pdu(uint8_t* payload, uint32_t nof_bytes) final;
+  void handle_data_pdu(byte_buffer_slice pdu) final;
 
   void reestablish() final;
   void stop() final;
@@ -248,7 +248,7 @@ public:
 
   // Data handling methods
   int  handle_full_data_sdu(const rlc_am_nr_pdu_header_t& header, const uint8_t* payload, uint32_t nof_bytes);
-  int  handle_segment_data_sdu(const rlc_am_nr_pdu_header_t& header, const uint8_t* payload, uint32_t nof_bytes);
+  int  handle_segment_data_sdu(const rlc_am_nr_pdu_header_t& header, byte_buffer_slice pdu);
   bool inside_rx_window(uint32_t sn) const;
   bool valid_ack_sn(uint32_t sn) const;
   void write_to_upper_layers(uint32_t lcid, unique_byte_buffer_t sdu);
@@ -56,7 +56,7 @@ struct rlc_amd_pdu_nr_t {
 
 struct rlc_amd_rx_pdu_nr {
   rlc_am_nr_pdu_header_t header = {};
-  unique_byte_buffer_t   buf    = nullptr;
+  byte_buffer_slice      buf; ///< Payload, without the header
   uint32_t               rlc_sn = {};
 
   rlc_amd_rx_pdu_nr() = default;
@@ -25,6 +25,7 @@
 #include "srsran/adt/circular_buffer.h"
 #include "srsran/adt/circular_map.h"
 #include "srsran/adt/intrusive_list.h"
+#include "srsran/common/byte_buffer_slice.h"
 #include "srsran/interfaces/rlc_interface_types.h"
 #include "srsran/rlc/bearer_mem_pool.h"
 #include "srsran/rlc/rlc_metrics.h"
@@ -270,6 +271,15 @@ public:
     }
   }
 
+  void write_pdu_s(byte_buffer_slice pdu)
+  {
+    if (suspended) {
+      queue_rx_pdu(pdu.data(), pdu.size());
+    } else {
+      write_pdu_slice(std::move(pdu));
+    }
+  }
+
   void write_sdu_s(unique_byte_buffer_t sdu)
   {
     if (suspended) {
@@ -297,6 +307,8 @@ public:
   virtual void     get_buffer_state(uint32_t& tx_queue, uint32_t& prio_tx_queue) = 0;
   virtual uint32_t read_pdu(uint8_t* payload, uint32_t nof_bytes)                = 0;
   virtual void     write_pdu(uint8_t* payload, uint32_t nof_bytes)               = 0;
+  // Bearers that buffer received PDUs override this to keep them as slices of the transport block, without copies
+  virtual void write_pdu_slice(byte_buffer_slice pdu) { write_pdu(pdu.data(), pdu.size()); }
 
   virtual void set_bsr_callback(bsr_callback_t callback) = 0;
 
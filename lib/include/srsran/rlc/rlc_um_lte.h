@@ -30,6 +30,7 @@
 #include <mutex>
 #include <pthread.h>
 #include <queue>
+#include <vector>
 
 namespace srsran {
 
@@ -57,13 +58,23 @@ private:
     rlc_um_lte_tx(rlc_um_base* parent_);
 
     bool     configure(const rlc_config_t& cfg, std::string rb_name);
-    uint32_t build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes);
+    uint32_t pack_data_pdu(uint8_t* payload, uint32_t nof_bytes);
     void     discard_sdu(uint32_t discard_sn);
     uint32_t get_buffer_state();
     bool     sdu_queue_is_full();
 
   private:
     void reset();
+    void add_tx_segment(uint32_t to_move);
+
+    // SDU segments of the PDU being built. They are gathered into the MAC buffer once the header is known, so the
+    // SDUs that were completely consumed are kept alive until then
+    struct tx_segment_t {
+      const uint8_t*       ptr = nullptr;
+      uint32_t             len = 0;
+      unique_byte_buffer_t sdu;
+    };
+    std::vector<tx_segment_t> tx_segments;
 
     /****************************************************************************
      * State variables and counters
@@ -127,7 +138,8 @@ void rlc_um_read_data_pdu_header(uint8_t*              payload,
                                  uint32_t              nof_bytes,
                                  rlc_umd_sn_size_t     sn_size,
                                  rlc_umd_pdu_header_t* header);
-void rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, byte_buffer_t* pdu);
+void     rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, byte_buffer_t* pdu);
+uint32_t rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, uint8_t* payload);
 
 uint32_t rlc_um_packed_length(rlc_umd_pdu_header_t* header);
 bool     rlc_um_start_aligned(uint8_t fi);
@@ -61,7 +61,7 @@ private:
     rlc_um_nr_tx(rlc_um_base* parent_);
 
     bool     configure(const rlc_config_t& cfg, std::string rb_name);
-    uint32_t build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes);
+    uint32_t pack_data_pdu(uint8_t* payload, uint32_t nof_bytes);
     void     discard_sdu(uint32_t discard_sn);
     uint32_t get_buffer_state();
 
@@ -151,6 +151,7 @@ uint32_t rlc_um_nr_read_data_pdu_header(const uint8_t*            payload,
                                         rlc_um_nr_pdu_header_t*   header);
 
 uint32_t rlc_um_nr_write_data_pdu_header(const rlc_um_nr_pdu_header_t& header, byte_buffer_t* pdu);
+uint32_t rlc_um_nr_write_data_pdu_header(const rlc_um_nr_pdu_header_t& header, uint8_t* payload);
 
 uint32_t rlc_um_nr_packed_length(const rlc_um_nr_pdu_header_t& header);
 
@@ -23,46 +23,114 @@
  * @file byte_buffer_queue.h
  *
  * @brief Queue of unique pointers to byte buffers used in PDCP and RLC TX queues.
- *        Uses a blocking queue with bounded capacity to block higher layers
- *        when pushing uplink traffic
+ *        Pushing and popping does not take any lock, so the PDCP writing SDUs does not contend with the MAC
+ *        reading PDUs and polling the buffer state from the PHY workers. The number of queued SDUs and bytes are
+ *        kept in atomic counters. Writers only block higher layers when the bounded capacity is reached.
  */
 
 #ifndef SRSRAN_BYTE_BUFFERQUEUE_H
 #define SRSRAN_BYTE_BUFFERQUEUE_H
 
-#include "srsran/adt/circular_buffer.h"
-#include "srsran/common/block_queue.h"
+#include "srsran/adt/expected.h"
+#include "srsran/adt/lockfree_bounded_queue.h"
 #include "srsran/common/byte_buffer.h"
 #include "srsran/common/common.h"
-#include <functional>
-#include <pthread.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 
 namespace srsran {
 
 class byte_buffer_queue
 {
 public:
-  byte_buffer_queue(int capacity = 128) :
-    queue(capacity, push_callback(unread_bytes, n_sdus), pop_callback(unread_bytes, n_sdus))
-  {}
+  byte_buffer_queue(int capacity = 128) : queue(capacity) {}
 
-  void write(unique_byte_buffer_t msg) { queue.push_blocking(std::move(msg)); }
+  /// Writes the SDU, blocking while the queue is full
+  void write(unique_byte_buffer_t msg)
+  {
+    while (true) {
+      srsran::error_type<unique_byte_buffer_t> ret = try_write(std::move(msg));
+      if (ret) {
+        return;
+      }
+      msg = std::move(ret.error());
+      wait_until(cvar_not_full, nof_writers_waiting, [this]() { return not queue.full(); });
+    }
+  }
 
   srsran::error_type<unique_byte_buffer_t> try_write(unique_byte_buffer_t&& msg)
   {
-    return queue.try_push(std::move(msg));
+    // Counters are updated before the SDU becomes visible, so readers never see them lag behind the queue
+    uint32_t nof_bytes = msg->N_bytes;
+    unread_bytes.fetch_add(nof_bytes, std::memory_order_relaxed);
+    n_sdus.fetch_add(1, std::memory_order_relaxed);
+    if (not queue.try_push(std::move(msg))) {
+      unread_bytes.fetch_sub(nof_bytes, std::memory_order_relaxed);
+      n_sdus.fetch_sub(1, std::memory_order_relaxed);
+      return std::move(msg);
+    }
+    notify(cvar_not_empty, nof_readers_waiting);
+    return {};
+  }
+
+  /// Writes as many of the nof_msgs SDUs as fit in the queue, with a single reservation of queue positions
+  /// @return number of SDUs written, which are moved from
+  uint32_t try_write_batch(unique_byte_buffer_t* msgs, uint32_t nof_msgs)
+  {
+    uint32_t nof_bytes = 0;
+    for (uint32_t i = 0; i < nof_msgs; ++i) {
+      nof_bytes += msgs[i]->N_bytes;
+    }
+    unread_bytes.fetch_add(nof_bytes, std::memory_order_relaxed);
+    n_sdus.fetch_add(nof_msgs, std::memory_order_relaxed);
+
+    // The SDUs that are not written keep their pointer, discount them
+    uint32_t nof_written    = queue.try_push_batch(msgs, nof_msgs);
+    uint32_t nof_bytes_left = 0;
+    for (uint32_t i = nof_written; i < nof_msgs; ++i) {
+      nof_bytes_left += msgs[i]->N_bytes;
+    }
+    unread_bytes.fetch_sub(nof_bytes_left, std::memory_order_relaxed);
+    n_sdus.fetch_sub(nof_msgs - nof_written, std::memory_order_relaxed);
+
+    if (nof_written > 0) {
+      notify(cvar_not_empty, nof_readers_waiting);
+    }
+    return nof_written;
   }
 
-  unique_byte_buffer_t read() { return queue.pop_blocking(); }
+  /// Reads an SDU, blocking while the queue is empty. Discarded SDUs are read as nullptr
+  unique_byte_buffer_t read()
+  {
+    unique_byte_buffer_t msg;
+    while (not try_read(&msg)) {
+      wait_until(cvar_not_empty, nof_readers_waiting, [this]() { return not queue.empty(); });
+    }
+    return msg;
+  }
 
-  bool try_read(unique_byte_buffer_t* msg) { return queue.try_pop(*msg); }
+  bool try_read(unique_byte_buffer_t* msg)
+  {
+    if (not queue.try_pop(*msg)) {
+      return false;
+    }
+    if (*msg != nullptr) {
+      unread_bytes.fetch_sub((*msg)->N_bytes, std::memory_order_relaxed);
+      n_sdus.fetch_sub(1, std::memory_order_relaxed);
+    }
+    notify(cvar_not_full, nof_writers_waiting);
+    return true;
+  }
 
+  /// Changes the capacity, it requires an empty queue and no concurrent access
   void     resize(uint32_t capacity) { queue.set_size(capacity); }
   uint32_t size() { return (uint32_t)queue.size(); }
-  uint32_t get_n_sdus() { return n_sdus; }
+  uint32_t get_n_sdus() { return n_sdus.load(std::memory_order_relaxed); }
 
-  uint32_t size_bytes() { return unread_bytes; }
+  uint32_t size_bytes() { return unread_bytes.load(std::memory_order_relaxed); }
 
+  /// Size of the SDU at the front of the queue. Must be called from the reader side
   uint32_t size_tail_bytes()
   {
     uint32_t size_next = 0;
@@ -74,55 +142,58 @@ public:
     return size_next;
   }
 
-  // This is a hack to reset N_bytes counter when queue is corrupted (see line 89)
-  void reset() { unread_bytes = 0; }
-
   bool is_empty() { return queue.empty(); }
 
   bool is_full() { return queue.full(); }
 
+  /// Discards the first queued SDU for which func returns true, leaving a nullptr in its place. Must be called from
+  /// the reader side, i.e. not concurrently with read() or try_read()
   template <typename F>
-  bool apply_first(const F& func)
+  bool discard_first(const F& func)
   {
-    return queue.apply_first(func);
+    return queue.apply_first([this, &func](unique_byte_buffer_t& msg) {
+      if (msg == nullptr or not func(msg)) {
+        return false;
+      }
+      unread_bytes.fetch_sub(msg->N_bytes, std::memory_order_relaxed);
+      n_sdus.fetch_sub(1, std::memory_order_relaxed);
+      msg.reset();
+      return true;
+    });
   }
 
 private:
-  struct push_callback {
-    explicit push_callback(std::atomic<uint32_t>& unread_bytes_, std::atomic<uint32_t>& n_sdus_) :
-      unread_bytes(unread_bytes_), n_sdus(n_sdus_)
-    {}
-    void operator()(const unique_byte_buffer_t& msg)
-    {
-      unread_bytes.fetch_add(msg->N_bytes, std::memory_order_relaxed);
-      n_sdus.fetch_add(1, std::memory_order_relaxed);
+  // Slow path of the blocking calls, the waiter counters avoid touching the mutex when nobody is waiting
+  template <typename Pred>
+  void wait_until(std::condition_variable& cvar, std::atomic<uint32_t>& nof_waiting, const Pred& ready)
+  {
+    std::unique_lock<std::mutex> lock(wait_mutex);
+    nof_waiting.fetch_add(1);
+    while (not ready()) {
+      cvar.wait(lock);
     }
-    std::atomic<uint32_t>& unread_bytes;
-    std::atomic<uint32_t>& n_sdus;
-  };
-  struct pop_callback {
-    explicit pop_callback(std::atomic<uint32_t>& unread_bytes_, std::atomic<uint32_t>& n_sdus_) :
-      unread_bytes(unread_bytes_), n_sdus(n_sdus_)
-    {}
-    void operator()(const unique_byte_buffer_t& msg)
-    {
-      if (msg == nullptr) {
-        return;
-      }
-      // non-atomic update of both state variables
-      unread_bytes.fetch_sub(std::min(msg->N_bytes, unread_bytes.load(std::memory_order_relaxed)),
-                             std::memory_order_relaxed);
-      n_sdus.store(std::max(0, (int32_t)(n_sdus.load(std::memory_order_relaxed)) - 1), std::memory_order_relaxed);
+    nof_waiting.fetch_sub(1);
+  }
+
+  void notify(std::condition_variable& cvar, std::atomic<uint32_t>& nof_waiting)
+  {
+    // Orders the queue update before checking for waiters, pairs with the increment in wait_until()
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (nof_waiting.load(std::memory_order_relaxed) > 0) {
+      std::lock_guard<std::mutex> lock(wait_mutex);
+      cvar.notify_one();
     }
-    std::atomic<uint32_t>& unread_bytes;
-    std::atomic<uint32_t>& n_sdus;
-  };
+  }
+
+  lockfree_bounded_queue<unique_byte_buffer_t> queue;
 
   std::atomic<uint32_t> unread_bytes = {0};
   std::atomic<uint32_t> n_sdus       = {0};
 
-public:
-  dyn_blocking_queue<unique_byte_buffer_t, push_callback, pop_callback> queue;
+  std::mutex              wait_mutex;
+  std::condition_variable cvar_not_empty, cvar_not_full;
+  std::atomic<uint32_t>   nof_readers_waiting = {0};
+  std::atomic<uint32_t>   nof_writers_waiting = {0};
 };
 
 } // namespace srsran
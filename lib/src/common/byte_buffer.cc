@@ -20,7 +20,9 @@
  */
 
 #include "srsran/common/byte_buffer.h"
+#include "srsran/adt/pool/batch_mem_pool.h"
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/byte_buffer_slice.h"
 
 namespace srsran {
 
@@ -45,4 +47,55 @@ void byte_buffer_t::operator delete(void* ptr)
   byte_buffer_pool::get_instance()->deallocate_node(ptr);
 }
 
+namespace {
+
+background_mem_pool* get_shared_byte_buffer_pool();
+
+/// Reference-counted holder of a byte buffer shared by several slices
+class shared_byte_buffer final : public shared_buffer_ref
+{
+public:
+  explicit shared_byte_buffer(unique_byte_buffer_t buf_) : buf(std::move(buf_)) {}
+
+  void* operator new(size_t sz) { return get_shared_byte_buffer_pool()->allocate_node(sz); }
+  void  operator delete(void* ptr) { get_shared_byte_buffer_pool()->deallocate_node(ptr); }
+
+private:
+  void release_buffer() override { delete this; }
+
+  unique_byte_buffer_t buf;
+};
+
+background_mem_pool* get_shared_byte_buffer_pool()
+{
+  static background_mem_pool pool(64, sizeof(shared_byte_buffer), 16);
+  return &pool;
+}
+
+} // namespace
+
+byte_buffer_slice make_shared_slice(unique_byte_buffer_t buf)
+{
+  if (buf == nullptr) {
+    return {};
+  }
+  uint8_t*            ptr    = buf->msg;
+  uint32_t            len    = buf->N_bytes;
+  shared_byte_buffer* shared = new shared_byte_buffer(std::move(buf));
+  return byte_buffer_slice(shared, ptr, len);
+}
+
+byte_buffer_slice retain_slice(byte_buffer_slice slice)
+{
+  if (slice.is_shared()) {
+    return slice;
+  }
+  unique_byte_buffer_t buf = make_byte_buffer();
+  if (buf == nullptr || slice.size() > buf->get_tailroom()) {
+    return {};
+  }
+  buf->append_bytes(slice.data(), slice.size());
+  return make_shared_slice(std::move(buf));
+}
+
 } // namespace srsran
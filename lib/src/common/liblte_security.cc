@@ -1272,6 +1272,112 @@ liblte_security_milenage_f2345(uint8* k, uint8* op_c, uint8* rand, uint8* res, u
   return (err);
 }
 
+/*********************************************************************
+    Name: liblte_security_milenage_f12345
+
+    Description: Milenage security functions F1, F2, F3, F4, and F5
+                 for a batch of authentication vectors sharing the
+                 same key K. Computes MAC-A, RES, CK, IK and AK for
+                 every pair of random challenge RAND and sequence
+                 number SQN. The round keys and TEMP are computed
+                 once per vector instead of once per function.
+
+    Document Reference: 35.206 v10.0.0 Annex 3
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_security_milenage_f12345(uint8* k,
+                                                  uint8* op_c,
+                                                  uint32 nof_vectors,
+                                                  uint8* rand,
+                                                  uint8* sqn,
+                                                  uint8* amf,
+                                                  uint8* mac_a,
+                                                  uint8* res,
+                                                  uint8* ck,
+                                                  uint8* ik,
+                                                  uint8* ak)
+{
+  LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+  aes_context       ctx;
+  uint32            i;
+  uint32            n;
+  uint8             temp[LIBLTE_SECURITY_MILENAGE_MAX_BATCH][16];
+  uint8             out[16];
+  uint8             input[16];
+
+  if (k != NULL && op_c != NULL && rand != NULL && sqn != NULL && amf != NULL && mac_a != NULL && res != NULL &&
+      ck != NULL && ik != NULL && ak != NULL && nof_vectors <= LIBLTE_SECURITY_MILENAGE_MAX_BATCH) {
+    // Initialize the round keys
+    aes_setkey_enc(&ctx, k, 128);
+
+    // Compute temp of all the vectors back to back
+    for (n = 0; n < nof_vectors; n++) {
+      for (i = 0; i < 16; i++) {
+        input[i] = rand[16 * n + i] ^ op_c[i];
+      }
+      aes_crypt_ecb(&ctx, AES_ENCRYPT, input, temp[n]);
+    }
+
+    for (n = 0; n < nof_vectors; n++) {
+      // Compute out1 for MAC-A, in1 = SQN || AMF || SQN || AMF rotated by r1 = 64 bits
+      for (i = 0; i < 6; i++) {
+        input[i + 8] = sqn[6 * n + i] ^ op_c[i];
+        input[i]     = sqn[6 * n + i] ^ op_c[i + 8];
+      }
+      for (i = 0; i < 2; i++) {
+        input[i + 14] = amf[i] ^ op_c[i + 6];
+        input[i + 6]  = amf[i] ^ op_c[i + 14];
+      }
+      for (i = 0; i < 16; i++) {
+        input[i] ^= temp[n][i];
+      }
+      aes_crypt_ecb(&ctx, AES_ENCRYPT, input, out);
+      for (i = 0; i < 8; i++) {
+        mac_a[8 * n + i] = out[i] ^ op_c[i];
+      }
+
+      // Compute out for RES and AK
+      for (i = 0; i < 16; i++) {
+        input[i] = temp[n][i] ^ op_c[i];
+      }
+      input[15] ^= 1;
+      aes_crypt_ecb(&ctx, AES_ENCRYPT, input, out);
+      for (i = 0; i < 16; i++) {
+        out[i] ^= op_c[i];
+      }
+      for (i = 0; i < 8; i++) {
+        res[8 * n + i] = out[i + 8];
+      }
+      for (i = 0; i < 6; i++) {
+        ak[6 * n + i] = out[i];
+      }
+
+      // Compute out for CK
+      for (i = 0; i < 16; i++) {
+        input[(i + 12) % 16] = temp[n][i] ^ op_c[i];
+      }
+      input[15] ^= 2;
+      aes_crypt_ecb(&ctx, AES_ENCRYPT, input, out);
+      for (i = 0; i < 16; i++) {
+        ck[16 * n + i] = out[i] ^ op_c[i];
+      }
+
+      // Compute out for IK
+      for (i = 0; i < 16; i++) {
+        input[(i + 8) % 16] = temp[n][i] ^ op_c[i];
+      }
+      input[15] ^= 4;
+      aes_crypt_ecb(&ctx, AES_ENCRYPT, input, out);
+      for (i = 0; i < 16; i++) {
+        ik[16 * n + i] = out[i] ^ op_c[i];
+      }
+    }
+
+    err = LIBLTE_SUCCESS;
+  }
+
+  return (err);
+}
+
 /*********************************************************************
     Name: liblte_security_milenage_f5_star
 
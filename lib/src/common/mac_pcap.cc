@@ -31,25 +31,25 @@ mac_pcap::~mac_pcap()
   close();
 }
 
-uint32_t mac_pcap::open(std::string filename_, uint32_t ue_id_)
+uint32_t mac_pcap::open(std::string filename_, uint32_t ue_id_, const pcap_file_args_t& args)
 {
   std::lock_guard<std::mutex> lock(mutex);
-  if (pcap_file != nullptr) {
+  if (pcap_file.is_open()) {
     logger.error("PCAP writer for %s already running. Close first.", filename_.c_str());
     return SRSRAN_ERROR;
   }
 
   // set UDP DLT
-  dlt       = UDP_DLT;
-  pcap_file = DLT_PCAP_Open(dlt, filename_.c_str());
-  if (pcap_file == nullptr) {
+  dlt = UDP_DLT;
+  if (not pcap_file.open(filename_, dlt, args)) {
     logger.error("Couldn't open %s to write PCAP", filename_.c_str());
     return SRSRAN_ERROR;
   }
 
-  filename = filename_;
-  ue_id    = ue_id_;
-  running  = true;
+  filename        = filename_;
+  ue_id           = ue_id_;
+  max_payload_len = args.max_payload_len;
+  running         = true;
 
   // start writer thread
   start();
@@ -61,43 +61,55 @@ uint32_t mac_pcap::close()
 {
   {
     std::lock_guard<std::mutex> lock(mutex);
-    if (running == false || pcap_file == nullptr) {
+    if (running == false) {
       return SRSRAN_ERROR;
     }
 
-    // tell writer thread to stop
-    running        = false;
-    pcap_pdu_t pdu = {};
-    queue.push_blocking(std::move(pdu));
+    // tell writer thread to stop, it writes the pending PDUs before exiting
+    running = false;
   }
 
+  // The writer thread is joined even if the file is no longer open, e.g. after a failed rotation
+  wake_up_writer();
   wait_thread_finish();
 
   // close file handle
   {
     std::lock_guard<std::mutex> lock(mutex);
-    srsran::console("Saving MAC PCAP (DLT=%d) to %s\n", dlt, filename.c_str());
-    DLT_PCAP_Close(pcap_file);
-    pcap_file = nullptr;
+    if (not pcap_file.is_open()) {
+      logger.error("MAC PCAP %s was closed before the end of the capture", filename.c_str());
+      return SRSRAN_ERROR;
+    }
+    if (pcap_file.get_nof_files() > 1) {
+      srsran::console("Saving MAC PCAP (DLT=%d) to %s (%d files)\n", dlt, filename.c_str(), pcap_file.get_nof_files());
+    } else {
+      srsran::console("Saving MAC PCAP (DLT=%d) to %s\n", dlt, filename.c_str());
+    }
+    pcap_file.close();
   }
 
   return SRSRAN_SUCCESS;
 }
 
-void mac_pcap::write_pdu(srsran::mac_pcap_base::pcap_pdu_t& pdu)
+bool mac_pcap::write_pdu(srsran::mac_pcap_base::pcap_pdu_t& pdu)
 {
-  if (pdu.pdu != nullptr) {
-    switch (pdu.rat) {
-      case srsran_rat_t::lte:
-        LTE_PCAP_MAC_UDP_WritePDU(pcap_file, &pdu.context, pdu.pdu->msg, pdu.pdu->N_bytes);
-        break;
-      case srsran_rat_t::nr:
-        NR_PCAP_MAC_UDP_WritePDU(pcap_file, &pdu.context_nr, pdu.pdu->msg, pdu.pdu->N_bytes);
-        break;
-      default:
-        logger.error("Error writing PDU to PCAP. Unsupported RAT selected.");
-    }
+  if (pdu.pdu == nullptr) {
+    return false;
+  }
+  uint8_t header[PCAP_CONTEXT_HEADER_MAX] = {};
+  int     header_len                      = 0;
+  switch (pdu.rat) {
+    case srsran_rat_t::lte:
+      header_len = LTE_PCAP_PACK_MAC_UDP_HEADER_TO_BUFFER(&pdu.context, header, pdu.orig_len);
+      break;
+    case srsran_rat_t::nr:
+      header_len = NR_PCAP_PACK_MAC_UDP_HEADER_TO_BUFFER(&pdu.context_nr, header, pdu.orig_len);
+      break;
+    default:
+      logger.error("Error writing PDU to PCAP. Unsupported RAT selected.");
+      return false;
   }
+  return pcap_file.write_packet(pdu.ts, header, header_len, pdu.pdu->msg, pdu.pdu->N_bytes, pdu.orig_len);
 }
 
 } // namespace srsran
\ No newline at end of file
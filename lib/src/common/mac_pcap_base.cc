@@ -23,7 +23,9 @@
 #include "srsran/config.h"
 #include "srsran/phy/common/phy_common.h"
 #include "srsran/support/emergency_handlers.h"
+#include <algorithm>
 #include <stdint.h>
+#include <sys/time.h>
 
 namespace srsran {
 
@@ -33,7 +35,8 @@ static void emergency_cleanup_handler(void* data)
   reinterpret_cast<mac_pcap_base*>(data)->close();
 }
 
-mac_pcap_base::mac_pcap_base() : logger(srslog::fetch_basic_logger("MAC")), thread("PCAP_WRITER_MAC")
+mac_pcap_base::mac_pcap_base() :
+  logger(srslog::fetch_basic_logger("MAC")), thread("PCAP_WRITER_MAC"), queue(queue_size)
 {
   emergency_handler_id = add_emergency_cleanup_handler(emergency_cleanup_handler, this);
 }
@@ -57,26 +60,97 @@ void mac_pcap_base::set_ue_id(uint16_t ue_id_)
   ue_id = ue_id_;
 }
 
+void mac_pcap_base::set_max_payload_len(uint32_t max_payload_len_)
+{
+  max_payload_len = max_payload_len_;
+}
+
+void mac_pcap_base::get_metrics(pcap_metrics_t& metrics) const
+{
+  metrics.nof_written_pdus  = nof_written_pdus.load(std::memory_order_relaxed);
+  metrics.nof_written_bytes = nof_written_bytes.load(std::memory_order_relaxed);
+  metrics.nof_dropped_pdus  = nof_dropped_pdus.load(std::memory_order_relaxed);
+}
+
 void mac_pcap_base::run_thread()
 {
-  // blocking write until stopped
-  while (running) {
-    pcap_pdu_t pdu = queue.pop_blocking();
+  pcap_pdu_t pdu = {};
+  bool       stop;
+  do {
+    // read the flag before draining, so that the PDUs queued before close() are always written
+    stop = not running;
+
+    uint32_t nof_pdus    = 0;
+    uint32_t nof_written = 0;
+    uint64_t nof_bytes   = 0;
     {
       std::lock_guard<std::mutex> lock(mutex);
-      write_pdu(pdu);
+      while (nof_pdus < max_batch_size and queue.try_pop(pdu)) {
+        uint32_t pdu_len = pdu.pdu->N_bytes;
+        if (write_pdu(pdu)) {
+          nof_written++;
+          nof_bytes += pdu_len;
+        }
+        pdu.pdu.reset();
+        nof_pdus++;
+      }
+    }
+    nof_written_pdus.fetch_add(nof_written, std::memory_order_relaxed);
+    nof_written_bytes.fetch_add(nof_bytes, std::memory_order_relaxed);
+    nof_dropped_pdus.fetch_add(nof_pdus - nof_written, std::memory_order_relaxed);
+
+    if (nof_pdus == 0 and not stop) {
+      // Sleep until a PDU is queued or the writer is closed
+      std::unique_lock<std::mutex> lock(writer_mutex);
+      writer_waiting = true;
+      writer_cvar.wait_for(lock, std::chrono::milliseconds(max_wait_ms), [this]() {
+        return not queue.empty() or not running;
+      });
+      writer_waiting = false;
     }
+  } while (not stop or not queue.empty());
+}
+
+void mac_pcap_base::wake_up_writer()
+{
+  // The producers only take the lock if the writer is waiting, which is rare under load
+  if (writer_waiting) {
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    writer_cvar.notify_one();
+  }
+}
+
+// Function called from PHY worker context, the PDU queue is lock-free
+bool mac_pcap_base::alloc_and_queue(pcap_pdu_t& pdu, const uint8_t* payload, uint32_t payload_len)
+{
+  gettimeofday(&pdu.ts, nullptr);
+  pdu.orig_len = payload_len;
+
+  uint32_t max_len = max_payload_len.load(std::memory_order_relaxed);
+  if (max_len > 0) {
+    payload_len = std::min(payload_len, max_len);
   }
 
-  // write remainder of queue
-  pcap_pdu_t pdu = {};
-  while (queue.try_pop(pdu)) {
-    std::lock_guard<std::mutex> lock(mutex);
-    write_pdu(pdu);
+  // try to allocate PDU buffer
+  pdu.pdu = srsran::make_byte_buffer();
+  if (pdu.pdu == nullptr || pdu.pdu->get_tailroom() < payload_len) {
+    nof_dropped_pdus.fetch_add(1, std::memory_order_relaxed);
+    logger.warning("Dropping PDU in PCAP. No buffer available or not enough space (pdu_len=%d).", payload_len);
+    return false;
+  }
+
+  // copy payload into PDU buffer
+  memcpy(pdu.pdu->msg, payload, payload_len);
+  pdu.pdu->N_bytes = payload_len;
+  if (not queue.try_push(std::move(pdu))) {
+    nof_dropped_pdus.fetch_add(1, std::memory_order_relaxed);
+    logger.warning("Dropping PDU (%d B) in PCAP. Write queue full.", payload_len);
+    return false;
   }
+  wake_up_writer();
+  return true;
 }
 
-// Function called from PHY worker context, locking not needed as PDU queue is thread-safe
 void mac_pcap_base::pack_and_queue(uint8_t* payload,
                                    uint32_t payload_len,
                                    uint16_t ue_id,
@@ -101,23 +175,10 @@ void mac_pcap_base::pack_and_queue(uint8_t* payload,
     pdu.context.cc_idx         = cc_idx;
     pdu.context.sysFrameNumber = (uint16_t)(tti / 10);
     pdu.context.subFrameNumber = (uint16_t)(tti % 10);
-
-    // try to allocate PDU buffer
-    pdu.pdu = srsran::make_byte_buffer();
-    if (pdu.pdu != nullptr && pdu.pdu->get_tailroom() >= payload_len) {
-      // copy payload into PDU buffer
-      memcpy(pdu.pdu->msg, payload, payload_len);
-      pdu.pdu->N_bytes = payload_len;
-      if (not queue.try_push(std::move(pdu))) {
-        logger.warning("Dropping PDU (%d B) in PCAP. Write queue full.", payload_len);
-      }
-    } else {
-      logger.warning("Dropping PDU in PCAP. No buffer available or not enough space (pdu_len=%d).", payload_len);
-    }
+    alloc_and_queue(pdu, payload, payload_len);
   }
 }
 
-// Function called from PHY worker context, locking not needed as PDU queue is thread-safe
 void mac_pcap_base::pack_and_queue_nr(uint8_t* payload,
                                       uint32_t payload_len,
                                       uint32_t tti,
@@ -138,19 +199,7 @@ void mac_pcap_base::pack_and_queue_nr(uint8_t* payload,
     pdu.context_nr.harqid              = harqid;
     pdu.context_nr.system_frame_number = tti / 10;
     pdu.context_nr.sub_frame_number    = tti % 10;
-
-    // try to allocate PDU buffer
-    pdu.pdu = srsran::make_byte_buffer();
-    if (pdu.pdu != nullptr && pdu.pdu->get_tailroom() >= payload_len) {
-      // copy payload into PDU buffer
-      memcpy(pdu.pdu->msg, payload, payload_len);
-      pdu.pdu->N_bytes = payload_len;
-      if (not queue.try_push(std::move(pdu))) {
-        logger.warning("Dropping PDU (%d B) in NR PCAP. Write queue full.", payload_len);
-      }
-    } else {
-      logger.warning("Dropping PDU in NR PCAP. No buffer available or not enough space (pdu_len=%d).", payload_len);
-    }
+    alloc_and_queue(pdu, payload, payload_len);
   }
 }
 
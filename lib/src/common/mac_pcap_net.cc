@@ -79,12 +79,11 @@ uint32_t mac_pcap_net::close()
       return SRSRAN_ERROR;
     }
 
-    // tell writer thread to stop
-    running        = false;
-    pcap_pdu_t pdu = {};
-    queue.push_blocking(std::move(pdu));
+    // tell writer thread to stop, it writes the pending PDUs before exiting
+    running = false;
   }
 
+  wake_up_writer();
   wait_thread_finish();
   // close socket handle
   if (socket.is_open()) {
@@ -95,23 +94,22 @@ uint32_t mac_pcap_net::close()
   return SRSRAN_SUCCESS;
 }
 
-void mac_pcap_net::write_pdu(pcap_pdu_t& pdu)
+bool mac_pcap_net::write_pdu(pcap_pdu_t& pdu)
 {
   if (pdu.pdu != nullptr && socket.is_open()) {
     switch (pdu.rat) {
       case srsran_rat_t::lte:
-        write_mac_lte_pdu_to_net(pdu);
-        break;
+        return write_mac_lte_pdu_to_net(pdu);
       case srsran_rat_t::nr:
-        write_mac_nr_pdu_to_net(pdu);
-        break;
+        return write_mac_nr_pdu_to_net(pdu);
       default:
         logger.error("Error writing PDU to PCAP socket. Unsupported RAT selected.");
     }
   }
+  return false;
 }
 
-void mac_pcap_net::write_mac_lte_pdu_to_net(pcap_pdu_t& pdu)
+bool mac_pcap_net::write_mac_lte_pdu_to_net(pcap_pdu_t& pdu)
 {
   int      bytes_sent;
   uint32_t offset = 0;
@@ -125,7 +123,7 @@ void mac_pcap_net::write_mac_lte_pdu_to_net(pcap_pdu_t& pdu)
 
   if (pdu.pdu.get()->get_headroom() < offset) {
     logger.error("PDU headroom is to small for adding context buffer");
-    return;
+    return false;
   }
 
   pdu.pdu.get()->msg -= offset;
@@ -142,10 +140,12 @@ void mac_pcap_net::write_mac_lte_pdu_to_net(pcap_pdu_t& pdu)
   if ((int)pdu.pdu.get()->N_bytes != bytes_sent || bytes_sent < 0) {
     logger.error(
         "Sending UDP packet mismatches %d != %d (err %s)", pdu.pdu.get()->N_bytes, bytes_sent, strerror(errno));
+    return false;
   }
+  return true;
 }
 
-void mac_pcap_net::write_mac_nr_pdu_to_net(pcap_pdu_t& pdu)
+bool mac_pcap_net::write_mac_nr_pdu_to_net(pcap_pdu_t& pdu)
 {
   int      bytes_sent;
   uint32_t offset = 0;
@@ -159,7 +159,7 @@ void mac_pcap_net::write_mac_nr_pdu_to_net(pcap_pdu_t& pdu)
 
   if (pdu.pdu.get()->get_headroom() < offset) {
     logger.error("PDU headroom is to small for adding context buffer");
-    return;
+    return false;
   }
 
   pdu.pdu.get()->msg -= offset;
@@ -176,6 +176,8 @@ void mac_pcap_net::write_mac_nr_pdu_to_net(pcap_pdu_t& pdu)
   if ((int)pdu.pdu.get()->N_bytes != bytes_sent || bytes_sent < 0) {
     logger.error(
         "Sending UDP packet mismatches %d != %d (err %s)", pdu.pdu.get()->N_bytes, bytes_sent, strerror(errno));
+    return false;
   }
+  return true;
 }
 } // namespace srsran
\ No newline at end of file
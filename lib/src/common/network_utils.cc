@@ -22,6 +22,8 @@
 #include "srsran/common/network_utils.h"
 
 #include <netinet/sctp.h>
+#include <array>
+#include <sys/epoll.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <unistd.h> // for the pipe
@@ -356,6 +358,13 @@ socket_manager::socket_manager() : thread("RXsockets"), socket_manager_itf(srslo
   // register control pipe fd
   int fd = pipe(pipefd);
   srsran_assert(fd != -1, "Failed to open control pipe");
+  epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  srsran_assert(epoll_fd != -1, "Failed to create epoll instance");
+  epoll_event ev = {};
+  ev.events      = EPOLLIN;
+  ev.data.fd     = pipefd[0];
+  fd             = epoll_ctl(epoll_fd, EPOLL_CTL_ADD, pipefd[0], &ev);
+  srsran_assert(fd != -1, "Failed to register control pipe in epoll");
   start(thread_prio);
 }
 
@@ -387,6 +396,10 @@ void socket_manager::stop()
     pipefd[1] = -1;
     rxSockDebug("closed.");
   }
+  if (epoll_fd >= 0) {
+    close(epoll_fd);
+    epoll_fd = -1;
+  }
 }
 
 bool socket_manager::add_socket_handler(int fd, recv_callback_t handler)
@@ -451,68 +464,65 @@ bool socket_manager::remove_socket(int fd)
   return result;
 }
 
-std::map<int, socket_manager::recv_callback_t>::iterator
-socket_manager::remove_socket_unprotected(int fd, fd_set* total_fd_set, int* max_fd)
+void socket_manager::remove_socket_unprotected(int fd)
 {
   if (fd < 0) {
     rxSockError("fd to be removed is not valid");
-    return active_sockets.end();
+    return;
+  }
+  active_sockets.erase(fd);
+  if (epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr) == -1) {
+    // The fd may have been closed already, which also removes it from the epoll set
+    rxSockDebug("Socket fd=%d was not in the epoll set: %s", fd, strerror(errno));
   }
-  auto it = active_sockets.find(fd);
-  it      = active_sockets.erase(it);
-  FD_CLR(fd, total_fd_set);
-  // assumes ordering
-  *max_fd = (active_sockets.empty()) ? pipefd[0] : std::max(pipefd[0], active_sockets.rbegin()->first);
   rxSockDebug("Socket fd=%d has been successfully removed", fd);
-  return it;
 }
 
 void socket_manager::run_thread()
 {
   running = true;
-  fd_set total_fd_set, read_fd_set;
-  FD_ZERO(&total_fd_set);
-  int max_fd = 0;
-
-  FD_SET(pipefd[0], &total_fd_set);
-  max_fd = std::max(pipefd[0], max_fd);
+  std::array<epoll_event, max_rx_events> events;
 
   while (running.load(std::memory_order_relaxed)) {
-    memcpy(&read_fd_set, &total_fd_set, sizeof(total_fd_set));
-    int n = select(max_fd + 1, &read_fd_set, nullptr, nullptr, nullptr);
+    int n = epoll_wait(epoll_fd, events.data(), events.size(), -1);
 
-    // handle select return
+    // handle epoll_wait return
     if (n == -1) {
-      rxSockError("Error from select(%d,...). Number of rx sockets: %d", max_fd + 1, (int)active_sockets.size() + 1);
+      if (errno != EINTR) {
+        rxSockError("Error from epoll_wait. Number of rx sockets: %d", (int)active_sockets.size() + 1);
+      }
       continue;
     }
     if (n == 0) {
-      rxSockDebug("No data from select.");
+      rxSockDebug("No data from epoll_wait.");
       continue;
     }
 
     // Shared state area
     std::lock_guard<std::mutex> lock(socket_mutex);
 
-    // call read callback for all SCTP/TCP/UDP connections
-    for (auto handler_it = active_sockets.begin(); handler_it != active_sockets.end();) {
-      int              fd       = handler_it->first;
-      recv_callback_t& callback = handler_it->second;
-      if (not FD_ISSET(fd, &read_fd_set)) {
-        ++handler_it;
+    // call read callback for the SCTP/TCP/UDP connections with data
+    bool ctrl_pending = false;
+    for (int i = 0; i < n; ++i) {
+      int fd = events[i].data.fd;
+      if (fd == pipefd[0]) {
+        ctrl_pending = true;
         continue;
       }
-      bool socket_valid = callback(fd);
+      auto handler_it = active_sockets.find(fd);
+      if (handler_it == active_sockets.end()) {
+        // removed while handling a previous event of this wakeup
+        continue;
+      }
+      bool socket_valid = handler_it->second(fd);
       if (not socket_valid) {
         rxSockInfo("The socket fd=%d has been closed by peer", fd);
-        handler_it = remove_socket_unprotected(fd, &total_fd_set, &max_fd);
-      } else {
-        ++handler_it;
+        remove_socket_unprotected(fd);
       }
     }
 
     // handle ctrl messages
-    if (FD_ISSET(pipefd[0], &read_fd_set)) {
+    if (ctrl_pending) {
       ctrl_cmd_t msg;
       ssize_t    nrd = read(pipefd[0], &msg, sizeof(msg));
       if (nrd <= 0) {
@@ -525,19 +535,22 @@ void socket_manager::run_thread()
           return;
         case ctrl_cmd_t::cmd_id_t::NEW_FD:
           if (msg.new_fd >= 0) {
-            FD_SET(msg.new_fd, &total_fd_set);
-            max_fd = std::max(max_fd, msg.new_fd);
+            epoll_event ev = {};
+            ev.events      = EPOLLIN;
+            ev.data.fd     = msg.new_fd;
+            if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, msg.new_fd, &ev) == -1) {
+              rxSockError("Failed to add fd=%d to epoll set: %s", msg.new_fd, strerror(errno));
+            }
           } else {
             rxSockError("added fd is not valid");
           }
           break;
         case ctrl_cmd_t::cmd_id_t::RM_FD:
-          remove_socket_unprotected(msg.new_fd, &total_fd_set, &max_fd);
+          remove_socket_unprotected(msg.new_fd);
           if (msg.signal_rm_complete) {
             rem_fd_tmp_list.push_back(msg.new_fd);
             rem_cvar.notify_one();
           }
-          rxSockDebug("Socket fd=%d has been successfully removed", msg.new_fd);
           break;
         default:
           rxSockError("ctrl message command %d is not valid", (int)msg.cmd);
@@ -618,34 +631,43 @@ public:
 
   bool operator()(int fd)
   {
-    srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
-    if (pdu == nullptr) {
-      logger.error("Unable to allocate byte buffer");
-      return true;
-    }
-    sockaddr_in from    = {};
-    socklen_t   fromlen = sizeof(from);
-
-    ssize_t n_recv = recvfrom(fd, pdu->msg, pdu->get_tailroom(), 0, (struct sockaddr*)&from, &fromlen);
-    if (n_recv == -1 and errno != EAGAIN) {
-      logger.error("Error reading from socket: %s", strerror(errno));
-      return true;
-    }
-    if (n_recv == -1 and errno == EAGAIN) {
-      logger.debug("Socket timeout reached");
-      return true;
-    }
+    // Drain the datagrams already queued in the socket, so that a burst is served with a single wakeup
+    for (uint32_t i = 0; i < max_batch_size; ++i) {
+      srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+      if (pdu == nullptr) {
+        logger.error("Unable to allocate byte buffer");
+        return true;
+      }
+      sockaddr_in from    = {};
+      socklen_t   fromlen = sizeof(from);
+
+      // Only the first read is known not to block
+      int     flags  = (i == 0) ? 0 : MSG_DONTWAIT;
+      ssize_t n_recv = recvfrom(fd, pdu->msg, pdu->get_tailroom(), flags, (struct sockaddr*)&from, &fromlen);
+      if (n_recv == -1 and errno != EAGAIN and errno != EWOULDBLOCK) {
+        logger.error("Error reading from socket: %s", strerror(errno));
+        return true;
+      }
+      if (n_recv == -1) {
+        if (i == 0) {
+          logger.debug("Socket timeout reached");
+        }
+        return true;
+      }
 
-    pdu->N_bytes = static_cast<uint32_t>(n_recv);
+      pdu->N_bytes = static_cast<uint32_t>(n_recv);
 
-    // Defer handling of received packet to provided queue
-    queue.push(
-        std::bind([this, from](srsran::unique_byte_buffer_t& sdu) { func(std::move(sdu), from); }, std::move(pdu)));
+      // Defer handling of received packet to provided queue
+      queue.push(
+          std::bind([this, from](srsran::unique_byte_buffer_t& sdu) { func(std::move(sdu), from); }, std::move(pdu)));
+    }
 
     return true;
   }
 
 private:
+  static const uint32_t max_batch_size = 32;
+
   srslog::basic_logger&      logger;
   srsran::task_queue_handle& queue;
   callback_t                 func;
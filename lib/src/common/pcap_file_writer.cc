@@ -0,0 +1,189 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/pcap_file_writer.h"
+#include "srsran/common/standard_streams.h"
+#include <algorithm>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace srsran {
+
+bool pcap_file_writer::open(const std::string& filename, uint32_t dlt_, const pcap_file_args_t& args_)
+{
+  if (is_open()) {
+    return false;
+  }
+  base_filename = filename;
+  dlt           = dlt_;
+  args          = args_;
+  file_idx      = 0;
+  return open_file();
+}
+
+void pcap_file_writer::close()
+{
+  close_file();
+}
+
+std::string pcap_file_writer::make_filename(uint32_t idx) const
+{
+  if (idx == 0) {
+    return base_filename;
+  }
+  // Insert the counter before the extension, if there is one in the last path component
+  size_t dot   = base_filename.find_last_of('.');
+  size_t slash = base_filename.find_last_of('/');
+  if (dot == std::string::npos or (slash != std::string::npos and dot < slash)) {
+    return base_filename + "." + std::to_string(idx);
+  }
+  return base_filename.substr(0, dot) + "." + std::to_string(idx) + base_filename.substr(dot);
+}
+
+bool pcap_file_writer::open_file()
+{
+  std::string filename = make_filename(file_idx);
+  fd                   = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    srsran::console("Failed to open file \"%s\" for writing\n", filename.c_str());
+    return false;
+  }
+  file_len   = 0;
+  file_start = std::chrono::steady_clock::now();
+  if (not map_segment(0)) {
+    close_file();
+    return false;
+  }
+
+  pcap_hdr_t file_header = {
+      0xa1b2c3d4, /* magic number */
+      2,
+      4,     /* version number is 2.4 */
+      0,     /* timezone */
+      0,     /* sigfigs - apparently all tools do this */
+      65535, /* snaplen - this should be long enough */
+      dlt    /* Data Link Type (DLT) */
+  };
+  return append(&file_header, sizeof(file_header));
+}
+
+void pcap_file_writer::close_file()
+{
+  if (fd < 0) {
+    return;
+  }
+  if (segment != nullptr) {
+    munmap(segment, segment_size);
+    segment = nullptr;
+  }
+  // Remove the unused part of the last segment
+  if (ftruncate(fd, file_len) != 0) {
+    srsran::console("Failed to truncate PCAP file: %s\n", strerror(errno));
+  }
+  ::close(fd);
+  fd = -1;
+}
+
+bool pcap_file_writer::map_segment(size_t offset)
+{
+  if (segment != nullptr) {
+    munmap(segment, segment_size);
+    segment = nullptr;
+  }
+  // Reserve the blocks of the segment, a write to a sparse mapping raises SIGBUS when the disk is full
+  int err = posix_fallocate(fd, offset, segment_size);
+  if (err != 0) {
+    srsran::console("Failed to extend PCAP file: %s\n", strerror(err));
+    return false;
+  }
+  void* ptr = mmap(nullptr, segment_size, PROT_WRITE, MAP_SHARED, fd, offset);
+  if (ptr == MAP_FAILED) {
+    srsran::console("Failed to map PCAP file: %s\n", strerror(errno));
+    return false;
+  }
+  segment   = static_cast<uint8_t*>(ptr);
+  seg_start = offset;
+  return true;
+}
+
+bool pcap_file_writer::append(const void* data, size_t len)
+{
+  const uint8_t* src = static_cast<const uint8_t*>(data);
+  while (len > 0) {
+    size_t seg_pos = file_len - seg_start;
+    if (seg_pos == segment_size) {
+      if (not map_segment(file_len)) {
+        return false;
+      }
+      seg_pos = 0;
+    }
+    size_t n = std::min(len, segment_size - seg_pos);
+    memcpy(segment + seg_pos, src, n);
+    src += n;
+    len -= n;
+    file_len += n;
+  }
+  return true;
+}
+
+bool pcap_file_writer::write_packet(const timeval& ts,
+                                    const uint8_t* header,
+                                    uint32_t       header_len,
+                                    const uint8_t* payload,
+                                    uint32_t       payload_len,
+                                    uint32_t       orig_payload_len)
+{
+  if (not is_open()) {
+    return false;
+  }
+
+  // Rotate the file before writing the packet if needed
+  size_t record_len = sizeof(pcaprec_hdr_t) + header_len + payload_len;
+  bool   rotate     = args.max_file_size_mb > 0 and file_len + record_len > args.max_file_size_mb * 1024UL * 1024UL;
+  rotate |= args.rotation_period_s > 0 and
+            std::chrono::steady_clock::now() - file_start >= std::chrono::seconds(args.rotation_period_s);
+  if (rotate) {
+    close_file();
+    file_idx++;
+    if (not open_file()) {
+      return false;
+    }
+  }
+
+  pcaprec_hdr_t packet_header;
+  packet_header.ts_sec   = ts.tv_sec;
+  packet_header.ts_usec  = ts.tv_usec;
+  packet_header.incl_len = header_len + payload_len;
+  packet_header.orig_len = header_len + orig_payload_len;
+  size_t record_start = file_len;
+  if (append(&packet_header, sizeof(packet_header)) and append(header, header_len) and append(payload, payload_len)) {
+    return true;
+  }
+
+  // The capture stops, the file keeps the complete records written so far
+  file_len = record_start;
+  close_file();
+  return false;
+}
+
+} // namespace srsran
@@ -925,6 +925,21 @@ uint8_t security_milenage_f5_star(uint8_t* k, uint8_t* op, uint8_t* rand, uint8_
   return liblte_security_milenage_f5_star(k, op, rand, ak);
 }
 
+uint8_t security_milenage_f12345(uint8_t* k,
+                                 uint8_t* op,
+                                 uint32_t nof_vectors,
+                                 uint8_t* rand,
+                                 uint8_t* sqn,
+                                 uint8_t* amf,
+                                 uint8_t* mac_a,
+                                 uint8_t* res,
+                                 uint8_t* ck,
+                                 uint8_t* ik,
+                                 uint8_t* ak)
+{
+  return liblte_security_milenage_f12345(k, op, nof_vectors, rand, sqn, amf, mac_a, res, ck, ik, ak);
+}
+
 int security_xor_f2345(uint8_t* k, uint8_t* rand, uint8_t* res, uint8_t* ck, uint8_t* ik, uint8_t* ak)
 {
   uint8_t xdout[16];
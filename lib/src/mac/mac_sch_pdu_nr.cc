@@ -206,9 +206,11 @@ uint32_t mac_sch_subpdu_nr::write_subpdu(const uint8_t* start_)
     logger->error("Error while packing PDU. Unsupported header length (%d)", header_length);
   }
 
-  // copy SDU payload
+  // copy SDU payload, unless it was already written in place
   if (sdu) {
-    memcpy(ptr, sdu.ptr(), sdu_length);
+    if (ptr != sdu.ptr()) {
+      memcpy(ptr, sdu.ptr(), sdu_length);
+    }
   } else {
     // clear memory
     memset(ptr, 0, sdu_length);
@@ -572,6 +574,42 @@ uint32_t mac_sch_pdu_nr::add_sdu(const uint32_t lcid_, const uint8_t* payload_,
   return add_sudpdu(sch_pdu);
 }
 
+int mac_sch_pdu_nr::add_sdu(const uint32_t lcid_, const uint32_t requested_bytes_, read_pdu_interface* sdu_itf_)
+{
+  uint32_t header_size = size_header_sdu(lcid_, requested_bytes_);
+  if (header_size + requested_bytes_ > remaining_len) {
+    logger.error("Header and SDU exceed space in PDU (%d + %d > %d)", header_size, requested_bytes_, remaining_len);
+    return SRSRAN_ERROR;
+  }
+
+  // Let the upper layer write the SDU at its final position
+  uint8_t* sdu_ptr = buffer->msg + buffer->N_bytes + header_size;
+  uint32_t sdu_len = sdu_itf_->read_pdu(lcid_, sdu_ptr, requested_bytes_);
+  if (sdu_len == 0) {
+    return 0;
+  }
+  if (sdu_len > requested_bytes_) {
+    logger.error("SDU exceeds requested space (%d > %d)", sdu_len, requested_bytes_);
+    return SRSRAN_ERROR;
+  }
+
+  // A shorter SDU may need a shorter subheader than the one reserved, move it next to the final subheader
+  uint32_t final_header_size = size_header_sdu(lcid_, sdu_len);
+  if (final_header_size != header_size) {
+    uint8_t* final_sdu_ptr = buffer->msg + buffer->N_bytes + final_header_size;
+    memmove(final_sdu_ptr, sdu_ptr, sdu_len);
+    sdu_ptr = final_sdu_ptr;
+  }
+
+  mac_sch_subpdu_nr sch_pdu(this);
+  sch_pdu.set_sdu(lcid_, sdu_ptr, sdu_len);
+  if (add_sudpdu(sch_pdu) != SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  return sdu_len;
+}
+
 uint32_t mac_sch_pdu_nr::add_crnti_ce(const uint16_t crnti)
 {
   mac_sch_subpdu_nr ce(this);
@@ -43,6 +43,7 @@ uint8_t* pdu_queue::request(uint32_t len)
       ERROR("Fatal error in memory alignment in struct pdu_queue::pdu_t");
       exit(-1);
     }
+    pdu->ref.init(this, pdu);
     return pdu->ptr;
   } else {
     logger.error("Not enough buffers for MAC PDU");
@@ -53,11 +54,26 @@ uint8_t* pdu_queue::request(uint32_t len)
 
 void pdu_queue::deallocate(const uint8_t* pdu)
 {
-  if (!pool.deallocate((pdu_t*)pdu)) {
+  ((pdu_t*)pdu)->ref.remove_ref();
+}
+
+void pdu_queue::release(pdu_t* pdu)
+{
+  if (!pool.deallocate(pdu)) {
     logger.warning("Error deallocating from buffer pool in deallocate(): buffer not created in this pool.");
   }
 }
 
+byte_buffer_slice pdu_queue::make_slice(const uint8_t* pdu, uint8_t* ptr, uint32_t nof_bytes)
+{
+  // Copy the bytes out of the PDU when the pool is running out of buffers, so that the slices kept by upper layers
+  // do not prevent the reception of new PDUs
+  if (pool.nof_available_pdus() < DEFAULT_POOL_SIZE / 4) {
+    return retain_slice(byte_buffer_slice(nullptr, ptr, nof_bytes));
+  }
+  return byte_buffer_slice(&((pdu_t*)pdu)->ref, ptr, nof_bytes);
+}
+
 /* Demultiplexing of logical channels and dissassemble of MAC CE
  * This function enqueues the packet and returns quickly because ACK
  * deadline is important here.
@@ -885,6 +885,68 @@ int mac_ul_sch_pdu_unpack_test7()
   return SRSRAN_SUCCESS;
 }
 
+// Writes SDUs of a fixed length filled with the LCID, like the RLC would do on a MAC opportunity
+class dummy_rlc : public srsran::read_pdu_interface
+{
+public:
+  explicit dummy_rlc(uint32_t sdu_len_) : sdu_len(sdu_len_) {}
+  uint32_t read_pdu(uint32_t lcid, uint8_t* payload, uint32_t requested_bytes) override
+  {
+    uint32_t len = std::min(sdu_len, requested_bytes);
+    memset(payload, lcid, len);
+    return len;
+  }
+
+private:
+  uint32_t sdu_len;
+};
+
+int mac_dl_sch_pdu_pack_in_place_test10()
+{
+  // The first SDU is requested with a 3 B subheader but only 100 B are written, so it is packed with a 2 B subheader.
+  // The second SDU fills the remaining space
+  byte_buffer_t          tx_buffer;
+  srsran::mac_sch_pdu_nr tx_pdu;
+  tx_pdu.init_tx(&tx_buffer, 1024);
+
+  dummy_rlc short_rlc(100);
+  TESTASSERT(tx_pdu.add_sdu(4, 600, &short_rlc) == 100);
+  TESTASSERT(tx_buffer.N_bytes == 102);
+
+  dummy_rlc long_rlc(2048);
+  TESTASSERT(tx_pdu.add_sdu(5, tx_pdu.get_remaing_len() - 3, &long_rlc) == 1024 - 102 - 3);
+  TESTASSERT(tx_pdu.get_remaing_len() == 0);
+
+  // Nothing to read
+  byte_buffer_t          empty_buffer;
+  srsran::mac_sch_pdu_nr empty_pdu;
+  empty_pdu.init_tx(&empty_buffer, 1024);
+  dummy_rlc empty_rlc(0);
+  TESTASSERT(empty_pdu.add_sdu(4, 100, &empty_rlc) == 0);
+  TESTASSERT(empty_buffer.N_bytes == 0);
+
+  // Both SDUs are found where the subheaders point to
+  srsran::mac_sch_pdu_nr rx_pdu;
+  TESTASSERT(rx_pdu.unpack(tx_buffer.msg, tx_buffer.N_bytes) == SRSRAN_SUCCESS);
+  TESTASSERT(rx_pdu.get_num_subpdus() == 2);
+
+  mac_sch_subpdu_nr subpdu = rx_pdu.get_subpdu(0);
+  TESTASSERT(subpdu.get_lcid() == 4);
+  TESTASSERT(subpdu.get_sdu_length() == 100);
+  for (uint32_t i = 0; i < 100; i++) {
+    TESTASSERT(subpdu.get_sdu()[i] == 4);
+  }
+
+  subpdu = rx_pdu.get_subpdu(1);
+  TESTASSERT(subpdu.get_lcid() == 5);
+  TESTASSERT(subpdu.get_sdu_length() == 1024 - 102 - 3);
+  for (uint32_t i = 0; i < subpdu.get_sdu_length(); i++) {
+    TESTASSERT(subpdu.get_sdu()[i] == 5);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
 #if PCAP
@@ -993,6 +1055,11 @@ int main(int argc, char** argv)
     return SRSRAN_ERROR;
   }
 
+  if (mac_dl_sch_pdu_pack_in_place_test10()) {
+    fprintf(stderr, "mac_dl_sch_pdu_pack_in_place_test10() failed.\n");
+    return SRSRAN_ERROR;
+  }
+
   if (pcap_handle) {
     pcap_handle->close();
   }
@@ -29,6 +29,7 @@
 
 #include "srsran/config.h"
 #include "srsran/phy/ch_estimation/chest_ul.h"
+#include "srsran/phy/ch_estimation/wiener_ul.h"
 #include "srsran/phy/dft/dft_precoding.h"
 #include "srsran/phy/utils/convolution.h"
 #include "srsran/phy/utils/vector.h"
@@ -275,6 +276,27 @@ average_pilots(srsran_chest_ul_t* q, cf_t* input, cf_t* ce, uint32_t nslots, uin
   }
 }
 
+static void wiener_pilots(srsran_chest_ul_t*        q,
+                          const srsran_wiener_ul_t* wiener,
+                          cf_t*                     input,
+                          cf_t*                     ce,
+                          uint32_t                  nslots,
+                          uint32_t                  nrefs,
+                          uint32_t                  n_prb[2],
+                          float                     snr)
+{
+  for (uint32_t i = 0; i < nslots; i++) {
+    uint32_t ce_idx = SRSRAN_REFSIGNAL_UL_L(i, q->cell.cp) * q->cell.nof_prb * SRSRAN_NRE + n_prb[i] * SRSRAN_NRE;
+
+    // The filter is designed for a delay profile centered at zero, remove the mean delay and restore it afterwards.
+    // The estimated frequency is the phase decrement between adjacent subcarriers.
+    float delay = srsran_vec_estimate_frequency(&input[i * nrefs], nrefs);
+    srsran_vec_apply_cfo(&input[i * nrefs], delay, q->pilot_estimates_tmp[0], nrefs);
+    srsran_wiener_ul_run(wiener, q->pilot_estimates_tmp[0], &ce[ce_idx], nrefs, snr);
+    srsran_vec_apply_cfo(&ce[ce_idx], -delay, &ce[ce_idx], nrefs);
+  }
+}
+
 /**
  * Generic PUSCH and DMRS channel estimation. It assumes q->pilot_estimates has been populated with the Least Square
  * Estimates
@@ -284,6 +306,7 @@ average_pilots(srsran_chest_ul_t* q, cf_t* input, cf_t* ce, uint32_t nslots, uin
  * @param nrefs_sym number of reference resource elements per symbols (depends on configuration)
  * @param stride sub-carrier distance between reference signal resource elements (1 for DMRS, 2 for SRS)
  * @param meas_ta_en enables or disables the Time Alignment error measurement
+ * @param wiener_en Replaces the averaged estimates by the Wiener filtered ones, (only for DMRS)
  * @param write_estimates Write channel estimation in res, (true for DMRS and false for SRS)
  * @param n_prb Resource block start for the grant, set to zero for Sounding Reference Signals
  * @param res UL channel estimation result
@@ -293,6 +316,7 @@ static void chest_ul_estimate(srsran_chest_ul_t*     q,
                               uint32_t               nrefs_sym,
                               uint32_t               stride,
                               bool                   meas_ta_en,
+                              bool                   wiener_en,
                               bool                   write_estimates,
                               uint32_t               n_prb[SRSRAN_NOF_SLOTS_PER_SF],
                               srsran_chest_ul_res_t* res)
@@ -330,16 +354,26 @@ static void chest_ul_estimate(srsran_chest_ul_t*     q,
     ERROR("ERROR: intra-subframe frequency hopping not supported in the estimator!!");
   }
 
+  // Measure EPRE
+  float epre = srsran_vec_avg_power_cf(q->pilot_recv_signal, nslots * nrefs_sym);
+
   if (res->ce != NULL) {
     if (q->smooth_filter_len > 0) {
       average_pilots(q, q->pilot_estimates, res->ce, nslots, nrefs_sym, n_prb);
 
+      // If averaging, compute noise from difference between received and averaged estimates
+      res->noise_estimate = estimate_noise_pilots(q, res->ce, nslots, nrefs_sym, n_prb);
+
+      // The averaging noise estimate selects the Wiener filter, which then overwrites the averaged estimates. The
+      // filters are shared by all the estimators and computed on the first use
+      const srsran_wiener_ul_t* wiener = wiener_en ? srsran_wiener_ul_get_default() : NULL;
+      if (wiener != NULL) {
+        wiener_pilots(q, wiener, q->pilot_estimates, res->ce, nslots, nrefs_sym, n_prb, epre / res->noise_estimate);
+      }
+
       if (write_estimates) {
         interpolate_pilots(q, res->ce, nslots, nrefs_sym, n_prb);
       }
-
-      // If averaging, compute noise from difference between received and averaged estimates
-      res->noise_estimate = estimate_noise_pilots(q, res->ce, nslots, nrefs_sym, n_prb);
     } else {
       // Copy estimates to CE vector without averaging
       for (int i = 0; i < nslots; i++) {
@@ -359,9 +393,6 @@ static void chest_ul_estimate(srsran_chest_ul_t*     q,
   cf_t  corr     = srsran_vec_acc_cc(q->pilot_recv_signal, nslots * nrefs_sym) / (nslots * nrefs_sym);
   float rsrp_avg = __real__ corr * __real__ corr + __imag__ corr * __imag__ corr;
 
-  // Measure EPRE
-  float epre = srsran_vec_avg_power_cf(q->pilot_recv_signal, nslots * nrefs_sym);
-
   // RSRP shall not be greater than EPRE
   rsrp_avg = SRSRAN_MIN(rsrp_avg, epre);
 
@@ -381,10 +412,12 @@ static void chest_ul_estimate(srsran_chest_ul_t*     q,
   res->noise_estimate_dbFs = srsran_convert_power_to_dBm(res->noise_estimate);
 }
 
-int srsran_chest_ul_estimate_pusch(srsran_chest_ul_t*     q,
+/* Estimates the PUSCH channel from the DMRS of the first nslots slots */
+static int chest_ul_estimate_pusch(srsran_chest_ul_t*     q,
                                    srsran_ul_sf_cfg_t*    sf,
                                    srsran_pusch_cfg_t*    cfg,
                                    cf_t*                  input,
+                                   uint32_t               nslots,
                                    srsran_chest_ul_res_t* res)
 {
   if (!q->dmrs_signal_configured) {
@@ -400,23 +433,52 @@ int srsran_chest_ul_estimate_pusch(srsran_chest_ul_t*     q,
   }
 
   int nrefs_sym = nof_prb * SRSRAN_NRE;
-  int nrefs_sf  = nrefs_sym * SRSRAN_NOF_SLOTS_PER_SF;
 
-  /* Get references from the input signal */
-  srsran_refsignal_dmrs_pusch_get(&q->dmrs_signal, cfg, input, q->pilot_recv_signal);
+  /* Get references from the input signal, the DMRS of the later slots may not have been received yet */
+  if (nslots == SRSRAN_NOF_SLOTS_PER_SF) {
+    srsran_refsignal_dmrs_pusch_get(&q->dmrs_signal, cfg, input, q->pilot_recv_signal);
+  } else {
+    srsran_vec_cf_copy(q->pilot_recv_signal,
+                       &input[SRSRAN_RE_IDX(q->cell.nof_prb,
+                                            SRSRAN_REFSIGNAL_UL_L(0, q->cell.cp),
+                                            cfg->grant.n_prb_tilde[0] * SRSRAN_NRE)],
+                       nrefs_sym);
+  }
 
   // Use the known DMRS signal to compute Least-squares estimates
   srsran_vec_prod_conj_ccc(q->pilot_recv_signal,
                            q->dmrs_pregen.r[cfg->grant.n_dmrs][sf->tti % SRSRAN_NOF_SF_X_FRAME][nof_prb],
                            q->pilot_estimates,
-                           nrefs_sf);
+                           nrefs_sym * nslots);
 
   // Estimate
-  chest_ul_estimate(q, SRSRAN_NOF_SLOTS_PER_SF, nrefs_sym, 1, cfg->meas_ta_en, true, cfg->grant.n_prb, res);
+  chest_ul_estimate(q, nslots, nrefs_sym, 1, cfg->meas_ta_en, cfg->wiener_en, true, cfg->grant.n_prb, res);
 
   return 0;
 }
 
+int srsran_chest_ul_estimate_pusch(srsran_chest_ul_t*     q,
+                                   srsran_ul_sf_cfg_t*    sf,
+                                   srsran_pusch_cfg_t*    cfg,
+                                   cf_t*                  input,
+                                   srsran_chest_ul_res_t* res)
+{
+  return chest_ul_estimate_pusch(q, sf, cfg, input, SRSRAN_NOF_SLOTS_PER_SF, res);
+}
+
+int srsran_chest_ul_estimate_pusch_slot(srsran_chest_ul_t*     q,
+                                        srsran_ul_sf_cfg_t*    sf,
+                                        srsran_pusch_cfg_t*    cfg,
+                                        cf_t*                  input,
+                                        uint32_t               slot_idx,
+                                        srsran_chest_ul_res_t* res)
+{
+  if (slot_idx >= SRSRAN_NOF_SLOTS_PER_SF) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+  return chest_ul_estimate_pusch(q, sf, cfg, input, slot_idx + 1, res);
+}
+
 static float
 estimate_noise_pilots_pucch(srsran_chest_ul_t* q, cf_t* ce, uint32_t n_rs, uint32_t n_prb[SRSRAN_NOF_SLOTS_PER_SF])
 {
@@ -620,7 +682,7 @@ int srsran_chest_ul_estimate_srs(srsran_chest_ul_t*                 q,
 
   // Estimate
   uint32_t n_prb[2] = {};
-  chest_ul_estimate(q, 1, n_srs_re, 1, true, false, n_prb, res);
+  chest_ul_estimate(q, 1, n_srs_re, 1, true, false, false, n_prb, res);
 
   return SRSRAN_SUCCESS;
 }
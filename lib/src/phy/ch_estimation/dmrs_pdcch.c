@@ -252,6 +252,24 @@ int srsran_dmrs_pdcch_estimator_init(srsran_dmrs_pdcch_estimator_t* q,
   q->coreset_bw = coreset_bw;
   q->coreset_sz = coreset_sz;
 
+  // Precompute the RBs of every CCE
+  q->nof_cce = SRSRAN_MIN((coreset_bw * coreset->duration) / 6, SRSRAN_CORESET_MAX_NOF_CCE);
+  for (uint32_t ncce = 0; ncce < q->nof_cce; ncce++) {
+    bool                  rb_mask[SRSRAN_MAX_PRB_NR] = {};
+    srsran_dci_location_t location                   = {.L = 0, .ncce = ncce};
+    if (srsran_pdcch_nr_cce_to_reg_mapping(coreset, &location, rb_mask) < SRSRAN_SUCCESS) {
+      ERROR("Error in CCE-to-REG mapping");
+      return SRSRAN_ERROR;
+    }
+
+    q->cce_nof_rb[ncce] = 0;
+    for (uint32_t rb = 0; rb < coreset_bw && q->cce_nof_rb[ncce] < 6; rb++) {
+      if (rb_mask[rb]) {
+        q->cce_rb[ncce][q->cce_nof_rb[ncce]++] = (uint16_t)rb;
+      }
+    }
+  }
+
   return SRSRAN_SUCCESS;
 }
 
@@ -360,6 +378,18 @@ int srsran_dmrs_pdcch_estimate(srsran_dmrs_pdcch_estimator_t* q,
     srsran_dmrs_pdcch_extract(q, cinit, &sf_symbols[l * q->carrier.nof_prb * SRSRAN_NRE], q->lse[l]);
   }
 
+  // Measure the pilots power of every CCE
+  for (uint32_t ncce = 0; ncce < q->nof_cce; ncce++) {
+    float power = 0.0f;
+    for (uint32_t l = 0; l < q->coreset.duration; l++) {
+      for (uint32_t i = 0; i < q->cce_nof_rb[ncce]; i++) {
+        const cf_t* lse = &q->lse[l][q->cce_rb[ncce][i] * NOF_PILOTS_X_RB];
+        power += crealf(srsran_vec_dot_prod_conj_ccc(lse, lse, NOF_PILOTS_X_RB));
+      }
+    }
+    q->cce_power[ncce] = power;
+  }
+
   // Time averaging and smoothing should be implemented here
   // ...
 
@@ -525,6 +555,44 @@ int srsran_dmrs_pdcch_get_measure(const srsran_dmrs_pdcch_estimator_t* q,
   return SRSRAN_SUCCESS;
 }
 
+int srsran_dmrs_pdcch_get_epre(const srsran_dmrs_pdcch_estimator_t* q,
+                               const srsran_dci_location_t*         dci_location,
+                               float*                               epre_dBfs)
+{
+  if (q == NULL || dci_location == NULL || epre_dBfs == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Check that CORESET duration is not less than minimum
+  if (q->coreset.duration < SRSRAN_CORESET_DURATION_MIN) {
+    ERROR("Invalid CORESET duration");
+    return SRSRAN_ERROR;
+  }
+
+  uint32_t L = 1U << dci_location->L;
+  if (dci_location->ncce + L > q->nof_cce) {
+    ERROR("DCI location (L=%d, ncce=%d) exceeds the CORESET", dci_location->L, dci_location->ncce);
+    return SRSRAN_ERROR;
+  }
+
+  // The CCE of a candidate do not overlap, so the EPRE is the sum of their pilots power over their number of pilots
+  float    power      = 0.0f;
+  uint32_t nof_pilots = 0;
+  for (uint32_t ncce = dci_location->ncce; ncce < dci_location->ncce + L; ncce++) {
+    power += q->cce_power[ncce];
+    nof_pilots += q->cce_nof_rb[ncce] * q->coreset.duration * NOF_PILOTS_X_RB;
+  }
+
+  if (nof_pilots == 0) {
+    ERROR("Error in DMRS EPRE. nof_pilots cannot be zero");
+    return SRSRAN_ERROR;
+  }
+
+  *epre_dBfs = srsran_convert_power_to_dB(power / (float)nof_pilots);
+
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_dmrs_pdcch_get_ce(const srsran_dmrs_pdcch_estimator_t* q,
                              const srsran_dci_location_t*         dci_location,
                              srsran_dmrs_pdcch_ce_t*              ce)
@@ -23,8 +23,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <strings.h>
+#include <sys/time.h>
 #include <unistd.h>
 
+#include "srsran/phy/channel/fading.h"
 #include "srsran/srsran.h"
 
 srsran_cell_t cell = {
@@ -40,6 +42,11 @@ srsran_cell_t cell = {
 
 char* output_matlab = NULL;
 
+// Channel emulator comparison between the averaging and the Wiener estimators
+static char*    fading_model = NULL;
+static float    snr_db       = 10.0f;
+static uint32_t nof_sf       = 100;
+
 void usage(char* prog)
 {
   printf("Usage: %s [recov]\n", prog);
@@ -50,13 +57,17 @@ void usage(char* prog)
   printf("\t-c cell_id (1000 tests all). [Default %d]\n", cell.id);
 
   printf("\t-o output matlab file [Default %s]\n", output_matlab ? output_matlab : "None");
+  printf("\t-m fading model, compares the averaging and Wiener estimators (e.g. epa5, etu70) [Default %s]\n",
+         fading_model ? fading_model : "None");
+  printf("\t-s SNR in dB for the fading model comparison [Default %.1f]\n", snr_db);
+  printf("\t-n number of subframes for the fading model comparison [Default %d]\n", nof_sf);
   printf("\t-v increase verbosity\n");
 }
 
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "recov")) != -1) {
+  while ((opt = getopt(argc, argv, "recovmsn")) != -1) {
     switch (opt) {
       case 'r':
         cell.nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -70,6 +81,15 @@ void parse_args(int argc, char** argv)
       case 'o':
         output_matlab = argv[optind];
         break;
+      case 'm':
+        fading_model = argv[optind];
+        break;
+      case 's':
+        snr_db = strtof(argv[optind], NULL);
+        break;
+      case 'n':
+        nof_sf = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -80,6 +100,221 @@ void parse_args(int argc, char** argv)
   }
 }
 
+typedef struct {
+  double err_pow;    // Channel estimation error power
+  double ch_pow;     // Channel power
+  double res_pow;    // Residual power after subtracting the estimated channel times the transmitted symbols
+  double sig_pow;    // Received symbols power without noise
+  double texec_us;   // Accumulated estimation time
+} estimator_metrics_t;
+
+static void estimator_metrics_acc(estimator_metrics_t* m,
+                                  const cf_t*          ce,
+                                  const cf_t*          h,
+                                  const cf_t*          x,
+                                  const cf_t*          y,
+                                  uint32_t             nof_prb)
+{
+  for (uint32_t l = 0; l < SRSRAN_CP_NSYMB(cell.cp) * SRSRAN_NOF_SLOTS_PER_SF; l++) {
+    // Skip the DMRS symbols
+    if (l == SRSRAN_REFSIGNAL_UL_L(0, cell.cp) || l == SRSRAN_REFSIGNAL_UL_L(1, cell.cp)) {
+      continue;
+    }
+    for (uint32_t k = 0; k < nof_prb * SRSRAN_NRE; k++) {
+      uint32_t idx = SRSRAN_RE_IDX(cell.nof_prb, l, k);
+      m->err_pow += SRSRAN_CSQABS(ce[idx] - h[idx]);
+      m->ch_pow += SRSRAN_CSQABS(h[idx]);
+      m->res_pow += SRSRAN_CSQABS(y[idx] - ce[idx] * x[idx]);
+      m->sig_pow += SRSRAN_CSQABS(h[idx] * x[idx]);
+    }
+  }
+}
+
+static void estimator_metrics_print(const char* name, const estimator_metrics_t* m, uint32_t nof_prb)
+{
+  // Shannon throughput of the data resource elements, the channel estimation error adds to the noise
+  float sinr       = (float)(m->sig_pow / m->res_pow);
+  float nof_data   = (float)(SRSRAN_CP_NSYMB(cell.cp) * SRSRAN_NOF_SLOTS_PER_SF - 2) * nof_prb * SRSRAN_NRE;
+  float throughput = nof_data * log2f(1.0f + sinr) / 1000.0f;
+  printf("%-9s NMSE: %+6.2f dB; SINR: %+6.2f dB; Throughput: %6.2f Mbps; ExTime: %6.2f us\n",
+         name,
+         srsran_convert_power_to_dB((float)(m->err_pow / m->ch_pow)),
+         srsran_convert_power_to_dB(sinr),
+         throughput,
+         m->texec_us / nof_sf);
+}
+
+/*
+ * Transmits random QPSK and DMRS through the fading channel emulator and compares the channel estimates and the
+ * resulting throughput of the averaging and the Wiener estimators. The actual channel is obtained by transmitting
+ * all ones through an identical channel emulator.
+ */
+static int chest_ul_emulator_test(srsran_chest_ul_t* est)
+{
+  int                     ret       = SRSRAN_ERROR;
+  uint32_t                nof_re    = SRSRAN_SF_LEN_RE(cell.nof_prb, cell.cp);
+  uint32_t                sf_len    = SRSRAN_SF_LEN_PRB(cell.nof_prb);
+  double                  srate     = (double)srsran_sampling_freq_hz(cell.nof_prb);
+  cf_t*                   x         = srsran_vec_cf_malloc(nof_re);
+  cf_t*                   grid      = srsran_vec_cf_malloc(nof_re);
+  cf_t*                   y         = srsran_vec_cf_malloc(nof_re);
+  cf_t*                   h         = srsran_vec_cf_malloc(nof_re);
+  cf_t*                   ce        = srsran_vec_cf_malloc(nof_re);
+  cf_t*                   tx_buffer = srsran_vec_cf_malloc(2 * sf_len);
+  cf_t*                   rx_buffer = srsran_vec_cf_malloc(2 * sf_len);
+  srsran_ofdm_t           ifft      = {};
+  srsran_ofdm_t           fft       = {};
+  srsran_channel_fading_t fading[2] = {};
+  estimator_metrics_t     metrics[2] = {};
+
+  if (!x || !grid || !y || !h || !ce || !tx_buffer || !rx_buffer) {
+    perror("srsran_vec_malloc");
+    goto clean_exit;
+  }
+  srsran_vec_cf_zero(tx_buffer, 2 * sf_len);
+
+  for (uint32_t i = 0; i < 2; i++) {
+    if (srsran_channel_fading_init(&fading[i], srate, fading_model, 1234)) {
+      ERROR("Error initializing fading channel %s", fading_model);
+      goto clean_exit;
+    }
+  }
+
+  // The emulator delays the signal, the receiver window skips the delay so the CP absorbs the channel delay spread
+  uint32_t delay = fading[0].path_delay;
+
+  // Same OFDM configuration than the UE transmitter and the eNb receiver
+  srsran_ofdm_cfg_t ofdm_cfg = {};
+  ofdm_cfg.nof_prb           = cell.nof_prb;
+  ofdm_cfg.cp                = cell.cp;
+  ofdm_cfg.in_buffer         = grid;
+  ofdm_cfg.out_buffer        = tx_buffer;
+  ofdm_cfg.freq_shift_f      = 0.5f;
+  ofdm_cfg.normalize         = true;
+  if (srsran_ofdm_tx_init_cfg(&ifft, &ofdm_cfg)) {
+    ERROR("Error initializing OFDM modulator");
+    goto clean_exit;
+  }
+  ofdm_cfg.in_buffer        = &rx_buffer[delay];
+  ofdm_cfg.out_buffer       = grid;
+  ofdm_cfg.freq_shift_f     = -0.5f;
+  ofdm_cfg.normalize        = false;
+  ofdm_cfg.rx_window_offset = 0.5f;
+  if (srsran_ofdm_rx_init_cfg(&fft, &ofdm_cfg)) {
+    ERROR("Error initializing OFDM demodulator");
+    goto clean_exit;
+  }
+
+  // Largest allocation the DFT precoding supports
+  uint32_t nof_prb = cell.nof_prb;
+  while (!srsran_dft_precoding_valid_prb(nof_prb)) {
+    nof_prb--;
+  }
+
+  srsran_refsignal_dmrs_pusch_cfg_t dmrs_cfg = {};
+  srsran_chest_ul_pregen(est, &dmrs_cfg, NULL);
+
+  srsran_pusch_cfg_t pusch_cfg = {};
+  pusch_cfg.grant.L_prb        = nof_prb;
+
+  srsran_chest_ul_res_t res = {};
+  res.ce                    = ce;
+
+  for (uint32_t n = 0; n < nof_sf; n++) {
+    srsran_ul_sf_cfg_t ul_sf = {};
+    ul_sf.tti                = n;
+    double t                 = n * 1e-3;
+
+    // Random QPSK data and DMRS
+    srsran_vec_cf_zero(x, nof_re);
+    for (uint32_t l = 0; l < SRSRAN_CP_NSYMB(cell.cp) * SRSRAN_NOF_SLOTS_PER_SF; l++) {
+      for (uint32_t k = 0; k < nof_prb * SRSRAN_NRE; k++) {
+        x[SRSRAN_RE_IDX(cell.nof_prb, l, k)] =
+            ((rand() % 2) ? M_SQRT1_2 : -M_SQRT1_2) + I * ((rand() % 2) ? M_SQRT1_2 : -M_SQRT1_2);
+      }
+    }
+    srsran_refsignal_dmrs_pusch_put(
+        &est->dmrs_signal, &pusch_cfg, est->dmrs_pregen.r[0][n % SRSRAN_NOF_SF_X_FRAME][nof_prb], x);
+
+    // Received signal
+    srsran_vec_cf_copy(grid, x, nof_re);
+    srsran_ofdm_tx_sf(&ifft);
+    srsran_channel_fading_execute(&fading[0], tx_buffer, rx_buffer, sf_len + delay, t);
+    srsran_ofdm_rx_sf(&fft);
+    srsran_vec_cf_copy(y, grid, nof_re);
+
+    // Actual channel, all ones through the same channel
+    srsran_vec_cf_zero(grid, nof_re);
+    for (uint32_t l = 0; l < SRSRAN_CP_NSYMB(cell.cp) * SRSRAN_NOF_SLOTS_PER_SF; l++) {
+      for (uint32_t k = 0; k < nof_prb * SRSRAN_NRE; k++) {
+        grid[SRSRAN_RE_IDX(cell.nof_prb, l, k)] = 1.0f;
+      }
+    }
+    srsran_ofdm_tx_sf(&ifft);
+    srsran_channel_fading_execute(&fading[1], tx_buffer, rx_buffer, sf_len + delay, t);
+    srsran_ofdm_rx_sf(&fft);
+    srsran_vec_cf_copy(h, grid, nof_re);
+
+    // Noise relative to the received signal power
+    float noise_var = srsran_vec_avg_power_cf(h, nof_re) * (float)cell.nof_prb / (float)nof_prb;
+    srsran_ch_awgn_c(y, y, noise_var * srsran_convert_dB_to_power(-snr_db), nof_re);
+
+    for (uint32_t i = 0; i < 2; i++) {
+      struct timeval tdata[3];
+      pusch_cfg.wiener_en = (i == 1);
+
+      gettimeofday(&tdata[1], NULL);
+      srsran_chest_ul_estimate_pusch(est, &ul_sf, &pusch_cfg, y, &res);
+      gettimeofday(&tdata[2], NULL);
+      get_time_interval(tdata);
+      metrics[i].texec_us += tdata[0].tv_sec * 1e6 + tdata[0].tv_usec;
+
+      estimator_metrics_acc(&metrics[i], ce, h, x, y, nof_prb);
+    }
+  }
+
+  printf("Model: %s; SNR: %.1f dB; PRB: %d; Subframes: %d\n", fading_model, snr_db, nof_prb, nof_sf);
+  estimator_metrics_print("Averaging", &metrics[0], nof_prb);
+  estimator_metrics_print("Wiener", &metrics[1], nof_prb);
+
+  // The Wiener estimator shall never be worse than averaging
+  if (metrics[1].err_pow > metrics[0].err_pow || metrics[1].res_pow > metrics[0].res_pow) {
+    ERROR("The Wiener estimator does not improve the averaging estimator");
+    goto clean_exit;
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  for (uint32_t i = 0; i < 2; i++) {
+    srsran_channel_fading_free(&fading[i]);
+  }
+  srsran_ofdm_tx_free(&ifft);
+  srsran_ofdm_rx_free(&fft);
+  if (x) {
+    free(x);
+  }
+  if (grid) {
+    free(grid);
+  }
+  if (y) {
+    free(y);
+  }
+  if (h) {
+    free(h);
+  }
+  if (ce) {
+    free(ce);
+  }
+  if (tx_buffer) {
+    free(tx_buffer);
+  }
+  if (rx_buffer) {
+    free(rx_buffer);
+  }
+  return ret;
+}
+
 int main(int argc, char** argv)
 {
   srsran_chest_ul_t est;
@@ -130,6 +365,15 @@ int main(int argc, char** argv)
     ERROR("Error initializing equalizer");
     goto do_exit;
   }
+
+  if (fading_model != NULL) {
+    cell.id = cid;
+    if (srsran_chest_ul_set_cell(&est, cell) == SRSRAN_SUCCESS && chest_ul_emulator_test(&est) == SRSRAN_SUCCESS) {
+      ret = 0;
+    }
+    srsran_chest_ul_free(&est);
+    goto do_exit;
+  }
   while (cid <= max_cid) {
     cell.id = cid;
     if (srsran_chest_ul_set_cell(&est, cell)) {
@@ -0,0 +1,190 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <complex.h>
+#include <math.h>
+#include <pthread.h>
+#include <strings.h>
+
+#include "srsran/phy/ch_estimation/wiener_ul.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/mat.h"
+#include "srsran/phy/utils/simd.h"
+#include "srsran/phy/utils/vector.h"
+
+static srsran_wiener_ul_t wiener_ul_default      = {};
+static int                wiener_ul_default_ret  = SRSRAN_ERROR;
+static pthread_once_t     wiener_ul_default_once = PTHREAD_ONCE_INIT;
+
+/*
+ * Frequency correlation between two subcarriers delta apart for a uniform power delay profile of length T centered at
+ * zero delay: R(delta) = sinc(delta * 15kHz * T)
+ */
+static cf_t wiener_ul_corr(float delay_spread_us, int delta)
+{
+  float x = (float)M_PI * delay_spread_us * 1e-6f * 15e3f * (float)delta;
+  return (delta == 0) ? 1.0f : sinf(x) / x;
+}
+
+/*
+ * Computes the MMSE filter for a window of N subcarriers. The coefficients estimating the subcarrier d of the window
+ * are f_d = c_d * inv(R + noise_var * I), where R(i, j) = R(i - j) and c_d(i) = R(d - i)
+ */
+static int wiener_ul_filter_gen(srsran_wiener_ul_filter_t* f, uint32_t N, float delay_spread_us, float noise_var)
+{
+  cf_t                    RH[SRSRAN_WIENER_UL_MAX_TAPS * SRSRAN_WIENER_UL_MAX_TAPS];
+  cf_t                    invRH[SRSRAN_WIENER_UL_MAX_TAPS * SRSRAN_WIENER_UL_MAX_TAPS];
+  srsran_matrix_NxN_inv_t inverter = {};
+
+  if (srsran_matrix_NxN_inv_init(&inverter, N) < SRSRAN_SUCCESS) {
+    ERROR("Error initialising matrix inverter");
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t i = 0; i < N; i++) {
+    for (uint32_t j = 0; j < N; j++) {
+      RH[i * N + j] = wiener_ul_corr(delay_spread_us, (int)i - (int)j);
+    }
+    RH[i * N + i] += noise_var;
+  }
+
+  srsran_matrix_NxN_inv_run(&inverter, RH, invRH);
+  srsran_matrix_NxN_inv_free(&inverter);
+
+  f->nof_taps = N;
+  for (uint32_t d = 0; d < N; d++) {
+    for (uint32_t j = 0; j < N; j++) {
+      cf_t acc = 0.0f;
+      for (uint32_t i = 0; i < N; i++) {
+        acc += wiener_ul_corr(delay_spread_us, (int)d - (int)i) * invRH[i * N + j];
+      }
+      f->filter[d][j] = acc;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_wiener_ul_init(srsran_wiener_ul_t* q, float delay_spread_us)
+{
+  if (q == NULL || !isnormal(delay_spread_us)) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  bzero(q, sizeof(srsran_wiener_ul_t));
+  q->delay_spread_us = delay_spread_us;
+
+  for (uint32_t b = 0; b < SRSRAN_WIENER_UL_NOF_SNR_BINS; b++) {
+    float noise_var = srsran_convert_dB_to_power(-(SRSRAN_WIENER_UL_SNR_MIN_DB + b * SRSRAN_WIENER_UL_SNR_STEP_DB));
+    for (uint32_t w = 0; w < SRSRAN_WIENER_UL_NOF_WINDOWS; w++) {
+      if (wiener_ul_filter_gen(&q->filters[b][w], (w + 1) * SRSRAN_NRE, delay_spread_us, noise_var) <
+          SRSRAN_SUCCESS) {
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+static void wiener_ul_default_init(void)
+{
+  wiener_ul_default_ret = srsran_wiener_ul_init(&wiener_ul_default, SRSRAN_WIENER_UL_DEFAULT_DELAY_SPREAD_US);
+}
+
+const srsran_wiener_ul_t* srsran_wiener_ul_get_default(void)
+{
+  pthread_once(&wiener_ul_default_once, wiener_ul_default_init);
+  return (wiener_ul_default_ret == SRSRAN_SUCCESS) ? &wiener_ul_default : NULL;
+}
+
+/*
+ * Applies the same filter to all the windows starting in [0, len), y[i] = sum_j(f[j] * x[i + j]). The taps are
+ * broadcast once and every SIMD register accumulates several consecutive outputs.
+ */
+static void wiener_ul_fir(const cf_t* x, const cf_t* f, uint32_t nof_taps, cf_t* y, uint32_t len)
+{
+  uint32_t i = 0;
+
+#if SRSRAN_SIMD_CF_SIZE
+  simd_cf_t taps[SRSRAN_WIENER_UL_MAX_TAPS];
+  for (uint32_t j = 0; j < nof_taps; j++) {
+    taps[j] = srsran_simd_cf_set1(f[j]);
+  }
+
+  for (; i + SRSRAN_SIMD_CF_SIZE <= len; i += SRSRAN_SIMD_CF_SIZE) {
+    simd_cf_t acc = srsran_simd_cf_zero();
+    for (uint32_t j = 0; j < nof_taps; j++) {
+      acc = srsran_simd_cf_add(acc, srsran_simd_cf_prod(taps[j], srsran_simd_cfi_loadu(&x[i + j])));
+    }
+    srsran_simd_cfi_storeu(&y[i], acc);
+  }
+#endif /* SRSRAN_SIMD_CF_SIZE */
+
+  for (; i < len; i++) {
+    y[i] = srsran_vec_dot_prod_ccc(&x[i], f, nof_taps);
+  }
+}
+
+int srsran_wiener_ul_run(const srsran_wiener_ul_t* q,
+                         const cf_t*               pilots,
+                         cf_t*                     estimated,
+                         uint32_t                  nof_re,
+                         float                     snr_lin)
+{
+  if (q == NULL || pilots == NULL || estimated == NULL || nof_re == 0 || nof_re % SRSRAN_NRE != 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Select SNR bin, assume the highest SNR if it could not be measured
+  uint32_t bin = SRSRAN_WIENER_UL_NOF_SNR_BINS - 1;
+  if (isnormal(snr_lin)) {
+    float snr_db = srsran_convert_power_to_dB(snr_lin);
+    float idx    = roundf((snr_db - SRSRAN_WIENER_UL_SNR_MIN_DB) / SRSRAN_WIENER_UL_SNR_STEP_DB);
+    bin          = (uint32_t)SRSRAN_MAX(0.0f, SRSRAN_MIN(idx, (float)(SRSRAN_WIENER_UL_NOF_SNR_BINS - 1)));
+  }
+
+  // Select window length
+  uint32_t                         N = SRSRAN_MIN(nof_re, SRSRAN_WIENER_UL_MAX_TAPS);
+  const srsran_wiener_ul_filter_t* f = &q->filters[bin][N / SRSRAN_NRE - 1];
+
+  // The subcarriers closer than N / 2 to the allocation edges use the window at the edge and their own filter
+  uint32_t half = N / 2;
+  for (uint32_t k = 0; k < half; k++) {
+    estimated[k] = srsran_vec_dot_prod_ccc(pilots, f->filter[k], N);
+  }
+
+  // Centered windows share the filter of the middle subcarrier
+  wiener_ul_fir(pilots, f->filter[half], N, &estimated[half], nof_re - N + 1);
+
+  for (uint32_t k = nof_re - N + half + 1; k < nof_re; k++) {
+    estimated[k] = srsran_vec_dot_prod_ccc(&pilots[nof_re - N], f->filter[k - (nof_re - N)], N);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_wiener_ul_free(srsran_wiener_ul_t* q)
+{
+  if (q) {
+    bzero(q, sizeof(srsran_wiener_ul_t));
+  }
+}
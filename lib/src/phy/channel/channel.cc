@@ -25,7 +25,10 @@
 
 using namespace srsran;
 
-channel::channel(const channel::args_t& channel_args, uint32_t _nof_channels, srslog::basic_logger& logger) :
+channel::channel(const channel::args_t& channel_args,
+                 uint32_t               _nof_channels,
+                 srslog::basic_logger&  logger,
+                 uint32_t               _nof_ports) :
   logger(logger)
 {
   int      ret         = SRSRAN_SUCCESS;
@@ -51,10 +54,43 @@ channel::channel(const channel::args_t& channel_args, uint32_t _nof_channels, sr
   }
 
   nof_channels = _nof_channels;
+
+  // Spatially correlated fading applies to every group of nof_ports channels (one group per carrier)
+  bool fading_enable =
+      channel_args.fading_enable && !channel_args.fading_model.empty() && channel_args.fading_model != "none";
+  bool fading_mimo_enable = fading_enable && !channel_args.fading_corr.empty() && channel_args.fading_corr != "none";
+  if (fading_mimo_enable && (_nof_ports < 2 || _nof_ports > SRSRAN_CHANNEL_FADING_MIMO_MAX_ANT ||
+                             nof_channels % _nof_ports != 0)) {
+    logger.warning("Channel: correlated fading requires between 2 and %d ports per carrier, using uncorrelated fading",
+                   SRSRAN_CHANNEL_FADING_MIMO_MAX_ANT);
+    fading_mimo_enable = false;
+  }
+
+  if (fading_mimo_enable && ret == SRSRAN_SUCCESS) {
+    nof_ports = _nof_ports;
+    for (uint32_t i = 0; i < nof_channels / nof_ports && ret == SRSRAN_SUCCESS; i++) {
+      fading_mimo[i] = (srsran_channel_fading_mimo_t*)calloc(sizeof(srsran_channel_fading_mimo_t), 1);
+      ret            = srsran_channel_fading_mimo_init(fading_mimo[i],
+                                            srate_max,
+                                            channel_args.fading_model.c_str(),
+                                            channel_args.fading_corr.c_str(),
+                                            channel_args.fading_uplink,
+                                            nof_ports,
+                                            nof_ports,
+                                            0x1234 * i);
+    }
+
+    for (uint32_t i = 0; i < nof_channels && ret == SRSRAN_SUCCESS; i++) {
+      buffer_mimo[i] = srsran_vec_cf_malloc(buffer_size);
+      if (!buffer_mimo[i]) {
+        ret = SRSRAN_ERROR;
+      }
+    }
+  }
+
   for (uint32_t i = 0; i < nof_channels; i++) {
     // Create fading channel
-    if (channel_args.fading_enable && !channel_args.fading_model.empty() && channel_args.fading_model != "none" &&
-        ret == SRSRAN_SUCCESS) {
+    if (fading_enable && !fading_mimo_enable && ret == SRSRAN_SUCCESS) {
       fading[i] = (srsran_channel_fading_t*)calloc(sizeof(srsran_channel_fading_t), 1);
       ret       = srsran_channel_fading_init(fading[i], srate_max, channel_args.fading_model.c_str(), 0x1234 * i);
     } else {
@@ -134,6 +170,15 @@ channel::~channel()
       srsran_channel_delay_free(delay[i]);
       free(delay[i]);
     }
+
+    if (fading_mimo[i]) {
+      srsran_channel_fading_mimo_free(fading_mimo[i]);
+      free(fading_mimo[i]);
+    }
+
+    if (buffer_mimo[i]) {
+      free(buffer_mimo[i]);
+    }
   }
 }
 
@@ -161,6 +206,9 @@ void channel::run(cf_t*                     in[SRSRAN_MAX_CHANNELS],
   for (uint32_t i = 0; i < nof_channels; i++) {
     // Skip iteration if any buffer is null
     if (in[i] == nullptr || out[i] == nullptr) {
+      if (buffer_mimo[i] != nullptr) {
+        srsran_vec_cf_zero(buffer_mimo[i], len);
+      }
       continue;
     }
 
@@ -175,14 +223,12 @@ void channel::run(cf_t*                     in[SRSRAN_MAX_CHANNELS],
     // Copy input buffer
     srsran_vec_cf_copy(buffer_in, in[i], len);
 
-    if (hst) {
-      srsran_channel_hst_execute(hst, buffer_in, buffer_out, len, &t);
-      srsran_vec_sc_prod_ccc(buffer_out, local_cexpf(hst_init_phase), buffer_in, len);
-    }
+    run_pre_fading(len, t);
 
-    if (awgn) {
-      srsran_channel_awgn_run_c(awgn, buffer_in, buffer_out, len);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
+    // Correlated fading needs every port of the carrier, defer the rest of the channel
+    if (buffer_mimo[i] != nullptr) {
+      srsran_vec_cf_copy(buffer_mimo[i], buffer_in, len);
+      continue;
     }
 
     if (fading[i]) {
@@ -190,20 +236,36 @@ void channel::run(cf_t*                     in[SRSRAN_MAX_CHANNELS],
       srsran_vec_cf_copy(buffer_in, buffer_out, len);
     }
 
-    if (delay[i]) {
-      srsran_channel_delay_execute(delay[i], buffer_in, buffer_out, len, &t);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
-    }
-
-    if (rlf) {
-      srsran_channel_rlf_execute(rlf, buffer_in, buffer_out, len, &t);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
-    }
+    run_post_fading(i, len, t);
 
     // Copy output buffer
     srsran_vec_cf_copy(out[i], buffer_in, len);
   }
 
+  if (buffer_mimo[0] != nullptr && current_srate != 0) {
+    // Run correlated fading for each carrier in place
+    for (uint32_t i = 0; i < nof_channels / nof_ports; i++) {
+      if (fading_mimo[i] == nullptr) {
+        continue;
+      }
+      srsran_channel_fading_mimo_execute(
+          fading_mimo[i], &buffer_mimo[i * nof_ports], &buffer_mimo[i * nof_ports], len, t.full_secs + t.frac_secs);
+    }
+
+    for (uint32_t i = 0; i < nof_channels; i++) {
+      if (in[i] == nullptr || out[i] == nullptr) {
+        continue;
+      }
+
+      srsran_vec_cf_copy(buffer_in, buffer_mimo[i], len);
+
+      run_post_fading(i, len, t);
+
+      // Copy output buffer
+      srsran_vec_cf_copy(out[i], buffer_in, len);
+    }
+  }
+
   if (hst) {
     // Increment phase to keep it coherent between frames
     hst_init_phase += (2 * M_PI * len * hst->fs_hz / hst->srate_hz);
@@ -231,6 +293,32 @@ void channel::run(cf_t*                     in[SRSRAN_MAX_CHANNELS],
   logger.debug("%s", str.str().c_str());
 }
 
+void channel::run_pre_fading(uint32_t len, const srsran_timestamp_t& t)
+{
+  if (hst) {
+    srsran_channel_hst_execute(hst, buffer_in, buffer_out, len, &t);
+    srsran_vec_sc_prod_ccc(buffer_out, local_cexpf(hst_init_phase), buffer_in, len);
+  }
+
+  if (awgn) {
+    srsran_channel_awgn_run_c(awgn, buffer_in, buffer_out, len);
+    srsran_vec_cf_copy(buffer_in, buffer_out, len);
+  }
+}
+
+void channel::run_post_fading(uint32_t i, uint32_t len, const srsran_timestamp_t& t)
+{
+  if (delay[i]) {
+    srsran_channel_delay_execute(delay[i], buffer_in, buffer_out, len, &t);
+    srsran_vec_cf_copy(buffer_in, buffer_out, len);
+  }
+
+  if (rlf) {
+    srsran_channel_rlf_execute(rlf, buffer_in, buffer_out, len, &t);
+    srsran_vec_cf_copy(buffer_in, buffer_out, len);
+  }
+}
+
 void channel::set_srate(uint32_t srate)
 {
   if (current_srate != srate) {
@@ -244,6 +332,26 @@ void channel::set_srate(uint32_t srate)
       if (delay[i]) {
         srsran_channel_delay_update_srate(delay[i], srate);
       }
+
+      if (fading_mimo[i]) {
+        srsran_channel_fading_mimo_free(fading_mimo[i]);
+
+        if (srsran_channel_fading_mimo_init(fading_mimo[i],
+                                            srate,
+                                            args.fading_model.c_str(),
+                                            args.fading_corr.c_str(),
+                                            args.fading_uplink,
+                                            nof_ports,
+                                            nof_ports,
+                                            0x1234 * i) < SRSRAN_SUCCESS) {
+          logger.error("Channel: error initialising correlated fading at %.2f MHz, disabling it for carrier %d",
+                       srate / 1e6,
+                       i);
+          srsran_channel_fading_mimo_free(fading_mimo[i]);
+          free(fading_mimo[i]);
+          fading_mimo[i] = nullptr;
+        }
+      }
     }
 
     if (hst) {
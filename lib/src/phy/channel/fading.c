@@ -21,6 +21,7 @@
 
 #include "srsran/phy/channel/fading.h"
 #include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector.h"
 #include <math.h>
 #include <stdio.h>
@@ -45,6 +46,24 @@ const static float relative_power_db[4][SRSRAN_CHANNEL_FADING_MAXTAPS] = {
     /* ETU  */ {-1.0f, -1.0f, -1.0f, +0.0f, +0.0f, +0.0f, -3.0f, -5.0f, -7.0f},
 };
 
+/*
+ * Spatial correlation parameters provided in 36.101 R10 Table B.2.3.1-1. Alpha applies to the eNodeB side and beta
+ * to the UE side, which are the transmitter and receiver in the downlink and the other way around in the uplink.
+ */
+const static float corr_alpha[4] = {/* None */ 0.0f, /* Low */ 0.0f, /* Medium */ 0.3f, /* High */ 0.9f};
+const static float corr_beta[4]  = {/* None */ 0.0f, /* Low */ 0.0f, /* Medium */ 0.9f, /* High */ 0.9f};
+
+/*
+ * Diagonal loading applied to the 4x2 and 4x4 high correlation matrices, 36.101 R10 section B.2.3.2
+ */
+#define FADING_MIMO_CORR_HIGH_A 0.00001
+
+/*
+ * Number of consecutive phasor rotations before the Jakes terms are evaluated again from the absolute time. It bounds
+ * the accumulated rounding error of the recursive rotation.
+ */
+#define FADING_MIMO_MAX_ROTATIONS 1024
+
 static inline int parse_model(srsran_channel_fading_t* q, const char* str)
 {
   int      ret    = SRSRAN_SUCCESS;
@@ -77,6 +96,25 @@ static inline int parse_model(srsran_channel_fading_t* q, const char* str)
   return ret;
 }
 
+static inline int parse_corr(srsran_channel_fading_mimo_t* q, const char* str)
+{
+  int ret = SRSRAN_SUCCESS;
+
+  if (str == NULL || strncmp("none", str, 4) == 0) {
+    q->corr = srsran_channel_fading_corr_none;
+  } else if (strncmp("low", str, 3) == 0) {
+    q->corr = srsran_channel_fading_corr_low;
+  } else if (strncmp("medium", str, 6) == 0) {
+    q->corr = srsran_channel_fading_corr_medium;
+  } else if (strncmp("high", str, 4) == 0) {
+    q->corr = srsran_channel_fading_corr_high;
+  } else {
+    ret = SRSRAN_ERROR;
+  }
+
+  return ret;
+}
+
 #ifdef LV_HAVE_SSE
 #include <immintrin.h>
 static inline __m128 _sine(const float* table, __m128 arg)
@@ -89,7 +127,8 @@ static inline __m128 _sine(const float* table, __m128 arg)
       _mm_round_ps(_mm_mul_ps(arg, _mm_set1_ps(1.0f / (2.0f * (float)M_PI))), (_MM_FROUND_TO_ZERO + _MM_FROUND_NO_EXC));
   __m128  argmod   = _mm_sub_ps(arg, _mm_mul_ps(turns, _mm_set1_ps(2.0f * (float)M_PI)));
   __m128  indexps  = _mm_mul_ps(argmod, _mm_set1_ps(1024.0f / (2.0f * (float)M_PI)));
-  __m128i indexi32 = _mm_abs_epi32(_mm_cvtps_epi32(indexps));
+  // Wrap the index into the table, the rounding may reach the table size and negative angles wrap around
+  __m128i indexi32 = _mm_and_si128(_mm_cvtps_epi32(indexps), _mm_set1_epi32(1023));
   _mm_store_si128((__m128i*)idx, indexi32);
 
   for (int i = 0; i < 4; i++) {
@@ -365,3 +404,463 @@ double srsran_channel_fading_execute(srsran_channel_fading_t* q,
   // Return time
   return init_time;
 }
+
+/*
+ * Single side correlation matrix, 36.101 R10 Table B.2.3.1-2. The coefficient between antennas i and j is
+ * coeff^(((i - j) / (nof_ant - 1))^2)
+ */
+static void fading_mimo_side_corr(float coeff, uint32_t nof_ant, double R[][SRSRAN_CHANNEL_FADING_MIMO_MAX_ANT])
+{
+  for (uint32_t i = 0; i < nof_ant; i++) {
+    for (uint32_t j = 0; j < nof_ant; j++) {
+      if (i == j) {
+        R[i][j] = 1.0;
+      } else {
+        double d = ((double)i - (double)j) / (double)(nof_ant - 1);
+        R[i][j]  = pow(coeff, d * d);
+      }
+    }
+  }
+}
+
+static int fading_mimo_init_corr(srsran_channel_fading_mimo_t* q)
+{
+  double R_tx[SRSRAN_CHANNEL_FADING_MIMO_MAX_ANT][SRSRAN_CHANNEL_FADING_MIMO_MAX_ANT] = {};
+  double R_rx[SRSRAN_CHANNEL_FADING_MIMO_MAX_ANT][SRSRAN_CHANNEL_FADING_MIMO_MAX_ANT] = {};
+  double R[SRSRAN_CHANNEL_FADING_MIMO_MAX_PATHS][SRSRAN_CHANNEL_FADING_MIMO_MAX_PATHS]   = {};
+  double L[SRSRAN_CHANNEL_FADING_MIMO_MAX_PATHS][SRSRAN_CHANNEL_FADING_MIMO_MAX_PATHS]   = {};
+
+  fading_mimo_side_corr(q->uplink ? corr_beta[q->corr] : corr_alpha[q->corr], q->nof_tx, R_tx);
+  fading_mimo_side_corr(q->uplink ? corr_alpha[q->corr] : corr_beta[q->corr], q->nof_rx, R_rx);
+
+  // Spatial correlation matrix R_spat = R_tx (x) R_rx
+  double a = (q->corr == srsran_channel_fading_corr_high && q->nof_paths >= 8) ? FADING_MIMO_CORR_HIGH_A : 0.0;
+  for (uint32_t p = 0; p < q->nof_paths; p++) {
+    for (uint32_t k = 0; k < q->nof_paths; k++) {
+      R[p][k] = R_tx[p / q->nof_rx][k / q->nof_rx] * R_rx[p % q->nof_rx][k % q->nof_rx];
+      if (p == k) {
+        R[p][k] += a;
+      }
+      R[p][k] /= (1.0 + a);
+    }
+  }
+
+  // Cholesky decomposition R_spat = L * L^T
+  for (uint32_t p = 0; p < q->nof_paths; p++) {
+    for (uint32_t k = 0; k <= p; k++) {
+      double sum = R[p][k];
+      for (uint32_t j = 0; j < k; j++) {
+        sum -= L[p][j] * L[k][j];
+      }
+
+      if (p == k) {
+        if (sum <= 0.0) {
+          return SRSRAN_ERROR;
+        }
+        L[p][p] = sqrt(sum);
+      } else {
+        L[p][k] = sum / L[k][k];
+      }
+    }
+  }
+
+  for (uint32_t p = 0; p < q->nof_paths; p++) {
+    for (uint32_t k = 0; k < q->nof_paths; k++) {
+      q->corr_sqrt[p][k] = (float)L[p][k];
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+// Evaluates all the Jakes terms from the absolute time of the given update
+static void fading_mimo_seed_phasors(srsran_channel_fading_mimo_t* q, uint64_t update_idx)
+{
+  double t = (double)update_idx * (double)q->update_len / (double)q->srate;
+
+  for (uint32_t i = 0; i < q->nof_coeff; i++) {
+    double arg        = fmod((double)q->omega[i] * t, 2.0 * M_PI);
+    double arg_a      = arg + q->coeff_a[i];
+    double arg_b      = arg + q->coeff_b[i];
+    q->phasor_a_re[i] = (float)cos(arg_a);
+    q->phasor_a_im[i] = (float)sin(arg_a);
+    q->phasor_b_re[i] = (float)cos(arg_b);
+    q->phasor_b_im[i] = (float)sin(arg_b);
+  }
+}
+
+// Accumulates the scaled frequency response of every tap into the response of one path
+static void fading_mimo_path_response(srsran_channel_fading_mimo_t* q, uint32_t path)
+{
+  cf_t*    h = q->h_freq[path];
+  uint32_t i = 0;
+
+#if SRSRAN_SIMD_CF_SIZE
+  simd_cf_t gain[SRSRAN_CHANNEL_FADING_MAXTAPS];
+  for (uint32_t tap = 0; tap < q->nof_taps; tap++) {
+    gain[tap] = srsran_simd_cf_set1(q->gain[tap][path]);
+  }
+
+  for (; i < q->N - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
+    simd_cf_t acc = srsran_simd_cf_prod(srsran_simd_cfi_load(&q->h_tap[0][i]), gain[0]);
+    for (uint32_t tap = 1; tap < q->nof_taps; tap++) {
+      acc = srsran_simd_cf_add(acc, srsran_simd_cf_prod(srsran_simd_cfi_load(&q->h_tap[tap][i]), gain[tap]));
+    }
+    srsran_simd_cfi_store(&h[i], acc);
+  }
+#endif /* SRSRAN_SIMD_CF_SIZE */
+
+  for (; i < q->N; i++) {
+    cf_t acc = 0;
+    for (uint32_t tap = 0; tap < q->nof_taps; tap++) {
+      acc += q->h_tap[tap][i] * q->gain[tap][path];
+    }
+    h[i] = acc;
+  }
+}
+
+static void fading_mimo_update_taps(srsran_channel_fading_mimo_t* q, uint64_t update_idx)
+{
+  // Taps are constant during an update period
+  if (q->taps_valid && update_idx == q->update_idx) {
+    return;
+  }
+
+  // Consecutive updates rotate all the terms at once, otherwise they are evaluated from the absolute time
+  if (q->taps_valid && update_idx == q->update_idx + 1 && q->nof_rotations < FADING_MIMO_MAX_ROTATIONS) {
+    srsran_vec_prod_ccc_split(
+        q->phasor_a_re, q->phasor_a_im, q->rot_re, q->rot_im, q->phasor_a_re, q->phasor_a_im, q->nof_coeff);
+    srsran_vec_prod_ccc_split(
+        q->phasor_b_re, q->phasor_b_im, q->rot_re, q->rot_im, q->phasor_b_re, q->phasor_b_im, q->nof_coeff);
+    q->nof_rotations++;
+  } else {
+    fading_mimo_seed_phasors(q, update_idx);
+    q->nof_rotations = 0;
+  }
+  q->update_idx = update_idx;
+  q->taps_valid = true;
+
+  // Sum the Jakes terms of every tap and path, then apply the spatial correlation
+  const float recN = 1.0f / sqrtf(SRSRAN_CHANNEL_FADING_NTERMS);
+  for (uint32_t tap = 0; tap < q->nof_taps; tap++) {
+    cf_t g[SRSRAN_CHANNEL_FADING_MIMO_MAX_PATHS];
+    for (uint32_t p = 0; p < q->nof_paths; p++) {
+      uint32_t idx = (tap * q->nof_paths + p) * SRSRAN_CHANNEL_FADING_NTERMS;
+      __real__ g[p] = srsran_vec_acc_ff(&q->phasor_a_re[idx], SRSRAN_CHANNEL_FADING_NTERMS) * recN;
+      __imag__ g[p] = srsran_vec_acc_ff(&q->phasor_b_im[idx], SRSRAN_CHANNEL_FADING_NTERMS) * recN;
+    }
+
+    for (uint32_t p = 0; p < q->nof_paths; p++) {
+      cf_t acc = 0;
+      for (uint32_t k = 0; k <= p; k++) {
+        acc += q->corr_sqrt[p][k] * g[k];
+      }
+      q->gain[tap][p] = acc;
+    }
+  }
+
+  // Generate the frequency response of every path
+  for (uint32_t p = 0; p < q->nof_paths; p++) {
+    fading_mimo_path_response(q, p);
+  }
+}
+
+// Accumulates the product of every transmit antenna spectrum with its path response to the given receive antenna
+static void fading_mimo_combine(srsran_channel_fading_mimo_t* q, uint32_t rx)
+{
+  uint32_t i = 0;
+
+#if SRSRAN_SIMD_CF_SIZE
+  for (; i < q->N - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
+    simd_cf_t acc =
+        srsran_simd_cf_prod(srsran_simd_cfi_load(&q->x_freq[0][i]), srsran_simd_cfi_load(&q->h_freq[rx][i]));
+    for (uint32_t tx = 1; tx < q->nof_tx; tx++) {
+      simd_cf_t x = srsran_simd_cfi_load(&q->x_freq[tx][i]);
+      simd_cf_t h = srsran_simd_cfi_load(&q->h_freq[tx * q->nof_rx + rx][i]);
+      acc         = srsran_simd_cf_add(acc, srsran_simd_cf_prod(x, h));
+    }
+    srsran_simd_cfi_store(&q->y_freq[i], acc);
+  }
+#endif /* SRSRAN_SIMD_CF_SIZE */
+
+  for (; i < q->N; i++) {
+    cf_t acc = 0;
+    for (uint32_t tx = 0; tx < q->nof_tx; tx++) {
+      acc += q->x_freq[tx][i] * q->h_freq[tx * q->nof_rx + rx][i];
+    }
+    q->y_freq[i] = acc;
+  }
+}
+
+/*
+ * Overlap-save filtering: every transmit antenna keeps a window of the last N input samples, so only one FFT per
+ * transmit antenna and one iFFT per receive antenna are required for each segment regardless of the number of paths.
+ */
+static void fading_mimo_filter_segment(srsran_channel_fading_mimo_t* q,
+                                       const cf_t* const*            input,
+                                       cf_t**                        output,
+                                       uint32_t                      offset,
+                                       uint32_t                      nsamples)
+{
+  for (uint32_t tx = 0; tx < q->nof_tx; tx++) {
+    // Slide window and append new samples
+    memmove(q->window[tx], &q->window[tx][nsamples], sizeof(cf_t) * (q->N - nsamples));
+    if (input[tx] != NULL) {
+      srsran_vec_cf_copy(&q->window[tx][q->N - nsamples], &input[tx][offset], nsamples);
+    } else {
+      srsran_vec_cf_zero(&q->window[tx][q->N - nsamples], nsamples);
+    }
+
+    // Do FFT
+    srsran_dft_run_c_zerocopy(&q->fft, q->window[tx], q->x_freq[tx]);
+  }
+
+  for (uint32_t rx = 0; rx < q->nof_rx; rx++) {
+    if (output[rx] == NULL) {
+      continue;
+    }
+
+    // Apply channel
+    fading_mimo_combine(q, rx);
+
+    // Do iFFT
+    srsran_dft_run_c_zerocopy(&q->ifft, q->y_freq, q->temp);
+
+    // The last nsamples are free of circular aliasing
+    srsran_vec_cf_copy(&output[rx][offset], &q->temp[q->N - nsamples], nsamples);
+  }
+}
+
+int srsran_channel_fading_mimo_init(srsran_channel_fading_mimo_t* q,
+                                    double                        srate,
+                                    const char*                   model,
+                                    const char*                   corr,
+                                    bool                          uplink,
+                                    uint32_t                      nof_tx,
+                                    uint32_t                      nof_rx,
+                                    uint32_t                      seed)
+{
+  int ret = SRSRAN_ERROR;
+
+  if (q == NULL || model == NULL || nof_tx == 0 || nof_tx > SRSRAN_CHANNEL_FADING_MIMO_MAX_ANT || nof_rx == 0 ||
+      nof_rx > SRSRAN_CHANNEL_FADING_MIMO_MAX_ANT) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_channel_fading_mimo_t, 1);
+
+  // Parse model
+  srsran_channel_fading_t siso = {};
+  if (parse_model(&siso, model) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Error: invalid channel model '%s'\n", model);
+    return SRSRAN_ERROR;
+  }
+  q->model   = siso.model;
+  q->doppler = siso.doppler;
+
+  // Parse correlation
+  if (parse_corr(q, corr) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Error: invalid channel correlation '%s'\n", corr);
+    return SRSRAN_ERROR;
+  }
+
+  // Fill dimensions
+  q->srate     = (float)srate;
+  q->uplink    = uplink;
+  q->nof_tx    = nof_tx;
+  q->nof_rx    = nof_rx;
+  q->nof_paths = nof_tx * nof_rx;
+  q->nof_taps  = nof_taps[q->model];
+  q->nof_coeff = q->nof_taps * q->nof_paths * SRSRAN_CHANNEL_FADING_NTERMS;
+
+  // Populate internal parameters, same FFT size than the single antenna emulator
+  uint32_t fft_min_pow =
+      (uint32_t)round(log2(excess_tap_delay_ns[q->model][q->nof_taps - 1] * 1e-9 * srate)) + 3;
+  q->N          = SRSRAN_MAX(1U << fft_min_pow, (uint32_t)(srate / (15e3f * 4.0f)));
+  q->path_delay = q->N / 4;
+  q->update_len = q->N / 2;
+
+  if (fading_mimo_init_corr(q) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Error: spatial correlation matrix is not positive definite\n");
+    goto clean_exit;
+  }
+
+  // Allocate Jakes terms
+  q->phasor_a_re = srsran_vec_f_malloc(q->nof_coeff);
+  q->phasor_a_im = srsran_vec_f_malloc(q->nof_coeff);
+  q->phasor_b_re = srsran_vec_f_malloc(q->nof_coeff);
+  q->phasor_b_im = srsran_vec_f_malloc(q->nof_coeff);
+  q->rot_re      = srsran_vec_f_malloc(q->nof_coeff);
+  q->rot_im      = srsran_vec_f_malloc(q->nof_coeff);
+  q->omega       = srsran_vec_f_malloc(q->nof_coeff);
+  q->coeff_a     = srsran_vec_f_malloc(q->nof_coeff);
+  q->coeff_b     = srsran_vec_f_malloc(q->nof_coeff);
+  if (!q->phasor_a_re || !q->phasor_a_im || !q->phasor_b_re || !q->phasor_b_im || !q->rot_re || !q->rot_im ||
+      !q->omega || !q->coeff_a || !q->coeff_b) {
+    fprintf(stderr, "Error: allocating Jakes terms\n");
+    goto clean_exit;
+  }
+
+  // Initialise random Jakes model coefficients, every tap and path is independent before correlation
+  srsran_random_t random = srsran_random_init(seed);
+  double          dt     = (double)q->update_len / (double)srate;
+  for (uint32_t i = 0; i < q->nof_coeff; i += SRSRAN_CHANNEL_FADING_NTERMS) {
+    float theta = srsran_random_uniform_real_dist(random, -(float)M_PI, (float)M_PI);
+    for (uint32_t j = 0; j < SRSRAN_CHANNEL_FADING_NTERMS; j++) {
+      float alpha = (2.0f * (float)M_PI * (j + 1) - (float)M_PI + theta) / (4.0f * SRSRAN_CHANNEL_FADING_NTERMS);
+
+      q->omega[i + j]   = 2.0f * (float)M_PI * q->doppler * cosf(alpha);
+      q->coeff_a[i + j] = srsran_random_uniform_real_dist(random, 0, 2.0f * (float)M_PI);
+      q->coeff_b[i + j] = srsran_random_uniform_real_dist(random, 0, 2.0f * (float)M_PI);
+      q->rot_re[i + j]  = (float)cos(q->omega[i + j] * dt);
+      q->rot_im[i + j]  = (float)sin(q->omega[i + j] * dt);
+    }
+  }
+  srsran_random_free(random);
+
+  // Generate tap frequency responses, normalised to unitary average power
+  float total_power = 0.0f;
+  for (uint32_t i = 0; i < q->nof_taps; i++) {
+    total_power += srsran_convert_dB_to_power(relative_power_db[q->model][i]);
+  }
+  for (uint32_t i = 0; i < q->nof_taps; i++) {
+    q->h_tap[i] = srsran_vec_cf_malloc(q->N);
+    if (!q->h_tap[i]) {
+      fprintf(stderr, "Error: allocating h_tap\n");
+      goto clean_exit;
+    }
+
+    float amplitude = sqrtf(srsran_convert_dB_to_power(relative_power_db[q->model][i]) / total_power);
+    float O         = (excess_tap_delay_ns[q->model][i] * 1e-9f * q->srate + q->path_delay) / (float)q->N;
+    srsran_vec_gen_sine(amplitude / q->N, -O, q->h_tap[i], q->N);
+  }
+
+  for (uint32_t p = 0; p < q->nof_paths; p++) {
+    q->h_freq[p] = srsran_vec_cf_malloc(q->N);
+    if (!q->h_freq[p]) {
+      fprintf(stderr, "Error: allocating h_freq\n");
+      goto clean_exit;
+    }
+  }
+
+  for (uint32_t tx = 0; tx < q->nof_tx; tx++) {
+    q->x_freq[tx] = srsran_vec_cf_malloc(q->N);
+    q->window[tx] = srsran_vec_cf_malloc(q->N);
+    if (!q->x_freq[tx] || !q->window[tx]) {
+      fprintf(stderr, "Error: allocating window\n");
+      goto clean_exit;
+    }
+    srsran_vec_cf_zero(q->window[tx], q->N);
+  }
+
+  q->y_freq = srsran_vec_cf_malloc(q->N);
+  q->temp   = srsran_vec_cf_malloc(q->N);
+  if (!q->y_freq || !q->temp) {
+    fprintf(stderr, "Error: allocating y_freq\n");
+    goto clean_exit;
+  }
+
+  // Plan FFT
+  if (srsran_dft_plan_c(&q->fft, q->N, SRSRAN_DFT_FORWARD) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Error: planning fft\n");
+    goto clean_exit;
+  }
+
+  // Plan iFFT
+  if (srsran_dft_plan_c(&q->ifft, q->N, SRSRAN_DFT_BACKWARD) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Error: planning ifft\n");
+    goto clean_exit;
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  return ret;
+}
+
+void srsran_channel_fading_mimo_free(srsran_channel_fading_mimo_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  srsran_dft_plan_free(&q->fft);
+  srsran_dft_plan_free(&q->ifft);
+
+  float* coeff[] = {q->phasor_a_re,
+                    q->phasor_a_im,
+                    q->phasor_b_re,
+                    q->phasor_b_im,
+                    q->rot_re,
+                    q->rot_im,
+                    q->omega,
+                    q->coeff_a,
+                    q->coeff_b};
+  for (uint32_t i = 0; i < sizeof(coeff) / sizeof(coeff[0]); i++) {
+    if (coeff[i]) {
+      free(coeff[i]);
+    }
+  }
+
+  for (uint32_t i = 0; i < SRSRAN_CHANNEL_FADING_MAXTAPS; i++) {
+    if (q->h_tap[i]) {
+      free(q->h_tap[i]);
+    }
+  }
+
+  for (uint32_t p = 0; p < SRSRAN_CHANNEL_FADING_MIMO_MAX_PATHS; p++) {
+    if (q->h_freq[p]) {
+      free(q->h_freq[p]);
+    }
+  }
+
+  for (uint32_t tx = 0; tx < SRSRAN_CHANNEL_FADING_MIMO_MAX_ANT; tx++) {
+    if (q->x_freq[tx]) {
+      free(q->x_freq[tx]);
+    }
+    if (q->window[tx]) {
+      free(q->window[tx]);
+    }
+  }
+
+  if (q->y_freq) {
+    free(q->y_freq);
+  }
+
+  if (q->temp) {
+    free(q->temp);
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_channel_fading_mimo_t, 1);
+}
+
+double srsran_channel_fading_mimo_execute(srsran_channel_fading_mimo_t* q,
+                                          const cf_t* const*            in,
+                                          cf_t**                        out,
+                                          uint32_t                      nsamples,
+                                          double                        init_time)
+{
+  if (q == NULL || in == NULL || out == NULL) {
+    return init_time;
+  }
+
+  // Taps are updated on a fixed time grid, so segments never cross an update boundary
+  uint64_t sample_idx = (uint64_t)SRSRAN_MAX(0, llround(init_time * q->srate));
+  uint32_t counter    = 0;
+  while (counter < nsamples) {
+    uint64_t update_idx = sample_idx / q->update_len;
+    uint32_t n          = SRSRAN_MIN(q->update_len - (uint32_t)(sample_idx % q->update_len), nsamples - counter);
+
+    // Generate taps
+    fading_mimo_update_taps(q, update_idx);
+
+    // Execute
+    fading_mimo_filter_segment(q, in, out, counter, n);
+
+    sample_idx += n;
+    counter += n;
+  }
+
+  // Return time
+  return init_time + nsamples / q->srate;
+}
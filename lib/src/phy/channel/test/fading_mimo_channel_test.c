@@ -0,0 +1,227 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/channel/fading.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+#include <complex.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+static srsran_channel_fading_mimo_t channel_fading = {};
+
+static char     default_model[] = "etu300";
+static char     default_corr[]  = "medium";
+static uint32_t duration_ms     = 1000;
+static char*    model           = default_model;
+static char*    corr            = default_corr;
+static uint32_t srate           = (uint32_t)1.92e6;
+static uint32_t nof_tx          = 2;
+static uint32_t nof_rx          = 2;
+static uint32_t random_seed     = 0x12345678; // Default seed, deterministic channel
+static bool     uplink          = false;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [mctsxyru]\n", prog);
+  printf("\t-m Channel model: epa5, eva70, etu300 [Default %s]\n", model);
+  printf("\t-c Spatial correlation: none, low, medium, high [Default %s]\n", corr);
+  printf("\t-t Simulation time in ms: [Default %d]\n", duration_ms);
+  printf("\t-s Sampling rate in Hz: [Default %d]\n", srate);
+  printf("\t-x Number of transmit antennas: [Default %d]\n", nof_tx);
+  printf("\t-y Number of receive antennas: [Default %d]\n", nof_rx);
+  printf("\t-r Random generator seed: [Default %d]\n", random_seed);
+  printf("\t-u Uplink, the eNodeB correlation applies to the receive antennas: [Default %s]\n", uplink ? "yes" : "no");
+}
+
+static int parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "mctsxyru")) != -1) {
+    switch (opt) {
+      case 'm':
+        model = argv[optind];
+        break;
+      case 'c':
+        corr = argv[optind];
+        break;
+      case 't':
+        duration_ms = (uint32_t)strtof(argv[optind], NULL);
+        break;
+      case 's':
+        srate = (uint32_t)strtof(argv[optind], NULL);
+        break;
+      case 'x':
+        nof_tx = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'y':
+        nof_rx = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        random_seed = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'u':
+        uplink = true;
+        break;
+      default:
+        usage(argv[0]);
+        return SRSRAN_ERROR;
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+/*
+ * Expected correlation coefficient between two paths, TS 36.101 Table B.2.3.1-1 and B.2.3.1-2
+ */
+static float expected_corr(uint32_t p, uint32_t k)
+{
+  float alpha = 0.0f;
+  float beta  = 0.0f;
+  if (strcmp(corr, "medium") == 0) {
+    alpha = 0.3f;
+    beta  = 0.9f;
+  } else if (strcmp(corr, "high") == 0) {
+    alpha = 0.9f;
+    beta  = 0.9f;
+  }
+
+  // Alpha is the eNodeB side coefficient, beta the UE side one
+  float tx_coeff = uplink ? beta : alpha;
+  float rx_coeff = uplink ? alpha : beta;
+
+  float d_tx = (nof_tx > 1) ? fabsf((float)(p / nof_rx) - (float)(k / nof_rx)) / (float)(nof_tx - 1) : 0.0f;
+  float d_rx = (nof_rx > 1) ? fabsf((float)(p % nof_rx) - (float)(k % nof_rx)) / (float)(nof_rx - 1) : 0.0f;
+
+  return ((d_tx > 0) ? powf(tx_coeff, d_tx * d_tx) : 1.0f) * ((d_rx > 0) ? powf(rx_coeff, d_rx * d_rx) : 1.0f);
+}
+
+int main(int argc, char** argv)
+{
+  int             ret                                               = SRSRAN_ERROR;
+  cf_t*           input_buffer[SRSRAN_CHANNEL_FADING_MIMO_MAX_ANT]  = {};
+  cf_t*           output_buffer[SRSRAN_CHANNEL_FADING_MIMO_MAX_ANT] = {};
+  struct timeval  t[3]                                              = {};
+  uint64_t        time_usec                                         = 0;
+  uint32_t        sf_len                                            = 0;
+  srsran_random_t random                                            = NULL;
+  cf_t            corr_acc[SRSRAN_CHANNEL_FADING_MIMO_MAX_PATHS][SRSRAN_CHANNEL_FADING_MIMO_MAX_PATHS] = {};
+
+  // Parse arguments
+  if (parse_args(argc, argv) < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+  sf_len = srate / 1000;
+
+  // Initialise channel
+  if (srsran_channel_fading_mimo_init(&channel_fading, srate, model, corr, uplink, nof_tx, nof_rx, random_seed)) {
+    fprintf(stderr,
+            "Error: initialising fading channel. model=%s, corr=%s, srate=%d, %dx%d\n",
+            model,
+            corr,
+            srate,
+            nof_tx,
+            nof_rx);
+    goto clean_exit;
+  }
+
+  // Allocate buffers and fill the inputs with random samples
+  random = srsran_random_init(random_seed);
+  for (uint32_t i = 0; i < nof_tx; i++) {
+    input_buffer[i] = srsran_vec_cf_malloc(sf_len);
+    if (!input_buffer[i]) {
+      fprintf(stderr, "Error: allocating input buffer\n");
+      goto clean_exit;
+    }
+    srsran_random_uniform_complex_dist_vector(random, input_buffer[i], sf_len, -1.0f, +1.0f);
+  }
+  for (uint32_t i = 0; i < nof_rx; i++) {
+    output_buffer[i] = srsran_vec_cf_malloc(sf_len);
+    if (!output_buffer[i]) {
+      fprintf(stderr, "Error: allocating output buffer\n");
+      goto clean_exit;
+    }
+  }
+
+  printf("-- Starting MIMO Fading channel simulator. srate=%.2fMHz; model=%s; corr=%s; %dx%d; duration=%dms\n",
+         (double)srate / 1e6,
+         model,
+         corr,
+         nof_tx,
+         nof_rx,
+         duration_ms);
+
+  for (uint32_t i = 0; i < duration_ms; i++) {
+    gettimeofday(&t[1], NULL);
+    srsran_channel_fading_mimo_execute(
+        &channel_fading, (const cf_t* const*)input_buffer, output_buffer, sf_len, (double)i / 1000.0);
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    time_usec += (uint64_t)(t->tv_sec * 1e6 + t->tv_usec);
+
+    // Accumulate first tap spatial correlation
+    for (uint32_t p = 0; p < channel_fading.nof_paths; p++) {
+      for (uint32_t k = 0; k < channel_fading.nof_paths; k++) {
+        corr_acc[p][k] += channel_fading.gain[0][p] * conjf(channel_fading.gain[0][k]);
+      }
+    }
+  }
+
+  // Check the measured correlation coefficients against the expected ones
+  for (uint32_t p = 0; p < channel_fading.nof_paths; p++) {
+    for (uint32_t k = 0; k < channel_fading.nof_paths; k++) {
+      float measured = cabsf(corr_acc[p][k]) / sqrtf(crealf(corr_acc[p][p]) * crealf(corr_acc[k][k]));
+      float expected = expected_corr(p, k);
+      if (fabsf(measured - expected) > 0.15f) {
+        fprintf(stderr, "Error: path %d-%d correlation %.3f does not match expected %.3f\n", p, k, measured, expected);
+        goto clean_exit;
+      }
+    }
+  }
+
+  // Print results and exit
+  if (time_usec) {
+    double msps = (double)duration_ms * sf_len / (double)time_usec;
+    printf("Ok ... %.1f MSps per antenna; %.1f MSps per path\n", msps, msps * channel_fading.nof_paths);
+    ret = SRSRAN_SUCCESS;
+  } else {
+    printf("Error in Msps calculation: undefined division\n");
+  }
+
+clean_exit:
+  for (uint32_t i = 0; i < SRSRAN_CHANNEL_FADING_MIMO_MAX_ANT; i++) {
+    if (input_buffer[i]) {
+      free(input_buffer[i]);
+    }
+    if (output_buffer[i]) {
+      free(output_buffer[i]);
+    }
+  }
+  if (random) {
+    srsran_random_free(random);
+  }
+  srsran_channel_fading_mimo_free(&channel_fading);
+  return ret;
+}
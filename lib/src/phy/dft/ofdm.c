@@ -563,6 +563,24 @@ void srsran_ofdm_rx_sf(srsran_ofdm_t* q)
   }
 }
 
+void srsran_ofdm_rx_slot(srsran_ofdm_t* q, uint32_t slot_in_sf)
+{
+  if (slot_in_sf >= SRSRAN_NOF_SLOTS_PER_SF) {
+    return;
+  }
+  if (isnormal(q->cfg.freq_shift_f)) {
+    srsran_vec_prod_ccc(&q->cfg.in_buffer[slot_in_sf * q->slot_sz],
+                        &q->shift_buffer[slot_in_sf * q->slot_sz],
+                        &q->cfg.in_buffer[slot_in_sf * q->slot_sz],
+                        q->slot_sz);
+  }
+  if (q->mbsfn_subframe && slot_in_sf == 0) {
+    ofdm_rx_slot_mbsfn(q, q->cfg.in_buffer, q->cfg.out_buffer);
+  } else {
+    ofdm_rx_slot(q, slot_in_sf);
+  }
+}
+
 void srsran_ofdm_rx_sf_ng(srsran_ofdm_t* q, cf_t* input, cf_t* output)
 {
   uint32_t n;
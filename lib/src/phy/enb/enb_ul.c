@@ -76,6 +76,24 @@ clean_exit:
   return ret;
 }
 
+int srsran_enb_ul_init_shared(srsran_enb_ul_t* q, srsran_enb_ul_t* src, uint32_t max_prb)
+{
+  if (q == NULL || src == NULL || src->sf_symbols == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (srsran_enb_ul_init(q, NULL, max_prb)) {
+    return SRSRAN_ERROR;
+  }
+
+  // Replace the own resource grid by the source one
+  free(q->sf_symbols);
+  q->sf_symbols        = src->sf_symbols;
+  q->sf_symbols_shared = true;
+
+  return SRSRAN_SUCCESS;
+}
+
 void srsran_enb_ul_free(srsran_enb_ul_t* q)
 {
   if (q) {
@@ -84,7 +102,7 @@ void srsran_enb_ul_free(srsran_enb_ul_t* q)
     srsran_pusch_free(&q->pusch);
     srsran_chest_ul_free(&q->chest);
 
-    if (q->sf_symbols) {
+    if (q->sf_symbols && !q->sf_symbols_shared) {
       free(q->sf_symbols);
     }
     if (q->chest_res.ce) {
@@ -105,21 +123,24 @@ int srsran_enb_ul_set_cell(srsran_enb_ul_t*                   q,
     if (cell.id != q->cell.id || q->cell.nof_prb == 0) {
       q->cell = cell;
 
-      srsran_ofdm_cfg_t ofdm_cfg = {};
-      ofdm_cfg.nof_prb           = q->cell.nof_prb;
-      ofdm_cfg.in_buffer         = q->in_buffer;
-      ofdm_cfg.out_buffer        = q->sf_symbols;
-      ofdm_cfg.cp                = q->cell.cp;
-      ofdm_cfg.freq_shift_f      = -0.5f;
-      ofdm_cfg.normalize         = false;
-      ofdm_cfg.rx_window_offset  = 0.5f;
-      if (srsran_ofdm_rx_init_cfg(&q->fft, &ofdm_cfg)) {
-        ERROR("Error initiating FFT");
-        return SRSRAN_ERROR;
-      }
-      if (srsran_ofdm_rx_set_prb(&q->fft, q->cell.cp, q->cell.nof_prb)) {
-        ERROR("Error initiating FFT");
-        return SRSRAN_ERROR;
+      // Objects sharing the resource grid of another one do not demodulate
+      if (!q->sf_symbols_shared) {
+        srsran_ofdm_cfg_t ofdm_cfg = {};
+        ofdm_cfg.nof_prb           = q->cell.nof_prb;
+        ofdm_cfg.in_buffer         = q->in_buffer;
+        ofdm_cfg.out_buffer        = q->sf_symbols;
+        ofdm_cfg.cp                = q->cell.cp;
+        ofdm_cfg.freq_shift_f      = -0.5f;
+        ofdm_cfg.normalize         = false;
+        ofdm_cfg.rx_window_offset  = 0.5f;
+        if (srsran_ofdm_rx_init_cfg(&q->fft, &ofdm_cfg)) {
+          ERROR("Error initiating FFT");
+          return SRSRAN_ERROR;
+        }
+        if (srsran_ofdm_rx_set_prb(&q->fft, q->cell.cp, q->cell.nof_prb)) {
+          ERROR("Error initiating FFT");
+          return SRSRAN_ERROR;
+        }
       }
 
       if (srsran_pucch_set_cell(&q->pucch, q->cell)) {
@@ -153,6 +174,11 @@ void srsran_enb_ul_fft(srsran_enb_ul_t* q)
   srsran_ofdm_rx_sf(&q->fft);
 }
 
+void srsran_enb_ul_fft_slot(srsran_enb_ul_t* q, uint32_t slot_idx)
+{
+  srsran_ofdm_rx_slot(&q->fft, slot_idx);
+}
+
 static int get_pucch(srsran_enb_ul_t* q, srsran_ul_sf_cfg_t* ul_sf, srsran_pucch_cfg_t* cfg, srsran_pucch_res_t* res)
 {
   int      ret                               = SRSRAN_SUCCESS;
@@ -281,3 +307,27 @@ int srsran_enb_ul_get_pusch(srsran_enb_ul_t*    q,
 
   return srsran_pusch_decode(&q->pusch, ul_sf, cfg, &q->chest_res, q->sf_symbols, res);
 }
+
+int srsran_enb_ul_get_pusch_slot(srsran_enb_ul_t*    q,
+                                 srsran_ul_sf_cfg_t* ul_sf,
+                                 srsran_pusch_cfg_t* cfg,
+                                 uint32_t            slot_idx,
+                                 void*               llr,
+                                 srsran_pusch_res_t* res)
+{
+  if (srsran_chest_ul_estimate_pusch_slot(&q->chest, ul_sf, cfg, q->sf_symbols, slot_idx, &q->chest_res) <
+      SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  return srsran_pusch_demod_slot(&q->pusch, ul_sf, cfg, &q->chest_res, q->sf_symbols, slot_idx, llr, res);
+}
+
+int srsran_enb_ul_decode_pusch_llr(srsran_enb_ul_t*    q,
+                                   srsran_ul_sf_cfg_t* ul_sf,
+                                   srsran_pusch_cfg_t* cfg,
+                                   void*               llr,
+                                   srsran_pusch_res_t* res)
+{
+  return srsran_pusch_decode_llr(&q->pusch, ul_sf, cfg, llr, res);
+}
@@ -33,6 +33,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "srsran/phy/fec/ldpc/ldpc_common.h" //FILLER_BIT definition
 #include "srsran/phy/fec/ldpc/ldpc_rm.h"
@@ -40,6 +41,10 @@
 
 #include "srsran/phy/utils/debug.h"
 
+#if defined(LV_HAVE_AVX2) || defined(LV_HAVE_AVX512)
+#include <immintrin.h>
+#endif // LV_HAVE_AVX2 || LV_HAVE_AVX512
+
 //#define debug
 /*!
  * \brief Look-up table: k0 indices
@@ -76,6 +81,16 @@ static const uint32_t BASEK[2] = {22, 10};
  */
 static const uint32_t MAXE = 273 * 13 * 12 * 8 * 4;
 
+/*!
+ * \brief Number of columns of the bit interleaver that are deinterleaved at once by the rate dematcher.
+ *
+ * The rate dematcher deinterleaves a block of columns into a temporal buffer of
+ * RM_RX_BLOCK_LEN x mod_order soft bits and combines it straight away, so the temporal
+ * buffer stays in the L1 cache.
+ */
+#define RM_RX_BLOCK_LEN 256
+#define RM_RX_TMP_LEN (RM_RX_BLOCK_LEN * SRSRAN_MAX_QM)
+
 /*!
  * \brief Describes an rate matcher.
  */
@@ -87,26 +102,38 @@ struct pRM_tx {
  * \brief Describes an rate dematcher (float version).
  */
 struct pRM_rx_f {
-  float*    tmp_rm_symbol; /*!< \brief Pointer to a temporal buffer between bit-selection and interleaver. */
-  uint32_t* indices;       /*!< \brief Pointer to a temporal buffer with the indices for bit-selection. */
+  float* tmp_rm_symbol; /*!< \brief Pointer to a temporal buffer between interleaver and bit-selection. */
 };
 
 /*!
  * \brief Describes an rate dematcher (short version).
  */
 struct pRM_rx_s {
-  int16_t*  tmp_rm_symbol; /*!< \brief Pointer to a temporal buffer between bit-selection and interleaver. */
-  uint32_t* indices;       /*!< \brief Pointer to a temporal buffer with the indices for bit-selection. */
+  int16_t* tmp_rm_symbol; /*!< \brief Pointer to a temporal buffer between interleaver and bit-selection. */
 };
 
 /*!
  * \brief Describes an rate dematcher (char version).
  */
 struct pRM_rx_c {
-  int8_t*   tmp_rm_symbol; /*!< \brief Pointer to a temporal buffer between bit-selection and interleaver. */
-  uint32_t* indices;       /*!< \brief Pointer to a temporal buffer with the indices for bit-selection. */
+  int8_t* tmp_rm_symbol; /*!< \brief Pointer to a temporal buffer between interleaver and bit-selection. */
 };
 
+/*!
+ * \brief Circular buffer walk of the rate dematcher.
+ *
+ * The soft bits selected by the rate matcher are consecutive positions of the circular
+ * buffer, starting at k0, that skip the filler bits and wrap around Ncb. The walk gives
+ * them as runs of consecutive positions, so they are combined with vector operations.
+ */
+typedef struct {
+  uint32_t Ncb;         /*!< \brief Circular buffer length. */
+  uint32_t ini_exclude; /*!< \brief First filler bit position within the circular buffer. */
+  uint32_t nof_filler;  /*!< \brief Number of filler bits within the circular buffer. */
+  uint32_t nof_bits;    /*!< \brief Number of positions that are not filler bits. */
+  uint32_t rank_k0;     /*!< \brief Index of the first selected position among the non-filler positions. */
+} rm_rx_walk_t;
+
 /*!
  * Initialize rate-matching parameters
  */
@@ -169,6 +196,7 @@ static int init_rm(srsran_ldpc_rm_t*  p,
 /*!
  * Bit selection for the rate-matching block. Selects out_len bits, starting from
  * the k0th, ingoring filler bits, and consider an input buffer of length Ncb.
+ * Runs of bits without filler bits are copied at once.
  */
 static void bit_selection_rm_tx(const uint8_t* input,
                                 uint8_t*       output,
@@ -179,169 +207,198 @@ static void bit_selection_rm_tx(const uint8_t* input,
   uint32_t E = out_len;
 
   uint32_t k    = 0;
-  uint32_t j    = 0;
-  uint32_t icwd = 0;
+  uint32_t icwd = k0 % Ncb;
 
   while (k < E) {
-    icwd = (k0 + j) % Ncb;
-    if (input[icwd] != FILLER_BIT) {
-      output[k] = input[icwd];
-      k         = k + 1;
+    uint32_t       len    = SRSRAN_MIN(Ncb - icwd, E - k);
+    const uint8_t* filler = memchr(&input[icwd], FILLER_BIT, len);
+    if (filler != NULL) {
+      len = (uint32_t)(filler - &input[icwd]);
+    }
+    srsran_vec_u8_copy(&output[k], &input[icwd], len);
+    k    = k + len;
+    icwd = icwd + len;
+
+    // skip filler bits
+    while (icwd < Ncb && input[icwd] == FILLER_BIT) {
+      icwd = icwd + 1;
+    }
+    if (icwd == Ncb) {
+      icwd = 0;
     }
-    j = j + 1;
   } // while
 }
 
 /*!
- * Undoes bit selection for the rate-dematching block.
- * The output has the codeword length N. It inserts filler bits as INFINITY symbols
- * (to indicate very reliable 0 bit), and set to 0 (completely unknown bit) all
- * missing symbol. Repeated symbols are added.
- * The input memory *output shall be either initialized to all zeros or to the
- * result of previous redundancy versions is available.
+ * Initializes the circular buffer walk of the rate dematcher.
  */
-static void bit_selection_rm_rx(const float*   input,
-                                const uint32_t in_len,
-                                float*         output,
-                                uint32_t*      indices,
-                                const uint32_t ini_exclude,
-                                const uint32_t end_exclude,
-                                const uint32_t k0,
-                                const uint32_t Ncb)
+static void rm_rx_walk_init(rm_rx_walk_t*  w,
+                            const uint32_t ini_exclude,
+                            const uint32_t end_exclude,
+                            const uint32_t k0,
+                            const uint32_t Ncb)
 {
-  uint32_t E = in_len;
-
-  uint32_t k    = 0;
-  uint32_t j    = 0;
-  uint32_t icwd = 0;
-  while (k < E) {
-    icwd = (k0 + j) % Ncb;
-    if (!(icwd >= ini_exclude && icwd < end_exclude)) { // avoid filler bits
-      indices[k] = icwd;
-      k          = k + 1;
-    }
-    j = j + 1;
-  } // while
+  w->Ncb         = Ncb;
+  w->ini_exclude = SRSRAN_MIN(ini_exclude, Ncb);
+  w->nof_filler  = SRSRAN_MIN(end_exclude, Ncb) - w->ini_exclude;
+  w->nof_bits    = Ncb - w->nof_filler;
+
+  // The first selected position is k0 or, if k0 is a filler bit, the first position after the filler bits
+  uint32_t start = k0 % Ncb;
+  if (start >= w->ini_exclude && start < w->ini_exclude + w->nof_filler) {
+    start = w->ini_exclude;
+  } else if (start > w->ini_exclude) {
+    start = start - w->nof_filler;
+  }
+  w->rank_k0 = start % w->nof_bits;
+}
 
-  // set filler bits to INFINITY
-  for (uint32_t i = ini_exclude; i < end_exclude; i++) {
-    output[i] = INFINITY;
+/*!
+ * Gets the run of consecutive circular buffer positions of the soft bits k to k + max_len - 1.
+ * \return The length of the run, the position of its first soft bit is written in pos.
+ */
+static uint32_t rm_rx_walk_run(const rm_rx_walk_t* w, const uint32_t k, const uint32_t max_len, uint32_t* pos)
+{
+  uint32_t rank = (w->rank_k0 + k) % w->nof_bits;
+  uint32_t end  = w->Ncb;
+  if (rank < w->ini_exclude) {
+    *pos = rank;
+    end  = w->ini_exclude;
+  } else {
+    *pos = rank + w->nof_filler;
   }
+  return SRSRAN_MIN(end - *pos, max_len);
+}
 
-  // Add soft bits, in case of repetition
-  for (uint32_t i = 0; i < E; i++) {
-    output[indices[i]] = output[indices[i]] + input[i];
-  }
+/*!
+ * Soft combining of the rate-dematched soft bits (float).
+ */
+static void combine_rm_rx(float* output, const float* input, const uint32_t len)
+{
+  srsran_vec_sum_fff(output, input, output, len);
 }
 
 /*!
- * Undoes bit selection for the rate-dematching block.
- * The output has the codeword length N. It inserts filler bits as INFINITY symbols
- * (to indicate very reliable 0 bit), and set to 0 (completely unknown bit) all
- * missing symbol. Repeated symbols are added.
- * The input memory *output shall be either initialized to all zeros or to the
- * result of previous redundancy versions is available.
+ * Soft combining of the rate-dematched soft bits (short). The result is saturated to the 15-bit
+ * quantization of the messages.
  */
-static void bit_selection_rm_rx_s(const int16_t* input,
-                                  const uint32_t in_len,
-                                  int16_t*       output,
-                                  uint32_t*      indices,
-                                  const uint32_t ini_exclude,
-                                  const uint32_t end_exclude,
-                                  const uint32_t k0,
-                                  const uint32_t Ncb)
+static void combine_rm_rx_s(int16_t* output, const int16_t* input, const uint32_t len)
 {
-  uint32_t E = in_len;
+  const int16_t infinity15 =
+      (1U << 14U) - 1; // Messages use a 15-bit quantization. Soft bits use the remaining bit to denote infinity.
+  uint32_t i = 0;
 
-  uint32_t k    = 0;
-  uint32_t j    = 0;
-  uint32_t icwd = 0;
-  while (k < E) {
-    icwd = (k0 + j) % Ncb;
-    if (!(icwd >= ini_exclude && icwd < end_exclude)) { // avoid filler bits
-      indices[k] = icwd;
-      k          = k + 1;
-    }
-    j = j + 1;
-  } // while
+#ifdef LV_HAVE_AVX512
+  const __m512i max512 = _mm512_set1_epi16(infinity15);
+  const __m512i min512 = _mm512_set1_epi16(-infinity15);
+  for (; i + 32 <= len; i += 32) {
+    __m512i sum = _mm512_adds_epi16(_mm512_loadu_si512(&output[i]), _mm512_loadu_si512(&input[i]));
+    _mm512_storeu_si512(&output[i], _mm512_max_epi16(_mm512_min_epi16(sum, max512), min512));
+  }
+#endif // LV_HAVE_AVX512
 
-  // set filler bits to INFINITY
-  const long infinity16 = (1U << 15U) - 1; // Max positive value in 16-bit representation
-  for (uint32_t i = ini_exclude; i < end_exclude; i++) {
-    output[i] = infinity16;
+#ifdef LV_HAVE_AVX2
+  const __m256i max256 = _mm256_set1_epi16(infinity15);
+  const __m256i min256 = _mm256_set1_epi16(-infinity15);
+  for (; i + 16 <= len; i += 16) {
+    __m256i sum = _mm256_adds_epi16(_mm256_loadu_si256((__m256i*)&output[i]), _mm256_loadu_si256((__m256i*)&input[i]));
+    _mm256_storeu_si256((__m256i*)&output[i], _mm256_max_epi16(_mm256_min_epi16(sum, max256), min256));
   }
+#endif // LV_HAVE_AVX2
 
-  // Add soft bits, in case of repetition
-  const int16_t infinity15 =
-      (1U << 14U) - 1; // Messages use a 15-bit quantization. Soft bits use the remaining bit to denote infinity.
-  // input is assume to be quantized from -infinity15 to infinity15. Only filler bits can be infinity16
   long tmp = 0;
-  for (uint32_t i = 0; i < E; i++) {
-    tmp = (long)output[indices[i]] + input[i];
+  for (; i < len; i++) {
+    tmp = (long)output[i] + input[i];
     if (tmp > infinity15) {
       tmp = infinity15;
     }
     if (tmp < -infinity15) {
       tmp = -infinity15;
     }
-    output[indices[i]] = (int16_t)tmp;
+    output[i] = (int16_t)tmp;
   }
 }
 
 /*!
- * Undoes bit selection for the rate-dematching block (int8_t).
- * The output has the codeword length N. It inserts filler bits as INFINITY symbols
- * (to indicate very reliable 0 bit), and set to 0 (completely unknown bit) all
- * missing symbol. Repeated symbols are added.
- * The input memory *output shall be either initialized to all zeros or to the
- * result of previous redundancy versions is available.
+ * Soft combining of the rate-dematched soft bits (int8_t). The result is saturated to the 7-bit
+ * quantization of the messages.
  */
-static void bit_selection_rm_rx_c(const int8_t*  input,
-                                  const uint32_t in_len,
-                                  int8_t*        output,
-                                  uint32_t*      indices,
-                                  const uint32_t ini_exclude,
-                                  const uint32_t end_exclude,
-                                  const uint32_t k0,
-                                  const uint32_t Ncb)
+static void combine_rm_rx_c(int8_t* output, const int8_t* input, const uint32_t len)
 {
-  uint32_t E = in_len;
+  const int8_t infinity7 =
+      (1U << 6U) - 1; // Messages use a 7-bit quantization. Soft bits use the remaining bit to denote infinity.
+  uint32_t i = 0;
 
-  uint32_t k    = 0;
-  uint32_t j    = 0;
-  uint32_t icwd = 0;
-  while (k < E) {
-    icwd = (k0 + j) % Ncb;
-    if (!(icwd >= ini_exclude && icwd < end_exclude)) { // avoid filler bits
-      indices[k] = icwd;
-      k          = k + 1;
-    }
-    j = j + 1;
-  } // while
+#ifdef LV_HAVE_AVX512
+  const __m512i max512 = _mm512_set1_epi8(infinity7);
+  const __m512i min512 = _mm512_set1_epi8(-infinity7);
+  for (; i + 64 <= len; i += 64) {
+    __m512i sum = _mm512_adds_epi8(_mm512_loadu_si512(&output[i]), _mm512_loadu_si512(&input[i]));
+    _mm512_storeu_si512(&output[i], _mm512_max_epi8(_mm512_min_epi8(sum, max512), min512));
+  }
+#endif // LV_HAVE_AVX512
 
-  // set filler bits to INFINITY
-  const long infinity8 = (1U << 7U) - 1; // Max positive value in 8-bit representation
-  for (uint32_t i = ini_exclude; i < end_exclude; i++) {
-    output[i] = infinity8;
+#ifdef LV_HAVE_AVX2
+  const __m256i max256 = _mm256_set1_epi8(infinity7);
+  const __m256i min256 = _mm256_set1_epi8(-infinity7);
+  for (; i + 32 <= len; i += 32) {
+    __m256i sum = _mm256_adds_epi8(_mm256_loadu_si256((__m256i*)&output[i]), _mm256_loadu_si256((__m256i*)&input[i]));
+    _mm256_storeu_si256((__m256i*)&output[i], _mm256_max_epi8(_mm256_min_epi8(sum, max256), min256));
   }
+#endif // LV_HAVE_AVX2
 
-  // Add soft bits, in case of repetition
-  const int16_t infinity7 =
-      (1U << 6U) - 1; // Messages use a 15-bit quantization. Soft bits use the remaining bit to denote infinity.
-  // input is assume to be quantized from -infinity15 to infinity15. Only filler bits can be infinity16
   long tmp = 0;
-  for (uint32_t i = 0; i < E; i++) {
-    tmp = (long)output[indices[i]] + input[i];
+  for (; i < len; i++) {
+    tmp = (long)output[i] + input[i];
     if (tmp > infinity7) {
       tmp = infinity7;
     }
     if (tmp < -infinity7) {
       tmp = -infinity7;
     }
-    output[indices[i]] = (int8_t)tmp;
+    output[i] = (int8_t)tmp;
   }
 }
 
+/*!
+ * Undoes bit selection for the rate-dematching block.
+ * Combines the soft bits k to k + in_len - 1 of the bit selection output with the
+ * circular buffer in *output. Repeated symbols are added.
+ */
+#define BIT_SELECTION_RM_RX(COMBINE)                                                                                  \
+  do {                                                                                                                 \
+    for (uint32_t i = 0; i < in_len;) {                                                                                \
+      uint32_t pos = 0;                                                                                                \
+      uint32_t len = rm_rx_walk_run(w, k + i, in_len - i, &pos);                                                      \
+      COMBINE(&output[pos], &input[i], len);                                                                          \
+      i += len;                                                                                                        \
+    }                                                                                                                  \
+  } while (false)
+
+static void
+bit_selection_rm_rx(const rm_rx_walk_t* w, const float* input, const uint32_t k, const uint32_t in_len, float* output)
+{
+  BIT_SELECTION_RM_RX(combine_rm_rx);
+}
+
+static void bit_selection_rm_rx_s(const rm_rx_walk_t* w,
+                                  const int16_t*      input,
+                                  const uint32_t      k,
+                                  const uint32_t      in_len,
+                                  int16_t*            output)
+{
+  BIT_SELECTION_RM_RX(combine_rm_rx_s);
+}
+
+static void bit_selection_rm_rx_c(const rm_rx_walk_t* w,
+                                  const int8_t*       input,
+                                  const uint32_t      k,
+                                  const uint32_t      in_len,
+                                  int8_t*             output)
+{
+  BIT_SELECTION_RM_RX(combine_rm_rx_c);
+}
+
 /*!
  * Bit interleaver
  */
@@ -360,56 +417,204 @@ bit_interleaver_rm_tx(const uint8_t* input, uint8_t* output, const uint32_t in_o
 }
 
 /*!
- * Bit deinterleaver (float)
+ * Bit deinterleaver (float). Deinterleaves the columns j0 to j0 + nof_cols - 1 into
+ * mod_order rows of RM_RX_BLOCK_LEN soft bits.
  */
-static void
-bit_interleaver_rm_rx(const float* input, float* output, const uint32_t in_out_len, const uint32_t mod_order)
+static void bit_interleaver_rm_rx(const float*   input,
+                                  float*         output,
+                                  const uint32_t j0,
+                                  const uint32_t nof_cols,
+                                  const uint32_t mod_order)
 {
-  uint32_t cols = 0;
-  uint32_t rows = 0;
-  rows          = mod_order;
-  cols          = in_out_len / rows;
-  for (uint32_t j = 0; j < cols; j++) {
-    for (uint32_t i = 0; i < rows; i++) {
-      output[i * cols + j] = input[j * rows + i];
+  for (uint32_t j = 0; j < nof_cols; j++) {
+    for (uint32_t i = 0; i < mod_order; i++) {
+      output[i * RM_RX_BLOCK_LEN + j] = input[(j0 + j) * mod_order + i];
     }
   }
 }
 
 /*!
- * Bit deinterleaver (short)
+ * Bit deinterleaver (short). Deinterleaves the columns j0 to j0 + nof_cols - 1 into
+ * mod_order rows of RM_RX_BLOCK_LEN soft bits.
  */
-static void
-bit_interleaver_rm_rx_s(const int16_t* input, int16_t* output, const uint32_t in_out_len, const uint32_t mod_order)
+static void bit_interleaver_rm_rx_s(const int16_t* input,
+                                    int16_t*       output,
+                                    const uint32_t j0,
+                                    const uint32_t nof_cols,
+                                    const uint32_t mod_order)
 {
-  uint32_t cols = 0;
-  uint32_t rows = 0;
-  rows          = mod_order;
-  cols          = in_out_len / rows;
-  for (uint32_t j = 0; j < cols; j++) {
-    for (uint32_t i = 0; i < rows; i++) {
-      output[i * cols + j] = input[j * rows + i];
+  for (uint32_t j = 0; j < nof_cols; j++) {
+    for (uint32_t i = 0; i < mod_order; i++) {
+      output[i * RM_RX_BLOCK_LEN + j] = input[(j0 + j) * mod_order + i];
     }
   }
 }
 
+#ifdef LV_HAVE_AVX2
 /*!
- * Bit deinterleaver (short)
+ * Deinterleaves 32 columns of 2 soft bits (int8_t).
  */
-static void
-bit_interleaver_rm_rx_c(const int8_t* input, int8_t* output, const uint32_t in_out_len, const uint32_t mod_order)
+static inline void bit_interleaver_rm_rx_c_avx2_qm2(const int8_t* input, int8_t* output)
 {
-  uint32_t cols = 0;
-  uint32_t rows = 0;
-  rows          = mod_order;
-  cols          = in_out_len / rows;
-  for (uint32_t j = 0; j < cols; j++) {
-    for (uint32_t i = 0; i < rows; i++) {
-      output[i * cols + j] = input[j * rows + i];
+  const __m256i shuffle = _mm256_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15,
+                                           0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+
+  // Group the soft bits of each row within the 128-bit lanes, then within the registers
+  __m256i v0 = _mm256_shuffle_epi8(_mm256_loadu_si256((__m256i*)&input[0]), shuffle);
+  __m256i v1 = _mm256_shuffle_epi8(_mm256_loadu_si256((__m256i*)&input[32]), shuffle);
+  v0         = _mm256_permute4x64_epi64(v0, 0xd8);
+  v1         = _mm256_permute4x64_epi64(v1, 0xd8);
+
+  _mm256_storeu_si256((__m256i*)&output[0], _mm256_permute2x128_si256(v0, v1, 0x20));
+  _mm256_storeu_si256((__m256i*)&output[RM_RX_BLOCK_LEN], _mm256_permute2x128_si256(v0, v1, 0x31));
+}
+
+/*!
+ * Deinterleaves 32 columns of 4 soft bits (int8_t).
+ */
+static inline void bit_interleaver_rm_rx_c_avx2_qm4(const int8_t* input, int8_t* output)
+{
+  const __m256i shuffle = _mm256_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15,
+                                           0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+  const __m256i permute = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+  // Every 64-bit word holds 8 columns of a row
+  __m256i v[4];
+  for (uint32_t m = 0; m < 4; m++) {
+    v[m] = _mm256_shuffle_epi8(_mm256_loadu_si256((__m256i*)&input[32 * m]), shuffle);
+    v[m] = _mm256_permutevar8x32_epi32(v[m], permute);
+  }
+
+  // Transpose the 64-bit words
+  __m256i t0 = _mm256_unpacklo_epi64(v[0], v[1]);
+  __m256i t1 = _mm256_unpackhi_epi64(v[0], v[1]);
+  __m256i t2 = _mm256_unpacklo_epi64(v[2], v[3]);
+  __m256i t3 = _mm256_unpackhi_epi64(v[2], v[3]);
+
+  _mm256_storeu_si256((__m256i*)&output[0], _mm256_permute2x128_si256(t0, t2, 0x20));
+  _mm256_storeu_si256((__m256i*)&output[RM_RX_BLOCK_LEN], _mm256_permute2x128_si256(t1, t3, 0x20));
+  _mm256_storeu_si256((__m256i*)&output[2 * RM_RX_BLOCK_LEN], _mm256_permute2x128_si256(t0, t2, 0x31));
+  _mm256_storeu_si256((__m256i*)&output[3 * RM_RX_BLOCK_LEN], _mm256_permute2x128_si256(t1, t3, 0x31));
+}
+
+/*!
+ * Deinterleaves 32 columns of 8 soft bits (int8_t).
+ */
+static inline void bit_interleaver_rm_rx_c_avx2_qm8(const int8_t* input, int8_t* output)
+{
+  const __m256i shuffle = _mm256_setr_epi8(0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15,
+                                           0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15);
+
+  // Every 16-bit word holds 2 columns of a row. Arrange the registers so the low lanes hold the columns 0 to 15 and
+  // the high lanes the columns 16 to 31
+  __m256i v[8];
+  __m256i w[8];
+  for (uint32_t m = 0; m < 8; m++) {
+    v[m] = _mm256_shuffle_epi8(_mm256_loadu_si256((__m256i*)&input[32 * m]), shuffle);
+  }
+  for (uint32_t m = 0; m < 4; m++) {
+    w[2 * m]     = _mm256_permute2x128_si256(v[m], v[m + 4], 0x20);
+    w[2 * m + 1] = _mm256_permute2x128_si256(v[m], v[m + 4], 0x31);
+  }
+
+  // Transpose the 8x8 16-bit words of each lane
+  __m256i a = _mm256_unpacklo_epi16(w[0], w[1]);
+  __m256i b = _mm256_unpackhi_epi16(w[0], w[1]);
+  __m256i c = _mm256_unpacklo_epi16(w[2], w[3]);
+  __m256i d = _mm256_unpackhi_epi16(w[2], w[3]);
+  __m256i e = _mm256_unpacklo_epi16(w[4], w[5]);
+  __m256i f = _mm256_unpackhi_epi16(w[4], w[5]);
+  __m256i g = _mm256_unpacklo_epi16(w[6], w[7]);
+  __m256i h = _mm256_unpackhi_epi16(w[6], w[7]);
+
+  __m256i r01l = _mm256_unpacklo_epi32(a, c);
+  __m256i r23l = _mm256_unpackhi_epi32(a, c);
+  __m256i r45l = _mm256_unpacklo_epi32(b, d);
+  __m256i r67l = _mm256_unpackhi_epi32(b, d);
+  __m256i r01h = _mm256_unpacklo_epi32(e, g);
+  __m256i r23h = _mm256_unpackhi_epi32(e, g);
+  __m256i r45h = _mm256_unpacklo_epi32(f, h);
+  __m256i r67h = _mm256_unpackhi_epi32(f, h);
+
+  _mm256_storeu_si256((__m256i*)&output[0], _mm256_unpacklo_epi64(r01l, r01h));
+  _mm256_storeu_si256((__m256i*)&output[RM_RX_BLOCK_LEN], _mm256_unpackhi_epi64(r01l, r01h));
+  _mm256_storeu_si256((__m256i*)&output[2 * RM_RX_BLOCK_LEN], _mm256_unpacklo_epi64(r23l, r23h));
+  _mm256_storeu_si256((__m256i*)&output[3 * RM_RX_BLOCK_LEN], _mm256_unpackhi_epi64(r23l, r23h));
+  _mm256_storeu_si256((__m256i*)&output[4 * RM_RX_BLOCK_LEN], _mm256_unpacklo_epi64(r45l, r45h));
+  _mm256_storeu_si256((__m256i*)&output[5 * RM_RX_BLOCK_LEN], _mm256_unpackhi_epi64(r45l, r45h));
+  _mm256_storeu_si256((__m256i*)&output[6 * RM_RX_BLOCK_LEN], _mm256_unpacklo_epi64(r67l, r67h));
+  _mm256_storeu_si256((__m256i*)&output[7 * RM_RX_BLOCK_LEN], _mm256_unpackhi_epi64(r67l, r67h));
+}
+#endif // LV_HAVE_AVX2
+
+/*!
+ * Bit deinterleaver (int8_t). Deinterleaves the columns j0 to j0 + nof_cols - 1 into
+ * mod_order rows of RM_RX_BLOCK_LEN soft bits.
+ */
+static void bit_interleaver_rm_rx_c(const int8_t*  input,
+                                    int8_t*        output,
+                                    const uint32_t j0,
+                                    const uint32_t nof_cols,
+                                    const uint32_t mod_order)
+{
+  uint32_t j = 0;
+
+#ifdef LV_HAVE_AVX2
+  for (; j + 32 <= nof_cols; j += 32) {
+    const int8_t* in_ptr = &input[(j0 + j) * mod_order];
+    if (mod_order == 2) {
+      bit_interleaver_rm_rx_c_avx2_qm2(in_ptr, &output[j]);
+    } else if (mod_order == 4) {
+      bit_interleaver_rm_rx_c_avx2_qm4(in_ptr, &output[j]);
+    } else if (mod_order == 8) {
+      bit_interleaver_rm_rx_c_avx2_qm8(in_ptr, &output[j]);
+    } else {
+      break;
+    }
+  }
+#endif // LV_HAVE_AVX2
+
+  for (; j < nof_cols; j++) {
+    for (uint32_t i = 0; i < mod_order; i++) {
+      output[i * RM_RX_BLOCK_LEN + j] = input[(j0 + j) * mod_order + i];
     }
   }
 }
 
+/*!
+ * Rate dematching: deinterleaves the input by blocks of columns and combines every row of
+ * the block with the circular buffer, so the input is read once and the temporal buffer
+ * stays small. If soft bits are repeated, the saturated combining depends on the order, so
+ * they are combined in order, one row after the other.
+ */
+#define RATE_DEMATCHING(INTERLEAVER, BIT_SELECTION)                                                                   \
+  do {                                                                                                                 \
+    rm_rx_walk_t walk = {};                                                                                            \
+    rm_rx_walk_init(&walk, ini_exclude, end_exclude, q->k0, q->Ncb);                                                   \
+    uint32_t cols = q->E / q->mod_order;                                                                               \
+    if (q->mod_order == 1) { /* interleaver can be skipped */                                                          \
+      BIT_SELECTION(&walk, input, 0, q->E, output);                                                                    \
+    } else if (q->E <= walk.nof_bits) {                                                                                \
+      for (uint32_t j0 = 0; j0 < cols; j0 += RM_RX_BLOCK_LEN) {                                                        \
+        uint32_t nof_cols = SRSRAN_MIN(RM_RX_BLOCK_LEN, cols - j0);                                                    \
+        INTERLEAVER(input, tmp_rm_symbol, j0, nof_cols, q->mod_order);                                                 \
+        for (uint32_t i = 0; i < q->mod_order; i++) {                                                                  \
+          BIT_SELECTION(&walk, &tmp_rm_symbol[i * RM_RX_BLOCK_LEN], i * cols + j0, nof_cols, output);                  \
+        }                                                                                                              \
+      }                                                                                                                \
+    } else {                                                                                                           \
+      for (uint32_t i = 0; i < q->mod_order; i++) {                                                                    \
+        for (uint32_t j0 = 0; j0 < cols; j0 += RM_RX_BLOCK_LEN) {                                                      \
+          uint32_t nof_cols = SRSRAN_MIN(RM_RX_BLOCK_LEN, cols - j0);                                                  \
+          for (uint32_t j = 0; j < nof_cols; j++) {                                                                    \
+            tmp_rm_symbol[j] = input[(j0 + j) * q->mod_order + i];                                                     \
+          }                                                                                                            \
+          BIT_SELECTION(&walk, tmp_rm_symbol, i * cols + j0, nof_cols, output);                                        \
+        }                                                                                                              \
+      }                                                                                                                \
+    }                                                                                                                  \
+  } while (false)
+
 int srsran_ldpc_rm_tx_init(srsran_ldpc_rm_t* p)
 {
   if (p == NULL) {
@@ -448,13 +653,7 @@ int srsran_ldpc_rm_rx_init_f(srsran_ldpc_rm_t* p)
   p->ptr = pp;
 
   // allocate memory to the temporal buffer
-  if ((pp->tmp_rm_symbol = srsran_vec_f_malloc(MAXE)) == NULL) {
-    free(pp);
-    return -1;
-  }
-
-  if ((pp->indices = srsran_vec_u32_malloc(MAXE)) == NULL) {
-    free(pp->tmp_rm_symbol);
+  if ((pp->tmp_rm_symbol = srsran_vec_f_malloc(RM_RX_TMP_LEN)) == NULL) {
     free(pp);
     return -1;
   }
@@ -476,13 +675,7 @@ int srsran_ldpc_rm_rx_init_s(srsran_ldpc_rm_t* p)
   p->ptr = pp;
 
   // allocate memory to the temporal buffer
-  if ((pp->tmp_rm_symbol = srsran_vec_i16_malloc(MAXE)) == NULL) {
-    free(pp);
-    return -1;
-  }
-
-  if ((pp->indices = srsran_vec_u32_malloc(MAXE)) == NULL) {
-    free(pp->tmp_rm_symbol);
+  if ((pp->tmp_rm_symbol = srsran_vec_i16_malloc(RM_RX_TMP_LEN)) == NULL) {
     free(pp);
     return -1;
   }
@@ -504,13 +697,7 @@ int srsran_ldpc_rm_rx_init_c(srsran_ldpc_rm_t* p)
   p->ptr = pp;
 
   // allocate memory to the temporal buffer
-  if ((pp->tmp_rm_symbol = srsran_vec_i8_malloc(MAXE)) == NULL) {
-    free(pp);
-    return -1;
-  }
-
-  if ((pp->indices = srsran_vec_u32_malloc(MAXE)) == NULL) {
-    free(pp->tmp_rm_symbol);
+  if ((pp->tmp_rm_symbol = srsran_vec_i8_malloc(RM_RX_TMP_LEN)) == NULL) {
     free(pp);
     return -1;
   }
@@ -539,9 +726,6 @@ void srsran_ldpc_rm_rx_free_f(srsran_ldpc_rm_t* q)
       if (qq->tmp_rm_symbol != NULL) {
         free(qq->tmp_rm_symbol);
       }
-      if (qq->indices != NULL) {
-        free(qq->indices);
-      }
       free(qq);
     }
   }
@@ -555,9 +739,6 @@ void srsran_ldpc_rm_rx_free_s(srsran_ldpc_rm_t* q)
       if (qq->tmp_rm_symbol != NULL) {
         free(qq->tmp_rm_symbol);
       }
-      if (qq->indices != NULL) {
-        free(qq->indices);
-      }
       free(qq);
     }
   }
@@ -571,9 +752,6 @@ void srsran_ldpc_rm_rx_free_c(srsran_ldpc_rm_t* q)
       if (qq->tmp_rm_symbol != NULL) {
         free(qq->tmp_rm_symbol);
       }
-      if (qq->indices != NULL) {
-        free(qq->indices);
-      }
       free(qq);
     }
   }
@@ -627,16 +805,15 @@ int srsran_ldpc_rm_rx_f(srsran_ldpc_rm_t*        q,
 
   struct pRM_rx_f* pp            = q->ptr;
   float*           tmp_rm_symbol = pp->tmp_rm_symbol;
-  uint32_t*        indices       = pp->indices;
   uint32_t         end_exclude   = q->K - 2 * q->ls;
   uint32_t         ini_exclude   = end_exclude - q->F;
 
-  if (q->mod_order == 1) { // interleaver can be skipped
-    bit_selection_rm_rx(input, q->E, output, indices, ini_exclude, end_exclude, q->k0, q->Ncb);
-  } else {
-    bit_interleaver_rm_rx(input, tmp_rm_symbol, q->E, q->mod_order);
-    bit_selection_rm_rx(tmp_rm_symbol, q->E, output, indices, ini_exclude, end_exclude, q->k0, q->Ncb);
+  // set filler bits to INFINITY
+  for (uint32_t i = ini_exclude; i < end_exclude; i++) {
+    output[i] = INFINITY;
   }
+
+  RATE_DEMATCHING(bit_interleaver_rm_rx, bit_selection_rm_rx);
   return 0;
 }
 
@@ -656,19 +833,19 @@ int srsran_ldpc_rm_rx_s(srsran_ldpc_rm_t*        q,
     exit(-1);
   }
 
-  struct pRM_rx_f* pp            = q->ptr;
-  int16_t*         tmp_rm_symbol = (int16_t*)pp->tmp_rm_symbol;
-  uint32_t*        indices       = pp->indices;
+  struct pRM_rx_s* pp            = q->ptr;
+  int16_t*         tmp_rm_symbol = pp->tmp_rm_symbol;
   uint32_t         end_exclude   = q->K - 2 * q->ls;
   uint32_t         ini_exclude   = end_exclude - q->F;
 
-  if (q->mod_order == 1) { // interleaver can be skipped
-    bit_selection_rm_rx_s(input, q->E, output, indices, ini_exclude, end_exclude, q->k0, q->Ncb);
-  } else {
-    bit_interleaver_rm_rx_s(input, tmp_rm_symbol, q->E, q->mod_order);
-    bit_selection_rm_rx_s(tmp_rm_symbol, q->E, output, indices, ini_exclude, end_exclude, q->k0, q->Ncb);
+  // set filler bits to INFINITY
+  const long infinity16 = (1U << 15U) - 1; // Max positive value in 16-bit representation
+  for (uint32_t i = ini_exclude; i < end_exclude; i++) {
+    output[i] = infinity16;
   }
 
+  RATE_DEMATCHING(bit_interleaver_rm_rx_s, bit_selection_rm_rx_s);
+
   return 0;
 }
 
@@ -690,17 +867,17 @@ int srsran_ldpc_rm_rx_c(srsran_ldpc_rm_t*        q,
 
   struct pRM_rx_c* pp            = q->ptr;
   int8_t*          tmp_rm_symbol = pp->tmp_rm_symbol;
-  uint32_t*        indices       = pp->indices;
   uint32_t         end_exclude   = q->K - 2 * q->ls;
   uint32_t         ini_exclude   = end_exclude - q->F;
 
-  if (q->mod_order == 1) { // interleaver can be skipped
-    bit_selection_rm_rx_c(input, q->E, output, indices, ini_exclude, end_exclude, q->k0, q->Ncb);
-  } else {
-    bit_interleaver_rm_rx_c(input, tmp_rm_symbol, q->E, q->mod_order);
-    bit_selection_rm_rx_c(tmp_rm_symbol, q->E, output, indices, ini_exclude, end_exclude, q->k0, q->Ncb);
+  // set filler bits to INFINITY
+  const long infinity8 = (1U << 7U) - 1; // Max positive value in 8-bit representation
+  for (uint32_t i = ini_exclude; i < end_exclude; i++) {
+    output[i] = infinity8;
   }
 
+  RATE_DEMATCHING(bit_interleaver_rm_rx_c, bit_selection_rm_rx_c);
+
   // Return the number of useful LLR
   return (int)SRSRAN_MIN(q->k0 + q->E, q->Ncb);
 }
@@ -26,7 +26,9 @@
  * A batch of example messages is randomly generated, encoded, rate-matched, 2-PAM modulated,
  * and, finally, rate-dematched and decoded by all three types of
  * rate dematchers (float, int16_t, int8_t).
- * The rate-dematched codeword is compared against the transmitted codeword
+ * The rate-dematched codeword is compared against the transmitted codeword, and the
+ * int16_t and int8_t rate dematchers are compared against a scalar reference implementation
+ * while combining random soft bits with a non-empty soft buffer.
  *
  * Synopsis: **ldpc_rm_test [options]**
  *
@@ -38,12 +40,14 @@
  *  - **-r \<number\>** Redundancy version {0-3}.
  *  - **-m \<number\>** Modulation type BPSK = 0, QPSK =1, QAM16 = 2, QAM64 = 3, QAM256 = 4.
  *  - **-M \<number\>** Limited buffer size.
+ *  - **-t \<number\>** Number of rate dematching runs of the throughput test (Default 0, no throughput test).
  */
 
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/time.h>
 #include <unistd.h>
 
 #include "srsran/phy/fec/ldpc/ldpc_common.h"
@@ -61,6 +65,7 @@ static uint32_t           E          = 0;   /*!< \brief Rate-matched codeword si
 static uint8_t            rv         = 0;   /*!< \brief Redundancy version {0-3}. */
 static srsran_mod_t       mod_type = SRSRAN_MOD_QPSK; /*!< \brief Modulation type: BPSK, QPSK, QAM16, QAM64, QAM256. */
 static uint32_t           Nref     = 0;               /*!< \brief Limited buffer size.*/
+static uint32_t           nof_runs = 0; /*!< \brief Number of rate dematching runs of the throughput test. */
 
 static uint32_t N = 0; /*!< \brief Codeblock size (including punctured and filler bits). */
 static uint32_t K = 0; /*!< \brief Codeword size. */
@@ -78,6 +83,7 @@ void usage(char* prog)
   printf("\t-r Redundancy version (rv) [Default %d]\n", rv);
   printf("\t-m Modulation_type BPSK=0, QPSK=1, 16QAM=2, 64QAM=3, 256QAM = 4 [Default %d]\n", mod_type);
   printf("\t-M Limited buffer size (Nref) [Default = %d (normal buffer Nref = N)]\n", Nref);
+  printf("\t-t Number of rate dematching runs of the throughput test [Default %d]\n", nof_runs);
 }
 
 /*!
@@ -86,7 +92,7 @@ void usage(char* prog)
 void parse_args(int argc, char** argv)
 {
   int opt = 0;
-  while ((opt = getopt(argc, argv, "b:l:e:f:r:m:M:")) != -1) {
+  while ((opt = getopt(argc, argv, "b:l:e:f:r:m:M:t:")) != -1) {
     switch (opt) {
       case 'b':
         base_graph = (uint32_t)strtol(optarg, NULL, 10) - 1;
@@ -109,6 +115,9 @@ void parse_args(int argc, char** argv)
       case 'M':
         Nref = (uint32_t)strtol(optarg, NULL, 10);
         break;
+      case 't':
+        nof_runs = (uint32_t)strtol(optarg, NULL, 10);
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -116,6 +125,123 @@ void parse_args(int argc, char** argv)
   }
 }
 
+/*!
+ * \brief Reference rate dematcher (int16_t and int8_t), element by element.
+ *
+ * It takes the circular buffer parameters from a rate dematcher that already processed the codeword.
+ */
+#define REFERENCE_RM_RX(TYPE, INFINITY_MAX, INFINITY_MSG)                                                              \
+  do {                                                                                                                 \
+    uint32_t end_exclude = q->K - 2 * q->ls;                                                                           \
+    uint32_t ini_exclude = end_exclude - q->F;                                                                         \
+    uint32_t cols        = q->E / q->mod_order;                                                                        \
+    uint32_t j           = 0;                                                                                          \
+    for (uint32_t i = ini_exclude; i < end_exclude; i++) {                                                             \
+      output[i] = INFINITY_MAX;                                                                                        \
+    }                                                                                                                  \
+    for (uint32_t k = 0; k < q->E; j++) {                                                                              \
+      uint32_t icwd = (q->k0 + j) % q->Ncb;                                                                            \
+      if (icwd >= ini_exclude && icwd < end_exclude) {                                                                 \
+        continue;                                                                                                      \
+      }                                                                                                                \
+      /* Soft bit k of the deinterleaved codeword */                                                                   \
+      long tmp = (long)output[icwd] + input[(k % cols) * q->mod_order + k / cols];                                     \
+      tmp      = SRSRAN_MIN(SRSRAN_MAX(tmp, -(long)(INFINITY_MSG)), (long)(INFINITY_MSG));                             \
+      output[icwd] = (TYPE)tmp;                                                                                        \
+      k++;                                                                                                             \
+    }                                                                                                                  \
+  } while (false)
+
+static void reference_rm_rx_s(const srsran_ldpc_rm_t* q, const int16_t* input, int16_t* output)
+{
+  REFERENCE_RM_RX(int16_t, (1U << 15U) - 1, (1U << 14U) - 1);
+}
+
+static void reference_rm_rx_c(const srsran_ldpc_rm_t* q, const int8_t* input, int8_t* output)
+{
+  REFERENCE_RM_RX(int8_t, (1U << 7U) - 1, (1U << 6U) - 1);
+}
+
+/*!
+ * \brief Compares the rate dematchers against the reference while combining random soft bits.
+ */
+static int test_soft_combining(srsran_random_t  random_gen,
+                               srsran_ldpc_rm_t* rm_rx_s,
+                               srsran_ldpc_rm_t* rm_rx_c,
+                               int16_t*          input_s,
+                               int8_t*           input_c,
+                               int16_t*          softbuffer_s,
+                               int8_t*           softbuffer_c)
+{
+  int16_t* expected_s = srsran_vec_i16_malloc(N);
+  int8_t*  expected_c = srsran_vec_i8_malloc(N);
+  int      ret        = 0;
+
+  // Random soft bits, the int8_t ones also exceed the 7-bit message range
+  for (uint32_t i = 0; i < E; i++) {
+    input_s[i] = (int16_t)srsran_random_uniform_int_dist(random_gen, -20000, 20000);
+    input_c[i] = (int8_t)srsran_random_uniform_int_dist(random_gen, -127, 127);
+  }
+  // Soft buffer from a previous transmission
+  for (uint32_t i = 0; i < N; i++) {
+    softbuffer_s[i] = (int16_t)srsran_random_uniform_int_dist(random_gen, -16383, 16383);
+    softbuffer_c[i] = (int8_t)srsran_random_uniform_int_dist(random_gen, -63, 63);
+  }
+  memcpy(expected_s, softbuffer_s, N * sizeof(int16_t));
+  memcpy(expected_c, softbuffer_c, N * sizeof(int8_t));
+
+  if (srsran_ldpc_rm_rx_s(rm_rx_s, input_s, softbuffer_s, E, F, base_graph, lift_size, rv, mod_type, Nref) ||
+      srsran_ldpc_rm_rx_c(rm_rx_c, input_c, softbuffer_c, E, F, base_graph, lift_size, rv, mod_type, Nref) < 0) {
+    ret = -1;
+    goto clean_exit;
+  }
+  reference_rm_rx_s(rm_rx_s, input_s, expected_s);
+  reference_rm_rx_c(rm_rx_c, input_c, expected_c);
+
+  if (memcmp(expected_s, softbuffer_s, N * sizeof(int16_t)) != 0) {
+    printf("Error in soft combining (int16_t)\n");
+    ret = -4;
+  } else if (memcmp(expected_c, softbuffer_c, N * sizeof(int8_t)) != 0) {
+    printf("Error in soft combining (int8_t)\n");
+    ret = -5;
+  } else {
+    printf(" No errors in soft combining (int16_t and int8_t)\n");
+  }
+
+clean_exit:
+  free(expected_s);
+  free(expected_c);
+  return ret;
+}
+
+/*!
+ * \brief Measures the throughput of the int8_t rate dematcher against the reference.
+ */
+static void test_throughput(srsran_ldpc_rm_t* rm_rx_c, const int8_t* input_c, int8_t* softbuffer_c)
+{
+  struct timeval t[3];
+  uint64_t       elapsed_us[2] = {};
+
+  for (uint32_t n = 0; n < nof_runs; n++) {
+    gettimeofday(&t[1], NULL);
+    srsran_ldpc_rm_rx_c(rm_rx_c, input_c, softbuffer_c, E, F, base_graph, lift_size, rv, mod_type, Nref);
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    elapsed_us[0] += t[0].tv_sec * 1000000UL + t[0].tv_usec;
+
+    gettimeofday(&t[1], NULL);
+    reference_rm_rx_c(rm_rx_c, input_c, softbuffer_c);
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    elapsed_us[1] += t[0].tv_sec * 1000000UL + t[0].tv_usec;
+  }
+
+  double nof_msoft_bits = (double)E * nof_runs / 1e6;
+  printf(" Rate dematching (int8_t): %.1f Msoft bit/s, reference %.1f Msoft bit/s\n",
+         nof_msoft_bits / ((double)SRSRAN_MAX(elapsed_us[0], 1) / 1e6),
+         nof_msoft_bits / ((double)SRSRAN_MAX(elapsed_us[1], 1) / 1e6));
+}
+
 /*!
  * \brief Main test function.
  */
@@ -338,6 +464,15 @@ int main(int argc, char** argv)
 
   } // codeblocks r
 
+  if (error == 0) {
+    error = test_soft_combining(
+        random_gen, &rm_rx_s, &rm_rx_c, rm_symbols_s, rm_symbols_c, unrm_symbols_s, unrm_symbols_c);
+  }
+
+  if (nof_runs > 0) {
+    test_throughput(&rm_rx_c, rm_symbols_c, unrm_symbols_c);
+  }
+
   free(unrm_symbols);
   free(unrm_symbols_s);
   free(unrm_symbols_c);
@@ -37,6 +37,7 @@
 #include <math.h>
 #include <string.h>
 
+#include "polar_decoder_scl_c.h"
 #include "polar_decoder_ssc_c.h"
 #include "polar_decoder_ssc_c_avx2.h"
 #include "polar_decoder_ssc_f.h"
@@ -114,6 +115,36 @@ static int decode_ssc_c_avx2(void*           o,
 }
 #endif // LV_HAVE_AVX2
 
+/*! SCL Polar decoder with int8_t LLR inputs, only the most likely candidate is returned. */
+static int decode_scl_c(void*           o,
+                        const int8_t*   symbols,
+                        uint8_t*        data,
+                        const uint8_t   n,
+                        const uint16_t* frozen_set,
+                        const uint16_t  frozen_set_size)
+{
+  srsran_polar_decoder_t* q = o;
+
+  if (polar_decoder_scl_c(q->ptr, symbols, data, 1, n, frozen_set, frozen_set_size) < 1) {
+    return -1;
+  }
+
+  return 0;
+}
+
+/*! SCL Polar decoder with int8_t LLR inputs, all the candidates are returned. */
+static int decode_list_scl_c(void*           o,
+                             const int8_t*   symbols,
+                             uint8_t*        data,
+                             const uint8_t   n,
+                             const uint16_t* frozen_set,
+                             const uint16_t  frozen_set_size)
+{
+  srsran_polar_decoder_t* q = o;
+
+  return polar_decoder_scl_c(q->ptr, symbols, data, q->list_size, n, frozen_set, frozen_set_size);
+}
+
 /*! Destructor of a (float) SSC polar decoder. */
 static void free_ssc_f(void* o)
 {
@@ -144,6 +175,13 @@ static void free_ssc_c_avx2(void* o)
 }
 #endif
 
+/*! Destructor of a (int8_t) SCL polar decoder. */
+static void free_scl_c(void* o)
+{
+  srsran_polar_decoder_t* q = o;
+  delete_polar_decoder_scl_c(q->ptr);
+}
+
 /*! Initializes a polar decoder structure to use the SSC polar decoder algorithm with float LLR inputs. */
 static int init_ssc_f(srsran_polar_decoder_t* q)
 {
@@ -203,9 +241,34 @@ static int init_ssc_c_avx2(srsran_polar_decoder_t* q)
 }
 #endif
 
+/*! Initializes a polar decoder structure to use the SCL polar decoder algorithm with uint8_t LLR inputs and the given
+ * vector kernels. */
+static int init_scl_c(srsran_polar_decoder_t* q, const polar_scl_kernels_t* kernels)
+{
+  q->decode_c      = decode_scl_c;
+  q->decode_list_c = decode_list_scl_c;
+  q->free          = free_scl_c;
+
+  if ((q->ptr = create_polar_decoder_scl_c(q->nMax, q->list_size, kernels)) == NULL) {
+    ERROR("create_polar_decoder_scl_c failed");
+    return -1;
+  }
+  return 0;
+}
+
 int srsran_polar_decoder_init(srsran_polar_decoder_t* q, srsran_polar_decoder_type_t type, const uint8_t nMax)
 {
-  q->nMax = nMax;
+  return srsran_polar_decoder_init_list(q, type, nMax, SRSRAN_POLAR_DECODER_LIST_SIZE_DEFAULT);
+}
+
+int srsran_polar_decoder_init_list(srsran_polar_decoder_t*     q,
+                                   srsran_polar_decoder_type_t type,
+                                   const uint8_t               nMax,
+                                   const uint8_t               list_size)
+{
+  q->nMax          = nMax;
+  q->list_size     = 1;
+  q->decode_list_c = NULL;
   switch (type) {
     case SRSRAN_POLAR_DECODER_SSC_F:
       return init_ssc_f(q);
@@ -217,6 +280,29 @@ int srsran_polar_decoder_init(srsran_polar_decoder_t* q, srsran_polar_decoder_ty
     case SRSRAN_POLAR_DECODER_SSC_C_AVX2:
       return init_ssc_c_avx2(q);
 #endif
+    case SRSRAN_POLAR_DECODER_SCL_C:
+    case SRSRAN_POLAR_DECODER_SCL_C_AVX2:
+    case SRSRAN_POLAR_DECODER_SCL_C_AVX512:
+      if (list_size == 0 || list_size > SRSRAN_POLAR_DECODER_LIST_SIZE_MAX) {
+        ERROR("Invalid list size %d", list_size);
+        return -1;
+      }
+      q->list_size = list_size;
+#ifdef LV_HAVE_AVX512
+      if (type == SRSRAN_POLAR_DECODER_SCL_C_AVX512) {
+        return init_scl_c(q, &polar_scl_kernels_avx512);
+      }
+#endif // LV_HAVE_AVX512
+#ifdef LV_HAVE_AVX2
+      if (type == SRSRAN_POLAR_DECODER_SCL_C_AVX2) {
+        return init_scl_c(q, &polar_scl_kernels_avx2);
+      }
+#endif // LV_HAVE_AVX2
+      if (type == SRSRAN_POLAR_DECODER_SCL_C) {
+        return init_scl_c(q, &polar_scl_kernels_c);
+      }
+      ERROR("Decoder not implemented");
+      return -1;
     default:
       ERROR("Decoder not implemented");
       return -1;
@@ -273,3 +359,25 @@ int srsran_polar_decoder_decode_c(srsran_polar_decoder_t* q,
 
   return -1;
 }
+
+int srsran_polar_decoder_decode_list_c(srsran_polar_decoder_t* q,
+                                       const int8_t*           llr,
+                                       uint8_t*                data_decoded,
+                                       const uint8_t           n,
+                                       const uint16_t*         frozen_set,
+                                       const uint16_t          frozen_set_size)
+{
+  if (q->nMax < n) {
+    return -1;
+  }
+
+  // SSC decoders give a single candidate
+  if (q->decode_list_c == NULL) {
+    if (q->decode_c(q, llr, data_decoded, n, frozen_set, frozen_set_size) < 0) {
+      return -1;
+    }
+    return 1;
+  }
+
+  return q->decode_list_c(q, llr, data_decoded, n, frozen_set, frozen_set_size);
+}
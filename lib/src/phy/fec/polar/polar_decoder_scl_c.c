@@ -0,0 +1,789 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file polar_decoder_scl_c.c
+ * \brief Definition of the Fast-SSC List (SCL) polar decoder working with 8-bit integer-valued LLRs.
+ *
+ * The decoding tree is traversed following a schedule of operations computed from the frozen set:
+ *  - f and g steps compute the LLRs of the left and right children of a node,
+ *  - combine steps merge the partial sums of both children into the parent ones,
+ *  - specialized leaves (rate-0, rate-1, repetition and single parity check) decide all the bits of a node at once.
+ *
+ * Every path keeps, for each stage, an index to a pool of buffers shared with reference counting. Paths created by a
+ * fork share all their buffers until one of them writes. The path metrics use the min-sum approximation
+ * (A. Balatsoukas-Stimming et al., "LLR-Based Successive Cancellation List Decoding of Polar Codes") and the
+ * specialized nodes only fork on their least reliable bits (S. A. Hashemi et al., "Fast and Flexible Successive-
+ * Cancellation List Decoders for Polar Codes").
+ *
+ */
+
+#include "polar_decoder_scl_c.h"
+#include "srsran/phy/fec/polar/polar_decoder.h"
+#include "srsran/phy/utils/vector.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SCL_L_MAX SRSRAN_POLAR_DECODER_LIST_SIZE_MAX
+#define SCL_N_MAX_LOG 10U                   /*!< \brief Largest supported \f$log_2\f$ of the code size. */
+#define SCL_NOF_STAGES (SCL_N_MAX_LOG + 2U) /*!< \brief LLR stages 0 to n and partial sum stages 1 to n + 1. */
+#define SCL_MIN_STRIDE 64U                  /*!< \brief Buffers are aligned to the largest SIMD register. */
+
+/*!
+ * \brief Operations of the decoding schedule.
+ */
+typedef enum {
+  SCL_OP_F = 0,   /*!< \brief Computes the LLRs of the left child. */
+  SCL_OP_G,       /*!< \brief Computes the LLRs of the right child. */
+  SCL_OP_COMBINE, /*!< \brief Merges the partial sums of both children into the parent. */
+  SCL_OP_RATE_0,  /*!< \brief All bits of the node are frozen. */
+  SCL_OP_RATE_1,  /*!< \brief No bit of the node is frozen. */
+  SCL_OP_REP,     /*!< \brief Only the last bit of the node is not frozen (repetition code). */
+  SCL_OP_SPC,     /*!< \brief Only the first bit of the node is frozen (single parity check code). */
+} scl_op_type_t;
+
+typedef struct {
+  uint8_t  type;  /*!< \brief One of scl_op_type_t. */
+  uint8_t  stage; /*!< \brief Stage of the node, its size is \f$2^{stage}\f$. */
+  uint16_t pos;   /*!< \brief Position of the first bit of the node. */
+} scl_op_t;
+
+typedef struct {
+  uint32_t pm;     /*!< \brief Path metric, the lower the more likely. */
+  uint8_t  path;   /*!< \brief Path the candidate comes from. */
+  uint8_t  choice; /*!< \brief 0 keeps the current decision of the path, 1 takes the alternative. */
+} scl_candidate_t;
+
+/*!
+ * \brief Buffers of one stage, shared by the paths.
+ */
+typedef struct {
+  uint8_t* mem;            /*!< \brief Memory for SCL_L_MAX buffers. */
+  uint32_t stride;         /*!< \brief Distance in bytes between buffers. */
+  uint8_t  ref[SCL_L_MAX]; /*!< \brief Number of paths using each buffer. */
+} scl_pool_t;
+
+/*!
+ * \brief Describes an SCL polar decoder (8-bit version).
+ */
+struct pSCL_c {
+  uint8_t                    nMax; /*!< \brief Maximum \f$log_2\f$ of the code size. */
+  uint8_t                    L;    /*!< \brief List size. */
+  uint8_t                    n;    /*!< \brief \f$log_2\f$ of the code size of the current codeword. */
+  const polar_scl_kernels_t* k;    /*!< \brief Vector kernels. */
+
+  scl_op_t* ops;             /*!< \brief Decoding schedule of the last frozen set. */
+  uint32_t  nof_ops;         /*!< \brief Number of operations in the schedule. */
+  uint8_t   ops_n;           /*!< \brief \f$log_2\f$ of the code size of the schedule, 0 if there is none. */
+  uint16_t* frozen_set;      /*!< \brief Frozen set of the schedule. */
+  uint16_t  frozen_set_size; /*!< \brief Size of the frozen set of the schedule. */
+  uint8_t*  frozen_mask;     /*!< \brief 1 for the frozen positions, used to build the schedule. */
+
+  scl_pool_t      alpha[SCL_NOF_STAGES];                /*!< \brief LLR buffers of stages 0 to n. */
+  scl_pool_t      beta[SCL_NOF_STAGES];                 /*!< \brief Partial sum buffers of stages 1 to n + 1. */
+  uint8_t         alpha_idx[SCL_L_MAX][SCL_NOF_STAGES]; /*!< \brief LLR buffer used by every path and stage. */
+  uint8_t         beta_idx[SCL_L_MAX][SCL_NOF_STAGES];  /*!< \brief Partial sum buffer used by every path and stage. */
+  uint32_t        pm[SCL_L_MAX];                        /*!< \brief Path metrics. */
+  uint8_t         active[SCL_L_MAX];                    /*!< \brief Active paths. */
+  uint8_t         nof_active;                           /*!< \brief Number of active paths. */
+  uint8_t         choice[SCL_L_MAX];                    /*!< \brief Decision taken by every path in the last fork. */
+  uint8_t*        node_bits[SCL_L_MAX];                 /*!< \brief Decisions of every path in the current node. */
+  uint16_t        reliab[SCL_L_MAX][SCL_L_MAX];         /*!< \brief Least reliable bits of the current node. */
+  scl_candidate_t cand[2 * SCL_L_MAX];                  /*!< \brief Fork candidates. */
+};
+
+static void scl_f_c(const int8_t* x, const int8_t* y, int8_t* z, uint16_t len)
+{
+  for (uint16_t i = 0; i < len; i++) {
+    int8_t abs_x = (int8_t)abs(x[i]);
+    int8_t abs_y = (int8_t)abs(y[i]);
+    int8_t m     = abs_x < abs_y ? abs_x : abs_y;
+    z[i]         = ((x[i] ^ y[i]) < 0) ? (int8_t)-m : m;
+  }
+}
+
+static void scl_g_c(const uint8_t* b, const int8_t* x, const int8_t* y, int8_t* z, uint16_t len)
+{
+  for (uint16_t i = 0; i < len; i++) {
+    int16_t tmp = (int16_t)y[i] + (b[i] ? -(int16_t)x[i] : (int16_t)x[i]);
+    z[i]        = (int8_t)(tmp > 127 ? 127 : (tmp < -127 ? -127 : tmp));
+  }
+}
+
+static void scl_xor_c(const uint8_t* x, const uint8_t* y, uint8_t* z, uint16_t len)
+{
+  for (uint16_t i = 0; i < len; i++) {
+    z[i] = x[i] ^ y[i];
+  }
+}
+
+static void scl_hard_bit_c(const int8_t* x, uint8_t* z, uint16_t len)
+{
+  for (uint16_t i = 0; i < len; i++) {
+    z[i] = x[i] < 0;
+  }
+}
+
+static void scl_penalty_c(const int8_t* x, uint16_t len, uint32_t* pen0, uint32_t* pen1)
+{
+  uint32_t p0 = 0;
+  uint32_t p1 = 0;
+  for (uint16_t i = 0; i < len; i++) {
+    if (x[i] < 0) {
+      p0 += (uint32_t)(-x[i]);
+    } else {
+      p1 += (uint32_t)x[i];
+    }
+  }
+  *pen0 = p0;
+  *pen1 = p1;
+}
+
+const polar_scl_kernels_t polar_scl_kernels_c = {
+    .f        = scl_f_c,
+    .g        = scl_g_c,
+    .xor      = scl_xor_c,
+    .hard_bit = scl_hard_bit_c,
+    .penalty  = scl_penalty_c,
+};
+
+static inline uint8_t* scl_buf(const scl_pool_t* pool, uint8_t idx)
+{
+  return pool->mem + (uint32_t)idx * pool->stride;
+}
+
+/*! Takes a free buffer of the pool. There is always one, as paths never hold more buffers than the list size. */
+static uint8_t scl_pool_take(scl_pool_t* pool, uint8_t L)
+{
+  for (uint8_t i = 0; i < L; i++) {
+    if (pool->ref[i] == 0) {
+      pool->ref[i] = 1;
+      return i;
+    }
+  }
+  return 0;
+}
+
+/*! Makes the buffer referenced by idx exclusive before writing it, the first keep_len bytes are preserved. */
+static uint8_t* scl_pool_write(const struct pSCL_c* pp, scl_pool_t* pool, uint8_t* idx, uint32_t keep_len)
+{
+  uint8_t* buf = scl_buf(pool, *idx);
+  if (pool->ref[*idx] > 1) {
+    pool->ref[*idx]--;
+    *idx = scl_pool_take(pool, pp->L);
+    if (keep_len > 0) {
+      memcpy(scl_buf(pool, *idx), buf, keep_len);
+    }
+    buf = scl_buf(pool, *idx);
+  }
+  return buf;
+}
+
+/*! Points idx to the buffer new_idx, already written by another path. */
+static void scl_pool_share(scl_pool_t* pool, uint8_t* idx, uint8_t new_idx)
+{
+  if (*idx != new_idx) {
+    pool->ref[*idx]--;
+    pool->ref[new_idx]++;
+    *idx = new_idx;
+  }
+}
+
+static void scl_path_release(struct pSCL_c* pp, uint8_t l)
+{
+  for (uint8_t s = 0; s <= pp->n; s++) {
+    pp->alpha[s].ref[pp->alpha_idx[l][s]]--;
+  }
+  for (uint8_t s = 1; s <= pp->n + 1; s++) {
+    pp->beta[s].ref[pp->beta_idx[l][s]]--;
+  }
+}
+
+static void scl_path_clone(struct pSCL_c* pp, uint8_t src, uint8_t dst, uint16_t node_size, uint16_t nof_reliab)
+{
+  for (uint8_t s = 0; s <= pp->n; s++) {
+    pp->alpha_idx[dst][s] = pp->alpha_idx[src][s];
+    pp->alpha[s].ref[pp->alpha_idx[dst][s]]++;
+  }
+  for (uint8_t s = 1; s <= pp->n + 1; s++) {
+    pp->beta_idx[dst][s] = pp->beta_idx[src][s];
+    pp->beta[s].ref[pp->beta_idx[dst][s]]++;
+  }
+  memcpy(pp->node_bits[dst], pp->node_bits[src], node_size);
+  memcpy(pp->reliab[dst], pp->reliab[src], nof_reliab * sizeof(uint16_t));
+}
+
+/*!
+ * Keeps the L candidates with the lowest metric. Paths without surviving candidates are released and paths with two
+ * of them are cloned. On return, pp->choice tells every active path which of its decisions it took.
+ */
+static void scl_select(struct pSCL_c* pp, uint32_t nof_cand, uint16_t node_size, uint16_t nof_reliab)
+{
+  scl_candidate_t* cand = pp->cand;
+
+  // Stable insertion sort, the candidates keeping the current decision come first and win ties
+  for (uint32_t i = 1; i < nof_cand; i++) {
+    scl_candidate_t c = cand[i];
+    uint32_t        j = i;
+    for (; j > 0 && cand[j - 1].pm > c.pm; j--) {
+      cand[j] = cand[j - 1];
+    }
+    cand[j] = c;
+  }
+  uint32_t nof_survivors = SRSRAN_MIN(nof_cand, pp->L);
+
+  uint8_t  survive[SCL_L_MAX]      = {};
+  uint32_t pm_choice[SCL_L_MAX][2] = {};
+  for (uint32_t i = 0; i < nof_survivors; i++) {
+    survive[cand[i].path] |= 1U << cand[i].choice;
+    pm_choice[cand[i].path][cand[i].choice] = cand[i].pm;
+  }
+
+  // Release the paths without survivors first, so that their slots can take the clones
+  bool    in_use[SCL_L_MAX] = {};
+  uint8_t nof_active        = 0;
+  for (uint8_t i = 0; i < pp->nof_active; i++) {
+    uint8_t l = pp->active[i];
+    if (survive[l] == 0) {
+      scl_path_release(pp, l);
+    } else {
+      pp->active[nof_active++] = l;
+      in_use[l]                = true;
+    }
+  }
+
+  uint8_t nof_survivor_paths = nof_active;
+  uint8_t free_slot          = 0;
+  for (uint8_t i = 0; i < nof_survivor_paths; i++) {
+    uint8_t l = pp->active[i];
+    if (survive[l] == 3) {
+      while (in_use[free_slot]) {
+        free_slot++;
+      }
+      in_use[free_slot] = true;
+      scl_path_clone(pp, l, free_slot, node_size, nof_reliab);
+      pp->pm[free_slot]        = pm_choice[l][1];
+      pp->choice[free_slot]    = 1;
+      pp->active[nof_active++] = free_slot;
+      pp->pm[l]                = pm_choice[l][0];
+      pp->choice[l]            = 0;
+    } else {
+      uint8_t c     = survive[l] >> 1U;
+      pp->pm[l]     = pm_choice[l][c];
+      pp->choice[l] = c;
+    }
+  }
+  pp->nof_active = nof_active;
+}
+
+/*! Finds the nof_reliab positions with the lowest LLR magnitude, sorted by increasing magnitude. */
+static void scl_least_reliable(const int8_t* llr, uint16_t len, uint16_t* idx, uint16_t nof_reliab)
+{
+  if (nof_reliab == 0) {
+    return;
+  }
+
+  uint16_t count = 0;
+  for (uint16_t i = 0; i < len; i++) {
+    int8_t a = (int8_t)abs(llr[i]);
+    if (count == nof_reliab && a >= abs(llr[idx[count - 1]])) {
+      continue;
+    }
+    uint16_t j = (count < nof_reliab) ? count++ : count - 1;
+    for (; j > 0 && abs(llr[idx[j - 1]]) > a; j--) {
+      idx[j] = idx[j - 1];
+    }
+    idx[j] = i;
+  }
+}
+
+static inline const int8_t* scl_alpha(const struct pSCL_c* pp, uint8_t l, uint8_t s)
+{
+  return (const int8_t*)scl_buf(&pp->alpha[s], pp->alpha_idx[l][s]);
+}
+
+/*! Returns where a leaf or a combine step writes the partial sums of the node (s, pos) for path l. */
+static uint8_t* scl_node_output(struct pSCL_c* pp, uint8_t l, uint8_t s, uint16_t pos)
+{
+  uint16_t size   = 1U << s;
+  uint16_t offset = ((pos >> s) & 1U) ? size : 0;
+  return scl_pool_write(pp, &pp->beta[s + 1], &pp->beta_idx[l][s + 1], offset) + offset;
+}
+
+static void scl_op_f(struct pSCL_c* pp, uint8_t s)
+{
+  uint16_t half = 1U << (s - 1U);
+  uint8_t  in_done[SCL_L_MAX];
+  uint8_t  out_done[SCL_L_MAX];
+  uint8_t  nof_done = 0;
+
+  for (uint8_t i = 0; i < pp->nof_active; i++) {
+    uint8_t l  = pp->active[i];
+    uint8_t in = pp->alpha_idx[l][s];
+
+    // Paths with the same LLRs share the result
+    uint8_t j = 0;
+    while (j < nof_done && in_done[j] != in) {
+      j++;
+    }
+    if (j < nof_done) {
+      scl_pool_share(&pp->alpha[s - 1], &pp->alpha_idx[l][s - 1], out_done[j]);
+      continue;
+    }
+
+    const int8_t* a = scl_alpha(pp, l, s);
+    int8_t*       z = (int8_t*)scl_pool_write(pp, &pp->alpha[s - 1], &pp->alpha_idx[l][s - 1], 0);
+    pp->k->f(a, a + half, z, half);
+
+    in_done[nof_done]    = in;
+    out_done[nof_done++] = pp->alpha_idx[l][s - 1];
+  }
+}
+
+static void scl_op_g(struct pSCL_c* pp, uint8_t s)
+{
+  uint16_t half = 1U << (s - 1U);
+  uint8_t  in_done[SCL_L_MAX][2];
+  uint8_t  out_done[SCL_L_MAX];
+  uint8_t  nof_done = 0;
+
+  for (uint8_t i = 0; i < pp->nof_active; i++) {
+    uint8_t l      = pp->active[i];
+    uint8_t in_llr = pp->alpha_idx[l][s];
+    uint8_t in_bit = pp->beta_idx[l][s];
+
+    // Paths with the same LLRs and left child decisions share the result
+    uint8_t j = 0;
+    while (j < nof_done && (in_done[j][0] != in_llr || in_done[j][1] != in_bit)) {
+      j++;
+    }
+    if (j < nof_done) {
+      scl_pool_share(&pp->alpha[s - 1], &pp->alpha_idx[l][s - 1], out_done[j]);
+      continue;
+    }
+
+    const int8_t*  a = scl_alpha(pp, l, s);
+    const uint8_t* b = scl_buf(&pp->beta[s], in_bit);
+    int8_t*        z = (int8_t*)scl_pool_write(pp, &pp->alpha[s - 1], &pp->alpha_idx[l][s - 1], 0);
+    pp->k->g(b, a, a + half, z, half);
+
+    in_done[nof_done][0] = in_llr;
+    in_done[nof_done][1] = in_bit;
+    out_done[nof_done++] = pp->alpha_idx[l][s - 1];
+  }
+}
+
+static void scl_op_combine(struct pSCL_c* pp, uint8_t s, uint16_t pos)
+{
+  uint16_t half = 1U << (s - 1U);
+
+  for (uint8_t i = 0; i < pp->nof_active; i++) {
+    uint8_t        l   = pp->active[i];
+    uint8_t*       dst = scl_node_output(pp, l, s, pos);
+    const uint8_t* src = scl_buf(&pp->beta[s], pp->beta_idx[l][s]);
+    pp->k->xor(src, src + half, dst, half);
+    memcpy(dst + half, src + half, half);
+  }
+}
+
+static void scl_op_rate_0(struct pSCL_c* pp, uint8_t s, uint16_t pos)
+{
+  uint16_t size = 1U << s;
+
+  for (uint8_t i = 0; i < pp->nof_active; i++) {
+    uint8_t  l    = pp->active[i];
+    uint32_t pen0 = 0;
+    uint32_t pen1 = 0;
+    pp->k->penalty(scl_alpha(pp, l, s), size, &pen0, &pen1);
+    pp->pm[l] += pen0;
+    memset(scl_node_output(pp, l, s, pos), 0, size);
+  }
+}
+
+static void scl_op_rep(struct pSCL_c* pp, uint8_t s, uint16_t pos)
+{
+  uint16_t size     = 1U << s;
+  uint32_t nof_cand = 0;
+
+  for (uint8_t i = 0; i < pp->nof_active; i++) {
+    uint8_t  l    = pp->active[i];
+    uint32_t pen0 = 0;
+    uint32_t pen1 = 0;
+    pp->k->penalty(scl_alpha(pp, l, s), size, &pen0, &pen1);
+
+    // Keep first the most likely decision
+    uint8_t best         = pen1 < pen0;
+    pp->node_bits[l][0]  = best;
+    pp->cand[nof_cand++] = (scl_candidate_t){pp->pm[l] + (best ? pen1 : pen0), l, 0};
+    pp->cand[nof_cand++] = (scl_candidate_t){pp->pm[l] + (best ? pen0 : pen1), l, 1};
+  }
+  scl_select(pp, nof_cand, 1, 0);
+
+  for (uint8_t i = 0; i < pp->nof_active; i++) {
+    uint8_t l = pp->active[i];
+    memset(scl_node_output(pp, l, s, pos), pp->node_bits[l][0] ^ pp->choice[l], size);
+  }
+}
+
+static void scl_op_rate_1(struct pSCL_c* pp, uint8_t s, uint16_t pos)
+{
+  uint16_t size       = 1U << s;
+  uint16_t nof_reliab = SRSRAN_MIN(pp->L - 1U, size);
+
+  for (uint8_t i = 0; i < pp->nof_active; i++) {
+    uint8_t       l = pp->active[i];
+    const int8_t* a = scl_alpha(pp, l, s);
+    pp->k->hard_bit(a, pp->node_bits[l], size);
+    scl_least_reliable(a, size, pp->reliab[l], nof_reliab);
+  }
+
+  // Fork on every one of the least reliable bits
+  for (uint16_t r = 0; r < nof_reliab; r++) {
+    uint32_t nof_cand = 0;
+    for (uint8_t i = 0; i < pp->nof_active; i++) {
+      uint8_t  l           = pp->active[i];
+      uint32_t cost        = (uint32_t)abs(scl_alpha(pp, l, s)[pp->reliab[l][r]]);
+      pp->cand[nof_cand++] = (scl_candidate_t){pp->pm[l], l, 0};
+      pp->cand[nof_cand++] = (scl_candidate_t){pp->pm[l] + cost, l, 1};
+    }
+    scl_select(pp, nof_cand, size, nof_reliab);
+
+    for (uint8_t i = 0; i < pp->nof_active; i++) {
+      uint8_t l = pp->active[i];
+      pp->node_bits[l][pp->reliab[l][r]] ^= pp->choice[l];
+    }
+  }
+
+  for (uint8_t i = 0; i < pp->nof_active; i++) {
+    uint8_t l = pp->active[i];
+    memcpy(scl_node_output(pp, l, s, pos), pp->node_bits[l], size);
+  }
+}
+
+static void scl_op_spc(struct pSCL_c* pp, uint8_t s, uint16_t pos)
+{
+  uint16_t size       = 1U << s;
+  uint16_t nof_reliab = SRSRAN_MIN(pp->L, size);
+
+  // Hard decision, the least reliable bit is flipped if the parity does not hold
+  for (uint8_t i = 0; i < pp->nof_active; i++) {
+    uint8_t       l    = pp->active[i];
+    const int8_t* a    = scl_alpha(pp, l, s);
+    uint8_t*      bits = pp->node_bits[l];
+    pp->k->hard_bit(a, bits, size);
+    scl_least_reliable(a, size, pp->reliab[l], nof_reliab);
+
+    uint8_t parity = 0;
+    for (uint16_t j = 0; j < size; j++) {
+      parity ^= bits[j];
+    }
+    if (parity) {
+      bits[pp->reliab[l][0]] ^= 1U;
+      pp->pm[l] += (uint32_t)abs(a[pp->reliab[l][0]]);
+    }
+  }
+
+  // Fork on flipping every other unreliable bit together with the least reliable one
+  for (uint16_t r = 1; r < nof_reliab; r++) {
+    uint32_t nof_cand = 0;
+    for (uint8_t i = 0; i < pp->nof_active; i++) {
+      uint8_t       l        = pp->active[i];
+      const int8_t* a        = scl_alpha(pp, l, s);
+      uint16_t      i_min    = pp->reliab[l][0];
+      int32_t       cost_min = abs(a[i_min]);
+      if (pp->node_bits[l][i_min] != (a[i_min] < 0)) {
+        cost_min = -cost_min;
+      }
+      uint32_t cost        = (uint32_t)(abs(a[pp->reliab[l][r]]) + cost_min);
+      pp->cand[nof_cand++] = (scl_candidate_t){pp->pm[l], l, 0};
+      pp->cand[nof_cand++] = (scl_candidate_t){pp->pm[l] + cost, l, 1};
+    }
+    scl_select(pp, nof_cand, size, nof_reliab);
+
+    for (uint8_t i = 0; i < pp->nof_active; i++) {
+      uint8_t l = pp->active[i];
+      pp->node_bits[l][pp->reliab[l][r]] ^= pp->choice[l];
+      pp->node_bits[l][pp->reliab[l][0]] ^= pp->choice[l];
+    }
+  }
+
+  for (uint8_t i = 0; i < pp->nof_active; i++) {
+    uint8_t l = pp->active[i];
+    memcpy(scl_node_output(pp, l, s, pos), pp->node_bits[l], size);
+  }
+}
+
+/*! Recovers the message from the codeword, the polar transform is its own inverse. */
+static void scl_transform(const polar_scl_kernels_t* k, const uint8_t* x, uint8_t* u, uint8_t n)
+{
+  uint16_t size = 1U << n;
+  uint16_t half = 1;
+
+  memcpy(u, x, size);
+
+  // Short butterflies are not worth a kernel call
+  for (; half < SCL_MIN_STRIDE / 2 && half < size; half *= 2) {
+    for (uint16_t j = 0; j < size; j += 2 * half) {
+      for (uint16_t i = j; i < j + half; i++) {
+        u[i] ^= u[i + half];
+      }
+    }
+  }
+  for (; half < size; half *= 2) {
+    for (uint16_t j = 0; j < size; j += 2 * half) {
+      k->xor(u + j, u + j + half, u + j, half);
+    }
+  }
+}
+
+static void scl_schedule_node(struct pSCL_c* pp, uint8_t s, uint16_t pos)
+{
+  uint16_t size       = 1U << s;
+  uint16_t nof_frozen = 0;
+  for (uint16_t i = 0; i < size; i++) {
+    nof_frozen += pp->frozen_mask[pos + i];
+  }
+
+  uint8_t type = SCL_OP_F;
+  if (nof_frozen == size) {
+    type = SCL_OP_RATE_0;
+  } else if (nof_frozen == 0) {
+    type = SCL_OP_RATE_1;
+  } else if (nof_frozen == size - 1 && !pp->frozen_mask[pos + size - 1]) {
+    type = SCL_OP_REP;
+  } else if (nof_frozen == 1 && pp->frozen_mask[pos] && size >= 4) {
+    type = SCL_OP_SPC;
+  }
+
+  if (type != SCL_OP_F) {
+    pp->ops[pp->nof_ops++] = (scl_op_t){type, s, pos};
+    return;
+  }
+
+  pp->ops[pp->nof_ops++] = (scl_op_t){SCL_OP_F, s, pos};
+  scl_schedule_node(pp, s - 1, pos);
+  pp->ops[pp->nof_ops++] = (scl_op_t){SCL_OP_G, s, pos};
+  scl_schedule_node(pp, s - 1, pos + size / 2);
+  pp->ops[pp->nof_ops++] = (scl_op_t){SCL_OP_COMBINE, s, pos};
+}
+
+/*! Builds the decoding schedule, unless the one of the previous codeword is still valid. */
+static void scl_schedule(struct pSCL_c* pp, uint8_t n, const uint16_t* frozen_set, uint16_t frozen_set_size)
+{
+  if (pp->ops_n == n && pp->frozen_set_size == frozen_set_size &&
+      memcmp(pp->frozen_set, frozen_set, frozen_set_size * sizeof(uint16_t)) == 0) {
+    return;
+  }
+
+  uint16_t code_size = 1U << n;
+  memset(pp->frozen_mask, 0, code_size);
+  for (uint16_t i = 0; i < frozen_set_size; i++) {
+    pp->frozen_mask[frozen_set[i]] = 1;
+  }
+
+  pp->nof_ops = 0;
+  scl_schedule_node(pp, n, 0);
+
+  memcpy(pp->frozen_set, frozen_set, frozen_set_size * sizeof(uint16_t));
+  pp->frozen_set_size = frozen_set_size;
+  pp->ops_n           = n;
+}
+
+int polar_decoder_scl_c(void*           p,
+                        const int8_t*   llr,
+                        uint8_t*        data_decoded,
+                        uint8_t         max_nof_candidates,
+                        uint8_t         code_size_log,
+                        const uint16_t* frozen_set,
+                        uint16_t        frozen_set_size)
+{
+  struct pSCL_c* pp = p;
+
+  if (p == NULL || llr == NULL || data_decoded == NULL || code_size_log == 0 || code_size_log > pp->nMax) {
+    return -1;
+  }
+
+  uint16_t code_size = 1U << code_size_log;
+  if (frozen_set_size > code_size) {
+    return -1;
+  }
+  scl_schedule(pp, code_size_log, frozen_set, frozen_set_size);
+
+  // A single path holding the first buffer of every stage
+  pp->n = code_size_log;
+  for (uint8_t s = 0; s < SCL_NOF_STAGES; s++) {
+    memset(pp->alpha[s].ref, 0, sizeof(pp->alpha[s].ref));
+    memset(pp->beta[s].ref, 0, sizeof(pp->beta[s].ref));
+    pp->alpha[s].ref[0] = 1;
+    pp->beta[s].ref[0]  = 1;
+    pp->alpha_idx[0][s] = 0;
+    pp->beta_idx[0][s]  = 0;
+  }
+  pp->pm[0]      = 0;
+  pp->active[0]  = 0;
+  pp->nof_active = 1;
+
+  // The root LLRs are saturated to the symmetric range assumed by the kernels
+  int8_t* root = (int8_t*)scl_buf(&pp->alpha[code_size_log], 0);
+  for (uint16_t i = 0; i < code_size; i++) {
+    root[i] = (llr[i] < -127) ? -127 : llr[i];
+  }
+
+  for (uint32_t i = 0; i < pp->nof_ops; i++) {
+    const scl_op_t* op = &pp->ops[i];
+    switch (op->type) {
+      case SCL_OP_F:
+        scl_op_f(pp, op->stage);
+        break;
+      case SCL_OP_G:
+        scl_op_g(pp, op->stage);
+        break;
+      case SCL_OP_COMBINE:
+        scl_op_combine(pp, op->stage, op->pos);
+        break;
+      case SCL_OP_RATE_0:
+        scl_op_rate_0(pp, op->stage, op->pos);
+        break;
+      case SCL_OP_RATE_1:
+        scl_op_rate_1(pp, op->stage, op->pos);
+        break;
+      case SCL_OP_REP:
+        scl_op_rep(pp, op->stage, op->pos);
+        break;
+      case SCL_OP_SPC:
+        scl_op_spc(pp, op->stage, op->pos);
+        break;
+      default:
+        return -1;
+    }
+  }
+
+  // Sort the paths by metric
+  for (uint8_t i = 1; i < pp->nof_active; i++) {
+    uint8_t l = pp->active[i];
+    uint8_t j = i;
+    for (; j > 0 && pp->pm[pp->active[j - 1]] > pp->pm[l]; j--) {
+      pp->active[j] = pp->active[j - 1];
+    }
+    pp->active[j] = l;
+  }
+
+  // The partial sums of the root are the codeword
+  uint8_t nof_candidates = SRSRAN_MIN(pp->nof_active, max_nof_candidates);
+  for (uint8_t i = 0; i < nof_candidates; i++) {
+    const uint8_t* x = scl_buf(&pp->beta[code_size_log + 1], pp->beta_idx[pp->active[i]][code_size_log + 1]);
+    scl_transform(pp->k, x, data_decoded + (uint32_t)i * code_size, code_size_log);
+  }
+
+  return nof_candidates;
+}
+
+void delete_polar_decoder_scl_c(void* p)
+{
+  struct pSCL_c* pp = p;
+
+  if (p == NULL) {
+    return;
+  }
+
+  for (uint8_t s = 0; s < SCL_NOF_STAGES; s++) {
+    if (pp->alpha[s].mem) {
+      free(pp->alpha[s].mem);
+    }
+    if (pp->beta[s].mem) {
+      free(pp->beta[s].mem);
+    }
+  }
+  for (uint8_t l = 0; l < SCL_L_MAX; l++) {
+    if (pp->node_bits[l]) {
+      free(pp->node_bits[l]);
+    }
+  }
+  if (pp->ops) {
+    free(pp->ops);
+  }
+  if (pp->frozen_set) {
+    free(pp->frozen_set);
+  }
+  if (pp->frozen_mask) {
+    free(pp->frozen_mask);
+  }
+  free(pp);
+}
+
+void* create_polar_decoder_scl_c(uint8_t nMax, uint8_t list_size, const polar_scl_kernels_t* kernels)
+{
+  if (nMax > SCL_N_MAX_LOG || list_size == 0 || list_size > SCL_L_MAX || kernels == NULL) {
+    return NULL;
+  }
+
+  struct pSCL_c* pp = SRSRAN_MEM_ALLOC(struct pSCL_c, 1);
+  if (pp == NULL) {
+    return NULL;
+  }
+  SRSRAN_MEM_ZERO(pp, struct pSCL_c, 1);
+
+  pp->nMax = nMax;
+  pp->L    = list_size;
+  pp->k    = kernels;
+
+  uint32_t code_size = 1U << nMax;
+
+  // The tree has at most 2N - 1 nodes and every node takes at most 3 operations
+  pp->ops         = SRSRAN_MEM_ALLOC(scl_op_t, 6 * code_size);
+  pp->frozen_set  = srsran_vec_u16_malloc(code_size);
+  pp->frozen_mask = srsran_vec_u8_malloc(code_size);
+  if (pp->ops == NULL || pp->frozen_set == NULL || pp->frozen_mask == NULL) {
+    delete_polar_decoder_scl_c(pp);
+    return NULL;
+  }
+
+  for (uint8_t s = 0; s <= nMax + 1; s++) {
+    uint32_t stride = SRSRAN_MAX(1U << s, SCL_MIN_STRIDE);
+    if (s <= nMax) {
+      pp->alpha[s].stride = stride;
+      pp->alpha[s].mem    = srsran_vec_u8_malloc(stride * list_size);
+      if (pp->alpha[s].mem == NULL) {
+        delete_polar_decoder_scl_c(pp);
+        return NULL;
+      }
+    }
+    if (s > 0) {
+      pp->beta[s].stride = stride;
+      pp->beta[s].mem    = srsran_vec_u8_malloc(stride * list_size);
+      if (pp->beta[s].mem == NULL) {
+        delete_polar_decoder_scl_c(pp);
+        return NULL;
+      }
+    }
+  }
+
+  for (uint8_t l = 0; l < list_size; l++) {
+    pp->node_bits[l] = srsran_vec_u8_malloc(code_size);
+    if (pp->node_bits[l] == NULL) {
+      delete_polar_decoder_scl_c(pp);
+      return NULL;
+    }
+  }
+
+  return pp;
+}
@@ -0,0 +1,74 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file polar_decoder_scl_c.h
+ * \brief Declaration of the Fast-SSC List (SCL) polar decoder working with 8-bit integer-valued LLRs.
+ *
+ * The decoder keeps up to \ref SRSRAN_POLAR_DECODER_LIST_SIZE_MAX decoding paths. The decoding tree is pruned with
+ * specialized nodes (rate-0, rate-1, repetition and single parity check) whose list decoding only forks on the least
+ * reliable bits. LLR and partial sum buffers are shared between paths and only copied when a path writes them.
+ *
+ */
+
+#ifndef POLAR_DECODER_SCL_C_H
+#define POLAR_DECODER_SCL_C_H
+
+#include "polar_decoder_scl_kernels.h"
+#include <stdint.h>
+
+/*!
+ * Creates an SCL polar decoder and allocates memory for the decoding buffers.
+ * \param[in] nMax \f$log_2\f$ of the maximum number of bits in the codeword.
+ * \param[in] list_size Number of paths, from 1 to \ref SRSRAN_POLAR_DECODER_LIST_SIZE_MAX.
+ * \param[in] kernels Vector kernels used by the decoder.
+ * \return A pointer to the decoder if the function executes correctly, NULL otherwise.
+ */
+void* create_polar_decoder_scl_c(uint8_t nMax, uint8_t list_size, const polar_scl_kernels_t* kernels);
+
+/*!
+ * The SCL polar decoder "destructor": it frees all the resources allocated to the decoder.
+ * \param[in, out] p A pointer to the dismantled decoder.
+ */
+void delete_polar_decoder_scl_c(void* p);
+
+/*!
+ * Decodes a codeword and writes the surviving paths, sorted from the most to the least likely.
+ *
+ * The node types are only recomputed when the code size or the frozen set change between calls.
+ * \param[in, out] p A pointer to the decoder.
+ * \param[in] llr LLRs of the codeword.
+ * \param[out] data_decoded Decoded messages, the i-th one starts at position \f$ i \times 2^n \f$.
+ * \param[in] max_nof_candidates Maximum number of messages written in data_decoded.
+ * \param[in] code_size_log \f$log_2\f$ of the number of bits in the codeword.
+ * \param[in] frozen_set The position of the frozen bits in increasing order.
+ * \param[in] frozen_set_size The size of the frozen_set.
+ * \return The number of messages written, -1 if an error occurs.
+ */
+int polar_decoder_scl_c(void*           p,
+                        const int8_t*   llr,
+                        uint8_t*        data_decoded,
+                        uint8_t         max_nof_candidates,
+                        uint8_t         code_size_log,
+                        const uint16_t* frozen_set,
+                        uint16_t        frozen_set_size);
+
+#endif // POLAR_DECODER_SCL_C_H
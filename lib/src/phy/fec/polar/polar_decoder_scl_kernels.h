@@ -0,0 +1,71 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file polar_decoder_scl_kernels.h
+ * \brief Declaration of the vector kernels used by the SCL polar decoder.
+ *
+ * All kernels work with 8-bit LLRs saturated to \f$[-127, 127]\f$ and with bits stored as 0 and 1 bytes. The
+ * different implementations are bit exact.
+ */
+
+#ifndef POLAR_DECODER_SCL_KERNELS_H
+#define POLAR_DECODER_SCL_KERNELS_H
+
+#include <stdint.h>
+
+/*!
+ * \brief Set of vector kernels of an SCL polar decoder.
+ */
+typedef struct {
+  /*! \brief Computes \f$ z = sign(x) \times sign(y) \times \min(abs(x), abs(y)) \f$ elementwise. */
+  void (*f)(const int8_t* x, const int8_t* y, int8_t* z, uint16_t len);
+  /*! \brief Computes \f$ z = y + (1 - 2b) x \f$ elementwise, saturated to \f$[-127, 127]\f$. */
+  void (*g)(const uint8_t* b, const int8_t* x, const int8_t* y, int8_t* z, uint16_t len);
+  /*! \brief Computes \f$ z = x \oplus y \f$ elementwise. */
+  void (*xor)(const uint8_t* x, const uint8_t* y, uint8_t* z, uint16_t len);
+  /*! \brief Returns 1 if \f$ (x < 0) \f$ and 0 if \f$ (x >= 0) \f$. */
+  void (*hard_bit)(const int8_t* x, uint8_t* z, uint16_t len);
+  /*! \brief Path metric penalties of deciding all bits 0 (sum of \f$|x|\f$ for \f$ x < 0\f$) and all bits 1 (sum of
+   * \f$x\f$ for \f$ x > 0\f$). */
+  void (*penalty)(const int8_t* x, uint16_t len, uint32_t* pen0, uint32_t* pen1);
+} polar_scl_kernels_t;
+
+/*!
+ * \brief Portable implementation of the SCL kernels.
+ */
+extern const polar_scl_kernels_t polar_scl_kernels_c;
+
+#ifdef LV_HAVE_AVX2
+/*!
+ * \brief AVX2 implementation of the SCL kernels, vectors shorter than 32 LLRs use the portable kernels.
+ */
+extern const polar_scl_kernels_t polar_scl_kernels_avx2;
+#endif // LV_HAVE_AVX2
+
+#ifdef LV_HAVE_AVX512
+/*!
+ * \brief AVX512 implementation of the SCL kernels, vector tails are processed with masked instructions.
+ */
+extern const polar_scl_kernels_t polar_scl_kernels_avx512;
+#endif // LV_HAVE_AVX512
+
+#endif // POLAR_DECODER_SCL_KERNELS_H
@@ -0,0 +1,139 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file polar_decoder_scl_kernels_avx2.c
+ * \brief Definition of the SCL polar decoder kernels (AVX2 version).
+ */
+
+#include <stdint.h>
+
+#include "../utils_avx2.h"
+#include "polar_decoder_scl_kernels.h"
+
+#ifdef LV_HAVE_AVX2
+
+#include <immintrin.h>
+
+static void scl_f_avx2(const int8_t* x, const int8_t* y, int8_t* z, uint16_t len)
+{
+  uint16_t i = 0;
+  for (; i + SRSRAN_AVX2_B_SIZE <= len; i += SRSRAN_AVX2_B_SIZE) {
+    __m256i m_x = _mm256_loadu_si256((__m256i*)&x[i]);
+    __m256i m_y = _mm256_loadu_si256((__m256i*)&y[i]);
+
+    __m256i m_sign = _mm256_sign_epi8(m_x, m_y);
+    __m256i m_min  = _mm256_min_epi8(_mm256_abs_epi8(m_x), _mm256_abs_epi8(m_y));
+
+    _mm256_storeu_si256((__m256i*)&z[i], _mm256_sign_epi8(m_min, m_sign));
+  }
+  if (i < len) {
+    polar_scl_kernels_c.f(x + i, y + i, z + i, len - i);
+  }
+}
+
+static void scl_g_avx2(const uint8_t* b, const int8_t* x, const int8_t* y, int8_t* z, uint16_t len)
+{
+  const __m256i M_1      = _mm256_set1_epi8(1);
+  const __m256i M_NEG127 = _mm256_set1_epi8(-127);
+
+  uint16_t i = 0;
+  for (; i + SRSRAN_AVX2_B_SIZE <= len; i += SRSRAN_AVX2_B_SIZE) {
+    __m256i m_x = _mm256_loadu_si256((__m256i*)&x[i]);
+    __m256i m_y = _mm256_loadu_si256((__m256i*)&y[i]);
+    __m256i m_b = _mm256_loadu_si256((__m256i*)&b[i]);
+
+    // 1 - 2b is 1 for b = 0 and -1 for b = 1
+    __m256i m_sign = _mm256_sub_epi8(M_1, _mm256_add_epi8(m_b, m_b));
+    __m256i m_z    = _mm256_adds_epi8(_mm256_sign_epi8(m_x, m_sign), m_y);
+
+    _mm256_storeu_si256((__m256i*)&z[i], _mm256_max_epi8(M_NEG127, m_z));
+  }
+  if (i < len) {
+    polar_scl_kernels_c.g(b + i, x + i, y + i, z + i, len - i);
+  }
+}
+
+static void scl_xor_avx2(const uint8_t* x, const uint8_t* y, uint8_t* z, uint16_t len)
+{
+  uint16_t i = 0;
+  for (; i + SRSRAN_AVX2_B_SIZE <= len; i += SRSRAN_AVX2_B_SIZE) {
+    __m256i m_x = _mm256_loadu_si256((__m256i*)&x[i]);
+    __m256i m_y = _mm256_loadu_si256((__m256i*)&y[i]);
+    _mm256_storeu_si256((__m256i*)&z[i], _mm256_xor_si256(m_x, m_y));
+  }
+  if (i < len) {
+    polar_scl_kernels_c.xor(x + i, y + i, z + i, len - i);
+  }
+}
+
+static void scl_hard_bit_avx2(const int8_t* x, uint8_t* z, uint16_t len)
+{
+  const __m256i M_0 = _mm256_setzero_si256();
+  const __m256i M_1 = _mm256_set1_epi8(1);
+
+  uint16_t i = 0;
+  for (; i + SRSRAN_AVX2_B_SIZE <= len; i += SRSRAN_AVX2_B_SIZE) {
+    __m256i m_x = _mm256_loadu_si256((__m256i*)&x[i]);
+    _mm256_storeu_si256((__m256i*)&z[i], _mm256_and_si256(_mm256_cmpgt_epi8(M_0, m_x), M_1));
+  }
+  if (i < len) {
+    polar_scl_kernels_c.hard_bit(x + i, z + i, len - i);
+  }
+}
+
+static void scl_penalty_avx2(const int8_t* x, uint16_t len, uint32_t* pen0, uint32_t* pen1)
+{
+  const __m256i M_0 = _mm256_setzero_si256();
+
+  __m256i  m_acc0 = _mm256_setzero_si256();
+  __m256i  m_acc1 = _mm256_setzero_si256();
+  uint16_t i      = 0;
+  for (; i + SRSRAN_AVX2_B_SIZE <= len; i += SRSRAN_AVX2_B_SIZE) {
+    __m256i m_x = _mm256_loadu_si256((__m256i*)&x[i]);
+
+    // Magnitudes fit in unsigned bytes, the sum of absolute differences against zero accumulates them
+    __m256i m_neg = _mm256_abs_epi8(_mm256_min_epi8(m_x, M_0));
+    __m256i m_pos = _mm256_max_epi8(m_x, M_0);
+    m_acc0        = _mm256_add_epi64(m_acc0, _mm256_sad_epu8(m_neg, M_0));
+    m_acc1        = _mm256_add_epi64(m_acc1, _mm256_sad_epu8(m_pos, M_0));
+  }
+
+  uint32_t p0 = 0;
+  uint32_t p1 = 0;
+  if (i < len) {
+    polar_scl_kernels_c.penalty(x + i, len - i, &p0, &p1);
+  }
+  *pen0 = p0 + (uint32_t)(_mm256_extract_epi64(m_acc0, 0) + _mm256_extract_epi64(m_acc0, 1) +
+                          _mm256_extract_epi64(m_acc0, 2) + _mm256_extract_epi64(m_acc0, 3));
+  *pen1 = p1 + (uint32_t)(_mm256_extract_epi64(m_acc1, 0) + _mm256_extract_epi64(m_acc1, 1) +
+                          _mm256_extract_epi64(m_acc1, 2) + _mm256_extract_epi64(m_acc1, 3));
+}
+
+const polar_scl_kernels_t polar_scl_kernels_avx2 = {
+    .f        = scl_f_avx2,
+    .g        = scl_g_avx2,
+    .xor      = scl_xor_avx2,
+    .hard_bit = scl_hard_bit_avx2,
+    .penalty  = scl_penalty_avx2,
+};
+
+#endif // LV_HAVE_AVX2
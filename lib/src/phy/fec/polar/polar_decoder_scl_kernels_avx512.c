@@ -0,0 +1,129 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file polar_decoder_scl_kernels_avx512.c
+ * \brief Definition of the SCL polar decoder kernels (AVX512 version).
+ *
+ * Most operations of a polar decoder act on short vectors, the last (or only) iteration of every kernel uses masked
+ * loads and stores instead of falling back to scalar code.
+ */
+
+#include <stdint.h>
+
+#include "../utils_avx512.h"
+#include "polar_decoder_scl_kernels.h"
+
+#ifdef LV_HAVE_AVX512
+
+#include <immintrin.h>
+
+/*! Mask selecting the remaining bytes of a vector. */
+static inline __mmask64 scl_mask_avx512(uint16_t remaining)
+{
+  return (remaining >= SRSRAN_AVX512_B_SIZE) ? ~(__mmask64)0 : (((__mmask64)1 << remaining) - 1);
+}
+
+static void scl_f_avx512(const int8_t* x, const int8_t* y, int8_t* z, uint16_t len)
+{
+  const __m512i M_0 = _mm512_setzero_si512();
+
+  for (uint16_t i = 0; i < len; i += SRSRAN_AVX512_B_SIZE) {
+    __mmask64 mask = scl_mask_avx512(len - i);
+    __m512i   m_x  = _mm512_maskz_loadu_epi8(mask, &x[i]);
+    __m512i   m_y  = _mm512_maskz_loadu_epi8(mask, &y[i]);
+
+    __m512i   m_min = _mm512_min_epi8(_mm512_abs_epi8(m_x), _mm512_abs_epi8(m_y));
+    __mmask64 m_neg = _mm512_movepi8_mask(_mm512_xor_si512(m_x, m_y));
+
+    _mm512_mask_storeu_epi8(&z[i], mask, _mm512_mask_sub_epi8(m_min, m_neg, M_0, m_min));
+  }
+}
+
+static void scl_g_avx512(const uint8_t* b, const int8_t* x, const int8_t* y, int8_t* z, uint16_t len)
+{
+  const __m512i M_0      = _mm512_setzero_si512();
+  const __m512i M_NEG127 = _mm512_set1_epi8(-127);
+
+  for (uint16_t i = 0; i < len; i += SRSRAN_AVX512_B_SIZE) {
+    __mmask64 mask = scl_mask_avx512(len - i);
+    __m512i   m_x  = _mm512_maskz_loadu_epi8(mask, &x[i]);
+    __m512i   m_y  = _mm512_maskz_loadu_epi8(mask, &y[i]);
+    __m512i   m_b  = _mm512_maskz_loadu_epi8(mask, &b[i]);
+
+    // Negate x where the bit is 1
+    __mmask64 m_is_1 = _mm512_test_epi8_mask(m_b, m_b);
+    __m512i   m_z    = _mm512_adds_epi8(_mm512_mask_sub_epi8(m_x, m_is_1, M_0, m_x), m_y);
+
+    _mm512_mask_storeu_epi8(&z[i], mask, _mm512_max_epi8(M_NEG127, m_z));
+  }
+}
+
+static void scl_xor_avx512(const uint8_t* x, const uint8_t* y, uint8_t* z, uint16_t len)
+{
+  for (uint16_t i = 0; i < len; i += SRSRAN_AVX512_B_SIZE) {
+    __mmask64 mask = scl_mask_avx512(len - i);
+    __m512i   m_x  = _mm512_maskz_loadu_epi8(mask, &x[i]);
+    __m512i   m_y  = _mm512_maskz_loadu_epi8(mask, &y[i]);
+    _mm512_mask_storeu_epi8(&z[i], mask, _mm512_xor_si512(m_x, m_y));
+  }
+}
+
+static void scl_hard_bit_avx512(const int8_t* x, uint8_t* z, uint16_t len)
+{
+  const __m512i M_1 = _mm512_set1_epi8(1);
+
+  for (uint16_t i = 0; i < len; i += SRSRAN_AVX512_B_SIZE) {
+    __mmask64 mask = scl_mask_avx512(len - i);
+    __m512i   m_x  = _mm512_maskz_loadu_epi8(mask, &x[i]);
+    _mm512_mask_storeu_epi8(&z[i], mask, _mm512_maskz_mov_epi8(_mm512_movepi8_mask(m_x), M_1));
+  }
+}
+
+static void scl_penalty_avx512(const int8_t* x, uint16_t len, uint32_t* pen0, uint32_t* pen1)
+{
+  const __m512i M_0 = _mm512_setzero_si512();
+
+  __m512i m_acc0 = _mm512_setzero_si512();
+  __m512i m_acc1 = _mm512_setzero_si512();
+  for (uint16_t i = 0; i < len; i += SRSRAN_AVX512_B_SIZE) {
+    __m512i m_x = _mm512_maskz_loadu_epi8(scl_mask_avx512(len - i), &x[i]);
+
+    // Magnitudes fit in unsigned bytes, the sum of absolute differences against zero accumulates them
+    __m512i m_neg = _mm512_abs_epi8(_mm512_min_epi8(m_x, M_0));
+    __m512i m_pos = _mm512_max_epi8(m_x, M_0);
+    m_acc0        = _mm512_add_epi64(m_acc0, _mm512_sad_epu8(m_neg, M_0));
+    m_acc1        = _mm512_add_epi64(m_acc1, _mm512_sad_epu8(m_pos, M_0));
+  }
+
+  *pen0 = (uint32_t)_mm512_reduce_add_epi64(m_acc0);
+  *pen1 = (uint32_t)_mm512_reduce_add_epi64(m_acc1);
+}
+
+const polar_scl_kernels_t polar_scl_kernels_avx512 = {
+    .f        = scl_f_avx512,
+    .g        = scl_g_avx512,
+    .xor      = scl_xor_avx512,
+    .hard_bit = scl_hard_bit_avx512,
+    .penalty  = scl_penalty_avx512,
+};
+
+#endif // LV_HAVE_AVX512
@@ -0,0 +1,358 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file polar_list_test.c
+ * \brief Test and benchmark of the CRC-aided SCL polar decoders against the 8-bit SSC decoder.
+ *
+ * Random messages with a CRC24C are sent through the polar chain (subchannel allocation, encoder and rate-matching)
+ * over an AWGN channel and decoded by the SSC decoder and by the SCL decoders of every available instruction set
+ * with list sizes 2, 4 and 8. The SCL candidates are checked in order and the first one passing the CRC is selected.
+ *
+ * The test fails if the vectorized SCL decoders are not bit exact with the portable one, or if any decoder fails in
+ * the noiseless case. The BLER and the decoding throughput of all decoders are printed.
+ *
+ * Synopsis: **polar_list_test [options]**
+ *
+ * Options:
+ *
+ *  - <b>-n \<number\></b> nMax,  [Default 9] -- Use 9 for downlink, and 10 for uplink configuration.
+ *  - <b>-k \<number\></b> Message size (K),  [Default 64]. K includes the 24 CRC bits.
+ *  - <b>-e \<number\></b> Rate matching size (E), [Default 108].
+ *  - <b>-i \<number\></b> Enable bit interleaver (bil),  [Default 0].
+ *  - <b>-s \<number\></b> SNR [dB, Default 1.00 dB] -- Use 101 for noiseless.
+ *  - <b>-b \<number\></b> Number of transmitted messages, [Default 2000].
+ *
+ * Example: PDCCH aggregation level 1 - ./polar_list_test -n9 -k64 -e108 -s1
+ */
+
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/phy/common/phy_common.h"
+#include "srsran/phy/common/timestamp.h"
+#include "srsran/phy/fec/crc.h"
+#include "srsran/phy/utils/bit.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "srsran/phy/fec/polar/polar_chanalloc.h"
+#include "srsran/phy/fec/polar/polar_code.h"
+#include "srsran/phy/fec/polar/polar_decoder.h"
+#include "srsran/phy/fec/polar/polar_encoder.h"
+#include "srsran/phy/fec/polar/polar_rm.h"
+
+#define CRC_LEN 24       /*!< \brief Number of CRC bits appended to the messages. */
+#define NOF_LIST_SIZES 3 /*!< \brief Number of tested list sizes. */
+#define NOF_KERNELS 3    /*!< \brief Maximum number of SCL implementations. */
+
+// default values
+static uint16_t K         = 64;   /*!< \brief Number of message bits (data and CRC). */
+static uint16_t E         = 108;  /*!< \brief Number of bits of the codeword after rate matching. */
+static uint8_t  nMax      = 9;    /*!< \brief Maximum \f$log_2(N)\f$, where \f$N\f$ is the codeword size.*/
+static uint8_t  bil       = 0;    /*!< \brief If bil = 0 channel interleaver disabled. */
+static double   snr_db    = 1;    /*!< \brief SNR in dB (101 for no noise). */
+static uint32_t nof_words = 2000; /*!< \brief Number of transmitted messages. */
+
+static const uint8_t list_sizes[NOF_LIST_SIZES] = {2, 4, 8};
+
+static const srsran_polar_decoder_type_t scl_types[NOF_KERNELS] = {SRSRAN_POLAR_DECODER_SCL_C,
+                                                                   SRSRAN_POLAR_DECODER_SCL_C_AVX2,
+                                                                   SRSRAN_POLAR_DECODER_SCL_C_AVX512};
+
+static const char* scl_names[NOF_KERNELS] = {"c", "avx2", "avx512"};
+
+/*!
+ * \brief Prints test help when a wrong parameter is passed as input.
+ */
+void usage(char* prog)
+{
+  printf("Usage: %s [-nX] [-kX] [-eX] [-iX] [-sX] [-bX]\n", prog);
+  printf("\t-n nMax [Default %d]\n", nMax);
+  printf("\t-k Message size, including %d CRC bits [Default %d]\n", CRC_LEN, K);
+  printf("\t-e Rate matching size [Default %d]\n", E);
+  printf("\t-i Bit interleaver indicator [Default %d]\n", bil);
+  printf("\t-s SNR [dB, Default %.2f dB] -- Use 101 for noiseless\n", snr_db);
+  printf("\t-b Number of transmitted messages [Default %d]\n", nof_words);
+}
+
+/*!
+ * \brief Parses the input line.
+ */
+void parse_args(int argc, char** argv)
+{
+  int opt = 0;
+  while ((opt = getopt(argc, argv, "n:k:e:i:s:b:")) != -1) {
+    switch (opt) {
+      case 'e':
+        E = (int)strtol(optarg, NULL, 10);
+        break;
+      case 'k':
+        K = (int)strtol(optarg, NULL, 10);
+        break;
+      case 'n':
+        nMax = (int)strtol(optarg, NULL, 10);
+        break;
+      case 'i':
+        bil = (int)strtol(optarg, NULL, 10);
+        break;
+      case 's':
+        snr_db = strtof(optarg, NULL);
+        break;
+      case 'b':
+        nof_words = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+/*!
+ * \brief Accumulates the time elapsed since t[1] in elapsed.
+ */
+static void accumulate_time(struct timeval* t, double* elapsed)
+{
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  *elapsed += t[0].tv_sec + 1e-6 * t[0].tv_usec;
+}
+
+/*!
+ * \brief Prints the BLER and the throughput, in information Mbps, of a decoder.
+ */
+static void print_result(const char* name, uint32_t nof_errors, double elapsed)
+{
+  printf("  %-14s BLER = %.2e (%4d errors), throughput = %8.2f Mbps\n",
+         name,
+         (double)nof_errors / nof_words,
+         nof_errors,
+         (double)(K - CRC_LEN) * nof_words / elapsed / 1e6);
+}
+
+int main(int argc, char** argv)
+{
+  int ret = SRSRAN_ERROR;
+
+  parse_args(argc, argv);
+
+  if (K <= CRC_LEN || K >= E) {
+    ERROR("Invalid message size K=%d for E=%d", K, E);
+    return SRSRAN_ERROR;
+  }
+
+  srsran_polar_code_t    code        = {};
+  srsran_polar_encoder_t enc         = {};
+  srsran_polar_rm_t      rm_tx       = {};
+  srsran_polar_rm_t      rm_rx       = {};
+  srsran_polar_decoder_t dec_ssc     = {};
+  srsran_crc_t           crc         = {};
+  srsran_random_t        random_gen  = srsran_random_init(1234);
+  uint32_t               nof_kernels = 0;
+
+  srsran_polar_decoder_t dec_scl[NOF_LIST_SIZES][NOF_KERNELS] = {};
+
+  uint8_t* data_tx    = srsran_vec_u8_malloc(K);
+  uint8_t* data_rx    = srsran_vec_u8_malloc(K);
+  uint8_t* input_enc  = srsran_vec_u8_malloc(NMAX);
+  uint8_t* output_enc = srsran_vec_u8_malloc(NMAX);
+  uint8_t* codeword   = srsran_vec_u8_malloc(E);
+  float*   rm_llr     = srsran_vec_f_malloc(E);
+  int8_t*  rm_llr_c   = srsran_vec_i8_malloc(E);
+  int8_t*  llr_c      = srsran_vec_i8_malloc(NMAX);
+  uint8_t* output_dec = srsran_vec_u8_malloc(NMAX * SRSRAN_POLAR_DECODER_LIST_SIZE_MAX);
+  uint8_t* output_ref = srsran_vec_u8_malloc(NMAX * SRSRAN_POLAR_DECODER_LIST_SIZE_MAX);
+  if (!data_tx || !data_rx || !input_enc || !output_enc || !codeword || !rm_llr || !rm_llr_c || !llr_c || !output_dec ||
+      !output_ref) {
+    perror("malloc");
+    goto clean_exit;
+  }
+
+  if (srsran_polar_code_init(&code) < SRSRAN_SUCCESS || srsran_polar_code_get(&code, K, E, nMax) < SRSRAN_SUCCESS ||
+      srsran_polar_encoder_init(&enc, SRSRAN_POLAR_ENCODER_PIPELINED, nMax) < SRSRAN_SUCCESS ||
+      srsran_polar_rm_tx_init(&rm_tx) < SRSRAN_SUCCESS || srsran_polar_rm_rx_init_c(&rm_rx) < SRSRAN_SUCCESS ||
+      srsran_polar_decoder_init(&dec_ssc, SRSRAN_POLAR_DECODER_SSC_C, nMax) < SRSRAN_SUCCESS ||
+      srsran_crc_init(&crc, SRSRAN_LTE_CRC24C, CRC_LEN) < SRSRAN_SUCCESS) {
+    ERROR("Error initializing the polar chain");
+    goto clean_exit;
+  }
+
+  // The portable decoder is always available, the vectorized ones depend on the build
+  for (uint32_t t = 0; t < NOF_KERNELS; t++) {
+    bool available = true;
+    for (uint32_t l = 0; l < NOF_LIST_SIZES && available; l++) {
+      available = srsran_polar_decoder_init_list(&dec_scl[l][t], scl_types[t], nMax, list_sizes[l]) == SRSRAN_SUCCESS;
+    }
+    if (!available) {
+      if (t == 0) {
+        ERROR("Error initializing the SCL decoder");
+        goto clean_exit;
+      }
+      break;
+    }
+    nof_kernels++;
+  }
+
+  printf("Test POLAR list decoders: E=%d, N=%d, K=%d (%d CRC bits), PC=%d, SNR=%.1f dB, %d messages\n",
+         E,
+         code.N,
+         K,
+         CRC_LEN,
+         code.nPC,
+         snr_db,
+         nof_words);
+
+  // Same noise and quantization as the polar chain test
+  double var    = srsran_convert_dB_to_power(-snr_db);
+  float  gain_c = (snr_db == 101) ? 32.0f : (float)(127 * var / 20 / (1 / var + 2));
+
+  uint32_t       errors_ssc                               = 0;
+  uint32_t       errors_scl[NOF_LIST_SIZES]               = {};
+  double         elapsed_ssc                              = 0;
+  double         elapsed_scl[NOF_LIST_SIZES][NOF_KERNELS] = {};
+  uint32_t       mismatches                               = 0;
+  struct timeval t[3];
+
+  for (uint32_t w = 0; w < nof_words; w++) {
+    // Generate the message and send it through the chain
+    for (uint32_t i = 0; i < K - CRC_LEN; i++) {
+      data_tx[i] = (uint8_t)srsran_random_uniform_int_dist(random_gen, 0, 1);
+    }
+    srsran_crc_attach(&crc, data_tx, K - CRC_LEN);
+    srsran_polar_chanalloc_tx(data_tx, input_enc, code.N, code.K, code.nPC, code.K_set, code.PC_set);
+    srsran_polar_encoder_encode(&enc, input_enc, output_enc, code.n);
+    srsran_polar_rm_tx(&rm_tx, output_enc, codeword, code.n, E, K, bil);
+
+    for (uint32_t i = 0; i < E; i++) {
+      rm_llr[i] = codeword[i] ? -1 : 1;
+    }
+    if (snr_db != 101) {
+      srsran_ch_awgn_f(rm_llr, rm_llr, var, E);
+      srsran_vec_sc_prod_fff(rm_llr, 2 / (var * var), rm_llr, E);
+    }
+    srsran_vec_quant_fc(rm_llr, rm_llr_c, gain_c, 0, 127, E);
+    srsran_polar_rm_rx_c(&rm_rx, rm_llr_c, llr_c, E, code.n, K, bil);
+
+    // SSC reference
+    gettimeofday(&t[1], NULL);
+    srsran_polar_decoder_decode_c(&dec_ssc, llr_c, output_dec, code.n, code.F_set, code.F_set_size);
+    accumulate_time(t, &elapsed_ssc);
+    srsran_polar_chanalloc_rx(output_dec, data_rx, code.K, code.nPC, code.K_set, code.PC_set);
+    if (memcmp(data_tx, data_rx, K) != 0) {
+      errors_ssc++;
+    }
+
+    for (uint32_t l = 0; l < NOF_LIST_SIZES; l++) {
+      int nof_cand_ref = 0;
+      for (uint32_t k = 0; k < nof_kernels; k++) {
+        uint8_t* output = (k == 0) ? output_ref : output_dec;
+
+        gettimeofday(&t[1], NULL);
+        int nof_cand = srsran_polar_decoder_decode_list_c(
+            &dec_scl[l][k], llr_c, output, code.n, code.F_set, code.F_set_size);
+        accumulate_time(t, &elapsed_scl[l][k]);
+
+        if (nof_cand < 1 || nof_cand > list_sizes[l]) {
+          ERROR("Invalid number of candidates %d for L=%d", nof_cand, list_sizes[l]);
+          goto clean_exit;
+        }
+
+        if (k == 0) {
+          nof_cand_ref = nof_cand;
+        } else if (nof_cand != nof_cand_ref || memcmp(output_ref, output_dec, (size_t)nof_cand * code.N) != 0) {
+          ERROR("SCL %s decoder (L=%d) differs from the portable one in message %d", scl_names[k], list_sizes[l], w);
+          mismatches++;
+        }
+      }
+
+      // CRC-aided selection, the most likely candidate is kept if none passes the CRC
+      bool found = false;
+      for (int c = 0; c < nof_cand_ref && !found; c++) {
+        srsran_polar_chanalloc_rx(output_ref + c * code.N, data_rx, code.K, code.nPC, code.K_set, code.PC_set);
+        found = srsran_crc_match(&crc, data_rx, K - CRC_LEN);
+      }
+      if (!found) {
+        srsran_polar_chanalloc_rx(output_ref, data_rx, code.K, code.nPC, code.K_set, code.PC_set);
+      }
+      if (memcmp(data_tx, data_rx, K) != 0) {
+        errors_scl[l]++;
+      }
+    }
+  }
+
+  print_result("SSC c", errors_ssc, elapsed_ssc);
+  for (uint32_t l = 0; l < NOF_LIST_SIZES; l++) {
+    for (uint32_t k = 0; k < nof_kernels; k++) {
+      char name[32];
+      snprintf(name, sizeof(name), "SCL-%d %s", list_sizes[l], scl_names[k]);
+      print_result(name, errors_scl[l], elapsed_scl[l][k]);
+    }
+  }
+
+  if (mismatches > 0) {
+    ERROR("%d mismatches between the SCL implementations", mismatches);
+    goto clean_exit;
+  }
+
+  if (snr_db == 101) {
+    bool all_correct = errors_ssc == 0;
+    for (uint32_t l = 0; l < NOF_LIST_SIZES; l++) {
+      all_correct = all_correct && errors_scl[l] == 0;
+    }
+    if (!all_correct) {
+      ERROR("Decoding errors in the noiseless case");
+      goto clean_exit;
+    }
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  for (uint32_t l = 0; l < NOF_LIST_SIZES; l++) {
+    for (uint32_t k = 0; k < NOF_KERNELS; k++) {
+      srsran_polar_decoder_free(&dec_scl[l][k]);
+    }
+  }
+  srsran_polar_decoder_free(&dec_ssc);
+  srsran_polar_encoder_free(&enc);
+  srsran_polar_rm_rx_free_c(&rm_rx);
+  srsran_polar_rm_tx_free(&rm_tx);
+  srsran_polar_code_free(&code);
+  srsran_random_free(random_gen);
+  free(data_tx);
+  free(data_rx);
+  free(input_enc);
+  free(output_enc);
+  free(codeword);
+  free(rm_llr);
+  free(rm_llr_c);
+  free(llr_c);
+  free(output_dec);
+  free(output_ref);
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+  return ret;
+}
@@ -26,6 +26,7 @@
 #include <strings.h>
 
 #include "srsran/phy/common/phy_common.h"
+#include "srsran/phy/fec/ldpc/base_graph.h"
 #include "srsran/phy/fec/softbuffer.h"
 #include "srsran/phy/fec/turbo/turbodecoder_gen.h"
 #include "srsran/phy/phch/ra.h"
@@ -33,6 +34,12 @@
 
 #define MAX_PDSCH_RE(cp) (2 * SRSRAN_CP_NSYMB(cp) * 12)
 
+// Slab blocks are aligned to cache lines, which also suits every SIMD width
+#define SOFTBUFFER_SLAB_ALIGN 64
+
+static uint32_t softbuffer_slab_get(srsran_softbuffer_slab_t* q, uint8_t** blocks, uint32_t nof_blocks);
+static void     softbuffer_slab_put(srsran_softbuffer_slab_t* q, uint8_t** blocks, uint32_t nof_blocks);
+
 int srsran_softbuffer_rx_init(srsran_softbuffer_rx_t* q, uint32_t nof_prb)
 {
   int ret = srsran_ra_tbs_from_idx(SRSRAN_RA_NOF_TBS_IDX - 1, nof_prb);
@@ -46,7 +53,7 @@ int srsran_softbuffer_rx_init(srsran_softbuffer_rx_t* q, uint32_t nof_prb)
   return srsran_softbuffer_rx_init_guru(q, max_cb, max_cb_size);
 }
 
-int srsran_softbuffer_rx_init_guru(srsran_softbuffer_rx_t* q, uint32_t max_cb, uint32_t max_cb_size)
+static int softbuffer_rx_init(srsran_softbuffer_rx_t* q, uint32_t max_cb, uint32_t max_cb_size, uint32_t llr_size)
 {
   int ret = SRSRAN_ERROR;
 
@@ -61,6 +68,7 @@ int srsran_softbuffer_rx_init_guru(srsran_softbuffer_rx_t* q, uint32_t max_cb, u
   // Set internal attributes
   q->max_cb      = max_cb;
   q->max_cb_size = max_cb_size;
+  q->llr_size    = llr_size;
 
   q->buffer_f = SRSRAN_MEM_ALLOC(int16_t*, q->max_cb);
   if (!q->buffer_f) {
@@ -83,7 +91,7 @@ int srsran_softbuffer_rx_init_guru(srsran_softbuffer_rx_t* q, uint32_t max_cb, u
   }
 
   for (uint32_t i = 0; i < q->max_cb; i++) {
-    q->buffer_f[i] = srsran_vec_i16_malloc(q->max_cb_size);
+    q->buffer_f[i] = srsran_vec_malloc(q->max_cb_size * q->llr_size);
     if (!q->buffer_f[i]) {
       perror("malloc");
       goto clean_exit;
@@ -109,23 +117,73 @@ clean_exit:
   return ret;
 }
 
+int srsran_softbuffer_rx_init_guru(srsran_softbuffer_rx_t* q, uint32_t max_cb, uint32_t max_cb_size)
+{
+  return softbuffer_rx_init(q, max_cb, max_cb_size, sizeof(int16_t));
+}
+
+int srsran_softbuffer_rx_init_guru_8bit(srsran_softbuffer_rx_t* q, uint32_t max_cb, uint32_t max_cb_size)
+{
+  return softbuffer_rx_init(q, max_cb, max_cb_size, sizeof(int8_t));
+}
+
+int srsran_softbuffer_rx_init_slab(srsran_softbuffer_rx_t* q, uint32_t max_cb, srsran_softbuffer_slab_t* slab)
+{
+  // Protect pointers
+  if (!q || !slab) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Initialise object
+  SRSRAN_MEM_ZERO(q, srsran_softbuffer_rx_t, 1);
+
+  // Set internal attributes, the code blocks are attached on reset
+  q->max_cb      = max_cb;
+  q->max_cb_size = slab->max_cb_size;
+  q->llr_size    = slab->llr_size;
+  q->slab        = slab;
+
+  q->buffer_f = SRSRAN_MEM_ALLOC(int16_t*, q->max_cb);
+  q->data     = SRSRAN_MEM_ALLOC(uint8_t*, q->max_cb);
+  q->cb_crc   = SRSRAN_MEM_ALLOC(bool, q->max_cb);
+  if (!q->buffer_f || !q->data || !q->cb_crc) {
+    perror("malloc");
+    srsran_softbuffer_rx_free(q);
+    return SRSRAN_ERROR;
+  }
+  SRSRAN_MEM_ZERO(q->buffer_f, int16_t*, q->max_cb);
+  SRSRAN_MEM_ZERO(q->data, uint8_t*, q->max_cb);
+  SRSRAN_MEM_ZERO(q->cb_crc, bool, q->max_cb);
+
+  return SRSRAN_SUCCESS;
+}
+
 void srsran_softbuffer_rx_free(srsran_softbuffer_rx_t* q)
 {
   if (q) {
-    if (q->buffer_f) {
-      for (uint32_t i = 0; i < q->max_cb; i++) {
-        if (q->buffer_f[i]) {
-          free(q->buffer_f[i]);
+    if (q->slab) {
+      // Blocks belong to the slab
+      srsran_softbuffer_rx_release(q);
+    } else {
+      if (q->buffer_f) {
+        for (uint32_t i = 0; i < q->max_cb; i++) {
+          if (q->buffer_f[i]) {
+            free(q->buffer_f[i]);
+          }
+        }
+      }
+      if (q->data) {
+        for (uint32_t i = 0; i < q->max_cb; i++) {
+          if (q->data[i]) {
+            free(q->data[i]);
+          }
         }
       }
+    }
+    if (q->buffer_f) {
       free(q->buffer_f);
     }
     if (q->data) {
-      for (uint32_t i = 0; i < q->max_cb; i++) {
-        if (q->data[i]) {
-          free(q->data[i]);
-        }
-      }
       free(q->data);
     }
     if (q->cb_crc) {
@@ -139,23 +197,68 @@ void srsran_softbuffer_rx_free(srsran_softbuffer_rx_t* q)
 void srsran_softbuffer_rx_reset_tbs(srsran_softbuffer_rx_t* q, uint32_t tbs)
 {
   uint32_t nof_cb = (tbs + 24) / (SRSRAN_TCOD_MAX_LEN_CB - 24) + 1;
+  if (q->slab) {
+    // Slab soft-buffers only attach the blocks the TB needs. Bound the number of code blocks with the smallest code
+    // block, LDPC base graph 2, which also covers base graph 1 and turbo segmentation
+    nof_cb = SRSRAN_CEIL(tbs + 24, SRSRAN_LDPC_BG2_MAX_LEN_CB - 24);
+  }
   srsran_softbuffer_rx_reset_cb(q, SRSRAN_MIN(nof_cb, q->max_cb));
 }
 
 void srsran_softbuffer_rx_reset(srsran_softbuffer_rx_t* q)
 {
+  if (q->slab) {
+    srsran_softbuffer_rx_release(q);
+    return;
+  }
   srsran_softbuffer_rx_reset_cb(q, q->max_cb);
 }
 
+// Takes or returns slab blocks until nof_cb code blocks are attached or the slab runs out of blocks
+static void softbuffer_rx_attach(srsran_softbuffer_rx_t* q, uint32_t nof_cb)
+{
+  uint8_t* blocks[SRSRAN_MAX_CODEBLOCKS];
+
+  // Take the missing blocks
+  while (q->nof_attached < nof_cb) {
+    uint32_t nof_new = SRSRAN_MIN(nof_cb - q->nof_attached, SRSRAN_MAX_CODEBLOCKS);
+    nof_new          = softbuffer_slab_get(q->slab, blocks, nof_new);
+    if (nof_new == 0) {
+      return;
+    }
+    for (uint32_t i = 0; i < nof_new; i++) {
+      q->buffer_f[q->nof_attached] = (int16_t*)blocks[i];
+      q->data[q->nof_attached]     = blocks[i] + q->max_cb_size * q->llr_size;
+      q->nof_attached++;
+    }
+  }
+
+  // Return the blocks the TB does not need
+  while (q->nof_attached > nof_cb) {
+    uint32_t nof_old = 0;
+    while (q->nof_attached > nof_cb && nof_old < SRSRAN_MAX_CODEBLOCKS) {
+      q->nof_attached--;
+      blocks[nof_old++]            = (uint8_t*)q->buffer_f[q->nof_attached];
+      q->buffer_f[q->nof_attached] = NULL;
+      q->data[q->nof_attached]     = NULL;
+    }
+    softbuffer_slab_put(q->slab, blocks, nof_old);
+  }
+}
+
 void srsran_softbuffer_rx_reset_cb(srsran_softbuffer_rx_t* q, uint32_t nof_cb)
 {
   if (q->buffer_f) {
     if (nof_cb > q->max_cb) {
       nof_cb = q->max_cb;
     }
+    if (q->slab) {
+      softbuffer_rx_attach(q, nof_cb);
+      nof_cb = q->nof_attached;
+    }
     for (uint32_t i = 0; i < nof_cb; i++) {
       if (q->buffer_f[i]) {
-        srsran_vec_i16_zero(q->buffer_f[i], q->max_cb_size);
+        srsran_vec_u8_zero((uint8_t*)q->buffer_f[i], q->max_cb_size * q->llr_size);
       }
       if (q->data[i]) {
         srsran_vec_u8_zero(q->data[i], q->max_cb_size / 8);
@@ -168,6 +271,27 @@ void srsran_softbuffer_rx_reset_cb(srsran_softbuffer_rx_t* q, uint32_t nof_cb)
   q->tb_crc = false;
 }
 
+void srsran_softbuffer_rx_release(srsran_softbuffer_rx_t* q)
+{
+  if (q == NULL || q->slab == NULL) {
+    return;
+  }
+  softbuffer_rx_attach(q, 0);
+  if (q->cb_crc) {
+    SRSRAN_MEM_ZERO(q->cb_crc, bool, q->max_cb);
+  }
+  q->tb_crc = false;
+}
+
+size_t srsran_softbuffer_rx_mem_size(const srsran_softbuffer_rx_t* q)
+{
+  if (q == NULL) {
+    return 0;
+  }
+  uint32_t nof_cb = q->slab ? q->nof_attached : q->max_cb;
+  return (size_t)nof_cb * (q->max_cb_size * q->llr_size + q->max_cb_size / 8);
+}
+
 void srsran_softbuffer_rx_reset_cb_crc(srsran_softbuffer_rx_t* q, uint32_t nof_cb)
 {
   if (q == NULL || nof_cb == 0) {
@@ -177,6 +301,137 @@ void srsran_softbuffer_rx_reset_cb_crc(srsran_softbuffer_rx_t* q, uint32_t nof_c
   SRSRAN_MEM_ZERO(q->cb_crc, bool, SRSRAN_MIN(q->max_cb, nof_cb));
 }
 
+static int softbuffer_slab_grow(srsran_softbuffer_slab_t* q)
+{
+  if (q->nof_segments == q->max_segments) {
+    return SRSRAN_ERROR;
+  }
+  uint8_t* segment = srsran_vec_malloc(q->segment_len * q->block_size);
+  if (segment == NULL) {
+    perror("malloc");
+    return SRSRAN_ERROR;
+  }
+  q->segments[q->nof_segments++] = segment;
+
+  // Push in reverse order so the blocks are handed out in memory order
+  for (uint32_t i = q->segment_len; i > 0; i--) {
+    q->free_list[q->nof_free++] = segment + (size_t)(i - 1) * q->block_size;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_softbuffer_slab_init(srsran_softbuffer_slab_t* q,
+                                uint32_t                  segment_len,
+                                uint32_t                  max_segments,
+                                uint32_t                  max_cb_size,
+                                uint32_t                  llr_size)
+{
+  if (q == NULL || segment_len == 0 || max_segments == 0 || max_segments > SRSRAN_SOFTBUFFER_SLAB_MAX_SEGMENTS ||
+      (llr_size != sizeof(int8_t) && llr_size != sizeof(int16_t))) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_softbuffer_slab_t, 1);
+
+  // Soft bits followed by the decoded data
+  uint32_t block_len = max_cb_size * llr_size + max_cb_size / 8;
+
+  q->max_cb_size  = max_cb_size;
+  q->llr_size     = llr_size;
+  q->block_size   = SRSRAN_CEIL(block_len, SOFTBUFFER_SLAB_ALIGN) * SOFTBUFFER_SLAB_ALIGN;
+  q->segment_len  = segment_len;
+  q->max_segments = max_segments;
+
+  q->free_list = SRSRAN_MEM_ALLOC(uint8_t*, segment_len * max_segments);
+  if (q->free_list == NULL) {
+    perror("malloc");
+    return SRSRAN_ERROR;
+  }
+
+  if (pthread_mutex_init(&q->mutex, NULL)) {
+    free(q->free_list);
+    q->free_list = NULL;
+    return SRSRAN_ERROR;
+  }
+
+  // Allocate the first segment up front
+  if (softbuffer_slab_grow(q) < SRSRAN_SUCCESS) {
+    srsran_softbuffer_slab_free(q);
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_softbuffer_slab_free(srsran_softbuffer_slab_t* q)
+{
+  if (q == NULL || q->free_list == NULL) {
+    return;
+  }
+  for (uint32_t i = 0; i < q->nof_segments; i++) {
+    free(q->segments[i]);
+  }
+  free(q->free_list);
+  pthread_mutex_destroy(&q->mutex);
+  SRSRAN_MEM_ZERO(q, srsran_softbuffer_slab_t, 1);
+}
+
+// Takes up to nof_blocks blocks, allocating a new segment if the slab ran out of blocks
+static uint32_t softbuffer_slab_get(srsran_softbuffer_slab_t* q, uint8_t** blocks, uint32_t nof_blocks)
+{
+  pthread_mutex_lock(&q->mutex);
+  while (q->nof_free < nof_blocks) {
+    if (softbuffer_slab_grow(q) < SRSRAN_SUCCESS) {
+      break;
+    }
+  }
+  nof_blocks = SRSRAN_MIN(nof_blocks, q->nof_free);
+  for (uint32_t i = 0; i < nof_blocks; i++) {
+    blocks[i] = q->free_list[--q->nof_free];
+  }
+  uint32_t nof_used = q->nof_segments * q->segment_len - q->nof_free;
+  q->max_used       = SRSRAN_MAX(q->max_used, nof_used);
+  pthread_mutex_unlock(&q->mutex);
+
+  return nof_blocks;
+}
+
+static void softbuffer_slab_put(srsran_softbuffer_slab_t* q, uint8_t** blocks, uint32_t nof_blocks)
+{
+  if (nof_blocks == 0) {
+    return;
+  }
+  pthread_mutex_lock(&q->mutex);
+  for (uint32_t i = 0; i < nof_blocks; i++) {
+    q->free_list[q->nof_free++] = blocks[i];
+  }
+  pthread_mutex_unlock(&q->mutex);
+}
+
+uint32_t srsran_softbuffer_slab_nof_used(srsran_softbuffer_slab_t* q)
+{
+  pthread_mutex_lock(&q->mutex);
+  uint32_t nof_used = q->nof_segments * q->segment_len - q->nof_free;
+  pthread_mutex_unlock(&q->mutex);
+  return nof_used;
+}
+
+uint32_t srsran_softbuffer_slab_max_used(srsran_softbuffer_slab_t* q)
+{
+  pthread_mutex_lock(&q->mutex);
+  uint32_t max_used = q->max_used;
+  pthread_mutex_unlock(&q->mutex);
+  return max_used;
+}
+
+size_t srsran_softbuffer_slab_mem_size(srsran_softbuffer_slab_t* q)
+{
+  pthread_mutex_lock(&q->mutex);
+  size_t mem_size = (size_t)q->nof_segments * q->segment_len * q->block_size;
+  pthread_mutex_unlock(&q->mutex);
+  return mem_size;
+}
+
 int srsran_softbuffer_tx_init(srsran_softbuffer_tx_t* q, uint32_t nof_prb)
 {
   int ret = srsran_ra_tbs_from_idx(SRSRAN_RA_NOF_TBS_IDX - 1, nof_prb);
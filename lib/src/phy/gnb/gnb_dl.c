@@ -61,10 +61,18 @@ int srsran_gnb_dl_init(srsran_gnb_dl_t* q, cf_t* output[SRSRAN_MAX_PORTS], const
 
   q->nof_tx_antennas = args->nof_tx_antennas;
 
-  if (srsran_pdsch_nr_init_enb(&q->pdsch, &args->pdsch) < SRSRAN_SUCCESS) {
+  q->nof_pdsch_encoders = SRSRAN_MAX(args->nof_pdsch_encoders, 1);
+  if (q->nof_pdsch_encoders > SRSRAN_GNB_DL_MAX_PDSCH_ENCODERS) {
+    ERROR("Error invalid number of PDSCH encoders (%d)", args->nof_pdsch_encoders);
     return SRSRAN_ERROR;
   }
 
+  for (uint32_t i = 0; i < q->nof_pdsch_encoders; i++) {
+    if (srsran_pdsch_nr_init_enb(&q->pdsch[i], &args->pdsch) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+
   if (gnb_dl_alloc_prb(q, args->nof_max_prb) < SRSRAN_SUCCESS) {
     ERROR("Error allocating");
     return SRSRAN_ERROR;
@@ -129,7 +137,9 @@ void srsran_gnb_dl_free(srsran_gnb_dl_t* q)
     }
   }
 
-  srsran_pdsch_nr_free(&q->pdsch);
+  for (uint32_t i = 0; i < q->nof_pdsch_encoders; i++) {
+    srsran_pdsch_nr_free(&q->pdsch[i]);
+  }
   srsran_dmrs_sch_free(&q->dmrs);
 
   srsran_pdcch_nr_free(&q->pdcch);
@@ -140,8 +150,10 @@ void srsran_gnb_dl_free(srsran_gnb_dl_t* q)
 
 int srsran_gnb_dl_set_carrier(srsran_gnb_dl_t* q, const srsran_carrier_nr_t* carrier)
 {
-  if (srsran_pdsch_nr_set_carrier(&q->pdsch, carrier) < SRSRAN_SUCCESS) {
-    return SRSRAN_ERROR;
+  for (uint32_t i = 0; i < q->nof_pdsch_encoders; i++) {
+    if (srsran_pdsch_nr_set_carrier(&q->pdsch[i], carrier) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
   }
 
   if (srsran_dmrs_sch_set_carrier(&q->dmrs, carrier) < SRSRAN_SUCCESS) {
@@ -231,7 +243,7 @@ void srsran_gnb_dl_gen_signal(srsran_gnb_dl_t* q)
     return;
   }
 
-  float norm_factor = gnb_dl_get_norm_factor(q->pdsch.carrier.nof_prb);
+  float norm_factor = gnb_dl_get_norm_factor(q->pdsch[0].carrier.nof_prb);
 
   for (uint32_t i = 0; i < q->nof_tx_antennas; i++) {
     srsran_ofdm_tx_sf(&q->fft[i]);
@@ -333,11 +345,25 @@ int srsran_gnb_dl_pdsch_put(srsran_gnb_dl_t*           q,
                             const srsran_sch_cfg_nr_t* cfg,
                             uint8_t*                   data[SRSRAN_MAX_TB])
 {
+  return srsran_gnb_dl_pdsch_put_encoder(q, 0, slot, cfg, data);
+}
+
+int srsran_gnb_dl_pdsch_put_encoder(srsran_gnb_dl_t*           q,
+                                    uint32_t                   encoder_idx,
+                                    const srsran_slot_cfg_t*   slot,
+                                    const srsran_sch_cfg_nr_t* cfg,
+                                    uint8_t*                   data[SRSRAN_MAX_TB])
+{
+  if (q == NULL || encoder_idx >= q->nof_pdsch_encoders) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // The DMRS object is only read, it can be shared by all the encoders
   if (srsran_dmrs_sch_put_sf(&q->dmrs, slot, cfg, &cfg->grant, q->sf_symbols[0]) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
-  if (srsran_pdsch_nr_encode(&q->pdsch, cfg, &cfg->grant, data, q->sf_symbols) < SRSRAN_SUCCESS) {
+  if (srsran_pdsch_nr_encode(&q->pdsch[encoder_idx], cfg, &cfg->grant, data, q->sf_symbols) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
@@ -345,11 +371,24 @@ int srsran_gnb_dl_pdsch_put(srsran_gnb_dl_t*           q,
 }
 
 int srsran_gnb_dl_pdsch_info(const srsran_gnb_dl_t* q, const srsran_sch_cfg_nr_t* cfg, char* str, uint32_t str_len)
+{
+  return srsran_gnb_dl_pdsch_encoder_info(q, 0, cfg, str, str_len);
+}
+
+int srsran_gnb_dl_pdsch_encoder_info(const srsran_gnb_dl_t*     q,
+                                     uint32_t                   encoder_idx,
+                                     const srsran_sch_cfg_nr_t* cfg,
+                                     char*                      str,
+                                     uint32_t                   str_len)
 {
   int len = 0;
 
+  if (encoder_idx >= q->nof_pdsch_encoders) {
+    return len;
+  }
+
   // Append PDSCH info
-  len += srsran_pdsch_nr_tx_info(&q->pdsch, cfg, &cfg->grant, &str[len], str_len - len);
+  len += srsran_pdsch_nr_tx_info(&q->pdsch[encoder_idx], cfg, &cfg->grant, &str[len], str_len - len);
 
   return len;
 }
@@ -71,6 +71,10 @@
 
 #endif
 
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+#endif
+
 #ifdef LV_HAVE_SSE
 #include <smmintrin.h>
 void demod_16qam_lte_s_sse(const cf_t* symbols, short* llr, int nsymbols);
@@ -86,6 +90,494 @@ void demod_16qam_lte_s_sse(const cf_t* symbols, short* llr, int nsymbols);
 #define SCALE_BYTE_CONV_QAM64 40
 #define SCALE_BYTE_CONV_QAM256 50
 
+/*
+ * Square QAM demapping. The LLR pair (real, imaginary) of stage s is computed from the folded coordinate
+ * D_0 = -y, D_s = |D_(s-1)| - offset[s], where each folding maps the remaining bits onto a PAM with half the levels.
+ *
+ * The simplified demapper outputs D_s directly (Tosato-Bisaglia). The exact max-log LLR of the first bit of a PAM with
+ * M levels is piecewise linear, its slope grows by one at every even multiple of the amplitude A:
+ *
+ *   L(u) = M / 2 * u - sum_(k = 1)^(M / 2 - 1) clamp(u, -2kA, 2kA)
+ *
+ * so the exact max-log LLR of stage s is L(D_s) with M = 2^(nof_stages - s), scaled by 4A / noise variance.
+ *
+ * The stages are bounded to 256QAM. 1024QAM needs a fifth stage, which also widens the SIMD masks and clamp sets.
+ */
+#define DEMOD_SOFT_MAX_STAGES 4
+#define DEMOD_SOFT_MAX_CLAMPS ((1U << (DEMOD_SOFT_MAX_STAGES - 1U)) - 1U)
+
+typedef struct {
+  uint32_t nof_stages;
+  float    offset[DEMOD_SOFT_MAX_STAGES]; // Folding offset of each stage, the first one is not used
+  float    amplitude;                     // Half the distance between adjacent constellation points
+} demod_soft_qam_t;
+
+static const demod_soft_qam_t demod_soft_qam_table[SRSRAN_MOD_NITEMS] = {
+    {1, {0.0f}, 1.0f},                                               // BPSK, not used by the QAM demappers
+    {1, {0.0f}, 0.70710678f},                                        // QPSK
+    {2, {0.0f, 0.63245553f}, 0.31622777f},                           // 16QAM, 2 / sqrt(10)
+    {3, {0.0f, 0.61721340f, 0.30860670f}, 0.15430335f},              // 64QAM, {4, 2} / sqrt(42)
+    {4, {0.0f, 0.61357199f, 0.30678600f, 0.15339300f}, 0.07669650f}, // 256QAM, {8, 4, 2} / sqrt(170)
+};
+
+static inline short demod_soft_sat_s(float x)
+{
+  return (short)lrintf(SRSRAN_MAX(SRSRAN_MIN(x, INT16_MAX), INT16_MIN));
+}
+
+static inline int8_t demod_soft_sat_b(float x)
+{
+  return (int8_t)lrintf(SRSRAN_MAX(SRSRAN_MIN(x, INT8_MAX), INT8_MIN));
+}
+
+static inline float demod_soft_max_log(float u, uint32_t nof_levels, float two_a)
+{
+  float llr = (float)(nof_levels / 2) * u;
+  for (uint32_t k = 1; k < nof_levels / 2; k++) {
+    llr -= SRSRAN_MAX(SRSRAN_MIN(u, k * two_a), -(k * two_a));
+  }
+  return llr;
+}
+
+static inline void
+demod_qam_symbol(const demod_soft_qam_t* q, cf_t symbol, float scale, bool exact, float llr[2 * DEMOD_SOFT_MAX_STAGES])
+{
+  float real = -scale * __real__ symbol;
+  float imag = -scale * __imag__ symbol;
+  for (uint32_t s = 0; s < q->nof_stages; s++) {
+    if (s > 0) {
+      real = fabsf(real) - scale * q->offset[s];
+      imag = fabsf(imag) - scale * q->offset[s];
+    }
+    if (exact) {
+      uint32_t nof_levels = 1U << (q->nof_stages - s);
+      llr[2 * s]          = demod_soft_max_log(real, nof_levels, 2.0f * scale * q->amplitude);
+      llr[2 * s + 1]      = demod_soft_max_log(imag, nof_levels, 2.0f * scale * q->amplitude);
+    } else {
+      llr[2 * s]     = real;
+      llr[2 * s + 1] = imag;
+    }
+  }
+}
+
+static void
+demod_qam_gen(const demod_soft_qam_t* q, const cf_t* symbols, float* llr, int nsymbols, float scale, bool exact)
+{
+  for (int i = 0; i < nsymbols; i++) {
+    demod_qam_symbol(q, symbols[i], scale, exact, &llr[2 * q->nof_stages * i]);
+  }
+}
+
+static void
+demod_qam_gen_s(const demod_soft_qam_t* q, const cf_t* symbols, short* llr, int nsymbols, float scale, bool exact)
+{
+  float tmp[2 * DEMOD_SOFT_MAX_STAGES];
+  for (int i = 0; i < nsymbols; i++) {
+    demod_qam_symbol(q, symbols[i], scale, exact, tmp);
+    for (uint32_t j = 0; j < 2 * q->nof_stages; j++) {
+      *(llr++) = demod_soft_sat_s(tmp[j]);
+    }
+  }
+}
+
+static void
+demod_qam_gen_b(const demod_soft_qam_t* q, const cf_t* symbols, int8_t* llr, int nsymbols, float scale, bool exact)
+{
+  float tmp[2 * DEMOD_SOFT_MAX_STAGES];
+  for (int i = 0; i < nsymbols; i++) {
+    demod_qam_symbol(q, symbols[i], scale, exact, tmp);
+    for (uint32_t j = 0; j < 2 * q->nof_stages; j++) {
+      *(llr++) = demod_soft_sat_b(tmp[j]);
+    }
+  }
+}
+
+/*
+ * The SIMD demappers process blocks of W symbols. The foldings and max-log clamps are computed for all the symbol
+ * coordinates of a stage at once, then the stages are interleaved into nof_stages registers holding the LLR of the
+ * block in memory order. Register k holds the LLR pairs m = k * W + l, l < W, which belong to symbol m / nof_stages and
+ * stage m % nof_stages.
+ */
+static inline void demod_qam_lane_cfg(const demod_soft_qam_t* q, uint32_t k, uint32_t l, uint32_t w, int32_t* idx, uint32_t* stage)
+{
+  uint32_t m = k * w + l / 2;
+  *idx       = (int32_t)(2 * (m / q->nof_stages) + l % 2);
+  *stage     = m % q->nof_stages;
+}
+
+// The number of stages is passed as a constant so that the stage loops get unrolled
+#define DEMOD_QAM_SIMD_DISPATCH(RUN, V, Q, EXACT, SYMBOLS, LLR, NSYMBOLS)                                              \
+  ((Q)->nof_stages == 1   ? RUN(V, 1, EXACT, SYMBOLS, LLR, NSYMBOLS)                                                  \
+   : (Q)->nof_stages == 2 ? RUN(V, 2, EXACT, SYMBOLS, LLR, NSYMBOLS)                                                  \
+   : (Q)->nof_stages == 3 ? RUN(V, 3, EXACT, SYMBOLS, LLR, NSYMBOLS)                                                  \
+                          : RUN(V, 4, EXACT, SYMBOLS, LLR, NSYMBOLS))
+
+#ifdef LV_HAVE_AVX512
+
+#define DEMOD_SOFT_AVX512_W 8
+
+typedef struct {
+  __m512i   perm[DEMOD_SOFT_MAX_STAGES];
+  __mmask16 mask[DEMOD_SOFT_MAX_STAGES][DEMOD_SOFT_MAX_STAGES];
+  __m512    offset[DEMOD_SOFT_MAX_STAGES];
+  __m512    gain[DEMOD_SOFT_MAX_STAGES];
+  __m512    bound[DEMOD_SOFT_MAX_CLAMPS];
+  __m512    neg_bound[DEMOD_SOFT_MAX_CLAMPS];
+  __m512    scale;
+} demod_soft_avx512_t;
+
+static void demod_qam_avx512_init(demod_soft_avx512_t* v, const demod_soft_qam_t* q, float scale)
+{
+  for (uint32_t k = 0; k < q->nof_stages; k++) {
+    int32_t idx[2 * DEMOD_SOFT_AVX512_W];
+    for (uint32_t s = 0; s < q->nof_stages; s++) {
+      v->mask[k][s] = 0;
+    }
+    for (uint32_t l = 0; l < 2 * DEMOD_SOFT_AVX512_W; l++) {
+      uint32_t stage;
+      demod_qam_lane_cfg(q, k, l, DEMOD_SOFT_AVX512_W, &idx[l], &stage);
+      v->mask[k][stage] |= (__mmask16)(1U << l);
+    }
+    v->perm[k]   = _mm512_loadu_si512(idx);
+    v->offset[k] = _mm512_set1_ps(scale * q->offset[k]);
+    v->gain[k]   = _mm512_set1_ps((float)(1U << (q->nof_stages - k - 1)));
+  }
+  for (uint32_t c = 0; c < DEMOD_SOFT_MAX_CLAMPS; c++) {
+    v->bound[c]     = _mm512_set1_ps((c + 1) * 2.0f * scale * q->amplitude);
+    v->neg_bound[c] = _mm512_set1_ps(-(float)(c + 1) * 2.0f * scale * q->amplitude);
+  }
+  v->scale = _mm512_set1_ps(-scale);
+}
+
+static inline void demod_qam_avx512_block(const demod_soft_avx512_t* v,
+                                          uint32_t                   nof_stages,
+                                          bool                       exact,
+                                          const cf_t*                symbols,
+                                          __m512                     llr[DEMOD_SOFT_MAX_STAGES])
+{
+  __m512 stage[DEMOD_SOFT_MAX_STAGES];
+  __m512 u = _mm512_mul_ps(_mm512_loadu_ps((const float*)symbols), v->scale);
+  for (uint32_t s = 0; s < nof_stages; s++) {
+    if (s > 0) {
+      u = _mm512_sub_ps(_mm512_abs_ps(u), v->offset[s]);
+    }
+    stage[s] = u;
+    if (exact) {
+      stage[s] = _mm512_mul_ps(u, v->gain[s]);
+      for (uint32_t c = 0; c + 1 < (1U << (nof_stages - s - 1)); c++) {
+        stage[s] = _mm512_sub_ps(stage[s], _mm512_max_ps(_mm512_min_ps(u, v->bound[c]), v->neg_bound[c]));
+      }
+    }
+  }
+  for (uint32_t k = 0; k < nof_stages; k++) {
+    llr[k] = _mm512_permutexvar_ps(v->perm[k], stage[0]);
+    for (uint32_t s = 1; s < nof_stages; s++) {
+      llr[k] = _mm512_mask_permutexvar_ps(llr[k], v->mask[k][s], v->perm[k], stage[s]);
+    }
+  }
+}
+
+static inline int demod_qam_avx512_run(const demod_soft_avx512_t* v,
+                                       uint32_t                   nof_stages,
+                                       bool                       exact,
+                                       const cf_t*                symbols,
+                                       float*                     llr,
+                                       int                        nsymbols)
+{
+  int i = 0;
+  for (; i + DEMOD_SOFT_AVX512_W <= nsymbols; i += DEMOD_SOFT_AVX512_W) {
+    __m512 out[DEMOD_SOFT_MAX_STAGES];
+    demod_qam_avx512_block(v, nof_stages, exact, &symbols[i], out);
+    for (uint32_t k = 0; k < nof_stages; k++) {
+      _mm512_storeu_ps(&llr[2 * (i * nof_stages + k * DEMOD_SOFT_AVX512_W)], out[k]);
+    }
+  }
+  return i;
+}
+
+static inline int demod_qam_avx512_run_s(const demod_soft_avx512_t* v,
+                                         uint32_t                   nof_stages,
+                                         bool                       exact,
+                                         const cf_t*                symbols,
+                                         short*                     llr,
+                                         int                        nsymbols)
+{
+  int i = 0;
+  for (; i + DEMOD_SOFT_AVX512_W <= nsymbols; i += DEMOD_SOFT_AVX512_W) {
+    __m512 out[DEMOD_SOFT_MAX_STAGES];
+    demod_qam_avx512_block(v, nof_stages, exact, &symbols[i], out);
+    for (uint32_t k = 0; k < nof_stages; k++) {
+      _mm256_storeu_si256((__m256i*)&llr[2 * (i * nof_stages + k * DEMOD_SOFT_AVX512_W)],
+                          _mm512_cvtsepi32_epi16(_mm512_cvtps_epi32(out[k])));
+    }
+  }
+  return i;
+}
+
+static inline int demod_qam_avx512_run_b(const demod_soft_avx512_t* v,
+                                         uint32_t                   nof_stages,
+                                         bool                       exact,
+                                         const cf_t*                symbols,
+                                         int8_t*                    llr,
+                                         int                        nsymbols)
+{
+  int i = 0;
+  for (; i + DEMOD_SOFT_AVX512_W <= nsymbols; i += DEMOD_SOFT_AVX512_W) {
+    __m512 out[DEMOD_SOFT_MAX_STAGES];
+    demod_qam_avx512_block(v, nof_stages, exact, &symbols[i], out);
+    for (uint32_t k = 0; k < nof_stages; k++) {
+      _mm_storeu_si128((__m128i*)&llr[2 * (i * nof_stages + k * DEMOD_SOFT_AVX512_W)],
+                       _mm512_cvtsepi32_epi8(_mm512_cvtps_epi32(out[k])));
+    }
+  }
+  return i;
+}
+
+static void demod_qam_avx512(const demod_soft_qam_t* q,
+                             const cf_t*             symbols,
+                             float*                  llr,
+                             int                     nsymbols,
+                             float                   scale,
+                             bool                    exact)
+{
+  demod_soft_avx512_t v;
+  demod_qam_avx512_init(&v, q, scale);
+  int i = DEMOD_QAM_SIMD_DISPATCH(demod_qam_avx512_run, &v, q, exact, symbols, llr, nsymbols);
+  demod_qam_gen(q, &symbols[i], &llr[2 * i * q->nof_stages], nsymbols - i, scale, exact);
+}
+
+static void demod_qam_avx512_s(const demod_soft_qam_t* q,
+                               const cf_t*             symbols,
+                               short*                  llr,
+                               int                     nsymbols,
+                               float                   scale,
+                               bool                    exact)
+{
+  demod_soft_avx512_t v;
+  demod_qam_avx512_init(&v, q, scale);
+  int i = DEMOD_QAM_SIMD_DISPATCH(demod_qam_avx512_run_s, &v, q, exact, symbols, llr, nsymbols);
+  demod_qam_gen_s(q, &symbols[i], &llr[2 * i * q->nof_stages], nsymbols - i, scale, exact);
+}
+
+static void demod_qam_avx512_b(const demod_soft_qam_t* q,
+                               const cf_t*             symbols,
+                               int8_t*                 llr,
+                               int                     nsymbols,
+                               float                   scale,
+                               bool                    exact)
+{
+  demod_soft_avx512_t v;
+  demod_qam_avx512_init(&v, q, scale);
+  int i = DEMOD_QAM_SIMD_DISPATCH(demod_qam_avx512_run_b, &v, q, exact, symbols, llr, nsymbols);
+  demod_qam_gen_b(q, &symbols[i], &llr[2 * i * q->nof_stages], nsymbols - i, scale, exact);
+}
+
+#endif /* LV_HAVE_AVX512 */
+
+#if defined(LV_HAVE_AVX2) && !defined(LV_HAVE_AVX512)
+
+#define DEMOD_SOFT_AVX2_W 4
+
+typedef struct {
+  __m256i perm[DEMOD_SOFT_MAX_STAGES];
+  __m256  mask[DEMOD_SOFT_MAX_STAGES][DEMOD_SOFT_MAX_STAGES];
+  __m256  offset[DEMOD_SOFT_MAX_STAGES];
+  __m256  gain[DEMOD_SOFT_MAX_STAGES];
+  __m256  bound[DEMOD_SOFT_MAX_CLAMPS];
+  __m256  neg_bound[DEMOD_SOFT_MAX_CLAMPS];
+  __m256  scale;
+  __m256  abs_mask;
+} demod_soft_avx2_t;
+
+static void demod_qam_avx2_init(demod_soft_avx2_t* v, const demod_soft_qam_t* q, float scale)
+{
+  for (uint32_t k = 0; k < q->nof_stages; k++) {
+    int32_t idx[2 * DEMOD_SOFT_AVX2_W];
+    int32_t mask[DEMOD_SOFT_MAX_STAGES][2 * DEMOD_SOFT_AVX2_W] = {};
+    for (uint32_t l = 0; l < 2 * DEMOD_SOFT_AVX2_W; l++) {
+      uint32_t stage;
+      demod_qam_lane_cfg(q, k, l, DEMOD_SOFT_AVX2_W, &idx[l], &stage);
+      mask[stage][l] = -1;
+    }
+    v->perm[k] = _mm256_loadu_si256((__m256i*)idx);
+    for (uint32_t s = 0; s < q->nof_stages; s++) {
+      v->mask[k][s] = _mm256_castsi256_ps(_mm256_loadu_si256((__m256i*)mask[s]));
+    }
+    v->offset[k] = _mm256_set1_ps(scale * q->offset[k]);
+    v->gain[k]   = _mm256_set1_ps((float)(1U << (q->nof_stages - k - 1)));
+  }
+  for (uint32_t c = 0; c < DEMOD_SOFT_MAX_CLAMPS; c++) {
+    v->bound[c]     = _mm256_set1_ps((c + 1) * 2.0f * scale * q->amplitude);
+    v->neg_bound[c] = _mm256_set1_ps(-(float)(c + 1) * 2.0f * scale * q->amplitude);
+  }
+  v->scale    = _mm256_set1_ps(-scale);
+  v->abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+}
+
+static inline void demod_qam_avx2_block(const demod_soft_avx2_t* v,
+                                        uint32_t                 nof_stages,
+                                        bool                     exact,
+                                        const cf_t*              symbols,
+                                        __m256                   llr[DEMOD_SOFT_MAX_STAGES])
+{
+  __m256 stage[DEMOD_SOFT_MAX_STAGES];
+  __m256 u = _mm256_mul_ps(_mm256_loadu_ps((const float*)symbols), v->scale);
+  for (uint32_t s = 0; s < nof_stages; s++) {
+    if (s > 0) {
+      u = _mm256_sub_ps(_mm256_and_ps(u, v->abs_mask), v->offset[s]);
+    }
+    stage[s] = u;
+    if (exact) {
+      stage[s] = _mm256_mul_ps(u, v->gain[s]);
+      for (uint32_t c = 0; c + 1 < (1U << (nof_stages - s - 1)); c++) {
+        stage[s] = _mm256_sub_ps(stage[s], _mm256_max_ps(_mm256_min_ps(u, v->bound[c]), v->neg_bound[c]));
+      }
+    }
+  }
+  for (uint32_t k = 0; k < nof_stages; k++) {
+    llr[k] = _mm256_permutevar8x32_ps(stage[0], v->perm[k]);
+    for (uint32_t s = 1; s < nof_stages; s++) {
+      llr[k] = _mm256_blendv_ps(llr[k], _mm256_permutevar8x32_ps(stage[s], v->perm[k]), v->mask[k][s]);
+    }
+  }
+}
+
+static inline int demod_qam_avx2_run(const demod_soft_avx2_t* v,
+                                     uint32_t                 nof_stages,
+                                     bool                     exact,
+                                     const cf_t*              symbols,
+                                     float*                   llr,
+                                     int                      nsymbols)
+{
+  int i = 0;
+  for (; i + DEMOD_SOFT_AVX2_W <= nsymbols; i += DEMOD_SOFT_AVX2_W) {
+    __m256 out[DEMOD_SOFT_MAX_STAGES];
+    demod_qam_avx2_block(v, nof_stages, exact, &symbols[i], out);
+    for (uint32_t k = 0; k < nof_stages; k++) {
+      _mm256_storeu_ps(&llr[2 * (i * nof_stages + k * DEMOD_SOFT_AVX2_W)], out[k]);
+    }
+  }
+  return i;
+}
+
+static inline int demod_qam_avx2_run_s(const demod_soft_avx2_t* v,
+                                       uint32_t                 nof_stages,
+                                       bool                     exact,
+                                       const cf_t*              symbols,
+                                       short*                   llr,
+                                       int                      nsymbols)
+{
+  int i = 0;
+  for (; i + DEMOD_SOFT_AVX2_W <= nsymbols; i += DEMOD_SOFT_AVX2_W) {
+    __m256 out[DEMOD_SOFT_MAX_STAGES];
+    demod_qam_avx2_block(v, nof_stages, exact, &symbols[i], out);
+    for (uint32_t k = 0; k < nof_stages; k++) {
+      // Saturate to 16 bit, the pack works within each 128 bit lane
+      __m256i llr_i = _mm256_cvtps_epi32(out[k]);
+      llr_i         = _mm256_permute4x64_epi64(_mm256_packs_epi32(llr_i, llr_i), 0x08);
+      _mm_storeu_si128((__m128i*)&llr[2 * (i * nof_stages + k * DEMOD_SOFT_AVX2_W)], _mm256_castsi256_si128(llr_i));
+    }
+  }
+  return i;
+}
+
+static inline int demod_qam_avx2_run_b(const demod_soft_avx2_t* v,
+                                       uint32_t                 nof_stages,
+                                       bool                     exact,
+                                       const cf_t*              symbols,
+                                       int8_t*                  llr,
+                                       int                      nsymbols)
+{
+  const __m256i gather = _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0);
+
+  int i = 0;
+  for (; i + DEMOD_SOFT_AVX2_W <= nsymbols; i += DEMOD_SOFT_AVX2_W) {
+    __m256 out[DEMOD_SOFT_MAX_STAGES];
+    demod_qam_avx2_block(v, nof_stages, exact, &symbols[i], out);
+    for (uint32_t k = 0; k < nof_stages; k++) {
+      // Saturate to 8 bit, the packs work within each 128 bit lane
+      __m256i llr_i = _mm256_cvtps_epi32(out[k]);
+      llr_i         = _mm256_packs_epi32(llr_i, llr_i);
+      llr_i         = _mm256_packs_epi16(llr_i, llr_i);
+      llr_i         = _mm256_permutevar8x32_epi32(llr_i, gather);
+      _mm_storel_epi64((__m128i*)&llr[2 * (i * nof_stages + k * DEMOD_SOFT_AVX2_W)], _mm256_castsi256_si128(llr_i));
+    }
+  }
+  return i;
+}
+
+static void
+demod_qam_avx2(const demod_soft_qam_t* q, const cf_t* symbols, float* llr, int nsymbols, float scale, bool exact)
+{
+  demod_soft_avx2_t v;
+  demod_qam_avx2_init(&v, q, scale);
+  int i = DEMOD_QAM_SIMD_DISPATCH(demod_qam_avx2_run, &v, q, exact, symbols, llr, nsymbols);
+  demod_qam_gen(q, &symbols[i], &llr[2 * i * q->nof_stages], nsymbols - i, scale, exact);
+}
+
+static void
+demod_qam_avx2_s(const demod_soft_qam_t* q, const cf_t* symbols, short* llr, int nsymbols, float scale, bool exact)
+{
+  demod_soft_avx2_t v;
+  demod_qam_avx2_init(&v, q, scale);
+  int i = DEMOD_QAM_SIMD_DISPATCH(demod_qam_avx2_run_s, &v, q, exact, symbols, llr, nsymbols);
+  demod_qam_gen_s(q, &symbols[i], &llr[2 * i * q->nof_stages], nsymbols - i, scale, exact);
+}
+
+static void
+demod_qam_avx2_b(const demod_soft_qam_t* q, const cf_t* symbols, int8_t* llr, int nsymbols, float scale, bool exact)
+{
+  demod_soft_avx2_t v;
+  demod_qam_avx2_init(&v, q, scale);
+  int i = DEMOD_QAM_SIMD_DISPATCH(demod_qam_avx2_run_b, &v, q, exact, symbols, llr, nsymbols);
+  demod_qam_gen_b(q, &symbols[i], &llr[2 * i * q->nof_stages], nsymbols - i, scale, exact);
+}
+#endif /* LV_HAVE_AVX2 && !LV_HAVE_AVX512 */
+
+static void demod_qam(srsran_mod_t modulation, const cf_t* symbols, float* llr, int nsymbols, float scale, bool exact)
+{
+  const demod_soft_qam_t* q = &demod_soft_qam_table[modulation];
+#ifdef LV_HAVE_AVX512
+  demod_qam_avx512(q, symbols, llr, nsymbols, scale, exact);
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  demod_qam_avx2(q, symbols, llr, nsymbols, scale, exact);
+#else  /* LV_HAVE_AVX2 */
+  demod_qam_gen(q, symbols, llr, nsymbols, scale, exact);
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
+static void
+demod_qam_s(srsran_mod_t modulation, const cf_t* symbols, short* llr, int nsymbols, float scale, bool exact)
+{
+  const demod_soft_qam_t* q = &demod_soft_qam_table[modulation];
+#ifdef LV_HAVE_AVX512
+  demod_qam_avx512_s(q, symbols, llr, nsymbols, scale, exact);
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  demod_qam_avx2_s(q, symbols, llr, nsymbols, scale, exact);
+#else  /* LV_HAVE_AVX2 */
+  demod_qam_gen_s(q, symbols, llr, nsymbols, scale, exact);
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
+static void
+demod_qam_b(srsran_mod_t modulation, const cf_t* symbols, int8_t* llr, int nsymbols, float scale, bool exact)
+{
+  const demod_soft_qam_t* q = &demod_soft_qam_table[modulation];
+#ifdef LV_HAVE_AVX512
+  demod_qam_avx512_b(q, symbols, llr, nsymbols, scale, exact);
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  demod_qam_avx2_b(q, symbols, llr, nsymbols, scale, exact);
+#else  /* LV_HAVE_AVX2 */
+  demod_qam_gen_b(q, symbols, llr, nsymbols, scale, exact);
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
 void demod_bpsk_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
 {
   for (int i = 0; i < nsymbols; i++) {
@@ -124,6 +616,9 @@ void demod_qpsk_lte(const cf_t* symbols, float* llr, int nsymbols)
 
 void demod_16qam_lte(const cf_t* symbols, float* llr, int nsymbols)
 {
+#ifdef LV_HAVE_AVX2
+  demod_qam(SRSRAN_MOD_16QAM, symbols, llr, nsymbols, 1.0f, false);
+#else
   for (int i = 0; i < nsymbols; i++) {
     float yre = crealf(symbols[i]);
     float yim = cimagf(symbols[i]);
@@ -133,6 +628,7 @@ void demod_16qam_lte(const cf_t* symbols, float* llr, int nsymbols)
     llr[4 * i + 2] = fabsf(yre) - 2 / sqrtf(10);
     llr[4 * i + 3] = fabsf(yim) - 2 / sqrtf(10);
   }
+#endif
 }
 
 #ifdef HAVE_NEONv8
@@ -362,6 +858,9 @@ void demod_16qam_lte_b_sse(const cf_t* symbols, int8_t* llr, int nsymbols)
 
 void demod_16qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
 {
+#ifdef LV_HAVE_AVX2
+  demod_qam_s(SRSRAN_MOD_16QAM, symbols, llr, nsymbols, SCALE_SHORT_CONV_QAM16, false);
+#else
 #ifdef LV_HAVE_SSE
   demod_16qam_lte_s_sse(symbols, llr, nsymbols);
 #else
@@ -379,10 +878,14 @@ void demod_16qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
   }
 #endif
 #endif
+#endif
 }
 
 void demod_16qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
 {
+#ifdef LV_HAVE_AVX2
+  demod_qam_b(SRSRAN_MOD_16QAM, symbols, llr, nsymbols, SCALE_BYTE_CONV_QAM16, false);
+#else
 #ifdef LV_HAVE_SSE
   demod_16qam_lte_b_sse(symbols, llr, nsymbols);
 #else
@@ -400,10 +903,14 @@ void demod_16qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
   }
 #endif
 #endif
+#endif
 }
 
 void demod_64qam_lte(const cf_t* symbols, float* llr, int nsymbols)
 {
+#ifdef LV_HAVE_AVX2
+  demod_qam(SRSRAN_MOD_64QAM, symbols, llr, nsymbols, 1.0f, false);
+#else
   for (int i = 0; i < nsymbols; i++) {
     float yre = crealf(symbols[i]);
     float yim = cimagf(symbols[i]);
@@ -415,6 +922,7 @@ void demod_64qam_lte(const cf_t* symbols, float* llr, int nsymbols)
     llr[6 * i + 4] = fabsf(llr[6 * i + 2]) - 2 / sqrtf(42);
     llr[6 * i + 5] = fabsf(llr[6 * i + 3]) - 2 / sqrtf(42);
   }
+#endif
 }
 #ifdef HAVE_NEONv8
 
@@ -564,7 +1072,7 @@ void demod_64qam_lte_b_neon(const cf_t* symbols, int8_t* llr, int nsymbols)
 
 #endif
 
-#ifdef LV_HAVE_SSE
+#if defined(LV_HAVE_SSE) && !defined(LV_HAVE_AVX2)
 
 static void demod_64qam_lte_s_sse(const cf_t* symbols, int16_t* llr, int nsymbols)
 {
@@ -643,6 +1151,10 @@ static void demod_64qam_lte_s_sse(const cf_t* symbols, int16_t* llr, int nsymbol
   }
 }
 
+#endif /* LV_HAVE_SSE && !LV_HAVE_AVX2 */
+
+#ifdef LV_HAVE_SSE
+
 void demod_64qam_lte_b_sse(const cf_t* symbols, int8_t* llr, int nsymbols)
 {
   float*   symbolsPtr = (float*)symbols;
@@ -733,6 +1245,9 @@ void demod_64qam_lte_b_sse(const cf_t* symbols, int8_t* llr, int nsymbols)
 
 void demod_64qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
 {
+#ifdef LV_HAVE_AVX2
+  demod_qam_s(SRSRAN_MOD_64QAM, symbols, llr, nsymbols, SCALE_SHORT_CONV_QAM64, false);
+#else
 #ifdef LV_HAVE_SSE
   demod_64qam_lte_s_sse(symbols, llr, nsymbols);
 #else
@@ -752,10 +1267,14 @@ void demod_64qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
   }
 #endif
 #endif
+#endif
 }
 
 void demod_64qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
 {
+#ifdef LV_HAVE_AVX2
+  demod_qam_b(SRSRAN_MOD_64QAM, symbols, llr, nsymbols, SCALE_BYTE_CONV_QAM64, false);
+#else
 #ifdef LV_HAVE_SSE
   demod_64qam_lte_b_sse(symbols, llr, nsymbols);
 #else
@@ -775,10 +1294,14 @@ void demod_64qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
   }
 #endif
 #endif
+#endif
 }
 
 void demod_256qam_lte(const cf_t* symbols, float* llr, int nsymbols)
 {
+#ifdef LV_HAVE_AVX2
+  demod_qam(SRSRAN_MOD_256QAM, symbols, llr, nsymbols, 1.0f, false);
+#else
   for (int i = 0; i < nsymbols; i++) {
     float real = -__real__ symbols[i];
     float imag = -__imag__ symbols[i];
@@ -797,10 +1320,14 @@ void demod_256qam_lte(const cf_t* symbols, float* llr, int nsymbols)
     *(llr++)   = real;
     *(llr++)   = imag;
   }
+#endif
 }
 
 void demod_256qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
 {
+#ifdef LV_HAVE_AVX2
+  demod_qam_b(SRSRAN_MOD_256QAM, symbols, llr, nsymbols, SCALE_BYTE_CONV_QAM256, false);
+#else
   for (int i = 0; i < nsymbols; i++) {
     float real = -__real__ symbols[i];
     float imag = -__imag__ symbols[i];
@@ -819,10 +1346,14 @@ void demod_256qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
     *(llr++)   = SCALE_BYTE_CONV_QAM256 * real;
     *(llr++)   = SCALE_BYTE_CONV_QAM256 * imag;
   }
+#endif
 }
 
 void demod_256qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
 {
+#ifdef LV_HAVE_AVX2
+  demod_qam_s(SRSRAN_MOD_256QAM, symbols, llr, nsymbols, SCALE_SHORT_CONV_QAM256, false);
+#else
   for (int i = 0; i < nsymbols; i++) {
     float real = -__real__ symbols[i];
     float imag = -__imag__ symbols[i];
@@ -841,6 +1372,7 @@ void demod_256qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
     *(llr++)   = SCALE_SHORT_CONV_QAM256 * real;
     *(llr++)   = SCALE_SHORT_CONV_QAM256 * imag;
   }
+#endif
 }
 
 int srsran_demod_soft_demodulate(srsran_mod_t modulation, const cf_t* symbols, float* llr, int nsymbols)
@@ -917,3 +1449,79 @@ int srsran_demod_soft_demodulate_b(srsran_mod_t modulation, const cf_t* symbols,
   }
   return 0;
 }
+
+static int demod_soft_scale(srsran_mod_t modulation, float noise_var, float* scale)
+{
+  if (modulation >= SRSRAN_MOD_NITEMS || !isnormal(noise_var) || noise_var < 0.0f) {
+    ERROR("Invalid modulation %d or noise variance %f", modulation, noise_var);
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+  *scale = 4.0f * demod_soft_qam_table[modulation].amplitude / noise_var;
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_demod_soft_demodulate_scaled(srsran_mod_t modulation,
+                                        const cf_t*  symbols,
+                                        float*       llr,
+                                        int          nsymbols,
+                                        float        noise_var)
+{
+  float scale = 0.0f;
+  if (demod_soft_scale(modulation, noise_var, &scale) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (modulation == SRSRAN_MOD_BPSK) {
+    for (int i = 0; i < nsymbols; i++) {
+      llr[i] = -scale * (crealf(symbols[i]) + cimagf(symbols[i])) * M_SQRT1_2;
+    }
+    return SRSRAN_SUCCESS;
+  }
+
+  demod_qam(modulation, symbols, llr, nsymbols, scale, true);
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_demod_soft_demodulate_scaled_s(srsran_mod_t modulation,
+                                          const cf_t*  symbols,
+                                          short*       llr,
+                                          int          nsymbols,
+                                          float        noise_var)
+{
+  float scale = 0.0f;
+  if (demod_soft_scale(modulation, noise_var, &scale) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (modulation == SRSRAN_MOD_BPSK) {
+    for (int i = 0; i < nsymbols; i++) {
+      llr[i] = demod_soft_sat_s(-scale * (crealf(symbols[i]) + cimagf(symbols[i])) * M_SQRT1_2);
+    }
+    return SRSRAN_SUCCESS;
+  }
+
+  demod_qam_s(modulation, symbols, llr, nsymbols, scale, true);
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_demod_soft_demodulate_scaled_b(srsran_mod_t modulation,
+                                          const cf_t*  symbols,
+                                          int8_t*      llr,
+                                          int          nsymbols,
+                                          float        noise_var)
+{
+  float scale = 0.0f;
+  if (demod_soft_scale(modulation, noise_var, &scale) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (modulation == SRSRAN_MOD_BPSK) {
+    for (int i = 0; i < nsymbols; i++) {
+      llr[i] = demod_soft_sat_b(-scale * (crealf(symbols[i]) + cimagf(symbols[i])) * M_SQRT1_2);
+    }
+    return SRSRAN_SUCCESS;
+  }
+
+  demod_qam_b(modulation, symbols, llr, nsymbols, scale, true);
+  return SRSRAN_SUCCESS;
+}
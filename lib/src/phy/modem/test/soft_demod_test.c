@@ -33,23 +33,28 @@
 static uint32_t     nof_frames = 10;
 static uint32_t     num_bits   = 1000;
 static srsran_mod_t modulation = SRSRAN_MOD_NITEMS;
+static float        snr_db     = 20.0f;
 
 void usage(char* prog)
 {
-  printf("Usage: %s [nfv] -m modulation (1: BPSK, 2: QPSK, 4: QAM16, 6: QAM64)\n", prog);
+  printf("Usage: %s [nfsv] -m modulation (1: BPSK, 2: QPSK, 4: QAM16, 6: QAM64, 8: QAM256)\n", prog);
   printf("\t-n num_bits [Default %d]\n", num_bits);
   printf("\t-f nof_frames [Default %d]\n", nof_frames);
+  printf("\t-s SNR in dB for the comparison against the exact LLR [Default %.1f]\n", snr_db);
   printf("\t-v srsran_verbose [Default None]\n");
 }
 
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "nmvf")) != -1) {
+  while ((opt = getopt(argc, argv, "nmvfs")) != -1) {
     switch (opt) {
       case 'n':
         num_bits = (uint32_t)strtol(argv[optind], NULL, 10);
         break;
+      case 's':
+        snr_db = strtof(argv[optind], NULL);
+        break;
       case 'f':
         nof_frames = (uint32_t)strtol(argv[optind], NULL, 10);
         break;
@@ -75,7 +80,7 @@ void parse_args(int argc, char** argv)
             break;
           default:
             ERROR("Invalid modulation %d. Possible values: "
-                  "(1: BPSK, 2: QPSK, 4: QAM16, 6: QAM64)",
+                  "(1: BPSK, 2: QPSK, 4: QAM16, 6: QAM64, 8: QAM256)",
                   (int)strtol(argv[optind], NULL, 10));
             break;
         }
@@ -109,6 +114,26 @@ float mse_threshold()
   }
 }
 
+/* Exact max-log LLR, positive when the bit is more likely to be 1 */
+static void demod_max_log(const srsran_modem_table_t* mod,
+                          const cf_t*                 symbols,
+                          float*                      llr,
+                          uint32_t                    nsymbols,
+                          float                       noise_var)
+{
+  for (uint32_t i = 0; i < nsymbols; i++) {
+    for (uint32_t b = 0; b < mod->nbits_x_symbol; b++) {
+      float dist[2] = {INFINITY, INFINITY};
+      for (uint32_t idx = 0; idx < mod->nsymbols; idx++) {
+        uint32_t bit = (idx >> (mod->nbits_x_symbol - 1 - b)) & 1U;
+        float    d   = cabsf(symbols[i] - mod->symbol_table[idx]);
+        dist[bit]    = SRSRAN_MIN(dist[bit], d * d);
+      }
+      llr[i * mod->nbits_x_symbol + b] = (dist[0] - dist[1]) / noise_var;
+    }
+  }
+}
+
 int main(int argc, char** argv)
 {
   int                  i;
@@ -118,6 +143,7 @@ int main(int argc, char** argv)
   float*               llr;
   short*               llr_s;
   int8_t*              llr_b;
+  float*               llr_ref;
 
   parse_args(argc, argv);
 
@@ -165,6 +191,12 @@ int main(int argc, char** argv)
     exit(-1);
   }
 
+  llr_ref = srsran_vec_f_malloc(num_bits);
+  if (!llr_ref) {
+    perror("malloc");
+    exit(-1);
+  }
+
   /* generate random data */
   srand(0);
 
@@ -173,6 +205,12 @@ int main(int argc, char** argv)
   float          mean_texec   = 0.0;
   float          mean_texec_s = 0.0;
   float          mean_texec_b = 0.0;
+  float          scaled_texec   = 0.0;
+  float          scaled_texec_s = 0.0;
+  float          scaled_texec_b = 0.0;
+  float          noise_var      = srsran_convert_dB_to_power(-snr_db);
+  double         err_pow        = 0.0;
+  double         ref_pow        = 0.0;
   for (int n = 0; n < nof_frames; n++) {
     for (i = 0; i < num_bits; i++) {
       input[i] = rand() % 2;
@@ -232,11 +270,69 @@ int main(int argc, char** argv)
         printf("Error in bit %d\n", i);
         goto clean_exit;
       }
+      if (input[i] != (llr_s[i] > 0 ? 1 : 0) || input[i] != (llr_b[i] > 0 ? 1 : 0)) {
+        printf("Error in fixed point bit %d\n", i);
+        goto clean_exit;
+      }
     }
+
+    // Demodulate with noise variance scaling and compare against the exact max-log LLR
+    srsran_ch_awgn_c(symbols, symbols, noise_var, num_bits / mod.nbits_x_symbol);
+
+    gettimeofday(&t[1], NULL);
+    srsran_demod_soft_demodulate_scaled(modulation, symbols, llr, num_bits / mod.nbits_x_symbol, noise_var);
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+
+    if (n > 0) {
+      scaled_texec = SRSRAN_VEC_CMA((float)t[0].tv_usec, scaled_texec, n - 1);
+    }
+
+    gettimeofday(&t[1], NULL);
+    srsran_demod_soft_demodulate_scaled_s(modulation, symbols, llr_s, num_bits / mod.nbits_x_symbol, noise_var);
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+
+    if (n > 0) {
+      scaled_texec_s = SRSRAN_VEC_CMA((float)t[0].tv_usec, scaled_texec_s, n - 1);
+    }
+
+    gettimeofday(&t[1], NULL);
+    srsran_demod_soft_demodulate_scaled_b(modulation, symbols, llr_b, num_bits / mod.nbits_x_symbol, noise_var);
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+
+    if (n > 0) {
+      scaled_texec_b = SRSRAN_VEC_CMA((float)t[0].tv_usec, scaled_texec_b, n - 1);
+    }
+
+    demod_max_log(&mod, symbols, llr_ref, num_bits / mod.nbits_x_symbol, noise_var);
+
+    for (int i = 0; i < num_bits; i++) {
+      err_pow += (llr[i] - llr_ref[i]) * (llr[i] - llr_ref[i]);
+      ref_pow += llr_ref[i] * llr_ref[i];
+
+      // The fixed point LLR are the rounded and saturated floating point ones
+      float llr_sat_s = SRSRAN_MAX(SRSRAN_MIN(llr[i], INT16_MAX), INT16_MIN);
+      float llr_sat_b = SRSRAN_MAX(SRSRAN_MIN(llr[i], INT8_MAX), INT8_MIN);
+      if (fabsf(llr_s[i] - llr_sat_s) > 1.0f || fabsf(llr_b[i] - llr_sat_b) > 1.0f) {
+        printf("Error in fixed point LLR %d (%f, %d, %d)\n", i, llr[i], llr_s[i], llr_b[i]);
+        goto clean_exit;
+      }
+    }
+  }
+
+  // The scaled demodulator computes the exact max-log LLR, only the floating point error is tolerated
+  float nmse = (float)(err_pow / ref_pow);
+  printf("NMSE against the exact max-log LLR at %.1f dB: %e\n", snr_db, nmse);
+  if (!(nmse < 1e-9f)) {
+    printf("NMSE exceeds the tolerance\n");
+    goto clean_exit;
   }
   ret = 0;
 
 clean_exit:
+  free(llr_ref);
   free(llr_b);
   free(llr_s);
   free(llr);
@@ -253,5 +349,12 @@ clean_exit:
          mean_texec,
          mean_texec_s,
          mean_texec_b);
+  printf("Scaled Throughput: %.2f/%.2f/%.2f. Mbps ExTime: %.2f/%.2f/%.2f us\n",
+         num_bits / scaled_texec,
+         num_bits / scaled_texec_s,
+         num_bits / scaled_texec_b,
+         scaled_texec,
+         scaled_texec_s,
+         scaled_texec_b);
   exit(ret);
 }
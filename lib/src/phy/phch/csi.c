@@ -25,6 +25,7 @@
 #include <math.h>
 
 #define CSI_WIDEBAND_CSI_NOF_BITS 4
+#define CSI_SUBBAND_DIFF_CQI_NOF_BITS 2
 
 #define CSI_DEFAULT_ALPHA 0.5f
 
@@ -119,6 +120,93 @@ static uint32_t csi_wideband_cri_ri_pmi_cqi_unpack(const srsran_csi_report_cfg_t
   return nof_bits_cri + CSI_WIDEBAND_CSI_NOF_BITS;
 }
 
+/// Implements the subband differential CQI mapping of TS 38.214 Table 5.2.2.1-1
+static uint8_t csi_subband_diff_cqi(uint32_t wideband_cqi, uint32_t subband_cqi)
+{
+  int offset = (int)subband_cqi - (int)wideband_cqi;
+  if (offset < 0) {
+    return 3;
+  }
+  return (uint8_t)SRSRAN_MIN(offset, 2);
+}
+
+static void csi_subband_cri_ri_pmi_cqi_quantify(const srsran_csi_hl_report_cfg_t*        cfg,
+                                                const srsran_csi_channel_measurements_t* channel_meas,
+                                                const srsran_csi_channel_measurements_t* interf_meas,
+                                                srsran_csi_report_value_t*               report_value)
+{
+  // Quantify the wideband CQI as in a wideband report
+  csi_wideband_cri_ri_pmi_cqi_quantify(cfg, channel_meas, interf_meas, report_value);
+  uint32_t wideband_cqi = report_value->wideband_cri_ri_pmi_cqi.cqi;
+
+  // Subbands without measurement take the wideband CQI
+  for (uint32_t i = 0; i < cfg->nof_subbands && i < SRSRAN_CSI_MAX_NOF_SUBBANDS; i++) {
+    uint32_t subband_cqi = wideband_cqi;
+    if (i < channel_meas->nof_subbands && interf_meas == NULL) {
+      subband_cqi = csi_snri_db_to_cqi(cfg->cqi_table, channel_meas->subband_snr_db[i]);
+    }
+    report_value->subband_cri_ri_pmi_cqi.subband_diff_cqi[i] = csi_subband_diff_cqi(wideband_cqi, subband_cqi);
+  }
+}
+
+static uint32_t csi_subband_cri_ri_pmi_cqi_nof_bits(const srsran_csi_report_cfg_t* cfg)
+{
+  uint32_t nof_bits = csi_wideband_cri_ri_pmi_cqi_nof_bits(cfg);
+  if (nof_bits == 0) {
+    return 0;
+  }
+  return nof_bits + CSI_SUBBAND_DIFF_CQI_NOF_BITS * SRSRAN_MIN(cfg->cfg.nof_subbands, SRSRAN_CSI_MAX_NOF_SUBBANDS);
+}
+
+static uint32_t csi_subband_cri_ri_pmi_cqi_pack(const srsran_csi_report_cfg_t*   cfg,
+                                                const srsran_csi_report_value_t* value,
+                                                uint8_t*                         o_csi1)
+{
+  uint32_t nof_subbands = SRSRAN_MIN(cfg->cfg.nof_subbands, SRSRAN_CSI_MAX_NOF_SUBBANDS);
+
+  // Write wideband CQI
+  srsran_bit_unpack(value->subband_cri_ri_pmi_cqi.cqi, &o_csi1, CSI_WIDEBAND_CSI_NOF_BITS);
+
+  // Write subband differential CQIs
+  for (uint32_t i = 0; i < nof_subbands; i++) {
+    srsran_bit_unpack(value->subband_cri_ri_pmi_cqi.subband_diff_cqi[i], &o_csi1, CSI_SUBBAND_DIFF_CQI_NOF_BITS);
+  }
+
+  // Compute number of bits for CRI and write
+  uint32_t nof_bits_cri = 0;
+  if (cfg->K_csi_rs > 0) {
+    nof_bits_cri = (uint32_t)ceilf(log2f((float)cfg->K_csi_rs));
+  }
+  srsran_bit_unpack(value->cri, &o_csi1, nof_bits_cri);
+
+  return CSI_WIDEBAND_CSI_NOF_BITS + CSI_SUBBAND_DIFF_CQI_NOF_BITS * nof_subbands + nof_bits_cri;
+}
+
+static uint32_t csi_subband_cri_ri_pmi_cqi_unpack(const srsran_csi_report_cfg_t* cfg,
+                                                  uint8_t*                       o_csi1,
+                                                  srsran_csi_report_value_t*     value)
+{
+  uint32_t nof_subbands = SRSRAN_MIN(cfg->cfg.nof_subbands, SRSRAN_CSI_MAX_NOF_SUBBANDS);
+
+  // Read wideband CQI
+  value->subband_cri_ri_pmi_cqi.cqi = srsran_bit_pack(&o_csi1, CSI_WIDEBAND_CSI_NOF_BITS);
+
+  // Read subband differential CQIs
+  for (uint32_t i = 0; i < nof_subbands; i++) {
+    value->subband_cri_ri_pmi_cqi.subband_diff_cqi[i] =
+        (uint8_t)srsran_bit_pack(&o_csi1, CSI_SUBBAND_DIFF_CQI_NOF_BITS);
+  }
+
+  // Compute number of bits for CRI and read
+  uint32_t nof_bits_cri = 0;
+  if (cfg->K_csi_rs > 0) {
+    nof_bits_cri = (uint32_t)ceilf(log2f((float)cfg->K_csi_rs));
+  }
+  value->cri = srsran_bit_pack(&o_csi1, nof_bits_cri);
+
+  return CSI_WIDEBAND_CSI_NOF_BITS + CSI_SUBBAND_DIFF_CQI_NOF_BITS * nof_subbands + nof_bits_cri;
+}
+
 static uint32_t csi_none_nof_bits(const srsran_csi_report_cfg_t* cfg)
 {
   return cfg->K_csi_rs;
@@ -177,6 +265,17 @@ int srsran_csi_new_nzp_csi_rs_measurement(
         SRSRAN_VEC_SAFE_EMA(new_measure->wideband_epre_dBm, measurements[res_idx].wideband_epre_dBm, CSI_DEFAULT_ALPHA);
     measurements[res_idx].wideband_snr_db =
         SRSRAN_VEC_SAFE_EMA(new_measure->wideband_snr_db, measurements[res_idx].wideband_snr_db, CSI_DEFAULT_ALPHA);
+    if (new_measure->nof_subbands != measurements[res_idx].nof_subbands) {
+      // The subbands changed, restart the filter
+      measurements[res_idx].nof_subbands = SRSRAN_MIN(new_measure->nof_subbands, SRSRAN_CSI_MAX_NOF_SUBBANDS);
+      srsran_vec_f_copy(
+          measurements[res_idx].subband_snr_db, new_measure->subband_snr_db, measurements[res_idx].nof_subbands);
+    } else {
+      for (uint32_t i = 0; i < measurements[res_idx].nof_subbands; i++) {
+        measurements[res_idx].subband_snr_db[i] = SRSRAN_VEC_SAFE_EMA(
+            new_measure->subband_snr_db[i], measurements[res_idx].subband_snr_db[i], CSI_DEFAULT_ALPHA);
+      }
+    }
 
     // Force rest
     measurements[res_idx].cri      = new_measure->cri;
@@ -267,6 +366,10 @@ int srsran_csi_reports_quantify(const srsran_csi_report_cfg_t           reports[
         reports[i].cfg.quantity == SRSRAN_CSI_REPORT_QUANTITY_CRI_RI_PMI_CQI) {
       csi_wideband_cri_ri_pmi_cqi_quantify(&reports[i].cfg, channel_meas, interf_meas, &report_value[count]);
       count++;
+    } else if (reports[i].cfg.freq_cfg == SRSRAN_CSI_REPORT_FREQ_SUBBAND &&
+               reports[i].cfg.quantity == SRSRAN_CSI_REPORT_QUANTITY_CRI_RI_PMI_CQI) {
+      csi_subband_cri_ri_pmi_cqi_quantify(&reports[i].cfg, channel_meas, interf_meas, &report_value[count]);
+      count++;
     } else {
       ; // Ignore other types
     }
@@ -287,7 +390,10 @@ int srsran_csi_part1_nof_bits(const srsran_csi_report_cfg_t* report_list, uint32
   // Iterate all report configurations
   for (uint32_t i = 0; i < nof_reports; i++) {
     const srsran_csi_report_cfg_t* report = &report_list[i];
-    if (report->cfg.quantity && report->cfg.quantity == SRSRAN_CSI_REPORT_QUANTITY_CRI_RI_PMI_CQI) {
+    if (report->cfg.quantity == SRSRAN_CSI_REPORT_QUANTITY_CRI_RI_PMI_CQI &&
+        report->cfg.freq_cfg == SRSRAN_CSI_REPORT_FREQ_SUBBAND) {
+      count += csi_subband_cri_ri_pmi_cqi_nof_bits(report);
+    } else if (report->cfg.quantity == SRSRAN_CSI_REPORT_QUANTITY_CRI_RI_PMI_CQI) {
       count += csi_wideband_cri_ri_pmi_cqi_nof_bits(report);
     } else if (report->cfg.quantity == SRSRAN_CSI_REPORT_QUANTITY_NONE) {
       count += csi_none_nof_bits(report);
@@ -345,6 +451,9 @@ int srsran_csi_part1_pack(const srsran_csi_report_cfg_t*   report_cfg,
     if (report_cfg[i].cfg.freq_cfg == SRSRAN_CSI_REPORT_FREQ_WIDEBAND &&
         report_cfg[i].cfg.quantity == SRSRAN_CSI_REPORT_QUANTITY_CRI_RI_PMI_CQI) {
       count += csi_wideband_cri_ri_pmi_cqi_pack(&report_cfg[i], &report_value[i], &o_csi1[count]);
+    } else if (report_cfg[i].cfg.freq_cfg == SRSRAN_CSI_REPORT_FREQ_SUBBAND &&
+               report_cfg[i].cfg.quantity == SRSRAN_CSI_REPORT_QUANTITY_CRI_RI_PMI_CQI) {
+      count += csi_subband_cri_ri_pmi_cqi_pack(&report_cfg[i], &report_value[i], &o_csi1[count]);
     } else if (report_cfg[i].cfg.quantity == SRSRAN_CSI_REPORT_QUANTITY_NONE) {
       count += csi_none_pack(&report_cfg[i], &report_value[i], &o_csi1[count]);
     } else {
@@ -379,6 +488,9 @@ int srsran_csi_part1_unpack(const srsran_csi_report_cfg_t* report_cfg,
     if (report_cfg[i].cfg.freq_cfg == SRSRAN_CSI_REPORT_FREQ_WIDEBAND &&
         report_cfg[i].cfg.quantity == SRSRAN_CSI_REPORT_QUANTITY_CRI_RI_PMI_CQI) {
       count += csi_wideband_cri_ri_pmi_cqi_unpack(&report_cfg[i], &o_csi1[count], &report_value[i]);
+    } else if (report_cfg[i].cfg.freq_cfg == SRSRAN_CSI_REPORT_FREQ_SUBBAND &&
+               report_cfg[i].cfg.quantity == SRSRAN_CSI_REPORT_QUANTITY_CRI_RI_PMI_CQI) {
+      count += csi_subband_cri_ri_pmi_cqi_unpack(&report_cfg[i], &o_csi1[count], &report_value[i]);
     } else if (report_cfg[i].cfg.quantity == SRSRAN_CSI_REPORT_QUANTITY_NONE) {
       count += csi_none_unpack(&report_cfg[i], &o_csi1[count], &report_value[i]);
     } else {
@@ -402,6 +514,14 @@ uint32_t srsran_csi_str(const srsran_csi_report_cfg_t*   report_cfg,
     if (report_cfg[i].cfg.freq_cfg == SRSRAN_CSI_REPORT_FREQ_WIDEBAND &&
         report_cfg[i].cfg.quantity == SRSRAN_CSI_REPORT_QUANTITY_CRI_RI_PMI_CQI) {
       len = srsran_print_check(str, str_len, len, "cqi=%d ", report_value[i].wideband_cri_ri_pmi_cqi.cqi);
+    } else if (report_cfg[i].cfg.freq_cfg == SRSRAN_CSI_REPORT_FREQ_SUBBAND &&
+               report_cfg[i].cfg.quantity == SRSRAN_CSI_REPORT_QUANTITY_CRI_RI_PMI_CQI) {
+      len = srsran_print_check(str, str_len, len, "cqi=%d sb_cqi=[", report_value[i].subband_cri_ri_pmi_cqi.cqi);
+      for (uint32_t j = 0; j < report_cfg[i].cfg.nof_subbands && j < SRSRAN_CSI_MAX_NOF_SUBBANDS; j++) {
+        len = srsran_print_check(
+            str, str_len, len, j == 0 ? "%d" : ",%d", srsran_csi_subband_cqi(&report_value[i], j));
+      }
+      len = srsran_print_check(str, str_len, len, "] ");
     } else if (report_cfg[i].cfg.quantity == SRSRAN_CSI_REPORT_QUANTITY_NONE) {
       char tmp[20] = {};
       srsran_vec_sprint_bin(tmp, sizeof(tmp), report_value[i].none, report_cfg->K_csi_rs);
@@ -410,3 +530,58 @@ uint32_t srsran_csi_str(const srsran_csi_report_cfg_t*   report_cfg,
   }
   return len;
 }
+
+int srsran_csi_set_subbands(srsran_csi_hl_report_cfg_t* cfg,
+                            uint32_t                    bwp_start,
+                            uint32_t                    bwp_nof_prb,
+                            bool                        large_subbands)
+{
+  if (cfg == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // TS 38.214 Table 5.2.1.4-2: Configurable subband sizes
+  uint32_t subband_size = 0;
+  if (bwp_nof_prb < 24) {
+    ERROR("Subband CSI reports are not supported in BWP of %d PRB", bwp_nof_prb);
+    return SRSRAN_ERROR;
+  } else if (bwp_nof_prb <= 72) {
+    subband_size = large_subbands ? 8 : 4;
+  } else if (bwp_nof_prb <= 144) {
+    subband_size = large_subbands ? 16 : 8;
+  } else if (bwp_nof_prb <= 275) {
+    subband_size = large_subbands ? 32 : 16;
+  } else {
+    ERROR("Invalid BWP size (%d)", bwp_nof_prb);
+    return SRSRAN_ERROR;
+  }
+
+  // TS 38.214 Section 5.2.1.4: The first and last subbands are aligned to the subband size in common resource blocks
+  cfg->subband_size = subband_size;
+  cfg->nof_subbands = SRSRAN_CEIL(bwp_start % subband_size + bwp_nof_prb, subband_size);
+
+  return SRSRAN_SUCCESS;
+}
+
+uint32_t srsran_csi_subband_cqi(const srsran_csi_report_value_t* value, uint32_t subband_idx)
+{
+  if (value == NULL || subband_idx >= SRSRAN_CSI_MAX_NOF_SUBBANDS) {
+    return 0;
+  }
+
+  // TS 38.214 Table 5.2.2.1-1: Mapping subband differential CQI value to offset level
+  int cqi = (int)value->subband_cri_ri_pmi_cqi.cqi;
+  switch (value->subband_cri_ri_pmi_cqi.subband_diff_cqi[subband_idx]) {
+    case 1:
+      cqi += 1;
+      break;
+    case 2:
+      cqi += 2;
+      break;
+    case 3:
+      cqi -= 1;
+      break;
+    default:; // Same as wideband
+  }
+  return (uint32_t)SRSRAN_MIN(SRSRAN_MAX(cqi, 0), 15);
+}
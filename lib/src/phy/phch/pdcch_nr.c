@@ -35,22 +35,48 @@
 #define PDCCH_INFO_RX(...) INFO("PDCCH Rx: " __VA_ARGS__)
 #define PDCCH_DEBUG_RX(...) DEBUG("PDCCH Rx: " __VA_ARGS__)
 
+static const uint32_t pdcch_nr_A_p[3] = {39827, 39829, 39839};
+static const uint32_t pdcch_nr_D        = 65537;
+
 /**
  * @brief Recursive Y_p_n function
  */
 static uint32_t srsran_pdcch_calculate_Y_p_n(uint32_t coreset_id, uint16_t rnti, uint32_t n)
 {
-  static const uint32_t A_p[3] = {39827, 39829, 39839};
-  const uint32_t        D      = 65537;
-
   uint32_t Y_p_n = (uint32_t)rnti;
   for (uint32_t i = 0; i <= n; i++) {
-    Y_p_n = (A_p[coreset_id % 3] * Y_p_n) % D;
+    Y_p_n = (pdcch_nr_A_p[coreset_id % 3] * Y_p_n) % pdcch_nr_D;
   }
 
   return Y_p_n;
 }
 
+/**
+ * @brief Computes the number of CCE of a CORESET and checks it fits an aggregation level
+ */
+static int pdcch_nr_nof_cce(const srsran_coreset_t* coreset, uint32_t aggregation_level)
+{
+  uint32_t L = 1U << aggregation_level;
+
+  // Calculate CORESET bandiwth in physical resource blocks
+  uint32_t coreset_bw = srsran_coreset_get_bw(coreset);
+
+  // Every REG is 1PRB wide and a CCE is 6 REG. So, the number of N_CCE is a sixth of the bandwidth times the number of
+  // symbols
+  uint32_t N_cce = coreset_bw * coreset->duration / 6;
+
+  if (N_cce < L) {
+    ERROR("Error CORESET (total bandwidth of %d RBs and %d CCEs) cannot fit the aggregation level %d (%d)",
+          coreset_bw,
+          N_cce,
+          L,
+          aggregation_level);
+    return SRSRAN_ERROR;
+  }
+
+  return (int)N_cce;
+}
+
 /**
  * Calculates the Control Channnel Element As described in 3GPP 38.213 R15 10.1 UE procedure for determining physical
  * downlink control channel assignment
@@ -78,19 +104,8 @@ static int srsran_pdcch_nr_get_ncce(const srsran_coreset_t*      coreset,
     return SRSRAN_ERROR;
   }
 
-  // Calculate CORESET bandiwth in physical resource blocks
-  uint32_t coreset_bw = srsran_coreset_get_bw(coreset);
-
-  // Every REG is 1PRB wide and a CCE is 6 REG. So, the number of N_CCE is a sixth of the bandwidth times the number of
-  // symbols
-  uint32_t N_cce = coreset_bw * coreset->duration / 6;
-
-  if (N_cce < L) {
-    ERROR("Error CORESET (total bandwidth of %d RBs and %d CCEs) cannot fit the aggregation level %d (%d)",
-          coreset_bw,
-          N_cce,
-          L,
-          aggregation_level);
+  int N_cce = pdcch_nr_nof_cce(coreset, aggregation_level);
+  if (N_cce < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
@@ -130,6 +145,59 @@ int srsran_pdcch_nr_locations_coreset(const srsran_coreset_t*      coreset,
   return nof_candidates;
 }
 
+int srsran_pdcch_nr_locations_table(const srsran_coreset_t*      coreset,
+                                    const srsran_search_space_t* search_space,
+                                    uint16_t                     rnti,
+                                    srsran_subcarrier_spacing_t  scs,
+                                    srsran_pdcch_nr_locations_t* locations)
+{
+  if (coreset == NULL || search_space == NULL || locations == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Only the UE specific search space locations change from slot to slot
+  uint32_t nof_slots = (search_space->type == srsran_search_space_type_ue) ? SRSRAN_NSLOTS_PER_FRAME_NR(scs) : 1;
+  if (nof_slots > SRSRAN_PDCCH_NR_MAX_NOF_SLOTS) {
+    ERROR("Invalid subcarrier spacing for PDCCH (%d)", (int)scs);
+    return SRSRAN_ERROR;
+  }
+
+  locations->rnti      = rnti;
+  locations->nof_slots = 0;
+
+  for (uint32_t aggregation_level = 0; aggregation_level < SRSRAN_SEARCH_SPACE_NOF_AGGREGATION_LEVELS_NR;
+       aggregation_level++) {
+    uint32_t L              = 1U << aggregation_level;
+    uint32_t M              = search_space->nof_candidates[aggregation_level];
+    uint32_t nof_candidates = SRSRAN_MIN(M, SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR);
+    locations->nof_candidates[aggregation_level] = nof_candidates;
+    if (nof_candidates == 0) {
+      continue;
+    }
+
+    int N_cce = pdcch_nr_nof_cce(coreset, aggregation_level);
+    if (N_cce < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+
+    // Advance the Y_p_n recursion one step every slot instead of restarting it
+    uint32_t Y_p_n = (uint32_t)rnti;
+    for (uint32_t slot_idx = 0; slot_idx < nof_slots; slot_idx++) {
+      Y_p_n = (search_space->type == srsran_search_space_type_ue)
+                  ? (pdcch_nr_A_p[coreset->id % 3] * Y_p_n) % pdcch_nr_D
+                  : 0;
+      for (uint32_t m = 0; m < nof_candidates; m++) {
+        locations->ncce[slot_idx][aggregation_level][m] =
+            (uint8_t)(L * ((Y_p_n + (m * N_cce) / (L * M)) % (N_cce / L)));
+      }
+    }
+  }
+
+  locations->nof_slots = nof_slots;
+
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_pdcch_nr_max_candidates_coreset(const srsran_coreset_t* coreset, uint32_t aggregation_level)
 {
   if (coreset == NULL) {
@@ -145,6 +213,24 @@ int srsran_pdcch_nr_max_candidates_coreset(const srsran_coreset_t* coreset, uint
   return SRSRAN_MIN(nof_candidates, SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR);
 }
 
+// Builds the polar code for the current K and E, the blind search decodes many candidates with the same parameters
+static int pdcch_nr_polar_code_get(srsran_pdcch_nr_t* q)
+{
+  if (q->code_K == q->K && q->code_E == q->E) {
+    return SRSRAN_SUCCESS;
+  }
+
+  if (srsran_polar_code_get(&q->code, q->K, q->E, 9U) < SRSRAN_SUCCESS) {
+    q->code_K = 0;
+    q->code_E = 0;
+    return SRSRAN_ERROR;
+  }
+
+  q->code_K = q->K;
+  q->code_E = q->E;
+  return SRSRAN_SUCCESS;
+}
+
 static int pdcch_nr_init_common(srsran_pdcch_nr_t* q, const srsran_pdcch_nr_args_t* args)
 {
   if (q == NULL || args == NULL) {
@@ -152,6 +238,8 @@ static int pdcch_nr_init_common(srsran_pdcch_nr_t* q, const srsran_pdcch_nr_args
   }
 
   q->meas_time_en = args->measure_time;
+  q->code_K       = 0;
+  q->code_E       = 0;
 
   q->c = srsran_vec_u8_malloc(SRSRAN_PDCCH_MAX_RE * 2);
   if (q->c == NULL) {
@@ -173,7 +261,7 @@ static int pdcch_nr_init_common(srsran_pdcch_nr_t* q, const srsran_pdcch_nr_args
     return SRSRAN_ERROR;
   }
 
-  q->allocated = srsran_vec_u8_malloc(NMAX);
+  q->allocated = srsran_vec_u8_malloc(NMAX * SRSRAN_POLAR_DECODER_LIST_SIZE_MAX);
   if (q->allocated == NULL) {
     return SRSRAN_ERROR;
   }
@@ -227,14 +315,25 @@ int srsran_pdcch_nr_init_rx(srsran_pdcch_nr_t* q, const srsran_pdcch_nr_args_t*
   }
 
   srsran_polar_decoder_type_t decoder_type = SRSRAN_POLAR_DECODER_SSC_C;
+  uint32_t                    list_size    = SRSRAN_MAX(args->polar_list_size, 1);
+
+  if (list_size > 1) {
+    decoder_type = SRSRAN_POLAR_DECODER_SCL_C;
+  }
 
 #ifdef LV_HAVE_AVX2
   if (!args->disable_simd) {
-    decoder_type = SRSRAN_POLAR_DECODER_SSC_C_AVX2;
+    decoder_type = (list_size > 1) ? SRSRAN_POLAR_DECODER_SCL_C_AVX2 : SRSRAN_POLAR_DECODER_SSC_C_AVX2;
   }
 #endif // LV_HAVE_AVX2
 
-  if (srsran_polar_decoder_init(&q->decoder, decoder_type, NMAX_LOG) < SRSRAN_SUCCESS) {
+#ifdef LV_HAVE_AVX512
+  if (!args->disable_simd && list_size > 1) {
+    decoder_type = SRSRAN_POLAR_DECODER_SCL_C_AVX512;
+  }
+#endif // LV_HAVE_AVX512
+
+  if (srsran_polar_decoder_init_list(&q->decoder, decoder_type, NMAX_LOG, list_size) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
@@ -246,6 +345,15 @@ int srsran_pdcch_nr_init_rx(srsran_pdcch_nr_t* q, const srsran_pdcch_nr_args_t*
     q->evm_buffer = srsran_evm_buffer_alloc(SRSRAN_PDCCH_MAX_RE * 2);
   }
 
+  uint32_t reg_sz = SRSRAN_CORESET_DURATION_MAX * SRSRAN_MAX_PRB_NR * SRSRAN_PDCCH_NR_RE_X_REG;
+  q->reg_symbols  = srsran_vec_cf_malloc(reg_sz);
+  q->reg_llr      = srsran_vec_i8_malloc(reg_sz * 2);
+  q->reg_ce       = srsran_vec_cf_malloc(SRSRAN_PDCCH_MAX_RE);
+  if (q->reg_symbols == NULL || q->reg_llr == NULL || q->reg_ce == NULL) {
+    return SRSRAN_ERROR;
+  }
+  srsran_pdcch_nr_reset_reg(q);
+
   return SRSRAN_SUCCESS;
 }
 
@@ -285,6 +393,18 @@ void srsran_pdcch_nr_free(srsran_pdcch_nr_t* q)
     free(q->symbols);
   }
 
+  if (q->reg_symbols) {
+    free(q->reg_symbols);
+  }
+
+  if (q->reg_llr) {
+    free(q->reg_llr);
+  }
+
+  if (q->reg_ce) {
+    free(q->reg_ce);
+  }
+
   srsran_modem_table_free(&q->modem_table);
 
   if (q->evm_buffer) {
@@ -307,12 +427,25 @@ int srsran_pdcch_nr_set_carrier(srsran_pdcch_nr_t*         q,
   }
 
   if (coreset != NULL) {
+    // The REG soft bits belong to the previous CORESET
+    if (coreset->id != q->coreset.id) {
+      srsran_pdcch_nr_reset_reg(q);
+    }
     q->coreset = *coreset;
   }
 
   return SRSRAN_SUCCESS;
 }
 
+void srsran_pdcch_nr_reset_reg(srsran_pdcch_nr_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  SRSRAN_MEM_ZERO(&q->reg_valid[0][0], bool, SRSRAN_CORESET_DURATION_MAX * SRSRAN_MAX_PRB_NR);
+}
+
 static int pdcch_nr_cce_to_reg_mapping_non_interleaved(const srsran_coreset_t*      coreset,
                                                        const srsran_dci_location_t* dci_location,
                                                        bool                         rb_mask[SRSRAN_MAX_PRB_NR])
@@ -487,7 +620,7 @@ int srsran_pdcch_nr_encode(srsran_pdcch_nr_t* q, const srsran_dci_msg_nr_t* dci_
   uint32_t cinit = pdcch_nr_c_init(q, dci_msg);                              // Pseudo-random sequence initiation
 
   // Get polar code
-  if (srsran_polar_code_get(&q->code, q->K, q->E, 9U) < SRSRAN_SUCCESS) {
+  if (pdcch_nr_polar_code_get(q) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
   PDCCH_INFO_TX("K=%d; E=%d; M=%d; n=%d; cinit=%08x;", q->K, q->E, q->M, q->code.n, cinit);
@@ -569,6 +702,101 @@ int srsran_pdcch_nr_encode(srsran_pdcch_nr_t* q, const srsran_dci_msg_nr_t* dci_
   return SRSRAN_SUCCESS;
 }
 
+/**
+ * @brief Recovers the DCI bits of a decoded polar message into q->c and checks the CRC scrambled with the RNTI
+ * @return True if the CRC matches, false otherwise
+ */
+static bool pdcch_nr_check_message(srsran_pdcch_nr_t* q, const srsran_dci_msg_nr_t* dci_msg, const uint8_t* allocated)
+{
+  // De-allocate channel
+  uint8_t c_prime[SRSRAN_POLAR_INTERLEAVER_K_MAX_IL];
+  srsran_polar_chanalloc_rx(allocated, c_prime, q->code.K, q->code.nPC, q->code.K_set, q->code.PC_set);
+
+  // Set first L bits to ones, c will have an offset of 24 bits
+  uint8_t* c = q->c;
+  srsran_bit_unpack(UINT32_MAX, &c, 24U);
+
+  // De-interleave
+  srsran_polar_interleaver_run_u8(c_prime, c, q->K, false);
+
+  // Print c
+  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
+    PDCCH_INFO_RX("c_prime=");
+    srsran_vec_fprint_hex(stdout, c_prime, q->K);
+    PDCCH_INFO_RX("c=");
+    srsran_vec_fprint_hex(stdout, c, q->K);
+  }
+
+  // Unpack RNTI
+  uint8_t  unpacked_rnti[16] = {};
+  uint8_t* ptr               = unpacked_rnti;
+  srsran_bit_unpack(dci_msg->ctx.rnti, &ptr, 16);
+
+  // De-Scramble CRC with RNTI
+  srsran_vec_xor_bbb(unpacked_rnti, &c[q->K - 16], &c[q->K - 16], 16);
+
+  // Check CRC
+  ptr                = &c[q->K - 24];
+  uint32_t checksum1 = srsran_crc_checksum(&q->crc24c, q->c, q->K);
+  uint32_t checksum2 = srsran_bit_pack(&ptr, 24);
+
+  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
+    PDCCH_INFO_RX("CRC={%06x, %06x}; msg=", checksum1, checksum2);
+    srsran_vec_fprint_hex(stdout, c, dci_msg->nof_bits);
+  }
+
+  return checksum1 == checksum2;
+}
+
+/**
+ * @brief Decodes the DCI from the demodulated soft bits of the candidate, stored in q->f
+ */
+static int pdcch_nr_decode_llr(srsran_pdcch_nr_t* q, srsran_dci_msg_nr_t* dci_msg, srsran_pdcch_nr_res_t* res)
+{
+  int8_t* llr = (int8_t*)q->f;
+
+  // Negate all LLR
+  for (uint32_t i = 0; i < q->E; i++) {
+    llr[i] *= -1;
+  }
+
+  // Descrambling
+  srsran_sequence_apply_c(llr, llr, q->E, pdcch_nr_c_init(q, dci_msg));
+
+  // Un-rate matching
+  int8_t* d = (int8_t*)q->d;
+  if (srsran_polar_rm_rx_c(&q->rm, llr, d, q->E, q->code.n, q->K, PDCCH_NR_POLAR_RM_IBIL) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  // Print d
+  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
+    PDCCH_DEBUG_RX("d=");
+    srsran_vec_fprint_bs(stdout, d, q->K);
+  }
+
+  // Decode, list decoders give several candidate messages sorted by likelihood
+  int nof_candidates = srsran_polar_decoder_decode_list_c(
+      &q->decoder, d, q->allocated, q->code.n, q->code.F_set, q->code.F_set_size);
+  if (nof_candidates < 1) {
+    return SRSRAN_ERROR;
+  }
+
+  // Take the first candidate passing the CRC, or the most likely one if none does
+  res->crc = false;
+  for (int i = 0; i < nof_candidates && !res->crc; i++) {
+    res->crc = pdcch_nr_check_message(q, dci_msg, q->allocated + i * q->code.N);
+  }
+  if (!res->crc && nof_candidates > 1) {
+    pdcch_nr_check_message(q, dci_msg, q->allocated);
+  }
+
+  // Copy DCI message
+  srsran_vec_u8_copy(dci_msg->payload, &q->c[24], dci_msg->nof_bits);
+
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
                            cf_t*                   slot_symbols,
                            srsran_dmrs_pdcch_ce_t* ce,
@@ -596,7 +824,7 @@ int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
   }
 
   // Get polar code
-  if (srsran_polar_code_get(&q->code, q->K, q->E, 9U) < SRSRAN_SUCCESS) {
+  if (pdcch_nr_polar_code_get(q) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
   PDCCH_INFO_RX("K=%d; E=%d; M=%d; n=%d;", q->K, q->E, q->M, q->code.n);
@@ -634,72 +862,166 @@ int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
     res->evm = NAN;
   }
 
-  // Negate all LLR
-  for (uint32_t i = 0; i < q->E; i++) {
-    llr[i] *= -1;
+  // Decode soft bits
+  if (pdcch_nr_decode_llr(q, dci_msg, res) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
   }
 
-  // Descrambling
-  srsran_sequence_apply_c(llr, llr, q->E, pdcch_nr_c_init(q, dci_msg));
+  if (q->meas_time_en) {
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    q->meas_time_us = (uint32_t)t[0].tv_usec;
+  }
 
-  // Un-rate matching
-  int8_t* d = (int8_t*)q->d;
-  if (srsran_polar_rm_rx_c(&q->rm, llr, d, q->E, q->code.n, q->K, PDCCH_NR_POLAR_RM_IBIL) < SRSRAN_SUCCESS) {
-    return SRSRAN_ERROR;
+  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
+    char str[128] = {};
+    srsran_pdcch_nr_info(q, res, str, sizeof(str));
+    PDCCH_INFO_RX("%s", str);
   }
 
-  // Print d
-  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
-    PDCCH_DEBUG_RX("d=");
-    srsran_vec_fprint_bs(stdout, d, q->K);
+  return SRSRAN_SUCCESS;
+}
+
+/**
+ * @brief Demodulates the REGs of a candidate that are not demodulated yet and gathers the candidate equalized symbols
+ * and soft bits in q->symbols and q->f, in the same order as pdcch_nr_cp()
+ */
+static uint32_t pdcch_nr_reg_demod(srsran_pdcch_nr_t*                   q,
+                                   const cf_t*                          slot_grid,
+                                   const srsran_dmrs_pdcch_estimator_t* estimator,
+                                   const srsran_dci_location_t*         dci_location)
+{
+  uint32_t offset_k = q->coreset.offset_rb * SRSRAN_NRE;
+  int8_t*  llr      = (int8_t*)q->f;
+
+  // Compute REG list
+  bool rb_mask[SRSRAN_MAX_PRB_NR] = {};
+  if (srsran_pdcch_nr_cce_to_reg_mapping(&q->coreset, dci_location, rb_mask) < SRSRAN_SUCCESS) {
+    return 0;
   }
 
-  // Decode
-  if (srsran_polar_decoder_decode_c(&q->decoder, d, q->allocated, q->code.n, q->code.F_set, q->code.F_set_size) <
-      SRSRAN_SUCCESS) {
-    return SRSRAN_ERROR;
+  // Gather the symbols and channel estimates of the REGs that no other candidate used
+  uint32_t nof_new = 0;
+  for (uint32_t l = 0; l < q->coreset.duration; l++) {
+    uint32_t rb = 0;
+    for (uint32_t r = 0; r < SRSRAN_CORESET_FREQ_DOMAIN_RES_SIZE; r++) {
+      if (!q->coreset.freq_resources[r]) {
+        continue;
+      }
+      for (uint32_t i = r * 6; i < (r + 1) * 6; i++, rb++) {
+        if (!rb_mask[rb] || q->reg_valid[l][rb]) {
+          continue;
+        }
+        const cf_t* grid = &slot_grid[q->carrier.nof_prb * SRSRAN_NRE * l + i * SRSRAN_NRE + offset_k];
+        const cf_t* ce   = &estimator->ce[estimator->coreset_bw * SRSRAN_NRE * l + rb * SRSRAN_NRE];
+        for (uint32_t k = 0; k < SRSRAN_NRE; k++) {
+          // Skip if it is a DMRS
+          if (k % 4 == 1) {
+            continue;
+          }
+          q->symbols[nof_new] = grid[k];
+          q->reg_ce[nof_new]  = ce[k];
+          nof_new++;
+        }
+      }
+    }
   }
 
-  // De-allocate channel
-  uint8_t c_prime[SRSRAN_POLAR_INTERLEAVER_K_MAX_IL];
-  srsran_polar_chanalloc_rx(q->allocated, c_prime, q->code.K, q->code.nPC, q->code.K_set, q->code.PC_set);
+  // Equalise and demodulate them at once, then store them
+  if (nof_new > 0) {
+    srsran_predecoding_single(q->symbols, q->reg_ce, q->symbols, NULL, nof_new, 1.0f, 0.0f);
+    srsran_demod_soft_demodulate_b(SRSRAN_MOD_QPSK, q->symbols, llr, nof_new);
 
-  // Set first L bits to ones, c will have an offset of 24 bits
-  uint8_t* c = q->c;
-  srsran_bit_unpack(UINT32_MAX, &c, 24U);
+    uint32_t count = 0;
+    for (uint32_t l = 0; l < q->coreset.duration; l++) {
+      for (uint32_t rb = 0; rb < estimator->coreset_bw; rb++) {
+        if (!rb_mask[rb] || q->reg_valid[l][rb]) {
+          continue;
+        }
+        uint32_t reg = l * SRSRAN_MAX_PRB_NR + rb;
+        srsran_vec_cf_copy(&q->reg_symbols[reg * SRSRAN_PDCCH_NR_RE_X_REG],
+                           &q->symbols[count],
+                           SRSRAN_PDCCH_NR_RE_X_REG);
+        srsran_vec_i8_copy(&q->reg_llr[reg * SRSRAN_PDCCH_NR_RE_X_REG * 2],
+                           &llr[count * 2],
+                           SRSRAN_PDCCH_NR_RE_X_REG * 2);
+        q->reg_valid[l][rb] = true;
+        count += SRSRAN_PDCCH_NR_RE_X_REG;
+      }
+    }
+  }
 
-  // De-interleave
-  srsran_polar_interleaver_run_u8(c_prime, c, q->K, false);
+  // Gather the candidate
+  uint32_t count = 0;
+  for (uint32_t l = 0; l < q->coreset.duration; l++) {
+    for (uint32_t rb = 0; rb < estimator->coreset_bw; rb++) {
+      if (!rb_mask[rb]) {
+        continue;
+      }
+      uint32_t reg = l * SRSRAN_MAX_PRB_NR + rb;
+      srsran_vec_cf_copy(
+          &q->symbols[count], &q->reg_symbols[reg * SRSRAN_PDCCH_NR_RE_X_REG], SRSRAN_PDCCH_NR_RE_X_REG);
+      srsran_vec_i8_copy(
+          &llr[count * 2], &q->reg_llr[reg * SRSRAN_PDCCH_NR_RE_X_REG * 2], SRSRAN_PDCCH_NR_RE_X_REG * 2);
+      count += SRSRAN_PDCCH_NR_RE_X_REG;
+    }
+  }
 
-  // Print c
-  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
-    PDCCH_INFO_RX("c_prime=");
-    srsran_vec_fprint_hex(stdout, c_prime, q->K);
-    PDCCH_INFO_RX("c=");
-    srsran_vec_fprint_hex(stdout, c, q->K);
+  return count;
+}
+
+int srsran_pdcch_nr_decode_reg(srsran_pdcch_nr_t*                   q,
+                               cf_t*                                slot_symbols,
+                               const srsran_dmrs_pdcch_estimator_t* estimator,
+                               srsran_dci_msg_nr_t*                 dci_msg,
+                               srsran_pdcch_nr_res_t*               res)
+{
+  if (q == NULL || dci_msg == NULL || estimator == NULL || slot_symbols == NULL || res == NULL ||
+      q->reg_symbols == NULL) {
+    return SRSRAN_ERROR;
   }
 
-  // Unpack RNTI
-  uint8_t  unpacked_rnti[16] = {};
-  uint8_t* ptr               = unpacked_rnti;
-  srsran_bit_unpack(dci_msg->ctx.rnti, &ptr, 16);
+  struct timeval t[3];
+  if (q->meas_time_en) {
+    gettimeofday(&t[1], NULL);
+  }
 
-  // De-Scramble CRC with RNTI
-  srsran_vec_xor_bbb(unpacked_rnti, &c[q->K - 16], &c[q->K - 16], 16);
+  // The estimates must belong to the configured CORESET
+  if (estimator->coreset_bw != srsran_coreset_get_bw(&q->coreset) ||
+      estimator->coreset.duration != q->coreset.duration) {
+    ERROR("The channel estimator CORESET does not match the PDCCH CORESET");
+    return SRSRAN_ERROR;
+  }
 
-  // Check CRC
-  ptr                = &c[q->K - 24];
-  uint32_t checksum1 = srsran_crc_checksum(&q->crc24c, q->c, q->K);
-  uint32_t checksum2 = srsran_bit_pack(&ptr, 24);
-  res->crc           = checksum1 == checksum2;
+  // Calculate...
+  q->K = dci_msg->nof_bits + 24U;                                  // Payload size including CRC
+  q->M = (1U << dci_msg->ctx.location.L) * (SRSRAN_NRE - 3U) * 6U; // Number of RE
+  q->E = q->M * 2;                                                 // Number of Rate-Matched bits
 
-  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
-    PDCCH_INFO_RX("CRC={%06x, %06x}; msg=", checksum1, checksum2);
-    srsran_vec_fprint_hex(stdout, c, dci_msg->nof_bits);
+  // Get polar code
+  if (pdcch_nr_polar_code_get(q) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
   }
+  PDCCH_INFO_RX("K=%d; E=%d; M=%d; n=%d;", q->K, q->E, q->M, q->code.n);
 
-  // Copy DCI message
-  srsran_vec_u8_copy(dci_msg->payload, c, dci_msg->nof_bits);
+  // Get equalized symbols and soft bits, demodulating the REGs that were not used by other candidates
+  uint32_t m = pdcch_nr_reg_demod(q, slot_symbols, estimator, &dci_msg->ctx.location);
+  if (q->M != m) {
+    ERROR("Unmatch number of RE (%d != %d)", m, q->M);
+    return SRSRAN_ERROR;
+  }
+
+  // Measure EVM if configured
+  if (q->evm_buffer != NULL) {
+    res->evm = srsran_evm_run_b(q->evm_buffer, &q->modem_table, q->symbols, (int8_t*)q->f, q->E);
+  } else {
+    res->evm = NAN;
+  }
+
+  // Decode soft bits
+  if (pdcch_nr_decode_llr(q, dci_msg, res) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
 
   if (q->meas_time_en) {
     gettimeofday(&t[2], NULL);
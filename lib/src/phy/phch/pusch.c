@@ -43,14 +43,16 @@
 
 #define ACK_SNR_TH -1.0
 
-/* Allocate/deallocate PUSCH RBs to the resource grid
+/* Allocate/deallocate PUSCH RBs to the resource grid, for the slots [first_slot, first_slot + nof_slots)
  */
 static int pusch_cp(srsran_pusch_t*       q,
                     srsran_pusch_grant_t* grant,
                     cf_t*                 input,
                     cf_t*                 output,
                     bool                  is_shortened,
-                    bool                  advance_input)
+                    bool                  advance_input,
+                    uint32_t              first_slot,
+                    uint32_t              nof_slots)
 {
   cf_t* in_ptr  = input;
   cf_t* out_ptr = output;
@@ -59,7 +61,7 @@ static int pusch_cp(srsran_pusch_t*       q,
   if (SRSRAN_CP_ISEXT(q->cell.cp)) {
     L_ref = 2;
   }
-  for (uint32_t slot = 0; slot < 2; slot++) {
+  for (uint32_t slot = first_slot; slot < first_slot + nof_slots; slot++) {
     uint32_t N_srs = 0;
     if (is_shortened && slot == 1) {
       N_srs = 1;
@@ -96,12 +98,17 @@ static int pusch_cp(srsran_pusch_t*       q,
 
 static int pusch_put(srsran_pusch_t* q, srsran_pusch_grant_t* grant, cf_t* input, cf_t* output, bool is_shortened)
 {
-  return pusch_cp(q, grant, input, output, is_shortened, true);
+  return pusch_cp(q, grant, input, output, is_shortened, true, 0, SRSRAN_NOF_SLOTS_PER_SF);
 }
 
-static int pusch_get(srsran_pusch_t* q, srsran_pusch_grant_t* grant, cf_t* input, cf_t* output, bool is_shortened)
+static int pusch_get_slot(srsran_pusch_t*       q,
+                          srsran_pusch_grant_t* grant,
+                          cf_t*                 input,
+                          cf_t*                 output,
+                          bool                  is_shortened,
+                          uint32_t              slot)
 {
-  return pusch_cp(q, grant, input, output, is_shortened, false);
+  return pusch_cp(q, grant, input, output, is_shortened, false, slot, 1);
 }
 
 /** Initializes the PDCCH transmitter and receiver */
@@ -355,110 +362,163 @@ int srsran_pusch_encode(srsran_pusch_t*      q,
 
 /** Decodes the PUSCH from the received symbols
  */
-int srsran_pusch_decode(srsran_pusch_t*        q,
-                        srsran_ul_sf_cfg_t*    sf,
-                        srsran_pusch_cfg_t*    cfg,
-                        srsran_chest_ul_res_t* channel,
-                        cf_t*                  sf_symbols,
-                        srsran_pusch_res_t*    out)
+int srsran_pusch_demod_slot(srsran_pusch_t*        q,
+                            srsran_ul_sf_cfg_t*    sf,
+                            srsran_pusch_cfg_t*    cfg,
+                            srsran_chest_ul_res_t* channel,
+                            cf_t*                  sf_symbols,
+                            uint32_t               slot_idx,
+                            void*                  llr,
+                            srsran_pusch_res_t*    out)
 {
-  int      ret = SRSRAN_ERROR_INVALID_INPUTS;
-  uint32_t n;
-
-  if (q != NULL && sf_symbols != NULL && out != NULL && cfg != NULL) {
-    struct timeval t[3];
-    if (cfg->meas_time_en) {
-      gettimeofday(&t[1], NULL);
-    }
+  if (q == NULL || sf == NULL || cfg == NULL || channel == NULL || sf_symbols == NULL || llr == NULL || out == NULL ||
+      slot_idx >= SRSRAN_NOF_SLOTS_PER_SF) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
 
-    /* Limit UL modulation if not supported by the UE or disabled by higher layers */
-    if (!cfg->enable_64qam) {
-      if (cfg->grant.tb.mod >= SRSRAN_MOD_64QAM) {
-        cfg->grant.tb.mod      = SRSRAN_MOD_16QAM;
-        cfg->grant.tb.nof_bits = cfg->grant.nof_re * srsran_mod_bits_x_symbol(SRSRAN_MOD_16QAM);
-      }
+  /* Limit UL modulation if not supported by the UE or disabled by higher layers */
+  if (!cfg->enable_64qam) {
+    if (cfg->grant.tb.mod >= SRSRAN_MOD_64QAM) {
+      cfg->grant.tb.mod      = SRSRAN_MOD_16QAM;
+      cfg->grant.tb.nof_bits = cfg->grant.nof_re * srsran_mod_bits_x_symbol(SRSRAN_MOD_16QAM);
     }
+  }
 
-    INFO("Decoding PUSCH SF: %d, Mod %s, NofBits: %d, NofRE: %d, NofSymbols=%d, NofBitsE: %d, rv_idx: %d",
-         sf->tti % 10,
-         srsran_mod_string(cfg->grant.tb.mod),
-         cfg->grant.tb.tbs,
-         cfg->grant.nof_re,
-         cfg->grant.nof_symb,
-         cfg->grant.tb.nof_bits,
-         cfg->grant.tb.rv);
+  /* extract symbols, the ones of the first slot come first in the soft bits */
+  uint32_t nof_re    = pusch_get_slot(q, &cfg->grant, sf_symbols, q->d, sf->shortened, slot_idx);
+  uint32_t re_offset = (slot_idx == 0) ? 0 : cfg->grant.nof_re - nof_re;
+  if (nof_re > cfg->grant.nof_re ||
+      (slot_idx == SRSRAN_NOF_SLOTS_PER_SF - 1 && re_offset + nof_re != cfg->grant.nof_re)) {
+    ERROR("Error expecting %d symbols but got %d in slot %d", cfg->grant.nof_re, nof_re, slot_idx);
+    return SRSRAN_ERROR;
+  }
+  uint32_t nof_symb = nof_re / (cfg->grant.L_prb * SRSRAN_NRE);
 
-    /* extract symbols */
-    n = pusch_get(q, &cfg->grant, sf_symbols, q->d, sf->shortened);
-    if (n != cfg->grant.nof_re) {
-      ERROR("Error expecting %d symbols but got %d", cfg->grant.nof_re, n);
-      return SRSRAN_ERROR;
+  // Measure Energy per Resource Element, averaged with the one of the previous slot
+  if (cfg->meas_epre_en) {
+    float epre = srsran_vec_avg_power_cf(q->d, nof_re);
+    if (slot_idx > 0) {
+      epre = (srsran_convert_dB_to_power(out->epre_dbfs) * re_offset + epre * nof_re) / (re_offset + nof_re);
     }
+    out->epre_dbfs = srsran_convert_power_to_dB(epre);
+  } else {
+    out->epre_dbfs = NAN;
+  }
 
-    // Measure Energy per Resource Element
-    if (cfg->meas_epre_en) {
-      out->epre_dbfs = srsran_convert_power_to_dB(srsran_vec_avg_power_cf(q->d, n));
-    } else {
-      out->epre_dbfs = NAN;
-    }
+  /* extract channel estimates */
+  if (pusch_get_slot(q, &cfg->grant, channel->ce, q->ce, sf->shortened, slot_idx) != nof_re) {
+    ERROR("Error expecting %d channel estimates in slot %d", nof_re, slot_idx);
+    return SRSRAN_ERROR;
+  }
 
-    /* extract channel estimates */
-    n = pusch_get(q, &cfg->grant, channel->ce, q->ce, sf->shortened);
-    if (n != cfg->grant.nof_re) {
-      ERROR("Error expecting %d symbols but got %d", cfg->grant.nof_re, n);
-      return SRSRAN_ERROR;
-    }
+  // Equalization
+  srsran_predecoding_single(q->d, q->ce, q->z, NULL, nof_re, 1.0f, channel->noise_estimate);
 
-    // Equalization
-    srsran_predecoding_single(q->d, q->ce, q->z, NULL, cfg->grant.nof_re, 1.0f, channel->noise_estimate);
+  // DFT predecoding
+  srsran_dft_precoding(&q->dft_precoding, q->z, q->d, cfg->grant.L_prb, nof_symb);
 
-    // DFT predecoding
-    srsran_dft_precoding(&q->dft_precoding, q->z, q->d, cfg->grant.L_prb, cfg->grant.nof_symb);
+  // Soft demodulation
+  uint32_t Qm       = srsran_mod_bits_x_symbol(cfg->grant.tb.mod);
+  uint32_t nof_bits = nof_re * Qm;
+  void*    slot_llr = q->llr_is_8bit ? (void*)&((int8_t*)llr)[re_offset * Qm] : (void*)&((int16_t*)llr)[re_offset * Qm];
+  if (q->llr_is_8bit) {
+    srsran_demod_soft_demodulate_b(cfg->grant.tb.mod, q->d, slot_llr, nof_re);
+  } else {
+    srsran_demod_soft_demodulate_s(cfg->grant.tb.mod, q->d, slot_llr, nof_re);
+  }
 
-    // Soft demodulation
+  // RMS EVM, averaged with the one of the previous slot
+  if (cfg->meas_evm_en && q->evm_buffer) {
+    float evm;
     if (q->llr_is_8bit) {
-      srsran_demod_soft_demodulate_b(cfg->grant.tb.mod, q->d, q->q, cfg->grant.nof_re);
+      evm = srsran_evm_run_b(q->evm_buffer, &q->mod[cfg->grant.tb.mod], q->d, slot_llr, nof_bits);
     } else {
-      srsran_demod_soft_demodulate_s(cfg->grant.tb.mod, q->d, q->q, cfg->grant.nof_re);
+      evm = srsran_evm_run_s(q->evm_buffer, &q->mod[cfg->grant.tb.mod], q->d, slot_llr, nof_bits);
     }
-
-    if (cfg->meas_evm_en && q->evm_buffer) {
-      if (q->llr_is_8bit) {
-        out->evm = srsran_evm_run_b(q->evm_buffer, &q->mod[cfg->grant.tb.mod], q->d, q->q, cfg->grant.tb.nof_bits);
-      } else {
-        out->evm = srsran_evm_run_s(q->evm_buffer, &q->mod[cfg->grant.tb.mod], q->d, q->q, cfg->grant.tb.nof_bits);
-      }
-    } else {
-      out->evm = NAN;
+    if (slot_idx > 0) {
+      evm = sqrtf((out->evm * out->evm * re_offset + evm * evm * nof_re) / (re_offset + nof_re));
     }
+    out->evm = evm;
+  } else {
+    out->evm = NAN;
+  }
 
-    // Descrambling
-    if (q->llr_is_8bit) {
-      srsran_sequence_pusch_apply_c(
-          q->q, q->q, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
-    } else {
-      srsran_sequence_pusch_apply_s(
-          q->q, q->q, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
-    }
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_pusch_decode_llr(srsran_pusch_t*     q,
+                            srsran_ul_sf_cfg_t* sf,
+                            srsran_pusch_cfg_t* cfg,
+                            void*               llr,
+                            srsran_pusch_res_t* out)
+{
+  if (q == NULL || sf == NULL || cfg == NULL || llr == NULL || out == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  INFO("Decoding PUSCH SF: %d, Mod %s, NofBits: %d, NofRE: %d, NofSymbols=%d, NofBitsE: %d, rv_idx: %d",
+       sf->tti % 10,
+       srsran_mod_string(cfg->grant.tb.mod),
+       cfg->grant.tb.tbs,
+       cfg->grant.nof_re,
+       cfg->grant.nof_symb,
+       cfg->grant.tb.nof_bits,
+       cfg->grant.tb.rv);
+
+  // Descrambling
+  if (q->llr_is_8bit) {
+    srsran_sequence_pusch_apply_c(
+        llr, llr, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
+  } else {
+    srsran_sequence_pusch_apply_s(
+        llr, llr, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
+  }
+
+  // Generate packed sequence for UCI decoder
+  uint8_t* c = (uint8_t*)q->z; // Reuse Z
+  srsran_sequence_pusch_gen_unpack(
+      c, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
+
+  // Set max number of iterations
+  srsran_sch_set_max_noi(&q->ul_sch, cfg->max_nof_iterations);
 
-    // Generate packed sequence for UCI decoder
-    uint8_t* c = (uint8_t*)q->z; // Reuse Z
-    srsran_sequence_pusch_gen_unpack(
-        c, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
+  // Decode
+  int ret  = srsran_ulsch_decode(&q->ul_sch, cfg, llr, q->g, c, out->data, &out->uci);
+  out->crc = (ret == 0);
 
-    // Set max number of iterations
-    srsran_sch_set_max_noi(&q->ul_sch, cfg->max_nof_iterations);
+  // Save number of iterations
+  out->avg_iterations_block = q->ul_sch.avg_iterations;
 
-    // Decode
-    ret      = srsran_ulsch_decode(&q->ul_sch, cfg, q->q, q->g, c, out->data, &out->uci);
-    out->crc = (ret == 0);
+  // Save O_cqi for power control
+  cfg->last_O_cqi = srsran_cqi_size(&cfg->uci_cfg.cqi);
 
-    // Save number of iterations
-    out->avg_iterations_block = q->ul_sch.avg_iterations;
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_pusch_decode(srsran_pusch_t*        q,
+                        srsran_ul_sf_cfg_t*    sf,
+                        srsran_pusch_cfg_t*    cfg,
+                        srsran_chest_ul_res_t* channel,
+                        cf_t*                  sf_symbols,
+                        srsran_pusch_res_t*    out)
+{
+  int ret = SRSRAN_ERROR_INVALID_INPUTS;
+
+  if (q != NULL && sf_symbols != NULL && out != NULL && cfg != NULL) {
+    struct timeval t[3];
+    if (cfg->meas_time_en) {
+      gettimeofday(&t[1], NULL);
+    }
+
+    // Demodulate both slots into the PUSCH soft bits buffer
+    for (uint32_t slot_idx = 0; slot_idx < SRSRAN_NOF_SLOTS_PER_SF; slot_idx++) {
+      ret = srsran_pusch_demod_slot(q, sf, cfg, channel, sf_symbols, slot_idx, q->q, out);
+      if (ret < SRSRAN_SUCCESS) {
+        return ret;
+      }
+    }
 
-    // Save O_cqi for power control
-    cfg->last_O_cqi = srsran_cqi_size(&cfg->uci_cfg.cqi);
-    ret             = SRSRAN_SUCCESS;
+    ret = srsran_pusch_decode_llr(q, sf, cfg, q->q, out);
 
     if (cfg->meas_time_en) {
       gettimeofday(&t[2], NULL);
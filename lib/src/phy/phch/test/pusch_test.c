@@ -187,6 +187,7 @@ int main(int argc, char** argv)
   srsran_pusch_t         pusch_rx   = {};
   uint8_t*               data       = NULL;
   uint8_t*               data_rx    = NULL;
+  int16_t*               llr        = NULL;
   cf_t*                  sf_symbols = NULL;
   int                    ret        = -1;
   struct timeval         t[3];
@@ -267,6 +268,12 @@ int main(int argc, char** argv)
     exit(-1);
   }
 
+  llr = srsran_vec_i16_malloc(nof_re * srsran_mod_bits_x_symbol(SRSRAN_MOD_64QAM));
+  if (!llr) {
+    perror("malloc");
+    exit(-1);
+  }
+
   if (srsran_softbuffer_tx_init(&softbuffer_tx, 100)) {
     ERROR("Error initiating soft buffer");
     goto quit;
@@ -383,6 +390,23 @@ int main(int argc, char** argv)
       }
     }
 
+    // Demodulating slot by slot, as the eNB does while it receives the subframe, decodes the same data and UCI
+    srsran_pusch_res_t pusch_res_slots = {};
+    pusch_res_slots.data               = data_rx;
+    srsran_softbuffer_rx_reset(&softbuffer_rx);
+    srsran_vec_u8_zero(data_rx, (size_t)cfg.grant.tb.tbs / 8);
+    for (uint32_t slot_idx = 0; slot_idx < SRSRAN_NOF_SLOTS_PER_SF && r == SRSRAN_SUCCESS; slot_idx++) {
+      r = srsran_pusch_demod_slot(&pusch_rx, &ul_sf, &cfg, &chest_res, sf_symbols, slot_idx, llr, &pusch_res_slots);
+    }
+    if (r == SRSRAN_SUCCESS) {
+      r = srsran_pusch_decode_llr(&pusch_rx, &ul_sf, &cfg, llr, &pusch_res_slots);
+    }
+    if (r || pusch_res_slots.crc != pusch_res.crc || memcmp(data_rx, data, (size_t)cfg.grant.tb.tbs / 8) != 0 ||
+        memcmp(&pusch_res_slots.uci, &pusch_res.uci, sizeof(srsran_uci_value_t)) != 0) {
+      printf("Slot by slot decoding does not match\n");
+      ret = SRSRAN_ERROR;
+    }
+
     if (ret) {
       goto quit;
     }
@@ -415,6 +439,9 @@ quit:
   if (data_rx) {
     free(data_rx);
   }
+  if (llr) {
+    free(llr);
+  }
   if (ret) {
     printf("Error\n");
   } else {
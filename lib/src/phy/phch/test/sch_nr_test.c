@@ -26,6 +26,7 @@
 #include "srsran/phy/utils/vector.h"
 #include <getopt.h>
 #include <srsran/phy/utils/random.h>
+#include <sys/time.h>
 
 static srsran_carrier_nr_t carrier = SRSRAN_DEFAULT_CARRIER_NR;
 
@@ -33,6 +34,10 @@ static uint32_t            n_prb     = 0;  // Set to 0 for steering
 static uint32_t            mcs       = 30; // Set to 30 for steering
 static uint32_t            rv        = 4;  // Set to 30 for steering
 static srsran_sch_cfg_nr_t pdsch_cfg = {};
+static bool                use_slab  = false; // Take the Rx code blocks from a slab on demand
+static uint32_t            nof_ue    = 64;    // Number of UEs for the memory footprint report
+
+#define SCH_NR_TEST_NOF_HARQ 16
 
 static void usage(char* prog)
 {
@@ -44,13 +49,15 @@ static void usage(char* prog)
   printf("\t-T Provide MCS table (64qam, 256qam, 64qamLowSE) [Default %s]\n",
          srsran_mcs_table_to_str(pdsch_cfg.sch_cfg.mcs_table));
   printf("\t-L Provide number of layers [Default %d]\n", carrier.max_mimo_layers);
+  printf("\t-s Use an Rx soft-buffer with 8-bit soft bits taken from a slab [Default %s]\n", use_slab ? "yes" : "no");
+  printf("\t-U Number of UEs for the soft-buffer memory report [Default %d]\n", nof_ue);
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
 
 int parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "PpmTLvr")) != -1) {
+  while ((opt = getopt(argc, argv, "PpmTLvrsU")) != -1) {
     switch (opt) {
       case 'P':
         carrier.nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -70,6 +77,12 @@ int parse_args(int argc, char** argv)
       case 'L':
         carrier.max_mimo_layers = (uint32_t)strtol(argv[optind], NULL, 10);
         break;
+      case 's':
+        use_slab = true;
+        break;
+      case 'U':
+        nof_ue = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -89,6 +102,11 @@ int main(int argc, char** argv)
   srsran_sch_nr_t sch_nr_rx = {};
   srsran_random_t rand_gen  = srsran_random_init(1234);
 
+  srsran_softbuffer_slab_t slab        = {};
+  size_t                   max_rx_mem  = 0;
+  uint64_t                 decode_us   = 0;
+  uint64_t                 decode_bits = 0;
+
   uint8_t* data_tx = srsran_vec_u8_malloc(1024 * 1024);
   uint8_t* encoded = srsran_vec_u8_malloc(1024 * 1024 * 8);
   int8_t*  llr     = srsran_vec_i8_malloc(1024 * 1024 * 8);
@@ -139,8 +157,15 @@ int main(int argc, char** argv)
     goto clean_exit;
   }
 
-  if (srsran_softbuffer_rx_init_guru(&softbuffer_rx, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB) <
-      SRSRAN_SUCCESS) {
+  if (use_slab) {
+    if (srsran_softbuffer_slab_init(&slab, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, 1, SRSRAN_LDPC_MAX_LEN_ENCODED_CB, 1) <
+            SRSRAN_SUCCESS ||
+        srsran_softbuffer_rx_init_slab(&softbuffer_rx, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, &slab) < SRSRAN_SUCCESS) {
+      ERROR("Error init soft-buffer");
+      goto clean_exit;
+    }
+  } else if (srsran_softbuffer_rx_init_guru(
+                 &softbuffer_rx, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB) < SRSRAN_SUCCESS) {
     ERROR("Error init soft-buffer");
     goto clean_exit;
   }
@@ -204,14 +229,26 @@ int main(int argc, char** argv)
         }
 
         tb.softbuffer.rx = &softbuffer_rx;
-        srsran_softbuffer_rx_reset(tb.softbuffer.rx);
+        if (use_slab) {
+          // Attach only the code blocks of this TB, like the gNB does when it schedules a new transmission
+          srsran_softbuffer_rx_reset_tbs(tb.softbuffer.rx, tb.tbs);
+        } else {
+          srsran_softbuffer_rx_reset(tb.softbuffer.rx);
+        }
+        max_rx_mem = SRSRAN_MAX(max_rx_mem, srsran_softbuffer_rx_mem_size(tb.softbuffer.rx));
 
         srsran_sch_tb_res_nr_t res = {};
         res.payload                = data_rx;
+        struct timeval t[3];
+        gettimeofday(&t[1], NULL);
         if (srsran_dlsch_nr_decode(&sch_nr_rx, &pdsch_cfg.sch_cfg, &tb, llr, &res) < SRSRAN_SUCCESS) {
           ERROR("Error encoding");
           goto clean_exit;
         }
+        gettimeofday(&t[2], NULL);
+        get_time_interval(t);
+        decode_us += t[0].tv_sec * 1000000UL + t[0].tv_usec;
+        decode_bits += tb.tbs;
 
         if (rv == 0) {
           if (!res.crc) {
@@ -230,10 +267,33 @@ int main(int argc, char** argv)
         }
 
         INFO("n_prb=%d; mcs=%d; rv=%d TBS=%d; PASSED!\n", n_prb, mcs, rv, tb.tbs);
+
+        // The TB is decoded, return its code blocks
+        srsran_softbuffer_rx_release(tb.softbuffer.rx);
       }
     }
   }
 
+  // Soft-buffer memory if every HARQ process of every UE held the largest TB of the test
+  size_t nof_rx_buffers = (size_t)nof_ue * SCH_NR_TEST_NOF_HARQ;
+  printf("Rx soft-buffer (%s): %.1f kB per HARQ process, %.1f MB for %d UEs with %d HARQ processes\n",
+         use_slab ? "8-bit slab" : "16-bit",
+         (double)max_rx_mem / 1e3,
+         (double)(max_rx_mem * nof_rx_buffers) / 1e6,
+         nof_ue,
+         SCH_NR_TEST_NOF_HARQ);
+  if (use_slab) {
+    printf("Rx soft-buffer slab: %d code blocks at most in use, %.1f MB allocated\n",
+           srsran_softbuffer_slab_max_used(&slab),
+           (double)srsran_softbuffer_slab_mem_size(&slab) / 1e6);
+  }
+  if (decode_us > 0) {
+    printf("Decoded %.1f Mbit in %.1f ms, %.1f Mbps\n",
+           (double)decode_bits / 1e6,
+           (double)decode_us / 1e3,
+           (double)decode_bits / (double)decode_us);
+  }
+
   ret = SRSRAN_SUCCESS;
 
 clean_exit:
@@ -254,6 +314,7 @@ clean_exit:
   }
   srsran_softbuffer_tx_free(&softbuffer_tx);
   srsran_softbuffer_rx_free(&softbuffer_rx);
+  srsran_softbuffer_slab_free(&slab);
 
   return ret;
 }
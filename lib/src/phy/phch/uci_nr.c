@@ -84,12 +84,21 @@ int srsran_uci_nr_init(srsran_uci_nr_t* q, const srsran_uci_nr_args_t* args)
 
   srsran_polar_encoder_type_t polar_encoder_type = SRSRAN_POLAR_ENCODER_PIPELINED;
   srsran_polar_decoder_type_t polar_decoder_type = SRSRAN_POLAR_DECODER_SSC_C;
+  uint32_t                    polar_list_size    = SRSRAN_MAX(args->polar_list_size, 1);
+  if (polar_list_size > 1) {
+    polar_decoder_type = SRSRAN_POLAR_DECODER_SCL_C;
+  }
 #ifdef LV_HAVE_AVX2
   if (!args->disable_simd) {
     polar_encoder_type = SRSRAN_POLAR_ENCODER_AVX2;
-    polar_decoder_type = SRSRAN_POLAR_DECODER_SSC_C_AVX2;
+    polar_decoder_type = (polar_list_size > 1) ? SRSRAN_POLAR_DECODER_SCL_C_AVX2 : SRSRAN_POLAR_DECODER_SSC_C_AVX2;
   }
 #endif // LV_HAVE_AVX2
+#ifdef LV_HAVE_AVX512
+  if (!args->disable_simd && polar_list_size > 1) {
+    polar_decoder_type = SRSRAN_POLAR_DECODER_SCL_C_AVX512;
+  }
+#endif // LV_HAVE_AVX512
 
   if (srsran_polar_code_init(&q->code)) {
     ERROR("Initialising polar code");
@@ -101,7 +110,7 @@ int srsran_uci_nr_init(srsran_uci_nr_t* q, const srsran_uci_nr_args_t* args)
     return SRSRAN_ERROR;
   }
 
-  if (srsran_polar_decoder_init(&q->decoder, polar_decoder_type, NMAX_LOG) < SRSRAN_SUCCESS) {
+  if (srsran_polar_decoder_init_list(&q->decoder, polar_decoder_type, NMAX_LOG, polar_list_size) < SRSRAN_SUCCESS) {
     ERROR("Initialising polar encoder");
     return SRSRAN_ERROR;
   }
@@ -140,7 +149,7 @@ int srsran_uci_nr_init(srsran_uci_nr_t* q, const srsran_uci_nr_args_t* args)
     return SRSRAN_ERROR;
   }
 
-  q->allocated = srsran_vec_u8_malloc(UCI_NR_POLAR_MAX);
+  q->allocated = srsran_vec_u8_malloc(UCI_NR_POLAR_MAX * SRSRAN_POLAR_DECODER_LIST_SIZE_MAX);
   if (q->allocated == NULL) {
     ERROR("Error malloc");
     return SRSRAN_ERROR;
@@ -757,6 +766,39 @@ uci_nr_encode_11_1706_bit(srsran_uci_nr_t* q, const srsran_uci_cfg_nr_t* cfg, ui
   return E_uci;
 }
 
+/**
+ * @brief Undoes the channel allocation of a decoded polar code block into q->c and checks its CRC
+ * @return True if the CRC matches, false otherwise
+ */
+static bool uci_nr_polar_check_cb(srsran_uci_nr_t* q,
+                                  srsran_crc_t*    crc,
+                                  const uint8_t*   allocated,
+                                  uint32_t         A_r,
+                                  uint32_t         r,
+                                  uint32_t         C)
+{
+  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
+    UCI_NR_INFO_RX("Polar alloc %d/%d ", r, C);
+    srsran_vec_fprint_byte(stdout, allocated, q->code.N);
+  }
+
+  // Undo channel allocation
+  srsran_polar_chanalloc_rx(allocated, q->c, q->code.K, q->code.nPC, q->code.K_set, q->code.PC_set);
+
+  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
+    UCI_NR_INFO_RX("Polar cb %d/%d c=", r, C);
+    srsran_vec_fprint_byte(stdout, q->c, q->code.K);
+  }
+
+  // Calculate checksum
+  uint8_t* ptr       = &q->c[A_r];
+  uint32_t checksum1 = srsran_crc_checksum(crc, q->c, A_r);
+  uint32_t checksum2 = srsran_bit_pack(&ptr, (uint32_t)crc->order);
+  UCI_NR_INFO_RX("Checking %d/%d CRC%d={%02x,%02x}", r, C, crc->order, checksum1, checksum2);
+
+  return checksum1 == checksum2;
+}
+
 static int uci_nr_decode_11_1706_bit(srsran_uci_nr_t*           q,
                                      const srsran_uci_cfg_nr_t* cfg,
                                      uint32_t                   A,
@@ -808,31 +850,22 @@ static int uci_nr_decode_11_1706_bit(srsran_uci_nr_t*           q,
     int8_t* d = (int8_t*)q->d;
     srsran_polar_rm_rx_c(&q->rm_rx, &llr[E_r * r], d, E_r, q->code.n, K_r, UCI_NR_POLAR_RM_IBIL);
 
-    // Decode bits
-    if (srsran_polar_decoder_decode_c(&q->decoder, d, q->allocated, q->code.n, q->code.F_set, q->code.F_set_size) <
-        SRSRAN_SUCCESS) {
+    // Decode bits, list decoders give several candidates sorted by likelihood
+    int nof_candidates = srsran_polar_decoder_decode_list_c(
+        &q->decoder, d, q->allocated, q->code.n, q->code.F_set, q->code.F_set_size);
+    if (nof_candidates < 1) {
       return SRSRAN_ERROR;
     }
 
-    if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
-      UCI_NR_INFO_RX("Polar alloc %d/%d ", r, C);
-      srsran_vec_fprint_byte(stdout, q->allocated, q->code.N);
+    // Take the first candidate passing the CRC, or the most likely one if none does
+    bool crc_ok = false;
+    for (int i = 0; i < nof_candidates && !crc_ok; i++) {
+      crc_ok = uci_nr_polar_check_cb(q, crc, q->allocated + i * q->code.N, A_prime / C, r, C);
     }
-
-    // Undo channel allocation
-    srsran_polar_chanalloc_rx(q->allocated, q->c, q->code.K, q->code.nPC, q->code.K_set, q->code.PC_set);
-
-    if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
-      UCI_NR_INFO_RX("Polar cb %d/%d c=", r, C);
-      srsran_vec_fprint_byte(stdout, q->c, K_r);
+    if (!crc_ok && nof_candidates > 1) {
+      uci_nr_polar_check_cb(q, crc, q->allocated, A_prime / C, r, C);
     }
-
-    // Calculate checksum
-    uint8_t* ptr       = &q->c[A_prime / C];
-    uint32_t checksum1 = srsran_crc_checksum(crc, q->c, A_prime / C);
-    uint32_t checksum2 = srsran_bit_pack(&ptr, L);
-    (*decoded_ok)      = ((*decoded_ok) && (checksum1 == checksum2));
-    UCI_NR_INFO_RX("Checking %d/%d CRC%d={%02x,%02x}", r, C, L, checksum1, checksum2);
+    (*decoded_ok) = ((*decoded_ok) && crc_ok);
 
     // Prefix (A_prime - A) zeros for the first CB only
     if (r == 0) {
@@ -24,43 +24,68 @@
 #include <string.h>
 
 #include "srsran/phy/sync/sss.h"
+#include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector.h"
 
 #define MAX_M 3
 
-static void corr_all_zs(cf_t z[SRSRAN_SSS_N], float s[SRSRAN_SSS_N][SRSRAN_SSS_N - 1], float output[SRSRAN_SSS_N])
+/* Correlates the nof_k elements of z with all the sequences of the transposed table s_t, accumulating the squared
+ * magnitude of the result in output. Each row of s_t holds element k of the 31 sequences, so the 31 correlations are
+ * computed at once with one multiply-add per row and SIMD word.
+ */
+static void corr_all_t(const cf_t*  z,
+                       const float  s_t[][SRSRAN_SSS_N_PAD],
+                       uint32_t     nof_k,
+                       bool         accumulate,
+                       float        output[SRSRAN_SSS_N])
 {
-  uint32_t m;
-  cf_t     tmp[SRSRAN_SSS_N];
+  float    acc_re[SRSRAN_SSS_N_PAD];
+  float    acc_im[SRSRAN_SSS_N_PAD];
+  uint32_t m = 0;
+
+#if SRSRAN_SIMD_F_SIZE
+  for (; m + SRSRAN_SIMD_F_SIZE <= SRSRAN_SSS_N_PAD; m += SRSRAN_SIMD_F_SIZE) {
+    simd_f_t re = srsran_simd_f_zero();
+    simd_f_t im = srsran_simd_f_zero();
+    for (uint32_t k = 0; k < nof_k; k++) {
+      simd_f_t s = srsran_simd_f_loadu(&s_t[k][m]);
+      re         = srsran_simd_f_add(re, srsran_simd_f_mul(srsran_simd_f_set1(__real__ z[k]), s));
+      im         = srsran_simd_f_add(im, srsran_simd_f_mul(srsran_simd_f_set1(__imag__ z[k]), s));
+    }
+    srsran_simd_f_storeu(&acc_re[m], re);
+    srsran_simd_f_storeu(&acc_im[m], im);
+  }
+#endif /* SRSRAN_SIMD_F_SIZE */
+
+  for (; m < SRSRAN_SSS_N; m++) {
+    acc_re[m] = 0;
+    acc_im[m] = 0;
+    for (uint32_t k = 0; k < nof_k; k++) {
+      acc_re[m] += __real__ z[k] * s_t[k][m];
+      acc_im[m] += __imag__ z[k] * s_t[k][m];
+    }
+  }
 
   for (m = 0; m < SRSRAN_SSS_N; m++) {
-    tmp[m] = srsran_vec_dot_prod_cfc(z, s[m], SRSRAN_SSS_N - 1);
+    float corr = acc_re[m] * acc_re[m] + acc_im[m] * acc_im[m];
+    output[m]  = accumulate ? output[m] + corr : corr;
   }
-  srsran_vec_abs_square_cf(tmp, output, SRSRAN_SSS_N);
 }
 
-static void
-corr_all_sz_partial(cf_t z[SRSRAN_SSS_N], float s[SRSRAN_SSS_N][SRSRAN_SSS_N], uint32_t M, float output[SRSRAN_SSS_N])
+static void corr_all_zs(cf_t z[SRSRAN_SSS_N], float sd[SRSRAN_SSS_N - 1][SRSRAN_SSS_N_PAD], float output[SRSRAN_SSS_N])
+{
+  corr_all_t(z, (const float(*)[SRSRAN_SSS_N_PAD])sd, SRSRAN_SSS_N - 1, false, output);
+}
+
+static void corr_all_sz_partial(cf_t     z[SRSRAN_SSS_N],
+                                float    s[SRSRAN_SSS_N][SRSRAN_SSS_N_PAD],
+                                uint32_t M,
+                                float    output[SRSRAN_SSS_N])
 {
   uint32_t Nm = SRSRAN_SSS_N / M;
-  cf_t     tmp[SRSRAN_SSS_N];
-  float    tmp_abs[MAX_M - 1][SRSRAN_SSS_N];
-  int      j, m;
-  float*   ptr;
-
-  for (j = 0; j < M; j++) {
-    for (m = 0; m < SRSRAN_SSS_N; m++) {
-      tmp[m] = srsran_vec_dot_prod_cfc(&z[j * Nm], &s[m][j * Nm], Nm);
-    }
-    if (j == 0) {
-      ptr = output;
-    } else {
-      ptr = tmp_abs[j - 1];
-    }
-    srsran_vec_abs_square_cf(tmp, ptr, SRSRAN_SSS_N);
-  }
-  for (j = 1; j < M; j++) {
-    srsran_vec_sum_fff(tmp_abs[j - 1], output, output, SRSRAN_SSS_N);
+
+  for (uint32_t j = 0; j < M; j++) {
+    corr_all_t(&z[j * Nm], (const float(*)[SRSRAN_SSS_N_PAD])&s[j * Nm], Nm, j > 0, output);
   }
 }
 
@@ -200,14 +225,16 @@ void convert_tables(srsran_sss_fc_tables_t* fc_tables, srsran_sss_tables_t* in)
       fc_tables->z1[i][j] = (float)in->z1[i][j];
     }
   }
+  memset(fc_tables->s, 0, sizeof(fc_tables->s));
+  memset(fc_tables->sd, 0, sizeof(fc_tables->sd));
   for (i = 0; i < SRSRAN_SSS_N; i++) {
     for (j = 0; j < SRSRAN_SSS_N; j++) {
-      fc_tables->s[i][j] = (float)in->s[i][j];
+      fc_tables->s[j][i] = (float)in->s[i][j];
     }
   }
   for (i = 0; i < SRSRAN_SSS_N; i++) {
     for (j = 0; j < SRSRAN_SSS_N - 1; j++) {
-      fc_tables->sd[i][j] = (float)in->s[i][j + 1] * in->s[i][j];
+      fc_tables->sd[j][i] = (float)in->s[i][j + 1] * in->s[i][j];
     }
   }
   for (i = 0; i < 2; i++) {
@@ -405,18 +405,18 @@ void srsran_pss_set_ema_alpha(srsran_pss_t* q, float alpha)
   q->ema_alpha = alpha;
 }
 
-float compute_peak_sidelobe(srsran_pss_t* q, uint32_t corr_peak_pos, uint32_t conv_output_len)
+static float compute_peak_sidelobe_corr(const float* corr, uint32_t corr_peak_pos, uint32_t conv_output_len)
 {
   // Find end of peak lobe to the right
   int pl_ub = corr_peak_pos + 1;
-  while (q->conv_output_avg[pl_ub + 1] <= q->conv_output_avg[pl_ub] && pl_ub < conv_output_len) {
+  while (corr[pl_ub + 1] <= corr[pl_ub] && pl_ub < conv_output_len) {
     pl_ub++;
   }
   // Find end of peak lobe to the left
   int pl_lb;
   if (corr_peak_pos > 2) {
     pl_lb = corr_peak_pos - 1;
-    while (q->conv_output_avg[pl_lb - 1] <= q->conv_output_avg[pl_lb] && pl_lb > 1) {
+    while (corr[pl_lb - 1] <= corr[pl_lb] && pl_lb > 1) {
       pl_lb--;
     }
   } else {
@@ -429,11 +429,31 @@ float compute_peak_sidelobe(srsran_pss_t* q, uint32_t corr_peak_pos, uint32_t co
   }
   int sl_distance_left = pl_lb;
 
-  int   sl_right        = pl_ub + srsran_vec_max_fi(&q->conv_output_avg[pl_ub], sl_distance_right);
-  int   sl_left         = srsran_vec_max_fi(q->conv_output_avg, sl_distance_left);
-  float side_lobe_value = SRSRAN_MAX(q->conv_output_avg[sl_right], q->conv_output_avg[sl_left]);
+  int   sl_right        = pl_ub + srsran_vec_max_fi(&corr[pl_ub], sl_distance_right);
+  int   sl_left         = srsran_vec_max_fi(corr, sl_distance_left);
+  float side_lobe_value = SRSRAN_MAX(corr[sl_right], corr[sl_left]);
+
+  return corr[corr_peak_pos] / side_lobe_value;
+}
 
-  return q->conv_output_avg[corr_peak_pos] / side_lobe_value;
+float compute_peak_sidelobe(srsran_pss_t* q, uint32_t corr_peak_pos, uint32_t conv_output_len)
+{
+  return compute_peak_sidelobe_corr(q->conv_output_avg, corr_peak_pos, conv_output_len);
+}
+
+// Converts the position of the correlation peak into the position of the end of the PSS in the input
+static int pss_peak_to_input_pos(srsran_pss_t* q, uint32_t corr_peak_pos)
+{
+  if (q->decimate > 1) {
+    int decimation_correction = (q->filter.num_taps - 2);
+    corr_peak_pos             = corr_peak_pos - decimation_correction;
+    corr_peak_pos             = corr_peak_pos * q->decimate;
+  }
+
+  if (q->frame_size >= q->fft_size) {
+    return (int)corr_peak_pos;
+  }
+  return (int)corr_peak_pos + q->fft_size;
 }
 
 /** Performs time-domain PSS correlation.
@@ -518,19 +538,78 @@ int srsran_pss_find_pss(srsran_pss_t* q, const cf_t* input, float* corr_peak_val
     }
 #endif
 
+    ret = pss_peak_to_input_pos(q, corr_peak_pos);
+  }
+  return ret;
+}
+
+/** Correlates the input with the PSS sequences of the three N_id_2 in one pass.
+ * The input is decimated and transformed to the frequency domain once, then multiplied by each of the three PSS
+ * sequences, so that searching all the N_id_2 costs four FFT instead of six. The correlation of each N_id_2 is not
+ * averaged with previous calls and the object N_id_2 is not used nor modified.
+ *
+ * Stores in corr_peak_pos the position of the correlation peak of each N_id_2, in the same units returned by
+ * srsran_pss_find_pss(), and in corr_peak_value its value, as configured by SRSRAN_PSS_RETURN_PSR. The absolute peak
+ * values are saved in peak_value_all.
+ *
+ * Input buffer must be subframe_size long.
+ */
+int srsran_pss_find_pss_all(srsran_pss_t* q,
+                            const cf_t*   input,
+                            uint32_t      corr_peak_pos[SRSRAN_NOF_NID_2],
+                            float         corr_peak_value[SRSRAN_NOF_NID_2])
+{
+  if (q == NULL || input == NULL || corr_peak_pos == NULL || corr_peak_value == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t    conv_output_len = q->frame_size;
+  const cf_t* input_ptr       = input;
+
+#ifdef CONVOLUTION_FFT
+  if (q->frame_size >= q->fft_size) {
+    // Decimate and transform the input once for all the N_id_2
     if (q->decimate > 1) {
-      int decimation_correction = (q->filter.num_taps - 2);
-      corr_peak_pos             = corr_peak_pos - decimation_correction;
-      corr_peak_pos             = corr_peak_pos * q->decimate;
-    }
+      memcpy(q->tmp_input, input, (q->frame_size * q->decimate) * sizeof(cf_t));
+      srsran_filt_decim_cc_execute(&(q->filter),
+                                   q->tmp_input,
+                                   q->filter.downsampled_input,
+                                   q->filter.filter_output,
+                                   (q->frame_size * q->decimate));
+      input_ptr = q->filter.filter_output;
+    }
+    srsran_dft_run_c(&q->conv_fft.input_plan, input_ptr, q->conv_fft.input_fft);
+    conv_output_len = q->conv_fft.output_len - 1;
+  }
+#endif
 
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+#ifdef CONVOLUTION_FFT
     if (q->frame_size >= q->fft_size) {
-      ret = (int)corr_peak_pos;
-    } else {
-      ret = (int)corr_peak_pos + q->fft_size;
+      srsran_vec_prod_ccc(
+          q->conv_fft.input_fft, q->pss_signal_freq_full[N_id_2], q->conv_fft.output_fft, q->conv_fft.output_len);
+      srsran_dft_run_c(&q->conv_fft.output_plan, q->conv_fft.output_fft, q->conv_output);
+    } else
+#endif
+    {
+      for (int i = 0; i < q->frame_size; i++) {
+        q->conv_output[i] = srsran_vec_dot_prod_ccc(q->pss_signal_time[N_id_2], &input[i], q->fft_size);
+      }
     }
+
+    srsran_vec_abs_square_cf(q->conv_output, q->conv_output_abs, conv_output_len - 1);
+    uint32_t peak_pos         = srsran_vec_max_fi(q->conv_output_abs, conv_output_len - 1);
+    q->peak_value_all[N_id_2] = q->conv_output_abs[peak_pos];
+
+#ifdef SRSRAN_PSS_RETURN_PSR
+    corr_peak_value[N_id_2] = compute_peak_sidelobe_corr(q->conv_output_abs, peak_pos, conv_output_len);
+#else
+    corr_peak_value[N_id_2] = q->conv_output_abs[peak_pos];
+#endif
+    corr_peak_pos[N_id_2] = (uint32_t)pss_peak_to_input_pos(q, peak_pos);
   }
-  return ret;
+
+  return SRSRAN_SUCCESS;
 }
 
 /* Computes frequency-domain channel estimation of the PSS symbol
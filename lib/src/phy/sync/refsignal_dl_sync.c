@@ -88,11 +88,21 @@ static inline void refsignal_sf_prepare_correlation(srsran_refsignal_dl_sync_t*
   srsran_dft_run_c(&q->conv_fft_cc.filter_plan, ptr_filt, ptr_filt);
 }
 
-static inline void
-refsignal_sf_correlate(srsran_refsignal_dl_sync_t* q, cf_t* ptr_in, float* peak_value, uint32_t* peak_idx, float* rms)
+static inline void refsignal_sf_correlate(srsran_refsignal_dl_sync_t* q,
+                                          cf_t*                       ptr_in,
+                                          const cf_t*                 ptr_in_fft,
+                                          float*                      peak_value,
+                                          uint32_t*                   peak_idx,
+                                          float*                      rms)
 {
-  // Correlate
-  srsran_corr_fft_cc_run_opt(&q->conv_fft_cc, ptr_in, q->conv_fft_cc.filter_fft, q->correlation);
+  // Correlate, reusing the input transform if it is available
+  if (ptr_in_fft) {
+    srsran_conv_fft_cc_t* conv = &q->conv_fft_cc;
+    srsran_vec_prod_conj_ccc(ptr_in_fft, conv->filter_fft, conv->output_fft, conv->output_len);
+    srsran_dft_run_c(&conv->output_plan, conv->output_fft, q->correlation);
+  } else {
+    srsran_corr_fft_cc_run_opt(&q->conv_fft_cc, ptr_in, q->conv_fft_cc.filter_fft, q->correlation);
+  }
 
   // Find maximum, calculate RMS and peak
   uint32_t imax = srsran_vec_max_abs_ci(q->correlation, q->ifft.sf_sz);
@@ -299,6 +309,10 @@ void srsran_refsignal_dl_sync_free(srsran_refsignal_dl_sync_t* q)
       free(q->correlation);
     }
 
+    if (q->input_fft) {
+      free(q->input_fft);
+    }
+
     for (int i = 0; i < SRSRAN_NOF_SF_X_FRAME; i++) {
       if (q->sequences[i]) {
         free(q->sequences[i]);
@@ -309,7 +323,8 @@ void srsran_refsignal_dl_sync_free(srsran_refsignal_dl_sync_t* q)
   }
 }
 
-int refsignal_dl_sync_find_peak(srsran_refsignal_dl_sync_t* q, cf_t* buffer, uint32_t nsamples)
+static int
+refsignal_dl_sync_find_peak(srsran_refsignal_dl_sync_t* q, cf_t* buffer, uint32_t nsamples, bool use_input_fft)
 {
   int   ret        = SRSRAN_ERROR;
   float peak_value = 0.0f;
@@ -325,12 +340,13 @@ int refsignal_dl_sync_find_peak(srsran_refsignal_dl_sync_t* q, cf_t* buffer, uin
   refsignal_sf_prepare_correlation(q);
 
   // Correlation
-  for (uint32_t n = 0; n + q->conv_fft_cc.filter_len < nsamples; n += q->conv_fft_cc.input_len) {
+  for (uint32_t n = 0, w = 0; n + q->conv_fft_cc.filter_len < nsamples; n += q->conv_fft_cc.input_len, w++) {
     // Correlate, find maximum, calculate RMS and peak
-    uint32_t imax = 0;
-    float    peak = 0.0f;
-    float    rms  = 0.0f;
-    refsignal_sf_correlate(q, &buffer[n], &peak, &imax, &rms);
+    uint32_t    imax   = 0;
+    float       peak   = 0.0f;
+    float       rms    = 0.0f;
+    const cf_t* in_fft = use_input_fft ? &q->input_fft[w * q->conv_fft_cc.output_len] : NULL;
+    refsignal_sf_correlate(q, &buffer[n], in_fft, &peak, &imax, &rms);
 
     rms_avg += rms;
 
@@ -376,11 +392,8 @@ int refsignal_dl_sync_find_peak(srsran_refsignal_dl_sync_t* q, cf_t* buffer, uin
   return ret;
 }
 
-int srsran_refsignal_dl_sync_run(srsran_refsignal_dl_sync_t* q, cf_t* buffer, uint32_t nsamples)
+static void refsignal_dl_sync_measure(srsran_refsignal_dl_sync_t* q, cf_t* buffer, uint32_t nsamples, int peak_idx)
 {
-  if (q == NULL || buffer == NULL) {
-    return SRSRAN_ERROR_INVALID_INPUTS;
-  }
   uint32_t sf_len                 = q->ifft.sf_sz;
   uint32_t sf_count               = 0;
   float    rsrp_lin               = 0.0f;
@@ -395,9 +408,6 @@ int srsran_refsignal_dl_sync_run(srsran_refsignal_dl_sync_t* q, cf_t* buffer, ui
   float    rsrp_false_avg         = 0.0f;
   bool     false_alarm            = false;
 
-  // Stage 1: find peak
-  int peak_idx = refsignal_dl_sync_find_peak(q, buffer, nsamples);
-
   // Stage 2: Proccess subframes
   if (peak_idx >= 0) {
     // Calculate initial subframe index and sample
@@ -522,6 +532,88 @@ int srsran_refsignal_dl_sync_run(srsran_refsignal_dl_sync_t* q, cf_t* buffer, ui
   } else {
     refsignal_set_results_not_found(q);
   }
+}
+
+int srsran_refsignal_dl_sync_run(srsran_refsignal_dl_sync_t* q, cf_t* buffer, uint32_t nsamples)
+{
+  if (q == NULL || buffer == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Stage 1: find peak
+  int peak_idx = refsignal_dl_sync_find_peak(q, buffer, nsamples, false);
+
+  // Stage 2 and 3: measure and discard false alarms
+  refsignal_dl_sync_measure(q, buffer, nsamples, peak_idx);
+
+  return SRSRAN_SUCCESS;
+}
+
+static int refsignal_dl_sync_transform_input(srsran_refsignal_dl_sync_t* q, cf_t* buffer, uint32_t nsamples)
+{
+  srsran_conv_fft_cc_t* conv = &q->conv_fft_cc;
+
+  // Count correlation windows as refsignal_dl_sync_find_peak() does
+  uint32_t nof_windows = 0;
+  for (uint32_t n = 0; n + conv->filter_len < nsamples; n += conv->input_len) {
+    nof_windows++;
+  }
+
+  // Grow the buffer if needed, this only happens the first time or when the bandwidth increases
+  uint32_t len = nof_windows * conv->output_len;
+  if (len > q->input_fft_max_len) {
+    if (q->input_fft) {
+      free(q->input_fft);
+    }
+    q->input_fft = srsran_vec_cf_malloc(len);
+    if (q->input_fft == NULL) {
+      q->input_fft_max_len = 0;
+      return SRSRAN_ERROR;
+    }
+    q->input_fft_max_len = len;
+  }
+
+  for (uint32_t w = 0; w < nof_windows; w++) {
+    srsran_dft_run_c(&conv->input_plan, &buffer[w * conv->input_len], &q->input_fft[w * conv->output_len]);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_refsignal_dl_sync_run_batch(srsran_refsignal_dl_sync_t*      q,
+                                       srsran_cell_t                    cell,
+                                       const uint32_t*                  pci,
+                                       uint32_t                         nof_pci,
+                                       cf_t*                            buffer,
+                                       uint32_t                         nsamples,
+                                       srsran_refsignal_dl_sync_meas_t* meas)
+{
+  if (q == NULL || pci == NULL || buffer == NULL || meas == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  for (uint32_t i = 0; i < nof_pci; i++) {
+    cell.id = pci[i];
+    if (srsran_refsignal_dl_sync_set_cell(q, cell) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+
+    // All the cells share the bandwidth, so the correlation windows are the same for all of them
+    if (i == 0 && refsignal_dl_sync_transform_input(q, buffer, nsamples) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+
+    int peak_idx = refsignal_dl_sync_find_peak(q, buffer, nsamples, true);
+    refsignal_dl_sync_measure(q, buffer, nsamples, peak_idx);
+
+    meas[i].pci        = pci[i];
+    meas[i].found      = q->found;
+    meas[i].rsrp_dBfs  = q->rsrp_dBfs;
+    meas[i].rssi_dBfs  = q->rssi_dBfs;
+    meas[i].rsrq_dB    = q->rsrq_dB;
+    meas[i].cfo_Hz     = q->cfo_Hz;
+    meas[i].peak_index = q->peak_index;
+  }
 
   return SRSRAN_SUCCESS;
 }
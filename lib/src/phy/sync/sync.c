@@ -589,6 +589,26 @@ static float cfo_cp_estimate(srsran_sync_t* q, const cf_t* input)
   return cfo;
 }
 
+// Estimates the CFO using the CP, averages it and corrects the input into the internal buffer
+static const cf_t* cfo_cp_correct(srsran_sync_t* q, const cf_t* input)
+{
+  float cfo_cp = cfo_cp_estimate(q, input);
+
+  if (!q->cfo_cp_is_set) {
+    q->cfo_cp_mean   = cfo_cp;
+    q->cfo_cp_is_set = true;
+  } else {
+    /* compute exponential moving average CFO */
+    q->cfo_cp_mean = SRSRAN_VEC_EMA(cfo_cp, q->cfo_cp_mean, q->cfo_ema_alpha);
+  }
+
+  DEBUG("CP-CFO: estimated=%f, mean=%f", cfo_cp, q->cfo_cp_mean);
+
+  /* Correct CFO with the averaged CFO estimation */
+  srsran_cfo_correct(&q->cfo_corr_frame, input, q->temp, -q->cfo_cp_mean / q->fft_size);
+  return q->temp;
+}
+
 static int cfo_i_estimate(srsran_sync_t* q, const cf_t* input, int find_offset, int* peak_pos, int* cfo_i)
 {
   float         peak_value;
@@ -616,6 +636,136 @@ static int cfo_i_estimate(srsran_sync_t* q, const cf_t* input, int find_offset,
   return 0;
 }
 
+/* Runs the stages that follow the detection of the PSS correlation peak at peak_pos of the N_id_2 set in the object:
+ * the PSS-based CFO estimation, the SSS detection and the CP length detection
+ */
+static srsran_sync_find_ret_t
+sync_find_sss_cp(srsran_sync_t* q, const cf_t* input_ptr, uint32_t find_offset, int peak_pos)
+{
+  srsran_sync_find_ret_t ret = SRSRAN_SYNC_ERROR;
+
+  /* If peak is over threshold, compute CFO and SSS */
+  if (q->peak_value >= q->threshold || q->threshold == 0) {
+    if (q->cfo_pss_enable && peak_pos >= q->fft_size) {
+      // Filter central bands before PSS-based CFO estimation
+      const cf_t* pss_ptr = &input_ptr[find_offset + peak_pos - q->fft_size];
+      if (q->pss_filtering_enabled) {
+        srsran_pss_filter(&q->pss, pss_ptr, q->pss_filt);
+        pss_ptr = q->pss_filt;
+      }
+
+      // PSS-based CFO estimation
+      q->cfo_pss = srsran_pss_cfo_compute(&q->pss, pss_ptr);
+      if (!q->cfo_pss_is_set) {
+        q->cfo_pss_mean   = q->cfo_pss;
+        q->cfo_pss_is_set = true;
+      } else if (15000 * fabsf(q->cfo_pss) < MAX_CFO_PSS_OFFSET) {
+        q->cfo_pss_mean = SRSRAN_VEC_EMA(q->cfo_pss, q->cfo_pss_mean, q->cfo_ema_alpha);
+      }
+
+      DEBUG("PSS-CFO: filter=%s, estimated=%f, mean=%f",
+            q->pss_filtering_enabled ? "yes" : "no",
+            q->cfo_pss,
+            q->cfo_pss_mean);
+    }
+
+    // If there is enough space for CP and SSS estimation
+    if (peak_pos + find_offset >= 2 * (q->fft_size + SRSRAN_CP_LEN_EXT(q->fft_size))) {
+      // If SSS search is enabled, correlate SSS sequence
+      if (q->sss_en) {
+        int                 sss_idx;
+        uint32_t            nof_frame_type_trials;
+        srsran_frame_type_t frame_type_trials[2];
+        float               sss_corr[2] = {};
+        uint32_t            sf_idx[2], N_id_1[2];
+
+        if (q->detect_frame_type) {
+          nof_frame_type_trials = 2;
+          frame_type_trials[0]  = SRSRAN_FDD;
+          frame_type_trials[1]  = SRSRAN_TDD;
+        } else {
+          frame_type_trials[0]  = q->frame_type;
+          nof_frame_type_trials = 1;
+        }
+
+        q->sss_available = true;
+        q->sss_detected  = false;
+        for (uint32_t f = 0; f < nof_frame_type_trials; f++) {
+          if (frame_type_trials[f] == SRSRAN_FDD) {
+            sss_idx = (int)find_offset + peak_pos - 2 * SRSRAN_SYMBOL_SZ(q->fft_size, q->cp) +
+                      SRSRAN_CP_SZ(q->fft_size, q->cp);
+          } else {
+            sss_idx = (int)find_offset + peak_pos - 4 * SRSRAN_SYMBOL_SZ(q->fft_size, q->cp) +
+                      SRSRAN_CP_SZ(q->fft_size, q->cp);
+            ;
+          }
+
+          if (sss_idx >= 0) {
+            const cf_t* sss_ptr = &input_ptr[sss_idx];
+
+            // Correct CFO if detected in PSS
+            if (q->cfo_pss_enable) {
+              srsran_cfo_correct(&q->cfo_corr_symbol, sss_ptr, q->sss_filt, -q->cfo_pss_mean / q->fft_size);
+              // Equalize channel if estimated in PSS
+              if (q->sss_channel_equalize && q->pss.chest_on_filter && q->pss_filtering_enabled) {
+                srsran_vec_prod_ccc(&q->sss_filt[q->fft_size / 2 - SRSRAN_PSS_LEN / 2],
+                                    q->pss.tmp_ce,
+                                    &q->sss_filt[q->fft_size / 2 - SRSRAN_PSS_LEN / 2],
+                                    SRSRAN_PSS_LEN);
+              }
+              sss_ptr = q->sss_filt;
+            }
+
+            // Consider SSS detected if at least one trial found the SSS
+            q->sss_detected |= sync_sss_symbol(q, sss_ptr, &sf_idx[f], &N_id_1[f], &sss_corr[f]);
+          } else {
+            q->sss_available = false;
+          }
+        }
+
+        if (q->detect_frame_type) {
+          if (sss_corr[0] > sss_corr[1]) {
+            q->frame_type = SRSRAN_FDD;
+            q->sf_idx     = sf_idx[0];
+            q->N_id_1     = N_id_1[0];
+            q->sss_corr   = sss_corr[0];
+          } else {
+            q->frame_type = SRSRAN_TDD;
+            q->sf_idx     = sf_idx[1] + 1;
+            q->N_id_1     = N_id_1[1];
+            q->sss_corr   = sss_corr[1];
+          }
+          DEBUG("SYNC: Detected SSS %s, corr=%.2f/%.2f",
+                q->frame_type == SRSRAN_FDD ? "FDD" : "TDD",
+                sss_corr[0],
+                sss_corr[1]);
+        } else if (q->sss_detected) {
+          if (q->frame_type == SRSRAN_FDD) {
+            q->sf_idx = sf_idx[0];
+          } else {
+            q->sf_idx = sf_idx[0] + 1;
+          }
+          q->N_id_1   = N_id_1[0];
+          q->sss_corr = sss_corr[0];
+        }
+      }
+
+      // Detect CP length
+      if (q->detect_cp) {
+        srsran_sync_set_cp(q, srsran_sync_detect_cp(q, input_ptr, peak_pos + find_offset));
+      }
+
+      ret = SRSRAN_SYNC_FOUND;
+    } else {
+      ret = SRSRAN_SYNC_FOUND_NOSPACE;
+    }
+  } else {
+    ret = SRSRAN_SYNC_NOFOUND;
+  }
+
+  return ret;
+}
+
 /** Finds the PSS sequence previously defined by a call to srsran_sync_set_N_id_2()
  * around the position find_offset in the buffer input.
  *
@@ -666,21 +816,7 @@ srsran_sync_find(srsran_sync_t* q, const cf_t* input, uint32_t find_offset, uint
      * In case of multi-cell, this can lead to incorrect estimations if CFO from different cells is different
      */
     if (q->cfo_cp_enable) {
-      float cfo_cp = cfo_cp_estimate(q, input_ptr);
-
-      if (!q->cfo_cp_is_set) {
-        q->cfo_cp_mean   = cfo_cp;
-        q->cfo_cp_is_set = true;
-      } else {
-        /* compute exponential moving average CFO */
-        q->cfo_cp_mean = SRSRAN_VEC_EMA(cfo_cp, q->cfo_cp_mean, q->cfo_ema_alpha);
-      }
-
-      DEBUG("CP-CFO: estimated=%f, mean=%f", cfo_cp, q->cfo_cp_mean);
-
-      /* Correct CFO with the averaged CFO estimation */
-      srsran_cfo_correct(&q->cfo_corr_frame, input_ptr, q->temp, -q->cfo_cp_mean / q->fft_size);
-      input_ptr = q->temp;
+      input_ptr = cfo_cp_correct(q, input_ptr);
     }
 
     /* Find maximum of PSS correlation. If Integer CFO is enabled, correlation is already done
@@ -706,124 +842,7 @@ srsran_sync_find(srsran_sync_t* q, const cf_t* input, uint32_t find_offset, uint
       peak_pos = 0; // peak_pos + q->decimate*(2);// replace 2 with q->filter_size -2;
     }
 
-    /* If peak is over threshold, compute CFO and SSS */
-    if (q->peak_value >= q->threshold || q->threshold == 0) {
-      if (q->cfo_pss_enable && peak_pos >= q->fft_size) {
-        // Filter central bands before PSS-based CFO estimation
-        const cf_t* pss_ptr = &input_ptr[find_offset + peak_pos - q->fft_size];
-        if (q->pss_filtering_enabled) {
-          srsran_pss_filter(&q->pss, pss_ptr, q->pss_filt);
-          pss_ptr = q->pss_filt;
-        }
-
-        // PSS-based CFO estimation
-        q->cfo_pss = srsran_pss_cfo_compute(&q->pss, pss_ptr);
-        if (!q->cfo_pss_is_set) {
-          q->cfo_pss_mean   = q->cfo_pss;
-          q->cfo_pss_is_set = true;
-        } else if (15000 * fabsf(q->cfo_pss) < MAX_CFO_PSS_OFFSET) {
-          q->cfo_pss_mean = SRSRAN_VEC_EMA(q->cfo_pss, q->cfo_pss_mean, q->cfo_ema_alpha);
-        }
-
-        DEBUG("PSS-CFO: filter=%s, estimated=%f, mean=%f",
-              q->pss_filtering_enabled ? "yes" : "no",
-              q->cfo_pss,
-              q->cfo_pss_mean);
-      }
-
-      // If there is enough space for CP and SSS estimation
-      if (peak_pos + find_offset >= 2 * (q->fft_size + SRSRAN_CP_LEN_EXT(q->fft_size))) {
-        // If SSS search is enabled, correlate SSS sequence
-        if (q->sss_en) {
-          int                 sss_idx;
-          uint32_t            nof_frame_type_trials;
-          srsran_frame_type_t frame_type_trials[2];
-          float               sss_corr[2] = {};
-          uint32_t            sf_idx[2], N_id_1[2];
-
-          if (q->detect_frame_type) {
-            nof_frame_type_trials = 2;
-            frame_type_trials[0]  = SRSRAN_FDD;
-            frame_type_trials[1]  = SRSRAN_TDD;
-          } else {
-            frame_type_trials[0]  = q->frame_type;
-            nof_frame_type_trials = 1;
-          }
-
-          q->sss_available = true;
-          q->sss_detected  = false;
-          for (uint32_t f = 0; f < nof_frame_type_trials; f++) {
-            if (frame_type_trials[f] == SRSRAN_FDD) {
-              sss_idx = (int)find_offset + peak_pos - 2 * SRSRAN_SYMBOL_SZ(q->fft_size, q->cp) +
-                        SRSRAN_CP_SZ(q->fft_size, q->cp);
-            } else {
-              sss_idx = (int)find_offset + peak_pos - 4 * SRSRAN_SYMBOL_SZ(q->fft_size, q->cp) +
-                        SRSRAN_CP_SZ(q->fft_size, q->cp);
-              ;
-            }
-
-            if (sss_idx >= 0) {
-              const cf_t* sss_ptr = &input_ptr[sss_idx];
-
-              // Correct CFO if detected in PSS
-              if (q->cfo_pss_enable) {
-                srsran_cfo_correct(&q->cfo_corr_symbol, sss_ptr, q->sss_filt, -q->cfo_pss_mean / q->fft_size);
-                // Equalize channel if estimated in PSS
-                if (q->sss_channel_equalize && q->pss.chest_on_filter && q->pss_filtering_enabled) {
-                  srsran_vec_prod_ccc(&q->sss_filt[q->fft_size / 2 - SRSRAN_PSS_LEN / 2],
-                                      q->pss.tmp_ce,
-                                      &q->sss_filt[q->fft_size / 2 - SRSRAN_PSS_LEN / 2],
-                                      SRSRAN_PSS_LEN);
-                }
-                sss_ptr = q->sss_filt;
-              }
-
-              // Consider SSS detected if at least one trial found the SSS
-              q->sss_detected |= sync_sss_symbol(q, sss_ptr, &sf_idx[f], &N_id_1[f], &sss_corr[f]);
-            } else {
-              q->sss_available = false;
-            }
-          }
-
-          if (q->detect_frame_type) {
-            if (sss_corr[0] > sss_corr[1]) {
-              q->frame_type = SRSRAN_FDD;
-              q->sf_idx     = sf_idx[0];
-              q->N_id_1     = N_id_1[0];
-              q->sss_corr   = sss_corr[0];
-            } else {
-              q->frame_type = SRSRAN_TDD;
-              q->sf_idx     = sf_idx[1] + 1;
-              q->N_id_1     = N_id_1[1];
-              q->sss_corr   = sss_corr[1];
-            }
-            DEBUG("SYNC: Detected SSS %s, corr=%.2f/%.2f",
-                  q->frame_type == SRSRAN_FDD ? "FDD" : "TDD",
-                  sss_corr[0],
-                  sss_corr[1]);
-          } else if (q->sss_detected) {
-            if (q->frame_type == SRSRAN_FDD) {
-              q->sf_idx = sf_idx[0];
-            } else {
-              q->sf_idx = sf_idx[0] + 1;
-            }
-            q->N_id_1   = N_id_1[0];
-            q->sss_corr = sss_corr[0];
-          }
-        }
-
-        // Detect CP length
-        if (q->detect_cp) {
-          srsran_sync_set_cp(q, srsran_sync_detect_cp(q, input_ptr, peak_pos + find_offset));
-        }
-
-        ret = SRSRAN_SYNC_FOUND;
-      } else {
-        ret = SRSRAN_SYNC_FOUND_NOSPACE;
-      }
-    } else {
-      ret = SRSRAN_SYNC_NOFOUND;
-    }
+    ret = sync_find_sss_cp(q, input_ptr, find_offset, peak_pos);
 
     DEBUG("SYNC ret=%d N_id_2=%d find_offset=%d frame_len=%d, pos=%d peak=%.2f threshold=%.2f CFO=%.3f kHz",
           ret,
@@ -842,6 +861,138 @@ srsran_sync_find(srsran_sync_t* q, const cf_t* input, uint32_t find_offset, uint
   return ret;
 }
 
+/* Object state modified by sync_find_sss_cp(). srsran_sync_find_all() saves it before searching the N_id_2 and restores
+ * it before and after each search, so that every N_id_2 is searched from the same state */
+typedef struct {
+  uint32_t            N_id_2;
+  uint32_t            N_id_1;
+  uint32_t            sf_idx;
+  float               peak_value;
+  srsran_cp_t         cp;
+  float               M_norm_avg;
+  float               M_ext_avg;
+  srsran_frame_type_t frame_type;
+  bool                cfo_pss_is_set;
+  float               cfo_pss;
+  float               cfo_pss_mean;
+  bool                sss_detected;
+  bool                sss_available;
+  float               sss_corr;
+} sync_find_state_t;
+
+static void sync_find_state_save(const srsran_sync_t* q, sync_find_state_t* state)
+{
+  state->N_id_2         = q->N_id_2;
+  state->N_id_1         = q->N_id_1;
+  state->sf_idx         = q->sf_idx;
+  state->peak_value     = q->peak_value;
+  state->cp             = q->cp;
+  state->M_norm_avg     = q->M_norm_avg;
+  state->M_ext_avg      = q->M_ext_avg;
+  state->frame_type     = q->frame_type;
+  state->cfo_pss_is_set = q->cfo_pss_is_set;
+  state->cfo_pss        = q->cfo_pss;
+  state->cfo_pss_mean   = q->cfo_pss_mean;
+  state->sss_detected   = q->sss_detected;
+  state->sss_available  = q->sss_available;
+  state->sss_corr       = q->sss_corr;
+}
+
+static void sync_find_state_restore(srsran_sync_t* q, const sync_find_state_t* state)
+{
+  q->N_id_2         = state->N_id_2;
+  q->N_id_1         = state->N_id_1;
+  q->sf_idx         = state->sf_idx;
+  q->peak_value     = state->peak_value;
+  q->M_norm_avg     = state->M_norm_avg;
+  q->M_ext_avg      = state->M_ext_avg;
+  q->frame_type     = state->frame_type;
+  q->cfo_pss_is_set = state->cfo_pss_is_set;
+  q->cfo_pss        = state->cfo_pss;
+  q->cfo_pss_mean   = state->cfo_pss_mean;
+  q->sss_detected   = state->sss_detected;
+  q->sss_available  = state->sss_available;
+  q->sss_corr       = state->sss_corr;
+  srsran_sync_set_cp(q, state->cp);
+}
+
+/** Searches the PSS of the three N_id_2 in one pass around the position find_offset in the buffer input and, for each
+ * N_id_2 whose correlation peak exceeds the threshold, detects its SSS, CFO and CP length like srsran_sync_find().
+ *
+ * The integer CFO stage is not supported. The CP-based CFO is estimated once for all the N_id_2, whereas the PSS-based
+ * CFO of each N_id_2 is estimated from this call only, as each N_id_2 may belong to a different cell. Apart from the
+ * CP-based CFO, the object state is not modified: the N_id_2, CP length, PSS-based CFO and SSS results set before the
+ * call are kept.
+ *
+ * Returns SRSRAN_SUCCESS and the result of each N_id_2 in res, or a negative number on error.
+ */
+int srsran_sync_find_all(srsran_sync_t*             q,
+                         const cf_t*                input,
+                         uint32_t                   find_offset,
+                         srsran_sync_find_all_res_t res[SRSRAN_NOF_NID_2])
+{
+  if (q == NULL || input == NULL || res == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (!fft_size_isvalid(q->fft_size) || q->cfo_i_enable) {
+    ERROR("Invalid FFT size or integer CFO enabled");
+    return SRSRAN_ERROR;
+  }
+
+  const cf_t* input_ptr = input;
+  if (q->cfo_cp_enable) {
+    input_ptr = cfo_cp_correct(q, input_ptr);
+  }
+
+  uint32_t peak_pos[SRSRAN_NOF_NID_2];
+  float    peak_value[SRSRAN_NOF_NID_2];
+  if (srsran_pss_find_pss_all(&q->pss, &input_ptr[find_offset], peak_pos, peak_value) < SRSRAN_SUCCESS) {
+    ERROR("Error finding PSS sequences");
+    return SRSRAN_ERROR;
+  }
+
+  sync_find_state_t state = {};
+  sync_find_state_save(q, &state);
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+    srsran_sync_find_all_res_t* r = &res[N_id_2];
+
+    // The CP length and the CP detection averages of one N_id_2 must not bias the search of the next one
+    sync_find_state_restore(q, &state);
+    q->N_id_2         = N_id_2;
+    q->peak_value     = peak_value[N_id_2];
+    q->sss_detected   = false;
+    q->cfo_pss_mean   = 0;
+    q->cfo_pss_is_set = false;
+    srsran_pss_set_N_id_2(&q->pss, N_id_2);
+
+    r->ret          = sync_find_sss_cp(q, input_ptr, find_offset, (int)peak_pos[N_id_2]);
+    r->peak_pos     = peak_pos[N_id_2];
+    r->peak_value   = peak_value[N_id_2];
+    r->peak_abs     = q->pss.peak_value_all[N_id_2];
+    r->sss_detected = q->sss_detected;
+    r->N_id_1       = q->N_id_1;
+    r->sf_idx       = q->sf_idx;
+    r->cp           = q->cp;
+    r->frame_type   = q->frame_type;
+    r->cfo          = q->cfo_cp_mean + q->cfo_pss_mean;
+
+    DEBUG("SYNC ALL ret=%d N_id_2=%d pos=%d peak=%.2f sss=%s N_id_1=%d",
+          r->ret,
+          N_id_2,
+          r->peak_pos,
+          r->peak_value,
+          r->sss_detected ? "yes" : "no",
+          r->N_id_1);
+  }
+  sync_find_state_restore(q, &state);
+  if (srsran_N_id_2_isvalid(state.N_id_2)) {
+    srsran_pss_set_N_id_2(&q->pss, state.N_id_2);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 void srsran_sync_reset(srsran_sync_t* q)
 {
   q->M_ext_avg  = 0;
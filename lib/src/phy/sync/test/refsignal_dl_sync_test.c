@@ -0,0 +1,184 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/phy/sync/refsignal_dl_sync.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include <getopt.h>
+#include <math.h>
+#include <stdlib.h>
+
+#define NOF_CELLS 3
+#define NOF_MEAS_PCI 6
+
+static uint32_t nof_prb = 25;
+static uint32_t nof_sf  = 20;
+
+// Simulated cells, with their delay in samples and amplitude
+static const uint32_t cell_pci[NOF_CELLS]       = {1, 2, 150};
+static const uint32_t cell_delay[NOF_CELLS]     = {0, 1000, 7000};
+static const float    cell_amplitude[NOF_CELLS] = {1.0f, 1.0f, 1.0f};
+
+// Measured cells, the last ones are not in the signal
+static const uint32_t meas_pci[NOF_MEAS_PCI] = {1, 2, 150, 3, 151, 400};
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [pnv]\n", prog);
+  printf("\t-p Number of PRB [Default %d]\n", nof_prb);
+  printf("\t-n Number of subframes in the buffer [Default %d]\n", nof_sf);
+  printf("\t-v [set srsran_verbose to debug, default none]\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "pnv")) != -1) {
+    switch (opt) {
+      case 'p':
+        nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'n':
+        nof_sf = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+// Floating point measurements must be identical, including the not found ones
+static bool meas_equal(float a, float b)
+{
+  return (isnan(a) && isnan(b)) || a == b;
+}
+
+int main(int argc, char** argv)
+{
+  int                             ret                = SRSRAN_ERROR;
+  srsran_refsignal_dl_sync_t      refsignal_batch    = {};
+  srsran_refsignal_dl_sync_t      refsignal_single   = {};
+  srsran_refsignal_dl_sync_meas_t meas[NOF_MEAS_PCI] = {};
+  cf_t*                           buffer             = NULL;
+  cf_t*                           sf_buffer          = NULL;
+
+  parse_args(argc, argv);
+
+  srsran_cell_t cell = {};
+  cell.nof_prb       = nof_prb;
+  cell.nof_ports     = 1;
+  cell.cp            = SRSRAN_CP_NORM;
+
+  if (srsran_refsignal_dl_sync_init(&refsignal_batch, cell.cp) < SRSRAN_SUCCESS ||
+      srsran_refsignal_dl_sync_init(&refsignal_single, cell.cp) < SRSRAN_SUCCESS) {
+    ERROR("Error initialising refsignal DL sync");
+    goto clean_exit;
+  }
+
+  uint32_t sf_len   = SRSRAN_SF_LEN_PRB(nof_prb);
+  uint32_t nsamples = sf_len * nof_sf;
+  buffer            = srsran_vec_cf_malloc(nsamples);
+  sf_buffer         = srsran_vec_cf_malloc(sf_len);
+  if (buffer == NULL || sf_buffer == NULL) {
+    ERROR("Error malloc");
+    goto clean_exit;
+  }
+  srsran_vec_cf_zero(buffer, nsamples);
+
+  // Add the subframes of every cell with its delay and amplitude. The buffer is cyclic so every subframe is complete
+  for (uint32_t c = 0; c < NOF_CELLS; c++) {
+    cell.id = cell_pci[c];
+    if (srsran_refsignal_dl_sync_set_cell(&refsignal_single, cell) < SRSRAN_SUCCESS) {
+      ERROR("Error setting cell");
+      goto clean_exit;
+    }
+    for (uint32_t sf_idx = 0; sf_idx < nof_sf; sf_idx++) {
+      srsran_vec_sc_prod_cfc(
+          refsignal_single.sequences[sf_idx % SRSRAN_NOF_SF_X_FRAME], cell_amplitude[c], sf_buffer, sf_len);
+
+      uint32_t offset = (sf_idx * sf_len + cell_delay[c]) % nsamples;
+      uint32_t len    = SRSRAN_MIN(sf_len, nsamples - offset);
+      srsran_vec_sum_ccc(&buffer[offset], sf_buffer, &buffer[offset], len);
+      srsran_vec_sum_ccc(buffer, &sf_buffer[len], buffer, sf_len - len);
+    }
+  }
+
+  // Add noise 20 dB below the signal
+  srsran_ch_awgn_c(buffer, buffer, srsran_vec_avg_power_cf(buffer, nsamples) / 100.0f, nsamples);
+
+  if (srsran_refsignal_dl_sync_run_batch(&refsignal_batch, cell, meas_pci, NOF_MEAS_PCI, buffer, nsamples, meas) <
+      SRSRAN_SUCCESS) {
+    ERROR("Error running batch measurement");
+    goto clean_exit;
+  }
+
+  // Every cell of the batch must be measured as in a single cell measurement
+  for (uint32_t i = 0; i < NOF_MEAS_PCI; i++) {
+    cell.id = meas_pci[i];
+    TESTASSERT(srsran_refsignal_dl_sync_set_cell(&refsignal_single, cell) == SRSRAN_SUCCESS);
+    TESTASSERT(srsran_refsignal_dl_sync_run(&refsignal_single, buffer, nsamples) == SRSRAN_SUCCESS);
+
+    printf("pci=%03d; found=%s; peak_index=%d; rsrp=%+.1f dBfs; batch found=%s; peak_index=%d; rsrp=%+.1f dBfs\n",
+           meas_pci[i],
+           refsignal_single.found ? "yes" : "no",
+           refsignal_single.peak_index,
+           refsignal_single.rsrp_dBfs,
+           meas[i].found ? "yes" : "no",
+           meas[i].peak_index,
+           meas[i].rsrp_dBfs);
+
+    TESTASSERT(meas[i].pci == meas_pci[i]);
+    TESTASSERT(meas[i].found == refsignal_single.found);
+    TESTASSERT(meas[i].peak_index == refsignal_single.peak_index);
+    TESTASSERT(meas_equal(meas[i].rsrp_dBfs, refsignal_single.rsrp_dBfs));
+    TESTASSERT(meas_equal(meas[i].rssi_dBfs, refsignal_single.rssi_dBfs));
+    TESTASSERT(meas_equal(meas[i].rsrq_dB, refsignal_single.rsrq_dB));
+    TESTASSERT(meas_equal(meas[i].cfo_Hz, refsignal_single.cfo_Hz));
+
+    // The simulated cells must be found at their delay, the rest must not be found
+    TESTASSERT(meas[i].found == (i < NOF_CELLS));
+    if (i < NOF_CELLS) {
+      TESTASSERT(meas[i].peak_index % sf_len == cell_delay[i] % sf_len);
+    }
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_refsignal_dl_sync_free(&refsignal_batch);
+  srsran_refsignal_dl_sync_free(&refsignal_single);
+  if (buffer) {
+    free(buffer);
+  }
+  if (sf_buffer) {
+    free(sf_buffer);
+  }
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+
+  return ret;
+}
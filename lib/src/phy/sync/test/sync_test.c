@@ -122,6 +122,7 @@ int main(int argc, char** argv)
   /* Set a very high threshold to make sure the correlation is ok */
   srsran_sync_set_threshold(&syncobj, 5.0);
   srsran_sync_set_sss_algorithm(&syncobj, SSS_PARTIAL_3);
+  srsran_sync_set_cfo_pss_enable(&syncobj, true);
 
   if (cell_id == -1) {
     cid     = 0;
@@ -173,6 +174,29 @@ int main(int argc, char** argv)
         printf("Detected CP should be %s\n", SRSRAN_CP_ISNORM(cp) ? "Normal" : "Extended");
         exit(-1);
       }
+
+      /* Searching all the N_id_2 at once must find the same cell and keep the state of the object */
+      srsran_sync_find_all_res_t res[SRSRAN_NOF_NID_2];
+      float                      find_cfo     = srsran_sync_get_cfo(&syncobj);
+      int                        find_cell_id = srsran_sync_get_cell_id(&syncobj);
+
+      /* The PSS correlation is not averaged with previous calls, so the peak is lower than in srsran_sync_find */
+      srsran_sync_set_threshold(&syncobj, 3.0);
+      if (srsran_sync_find_all(&syncobj, fft_buffer, 0, res) < SRSRAN_SUCCESS) {
+        ERROR("Error running srsran_sync_find_all");
+        exit(-1);
+      }
+      srsran_sync_set_threshold(&syncobj, 5.0);
+      if (res[N_id_2].ret != SRSRAN_SYNC_FOUND || res[N_id_2].peak_pos != find_idx || !res[N_id_2].sss_detected ||
+          res[N_id_2].N_id_1 != cid / SRSRAN_NOF_NID_2 || res[N_id_2].sf_idx != find_sf || res[N_id_2].cp != cp) {
+        printf("srsran_sync_find_all result differs from srsran_sync_find\n");
+        exit(-1);
+      }
+      if (srsran_sync_get_cfo(&syncobj) != find_cfo || srsran_sync_get_sf_idx(&syncobj) != find_sf ||
+          srsran_sync_get_cell_id(&syncobj) != find_cell_id || srsran_sync_get_cp(&syncobj) != cp) {
+        printf("srsran_sync_find_all modified the state of the object\n");
+        exit(-1);
+      }
     }
     cid++;
   }
@@ -0,0 +1,635 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * Band scan benchmark. A band with a few cells is recorded to a file through the file RF device and then scanned back
+ * with srsran_ue_cellsearch_scan(), srsran_ue_cellsearch_scan_single_pass() and srsran_ue_cellsearch_scan_buffer()
+ * with the next EARFCN captured by another thread. For each method it reports the processing time, the time the
+ * samples take on air and the time the scan would take with a real radio.
+ */
+
+#include <complex.h>
+#include <inttypes.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/phy/rf/rf.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/srsran.h"
+
+#define MAX_EARFCN 1000
+#define MAX_CELLS_EARFCN 2
+#define CELL_FRAME_LEN (SRSRAN_NOF_SF_X_FRAME * SRSRAN_SF_LEN_PRB(SRSRAN_CS_NOF_PRB)) // 10 ms at 1.92 MHz
+#define SEARCH_FRAME_LEN (CELL_FRAME_LEN / 2)
+#define CHUNK_LEN SEARCH_FRAME_LEN
+
+static uint32_t band         = 20;
+static int      earfcn_start = -1;
+static int      earfcn_end   = -1;
+static uint32_t max_frames   = 8;
+static uint32_t nof_valid    = 4;
+static uint32_t cell_stride  = 10;
+static float    snr_db       = 0.0f;
+static uint32_t seed         = 1234;
+static char*    filename     = "/tmp/ue_cell_search_band_bench.dat";
+static bool     keep_file    = false;
+static uint32_t segment_len  = 0; // Samples recorded for each EARFCN
+static uint32_t capture_len  = 0; // Samples captured for each EARFCN by the pipelined scan
+
+typedef struct {
+  uint32_t nof_cells;
+  uint32_t cell_id[MAX_CELLS_EARFCN];
+} planted_t;
+
+typedef struct {
+  srsran_rf_t rf;
+  uint64_t    nof_samples; // Samples received in the current EARFCN
+  cf_t*       scratch;
+} bench_radio_t;
+
+typedef struct {
+  const char* name;
+  double      proc_s;
+  double      air_s;
+  double      radio_s;
+  uint32_t    nof_hits;
+  uint32_t    nof_misses;
+  uint32_t    nof_strong_misses; // Misses of the strongest cell of an EARFCN
+  uint32_t    nof_false;
+  uint32_t    nof_overflows;
+} bench_result_t;
+
+static srsran_earfcn_t channels[MAX_EARFCN];
+static planted_t       planted[MAX_EARFCN];
+static int             nof_channels = 0;
+
+void usage(char* prog)
+{
+  printf("Usage: %s [bsencSrfkv]\n", prog);
+  printf("\t-b band [Default %d]\n", band);
+  printf("\t-s earfcn_start [Default All]\n");
+  printf("\t-e earfcn_end [Default All]\n");
+  printf("\t-n max_frames_pss [Default %d]\n", max_frames);
+  printf("\t-V nof_valid_pss_frames [Default %d]\n", nof_valid);
+  printf("\t-c place cells every c EARFCN [Default %d]\n", cell_stride);
+  printf("\t-S SNR in dB [Default %.1f]\n", snr_db);
+  printf("\t-r random seed [Default %d]\n", seed);
+  printf("\t-f recording file [Default %s]\n", filename);
+  printf("\t-k keep the recording file\n");
+  printf("\t-v srsran_verbose\n");
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "bsencVSrfkv")) != -1) {
+    switch (opt) {
+      case 'b':
+        band = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 's':
+        earfcn_start = (int)strtol(argv[optind], NULL, 10);
+        break;
+      case 'e':
+        earfcn_end = (int)strtol(argv[optind], NULL, 10);
+        break;
+      case 'n':
+        max_frames = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'V':
+        nof_valid = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'c':
+        cell_stride = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'S':
+        snr_db = strtof(argv[optind], NULL);
+        break;
+      case 'r':
+        seed = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'f':
+        filename = argv[optind];
+        break;
+      case 'k':
+        keep_file = true;
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+  if (max_frames == 0 || nof_valid == 0 || nof_valid > max_frames || cell_stride == 0) {
+    usage(argv[0]);
+    exit(-1);
+  }
+}
+
+/* Generates one radio frame of a loaded 6 PRB cell, with unit average power */
+static int generate_cell_frame(srsran_random_t random, uint32_t cell_id, cf_t* frame)
+{
+  srsran_ofdm_t ifft;
+  uint32_t      sf_len = SRSRAN_SF_LEN_PRB(SRSRAN_CS_NOF_PRB);
+  uint32_t      nof_re = SRSRAN_SF_LEN_RE(SRSRAN_CS_NOF_PRB, SRSRAN_CP_NORM);
+  cf_t          pss_signal[SRSRAN_PSS_LEN];
+  float         sss_signal0[SRSRAN_SSS_LEN];
+  float         sss_signal5[SRSRAN_SSS_LEN];
+  cf_t*         sf_symbols = srsran_vec_cf_malloc(nof_re);
+  cf_t*         sf_buffer  = srsran_vec_cf_malloc(sf_len);
+  if (sf_symbols == NULL || sf_buffer == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_ofdm_tx_init(&ifft, SRSRAN_CP_NORM, sf_symbols, sf_buffer, SRSRAN_CS_NOF_PRB)) {
+    ERROR("Error creating iFFT object");
+    free(sf_symbols);
+    free(sf_buffer);
+    return SRSRAN_ERROR;
+  }
+
+  srsran_pss_generate(pss_signal, cell_id % SRSRAN_NOF_NID_2);
+  srsran_sss_generate(sss_signal0, sss_signal5, cell_id);
+
+  for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
+    // Random QPSK on every RE, then the synchronization signals on subframes 0 and 5
+    for (uint32_t i = 0; i < nof_re; i++) {
+      sf_symbols[i] = (srsran_random_bool(random, 0.5f) ? M_SQRT1_2 : -M_SQRT1_2) +
+                      (srsran_random_bool(random, 0.5f) ? M_SQRT1_2 : -M_SQRT1_2) * _Complex_I;
+    }
+    if (sf_idx == 0 || sf_idx == 5) {
+      srsran_pss_put_slot(pss_signal, sf_symbols, SRSRAN_CS_NOF_PRB, SRSRAN_CP_NORM);
+      srsran_sss_put_slot(sf_idx ? sss_signal5 : sss_signal0, sf_symbols, SRSRAN_CS_NOF_PRB, SRSRAN_CP_NORM);
+    }
+    srsran_ofdm_tx_sf(&ifft);
+    srsran_vec_cf_copy(&frame[sf_idx * sf_len], sf_buffer, sf_len);
+  }
+
+  float power = srsran_vec_avg_power_cf(frame, CELL_FRAME_LEN);
+  if (isnormal(power)) {
+    srsran_vec_sc_prod_cfc(frame, 1.0f / sqrtf(power), frame, CELL_FRAME_LEN);
+  }
+
+  srsran_ofdm_tx_free(&ifft);
+  free(sf_symbols);
+  free(sf_buffer);
+  return SRSRAN_SUCCESS;
+}
+
+/* Records segment_len samples per EARFCN. Every cell_stride EARFCN has a cell, and one of each two of them has a
+ * second cell with a different N_id_2, 3 dB weaker. Each cell has a random timing and CFO. */
+static int record_band(srsran_random_t random)
+{
+  int         ret                          = SRSRAN_ERROR;
+  cf_t*       segment                      = srsran_vec_cf_malloc(segment_len);
+  cf_t*       cell_signal                  = srsran_vec_cf_malloc(segment_len);
+  cf_t*       cell_frame[MAX_CELLS_EARFCN] = {};
+  char        rf_args[RF_PARAM_LEN]        = {};
+  float       noise_var                    = srsran_convert_dB_to_power(-snr_db);
+  bool        rf_open                      = false;
+  srsran_rf_t rf;
+
+  for (uint32_t i = 0; i < MAX_CELLS_EARFCN; i++) {
+    cell_frame[i] = srsran_vec_cf_malloc(CELL_FRAME_LEN);
+    if (cell_frame[i] == NULL) {
+      goto clean_exit;
+    }
+  }
+  if (segment == NULL || cell_signal == NULL) {
+    goto clean_exit;
+  }
+
+  snprintf(rf_args, RF_PARAM_LEN, "tx_file=%s,base_srate=%.0f", filename, SRSRAN_CS_SAMP_FREQ);
+  if (srsran_rf_open_devname(&rf, "file", rf_args, 1)) {
+    ERROR("Error opening file RF device for writing");
+    goto clean_exit;
+  }
+  rf_open = true;
+  srsran_rf_set_tx_srate(&rf, SRSRAN_CS_SAMP_FREQ);
+
+  for (int freq = 0; freq < nof_channels; freq++) {
+    planted_t* p = &planted[freq];
+    p->nof_cells = 0;
+    if (freq % cell_stride == 0) {
+      uint32_t N_id_2 = (freq / cell_stride) % SRSRAN_NOF_NID_2;
+      p->cell_id[p->nof_cells++] =
+          srsran_random_uniform_int_dist(random, 0, SRSRAN_NOF_NID_1 - 1) * SRSRAN_NOF_NID_2 + N_id_2;
+      if ((freq / cell_stride) % 2 == 1) {
+        N_id_2 = (N_id_2 + 1) % SRSRAN_NOF_NID_2;
+        p->cell_id[p->nof_cells++] =
+            srsran_random_uniform_int_dist(random, 0, SRSRAN_NOF_NID_1 - 1) * SRSRAN_NOF_NID_2 + N_id_2;
+      }
+    }
+
+    srsran_vec_cf_zero(segment, segment_len);
+    for (uint32_t c = 0; c < p->nof_cells; c++) {
+      if (generate_cell_frame(random, p->cell_id[c], cell_frame[c])) {
+        goto clean_exit;
+      }
+      uint32_t offset = srsran_random_uniform_int_dist(random, 0, CELL_FRAME_LEN - 1);
+      float    cfo_hz = srsran_random_uniform_real_dist(random, -2000.0f, 2000.0f);
+      float    amp    = c ? M_SQRT1_2 : 1.0f;
+      for (uint32_t n = 0; n < segment_len; n++) {
+        cell_signal[n] = amp * cell_frame[c][(n + offset) % CELL_FRAME_LEN];
+      }
+      srsran_vec_apply_cfo(cell_signal, cfo_hz / SRSRAN_CS_SAMP_FREQ, cell_signal, segment_len);
+      srsran_vec_sum_ccc(segment, cell_signal, segment, segment_len);
+    }
+    srsran_ch_awgn_c(segment, segment, noise_var, segment_len);
+
+    for (uint32_t n = 0; n < segment_len; n += CHUNK_LEN) {
+      if (srsran_rf_send(&rf, &segment[n], SRSRAN_MIN(CHUNK_LEN, segment_len - n), true) < SRSRAN_SUCCESS) {
+        ERROR("Error writing samples");
+        goto clean_exit;
+      }
+    }
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  if (rf_open) {
+    srsran_rf_close(&rf);
+  }
+  for (uint32_t i = 0; i < MAX_CELLS_EARFCN; i++) {
+    if (cell_frame[i]) {
+      free(cell_frame[i]);
+    }
+  }
+  if (cell_signal) {
+    free(cell_signal);
+  }
+  if (segment) {
+    free(segment);
+  }
+  return ret;
+}
+
+static int radio_open(bench_radio_t* radio)
+{
+  char rf_args[RF_PARAM_LEN] = {};
+  snprintf(rf_args, RF_PARAM_LEN, "rx_file=%s,base_srate=%.0f", filename, SRSRAN_CS_SAMP_FREQ);
+  if (srsran_rf_open_devname(&radio->rf, "file", rf_args, 1)) {
+    ERROR("Error opening file RF device for reading");
+    return SRSRAN_ERROR;
+  }
+  radio->scratch = srsran_vec_cf_malloc(CHUNK_LEN);
+  if (radio->scratch == NULL) {
+    srsran_rf_close(&radio->rf);
+    return SRSRAN_ERROR;
+  }
+  radio->nof_samples = 0;
+  srsran_rf_set_rx_srate(&radio->rf, SRSRAN_CS_SAMP_FREQ);
+  srsran_rf_start_rx_stream(&radio->rf, false);
+  return SRSRAN_SUCCESS;
+}
+
+static void radio_close(bench_radio_t* radio)
+{
+  srsran_rf_close(&radio->rf);
+  free(radio->scratch);
+}
+
+static int radio_recv(bench_radio_t* radio, cf_t* data, uint32_t nsamples)
+{
+  int n = srsran_rf_recv_with_time(&radio->rf, data, nsamples, true, NULL, NULL);
+  if (n > 0) {
+    radio->nof_samples += n;
+  }
+  return n;
+}
+
+int radio_recv_wrapper(void* h, void* data, uint32_t nsamples, srsran_timestamp_t* t)
+{
+  return radio_recv((bench_radio_t*)h, (cf_t*)data, nsamples);
+}
+
+/* Tunes to the next EARFCN: discards what is left of the recording of the current one */
+static int radio_next_earfcn(bench_radio_t* radio, bench_result_t* result)
+{
+  if (radio->nof_samples > segment_len) {
+    result->nof_overflows++;
+    ERROR("Scan received %" PRIu64 " samples, the recording only has %d per EARFCN", radio->nof_samples, segment_len);
+    return SRSRAN_ERROR;
+  }
+  while (radio->nof_samples < segment_len) {
+    uint32_t n = SRSRAN_MIN(CHUNK_LEN, segment_len - radio->nof_samples);
+    if (radio_recv(radio, radio->scratch, n) != n) {
+      ERROR("Error receiving samples");
+      return SRSRAN_ERROR;
+    }
+  }
+  radio->nof_samples = 0;
+  return SRSRAN_SUCCESS;
+}
+
+static void check_cells(int freq, const srsran_ue_cellsearch_result_t found_cells[3], int n, bench_result_t* result)
+{
+  const planted_t* p        = &planted[freq];
+  bool             found[3] = {};
+
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2 && n > 0; N_id_2++) {
+    if (found_cells[N_id_2].psr <= 2.0f) {
+      continue;
+    }
+    bool match = false;
+    for (uint32_t c = 0; c < p->nof_cells; c++) {
+      if (p->cell_id[c] == found_cells[N_id_2].cell_id) {
+        match    = true;
+        found[c] = true;
+      }
+    }
+    if (!match) {
+      result->nof_false++;
+      INFO("EARFCN %d: found PCI %d which was not recorded", channels[freq].id, found_cells[N_id_2].cell_id);
+    }
+  }
+  for (uint32_t c = 0; c < p->nof_cells; c++) {
+    if (found[c]) {
+      result->nof_hits++;
+    } else {
+      result->nof_misses++;
+      result->nof_strong_misses += (c == 0);
+      INFO("EARFCN %d: PCI %d not found", channels[freq].id, p->cell_id[c]);
+    }
+  }
+}
+
+static double elapsed_s(struct timeval t[3])
+{
+  get_time_interval(t);
+  return t[0].tv_sec + t[0].tv_usec * 1e-6;
+}
+
+/* Scans the band one EARFCN after the other, receiving while searching */
+static int
+scan_sequential(srsran_ue_cellsearch_t* cs, bench_radio_t* radio, bool single_pass, bench_result_t* result)
+{
+  srsran_ue_cellsearch_result_t found_cells[3];
+
+  if (radio_open(radio)) {
+    return SRSRAN_ERROR;
+  }
+
+  for (int freq = 0; freq < nof_channels; freq++) {
+    struct timeval t[3];
+    srsran_rf_set_rx_freq(&radio->rf, 0, channels[freq].fd * 1e6);
+    bzero(found_cells, 3 * sizeof(srsran_ue_cellsearch_result_t));
+
+    gettimeofday(&t[1], NULL);
+    int n = single_pass ? srsran_ue_cellsearch_scan_single_pass(cs, found_cells, NULL)
+                        : srsran_ue_cellsearch_scan(cs, found_cells, NULL);
+    gettimeofday(&t[2], NULL);
+    if (n < 0) {
+      ERROR("Error searching cell");
+      radio_close(radio);
+      return SRSRAN_ERROR;
+    }
+
+    double air_s  = radio->nof_samples / SRSRAN_CS_SAMP_FREQ;
+    double proc_s = elapsed_s(t);
+    result->air_s += air_s;
+    result->proc_s += proc_s;
+    result->radio_s += air_s + proc_s;
+    check_cells(freq, found_cells, n, result);
+
+    if (radio_next_earfcn(radio, result)) {
+      radio_close(radio);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  radio_close(radio);
+  return SRSRAN_SUCCESS;
+}
+
+/* Capture thread of the pipelined scan. Captures each EARFCN into one of two buffers while the other is searched */
+typedef struct {
+  bench_radio_t   radio;
+  cf_t*           buffer[2];
+  int             nof_captured;
+  int             nof_searched;
+  bool            error;
+  pthread_mutex_t mutex;
+  pthread_cond_t  cvar;
+  bench_result_t* result;
+} capture_t;
+
+static void* capture_thread(void* arg)
+{
+  capture_t* c = (capture_t*)arg;
+
+  for (int freq = 0; freq < nof_channels; freq++) {
+    // Wait for the buffer to be free
+    pthread_mutex_lock(&c->mutex);
+    while (freq - c->nof_searched >= 2) {
+      pthread_cond_wait(&c->cvar, &c->mutex);
+    }
+    pthread_mutex_unlock(&c->mutex);
+
+    srsran_rf_set_rx_freq(&c->radio.rf, 0, channels[freq].fd * 1e6);
+    bool error = radio_recv(&c->radio, c->buffer[freq % 2], capture_len) != capture_len ||
+                 radio_next_earfcn(&c->radio, c->result) != SRSRAN_SUCCESS;
+
+    pthread_mutex_lock(&c->mutex);
+    c->error = error;
+    c->nof_captured++;
+    pthread_cond_broadcast(&c->cvar);
+    pthread_mutex_unlock(&c->mutex);
+    if (error) {
+      break;
+    }
+  }
+  return NULL;
+}
+
+/* Scans the band searching each EARFCN while the next one is captured */
+static int scan_pipelined(srsran_ue_cellsearch_t* cs, bench_result_t* result)
+{
+  int                           ret = SRSRAN_ERROR;
+  capture_t                     c   = {};
+  pthread_t                     thread;
+  srsran_ue_cellsearch_result_t found_cells[3];
+  double                        air_s = capture_len / SRSRAN_CS_SAMP_FREQ;
+
+  c.result = result;
+  if (radio_open(&c.radio)) {
+    return SRSRAN_ERROR;
+  }
+  c.buffer[0] = srsran_vec_cf_malloc(capture_len);
+  c.buffer[1] = srsran_vec_cf_malloc(capture_len);
+  if (c.buffer[0] == NULL || c.buffer[1] == NULL) {
+    goto clean_exit;
+  }
+  pthread_mutex_init(&c.mutex, NULL);
+  pthread_cond_init(&c.cvar, NULL);
+  if (pthread_create(&thread, NULL, capture_thread, &c)) {
+    perror("pthread_create");
+    goto clean_exit;
+  }
+
+  // The first EARFCN is captured before any search can start
+  result->radio_s += air_s;
+
+  for (int freq = 0; freq < nof_channels; freq++) {
+    struct timeval t[3];
+
+    pthread_mutex_lock(&c.mutex);
+    while (c.nof_captured <= freq && !c.error) {
+      pthread_cond_wait(&c.cvar, &c.mutex);
+    }
+    bool error = c.error;
+    pthread_mutex_unlock(&c.mutex);
+    if (error) {
+      break;
+    }
+
+    gettimeofday(&t[1], NULL);
+    int n = srsran_ue_cellsearch_scan_buffer(cs, c.buffer[freq % 2], capture_len, found_cells, NULL);
+    gettimeofday(&t[2], NULL);
+    if (n < 0) {
+      ERROR("Error searching cell");
+      break;
+    }
+
+    pthread_mutex_lock(&c.mutex);
+    c.nof_searched++;
+    pthread_cond_broadcast(&c.cvar);
+    pthread_mutex_unlock(&c.mutex);
+
+    // With a radio the next EARFCN is received while this one is searched
+    double proc_s = elapsed_s(t);
+    result->air_s += air_s;
+    result->proc_s += proc_s;
+    result->radio_s += (freq + 1 < nof_channels) ? SRSRAN_MAX(air_s, proc_s) : proc_s;
+    check_cells(freq, found_cells, n, result);
+  }
+
+  // Release the capture thread if the search stopped early
+  pthread_mutex_lock(&c.mutex);
+  ret            = (c.nof_searched == nof_channels && !c.error) ? SRSRAN_SUCCESS : SRSRAN_ERROR;
+  c.nof_searched = nof_channels + 2;
+  pthread_cond_broadcast(&c.cvar);
+  pthread_mutex_unlock(&c.mutex);
+  pthread_join(thread, NULL);
+
+  pthread_cond_destroy(&c.cvar);
+  pthread_mutex_destroy(&c.mutex);
+
+clean_exit:
+  radio_close(&c.radio);
+  if (c.buffer[0]) {
+    free(c.buffer[0]);
+  }
+  if (c.buffer[1]) {
+    free(c.buffer[1]);
+  }
+  return ret;
+}
+
+static void print_result(const bench_result_t* r, const bench_result_t* ref)
+{
+  printf("%-12s proc=%8.3f s air=%8.3f s radio=%8.3f s (x%.2f) found=%d/%d false=%d\n",
+         r->name,
+         r->proc_s,
+         r->air_s,
+         r->radio_s,
+         ref->radio_s / r->radio_s,
+         r->nof_hits,
+         r->nof_hits + r->nof_misses,
+         r->nof_false);
+}
+
+int main(int argc, char** argv)
+{
+  int                    ret = SRSRAN_ERROR;
+  srsran_ue_cellsearch_t cs;
+  bench_radio_t          radio      = {};
+  bench_result_t         results[3] = {{.name = "scan"}, {.name = "single_pass"}, {.name = "pipelined"}};
+
+  parse_args(argc, argv);
+
+  nof_channels = srsran_band_get_fd_band(band, channels, earfcn_start, earfcn_end, MAX_EARFCN);
+  if (nof_channels <= 0) {
+    ERROR("Error getting EARFCN list");
+    exit(-1);
+  }
+
+  // Enough samples for the three N_id_2 of srsran_ue_cellsearch_scan() to go through max_frames frames, plus realigns
+  segment_len = (SRSRAN_NOF_NID_2 * max_frames + SRSRAN_NOF_NID_2) * SEARCH_FRAME_LEN;
+  capture_len = (max_frames + 1) * SEARCH_FRAME_LEN;
+
+  srsran_random_t random = srsran_random_init(seed);
+  srand(seed);
+
+  printf("Recording band %d, %d EARFCN (%.1f MB) to %s...\n",
+         band,
+         nof_channels,
+         (double)nof_channels * segment_len * sizeof(cf_t) / 1e6,
+         filename);
+  if (record_band(random)) {
+    goto clean_exit;
+  }
+
+  if (srsran_ue_cellsearch_init(&cs, max_frames, radio_recv_wrapper, (void*)&radio)) {
+    ERROR("Error initiating UE cell detect");
+    goto clean_exit;
+  }
+  srsran_ue_cellsearch_set_nof_valid_frames(&cs, nof_valid);
+
+  printf("Scanning %d EARFCN, max_frames=%d, nof_valid_frames=%d, SNR=%.1f dB\n",
+         nof_channels,
+         max_frames,
+         nof_valid,
+         snr_db);
+  if (scan_sequential(&cs, &radio, false, &results[0]) || scan_sequential(&cs, &radio, true, &results[1]) ||
+      scan_pipelined(&cs, &results[2])) {
+    srsran_ue_cellsearch_free(&cs);
+    goto clean_exit;
+  }
+  srsran_ue_cellsearch_free(&cs);
+
+  ret = SRSRAN_SUCCESS;
+  for (uint32_t i = 0; i < 3; i++) {
+    print_result(&results[i], &results[0]);
+    // Weaker cells may be missed, the strongest of each EARFCN must always be found
+    if (results[i].nof_strong_misses > 0 || results[i].nof_overflows > 0) {
+      ret = SRSRAN_ERROR;
+    }
+  }
+
+clean_exit:
+  srsran_random_free(random);
+  if (!keep_file) {
+    remove(filename);
+  }
+  printf("%s\n", ret ? "Error" : "Ok");
+  return ret;
+}
@@ -66,7 +66,7 @@ int srsran_ue_cellsearch_init(srsran_ue_cellsearch_t* q,
     q->sf_buffer[0]    = srsran_vec_cf_malloc(CELL_SEARCH_BUFFER_MAX_SAMPLES);
     q->nof_rx_antennas = 1;
 
-    q->candidates = calloc(sizeof(srsran_ue_cellsearch_result_t), max_frames);
+    q->candidates = calloc(sizeof(srsran_ue_cellsearch_result_t), SRSRAN_NOF_NID_2 * max_frames);
     if (!q->candidates) {
       perror("malloc");
       goto clean_exit;
@@ -128,7 +128,7 @@ int srsran_ue_cellsearch_init_multi(
     }
     q->nof_rx_antennas = nof_rx_antennas;
 
-    q->candidates = calloc(sizeof(srsran_ue_cellsearch_result_t), max_frames);
+    q->candidates = calloc(sizeof(srsran_ue_cellsearch_result_t), SRSRAN_NOF_NID_2 * max_frames);
     if (!q->candidates) {
       perror("malloc");
       goto clean_exit;
@@ -194,7 +194,10 @@ void srsran_set_detect_cp(srsran_ue_cellsearch_t* q, bool enable)
 }
 
 /* Decide the most likely cell based on the mode */
-static void get_cell(srsran_ue_cellsearch_t* q, uint32_t nof_detected_frames, srsran_ue_cellsearch_result_t* found_cell)
+static void get_cell(srsran_ue_cellsearch_t*              q,
+                     const srsran_ue_cellsearch_result_t* candidates,
+                     uint32_t                             nof_detected_frames,
+                     srsran_ue_cellsearch_result_t*       found_cell)
 {
   uint32_t i, j;
 
@@ -205,7 +208,7 @@ static void get_cell(srsran_ue_cellsearch_t* q, uint32_t nof_detected_frames, sr
   for (i = 0; i < nof_detected_frames; i++) {
     uint32_t cnt = 1;
     for (j = i + 1; j < nof_detected_frames; j++) {
-      if (q->candidates[j].cell_id == q->candidates[i].cell_id && !q->mode_counted[j]) {
+      if (candidates[j].cell_id == candidates[i].cell_id && !q->mode_counted[j]) {
         q->mode_counted[j] = 1;
         cnt++;
       }
@@ -219,22 +222,22 @@ static void get_cell(srsran_ue_cellsearch_t* q, uint32_t nof_detected_frames, sr
       mode_pos  = i;
     }
   }
-  found_cell->cell_id = q->candidates[mode_pos].cell_id;
+  found_cell->cell_id = candidates[mode_pos].cell_id;
   /* Now in all these cell IDs, find most frequent CP and duplex mode */
   uint32_t nof_normal = 0;
   uint32_t nof_fdd    = 0;
   found_cell->peak    = 0;
   for (i = 0; i < nof_detected_frames; i++) {
-    if (q->candidates[i].cell_id == found_cell->cell_id) {
-      if (SRSRAN_CP_ISNORM(q->candidates[i].cp)) {
+    if (candidates[i].cell_id == found_cell->cell_id) {
+      if (SRSRAN_CP_ISNORM(candidates[i].cp)) {
         nof_normal++;
       }
-      if (q->candidates[i].frame_type == SRSRAN_FDD) {
+      if (candidates[i].frame_type == SRSRAN_FDD) {
         nof_fdd++;
       }
     }
     // average absolute peak value
-    found_cell->peak += q->candidates[i].peak;
+    found_cell->peak += candidates[i].peak;
   }
   found_cell->peak /= nof_detected_frames;
 
@@ -251,10 +254,10 @@ static void get_cell(srsran_ue_cellsearch_t* q, uint32_t nof_detected_frames, sr
   found_cell->mode = (float)q->mode_ntimes[mode_pos] / nof_detected_frames;
 
   // PSR is already averaged so take the last value
-  found_cell->psr = q->candidates[nof_detected_frames - 1].psr;
+  found_cell->psr = candidates[nof_detected_frames - 1].psr;
 
   // CFO is also already averaged
-  found_cell->cfo = q->candidates[nof_detected_frames - 1].cfo;
+  found_cell->cfo = candidates[nof_detected_frames - 1].cfo;
 }
 
 /** Finds up to 3 cells, one per each N_id_2=0,1,2 and stores ID and CP in the structure pointed by found_cell.
@@ -352,7 +355,7 @@ int srsran_ue_cellsearch_scan_N_id_2(srsran_ue_cellsearch_t*        q,
     if (nof_detected_frames > 0) {
       ret = 1; // A cell has been found.
       if (found_cell) {
-        get_cell(q, nof_detected_frames, found_cell);
+        get_cell(q, q->candidates, nof_detected_frames, found_cell);
       }
     } else {
       ret = 0; // A cell was not found.
@@ -361,3 +364,177 @@ int srsran_ue_cellsearch_scan_N_id_2(srsran_ue_cellsearch_t*        q,
 
   return ret;
 }
+
+/* Searches the three N_id_2 in one frame of ue_sync frame_len samples. Each detected cell is saved as a candidate of
+ * its N_id_2. Returns the number of samples the next frame must be delayed to make space for the SSS of a peak found
+ * too close to the start of the frame, or a negative number on error.
+ */
+static int cellsearch_single_pass_frame(srsran_ue_cellsearch_t* q,
+                                        const cf_t*             frame,
+                                        uint32_t                nof_detected[SRSRAN_NOF_NID_2])
+{
+  srsran_sync_t*             sfind = &q->ue_sync.sfind;
+  srsran_sync_find_all_res_t res[SRSRAN_NOF_NID_2];
+  int                        delay = 0;
+
+  if (srsran_sync_find_all(sfind, frame, 0, res) < SRSRAN_SUCCESS) {
+    ERROR("Error searching PSS");
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+    if (res[N_id_2].ret == SRSRAN_SYNC_FOUND_NOSPACE) {
+      delay = q->ue_sync.frame_len / 2;
+    }
+    if (res[N_id_2].ret != SRSRAN_SYNC_FOUND || !res[N_id_2].sss_detected || nof_detected[N_id_2] >= q->max_frames ||
+        !srsran_N_id_1_isvalid(res[N_id_2].N_id_1)) {
+      continue;
+    }
+
+    srsran_ue_cellsearch_result_t* candidates = &q->candidates[N_id_2 * q->max_frames];
+    srsran_ue_cellsearch_result_t* c          = &candidates[nof_detected[N_id_2]];
+
+    c->cell_id    = res[N_id_2].N_id_1 * SRSRAN_NOF_NID_2 + N_id_2;
+    c->cp         = res[N_id_2].cp;
+    c->frame_type = res[N_id_2].frame_type;
+    c->peak       = res[N_id_2].peak_abs;
+    c->psr        = res[N_id_2].peak_value;
+    c->cfo        = 15000 * res[N_id_2].cfo;
+
+    // Average the PSR and CFO of the N_id_2 as ue_sync does, get_cell() takes the last value
+    if (nof_detected[N_id_2] > 0) {
+      const srsran_ue_cellsearch_result_t* prev = &candidates[nof_detected[N_id_2] - 1];
+      c->psr                                    = SRSRAN_VEC_EMA(c->psr, prev->psr, sfind->cfo_ema_alpha);
+      c->cfo                                    = SRSRAN_VEC_EMA(c->cfo, prev->cfo, sfind->cfo_ema_alpha);
+    }
+
+    INFO("CELL SEARCH: [%d] Found peak PSR=%.3f, Cell_id: %d CP: %s, CFO=%.1f KHz",
+         nof_detected[N_id_2],
+         c->psr,
+         c->cell_id,
+         srsran_cp_string(c->cp),
+         c->cfo / 1000);
+
+    nof_detected[N_id_2]++;
+  }
+
+  return delay;
+}
+
+static bool cellsearch_single_pass_done(srsran_ue_cellsearch_t* q, const uint32_t nof_detected[SRSRAN_NOF_NID_2])
+{
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+    if (nof_detected[N_id_2] < q->nof_valid_frames) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void cellsearch_single_pass_reset(srsran_ue_cellsearch_t* q, uint32_t nof_detected[SRSRAN_NOF_NID_2])
+{
+  bzero(q->candidates, sizeof(srsran_ue_cellsearch_result_t) * SRSRAN_NOF_NID_2 * q->max_frames);
+  bzero(nof_detected, sizeof(uint32_t) * SRSRAN_NOF_NID_2);
+
+  srsran_sync_reset(&q->ue_sync.sfind);
+  srsran_sync_cfo_reset(&q->ue_sync.sfind, 0.0f);
+}
+
+static int cellsearch_single_pass_result(srsran_ue_cellsearch_t*       q,
+                                         const uint32_t                nof_detected[SRSRAN_NOF_NID_2],
+                                         srsran_ue_cellsearch_result_t found_cells[3],
+                                         uint32_t*                     max_N_id_2)
+{
+  int   nof_detected_cells = 0;
+  float max_peak_value     = -1.0;
+
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+    bzero(&found_cells[N_id_2], sizeof(srsran_ue_cellsearch_result_t));
+    if (nof_detected[N_id_2] == 0) {
+      continue;
+    }
+    get_cell(q, &q->candidates[N_id_2 * q->max_frames], nof_detected[N_id_2], &found_cells[N_id_2]);
+    nof_detected_cells++;
+    if (max_N_id_2 && found_cells[N_id_2].peak > max_peak_value) {
+      max_peak_value = found_cells[N_id_2].peak;
+      *max_N_id_2    = N_id_2;
+    }
+  }
+  return nof_detected_cells;
+}
+
+/** Finds up to 3 cells, one per each N_id_2=0,1,2, like srsran_ue_cellsearch_scan(), but searching the three N_id_2 on
+ * each received frame instead of receiving max_frames frames for each of them. The scan stops once every N_id_2 has
+ * been detected in nof_valid_frames frames or after max_frames frames.
+ * Returns the number of found cells or a negative number if error
+ */
+int srsran_ue_cellsearch_scan_single_pass(srsran_ue_cellsearch_t*       q,
+                                          srsran_ue_cellsearch_result_t found_cells[3],
+                                          uint32_t*                     max_N_id_2)
+{
+  if (q == NULL || found_cells == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t nof_detected[SRSRAN_NOF_NID_2];
+  cellsearch_single_pass_reset(q, nof_detected);
+
+  for (uint32_t nof_scanned_frames = 0; nof_scanned_frames < q->max_frames; nof_scanned_frames++) {
+    if (q->ue_sync.recv_callback(q->ue_sync.stream, q->sf_buffer, q->ue_sync.frame_len, NULL) < 0) {
+      ERROR("Error receiving samples");
+      return SRSRAN_ERROR;
+    }
+
+    int delay = cellsearch_single_pass_frame(q, q->sf_buffer[0], nof_detected);
+    if (delay < 0) {
+      return SRSRAN_ERROR;
+    }
+    if (cellsearch_single_pass_done(q, nof_detected)) {
+      break;
+    }
+    if (delay > 0) {
+      INFO("No space for SSS/CP detection. Realigning frame...");
+      if (q->ue_sync.recv_callback(q->ue_sync.stream, q->sf_buffer, (uint32_t)delay, NULL) < 0) {
+        ERROR("Error receiving samples");
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
+  return cellsearch_single_pass_result(q, nof_detected, found_cells, max_N_id_2);
+}
+
+/** Finds up to 3 cells, one per each N_id_2=0,1,2, in nof_samples samples captured beforehand at SRSRAN_CS_SAMP_FREQ,
+ * searching the three N_id_2 on each frame like srsran_ue_cellsearch_scan_single_pass(). The stream handler is not
+ * used, so the next frequency can be captured while this one is processed.
+ * Returns the number of found cells or a negative number if error
+ */
+int srsran_ue_cellsearch_scan_buffer(srsran_ue_cellsearch_t*       q,
+                                     const cf_t*                   buffer,
+                                     uint32_t                      nof_samples,
+                                     srsran_ue_cellsearch_result_t found_cells[3],
+                                     uint32_t*                     max_N_id_2)
+{
+  if (q == NULL || buffer == NULL || found_cells == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t nof_detected[SRSRAN_NOF_NID_2];
+  cellsearch_single_pass_reset(q, nof_detected);
+
+  uint32_t frame_len = q->ue_sync.frame_len;
+  uint32_t offset    = 0;
+  for (uint32_t nof_scanned_frames = 0; nof_scanned_frames < q->max_frames && offset + frame_len <= nof_samples;
+       nof_scanned_frames++) {
+    int delay = cellsearch_single_pass_frame(q, &buffer[offset], nof_detected);
+    if (delay < 0) {
+      return SRSRAN_ERROR;
+    }
+    if (cellsearch_single_pass_done(q, nof_detected)) {
+      break;
+    }
+    offset += frame_len + (uint32_t)delay;
+  }
+
+  return cellsearch_single_pass_result(q, nof_detected, found_cells, max_N_id_2);
+}
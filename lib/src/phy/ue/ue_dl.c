@@ -363,6 +363,15 @@ int srsran_ue_dl_decode_fft_estimate(srsran_ue_dl_t* q, srsran_dl_sf_cfg_t* sf,
   }
 }
 
+int srsran_ue_dl_decode_estimate(srsran_ue_dl_t* q, srsran_dl_sf_cfg_t* sf, srsran_ue_dl_cfg_t* cfg)
+{
+  if (q) {
+    return estimate_pdcch_pcfich(q, sf, cfg);
+  } else {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+}
+
 int srsran_ue_dl_decode_fft_estimate_noguru(srsran_ue_dl_t*     q,
                                             srsran_dl_sf_cfg_t* sf,
                                             srsran_ue_dl_cfg_t* cfg,
@@ -58,6 +58,31 @@ static int ue_dl_nr_alloc_prb(srsran_ue_dl_nr_t* q, uint32_t new_nof_prb)
   return SRSRAN_SUCCESS;
 }
 
+static void ue_dl_nr_reset_locations(srsran_ue_dl_nr_t* q)
+{
+  for (uint32_t i = 0; i < SRSRAN_UE_DL_NR_MAX_NOF_SEARCH_SPACE; i++) {
+    if (q->ss_locations[i]) {
+      q->ss_locations[i]->nof_slots = 0;
+    }
+  }
+  if (q->ra_ss_locations) {
+    q->ra_ss_locations->nof_slots = 0;
+  }
+}
+
+static int ue_dl_nr_alloc_locations(srsran_pdcch_nr_locations_t** locations)
+{
+  if (*locations == NULL) {
+    *locations = SRSRAN_MEM_ALLOC(srsran_pdcch_nr_locations_t, 1);
+    if (*locations == NULL) {
+      ERROR("Error alloc");
+      return SRSRAN_ERROR;
+    }
+  }
+  (*locations)->nof_slots = 0;
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_ue_dl_nr_init(srsran_ue_dl_nr_t* q, cf_t* input[SRSRAN_MAX_PORTS], const srsran_ue_dl_nr_args_t* args)
 {
   if (!q || !input || !args) {
@@ -111,12 +136,6 @@ int srsran_ue_dl_nr_init(srsran_ue_dl_nr_t* q, cf_t* input[SRSRAN_MAX_PORTS], co
     return SRSRAN_ERROR;
   }
 
-  q->pdcch_ce = SRSRAN_MEM_ALLOC(srsran_dmrs_pdcch_ce_t, 1);
-  if (q->pdcch_ce == NULL) {
-    ERROR("Error alloc");
-    return SRSRAN_ERROR;
-  }
-
   return SRSRAN_SUCCESS;
 }
 
@@ -143,8 +162,13 @@ void srsran_ue_dl_nr_free(srsran_ue_dl_nr_t* q)
   }
   srsran_pdcch_nr_free(&q->pdcch);
 
-  if (q->pdcch_ce) {
-    free(q->pdcch_ce);
+  for (uint32_t i = 0; i < SRSRAN_UE_DL_NR_MAX_NOF_SEARCH_SPACE; i++) {
+    if (q->ss_locations[i]) {
+      free(q->ss_locations[i]);
+    }
+  }
+  if (q->ra_ss_locations) {
+    free(q->ra_ss_locations);
   }
 
   SRSRAN_MEM_ZERO(q, srsran_ue_dl_nr_t, 1);
@@ -182,6 +206,9 @@ int srsran_ue_dl_nr_set_carrier(srsran_ue_dl_nr_t* q, const srsran_carrier_nr_t*
 
   q->carrier = *carrier;
 
+  // The number of slots of the candidate locations depends on the numerology
+  ue_dl_nr_reset_locations(q);
+
   return SRSRAN_SUCCESS;
 }
 
@@ -214,6 +241,19 @@ int srsran_ue_dl_nr_set_pdcch_config(srsran_ue_dl_nr_t*           q,
     return SRSRAN_ERROR;
   }
 
+  // Allocate the candidate locations of the present search spaces, they are computed on their first search
+  for (uint32_t i = 0; i < SRSRAN_UE_DL_NR_MAX_NOF_SEARCH_SPACE; i++) {
+    if (cfg->search_space_present[i] && ue_dl_nr_alloc_locations(&q->ss_locations[i]) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+  if (cfg->ra_search_space_present && ue_dl_nr_alloc_locations(&q->ra_ss_locations) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  // The CORESET configurations might have changed
+  srsran_pdcch_nr_reset_reg(&q->pdcch);
+
   return SRSRAN_SUCCESS;
 }
 
@@ -234,45 +274,82 @@ void srsran_ue_dl_nr_estimate_fft(srsran_ue_dl_nr_t* q, const srsran_slot_cfg_t*
       srsran_dmrs_pdcch_estimate(&q->dmrs_pdcch[i], slot_cfg, q->sf_symbols[0]);
     }
   }
+
+  // The PDCCH soft bits of the previous slot are no longer valid
+  srsran_pdcch_nr_reset_reg(&q->pdcch);
 }
 
-static int ue_dl_nr_find_dci_ncce(srsran_ue_dl_nr_t*     q,
-                                  srsran_dci_msg_nr_t*   dci_msg,
-                                  srsran_pdcch_nr_res_t* pdcch_res,
-                                  uint32_t               coreset_id)
+static int ue_dl_nr_save_pdcch_info(srsran_ue_dl_nr_t*                 q,
+                                    const srsran_dci_msg_nr_t*         dci_msg,
+                                    const srsran_dmrs_pdcch_measure_t* m,
+                                    const srsran_pdcch_nr_res_t*       pdcch_res)
 {
   // Select debug information
-  srsran_ue_dl_nr_pdcch_info_t* pdcch_info = NULL;
-  if (q->pdcch_info_count < SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR) {
-    pdcch_info = &q->pdcch_info[q->pdcch_info_count];
-    q->pdcch_info_count++;
-  } else {
+  if (q->pdcch_info_count >= SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR) {
     ERROR("The UE does not expect more than %d candidates in this serving cell", SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR);
     return SRSRAN_ERROR;
   }
+  srsran_ue_dl_nr_pdcch_info_t* pdcch_info = &q->pdcch_info[q->pdcch_info_count];
+  q->pdcch_info_count++;
+
   SRSRAN_MEM_ZERO(pdcch_info, srsran_ue_dl_nr_pdcch_info_t, 1);
-  pdcch_info->dci_ctx            = dci_msg->ctx;
-  pdcch_info->nof_bits           = dci_msg->nof_bits;
-  srsran_dmrs_pdcch_measure_t* m = &pdcch_info->measure;
+  pdcch_info->dci_ctx  = dci_msg->ctx;
+  pdcch_info->nof_bits = dci_msg->nof_bits;
+  pdcch_info->measure  = *m;
+  if (pdcch_res != NULL) {
+    pdcch_info->result = *pdcch_res;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/**
+ * @brief Measures the DMRS of a PDCCH candidate and compares it with the thresholds. It is done once for every
+ * candidate location, before decoding any DCI size
+ */
+static int ue_dl_nr_measure_candidate(srsran_ue_dl_nr_t*           q,
+                                      uint32_t                     coreset_id,
+                                      const srsran_dci_location_t* location,
+                                      srsran_dmrs_pdcch_measure_t* m,
+                                      bool*                        detected)
+{
+  *detected = false;
+
+  // Discard empty candidates from the DMRS EPRE first, it is much cheaper than the complete measurement
+  float epre_dBfs = 0.0f;
+  if (srsran_dmrs_pdcch_get_epre(&q->dmrs_pdcch[coreset_id], location, &epre_dBfs) < SRSRAN_SUCCESS) {
+    ERROR("Error getting EPRE location L=%d, ncce=%d", location->L, location->ncce);
+    return SRSRAN_ERROR;
+  }
+  if (!(epre_dBfs >= q->pdcch_dmrs_epre_thr)) {
+    INFO("Discarded PDCCH candidate L=%d;ncce=%d; EPRE is too weak (%.1f<%.1f);",
+         location->L,
+         location->ncce,
+         epre_dBfs,
+         q->pdcch_dmrs_epre_thr);
+    SRSRAN_MEM_ZERO(m, srsran_dmrs_pdcch_measure_t, 1);
+    m->epre_dBfs = epre_dBfs;
+    m->epre      = srsran_convert_dB_to_power(epre_dBfs);
+    return SRSRAN_SUCCESS;
+  }
 
   // Measures the PDCCH transmission DMRS
-  srsran_dci_location_t location = dci_msg->ctx.location;
-  if (srsran_dmrs_pdcch_get_measure(&q->dmrs_pdcch[coreset_id], &location, m) < SRSRAN_SUCCESS) {
-    ERROR("Error getting measure location L=%d, ncce=%d", location.L, location.ncce);
+  if (srsran_dmrs_pdcch_get_measure(&q->dmrs_pdcch[coreset_id], location, m) < SRSRAN_SUCCESS) {
+    ERROR("Error getting measure location L=%d, ncce=%d", location->L, location->ncce);
     return SRSRAN_ERROR;
   }
 
   // If measured correlation is invalid, early return
   if (!isnormal(m->norm_corr)) {
-    INFO("Discarded PDCCH candidate L=%d;ncce=%d; Invalid measurement;", location.L, location.ncce);
+    INFO("Discarded PDCCH candidate L=%d;ncce=%d; Invalid measurement;", location->L, location->ncce);
     return SRSRAN_SUCCESS;
   }
 
   // Compare EPRE with threshold
   if (m->epre_dBfs < q->pdcch_dmrs_epre_thr) {
     INFO("Discarded PDCCH candidate L=%d;ncce=%d; EPRE is too weak (%.1f<%.1f);",
-         location.L,
-         location.ncce,
+         location->L,
+         location->ncce,
          m->epre_dBfs,
          q->pdcch_dmrs_epre_thr);
     return SRSRAN_SUCCESS;
@@ -281,8 +358,8 @@ static int ue_dl_nr_find_dci_ncce(srsran_ue_dl_nr_t*     q,
   // Compare DMRS correlation with threshold
   if (m->norm_corr < q->pdcch_dmrs_corr_thr) {
     INFO("Discarded PDCCH candidate L=%d;ncce=%d; Correlation is too low (%.1f<%.1f); EPRE=%+.2f; RSRP=%+.2f;",
-         location.L,
-         location.ncce,
+         location->L,
+         location->ncce,
          m->norm_corr,
          q->pdcch_dmrs_corr_thr,
          m->epre_dBfs,
@@ -290,30 +367,7 @@ static int ue_dl_nr_find_dci_ncce(srsran_ue_dl_nr_t*     q,
     return SRSRAN_SUCCESS;
   }
 
-  // Extract PDCCH channel estimates
-  if (srsran_dmrs_pdcch_get_ce(&q->dmrs_pdcch[coreset_id], &location, q->pdcch_ce) < SRSRAN_SUCCESS) {
-    ERROR("Error extracting PDCCH DMRS");
-    return SRSRAN_ERROR;
-  }
-
-  // Decode PDCCH
-  if (srsran_pdcch_nr_decode(&q->pdcch, q->sf_symbols[0], q->pdcch_ce, dci_msg, pdcch_res) < SRSRAN_SUCCESS) {
-    ERROR("Error decoding PDCCH");
-    return SRSRAN_ERROR;
-  }
-
-#if 0
-  static uint32_t num_pdcch = 0;
-  char            tmpstr[64];
-  snprintf(tmpstr, 64, "pdcch_symbols%d.dat", num_pdcch);
-  printf("save %d syms to %s\n", q->pdcch.M / 4, tmpstr);
-  srsran_vec_save_file(tmpstr, q->pdcch.symbols, q->pdcch.M / 4 * sizeof(cf_t));
-  // srsran_vec_fprint_c(stdout, q->pdcch.symbols, q->pdcch.M/4);
-  num_pdcch++;
-#endif
-
-  // Save information
-  pdcch_info->result = *pdcch_res;
+  *detected = true;
 
   return SRSRAN_SUCCESS;
 }
@@ -334,14 +388,67 @@ static bool find_dci_msg(srsran_dci_msg_nr_t* dci_msg, uint32_t nof_dci_msg, srs
   return found;
 }
 
+/**
+ * @brief Stores a DCI message that passed the CRC in the DL or UL list
+ */
+static void ue_dl_nr_save_dci(srsran_ue_dl_nr_t* q, srsran_dci_msg_nr_t* dci_msg)
+{
+  // Detect if the DCI is the right direction
+  if (!srsran_dci_nr_valid_direction(dci_msg)) {
+    // Change grant format direction
+    switch (dci_msg->ctx.format) {
+      case srsran_dci_format_nr_0_0:
+        dci_msg->ctx.format = srsran_dci_format_nr_1_0;
+        break;
+      case srsran_dci_format_nr_0_1:
+        dci_msg->ctx.format = srsran_dci_format_nr_1_1;
+        break;
+      case srsran_dci_format_nr_1_0:
+        dci_msg->ctx.format = srsran_dci_format_nr_0_0;
+        break;
+      case srsran_dci_format_nr_1_1:
+        dci_msg->ctx.format = srsran_dci_format_nr_0_1;
+        break;
+      default:
+        return;
+    }
+  }
+
+  // If UL grant, enqueue in UL list
+  if (dci_msg->ctx.format == srsran_dci_format_nr_0_0 || dci_msg->ctx.format == srsran_dci_format_nr_0_1) {
+    // If the pending UL grant list is full or has the dci message, keep moving
+    if (q->ul_dci_count >= SRSRAN_MAX_DCI_MSG_NR || find_dci_msg(q->ul_dci_msg, q->ul_dci_count, dci_msg)) {
+      return;
+    }
+
+    // Save the grant in the pending UL grant list
+    q->ul_dci_msg[q->ul_dci_count] = *dci_msg;
+    q->ul_dci_count++;
+    return;
+  }
+
+  // Check if the grant exists already in the DL list
+  if (find_dci_msg(q->dl_dci_msg, q->dl_dci_msg_count, dci_msg)) {
+    // The same DCI is in the list, keep moving
+    return;
+  }
+
+  INFO("Found DCI in L=%d,ncce=%d", dci_msg->ctx.location.L, dci_msg->ctx.location.ncce);
+  // Append DCI message into the list
+  q->dl_dci_msg[q->dl_dci_msg_count] = *dci_msg;
+  q->dl_dci_msg_count++;
+}
+
 static int ue_dl_nr_find_dci_ss(srsran_ue_dl_nr_t*           q,
                                 const srsran_slot_cfg_t*     slot_cfg,
                                 const srsran_search_space_t* search_space,
+                                srsran_pdcch_nr_locations_t* locations,
                                 uint16_t                     rnti,
                                 srsran_rnti_type_t           rnti_type)
 {
-  uint32_t dci_sizes[SRSRAN_DCI_NR_MAX_NOF_SIZES] = {};
-  uint32_t dci_sizes_count                        = 0;
+  uint32_t               dci_sizes[SRSRAN_DCI_NR_MAX_NOF_SIZES]   = {};
+  srsran_dci_format_nr_t dci_formats[SRSRAN_DCI_NR_MAX_NOF_SIZES] = {};
+  uint32_t               dci_sizes_count                          = 0;
 
   // Select CORESET
   uint32_t coreset_id = search_space->coreset_id;
@@ -351,6 +458,11 @@ static int ue_dl_nr_find_dci_ss(srsran_ue_dl_nr_t*           q,
   }
   srsran_coreset_t* coreset = &q->cfg.coreset[search_space->coreset_id];
 
+  if (locations == NULL) {
+    ERROR("Search space %d was not configured", search_space->id);
+    return SRSRAN_ERROR;
+  }
+
   // Set CORESET in PDCCH decoder
   if (srsran_pdcch_nr_set_carrier(&q->pdcch, &q->carrier, coreset) < SRSRAN_SUCCESS) {
     ERROR("Setting carrier and CORESETºn");
@@ -385,96 +497,103 @@ static int ue_dl_nr_find_dci_ss(srsran_ue_dl_nr_t*           q,
       ERROR("Exceed maximum number of DCI sizes");
       return SRSRAN_ERROR;
     }
+    dci_formats[dci_sizes_count] = dci_format;
     dci_sizes[dci_sizes_count++] = dci_nof_bits;
+  }
+  if (dci_sizes_count == 0) {
+    return SRSRAN_SUCCESS;
+  }
 
-    // Iterate all possible aggregation levels
-    for (uint32_t L = 0;
-         L < SRSRAN_SEARCH_SPACE_NOF_AGGREGATION_LEVELS_NR && q->dl_dci_msg_count < SRSRAN_MAX_DCI_MSG_NR;
-         L++) {
-      // Calculate possible PDCCH DCI candidates
-      uint32_t candidates[SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR] = {};
-      int      nof_candidates                                        = srsran_pdcch_nr_locations_coreset(
-                                                      coreset, search_space, rnti, L, SRSRAN_SLOT_NR_MOD(q->carrier.scs, slot_cfg->idx), candidates);
-      if (nof_candidates < SRSRAN_SUCCESS) {
-        ERROR("Error calculating DCI candidate location");
-        return SRSRAN_ERROR;
+  // Compute the candidate locations of the whole frame if the configuration or the RNTI changed
+  if (locations->nof_slots == 0 || (search_space->type == srsran_search_space_type_ue && locations->rnti != rnti)) {
+    if (srsran_pdcch_nr_locations_table(coreset, search_space, rnti, q->carrier.scs, locations) < SRSRAN_SUCCESS) {
+      ERROR("Error calculating DCI candidate location");
+      return SRSRAN_ERROR;
+    }
+  }
+  uint32_t slot_idx = SRSRAN_SLOT_NR_MOD(q->carrier.scs, slot_cfg->idx) % locations->nof_slots;
+
+  // CCEs of the PDCCH transmissions found in the search space, other candidates cannot use them
+  bool cce_used[SRSRAN_CORESET_MAX_NOF_CCE] = {};
+
+  // Iterate all possible aggregation levels
+  for (uint32_t L = 0; L < SRSRAN_SEARCH_SPACE_NOF_AGGREGATION_LEVELS_NR && q->dl_dci_msg_count < SRSRAN_MAX_DCI_MSG_NR;
+       L++) {
+    uint32_t nof_cce = 1U << L;
+
+    // Iterate over the candidates
+    for (uint32_t ncce_idx = 0;
+         ncce_idx < locations->nof_candidates[L] && q->dl_dci_msg_count < SRSRAN_MAX_DCI_MSG_NR;
+         ncce_idx++) {
+      uint32_t ncce = locations->ncce[slot_idx][L][ncce_idx];
+
+      // Skip the candidate if it overlaps a PDCCH transmission found already
+      bool overlap = false;
+      for (uint32_t i = ncce; i < ncce + nof_cce && i < SRSRAN_CORESET_MAX_NOF_CCE && !overlap; i++) {
+        overlap = cce_used[i];
+      }
+      if (overlap) {
+        continue;
       }
 
-      // Iterate over the candidates
-      for (int ncce_idx = 0; ncce_idx < nof_candidates && q->dl_dci_msg_count < SRSRAN_MAX_DCI_MSG_NR; ncce_idx++) {
-        // Build DCI context
-        srsran_dci_ctx_t ctx = {};
-        ctx.location.L       = L;
-        ctx.location.ncce    = candidates[ncce_idx];
-        ctx.ss_type          = search_space->type;
-        ctx.coreset_id       = search_space->coreset_id;
-        ctx.coreset_start_rb = srsran_coreset_start_rb(&q->cfg.coreset[search_space->coreset_id]);
-        ctx.rnti_type        = rnti_type;
-        ctx.rnti             = rnti;
-        ctx.format           = dci_format;
-
-        // Build DCI message
-        srsran_dci_msg_nr_t dci_msg = {};
-        dci_msg.ctx                 = ctx;
-        dci_msg.nof_bits            = (uint32_t)dci_nof_bits;
-
-        // Find and decode PDCCH transmission in the given ncce
-        srsran_pdcch_nr_res_t res = {};
-        if (ue_dl_nr_find_dci_ncce(q, &dci_msg, &res, coreset_id) < SRSRAN_SUCCESS) {
+      // Build DCI context
+      srsran_dci_ctx_t ctx = {};
+      ctx.location.L       = L;
+      ctx.location.ncce    = ncce;
+      ctx.ss_type          = search_space->type;
+      ctx.coreset_id       = search_space->coreset_id;
+      ctx.coreset_start_rb = srsran_coreset_start_rb(&q->cfg.coreset[search_space->coreset_id]);
+      ctx.rnti_type        = rnti_type;
+      ctx.rnti             = rnti;
+      ctx.format           = dci_formats[0];
+
+      // Build DCI message
+      srsran_dci_msg_nr_t dci_msg = {};
+      dci_msg.ctx                 = ctx;
+      dci_msg.nof_bits            = dci_sizes[0];
+
+      // Discard empty candidates from their DMRS before decoding any DCI size
+      srsran_dmrs_pdcch_measure_t m        = {};
+      bool                        detected = false;
+      if (ue_dl_nr_measure_candidate(q, coreset_id, &ctx.location, &m, &detected) < SRSRAN_SUCCESS) {
+        return SRSRAN_ERROR;
+      }
+      if (!detected) {
+        if (ue_dl_nr_save_pdcch_info(q, &dci_msg, &m, NULL) < SRSRAN_SUCCESS) {
           return SRSRAN_ERROR;
         }
+        continue;
+      }
 
-        // If the CRC was not match, move to next candidate
-        if (!res.crc) {
-          continue;
-        }
+      // Try every DCI size, all of them decode the same soft bits
+      for (uint32_t i = 0; i < dci_sizes_count; i++) {
+        dci_msg.ctx.format = dci_formats[i];
+        dci_msg.nof_bits   = dci_sizes[i];
 
-        // Detect if the DCI is the right direction
-        if (!srsran_dci_nr_valid_direction(&dci_msg)) {
-          // Change grant format direction
-          switch (dci_msg.ctx.format) {
-            case srsran_dci_format_nr_0_0:
-              dci_msg.ctx.format = srsran_dci_format_nr_1_0;
-              break;
-            case srsran_dci_format_nr_0_1:
-              dci_msg.ctx.format = srsran_dci_format_nr_1_1;
-              break;
-            case srsran_dci_format_nr_1_0:
-              dci_msg.ctx.format = srsran_dci_format_nr_0_0;
-              break;
-            case srsran_dci_format_nr_1_1:
-              dci_msg.ctx.format = srsran_dci_format_nr_0_1;
-              break;
-            default:
-              continue;
-          }
+        // Decode PDCCH
+        srsran_pdcch_nr_res_t res = {};
+        if (srsran_pdcch_nr_decode_reg(&q->pdcch, q->sf_symbols[0], &q->dmrs_pdcch[coreset_id], &dci_msg, &res) <
+            SRSRAN_SUCCESS) {
+          ERROR("Error decoding PDCCH");
+          return SRSRAN_ERROR;
         }
 
-        // If UL grant, enqueue in UL list
-        if (dci_msg.ctx.format == srsran_dci_format_nr_0_0 || dci_msg.ctx.format == srsran_dci_format_nr_0_1) {
-          // If the pending UL grant list is full or has the dci message, keep moving
-          if (q->ul_dci_count >= SRSRAN_MAX_DCI_MSG_NR || find_dci_msg(q->ul_dci_msg, q->ul_dci_count, &dci_msg)) {
-            continue;
-          }
-
-          // Save the grant in the pending UL grant list
-          q->ul_dci_msg[q->ul_dci_count] = dci_msg;
-          q->ul_dci_count++;
-
-          // Move to next candidate
-          continue;
+        // Save information
+        if (ue_dl_nr_save_pdcch_info(q, &dci_msg, &m, &res) < SRSRAN_SUCCESS) {
+          return SRSRAN_ERROR;
         }
 
-        // Check if the grant exists already in the DL list
-        if (find_dci_msg(q->dl_dci_msg, q->dl_dci_msg_count, &dci_msg)) {
-          // The same DCI is in the list, keep moving
+        // If the CRC was not match, move to next size
+        if (!res.crc) {
           continue;
         }
 
-        INFO("Found DCI in L=%d,ncce=%d", dci_msg.ctx.location.L, dci_msg.ctx.location.ncce);
-        // Append DCI message into the list
-        q->dl_dci_msg[q->dl_dci_msg_count] = dci_msg;
-        q->dl_dci_msg_count++;
+        // The candidate carries a PDCCH transmission, no other size nor overlapping candidate needs to be tried
+        for (uint32_t j = ncce; j < ncce + nof_cce && j < SRSRAN_CORESET_MAX_NOF_CCE; j++) {
+          cce_used[j] = true;
+        }
+        ue_dl_nr_save_dci(q, &dci_msg);
+        break;
       }
     }
   }
@@ -504,7 +623,7 @@ int srsran_ue_dl_nr_find_dl_dci(srsran_ue_dl_nr_t*       q,
   // If the UE looks for a RAR and RA search space is provided, search for it
   if (q->cfg.ra_search_space_present && rnti_type == srsran_rnti_type_ra) {
     // Find DCIs in the RA search space
-    int ret = ue_dl_nr_find_dci_ss(q, slot_cfg, &q->cfg.ra_search_space, rnti, rnti_type);
+    int ret = ue_dl_nr_find_dci_ss(q, slot_cfg, &q->cfg.ra_search_space, q->ra_ss_locations, rnti, rnti_type);
     if (ret < SRSRAN_SUCCESS) {
       ERROR("Error searching RAR DCI");
       return SRSRAN_ERROR;
@@ -518,7 +637,7 @@ int srsran_ue_dl_nr_find_dl_dci(srsran_ue_dl_nr_t*       q,
       }
 
       // Find DCIs in the selected search space
-      int ret = ue_dl_nr_find_dci_ss(q, slot_cfg, &q->cfg.search_space[i], rnti, rnti_type);
+      int ret = ue_dl_nr_find_dci_ss(q, slot_cfg, &q->cfg.search_space[i], q->ss_locations[i], rnti, rnti_type);
       if (ret < SRSRAN_SUCCESS) {
         ERROR("Error searching DCI");
         return SRSRAN_ERROR;
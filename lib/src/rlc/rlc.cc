@@ -325,6 +325,16 @@ void rlc::write_pdu(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
   }
 }
 
+void rlc::write_pdu_slice(uint32_t lcid, srsran::byte_buffer_slice pdu)
+{
+  if (valid_lcid(lcid)) {
+    rlc_array.at(lcid)->write_pdu_s(std::move(pdu));
+    update_bsr(lcid);
+  } else {
+    logger.warning("LCID %d doesn't exist. Dropping PDU.", lcid);
+  }
+}
+
 // Pass directly to PDCP, no DL througput counting done
 void rlc::write_pdu_bcch_bch(srsran::unique_byte_buffer_t pdu)
 {
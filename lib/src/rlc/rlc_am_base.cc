@@ -186,7 +186,13 @@ uint32_t rlc_am::read_pdu(uint8_t* payload, uint32_t nof_bytes)
 
 void rlc_am::write_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
-  rx_base->write_pdu(payload, nof_bytes);
+  write_pdu_slice(byte_buffer_slice(nullptr, payload, nof_bytes));
+}
+
+void rlc_am::write_pdu_slice(byte_buffer_slice pdu)
+{
+  uint32_t nof_bytes = pdu.size();
+  rx_base->write_pdu(std::move(pdu));
 
   std::lock_guard<std::mutex> lock(metrics_mutex);
   metrics.num_rx_pdus++;
@@ -275,14 +281,8 @@ void rlc_am::rlc_am_base_tx::discard_sdu(uint32_t discard_sn)
   if (!tx_enabled) {
     return;
   }
-  bool discarded = tx_sdu_queue.apply_first([&discard_sn, this](unique_byte_buffer_t& sdu) {
-    if (sdu != nullptr && sdu->md.pdcp_sn == discard_sn) {
-      tx_sdu_queue.queue.pop_func(sdu);
-      sdu = nullptr;
-      return true;
-    }
-    return false;
-  });
+  bool discarded = tx_sdu_queue.discard_first(
+      [&discard_sn](const unique_byte_buffer_t& sdu) { return sdu->md.pdcp_sn == discard_sn; });
 
   // Discard fails when the PDCP PDU is already in Tx window.
   RlcInfo("%s PDU with PDCP_SN=%d", discarded ? "Discarding" : "Couldn't discard", discard_sn);
@@ -303,17 +303,17 @@ void rlc_am::rlc_am_base_tx::set_bsr_callback(bsr_callback_t callback)
  *     This class is used for common code between the
  *     LTE and NR TX entities
  *******************************************************/
-void rlc_am::rlc_am_base_rx::write_pdu(uint8_t* payload, const uint32_t nof_bytes)
+void rlc_am::rlc_am_base_rx::write_pdu(byte_buffer_slice pdu)
 {
-  RlcInfo("Rx PDU - N bytes %d", nof_bytes);
-  if (nof_bytes < 1) {
+  RlcInfo("Rx PDU - N bytes %d", pdu.size());
+  if (pdu.size() < 1) {
     return;
   }
 
-  if (rlc_am_is_control_pdu(payload)) {
-    parent->tx_base->handle_control_pdu(payload, nof_bytes);
+  if (rlc_am_is_control_pdu(pdu.data())) {
+    parent->tx_base->handle_control_pdu(pdu.data(), pdu.size());
   } else {
-    handle_data_pdu(payload, nof_bytes);
+    handle_data_pdu(std::move(pdu));
   }
 }
 } // namespace srsran
@@ -1230,35 +1230,36 @@ void rlc_am_lte_rx::stop()
  * @param payload Pointer to payload
  * @param nof_bytes Payload length
  */
-void rlc_am_lte_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_bytes)
+void rlc_am_lte_rx::handle_data_pdu(byte_buffer_slice pdu)
 {
   std::lock_guard<std::mutex> lock(mutex);
 
   rlc_amd_pdu_header_t header      = {};
-  uint32_t             payload_len = nof_bytes;
+  uint8_t*             payload     = pdu.data();
+  uint32_t             payload_len = pdu.size();
   rlc_am_read_data_pdu_header(&payload, &payload_len, &header);
-  if (payload_len > nof_bytes) {
-    RlcInfo("Dropping corrupted PDU (%d B). Remaining length after header %d B.", nof_bytes, payload_len);
+  if (payload_len > pdu.size()) {
+    RlcInfo("Dropping corrupted PDU (%d B). Remaining length after header %d B.", pdu.size(), payload_len);
     return;
   }
+  pdu.advance(payload - pdu.data());
   if (header.rf != 0) {
-    handle_data_pdu_segment(payload, payload_len, header);
+    handle_data_pdu_segment(std::move(pdu), header);
   } else {
-    handle_data_pdu_full(payload, payload_len, header);
+    handle_data_pdu_full(std::move(pdu), header);
   }
 }
 
 /** Called from stack thread when MAC has received a new RLC PDU
  *
- * @param payload Pointer to payload
- * @param nof_bytes Payload length
+ * @param payload PDU payload, after the header
  * @param header Reference to PDU header (unpacked by caller)
  */
-void rlc_am_lte_rx::handle_data_pdu_full(uint8_t* payload, uint32_t nof_bytes, rlc_amd_pdu_header_t& header)
+void rlc_am_lte_rx::handle_data_pdu_full(byte_buffer_slice payload, rlc_amd_pdu_header_t& header)
 {
-  std::map<uint32_t, rlc_amd_rx_pdu>::iterator it;
+  uint32_t nof_bytes = payload.size();
 
-  RlcHexInfo(payload, nof_bytes, "Rx data PDU SN=%d (%d B)", header.sn, nof_bytes);
+  RlcHexInfo(payload.data(), nof_bytes, "Rx data PDU SN=%d (%d B)", header.sn, nof_bytes);
   log_rlc_amd_pdu_header_to_string(logger.debug, rb_name, "%s", header);
 
   // sanity check for segments not exceeding PDU length
@@ -1291,29 +1292,21 @@ void rlc_am_lte_rx::handle_data_pdu_full(uint8_t* payload, uint32_t nof_bytes, r
     return;
   }
 
-  // Write to rx window
-  rlc_amd_rx_pdu& pdu = rx_window.add_pdu(header.sn);
-  pdu.buf             = srsran::make_byte_buffer();
-  if (pdu.buf == NULL) {
+  // Write to rx window. The payload is kept as a slice of the received TB when it is shared
+  byte_buffer_slice buf = retain_slice(std::move(payload));
+  if (buf.empty() && nof_bytes > 0) {
 #ifdef RLC_AM_BUFFER_DEBUG
     srsran::console("Fatal Error: Couldn't allocate PDU in handle_data_pdu().\n");
     exit(-1);
 #else
     RlcError("Fatal Error: Couldn't allocate PDU in handle_data_pdu().");
-    rx_window.remove_pdu(header.sn);
     return;
 #endif
   }
-  pdu.buf->set_timestamp();
-
-  // check available space for payload
-  if (nof_bytes > pdu.buf->get_tailroom()) {
-    RlcError("Discarding SN=%d of size %d B (available space %d B)", header.sn, nof_bytes, pdu.buf->get_tailroom());
-    return;
-  }
-  memcpy(pdu.buf->msg, payload, nof_bytes);
-  pdu.buf->N_bytes = nof_bytes;
-  pdu.header       = header;
+  rlc_amd_rx_pdu& pdu = rx_window.add_pdu(header.sn);
+  pdu.buf             = std::move(buf);
+  pdu.rx_time         = std::chrono::high_resolution_clock::now();
+  pdu.header          = header;
 
   // Update vr_h
   if (RX_MOD_BASE(header.sn) >= RX_MOD_BASE(vr_h)) {
@@ -1367,11 +1360,12 @@ void rlc_am_lte_rx::handle_data_pdu_full(uint8_t* payload, uint32_t nof_bytes, r
   debug_state();
 }
 
-void rlc_am_lte_rx::handle_data_pdu_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_pdu_header_t& header)
+void rlc_am_lte_rx::handle_data_pdu_segment(byte_buffer_slice payload, rlc_amd_pdu_header_t& header)
 {
   std::map<uint32_t, rlc_amd_rx_pdu_segments_t>::iterator it;
 
-  RlcHexInfo(payload,
+  uint32_t nof_bytes = payload.size();
+  RlcHexInfo(payload.data(),
              nof_bytes,
              "Rx data PDU segment of SN=%d (%d B), SO=%d, N_li=%d",
              header.sn,
@@ -1391,8 +1385,8 @@ void rlc_am_lte_rx::handle_data_pdu_segment(uint8_t* payload, uint32_t nof_bytes
   }
 
   rlc_amd_rx_pdu segment;
-  segment.buf = srsran::make_byte_buffer();
-  if (segment.buf == NULL) {
+  segment.buf = retain_slice(std::move(payload));
+  if (segment.buf.empty() && nof_bytes > 0) {
 #ifdef RLC_AM_BUFFER_DEBUG
     srsran::console("Fatal Error: Couldn't allocate PDU in handle_data_pdu_segment().\n");
     exit(-1);
@@ -1401,15 +1395,7 @@ void rlc_am_lte_rx::handle_data_pdu_segment(uint8_t* payload, uint32_t nof_bytes
     return;
 #endif
   }
-
-  if (segment.buf->get_tailroom() < nof_bytes) {
-    RlcInfo("Dropping corrupted segment SN=%d, not enough space to fit %d B", header.sn, nof_bytes);
-    return;
-  }
-
-  memcpy(segment.buf->msg, payload, nof_bytes);
-  segment.buf->N_bytes = nof_bytes;
-  segment.header       = header;
+  segment.header = header;
 
   // Check if we already have a segment from the same PDU
   it = rx_segments.find(header.sn);
@@ -1476,7 +1462,7 @@ void rlc_am_lte_rx::reassemble_rx_sdus()
     for (uint32_t i = 0; i < rx_window[vr_r].header.N_li; i++) {
       len = rx_window[vr_r].header.li[i];
 
-      RlcHexDebug(rx_window[vr_r].buf->msg,
+      RlcHexDebug(rx_window[vr_r].buf.data(),
                   len,
                   "Handling segment %d/%d of length %d B of SN=%d",
                   i + 1,
@@ -1490,47 +1476,39 @@ void rlc_am_lte_rx::reassemble_rx_sdus()
       }
 
       if (rx_sdu->get_tailroom() >= len) {
-        if ((rx_window[vr_r].buf->msg - rx_window[vr_r].buf->buffer) + len < SRSRAN_MAX_BUFFER_SIZE_BYTES) {
-          if (rx_window[vr_r].buf->N_bytes < len) {
-            RlcError("Dropping corrupted SN=%d", vr_r);
-            rx_sdu.reset();
-            goto exit;
-          }
-          // store timestamp of the first segment when starting to assemble SDUs
-          if (rx_sdu->N_bytes == 0) {
-            rx_sdu->set_timestamp(rx_window[vr_r].buf->get_timestamp());
-          }
-          memcpy(&rx_sdu->msg[rx_sdu->N_bytes], rx_window[vr_r].buf->msg, len);
-          rx_sdu->N_bytes += len;
-
-          rx_window[vr_r].buf->msg += len;
-          rx_window[vr_r].buf->N_bytes -= len;
-
-          RlcHexInfo(rx_sdu->msg, rx_sdu->N_bytes, "Rx SDU (%d B)", rx_sdu->N_bytes);
-          sdu_rx_latency_ms.push(std::chrono::duration_cast<std::chrono::milliseconds>(
-                                     std::chrono::high_resolution_clock::now() - rx_sdu->get_timestamp())
-                                     .count());
-          parent->pdcp->write_pdu(parent->lcid, std::move(rx_sdu));
-          {
-            std::lock_guard<std::mutex> lock(parent->metrics_mutex);
-            parent->metrics.num_rx_sdus++;
-          }
+        if (rx_window[vr_r].buf.size() < len) {
+          RlcError("Dropping corrupted SN=%d", vr_r);
+          rx_sdu.reset();
+          goto exit;
+        }
+        // store timestamp of the first segment when starting to assemble SDUs
+        if (rx_sdu->N_bytes == 0) {
+          rx_sdu->set_timestamp(rx_window[vr_r].rx_time);
+        }
+        memcpy(&rx_sdu->msg[rx_sdu->N_bytes], rx_window[vr_r].buf.data(), len);
+        rx_sdu->N_bytes += len;
+
+        rx_window[vr_r].buf.advance(len);
+
+        RlcHexInfo(rx_sdu->msg, rx_sdu->N_bytes, "Rx SDU (%d B)", rx_sdu->N_bytes);
+        sdu_rx_latency_ms.push(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                   std::chrono::high_resolution_clock::now() - rx_sdu->get_timestamp())
+                                   .count());
+        parent->pdcp->write_pdu(parent->lcid, std::move(rx_sdu));
+        {
+          std::lock_guard<std::mutex> lock(parent->metrics_mutex);
+          parent->metrics.num_rx_sdus++;
+        }
 
-          rx_sdu = srsran::make_byte_buffer();
-          if (rx_sdu == nullptr) {
+        rx_sdu = srsran::make_byte_buffer();
+        if (rx_sdu == nullptr) {
 #ifdef RLC_AM_BUFFER_DEBUG
-            srsran::console("Fatal Error: Could not allocate PDU in reassemble_rx_sdus() (2)\n");
-            exit(-1);
+          srsran::console("Fatal Error: Could not allocate PDU in reassemble_rx_sdus() (2)\n");
+          exit(-1);
 #else
-            RlcError("Fatal Error: Could not allocate PDU in reassemble_rx_sdus() (2)");
-            return;
+          RlcError("Fatal Error: Could not allocate PDU in reassemble_rx_sdus() (2)");
+          return;
 #endif
-          }
-        } else {
-          int buf_len = rx_window[vr_r].buf->msg - rx_window[vr_r].buf->buffer;
-          RlcError("Cannot read %d bytes from rx_window. vr_r=%d, msg-buffer=%d B", len, vr_r, buf_len);
-          rx_sdu.reset();
-          goto exit;
         }
       } else {
         RlcError("Cannot fit RLC PDU in SDU buffer, dropping both.");
@@ -1540,15 +1518,15 @@ void rlc_am_lte_rx::reassemble_rx_sdus()
     }
 
     // Handle last segment
-    len = rx_window[vr_r].buf->N_bytes;
-    RlcHexDebug(rx_window[vr_r].buf->msg, len, "Handling last segment of length %d B of SN=%d", len, vr_r);
+    len = rx_window[vr_r].buf.size();
+    RlcHexDebug(rx_window[vr_r].buf.data(), len, "Handling last segment of length %d B of SN=%d", len, vr_r);
     if (rx_sdu->get_tailroom() >= len) {
       // store timestamp of the first segment when starting to assemble SDUs
       if (rx_sdu->N_bytes == 0) {
-        rx_sdu->set_timestamp(rx_window[vr_r].buf->get_timestamp());
+        rx_sdu->set_timestamp(rx_window[vr_r].rx_time);
       }
-      memcpy(&rx_sdu->msg[rx_sdu->N_bytes], rx_window[vr_r].buf->msg, len);
-      rx_sdu->N_bytes += rx_window[vr_r].buf->N_bytes;
+      memcpy(&rx_sdu->msg[rx_sdu->N_bytes], rx_window[vr_r].buf.data(), len);
+      rx_sdu->N_bytes += len;
     } else {
       printf("Cannot fit RLC PDU in SDU buffer (tailroom=%d, len=%d), dropping both. Erasing SN=%d.\n",
              rx_sdu->get_tailroom(),
@@ -1594,7 +1572,7 @@ void rlc_am_lte_rx::reassemble_rx_sdus()
         RlcDebug(" Erasing segment of SN=%d SO=%d Len=%d N_li=%d",
                  segit->header.sn,
                  segit->header.so,
-                 segit->buf->N_bytes,
+                 segit->buf.size(),
                  segit->header.N_li);
       }
       it->second.segments.clear();
@@ -1739,7 +1717,7 @@ void rlc_am_lte_rx::print_rx_segments()
   for (it = rx_segments.begin(); it != rx_segments.end(); it++) {
     std::list<rlc_amd_rx_pdu>::iterator segit;
     for (segit = it->second.segments.begin(); segit != it->second.segments.end(); segit++) {
-      ss << "    SN=" << segit->header.sn << " SO:" << segit->header.so << " N:" << segit->buf->N_bytes
+      ss << "    SN=" << segit->header.sn << " SO:" << segit->header.so << " N:" << segit->buf.size()
          << " N_li: " << segit->header.N_li << std::endl;
     }
   }
@@ -1762,7 +1740,7 @@ bool rlc_am_lte_rx::add_segment_and_check(rlc_amd_rx_pdu_segments_t* pdu, rlc_am
     rlc_amd_rx_pdu& s = *it1;
     if (s.header.so == segment->header.so) {
       // Same Segment offset
-      if (segment->buf->N_bytes > s.buf->N_bytes) {
+      if (segment->buf.size() > s.buf.size()) {
         // replace if the new one is bigger
         s = std::move(*segment);
       } else {
@@ -1787,12 +1765,12 @@ bool rlc_am_lte_rx::add_segment_and_check(rlc_amd_rx_pdu_segments_t* pdu, rlc_am
     }
 
     // Check if segment is overlapped
-    if (it->header.so + it->buf->N_bytes <= so) {
+    if (it->header.so + it->buf.size() <= so) {
       // completely overlapped with previous segments, erase
       it = pdu->segments.erase(it); // Returns next iterator
     } else {
       // Update segment offset it shall not go backwards
-      so = SRSRAN_MAX(so, it->header.so + it->buf->N_bytes);
+      so = SRSRAN_MAX(so, it->header.so + it->buf.size());
       it++; // Increments iterator
     }
   }
@@ -1858,23 +1836,23 @@ bool rlc_am_lte_rx::add_segment_and_check(rlc_amd_rx_pdu_segments_t* pdu, rlc_am
       }
     }
 
-    if (count <= it->buf->N_bytes) {
-      carryover = it->header.so + it->buf->N_bytes;
+    if (count <= it->buf.size()) {
+      carryover = it->header.so + it->buf.size();
       // substract all previous LIs
       for (uint32_t k = 0; k < header.N_li; ++k) {
         carryover -= header.li[k];
       }
-      RlcDebug("Incremented carryover (it->buf->N_bytes=%d, count=%d). New carryover=%d",
-               it->buf->N_bytes,
+      RlcDebug("Incremented carryover (it->buf.size()=%d, count=%d). New carryover=%d",
+               it->buf.size(),
                count,
                carryover);
     } else {
       // Next segment would be too long, recalculate carryover
       header.N_li--;
-      carryover = it->buf->N_bytes - (count - header.li[header.N_li]);
-      RlcDebug("Recalculated carryover=%d (it->buf->N_bytes=%d, count=%d, header.li[header.N_li]=%d)",
+      carryover = it->buf.size() - (count - header.li[header.N_li]);
+      RlcDebug("Recalculated carryover=%d (it->buf.size()=%d, count=%d, header.li[header.N_li]=%d)",
                carryover,
-               it->buf->N_bytes,
+               it->buf.size(),
                count,
                header.li[header.N_li]);
     }
@@ -1912,18 +1890,18 @@ bool rlc_am_lte_rx::add_segment_and_check(rlc_amd_rx_pdu_segments_t* pdu, rlc_am
     uint32_t n       = 0;
 
     // Check if the segment has non-overlapped bytes
-    if (it->header.so + it->buf->N_bytes > full_pdu->N_bytes) {
+    if (it->header.so + it->buf.size() > full_pdu->N_bytes) {
       // Calculate overlap and number of bytes
       overlap = full_pdu->N_bytes - it->header.so;
-      n       = it->buf->N_bytes - overlap;
+      n       = it->buf.size() - overlap;
     }
 
     // Copy data itself
-    memcpy(&full_pdu->msg[full_pdu->N_bytes], &it->buf->msg[overlap], n);
+    memcpy(&full_pdu->msg[full_pdu->N_bytes], &it->buf.data()[overlap], n);
     full_pdu->N_bytes += n;
   }
 
-  handle_data_pdu_full(full_pdu->msg, full_pdu->N_bytes, header);
+  handle_data_pdu_full(make_shared_slice(std::move(full_pdu)), header);
   return true;
 }
 
@@ -209,18 +209,14 @@ uint32_t rlc_am_nr_tx::build_new_pdu(uint8_t* payload, uint32_t nof_bytes)
   // NOTE: from now on, we can't return from this function anymore before increasing tx_next
   rlc_amd_tx_pdu_nr& tx_pdu = tx_window->add_pdu(st.tx_next);
   tx_pdu.pdcp_sn            = tx_sdu->md.pdcp_sn;
-  tx_pdu.sdu_buf            = srsran::make_byte_buffer();
-  if (tx_pdu.sdu_buf == nullptr) {
-    RlcError("Couldn't allocate PDU in %s().", __FUNCTION__);
-    return 0;
-  }
 
-  // Copy SDU into TX window SDU info
-  memcpy(tx_pdu.sdu_buf->msg, tx_sdu->msg, tx_sdu->N_bytes);
-  tx_pdu.sdu_buf->N_bytes = tx_sdu->N_bytes;
+  // The TX window takes ownership of the SDU, it is kept for retransmissions and the PDU payload is copied from it
+  // straight into the MAC buffer
+  tx_pdu.sdu_buf          = std::move(tx_sdu);
+  const uint32_t sdu_size = tx_pdu.sdu_buf->N_bytes;
 
   // Segment new SDU if necessary
-  if (tx_sdu->N_bytes + min_hdr_size > nof_bytes) {
+  if (sdu_size + min_hdr_size > nof_bytes) {
     RlcInfo("trying to build PDU segment from SDU.");
     return build_new_sdu_segment(tx_pdu, payload, nof_bytes);
   }
@@ -228,7 +224,7 @@ uint32_t rlc_am_nr_tx::build_new_pdu(uint8_t* payload, uint32_t nof_bytes)
   // Prepare header
   rlc_am_nr_pdu_header_t hdr = {};
   hdr.dc                     = RLC_DC_FIELD_DATA_PDU;
-  hdr.p                      = get_pdu_poll(st.tx_next, false, tx_sdu->N_bytes);
+  hdr.p                      = get_pdu_poll(st.tx_next, false, sdu_size);
   hdr.si                     = rlc_nr_si_field_t::full_sdu;
   hdr.sn_size                = cfg.tx_sn_field_length;
   hdr.sn                     = st.tx_next;
@@ -236,18 +232,18 @@ uint32_t rlc_am_nr_tx::build_new_pdu(uint8_t* payload, uint32_t nof_bytes)
   log_rlc_am_nr_pdu_header_to_string(logger.info, hdr, rb_name);
 
   // Write header
-  uint32_t len = rlc_am_nr_write_data_pdu_header(hdr, tx_sdu.get());
-  if (len > nof_bytes) {
+  uint32_t hdr_len = rlc_am_nr_write_data_pdu_header(hdr, payload);
+  if (hdr_len + sdu_size > nof_bytes) {
     RlcError("error writing AMD PDU header");
   }
 
   // Update TX Next
   st.tx_next = (st.tx_next + 1) % mod_nr;
 
-  memcpy(payload, tx_sdu->msg, tx_sdu->N_bytes);
-  RlcDebug("wrote RLC PDU - %d bytes", tx_sdu->N_bytes);
+  memcpy(&payload[hdr_len], tx_pdu.sdu_buf->msg, sdu_size);
+  RlcDebug("wrote RLC PDU - %d bytes", hdr_len + sdu_size);
 
-  return tx_sdu->N_bytes;
+  return hdr_len + sdu_size;
 }
 
 /**
@@ -258,7 +254,7 @@ uint32_t rlc_am_nr_tx::build_new_pdu(uint8_t* payload, uint32_t nof_bytes)
  * \param [nof_bytes] is the number of bytes the RLC is allowed to fill.
  *
  * \returns the number of bytes written to the payload buffer.
- * \remark: This functions assumes that the SDU has already been copied to tx_pdu.sdu_buf.
+ * \remark: This functions assumes that the SDU is already stored in tx_pdu.sdu_buf.
  */
 uint32_t rlc_am_nr_tx::build_new_sdu_segment(rlc_amd_tx_pdu_nr& tx_pdu, uint8_t* payload, uint32_t nof_bytes)
 {
@@ -326,7 +322,7 @@ uint32_t rlc_am_nr_tx::build_new_sdu_segment(rlc_amd_tx_pdu_nr& tx_pdu, uint8_t*
  * \param [nof_bytes] is the number of bytes the RLC is allowed to fill.
  *
  * \returns the number of bytes written to the payload buffer.
- * \remark: This functions assumes that the SDU has already been copied to tx_pdu.sdu_buf.
+ * \remark: This functions assumes that the SDU is already stored in tx_pdu.sdu_buf.
  */
 uint32_t rlc_am_nr_tx::build_continuation_sdu_segment(rlc_amd_tx_pdu_nr& tx_pdu, uint8_t* payload, uint32_t nof_bytes)
 {
@@ -441,7 +437,7 @@ uint32_t rlc_am_nr_tx::build_continuation_sdu_segment(rlc_amd_tx_pdu_nr& tx_pdu,
  * \param [nof_bytes] is the number of bytes the RLC is allowed to fill.
  *
  * \returns the number of bytes written to the payload buffer.
- * \remark: This functions assumes that the SDU has already been copied to tx_pdu.sdu_buf.
+ * \remark: This functions assumes that the SDU is already stored in tx_pdu.sdu_buf.
  */
 uint32_t rlc_am_nr_tx::build_retx_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
@@ -589,7 +585,7 @@ rlc_am_nr_tx::build_retx_pdu_without_segmentation(const rlc_amd_retx_nr_t retx,
  * \param [nof_bytes] is the number of bytes the RLC is allowed to fill.
  *
  * \returns the number of bytes written to the payload buffer.
- * \remark: This functions assumes that the SDU has already been copied to tx_pdu.sdu_buf.
+ * \remark: This functions assumes that the SDU is already stored in tx_pdu.sdu_buf.
  */
 uint32_t rlc_am_nr_tx::build_retx_pdu_with_segmentation(rlc_amd_retx_nr_t& retx, uint8_t* payload, uint32_t nof_bytes)
 {
@@ -1435,10 +1431,13 @@ void rlc_am_nr_rx::reestablish()
   stop();
 }
 
-void rlc_am_nr_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_bytes)
+void rlc_am_nr_rx::handle_data_pdu(byte_buffer_slice pdu)
 {
   std::lock_guard<std::mutex> lock(mutex);
 
+  uint8_t* payload   = pdu.data();
+  uint32_t nof_bytes = pdu.size();
+
   // Get AMD PDU Header
   rlc_am_nr_pdu_header_t header  = {};
   uint32_t               hdr_len = rlc_am_nr_read_data_pdu_header(payload, nof_bytes, cfg.rx_sn_field_length, &header);
@@ -1474,7 +1473,7 @@ void rlc_am_nr_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_bytes)
   // Section 5.2.3.2.2, discard segments with overlapping bytes
   if (rx_window->has_sn(header.sn) && header.si != rlc_nr_si_field_t::full_sdu) {
     for (const auto& segm : (*rx_window)[header.sn].segments) {
-      uint32_t segm_last_byte = segm.header.so + segm.buf->N_bytes - 1;
+      uint32_t segm_last_byte = segm.header.so + segm.buf.size() - 1;
       uint32_t pdu_last_byte  = header.so + nof_bytes - hdr_len - 1;
       if ((header.so >= segm.header.so && header.so <= segm_last_byte) ||
           (pdu_last_byte >= segm.header.so && pdu_last_byte <= segm_last_byte)) {
@@ -1488,7 +1487,7 @@ void rlc_am_nr_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_bytes)
                 header.sn,
                 segm.header.so,
                 segm_last_byte,
-                segm.buf->N_bytes);
+                segm.buf.size());
         return;
       }
     }
@@ -1501,7 +1500,7 @@ void rlc_am_nr_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_bytes)
       return;
     }
   } else {
-    int err = handle_segment_data_sdu(header, payload, nof_bytes);
+    int err = handle_segment_data_sdu(header, std::move(pdu));
     if (err != SRSRAN_SUCCESS) {
       return;
     }
@@ -1657,9 +1656,7 @@ int rlc_am_nr_rx::handle_full_data_sdu(const rlc_am_nr_pdu_header_t& header, con
   return SRSRAN_SUCCESS;
 }
 
-int rlc_am_nr_rx::handle_segment_data_sdu(const rlc_am_nr_pdu_header_t& header,
-                                          const uint8_t*                payload,
-                                          uint32_t                      nof_bytes)
+int rlc_am_nr_rx::handle_segment_data_sdu(const rlc_am_nr_pdu_header_t& header, byte_buffer_slice pdu)
 {
   if (header.si == rlc_nr_si_field_t::full_sdu) {
     RlcError("called %s but the SI implies a full SDU. SN=%d", __FUNCTION__, header.sn);
@@ -1680,16 +1677,16 @@ int rlc_am_nr_rx::handle_segment_data_sdu(const rlc_am_nr_pdu_header_t& header,
   // Add a new SDU to the RX window if necessary
   rlc_amd_rx_sdu_nr_t& rx_sdu = rx_window->has_sn(header.sn) ? (*rx_window)[header.sn] : rx_window->add_pdu(header.sn);
 
-  // Create PDU segment info, to be stored later
+  // Create PDU segment info, to be stored later. The payload is kept as a slice of the received TB when it is shared
   rlc_amd_rx_pdu_nr pdu_segment = {};
   pdu_segment.header            = header;
-  pdu_segment.buf               = srsran::make_byte_buffer();
-  if (pdu_segment.buf == nullptr) {
+  pdu.advance(hdr_len); // Don't keep header
+  uint32_t payload_len = pdu.size();
+  pdu_segment.buf      = retain_slice(std::move(pdu));
+  if (pdu_segment.buf.empty() && payload_len > 0) {
     RlcError("fatal error. Couldn't allocate PDU in %s.", __FUNCTION__);
     return SRSRAN_ERROR;
   }
-  memcpy(pdu_segment.buf->msg, payload + hdr_len, nof_bytes - hdr_len); // Don't copy header
-  pdu_segment.buf->N_bytes = nof_bytes - hdr_len;
 
   // Store SDU segment. Sort by SO and check for duplicate bytes.
   insert_received_segment(std::move(pdu_segment), rx_sdu.segments);
@@ -1706,9 +1703,11 @@ int rlc_am_nr_rx::handle_segment_data_sdu(const rlc_am_nr_pdu_header_t& header,
     }
     // Assemble SDU from segments
     for (const auto& it : rx_sdu.segments) {
-      memcpy(&rx_sdu.buf->msg[rx_sdu.buf->N_bytes], it.buf->msg, it.buf->N_bytes);
-      rx_sdu.buf->N_bytes += it.buf->N_bytes;
+      memcpy(&rx_sdu.buf->msg[rx_sdu.buf->N_bytes], it.buf.data(), it.buf.size());
+      rx_sdu.buf->N_bytes += it.buf.size();
     }
+    // Release the TBs held by the segments, duplicates of a fully received SDU are discarded without checking them
+    rx_sdu.segments.clear();
   }
   return SRSRAN_SUCCESS;
 }
@@ -1762,7 +1761,7 @@ uint32_t rlc_am_nr_rx::get_status_pdu(rlc_am_nr_status_pdu_t* status, uint32_t m
               // Print segment list
               for (auto segm_it = (*rx_window)[i].segments.begin(); segm_it != (*rx_window)[i].segments.end();
                    segm_it++) {
-                RlcError("Segment: segm.header.so=%d, segm.buf.N_bytes=%d", segm_it->header.so, segm_it->buf->N_bytes);
+                RlcError("Segment: segm.header.so=%d, segm.buf.N_bytes=%d", segm_it->header.so, segm_it->buf.size());
               }
               RlcError("Error: SO_start=%d > SO_end=%d. NACK_SN=%d. SO_start=%d, SO_end=%d, seg.so=%d",
                        nack.so_start,
@@ -1786,7 +1785,7 @@ uint32_t rlc_am_nr_rx::get_status_pdu(rlc_am_nr_status_pdu_t* status, uint32_t m
           if (segm->header.si == rlc_nr_si_field_t::last_segment) {
             last_segment_rx = true;
           }
-          last_so = segm->header.so + segm->buf->N_bytes;
+          last_so = segm->header.so + segm->buf.size();
         } // Segment loop
         if (not last_segment_rx) {
           rlc_status_nack_t nack;
@@ -1948,7 +1947,7 @@ void rlc_am_nr_rx::update_segment_inventory(rlc_amd_rx_sdu_nr_t& rx_sdu) const
       rx_sdu.fully_received = true;
       return;
     }
-    next_byte += it.buf->N_bytes;
+    next_byte += it.buf.size();
   }
   // No gaps, but last segment not yet received
   rx_sdu.has_gap        = false;
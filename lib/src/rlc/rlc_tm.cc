@@ -54,7 +54,6 @@ void rlc_tm::empty_queue()
   unique_byte_buffer_t buf;
   while (ul_queue.try_read(&buf)) {
   }
-  ul_queue.reset();
 }
 
 void rlc_tm::reestablish()
@@ -176,11 +175,6 @@ uint32_t rlc_tm::read_pdu(uint8_t* payload, uint32_t nof_bytes)
     metrics.num_tx_pdu_bytes += pdu_size;
     return pdu_size;
   }
-
-  if (ul_queue.size_bytes() > 0) {
-    RlcWarning("Corrupted queue: empty but size_bytes > 0. Resetting queue");
-    ul_queue.reset();
-  }
   return 0;
 }
 
@@ -309,13 +309,8 @@ void rlc_um_base::rlc_um_base_tx::discard_sdu(uint32_t discard_sn)
 {
   std::lock_guard<std::mutex> lock(mutex);
 
-  bool discarded = tx_sdu_queue.apply_first([&discard_sn, this](unique_byte_buffer_t& sdu) {
-    if (sdu != nullptr && sdu->md.pdcp_sn == discard_sn) {
-      tx_sdu_queue.queue.pop_func(sdu);
-      sdu = nullptr;
-    }
-    return false;
-  });
+  bool discarded = tx_sdu_queue.discard_first(
+      [&discard_sn](const unique_byte_buffer_t& sdu) { return sdu->md.pdcp_sn == discard_sn; });
 
   // Discard fails when the PDCP PDU is already in Tx window.
   RlcInfo("%s PDU with PDCP_SN=%d", discarded ? "Discarding" : "Couldn't discard", discard_sn);
@@ -328,7 +323,6 @@ bool rlc_um_base::rlc_um_base_tx::sdu_queue_is_full()
 
 uint32_t rlc_um_base::rlc_um_base_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
-  unique_byte_buffer_t pdu;
   {
     std::lock_guard<std::mutex> lock(mutex);
     RlcDebug("MAC opportunity - %d bytes", nof_bytes);
@@ -337,14 +331,8 @@ uint32_t rlc_um_base::rlc_um_base_tx::build_data_pdu(uint8_t* payload, uint32_t
       RlcInfo("No data available to be sent");
       return 0;
     }
-
-    pdu = make_byte_buffer();
-    if (!pdu || pdu->N_bytes != 0) {
-      RlcError("Failed to allocate PDU buffer");
-      return 0;
-    }
   }
-  return build_data_pdu(std::move(pdu), payload, nof_bytes);
+  return pack_data_pdu(payload, nof_bytes);
 }
 
 } // namespace srsran
@@ -115,13 +115,14 @@ bool rlc_um_lte::rlc_um_lte_tx::configure(const rlc_config_t& cnfg_, std::string
   }
 
   tx_sdu_queue.resize(cnfg_.tx_queue_length);
+  tx_segments.reserve(cnfg_.tx_queue_length);
 
   rb_name = rb_name_;
 
   return true;
 }
 
-uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes)
+uint32_t rlc_um_lte::rlc_um_lte_tx::pack_data_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
   std::lock_guard<std::mutex> lock(mutex);
   rlc_umd_pdu_header_t        header = {};
@@ -132,40 +133,25 @@ uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uin
 
   uint32_t to_move = 0;
   uint32_t last_li = 0;
-  uint8_t* pdu_ptr = pdu->msg;
 
   int head_len  = rlc_um_packed_length(&header);
-  int pdu_space = SRSRAN_MIN(nof_bytes, pdu->get_tailroom());
+  int pdu_space = nof_bytes;
 
   if (pdu_space <= head_len + 1) {
     RlcInfo("Cannot build a PDU - %d bytes available, %d bytes required for header", nof_bytes, head_len);
     return 0;
   }
 
+  tx_segments.clear();
+
   // Check for SDU segment
   if (tx_sdu) {
     uint32_t space = pdu_space - head_len;
     to_move        = space >= tx_sdu->N_bytes ? tx_sdu->N_bytes : space;
     RlcDebug("adding remainder of SDU segment - %d bytes of %d remaining", to_move, tx_sdu->N_bytes);
-    memcpy(pdu_ptr, tx_sdu->msg, to_move);
+    add_tx_segment(to_move);
     last_li = to_move;
-    pdu_ptr += to_move;
-    pdu->N_bytes += to_move;
-    tx_sdu->N_bytes -= to_move;
-    tx_sdu->msg += to_move;
-    if (tx_sdu->N_bytes == 0) {
-#ifdef ENABLE_TIMESTAMP
-      auto latency_us = tx_sdu->get_latency_us().count();
-      mean_pdu_latency_us.push(latency_us);
-      RlcDebug("Complete SDU scheduled for tx. Stack latency (last/average): %" PRIu64 "/%ld us",
-               (uint64_t)latency_us,
-               (long)mean_pdu_latency_us.value());
-#else
-      RlcDebug("%s Complete SDU scheduled for tx.", rb_name.c_str());
-#endif
-      tx_sdu.reset();
-    }
-    pdu_space -= SRSRAN_MIN(to_move, pdu->get_tailroom());
+    pdu_space -= to_move;
     header.fi |= RLC_FI_FIELD_NOT_START_ALIGNED; // First byte does not correspond to first byte of SDU
   }
 
@@ -185,24 +171,8 @@ uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uin
     tx_sdu  = tx_sdu_queue.read();
     to_move = (space >= tx_sdu->N_bytes) ? tx_sdu->N_bytes : space;
     RlcDebug("adding new SDU segment - %d bytes of %d remaining", to_move, tx_sdu->N_bytes);
-    memcpy(pdu_ptr, tx_sdu->msg, to_move);
+    add_tx_segment(to_move);
     last_li = to_move;
-    pdu_ptr += to_move;
-    pdu->N_bytes += to_move;
-    tx_sdu->N_bytes -= to_move;
-    tx_sdu->msg += to_move;
-    if (tx_sdu->N_bytes == 0) {
-#ifdef ENABLE_TIMESTAMP
-      auto latency_us = tx_sdu->get_latency_us().count();
-      mean_pdu_latency_us.push(latency_us);
-      RlcDebug("Complete SDU scheduled for tx. Stack latency (last/average): %" PRIu64 "/%ld us",
-               (uint64_t)latency_us,
-               (long)mean_pdu_latency_us.value());
-#else
-      RlcDebug("Complete SDU scheduled for tx.");
-#endif
-      tx_sdu.reset();
-    }
     pdu_space -= to_move;
   }
 
@@ -214,15 +184,45 @@ uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uin
   header.sn = vt_us;
   vt_us     = (vt_us + 1) % cfg.um.tx_mod;
 
-  // Add header and TX
-  rlc_um_write_data_pdu_header(&header, pdu.get());
-  memcpy(payload, pdu->msg, pdu->N_bytes);
+  // Add header and gather the SDU segments behind it
+  uint32_t pdu_len = rlc_um_write_data_pdu_header(&header, payload);
+  for (const tx_segment_t& segment : tx_segments) {
+    memcpy(&payload[pdu_len], segment.ptr, segment.len);
+    pdu_len += segment.len;
+  }
+  tx_segments.clear();
 
-  RlcHexInfo(payload, pdu->N_bytes, "Tx PDU SN=%d (%d B)", header.sn, pdu->N_bytes);
+  RlcHexInfo(payload, pdu_len, "Tx PDU SN=%d (%d B)", header.sn, pdu_len);
 
   debug_state();
 
-  return pdu->N_bytes;
+  return pdu_len;
+}
+
+/**
+ * Takes the next to_move bytes of tx_sdu for the PDU being built. The bytes are not copied yet, if the SDU is
+ * completely consumed its ownership is moved to the segment list so the data stays valid until the PDU is packed.
+ */
+void rlc_um_lte::rlc_um_lte_tx::add_tx_segment(uint32_t to_move)
+{
+  tx_segment_t segment;
+  segment.ptr = tx_sdu->msg;
+  segment.len = to_move;
+  tx_sdu->N_bytes -= to_move;
+  tx_sdu->msg += to_move;
+  if (tx_sdu->N_bytes == 0) {
+#ifdef ENABLE_TIMESTAMP
+    auto latency_us = tx_sdu->get_latency_us().count();
+    mean_pdu_latency_us.push(latency_us);
+    RlcDebug("Complete SDU scheduled for tx. Stack latency (last/average): %" PRIu64 "/%ld us",
+             (uint64_t)latency_us,
+             (long)mean_pdu_latency_us.value());
+#else
+    RlcDebug("Complete SDU scheduled for tx.");
+#endif
+    segment.sdu = std::move(tx_sdu);
+  }
+  tx_segments.push_back(std::move(segment));
 }
 
 void rlc_um_lte::rlc_um_lte_tx::debug_state()
@@ -761,12 +761,17 @@ void rlc_um_read_data_pdu_header(uint8_t*              payload,
 
 void rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, byte_buffer_t* pdu)
 {
-  uint32_t i;
-  uint8_t  ext = (header->N_li > 0) ? 1 : 0;
   // Make room for the header
   uint32_t len = rlc_um_packed_length(header);
   pdu->msg -= len;
-  uint8_t* ptr = pdu->msg;
+  pdu->N_bytes += rlc_um_write_data_pdu_header(header, pdu->msg);
+}
+
+uint32_t rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, uint8_t* payload)
+{
+  uint32_t i;
+  uint8_t  ext = (header->N_li > 0) ? 1 : 0;
+  uint8_t* ptr = payload;
 
   // Fixed part
   if (header->sn_size == rlc_umd_sn_size_t::size5bits) {
@@ -806,7 +811,7 @@ void rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, byte_buffer_t* p
   if (header->N_li % 2 == 1)
     ptr++;
 
-  pdu->N_bytes += ptr - pdu->msg;
+  return ptr - payload;
 }
 
 uint32_t rlc_um_packed_length(rlc_umd_pdu_header_t* header)
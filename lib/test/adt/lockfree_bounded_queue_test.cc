@@ -0,0 +1,123 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/lockfree_bounded_queue.h"
+#include "srsran/common/test_common.h"
+#include <thread>
+#include <vector>
+
+namespace srsran {
+
+void test_lockfree_queue_basic_api()
+{
+  lockfree_bounded_queue<std::unique_ptr<int> > queue(4);
+  TESTASSERT(queue.empty() and queue.size() == 0 and queue.max_size() == 4);
+
+  std::unique_ptr<int> val(new int(0));
+  TESTASSERT(queue.try_push(std::move(val)));
+  TESTASSERT(val == nullptr and queue.size() == 1);
+
+  std::unique_ptr<int> batch[5];
+  for (int i = 0; i < 5; ++i) {
+    batch[i].reset(new int(i + 1));
+  }
+  TESTASSERT(queue.try_push_batch(batch, 5) == 3);
+  TESTASSERT(queue.full());
+  TESTASSERT(batch[3] != nullptr and *batch[3] == 4);
+  TESTASSERT(not queue.try_push(std::move(batch[3])));
+  TESTASSERT(batch[3] != nullptr);
+
+  TESTASSERT(queue.try_call_on_front([](const std::unique_ptr<int>& v) { TESTASSERT(*v == 0); }));
+  TESTASSERT(queue.apply_first([](const std::unique_ptr<int>& v) { return *v == 2; }));
+  TESTASSERT(not queue.apply_first([](const std::unique_ptr<int>& v) { return *v == 4; }));
+
+  // Pop in order across the wrap around
+  for (int i = 0; i < 6; ++i) {
+    TESTASSERT(queue.try_pop(val) and *val == i);
+    if (i < 2) {
+      TESTASSERT(queue.try_push(std::move(batch[3 + i])));
+    }
+  }
+  TESTASSERT(not queue.try_pop(val));
+  TESTASSERT(queue.empty());
+
+  queue.set_size(8);
+  TESTASSERT(queue.max_size() == 8 and queue.empty());
+}
+
+void test_lockfree_queue_concurrent()
+{
+  const int nof_producers = 3, nof_consumers = 2, nof_items = 100000;
+
+  lockfree_bounded_queue<int> queue(16);
+  std::atomic<long>           sum{0};
+  std::atomic<int>            nof_popped{0};
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < nof_producers; ++p) {
+    threads.emplace_back([&queue, p]() {
+      int next = 0;
+      while (next < nof_items) {
+        int batch[4];
+        int n = std::min(4, nof_items - next);
+        for (int i = 0; i < n; ++i) {
+          batch[i] = next + i + 1;
+        }
+        next += queue.try_push_batch(batch, p == 0 ? 1 : n);
+        std::this_thread::yield();
+      }
+    });
+  }
+  for (int c = 0; c < nof_consumers; ++c) {
+    threads.emplace_back([&queue, &sum, &nof_popped]() {
+      int val;
+      while (nof_popped < nof_producers * nof_items) {
+        if (queue.try_pop(val)) {
+          sum += val;
+          nof_popped++;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  TESTASSERT(queue.empty());
+  TESTASSERT(sum == (long)nof_producers * nof_items * (nof_items + 1) / 2);
+}
+
+} // namespace srsran
+
+int main(int argc, char** argv)
+{
+  auto& test_log = srslog::fetch_basic_logger("TEST");
+  test_log.set_level(srslog::basic_levels::info);
+
+  srsran::test_init(argc, argv);
+
+  srsran::test_lockfree_queue_basic_api();
+  srsran::test_lockfree_queue_concurrent();
+  srsran::console("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -21,15 +21,36 @@
 
 #define NMSGS 1000000
 
+#include "srsran/adt/circular_buffer.h"
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/test_common.h"
 #include "srsran/upper/byte_buffer_queue.h"
+#include <chrono>
 #include <stdio.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
 
 using namespace srsran;
 
-typedef struct {
-  byte_buffer_queue* q;
-} args_t;
+static uint32_t bench_nof_msgs    = 200000;
+static uint32_t bench_max_writers = 4;
+
+unique_byte_buffer_t make_msg(uint32_t writer_id, uint32_t count, uint32_t nof_bytes = 8)
+{
+  unique_byte_buffer_t b;
+  do {
+    b = srsran::make_byte_buffer();
+    if (b == nullptr) {
+      // wait until pool is not depleted
+      std::this_thread::yield();
+    }
+  } while (b == nullptr);
+  memcpy(b->msg, &writer_id, 4);
+  memcpy(b->msg + 4, &count, 4);
+  b->N_bytes = nof_bytes;
+  return b;
+}
 
 void write_thread(byte_buffer_queue* q)
 {
@@ -80,7 +101,225 @@ int test_concurrent_writeread()
   return result;
 }
 
-int main()
+/// Several writers, the reader checks the order of every writer and that the counters never exceed the queue
+int test_concurrent_multi_writer()
+{
+  const uint32_t    nof_writers = 4;
+  const uint32_t    nof_msgs    = NMSGS / 10;
+  byte_buffer_queue q(64);
+
+  std::vector<std::thread> writers;
+  for (uint32_t w = 0; w < nof_writers; w++) {
+    writers.emplace_back([&q, w, nof_msgs]() {
+      for (uint32_t i = 0; i < nof_msgs; i++) {
+        q.write(make_msg(w, i, 8 + i % 16));
+      }
+    });
+  }
+
+  std::vector<uint32_t> next(nof_writers, 0);
+  for (uint32_t i = 0; i < nof_writers * nof_msgs; i++) {
+    TESTASSERT(q.get_n_sdus() <= nof_writers * nof_msgs);
+    unique_byte_buffer_t b = q.read();
+    TESTASSERT(b != nullptr);
+    uint32_t w = 0, count = 0;
+    memcpy(&w, b->msg, 4);
+    memcpy(&count, b->msg + 4, 4);
+    TESTASSERT(w < nof_writers);
+    TESTASSERT(count == next[w]);
+    TESTASSERT(b->N_bytes == 8 + count % 16);
+    next[w]++;
+  }
+
+  for (auto& t : writers) {
+    t.join();
+  }
+  TESTASSERT(q.is_empty());
+  TESTASSERT(q.size_bytes() == 0);
+  TESTASSERT(q.get_n_sdus() == 0);
+
+  printf("Passed multi writer\n");
+  return SRSRAN_SUCCESS;
+}
+
+int test_batch_write_and_discard()
 {
-  return test_concurrent_writeread();
+  byte_buffer_queue q(8);
+
+  // Only the first 8 SDUs fit, the rest are returned untouched
+  std::vector<unique_byte_buffer_t> batch;
+  uint32_t                          nof_bytes = 0;
+  for (uint32_t i = 0; i < 12; i++) {
+    batch.push_back(make_msg(0, i, 10 + i));
+    batch.back()->md.pdcp_sn = i;
+    nof_bytes += i < 8 ? 10 + i : 0;
+  }
+  TESTASSERT(q.try_write_batch(batch.data(), batch.size()) == 8);
+  TESTASSERT(q.is_full());
+  TESTASSERT(q.get_n_sdus() == 8);
+  TESTASSERT(q.size_bytes() == nof_bytes);
+  for (uint32_t i = 0; i < 12; i++) {
+    TESTASSERT((batch[i] == nullptr) == (i < 8));
+  }
+  TESTASSERT(not q.try_write(std::move(batch[8])));
+
+  // Discard leaves a hole that is read as nullptr
+  TESTASSERT(q.discard_first([](const unique_byte_buffer_t& sdu) { return sdu->md.pdcp_sn == 1; }));
+  TESTASSERT(not q.discard_first([](const unique_byte_buffer_t& sdu) { return sdu->md.pdcp_sn == 1; }));
+  TESTASSERT(q.get_n_sdus() == 7);
+  TESTASSERT(q.size() == 8);
+  TESTASSERT(q.size_bytes() == nof_bytes - 11);
+  TESTASSERT(q.size_tail_bytes() == 10);
+
+  unique_byte_buffer_t b;
+  TESTASSERT(q.try_read(&b) and b->md.pdcp_sn == 0);
+  TESTASSERT(q.try_read(&b) and b == nullptr);
+  TESTASSERT(q.try_read(&b) and b->md.pdcp_sn == 2);
+
+  // Wrap around
+  TESTASSERT(q.try_write_batch(&batch[9], 3) == 3);
+  for (uint32_t sn = 3; sn < 12; sn++) {
+    if (sn == 8) {
+      continue;
+    }
+    TESTASSERT(q.try_read(&b) and b->md.pdcp_sn == sn);
+  }
+  TESTASSERT(not q.try_read(&b));
+  TESTASSERT(q.size_bytes() == 0 and q.get_n_sdus() == 0);
+
+  printf("Passed batch write and discard\n");
+  return SRSRAN_SUCCESS;
+}
+
+/// Previous implementation of the SDU queue, protected by a mutex, kept as benchmark reference
+class mutex_byte_buffer_queue
+{
+public:
+  explicit mutex_byte_buffer_queue(int capacity) :
+    queue(capacity, push_callback(unread_bytes, n_sdus), pop_callback(unread_bytes, n_sdus))
+  {}
+  void     write(unique_byte_buffer_t msg) { queue.push_blocking(std::move(msg)); }
+  bool     try_read(unique_byte_buffer_t* msg) { return queue.try_pop(*msg); }
+  uint32_t get_n_sdus() { return n_sdus; }
+  uint32_t size_bytes() { return unread_bytes; }
+
+private:
+  struct push_callback {
+    explicit push_callback(std::atomic<uint32_t>& unread_bytes_, std::atomic<uint32_t>& n_sdus_) :
+      unread_bytes(unread_bytes_), n_sdus(n_sdus_)
+    {}
+    void operator()(const unique_byte_buffer_t& msg)
+    {
+      unread_bytes.fetch_add(msg->N_bytes, std::memory_order_relaxed);
+      n_sdus.fetch_add(1, std::memory_order_relaxed);
+    }
+    std::atomic<uint32_t>& unread_bytes;
+    std::atomic<uint32_t>& n_sdus;
+  };
+  struct pop_callback {
+    explicit pop_callback(std::atomic<uint32_t>& unread_bytes_, std::atomic<uint32_t>& n_sdus_) :
+      unread_bytes(unread_bytes_), n_sdus(n_sdus_)
+    {}
+    void operator()(const unique_byte_buffer_t& msg)
+    {
+      unread_bytes.fetch_sub(msg->N_bytes, std::memory_order_relaxed);
+      n_sdus.fetch_sub(1, std::memory_order_relaxed);
+    }
+    std::atomic<uint32_t>& unread_bytes;
+    std::atomic<uint32_t>& n_sdus;
+  };
+
+  std::atomic<uint32_t> unread_bytes = {0};
+  std::atomic<uint32_t> n_sdus       = {0};
+
+  dyn_blocking_queue<unique_byte_buffer_t, push_callback, pop_callback> queue;
+};
+
+/// Writers push SDUs as fast as possible while the reader, like the MAC, polls the buffer state before every read
+template <typename Queue>
+double run_contention_benchmark(uint32_t nof_writers, uint32_t nof_msgs)
+{
+  Queue q(512);
+
+  auto                     tic = std::chrono::steady_clock::now();
+  std::vector<std::thread> writers;
+  for (uint32_t w = 0; w < nof_writers; w++) {
+    writers.emplace_back([&q, w, nof_msgs, nof_writers]() {
+      for (uint32_t i = 0; i < nof_msgs / nof_writers; i++) {
+        q.write(make_msg(w, i));
+      }
+    });
+  }
+
+  uint64_t             nof_polls = 0;
+  uint32_t             nof_read  = 0;
+  unique_byte_buffer_t b;
+  while (nof_read < (nof_msgs / nof_writers) * nof_writers) {
+    nof_polls += q.size_bytes() + q.get_n_sdus() > 0 ? 1 : 0;
+    if (q.try_read(&b)) {
+      nof_read++;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  for (auto& t : writers) {
+    t.join();
+  }
+  auto toc = std::chrono::steady_clock::now();
+
+  TESTASSERT(q.size_bytes() == 0 and q.get_n_sdus() == 0);
+  return nof_read / std::chrono::duration<double>(toc - tic).count();
+}
+
+int run_benchmark()
+{
+  for (uint32_t nof_writers = 1; nof_writers <= bench_max_writers; nof_writers *= 2) {
+    double lockfree = run_contention_benchmark<byte_buffer_queue>(nof_writers, bench_nof_msgs);
+    double locked   = run_contention_benchmark<mutex_byte_buffer_queue>(nof_writers, bench_nof_msgs);
+    printf("Writers=%d: lock-free %.2f MSDU/s, mutex %.2f MSDU/s (x%.2f)\n",
+           nof_writers,
+           lockfree / 1e6,
+           locked / 1e6,
+           lockfree / locked);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+void usage(char* prog)
+{
+  printf("Usage: %s [nw]\n", prog);
+  printf("\t-n number of SDUs per benchmark run [Default %d]\n", bench_nof_msgs);
+  printf("\t-w maximum number of writer threads in the benchmark [Default %d]\n", bench_max_writers);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "nw")) != -1) {
+    switch (opt) {
+      case 'n':
+        bench_nof_msgs = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'w':
+        bench_max_writers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  if (test_concurrent_writeread() != SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+  TESTASSERT(test_concurrent_multi_writer() == SRSRAN_SUCCESS);
+  TESTASSERT(test_batch_write_and_discard() == SRSRAN_SUCCESS);
+  TESTASSERT(run_benchmark() == SRSRAN_SUCCESS);
+
+  return SRSRAN_SUCCESS;
 }
@@ -0,0 +1,292 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/mac_pcap.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <getopt.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <thread>
+#include <vector>
+
+static uint32_t bench_nof_pdus    = 200000;
+static uint32_t bench_nof_threads = 4;
+static uint32_t bench_burst_size  = 25;
+
+struct pcap_file_info_t {
+  uint32_t nof_records   = 0;
+  uint32_t nof_truncated = 0;
+  uint64_t nof_bytes     = 0;
+  uint32_t max_incl_len  = 0;
+  uint32_t max_orig_len  = 0;
+  bool     valid         = false;
+};
+
+/// Parses the records of a PCAP file, checking that the file is not truncated in the middle of a record
+static pcap_file_info_t read_pcap_file(const std::string& filename)
+{
+  pcap_file_info_t info = {};
+  FILE*            f    = fopen(filename.c_str(), "rb");
+  if (f == nullptr) {
+    return info;
+  }
+  pcap_hdr_t file_header = {};
+  if (fread(&file_header, sizeof(file_header), 1, f) != 1 or file_header.magic_number != 0xa1b2c3d4) {
+    fclose(f);
+    return info;
+  }
+  pcaprec_hdr_t        rec = {};
+  std::vector<uint8_t> data(65536);
+  while (fread(&rec, sizeof(rec), 1, f) == 1) {
+    if (rec.incl_len > data.size() or fread(data.data(), 1, rec.incl_len, f) != rec.incl_len) {
+      fclose(f);
+      return info;
+    }
+    info.nof_records++;
+    info.nof_truncated += rec.incl_len < rec.orig_len ? 1 : 0;
+    info.nof_bytes += rec.incl_len;
+    info.max_incl_len = std::max(info.max_incl_len, rec.incl_len);
+    info.max_orig_len = std::max(info.max_orig_len, rec.orig_len);
+  }
+  info.valid = feof(f);
+  fclose(f);
+  return info;
+}
+
+/// Writes nof_pdus PDUs, in bursts of burst_size PDUs per TTI if burst_size is not 0
+static void write_pdus(srsran::mac_pcap* pcap, uint32_t nof_pdus, uint32_t pdu_len, uint32_t burst_size = 0)
+{
+  std::vector<uint8_t> pdu(pdu_len, 0x02);
+  auto                 tti_start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < nof_pdus; i++) {
+    if (i % 2 == 0) {
+      pcap->write_ul_crnti(pdu.data(), pdu.size(), 0x46, 0, i, 0);
+    } else {
+      pcap->write_dl_crnti_nr(pdu.data(), pdu.size(), 0x4601, 0, i);
+    }
+    if (burst_size > 0 and (i + 1) % burst_size == 0) {
+      tti_start += std::chrono::milliseconds(1);
+      std::this_thread::sleep_until(tti_start);
+    }
+  }
+}
+
+int test_multi_writer()
+{
+  const char*      filename = "mac_pcap_test.pcap";
+  srsran::mac_pcap pcap;
+  TESTASSERT(pcap.open(filename) == SRSRAN_SUCCESS);
+  TESTASSERT(pcap.open(filename) != SRSRAN_SUCCESS);
+
+  std::vector<std::thread> writers;
+  for (uint32_t i = 0; i < 4; i++) {
+    writers.emplace_back(write_pdus, &pcap, 1000, 150, 0);
+  }
+  for (auto& t : writers) {
+    t.join();
+  }
+  TESTASSERT(pcap.close() == SRSRAN_SUCCESS);
+  TESTASSERT(pcap.close() != SRSRAN_SUCCESS);
+
+  srsran::pcap_metrics_t metrics = {};
+  pcap.get_metrics(metrics);
+  TESTASSERT(metrics.nof_written_pdus + metrics.nof_dropped_pdus == 4000);
+
+  pcap_file_info_t info = read_pcap_file(filename);
+  TESTASSERT(info.valid);
+  TESTASSERT(info.nof_records == metrics.nof_written_pdus);
+  TESTASSERT(info.nof_truncated == 0);
+  remove(filename);
+  return SRSRAN_SUCCESS;
+}
+
+int test_truncation()
+{
+  const char*              filename = "mac_pcap_trunc_test.pcap";
+  srsran::pcap_file_args_t args     = {};
+  args.max_payload_len              = 16;
+  srsran::mac_pcap pcap;
+  TESTASSERT(pcap.open(filename, 0, args) == SRSRAN_SUCCESS);
+  write_pdus(&pcap, 100, 150);
+  TESTASSERT(pcap.close() == SRSRAN_SUCCESS);
+
+  srsran::pcap_metrics_t metrics = {};
+  pcap.get_metrics(metrics);
+  TESTASSERT(metrics.nof_written_bytes == metrics.nof_written_pdus * 16);
+
+  // The pseudo headers are kept, and the original length is reported
+  pcap_file_info_t info = read_pcap_file(filename);
+  TESTASSERT(info.valid);
+  TESTASSERT(info.nof_records == metrics.nof_written_pdus);
+  TESTASSERT(info.nof_truncated == info.nof_records);
+  TESTASSERT(info.max_orig_len - info.max_incl_len == 150 - 16);
+  remove(filename);
+  return SRSRAN_SUCCESS;
+}
+
+int test_rotation()
+{
+  const char*              filename = "mac_pcap_rotation_test.pcap";
+  srsran::pcap_file_args_t args     = {};
+  args.max_file_size_mb             = 1;
+  srsran::mac_pcap pcap;
+  TESTASSERT(pcap.open(filename, 0, args) == SRSRAN_SUCCESS);
+
+  // Write about 2.5 MB in several bursts
+  for (uint32_t i = 0; i < 10; i++) {
+    write_pdus(&pcap, 200, 1200);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  TESTASSERT(pcap.close() == SRSRAN_SUCCESS);
+
+  srsran::pcap_metrics_t metrics = {};
+  pcap.get_metrics(metrics);
+
+  std::vector<std::string> files       = {filename, "mac_pcap_rotation_test.1.pcap", "mac_pcap_rotation_test.2.pcap"};
+  uint32_t                 nof_records = 0;
+  for (const auto& f : files) {
+    pcap_file_info_t info = read_pcap_file(f);
+    TESTASSERT(info.valid);
+    TESTASSERT(info.nof_bytes + sizeof(pcap_hdr_t) + info.nof_records * sizeof(pcaprec_hdr_t) <= 1024 * 1024);
+    nof_records += info.nof_records;
+    remove(f.c_str());
+  }
+  TESTASSERT(nof_records == metrics.nof_written_pdus);
+  return SRSRAN_SUCCESS;
+}
+
+int test_file_size_limit()
+{
+  // The file cannot grow past its first 4 MB segment, as with a full disk
+  const char*   filename  = "mac_pcap_limit_test.pcap";
+  struct rlimit old_limit = {};
+  TESTASSERT(getrlimit(RLIMIT_FSIZE, &old_limit) == 0);
+  struct rlimit limit = old_limit;
+  limit.rlim_cur      = 5 * 1024 * 1024;
+  TESTASSERT(setrlimit(RLIMIT_FSIZE, &limit) == 0);
+  sighandler_t old_handler = signal(SIGXFSZ, SIG_IGN);
+
+  srsran::mac_pcap pcap;
+  TESTASSERT(pcap.open(filename) == SRSRAN_SUCCESS);
+
+  // Write about 6 MB in several bursts, the PDUs after the first segment are dropped
+  const uint32_t nof_pdus = 4000;
+  for (uint32_t i = 0; i < 10; i++) {
+    write_pdus(&pcap, nof_pdus / 10, 1500);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  // The writer closed the file when the second segment could not be reserved
+  TESTASSERT(pcap.close() == SRSRAN_ERROR);
+
+  signal(SIGXFSZ, old_handler);
+  TESTASSERT(setrlimit(RLIMIT_FSIZE, &old_limit) == 0);
+
+  srsran::pcap_metrics_t metrics = {};
+  pcap.get_metrics(metrics);
+  TESTASSERT(metrics.nof_written_pdus + metrics.nof_dropped_pdus == nof_pdus);
+  TESTASSERT(metrics.nof_written_pdus > 0);
+  TESTASSERT(metrics.nof_dropped_pdus > 0);
+
+  // Only the PDUs written are counted, and the file is left with complete records
+  pcap_file_info_t info = read_pcap_file(filename);
+  TESTASSERT(info.valid);
+  TESTASSERT(info.nof_records == metrics.nof_written_pdus);
+  TESTASSERT(metrics.nof_written_bytes == metrics.nof_written_pdus * 1500);
+  TESTASSERT(sizeof(pcap_hdr_t) + info.nof_records * sizeof(pcaprec_hdr_t) + info.nof_bytes <= 4 * 1024 * 1024);
+  remove(filename);
+  return SRSRAN_SUCCESS;
+}
+
+int run_benchmark()
+{
+  const char*      filename = "mac_pcap_bench.pcap";
+  srsran::mac_pcap pcap;
+  TESTASSERT(pcap.open(filename) == SRSRAN_SUCCESS);
+
+  auto                     tic = std::chrono::steady_clock::now();
+  std::vector<std::thread> writers;
+  for (uint32_t i = 0; i < bench_nof_threads; i++) {
+    writers.emplace_back(write_pdus, &pcap, bench_nof_pdus / bench_nof_threads, 1500, bench_burst_size);
+  }
+  for (auto& t : writers) {
+    t.join();
+  }
+  TESTASSERT(pcap.close() == SRSRAN_SUCCESS);
+  double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - tic).count();
+
+  srsran::pcap_metrics_t metrics = {};
+  pcap.get_metrics(metrics);
+  printf("PCAP benchmark with %d producers and %d PDUs per TTI: %.1f kPDU/s written (%.1f MB/s), %.2f%% dropped\n",
+         bench_nof_threads,
+         bench_burst_size,
+         metrics.nof_written_pdus / secs / 1e3,
+         metrics.nof_written_bytes / secs / 1e6,
+         100.0 * metrics.nof_dropped_pdus / (metrics.nof_written_pdus + metrics.nof_dropped_pdus));
+  remove(filename);
+  return SRSRAN_SUCCESS;
+}
+
+void usage(char* prog)
+{
+  printf("Usage: %s [ntb]\n", prog);
+  printf("\t-n number of PDUs written in the benchmark [Default %d]\n", bench_nof_pdus);
+  printf("\t-t number of producer threads in the benchmark [Default %d]\n", bench_nof_threads);
+  printf("\t-b PDUs written by each producer per TTI, 0 to write as fast as possible [Default %d]\n", bench_burst_size);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "ntb")) != -1) {
+    switch (opt) {
+      case 'n':
+        bench_nof_pdus = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 't':
+        bench_nof_threads = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'b':
+        bench_burst_size = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  // Drops are expected in the benchmark and reported in the metrics
+  srslog::fetch_basic_logger("MAC", false).set_level(srslog::basic_levels::error);
+  srslog::init();
+
+  TESTASSERT(test_multi_writer() == SRSRAN_SUCCESS);
+  TESTASSERT(test_truncation() == SRSRAN_SUCCESS);
+  TESTASSERT(test_rotation() == SRSRAN_SUCCESS);
+  TESTASSERT(test_file_size_limit() == SRSRAN_SUCCESS);
+  TESTASSERT(run_benchmark() == SRSRAN_SUCCESS);
+
+  return SRSRAN_SUCCESS;
+}
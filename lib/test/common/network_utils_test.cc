@@ -23,7 +23,13 @@
 #include "srsran/common/task_scheduler.h"
 #include "srsran/common/test_common.h"
 #include <atomic>
+#include <chrono>
+#include <getopt.h>
 #include <iostream>
+#include <vector>
+
+static uint32_t bench_nof_sockets = 256;
+static uint32_t bench_nof_pkts    = 20000;
 
 struct rx_thread_tester {
   srsran::task_scheduler    task_sched;
@@ -136,8 +142,149 @@ int test_sctp_bind_error()
   return SRSRAN_SUCCESS;
 }
 
-int main()
+/// Opens nof_sockets UDP sockets bound to ephemeral loopback ports
+static std::vector<srsran::unique_socket> make_udp_sockets(uint32_t nof_sockets, std::vector<sockaddr_in>& addrs)
+{
+  using namespace srsran::net_utils;
+  std::vector<srsran::unique_socket> socks(nof_sockets);
+  addrs.resize(nof_sockets);
+  for (uint32_t i = 0; i < nof_sockets; ++i) {
+    if (not socks[i].open_socket(addr_family::ipv4, socket_type::datagram, protocol_type::UDP) or
+        not socks[i].bind_addr("127.0.0.1", 0)) {
+      return {};
+    }
+    socklen_t len = sizeof(addrs[i]);
+    getsockname(socks[i].fd(), (struct sockaddr*)&addrs[i], &len);
+  }
+  return socks;
+}
+
+/// Measures the time between sending a datagram to one of many sockets and its callback being called
+int bench_wakeup_latency()
+{
+  std::vector<sockaddr_in>           addrs;
+  std::vector<srsran::unique_socket> socks = make_udp_sockets(bench_nof_sockets, addrs);
+  TESTASSERT(socks.size() == bench_nof_sockets);
+  srsran::unique_socket tx_sock;
+  bool                  ret = tx_sock.open_socket(srsran::net_utils::addr_family::ipv4,
+                                 srsran::net_utils::socket_type::datagram,
+                                 srsran::net_utils::protocol_type::UDP);
+  TESTASSERT(ret);
+
+  std::atomic<uint32_t>  nof_rx = {0};
+  srsran::socket_manager sockhandler;
+  for (auto& s : socks) {
+    ret = sockhandler.add_socket_handler(s.fd(), [&nof_rx](int fd) {
+      uint8_t buf[64];
+      if (recv(fd, buf, sizeof(buf), 0) > 0) {
+        nof_rx.fetch_add(1, std::memory_order_release);
+      }
+      return true;
+    });
+    TESTASSERT(ret);
+  }
+
+  const uint32_t nof_pings = 1000;
+  uint8_t        buf[16]   = {};
+  double         total_us  = 0;
+  for (uint32_t i = 0; i < nof_pings; ++i) {
+    const sockaddr_in& dest = addrs[(i * 7919) % addrs.size()];
+    auto               tic  = std::chrono::steady_clock::now();
+    ssize_t            n_sent = sendto(tx_sock.fd(), buf, sizeof(buf), 0, (const struct sockaddr*)&dest, sizeof(dest));
+    TESTASSERT(n_sent > 0);
+    while (nof_rx.load(std::memory_order_acquire) != i + 1) {
+      std::this_thread::yield();
+      if (std::chrono::steady_clock::now() - tic > std::chrono::seconds(3)) {
+        return SRSRAN_ERROR;
+      }
+    }
+    total_us += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - tic).count();
+  }
+
+  printf("Wakeup latency with %d sockets: %.1f us\n", bench_nof_sockets, total_us / nof_pings);
+  return SRSRAN_SUCCESS;
+}
+
+/// Measures the packet rate of the SDU handlers when traffic is spread over many sockets
+int bench_rx_throughput()
+{
+  std::vector<sockaddr_in>           addrs;
+  std::vector<srsran::unique_socket> socks = make_udp_sockets(bench_nof_sockets, addrs);
+  TESTASSERT(socks.size() == bench_nof_sockets);
+  srsran::unique_socket tx_sock;
+  bool                  ret = tx_sock.open_socket(srsran::net_utils::addr_family::ipv4,
+                                 srsran::net_utils::socket_type::datagram,
+                                 srsran::net_utils::protocol_type::UDP);
+  TESTASSERT(ret);
+
+  auto&                  logger = srslog::fetch_basic_logger("S1AP", false);
+  std::atomic<uint32_t>  nof_rx = {0};
+  rx_thread_tester       rx_tester;
+  srsran::socket_manager sockhandler;
+  for (auto& s : socks) {
+    auto pdu_handler = [&nof_rx](srsran::unique_byte_buffer_t pdu, const sockaddr_in& from) {
+      nof_rx.fetch_add(1, std::memory_order_relaxed);
+    };
+    ret = sockhandler.add_socket_handler(s.fd(), srsran::make_sdu_handler(logger, rx_tester.task_queue, pdu_handler));
+    TESTASSERT(ret);
+  }
+
+  // Keep a bounded number of packets in flight, so that neither the socket buffers nor the buffer pool overflow
+  const uint32_t window  = 512;
+  uint8_t        buf[64] = {};
+  auto           tic     = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < bench_nof_pkts; ++i) {
+    while (i - nof_rx.load(std::memory_order_relaxed) >= window) {
+      std::this_thread::yield();
+      if (std::chrono::steady_clock::now() - tic > std::chrono::seconds(10)) {
+        return SRSRAN_ERROR;
+      }
+    }
+    const sockaddr_in& dest   = addrs[i % addrs.size()];
+    ssize_t            n_sent = sendto(tx_sock.fd(), buf, sizeof(buf), 0, (const struct sockaddr*)&dest, sizeof(dest));
+    TESTASSERT(n_sent > 0);
+  }
+  while (nof_rx.load(std::memory_order_relaxed) != bench_nof_pkts) {
+    std::this_thread::yield();
+    if (std::chrono::steady_clock::now() - tic > std::chrono::seconds(10)) {
+      return SRSRAN_ERROR;
+    }
+  }
+  double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - tic).count();
+
+  printf("Rx rate with %d sockets: %.1f kpackets/s\n", bench_nof_sockets, bench_nof_pkts / secs / 1e3);
+  return SRSRAN_SUCCESS;
+}
+
+void usage(char* prog)
+{
+  printf("Usage: %s [sn]\n", prog);
+  printf("\t-s number of sockets registered in the benchmark [Default %d]\n", bench_nof_sockets);
+  printf("\t-n number of packets of the throughput benchmark [Default %d]\n", bench_nof_pkts);
+}
+
+void parse_args(int argc, char** argv)
 {
+  int opt;
+  while ((opt = getopt(argc, argv, "sn")) != -1) {
+    switch (opt) {
+      case 's':
+        bench_nof_sockets = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'n':
+        bench_nof_pkts = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
   auto& logger = srslog::fetch_basic_logger("S1AP", false);
   logger.set_level(srslog::basic_levels::debug);
   logger.set_hex_dump_max_size(128);
@@ -147,5 +294,10 @@ int main()
   TESTASSERT(test_socket_handler() == 0);
   TESTASSERT(test_sctp_bind_error() == 0);
 
+  logger.set_level(srslog::basic_levels::warning);
+  srslog::fetch_basic_logger("COMN").set_level(srslog::basic_levels::warning);
+  TESTASSERT(bench_wakeup_latency() == SRSRAN_SUCCESS);
+  TESTASSERT(bench_rx_throughput() == SRSRAN_SUCCESS);
+
   return 0;
 }
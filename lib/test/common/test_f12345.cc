@@ -19,6 +19,7 @@
  *
  */
 
+#include <chrono>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -162,6 +163,87 @@ int test_set_2()
   return SRSRAN_SUCCESS;
 }
 
+/*
+ * The batched F1-F5 must match the individual functions. The first vector is test set 2, the others reuse its key
+ * with modified RAND and SQN.
+ */
+int test_set_2_batch()
+{
+  const uint32_t nof_vectors = 4;
+
+  uint8_t k[]   = {0x46, 0x5b, 0x5c, 0xe8, 0xb1, 0x99, 0xb4, 0x9f, 0xaa, 0x5f, 0x0a, 0x2e, 0xe2, 0x38, 0xa6, 0xbc};
+  uint8_t amf[] = {0xb9, 0xb9};
+  uint8_t opc[] = {0xcd, 0x63, 0xcb, 0x71, 0x95, 0x4a, 0x9f, 0x4e, 0x48, 0xa5, 0x99, 0x4e, 0x37, 0xa0, 0x2b, 0xaf};
+  uint8_t rand[nof_vectors * 16] = {
+      0x23, 0x55, 0x3c, 0xbe, 0x96, 0x37, 0xa8, 0x9d, 0x21, 0x8a, 0xe6, 0x4d, 0xae, 0x47, 0xbf, 0x35};
+  uint8_t sqn[nof_vectors * 6] = {0xff, 0x9b, 0xb4, 0xd0, 0xb6, 0x07};
+  for (uint32_t n = 1; n < nof_vectors; n++) {
+    for (uint32_t i = 0; i < 16; i++) {
+      rand[16 * n + i] = rand[i] ^ (uint8_t)(n * 37 + i);
+    }
+    for (uint32_t i = 0; i < 6; i++) {
+      sqn[6 * n + i] = sqn[i] + (uint8_t)n;
+    }
+  }
+
+  uint8_t mac_o[nof_vectors * 8];
+  uint8_t res_o[nof_vectors * 8];
+  uint8_t ck_o[nof_vectors * 16];
+  uint8_t ik_o[nof_vectors * 16];
+  uint8_t ak_o[nof_vectors * 6];
+  TESTASSERT(srsran::security_milenage_f12345(k, opc, nof_vectors, rand, sqn, amf, mac_o, res_o, ck_o, ik_o, ak_o) ==
+             LIBLTE_SUCCESS);
+
+  uint8_t mac_a[] = {0x4a, 0x9f, 0xfa, 0xc3, 0x54, 0xdf, 0xaf, 0xb3};
+  uint8_t res[]   = {0xa5, 0x42, 0x11, 0xd5, 0xe3, 0xba, 0x50, 0xbf};
+  uint8_t ck[]    = {0xb4, 0x0b, 0xa9, 0xa3, 0xc5, 0x8b, 0x2a, 0x05, 0xbb, 0xf0, 0xd9, 0x87, 0xb2, 0x1b, 0xf8, 0xcb};
+  uint8_t ik[]    = {0xf7, 0x69, 0xbc, 0xd7, 0x51, 0x04, 0x46, 0x04, 0x12, 0x76, 0x72, 0x71, 0x1c, 0x6d, 0x34, 0x41};
+  uint8_t ak[]    = {0xaa, 0x68, 0x9c, 0x64, 0x83, 0x70};
+  TESTASSERT(arrcmp(mac_o, mac_a, sizeof(mac_a)) == 0);
+  TESTASSERT(arrcmp(res_o, res, sizeof(res)) == 0);
+  TESTASSERT(arrcmp(ck_o, ck, sizeof(ck)) == 0);
+  TESTASSERT(arrcmp(ik_o, ik, sizeof(ik)) == 0);
+  TESTASSERT(arrcmp(ak_o, ak, sizeof(ak)) == 0);
+
+  for (uint32_t n = 1; n < nof_vectors; n++) {
+    uint8_t mac_n[8];
+    uint8_t res_n[8];
+    uint8_t ck_n[16];
+    uint8_t ik_n[16];
+    uint8_t ak_n[6];
+    TESTASSERT(liblte_security_milenage_f1(k, opc, &rand[16 * n], &sqn[6 * n], amf, mac_n) == LIBLTE_SUCCESS);
+    TESTASSERT(liblte_security_milenage_f2345(k, opc, &rand[16 * n], res_n, ck_n, ik_n, ak_n) == LIBLTE_SUCCESS);
+    TESTASSERT(arrcmp(&mac_o[8 * n], mac_n, sizeof(mac_n)) == 0);
+    TESTASSERT(arrcmp(&res_o[8 * n], res_n, sizeof(res_n)) == 0);
+    TESTASSERT(arrcmp(&ck_o[16 * n], ck_n, sizeof(ck_n)) == 0);
+    TESTASSERT(arrcmp(&ik_o[16 * n], ik_n, sizeof(ik_n)) == 0);
+    TESTASSERT(arrcmp(&ak_o[6 * n], ak_n, sizeof(ak_n)) == 0);
+  }
+
+  // Authentication vector throughput, one vector at a time versus batches of nof_vectors
+  const uint32_t nof_reps = 20000;
+  auto           t0       = std::chrono::steady_clock::now();
+  for (uint32_t r = 0; r < nof_reps; r++) {
+    for (uint32_t n = 0; n < nof_vectors; n++) {
+      liblte_security_milenage_f1(k, opc, &rand[16 * n], &sqn[6 * n], amf, &mac_o[8 * n]);
+      liblte_security_milenage_f2345(k, opc, &rand[16 * n], &res_o[8 * n], &ck_o[16 * n], &ik_o[16 * n], &ak_o[6 * n]);
+    }
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  for (uint32_t r = 0; r < nof_reps; r++) {
+    srsran::security_milenage_f12345(k, opc, nof_vectors, rand, sqn, amf, mac_o, res_o, ck_o, ik_o, ak_o);
+  }
+  auto t2 = std::chrono::steady_clock::now();
+
+  double single_us  = std::chrono::duration<double, std::micro>(t1 - t0).count();
+  double batched_us = std::chrono::duration<double, std::micro>(t2 - t1).count();
+  printf("Milenage vectors/s: single %.0f, batched %.0f\n",
+         nof_reps * nof_vectors / single_us * 1e6,
+         nof_reps * nof_vectors / batched_us * 1e6);
+
+  return SRSRAN_SUCCESS;
+}
+
 /*
   Own test sets
 */
@@ -223,6 +305,7 @@ int main(int argc, char* argv[])
   srslog::init();
 
   TESTASSERT(test_set_2() == SRSRAN_SUCCESS);
+  TESTASSERT(test_set_2_batch() == SRSRAN_SUCCESS);
   TESTASSERT(test_set_xor_own_set_1() == SRSRAN_SUCCESS);
   return SRSRAN_SUCCESS;
 }
@@ -0,0 +1,192 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/byte_buffer_slice.h"
+#include "srsran/common/test_common.h"
+#include "srsran/mac/pdu_queue.h"
+#include <chrono>
+#include <getopt.h>
+#include <vector>
+
+static uint32_t bench_nof_pdus = 100000;
+static uint32_t bench_tb_size  = 9000;
+static uint32_t bench_sdu_size = 1500;
+
+// Number of TBs decoded before RLC releases the SDUs, it must leave enough free PDU buffers for slices to be kept
+static const uint32_t batch_size       = 16;
+// Leaves room in the parser for the padding subheader
+static const uint32_t max_subh         = 20;
+static const uint32_t max_sdus_per_pdu = max_subh - 2;
+
+/// Packs a DL-SCH MAC PDU of tb_size bytes with up to max_sdus_per_pdu SDUs of sdu_size bytes, the SDU i filled with
+/// the value i
+static std::vector<uint8_t> make_tb(uint32_t tb_size, uint32_t sdu_size, uint32_t& nof_sdus)
+{
+  srsran::sch_pdu       pdu(max_subh, srslog::fetch_basic_logger("MAC"));
+  srsran::byte_buffer_t buffer;
+  std::vector<uint8_t>  payload(sdu_size);
+
+  pdu.init_tx(&buffer, tb_size);
+  nof_sdus = 0;
+  while (nof_sdus < max_sdus_per_pdu and pdu.new_subh()) {
+    std::fill(payload.begin(), payload.end(), (uint8_t)nof_sdus);
+    if (pdu.get()->set_sdu(3, sdu_size, payload.data()) < 0) {
+      pdu.del_subh();
+      break;
+    }
+    nof_sdus++;
+  }
+  uint8_t* ptr = pdu.write_packet();
+  return std::vector<uint8_t>(ptr, ptr + tb_size);
+}
+
+/// Demultiplexes a TB received in a PDU queue buffer, handing its SDUs to a sink as RLC would receive them
+template <typename Sink>
+static uint64_t demux_tb(srsran::sch_pdu& mac_msg, uint8_t* tb, uint32_t tb_size, Sink&& sink)
+{
+  uint64_t nof_bytes = 0;
+  mac_msg.init_rx(tb_size);
+  mac_msg.parse_packet(tb);
+  while (mac_msg.next()) {
+    if (mac_msg.get()->is_sdu()) {
+      sink(mac_msg.get()->get_sdu_ptr(), mac_msg.get()->get_payload_size());
+      nof_bytes += mac_msg.get()->get_payload_size();
+    }
+  }
+  return nof_bytes;
+}
+
+/// Runs the benchmark and returns the demultiplexed SDU throughput in Gbps. When zero_copy is false, every SDU is
+/// copied to a new byte buffer, as RLC used to do with the PDUs it keeps. Otherwise, the SDUs are kept as slices
+/// of the PDU queue buffer
+static double run_benchmark(bool zero_copy, const std::vector<uint8_t>& tb_template, uint32_t nof_sdus)
+{
+  srsran::pdu_queue                         pdus(srslog::fetch_basic_logger("MAC"));
+  srsran::sch_pdu                           mac_msg(max_subh, srslog::fetch_basic_logger("MAC"));
+  std::vector<uint8_t*>                     tbs(batch_size);
+  std::vector<srsran::unique_byte_buffer_t> copied;
+  std::vector<srsran::byte_buffer_slice>    slices;
+  copied.reserve(batch_size * nof_sdus);
+  slices.reserve(batch_size * nof_sdus);
+
+  uint64_t                 nof_bytes = 0;
+  std::chrono::nanoseconds elapsed{0};
+  for (uint32_t n = 0; n < bench_nof_pdus; n += batch_size) {
+    // The decoder writes the TBs, which is not accounted
+    for (auto& tb : tbs) {
+      tb = pdus.request(tb_template.size());
+      TESTASSERT(tb != nullptr);
+      memcpy(tb, tb_template.data(), tb_template.size());
+    }
+
+    // The first batch warms up the buffer pools and is not accounted
+    bool accounted = n > 0;
+    auto tic       = std::chrono::steady_clock::now();
+    for (uint8_t* tb : tbs) {
+      uint64_t bytes = 0;
+      if (zero_copy) {
+        bytes = demux_tb(mac_msg, tb, tb_template.size(), [&](uint8_t* ptr, uint32_t len) {
+          slices.push_back(pdus.make_slice(tb, ptr, len));
+        });
+      } else {
+        bytes = demux_tb(mac_msg, tb, tb_template.size(), [&](uint8_t* ptr, uint32_t len) {
+          srsran::unique_byte_buffer_t buf = srsran::make_byte_buffer();
+          memcpy(buf->msg, ptr, len);
+          buf->N_bytes = len;
+          copied.push_back(std::move(buf));
+        });
+      }
+      pdus.deallocate(tb);
+      nof_bytes += accounted ? bytes : 0;
+    }
+    auto toc = std::chrono::steady_clock::now();
+
+    // The SDUs must still be intact after the MAC has released the TBs
+    TESTASSERT(slices.size() + copied.size() == batch_size * nof_sdus);
+    for (uint32_t i = 0; i < slices.size(); i++) {
+      TESTASSERT(slices[i].is_shared() and slices[i].data()[0] == i % nof_sdus);
+    }
+    for (uint32_t i = 0; i < copied.size(); i++) {
+      TESTASSERT(copied[i]->msg[0] == i % nof_sdus);
+    }
+
+    // RLC releases the SDUs once reassembled
+    auto tic_release = std::chrono::steady_clock::now();
+    slices.clear();
+    copied.clear();
+    if (accounted) {
+      elapsed += (toc - tic) + (std::chrono::steady_clock::now() - tic_release);
+    }
+  }
+
+  return nof_bytes * 8 / std::chrono::duration<double>(elapsed).count() / 1e9;
+}
+
+void usage(char* prog)
+{
+  printf("Usage: %s [nts]\n", prog);
+  printf("\t-n number of TBs demultiplexed in the benchmark [Default %d]\n", bench_nof_pdus);
+  printf("\t-t TB size in bytes [Default %d]\n", bench_tb_size);
+  printf("\t-s SDU size in bytes [Default %d]\n", bench_sdu_size);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "nts")) != -1) {
+    switch (opt) {
+      case 'n':
+        bench_nof_pdus = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 't':
+        bench_tb_size = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 's':
+        bench_sdu_size = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srslog::fetch_basic_logger("MAC", false).set_level(srslog::basic_levels::error);
+  srslog::init();
+
+  uint32_t             nof_sdus    = 0;
+  std::vector<uint8_t> tb_template = make_tb(bench_tb_size, bench_sdu_size, nof_sdus);
+  TESTASSERT(nof_sdus > 0);
+
+  double copy_gbps  = run_benchmark(false, tb_template, nof_sdus);
+  double slice_gbps = run_benchmark(true, tb_template, nof_sdus);
+  printf("MAC demux benchmark with %d B TBs carrying %d SDUs: %.2f Gbps copying SDUs, %.2f Gbps with TB slices\n",
+         bench_tb_size,
+         nof_sdus,
+         copy_gbps,
+         slice_gbps);
+
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,232 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/phy/phch/csi.h"
+#include "srsran/phy/phch/uci_cfg_nr.h"
+#include "srsran/phy/utils/random.h"
+#include <getopt.h>
+#include <math.h>
+#include <stdlib.h>
+
+static uint32_t        nof_repetitions = 100;
+static srsran_random_t random_gen      = NULL;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [R]\n", prog);
+  printf("\t-R Number of random pack/unpack repetitions [Default %d]\n", nof_repetitions);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "R:")) != -1) {
+    switch (opt) {
+      case 'R':
+        nof_repetitions = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static int test_set_subbands_size(uint32_t nof_prb, bool large_subbands, int expected_size)
+{
+  srsran_csi_hl_report_cfg_t cfg = {};
+  int                        ret = srsran_csi_set_subbands(&cfg, 0, nof_prb, large_subbands);
+  if (expected_size == 0) {
+    TESTASSERT(ret < SRSRAN_SUCCESS);
+    return SRSRAN_SUCCESS;
+  }
+  TESTASSERT(ret == SRSRAN_SUCCESS);
+  TESTASSERT(cfg.subband_size == expected_size);
+  return SRSRAN_SUCCESS;
+}
+
+static int test_set_subbands()
+{
+  // TS 38.214 Table 5.2.1.4-2, on the edges of each BWP size range
+  TESTASSERT(srsran_csi_set_subbands(NULL, 0, 52, false) < SRSRAN_SUCCESS);
+  TESTASSERT(test_set_subbands_size(23, false, 0) == SRSRAN_SUCCESS);
+  TESTASSERT(test_set_subbands_size(24, false, 4) == SRSRAN_SUCCESS);
+  TESTASSERT(test_set_subbands_size(24, true, 8) == SRSRAN_SUCCESS);
+  TESTASSERT(test_set_subbands_size(72, false, 4) == SRSRAN_SUCCESS);
+  TESTASSERT(test_set_subbands_size(72, true, 8) == SRSRAN_SUCCESS);
+  TESTASSERT(test_set_subbands_size(73, false, 8) == SRSRAN_SUCCESS);
+  TESTASSERT(test_set_subbands_size(73, true, 16) == SRSRAN_SUCCESS);
+  TESTASSERT(test_set_subbands_size(144, false, 8) == SRSRAN_SUCCESS);
+  TESTASSERT(test_set_subbands_size(144, true, 16) == SRSRAN_SUCCESS);
+  TESTASSERT(test_set_subbands_size(145, false, 16) == SRSRAN_SUCCESS);
+  TESTASSERT(test_set_subbands_size(145, true, 32) == SRSRAN_SUCCESS);
+  TESTASSERT(test_set_subbands_size(275, false, 16) == SRSRAN_SUCCESS);
+  TESTASSERT(test_set_subbands_size(275, true, 32) == SRSRAN_SUCCESS);
+  TESTASSERT(test_set_subbands_size(276, false, 0) == SRSRAN_SUCCESS);
+
+  // The first and last subbands are partial when the BWP is not aligned to the subband size
+  srsran_csi_hl_report_cfg_t cfg = {};
+  TESTASSERT(srsran_csi_set_subbands(&cfg, 0, 52, false) == SRSRAN_SUCCESS);
+  TESTASSERT(cfg.nof_subbands == 13);
+  TESTASSERT(srsran_csi_set_subbands(&cfg, 2, 52, false) == SRSRAN_SUCCESS);
+  TESTASSERT(cfg.nof_subbands == 14);
+  TESTASSERT(srsran_csi_set_subbands(&cfg, 4, 52, false) == SRSRAN_SUCCESS);
+  TESTASSERT(cfg.nof_subbands == 13);
+  TESTASSERT(srsran_csi_set_subbands(&cfg, 15, 275, false) == SRSRAN_SUCCESS);
+  TESTASSERT(cfg.nof_subbands == SRSRAN_CSI_MAX_NOF_SUBBANDS);
+
+  // Every BWP is covered by its subbands, without exceeding the maximum number of subbands
+  for (uint32_t nof_prb = 24; nof_prb <= 275; nof_prb++) {
+    for (uint32_t bwp_start = 0; bwp_start < 32; bwp_start++) {
+      for (uint32_t large = 0; large < 2; large++) {
+        TESTASSERT(srsran_csi_set_subbands(&cfg, bwp_start, nof_prb, large) == SRSRAN_SUCCESS);
+        uint32_t span = bwp_start % cfg.subband_size + nof_prb;
+        TESTASSERT(cfg.nof_subbands <= SRSRAN_CSI_MAX_NOF_SUBBANDS);
+        TESTASSERT(cfg.nof_subbands * cfg.subband_size >= span);
+        TESTASSERT((cfg.nof_subbands - 1) * cfg.subband_size < span);
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+static int test_subband_pack_unpack(uint32_t nof_subbands, uint32_t K_csi_rs)
+{
+  srsran_csi_report_cfg_t report = {};
+  report.cfg.type                = SRSRAN_CSI_REPORT_TYPE_PERIODIC;
+  report.cfg.quantity            = SRSRAN_CSI_REPORT_QUANTITY_CRI_RI_PMI_CQI;
+  report.cfg.freq_cfg            = SRSRAN_CSI_REPORT_FREQ_SUBBAND;
+  report.cfg.nof_subbands        = nof_subbands;
+  report.nof_ports               = 1;
+  report.K_csi_rs                = K_csi_rs;
+
+  // Wideband CQI, 2 bits per subband and the CRI bits
+  uint32_t nof_bits_cri = K_csi_rs > 1 ? (uint32_t)ceilf(log2f((float)K_csi_rs)) : 0;
+  int      nof_bits     = srsran_csi_part1_nof_bits(&report, 1);
+  TESTASSERT(nof_bits == 4 + 2 * nof_subbands + nof_bits_cri);
+
+  for (uint32_t r = 0; r < nof_repetitions; r++) {
+    srsran_csi_report_value_t tx_value  = {};
+    tx_value.subband_cri_ri_pmi_cqi.cqi = srsran_random_uniform_int_dist(random_gen, 0, 15);
+    for (uint32_t i = 0; i < nof_subbands; i++) {
+      tx_value.subband_cri_ri_pmi_cqi.subband_diff_cqi[i] = srsran_random_uniform_int_dist(random_gen, 0, 3);
+    }
+    tx_value.cri = nof_bits_cri > 0 ? srsran_random_uniform_int_dist(random_gen, 0, K_csi_rs - 1) : 0;
+
+    uint8_t o_csi1[SRSRAN_UCI_NR_MAX_CSI1_BITS] = {};
+    TESTASSERT(srsran_csi_part1_pack(&report, &tx_value, 1, o_csi1, SRSRAN_UCI_NR_MAX_CSI1_BITS) == nof_bits);
+
+    srsran_csi_report_value_t rx_value = {};
+    TESTASSERT(srsran_csi_part1_unpack(&report, 1, o_csi1, SRSRAN_UCI_NR_MAX_CSI1_BITS, &rx_value) == nof_bits);
+    TESTASSERT(rx_value.subband_cri_ri_pmi_cqi.cqi == tx_value.subband_cri_ri_pmi_cqi.cqi);
+    TESTASSERT(rx_value.cri == tx_value.cri);
+    for (uint32_t i = 0; i < nof_subbands; i++) {
+      TESTASSERT(rx_value.subband_cri_ri_pmi_cqi.subband_diff_cqi[i] ==
+                 tx_value.subband_cri_ri_pmi_cqi.subband_diff_cqi[i]);
+      TESTASSERT(srsran_csi_subband_cqi(&rx_value, i) == srsran_csi_subband_cqi(&tx_value, i));
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+static int test_subband_quantify()
+{
+  srsran_csi_report_cfg_t reports[SRSRAN_CSI_SLOT_MAX_NOF_REPORT] = {};
+  reports[0].cfg.type                                            = SRSRAN_CSI_REPORT_TYPE_PERIODIC;
+  reports[0].cfg.quantity                                        = SRSRAN_CSI_REPORT_QUANTITY_CRI_RI_PMI_CQI;
+  reports[0].cfg.freq_cfg                                        = SRSRAN_CSI_REPORT_FREQ_SUBBAND;
+  reports[0].cfg.nof_subbands                                    = 5;
+  reports[0].nof_ports                                           = 1;
+
+  // The last subband is not measured
+  srsran_csi_channel_measurements_t measurements[SRSRAN_CSI_MAX_NOF_RESOURCES] = {};
+  measurements[0].wideband_snr_db                                            = 10.0f;
+  measurements[0].nof_subbands                                               = 4;
+  measurements[0].subband_snr_db[0]                                          = 10.0f;
+  measurements[0].subband_snr_db[1]                                          = 30.0f;
+  measurements[0].subband_snr_db[2]                                          = -10.0f;
+  measurements[0].subband_snr_db[3]                                          = 10.0f;
+
+  srsran_csi_report_value_t values[SRSRAN_CSI_SLOT_MAX_NOF_REPORT] = {};
+  TESTASSERT(srsran_csi_reports_quantify(reports, measurements, values) == 1);
+
+  // Every subband CQI is reported relative to the wideband CQI, the subband without measurement takes the wideband CQI
+  uint32_t wideband_cqi = values[0].subband_cri_ri_pmi_cqi.cqi;
+  TESTASSERT(wideband_cqi == values[0].wideband_cri_ri_pmi_cqi.cqi);
+  for (uint32_t i = 0; i < reports[0].cfg.nof_subbands; i++) {
+    uint32_t subband_cqi = srsran_csi_subband_cqi(&values[0], i);
+    TESTASSERT(subband_cqi + 1 >= wideband_cqi && subband_cqi <= wideband_cqi + 2);
+  }
+  TESTASSERT(values[0].subband_cri_ri_pmi_cqi.subband_diff_cqi[4] == 0);
+  TESTASSERT(srsran_csi_subband_cqi(&values[0], 4) == wideband_cqi);
+
+  // TS 38.214 Table 5.2.2.1-1: Mapping subband differential CQI value to offset level
+  values[0].subband_cri_ri_pmi_cqi.cqi = 7;
+  for (uint32_t i = 0; i < 4; i++) {
+    values[0].subband_cri_ri_pmi_cqi.subband_diff_cqi[i] = i;
+  }
+  TESTASSERT(srsran_csi_subband_cqi(&values[0], 0) == 7);
+  TESTASSERT(srsran_csi_subband_cqi(&values[0], 1) == 8);
+  TESTASSERT(srsran_csi_subband_cqi(&values[0], 2) == 9);
+  TESTASSERT(srsran_csi_subband_cqi(&values[0], 3) == 6);
+
+  // The CQI of a subband is kept within the CQI range
+  values[0].subband_cri_ri_pmi_cqi.cqi                 = 15;
+  values[0].subband_cri_ri_pmi_cqi.subband_diff_cqi[0] = 2;
+  TESTASSERT(srsran_csi_subband_cqi(&values[0], 0) == 15);
+  values[0].subband_cri_ri_pmi_cqi.cqi                 = 0;
+  values[0].subband_cri_ri_pmi_cqi.subband_diff_cqi[0] = 3;
+  TESTASSERT(srsran_csi_subband_cqi(&values[0], 0) == 0);
+  TESTASSERT(srsran_csi_subband_cqi(&values[0], SRSRAN_CSI_MAX_NOF_SUBBANDS) == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+  random_gen = srsran_random_init(1234);
+
+  int ret = SRSRAN_ERROR;
+  if (test_set_subbands() < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+  for (uint32_t nof_subbands = 1; nof_subbands <= SRSRAN_CSI_MAX_NOF_SUBBANDS; nof_subbands++) {
+    for (uint32_t K_csi_rs = 0; K_csi_rs <= 4; K_csi_rs++) {
+      if (test_subband_pack_unpack(nof_subbands, K_csi_rs) < SRSRAN_SUCCESS) {
+        printf("Failed pack/unpack of %d subbands and K_csi_rs=%d\n", nof_subbands, K_csi_rs);
+        goto clean_exit;
+      }
+    }
+  }
+  if (test_subband_quantify() < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_random_free(random_gen);
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+  return ret;
+}
@@ -0,0 +1,279 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/gnb/gnb_dl.h"
+#include "srsran/phy/phch/ra_nr.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+#include <getopt.h>
+#include <pthread.h>
+#include <string.h>
+
+static srsran_carrier_nr_t carrier   = SRSRAN_DEFAULT_CARRIER_NR;
+static uint32_t            nof_pdsch = 4;
+static uint32_t            nof_slots = 10;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [PNnv] \n", prog);
+  printf("\t-P Number of BWP (Carrier) PRB [Default %d]\n", carrier.nof_prb);
+  printf("\t-N Number of PDSCH per slot, each one encoded by its own thread [Default %d]\n", nof_pdsch);
+  printf("\t-n Number of slots to simulate [Default %d]\n", nof_slots);
+  printf("\t-v [set srsran_verbose to debug, default none]\n");
+}
+
+static int parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "PNnv")) != -1) {
+    switch (opt) {
+      case 'P':
+        carrier.nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'N':
+        nof_pdsch = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'n':
+        nof_slots = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        return SRSRAN_ERROR;
+    }
+  }
+
+  if (nof_pdsch == 0 || nof_pdsch > SRSRAN_GNB_DL_MAX_PDSCH_ENCODERS || nof_pdsch > carrier.nof_prb) {
+    ERROR("Invalid number of PDSCH (%d)", nof_pdsch);
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+typedef struct {
+  srsran_gnb_dl_t*     gnb_dl;
+  uint32_t             encoder_idx;
+  srsran_slot_cfg_t*   slot;
+  srsran_sch_cfg_nr_t* pdsch_cfg;
+  uint8_t**            data;
+  int                  ret;
+} encoder_task_t;
+
+static void* encoder_task(void* arg)
+{
+  encoder_task_t* task = (encoder_task_t*)arg;
+
+  task->ret = srsran_gnb_dl_pdsch_put_encoder(task->gnb_dl, task->encoder_idx, task->slot, task->pdsch_cfg, task->data);
+  return NULL;
+}
+
+static int init_gnb_dl(srsran_gnb_dl_t* gnb_dl, cf_t* buffer[SRSRAN_MAX_PORTS], uint32_t nof_pdsch_encoders)
+{
+  srsran_gnb_dl_args_t gnb_dl_args   = {};
+  gnb_dl_args.nof_tx_antennas        = 1;
+  gnb_dl_args.pdsch.sch.disable_simd = false;
+  gnb_dl_args.pdcch.disable_simd     = false;
+  gnb_dl_args.nof_max_prb            = carrier.nof_prb;
+  gnb_dl_args.srate_hz               = SRSRAN_SUBC_SPACING_NR(carrier.scs) * srsran_min_symbol_sz_rb(carrier.nof_prb);
+  gnb_dl_args.nof_pdsch_encoders     = nof_pdsch_encoders;
+
+  if (srsran_gnb_dl_init(gnb_dl, buffer, &gnb_dl_args) < SRSRAN_SUCCESS) {
+    ERROR("Error gNb DL");
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_gnb_dl_set_carrier(gnb_dl, &carrier) < SRSRAN_SUCCESS) {
+    ERROR("Error setting SCH NR carrier");
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  int                    ret                                                      = SRSRAN_ERROR;
+  srsran_gnb_dl_t        gnb_dl_serial                                            = {};
+  srsran_gnb_dl_t        gnb_dl_concurrent                                        = {};
+  srsran_random_t        rand_gen                                                 = srsran_random_init(1234);
+  srsran_slot_cfg_t      slot                                                     = {};
+  srsran_sch_cfg_nr_t    pdsch_cfg[SRSRAN_GNB_DL_MAX_PDSCH_ENCODERS]              = {};
+  srsran_softbuffer_tx_t softbuffer_serial[SRSRAN_GNB_DL_MAX_PDSCH_ENCODERS]      = {};
+  srsran_softbuffer_tx_t softbuffer_concurrent[SRSRAN_GNB_DL_MAX_PDSCH_ENCODERS]  = {};
+  uint8_t*               data_tx[SRSRAN_GNB_DL_MAX_PDSCH_ENCODERS][SRSRAN_MAX_TB] = {};
+  cf_t*                  buffer_serial[SRSRAN_MAX_PORTS]                          = {};
+  cf_t*                  buffer_concurrent[SRSRAN_MAX_PORTS]                      = {};
+
+  if (parse_args(argc, argv) < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+
+  uint32_t sf_len      = SRSRAN_SF_LEN_PRB_NR(carrier.nof_prb);
+  buffer_serial[0]     = srsran_vec_cf_malloc(sf_len);
+  buffer_concurrent[0] = srsran_vec_cf_malloc(sf_len);
+  if (buffer_serial[0] == NULL || buffer_concurrent[0] == NULL) {
+    ERROR("Error malloc");
+    goto clean_exit;
+  }
+
+  // The serial gNb DL puts every PDSCH with its only encoder, the concurrent one gives each PDSCH its own encoder
+  if (init_gnb_dl(&gnb_dl_serial, buffer_serial, 1) < SRSRAN_SUCCESS ||
+      init_gnb_dl(&gnb_dl_concurrent, buffer_concurrent, nof_pdsch) < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+
+  // Split the carrier in non-overlapping grants, one for each PDSCH
+  uint32_t grant_nof_prb = carrier.nof_prb / nof_pdsch;
+  for (uint32_t i = 0; i < nof_pdsch; i++) {
+    data_tx[i][0] = srsran_vec_u8_malloc(SRSRAN_SLOT_MAX_NOF_BITS_NR);
+    if (data_tx[i][0] == NULL) {
+      ERROR("Error malloc");
+      goto clean_exit;
+    }
+
+    if (srsran_softbuffer_tx_init_guru(
+            &softbuffer_serial[i], SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB) < SRSRAN_SUCCESS) {
+      ERROR("Error init soft-buffer");
+      goto clean_exit;
+    }
+
+    if (srsran_softbuffer_tx_init_guru(&softbuffer_concurrent[i],
+                                       SRSRAN_SCH_NR_MAX_NOF_CB_LDPC,
+                                       SRSRAN_LDPC_MAX_LEN_ENCODED_CB) < SRSRAN_SUCCESS) {
+      ERROR("Error init soft-buffer");
+      goto clean_exit;
+    }
+
+    srsran_sch_cfg_nr_t* cfg                    = &pdsch_cfg[i];
+    cfg->dmrs.type                              = srsran_dmrs_sch_type_1;
+    cfg->dmrs.typeA_pos                         = srsran_dmrs_sch_typeA_pos_2;
+    cfg->dmrs.additional_pos                    = srsran_dmrs_sch_add_pos_2;
+    cfg->grant.S                                = 1;
+    cfg->grant.L                                = 13;
+    cfg->grant.nof_layers                       = 1;
+    cfg->grant.dci_format                       = srsran_dci_format_nr_1_0;
+    cfg->grant.nof_dmrs_cdm_groups_without_data = 1;
+    cfg->grant.beta_dmrs                        = srsran_convert_dB_to_amplitude(3);
+    cfg->grant.rnti_type                        = srsran_rnti_type_c;
+    cfg->grant.rnti                             = 0x4601 + i;
+    cfg->grant.nof_prb                          = grant_nof_prb;
+    for (uint32_t n = 0; n < SRSRAN_MAX_PRB_NR; n++) {
+      cfg->grant.prb_idx[n] = (n >= i * grant_nof_prb && n < (i + 1) * grant_nof_prb);
+    }
+  }
+
+  for (slot.idx = 0; slot.idx < nof_slots; slot.idx++) {
+    if (srsran_gnb_dl_base_zero(&gnb_dl_serial) < SRSRAN_SUCCESS ||
+        srsran_gnb_dl_base_zero(&gnb_dl_concurrent) < SRSRAN_SUCCESS) {
+      ERROR("Error zeroing RE grid");
+      goto clean_exit;
+    }
+
+    // Select a different MCS and data for each PDSCH
+    for (uint32_t i = 0; i < nof_pdsch; i++) {
+      uint32_t mcs = srsran_random_uniform_int_dist(rand_gen, 0, 27);
+      if (srsran_ra_nr_fill_tb(&pdsch_cfg[i], &pdsch_cfg[i].grant, mcs, &pdsch_cfg[i].grant.tb[0]) < SRSRAN_SUCCESS) {
+        ERROR("Error filing tb");
+        goto clean_exit;
+      }
+      srsran_random_byte_vector(rand_gen, data_tx[i][0], pdsch_cfg[i].grant.tb[0].tbs / 8);
+      srsran_softbuffer_tx_reset(&softbuffer_serial[i]);
+      srsran_softbuffer_tx_reset(&softbuffer_concurrent[i]);
+    }
+
+    // Put all the PDSCH one after the other
+    for (uint32_t i = 0; i < nof_pdsch; i++) {
+      pdsch_cfg[i].grant.tb[0].softbuffer.tx = &softbuffer_serial[i];
+      if (srsran_gnb_dl_pdsch_put(&gnb_dl_serial, &slot, &pdsch_cfg[i], data_tx[i]) < SRSRAN_SUCCESS) {
+        ERROR("Error putting PDSCH");
+        goto clean_exit;
+      }
+    }
+
+    // Put all the PDSCH at the same time, each one from its own thread
+    srsran_sch_cfg_nr_t concurrent_cfg[SRSRAN_GNB_DL_MAX_PDSCH_ENCODERS] = {};
+    encoder_task_t      tasks[SRSRAN_GNB_DL_MAX_PDSCH_ENCODERS]          = {};
+    pthread_t           threads[SRSRAN_GNB_DL_MAX_PDSCH_ENCODERS]        = {};
+    for (uint32_t i = 0; i < nof_pdsch; i++) {
+      concurrent_cfg[i]                           = pdsch_cfg[i];
+      concurrent_cfg[i].grant.tb[0].softbuffer.tx = &softbuffer_concurrent[i];
+      tasks[i].gnb_dl                             = &gnb_dl_concurrent;
+      tasks[i].encoder_idx                        = i;
+      tasks[i].slot                               = &slot;
+      tasks[i].pdsch_cfg                          = &concurrent_cfg[i];
+      tasks[i].data                               = data_tx[i];
+      tasks[i].ret                                = SRSRAN_ERROR;
+      if (pthread_create(&threads[i], NULL, encoder_task, &tasks[i]) != 0) {
+        ERROR("Error creating thread");
+        goto clean_exit;
+      }
+    }
+    for (uint32_t i = 0; i < nof_pdsch; i++) {
+      pthread_join(threads[i], NULL);
+      if (tasks[i].ret < SRSRAN_SUCCESS) {
+        ERROR("Error putting PDSCH with encoder %d", i);
+        goto clean_exit;
+      }
+    }
+
+    // Both resource grids and signals must be identical
+    uint32_t nof_re = carrier.nof_prb * SRSRAN_NRE * SRSRAN_NSYMB_PER_SLOT_NR;
+    if (memcmp(gnb_dl_serial.sf_symbols[0], gnb_dl_concurrent.sf_symbols[0], sizeof(cf_t) * nof_re) != 0) {
+      ERROR("Resource grids differ in slot %d", slot.idx);
+      goto clean_exit;
+    }
+
+    srsran_gnb_dl_gen_signal(&gnb_dl_serial);
+    srsran_gnb_dl_gen_signal(&gnb_dl_concurrent);
+    if (memcmp(buffer_serial[0], buffer_concurrent[0], sizeof(cf_t) * sf_len) != 0) {
+      ERROR("Signals differ in slot %d", slot.idx);
+      goto clean_exit;
+    }
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_random_free(rand_gen);
+  srsran_gnb_dl_free(&gnb_dl_serial);
+  srsran_gnb_dl_free(&gnb_dl_concurrent);
+  for (uint32_t i = 0; i < SRSRAN_GNB_DL_MAX_PDSCH_ENCODERS; i++) {
+    if (data_tx[i][0] != NULL) {
+      free(data_tx[i][0]);
+    }
+    srsran_softbuffer_tx_free(&softbuffer_serial[i]);
+    srsran_softbuffer_tx_free(&softbuffer_concurrent[i]);
+  }
+  if (buffer_serial[0] != NULL) {
+    free(buffer_serial[0]);
+  }
+  if (buffer_concurrent[0] != NULL) {
+    free(buffer_concurrent[0]);
+  }
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+
+  return ret;
+}
@@ -40,10 +40,11 @@ static srsran_dmrs_sch_type_t    dmrs_type                        = srsran_dmrs_
 static srsran_dmrs_sch_add_pos_t dmrs_add_pos                     = srsran_dmrs_sch_add_pos_2;
 static bool                      interleaved_pdcch                = false;
 static uint32_t                  nof_dmrs_cdm_groups_without_data = 1;
+static uint32_t                  nof_blind_searches               = 0; // Idle UE blind searches every slot
 
 static void usage(char* prog)
 {
-  printf("Usage: %s [rRPdpmnTILDCv] \n", prog);
+  printf("Usage: %s [rRPdpmnTILDCbv] \n", prog);
   printf("\t-P Number of BWP (Carrier) PRB [Default %d]\n", carrier.nof_prb);
   printf("\t-p Number of grant PRB, set to 0 for steering [Default %d]\n", n_prb);
   printf("\t-n Number of slots to simulate [Default %d]\n", nof_slots);
@@ -57,13 +58,14 @@ static void usage(char* prog)
   printf("\t-L Provide number of layers [Default %d]\n", carrier.max_mimo_layers);
   printf("\t-D Delay signal an integer number of samples [Default %d samples]\n", delay_n);
   printf("\t-C Frequency shift (CFO) signal in Hz [Default %+.0f Hz]\n", cfo_hz);
+  printf("\t-b Number of PDCCH blind searches for RNTIs without PDCCH every slot [Default %d]\n", nof_blind_searches);
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
 
 static int parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "rRIPdpmnTLDCv")) != -1) {
+  while ((opt = getopt(argc, argv, "rRIPdpmnTLDCbv")) != -1) {
     switch (opt) {
       case 'P':
         carrier.nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -138,6 +140,9 @@ static int parse_args(int argc, char** argv)
       case 'C':
         cfo_hz = strtof(argv[optind], NULL);
         break;
+      case 'b':
+        nof_blind_searches = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -218,6 +223,39 @@ static int work_ue_dl(srsran_ue_dl_nr_t* ue_dl, srsran_slot_cfg_t* slot, srsran_
   return SRSRAN_SUCCESS;
 }
 
+/**
+ * @brief Blind searches the current slot for RNTIs that have no PDCCH, like the idle UEs sharing a carrier
+ */
+static int work_ue_dl_blind_search(srsran_ue_dl_nr_t* ue_dl,
+                                   srsran_slot_cfg_t* slot,
+                                   uint64_t*          nof_searches,
+                                   uint64_t*          nof_candidates,
+                                   uint64_t*          time_us)
+{
+  struct timeval t[3] = {};
+
+  for (uint32_t i = 0; i < nof_blind_searches; i++) {
+    uint16_t           rnti      = (uint16_t)(pdsch_cfg.grant.rnti + 1 + i);
+    srsran_dci_dl_nr_t dci_dl_rx = {};
+
+    gettimeofday(&t[1], NULL);
+    int nof_found_dci = srsran_ue_dl_nr_find_dl_dci(ue_dl, slot, rnti, srsran_rnti_type_c, &dci_dl_rx, 1);
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+
+    if (nof_found_dci != 0) {
+      ERROR("Error blind search for RNTI 0x%x returned %d", rnti, nof_found_dci);
+      return SRSRAN_ERROR;
+    }
+
+    *time_us += (size_t)(t[0].tv_sec * 1e6 + t[0].tv_usec);
+    *nof_searches += 1;
+    *nof_candidates += ue_dl->pdcch_info_count;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   int                   ret             = SRSRAN_ERROR;
@@ -230,6 +268,9 @@ int main(int argc, char** argv)
   uint64_t              pdsch_encode_us = 0;
   uint64_t              pdsch_decode_us = 0;
   uint64_t              nof_bits        = 0;
+  uint64_t              nof_searches    = 0;
+  uint64_t              nof_blind_dec   = 0;
+  uint64_t              search_us       = 0;
 
   uint8_t* data_tx[SRSRAN_MAX_TB]        = {};
   uint8_t* data_rx[SRSRAN_MAX_CODEWORDS] = {};
@@ -465,6 +506,11 @@ int main(int argc, char** argv)
         get_time_interval(t);
         pdsch_decode_us += (size_t)(t[0].tv_sec * 1e6 + t[0].tv_usec);
 
+        if (work_ue_dl_blind_search(&ue_dl, &slot, &nof_searches, &nof_blind_dec, &search_us) < SRSRAN_SUCCESS) {
+          ERROR("Error running UE DL blind search");
+          goto clean_exit;
+        }
+
         if (pdsch_res.evm[0] > 0.02f) {
           ERROR("Error PDSCH EVM is too high %f", pdsch_res.evm[0]);
           goto clean_exit;
@@ -513,6 +559,12 @@ int main(int argc, char** argv)
   printf("            UE:   %5.1f      %5.1f\n",
          (double)nof_bits / (double)slot_count / 1000.0f,
          (double)nof_bits / pdsch_decode_us);
+  if (nof_searches > 0 && search_us > 0) {
+    printf("PDCCH blind search: %.1f searches/s, %.1f kdecodes/s (%.1f candidates per search)\n",
+           (double)nof_searches * 1e6 / (double)search_us,
+           (double)nof_blind_dec * 1e3 / (double)search_us,
+           (double)nof_blind_dec / (double)nof_searches);
+  }
 
   ret = SRSRAN_SUCCESS;
 
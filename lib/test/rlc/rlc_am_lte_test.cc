@@ -4082,6 +4082,188 @@ bool full_window_check_wraparound_test()
 
   return SRSRAN_SUCCESS;
 }
+// Writes an SDU of the given size, filled with its index, to the RLC entity
+void write_indexed_sdu(rlc_am& rlc, uint32_t idx, uint32_t nof_bytes)
+{
+  unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+  sdu->N_bytes             = nof_bytes;
+  std::fill(sdu->msg, sdu->msg + sdu->N_bytes, idx);
+  sdu->md.pdcp_sn = idx;
+  rlc.write_sdu(std::move(sdu));
+}
+
+// Checks the SDUs received by the tester, each one of the given size and filled with its index
+int check_indexed_sdus(const rlc_am_tester& tester, const std::vector<uint32_t>& sdu_sizes)
+{
+  TESTASSERT_EQ(sdu_sizes.size(), tester.sdus.size());
+  for (uint32_t i = 0; i < tester.sdus.size(); i++) {
+    TESTASSERT_EQ(sdu_sizes[i], tester.sdus[i]->N_bytes);
+    for (uint32_t k = 0; k < tester.sdus[i]->N_bytes; k++) {
+      TESTASSERT_EQ(i, tester.sdus[i]->msg[k]);
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+// PDUs received as slices of shared TBs are kept in the RX window without copies until the SDUs are reassembled, and
+// the TBs return to the pool after delivery
+int tb_slice_reordering_test()
+{
+  rlc_am_tester tester(true, nullptr);
+  timer_handler timers(8);
+  rlc_tb_pool   tb_pool(4);
+
+  rlc_am rlc1(srsran_rat_t::lte, srslog::fetch_basic_logger("RLC_AM_1"), 1, &tester, &tester, &timers);
+  rlc_am rlc2(srsran_rat_t::lte, srslog::fetch_basic_logger("RLC_AM_2"), 1, &tester, &tester, &timers);
+
+  if (not rlc1.configure(rlc_config_t::default_rlc_am_config())) {
+    return -1;
+  }
+
+  if (not rlc2.configure(rlc_config_t::default_rlc_am_config())) {
+    return -1;
+  }
+
+  // SDU 0 is segmented in SN=0..2, SDUs 1 and 2 are sent in SN=3 and SN=4
+  write_indexed_sdu(rlc1, 0, 30);
+  write_indexed_sdu(rlc1, 1, 5);
+  write_indexed_sdu(rlc1, 2, 5);
+  byte_buffer_t pdus[5];
+  for (uint32_t i = 0; i < 3; i++) {
+    pdus[i].N_bytes = rlc1.read_pdu(pdus[i].msg, 12); // 2 byte header + 10 byte payload
+    TESTASSERT_EQ(12, pdus[i].N_bytes);
+  }
+  for (uint32_t i = 3; i < 5; i++) {
+    pdus[i].N_bytes = rlc1.read_pdu(pdus[i].msg, 7); // 2 byte header + 5 byte payload
+    TESTASSERT_EQ(7, pdus[i].N_bytes);
+  }
+
+  // SN=3 and SN=4 are received in the same TB, before the rest
+  std::vector<byte_buffer_slice> tb = tb_pool.write_tb({&pdus[3], &pdus[4]});
+  rlc2.write_pdu_slice(tb[0]);
+  rlc2.write_pdu_slice(tb[1]);
+  TESTASSERT_EQ(4, tb_pool.use_count(tb[0]));
+  tb.clear();
+  TESTASSERT_EQ(tb_pool.size() - 1, tb_pool.nof_available());
+
+  // SN=2 and SN=1 are received in reverse order in their own TBs
+  for (uint32_t i = 2; i > 0; i--) {
+    rlc2.write_pdu_slice(tb_pool.write_tb(pdus[i]));
+  }
+  TESTASSERT_EQ(tb_pool.size() - 3, tb_pool.nof_available());
+  TESTASSERT_EQ(0, tester.sdus.size());
+
+  // SN=0 completes the window, all the SDUs are delivered and the TBs are released
+  {
+    byte_buffer_slice slice = tb_pool.write_tb(pdus[0]);
+    rlc2.write_pdu_slice(slice);
+    TESTASSERT_EQ(1, tb_pool.use_count(slice));
+  }
+  TESTASSERT_EQ(tb_pool.size(), tb_pool.nof_available());
+  TESTASSERT(check_indexed_sdus(tester, {30, 5, 5}) == SRSRAN_SUCCESS);
+
+  return SRSRAN_SUCCESS;
+}
+
+// Retransmitted PDU segments received as slices of shared TBs are kept without copies until the PDU is complete
+int tb_slice_resegment_test()
+{
+  rlc_am_tester tester(true, nullptr);
+  timer_handler timers(8);
+  rlc_tb_pool   tb_pool(4);
+
+  rlc_am rlc1(srsran_rat_t::lte, srslog::fetch_basic_logger("RLC_AM_1"), 1, &tester, &tester, &timers);
+  rlc_am rlc2(srsran_rat_t::lte, srslog::fetch_basic_logger("RLC_AM_2"), 1, &tester, &tester, &timers);
+
+  if (not rlc1.configure(rlc_config_t::default_rlc_am_config())) {
+    return -1;
+  }
+
+  if (not rlc2.configure(rlc_config_t::default_rlc_am_config())) {
+    return -1;
+  }
+
+  // SN=0 is lost
+  write_indexed_sdu(rlc1, 0, 30);
+  byte_buffer_t pdu;
+  pdu.N_bytes = rlc1.read_pdu(pdu.msg, 32); // 2 byte header + 30 byte payload
+  TESTASSERT_EQ(32, pdu.N_bytes);
+
+  // Step timers until poll Retx timeout expires
+  for (int cnt = 0; cnt < 5; cnt++) {
+    timers.step_all();
+  }
+  TESTASSERT_EQ(32, rlc1.get_buffer_state());
+
+  // Retransmit SN=0 in 3 segments
+  byte_buffer_t segments[3];
+  for (byte_buffer_t& segment : segments) {
+    segment.N_bytes = rlc1.read_pdu(segment.msg, 14); // 4 byte header + 10 byte payload
+    TESTASSERT_EQ(14, segment.N_bytes);
+  }
+  TESTASSERT_EQ(0, rlc1.get_buffer_state());
+
+  // The last two segments are received in reverse order in their own TBs
+  for (uint32_t i = 2; i > 0; i--) {
+    byte_buffer_slice slice = tb_pool.write_tb(segments[i]);
+    rlc2.write_pdu_slice(slice);
+    TESTASSERT_EQ(2, tb_pool.use_count(slice));
+  }
+  TESTASSERT_EQ(tb_pool.size() - 2, tb_pool.nof_available());
+  TESTASSERT_EQ(0, tester.sdus.size());
+
+  // The first segment completes the PDU, the SDU is delivered and the TBs are released
+  rlc2.write_pdu_slice(tb_pool.write_tb(segments[0]));
+  TESTASSERT_EQ(tb_pool.size(), tb_pool.nof_available());
+  TESTASSERT(check_indexed_sdus(tester, {30}) == SRSRAN_SUCCESS);
+
+  return SRSRAN_SUCCESS;
+}
+
+// The TBs held by the RX window and the segment lists are released on reestablishment
+int tb_slice_reestablish_test()
+{
+  rlc_am_tester tester(true, nullptr);
+  timer_handler timers(8);
+  rlc_tb_pool   tb_pool(4);
+
+  rlc_am rlc1(srsran_rat_t::lte, srslog::fetch_basic_logger("RLC_AM_1"), 1, &tester, &tester, &timers);
+  rlc_am rlc2(srsran_rat_t::lte, srslog::fetch_basic_logger("RLC_AM_2"), 1, &tester, &tester, &timers);
+
+  if (not rlc1.configure(rlc_config_t::default_rlc_am_config())) {
+    return -1;
+  }
+
+  if (not rlc2.configure(rlc_config_t::default_rlc_am_config())) {
+    return -1;
+  }
+
+  // SN=0 and SN=2 are lost
+  byte_buffer_t pdus[3];
+  for (uint32_t i = 0; i < 3; i++) {
+    write_indexed_sdu(rlc1, i, 5);
+    pdus[i].N_bytes = rlc1.read_pdu(pdus[i].msg, 7); // 2 byte header + 5 byte payload
+    TESTASSERT_EQ(7, pdus[i].N_bytes);
+  }
+  rlc2.write_pdu_slice(tb_pool.write_tb(pdus[1]));
+
+  // Step timers until poll Retx timeout expires, and receive the first segment of the retransmitted SN=2
+  for (int cnt = 0; cnt < 5; cnt++) {
+    timers.step_all();
+  }
+  byte_buffer_t segment;
+  segment.N_bytes = rlc1.read_pdu(segment.msg, 6); // 4 byte header + 2 byte payload
+  TESTASSERT_EQ(6, segment.N_bytes);
+  rlc2.write_pdu_slice(tb_pool.write_tb(segment));
+  TESTASSERT_EQ(tb_pool.size() - 2, tb_pool.nof_available());
+  TESTASSERT_EQ(0, tester.sdus.size());
+
+  rlc2.reestablish();
+  TESTASSERT_EQ(tb_pool.size(), tb_pool.nof_available());
+
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   // Setup the log message spy to intercept error and warning log entries from RLC
@@ -4301,5 +4483,20 @@ int main(int argc, char** argv)
     printf("full_window_check_wraparound_test failed\n");
     exit(-1);
   };
+
+  if (tb_slice_reordering_test()) {
+    printf("tb_slice_reordering_test failed\n");
+    exit(-1);
+  };
+
+  if (tb_slice_resegment_test()) {
+    printf("tb_slice_resegment_test failed\n");
+    exit(-1);
+  };
+
+  if (tb_slice_reestablish_test()) {
+    printf("tb_slice_reestablish_test failed\n");
+    exit(-1);
+  };
   return SRSRAN_SUCCESS;
 }
@@ -3365,6 +3365,134 @@ int full_rx_window_t_reassembly_expiry(rlc_am_nr_sn_size_t sn_size)
   return SRSRAN_SUCCESS;
 }
 
+// Writes an SDU of the given size, filled with its index, to the RLC entity
+void write_indexed_sdu(rlc_am& rlc, uint32_t idx, uint32_t nof_bytes)
+{
+  unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+  sdu->N_bytes             = nof_bytes;
+  std::fill(sdu->msg, sdu->msg + sdu->N_bytes, idx);
+  sdu->md.pdcp_sn = idx;
+  rlc.write_sdu(std::move(sdu));
+}
+
+// Reads PDUs of at most max_pdu_size bytes until the RLC entity has no more data
+std::vector<byte_buffer_t> read_all_pdus(rlc_am& rlc, uint32_t max_pdu_size)
+{
+  std::vector<byte_buffer_t> pdus;
+  while (rlc.get_buffer_state() > 0) {
+    pdus.emplace_back();
+    pdus.back().N_bytes = rlc.read_pdu(pdus.back().msg, max_pdu_size);
+  }
+  return pdus;
+}
+
+/*
+ * SDU segments received as slices of shared TBs are kept without copies until the SDU is complete, and the TBs return
+ * to the pool once the SDU is reassembled
+ */
+int tb_slice_segmentation_test(rlc_am_nr_sn_size_t sn_size)
+{
+  rlc_am_tester       tester(true, nullptr);
+  timer_handler       timers(8);
+  rlc_tb_pool         tb_pool(8);
+  test_delimit_logger delimiter("TB slice segmentation ({} bit SN)", to_number(sn_size));
+  rlc_am              rlc1(srsran_rat_t::nr, srslog::fetch_basic_logger("RLC_AM_1"), 1, &tester, &tester, &timers);
+  rlc_am              rlc2(srsran_rat_t::nr, srslog::fetch_basic_logger("RLC_AM_2"), 1, &tester, &tester, &timers);
+
+  if (not rlc1.configure(rlc_config_t::default_rlc_am_nr_config(to_number(sn_size)))) {
+    return -1;
+  }
+
+  if (not rlc2.configure(rlc_config_t::default_rlc_am_nr_config(to_number(sn_size)))) {
+    return -1;
+  }
+
+  // SN=0 is a full SDU, SN=1 is segmented
+  write_indexed_sdu(rlc1, 0, 5);
+  std::vector<byte_buffer_t> sdu0 = read_all_pdus(rlc1, 100);
+  TESTASSERT_EQ(1, sdu0.size());
+  write_indexed_sdu(rlc1, 1, 30);
+  std::vector<byte_buffer_t> sdu1_segments = read_all_pdus(rlc1, 15);
+  TESTASSERT(sdu1_segments.size() >= 3);
+
+  // The last segments of SN=1 are received in reverse order, the last two in the same TB
+  uint32_t                       nof_segments = sdu1_segments.size();
+  std::vector<byte_buffer_slice> tb =
+      tb_pool.write_tb({&sdu1_segments[nof_segments - 1], &sdu1_segments[nof_segments - 2]});
+  for (byte_buffer_slice& slice : tb) {
+    rlc2.write_pdu_slice(slice);
+  }
+  TESTASSERT_EQ(4, tb_pool.use_count(tb[0]));
+  tb.clear();
+  for (uint32_t i = nof_segments - 3; i > 0; i--) {
+    rlc2.write_pdu_slice(tb_pool.write_tb(sdu1_segments[i]));
+  }
+  TESTASSERT_EQ(tb_pool.size() - (nof_segments - 2), tb_pool.nof_available());
+
+  // The first segment completes SN=1, which is reassembled and delivered before SN=0
+  rlc2.write_pdu_slice(tb_pool.write_tb(sdu1_segments[0]));
+  TESTASSERT_EQ(tb_pool.size(), tb_pool.nof_available());
+  TESTASSERT_EQ(1, tester.sdus.size());
+
+  // The full SDU is copied when it is received
+  {
+    byte_buffer_slice slice = tb_pool.write_tb(sdu0[0]);
+    rlc2.write_pdu_slice(slice);
+    TESTASSERT_EQ(1, tb_pool.use_count(slice));
+  }
+  TESTASSERT_EQ(tb_pool.size(), tb_pool.nof_available());
+
+  // SDUs are delivered as they are completed, SN=1 first
+  TESTASSERT_EQ(2, tester.sdus.size());
+  for (uint32_t i = 0; i < tester.sdus.size(); i++) {
+    uint32_t sdu_idx = 1 - i;
+    TESTASSERT_EQ(sdu_idx == 0 ? 5 : 30, tester.sdus[i]->N_bytes);
+    for (uint32_t k = 0; k < tester.sdus[i]->N_bytes; k++) {
+      TESTASSERT_EQ(sdu_idx, tester.sdus[i]->msg[k]);
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/*
+ * The TBs held by the segments of incomplete SDUs are released on reestablishment
+ */
+int tb_slice_reestablish_test(rlc_am_nr_sn_size_t sn_size)
+{
+  rlc_am_tester       tester(true, nullptr);
+  timer_handler       timers(8);
+  rlc_tb_pool         tb_pool(8);
+  test_delimit_logger delimiter("TB slice reestablish ({} bit SN)", to_number(sn_size));
+  rlc_am              rlc1(srsran_rat_t::nr, srslog::fetch_basic_logger("RLC_AM_1"), 1, &tester, &tester, &timers);
+  rlc_am              rlc2(srsran_rat_t::nr, srslog::fetch_basic_logger("RLC_AM_2"), 1, &tester, &tester, &timers);
+
+  if (not rlc1.configure(rlc_config_t::default_rlc_am_nr_config(to_number(sn_size)))) {
+    return -1;
+  }
+
+  if (not rlc2.configure(rlc_config_t::default_rlc_am_nr_config(to_number(sn_size)))) {
+    return -1;
+  }
+
+  // The first segment of SN=0 is lost, the rest of SN=0 and the segments of SN=1 are received in their own TBs
+  write_indexed_sdu(rlc1, 0, 30);
+  write_indexed_sdu(rlc1, 1, 30);
+  std::vector<byte_buffer_t> pdus = read_all_pdus(rlc1, 15);
+  TESTASSERT(pdus.size() >= 4);
+  for (uint32_t i = 1; i < pdus.size() - 1; i++) {
+    rlc2.write_pdu_slice(tb_pool.write_tb(pdus[i]));
+    TESTASSERT_EQ(tb_pool.size() - i, tb_pool.nof_available());
+  }
+  TESTASSERT_EQ(0, tester.sdus.size());
+
+  rlc2.reestablish();
+  TESTASSERT_EQ(tb_pool.size(), tb_pool.nof_available());
+  TESTASSERT_EQ(0, tester.sdus.size());
+
+  return SRSRAN_SUCCESS;
+}
+
 int main()
 {
   // Setup the log message spy to intercept error and warning log entries from RLC
@@ -3417,6 +3545,8 @@ int main()
     TESTASSERT(rx_nack_range_with_so_ending_with_full_sdu_test(sn_size) == SRSRAN_SUCCESS);
     TESTASSERT(out_of_order_status(sn_size) == SRSRAN_SUCCESS);
     TESTASSERT(lost_status_and_advanced_rx_window(sn_size) == SRSRAN_SUCCESS);
+    TESTASSERT(tb_slice_segmentation_test(sn_size) == SRSRAN_SUCCESS);
+    TESTASSERT(tb_slice_reestablish_test(sn_size) == SRSRAN_SUCCESS);
   }
   TESTASSERT(full_rx_window_t_reassembly_expiry(rlc_am_nr_sn_size_t::size12bits) == SRSRAN_SUCCESS);
   return SRSRAN_SUCCESS;
@@ -23,10 +23,12 @@
 #define SRSRAN_RLC_TEST_COMMON_H
 
 #include "srsran/common/byte_buffer.h"
+#include "srsran/common/byte_buffer_slice.h"
 #include "srsran/common/rlc_pcap.h"
 #include "srsran/interfaces/ue_pdcp_interfaces.h"
 #include "srsran/interfaces/ue_rrc_interfaces.h"
 #include "srsran/rlc/rlc_metrics.h"
+#include <array>
 #include <vector>
 
 namespace srsran {
@@ -126,6 +128,74 @@ public:
   std::map<uint32_t, uint32_t> notified_counts; // Map of PDCP SNs to number of notifications
 };
 
+/**
+ * Pool of received transport blocks that RLC gets as slices, like the MAC PDU queue does. A TB returns to the pool once
+ * every slice taken from it has been destroyed, and its contents are then overwritten, so that a bearer reading a
+ * released TB delivers corrupted SDUs.
+ */
+class rlc_tb_pool
+{
+public:
+  static const uint32_t MAX_TB_LEN = 2048;
+
+  explicit rlc_tb_pool(uint32_t nof_tbs) : tbs(nof_tbs) {}
+
+  /// Copies the given PDUs one after the other in a free TB, and returns a slice of each of them
+  std::vector<byte_buffer_slice> write_tb(const std::vector<const byte_buffer_t*>& pdus)
+  {
+    std::vector<byte_buffer_slice> slices;
+    for (tb_t& tb : tbs) {
+      if (tb.use_count() > 0) {
+        continue;
+      }
+      uint32_t offset = 0;
+      for (const byte_buffer_t* pdu : pdus) {
+        srsran_assert(offset + pdu->N_bytes <= MAX_TB_LEN, "TB too small for the PDUs");
+        memcpy(&tb.data[offset], pdu->msg, pdu->N_bytes);
+        slices.emplace_back(&tb, &tb.data[offset], pdu->N_bytes);
+        offset += pdu->N_bytes;
+      }
+      return slices;
+    }
+    srsran_terminate("No free TB in the pool");
+  }
+
+  /// Copies a PDU in a free TB and returns a slice of it
+  byte_buffer_slice write_tb(const byte_buffer_t& pdu) { return std::move(write_tb({&pdu}).front()); }
+
+  /// Number of slices that refer to the TB holding the given slice
+  uint32_t use_count(const byte_buffer_slice& slice) const
+  {
+    for (const tb_t& tb : tbs) {
+      if (slice.data() >= tb.data.begin() and slice.data() < tb.data.end()) {
+        return tb.use_count();
+      }
+    }
+    return 0;
+  }
+
+  uint32_t nof_available() const
+  {
+    return std::count_if(tbs.begin(), tbs.end(), [](const tb_t& tb) { return tb.use_count() == 0; });
+  }
+
+  uint32_t size() const { return tbs.size(); }
+
+private:
+  class tb_t final : public shared_buffer_ref
+  {
+  public:
+    ~tb_t() override = default;
+
+    std::array<uint8_t, MAX_TB_LEN> data = {};
+
+  private:
+    void release_buffer() override { data.fill(0xff); }
+  };
+
+  std::vector<tb_t> tbs;
+};
+
 bool rx_is_tx(const rlc_bearer_metrics_t& rlc1_metrics, const rlc_bearer_metrics_t& rlc2_metrics)
 {
   if (rlc1_metrics.num_tx_pdu_bytes != rlc2_metrics.num_rx_pdu_bytes) {
@@ -25,6 +25,7 @@
 #include <string.h>
 
 #include "../phy_common.h"
+#include "srsenb/hdr/phy/lte/ul_decoder_pool.h"
 #include "srsran/srslog/srslog.h"
 
 #define LOG_EXECTIME
@@ -37,7 +38,7 @@ class cc_worker
 public:
   cc_worker(srslog::basic_logger& logger);
   ~cc_worker();
-  void init(phy_common* phy, uint32_t cc_idx);
+  void init(phy_common* phy, uint32_t cc_idx, srsran::task_thread_pool* ul_task_pool = nullptr);
   void reset();
 
   cf_t* get_buffer_rx(uint32_t antenna_idx);
@@ -55,7 +56,12 @@ public:
   int  read_pucch_d(cf_t* pusch_d);
   void start_plot();
 
-  void work_ul(const srsran_ul_sf_cfg_t& ul_sf, stack_interface_phy_lte::ul_sched_t& ul_grants);
+  /* UL processing of a subframe. The jobs are prepared before any slot is received, each slot is demodulated once it
+   * is received and the PUSCH of the first slot can be demodulated while the second one is being received */
+  void work_ul_prepare(const srsran_ul_sf_cfg_t& ul_sf, stack_interface_phy_lte::ul_sched_t& ul_grants);
+  void work_ul_fft_slot(uint32_t slot_idx);
+  void work_ul_demod_first_slot();
+  void work_ul_decode();
   void work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
                stack_interface_phy_lte::dl_sched_t& dl_grants,
                stack_interface_phy_lte::ul_sched_t& ul_grants,
@@ -69,14 +75,28 @@ private:
 
   int  encode_pdsch(stack_interface_phy_lte::dl_sched_grant_t* grants, uint32_t nof_grants);
   int  encode_pmch(stack_interface_phy_lte::dl_sched_grant_t* grant, srsran_mbsfn_cfg_t* mbsfn_cfg);
-  bool decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_grant,
-                         srsran_ul_cfg_t&                           ul_cfg,
-                         srsran_pusch_res_t&                        pusch_res);
-  void decode_pusch(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_pusch);
   int  encode_phich(stack_interface_phy_lte::ul_sched_ack_t* acks, uint32_t nof_acks);
   int  encode_pdcch_dl(stack_interface_phy_lte::dl_sched_grant_t* grants, uint32_t nof_grants);
   int  encode_pdcch_ul(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_grants);
-  int  decode_pucch();
+
+  // UL decoding job of a single UE, jobs are decoded concurrently and reported in order
+  struct ul_job_t {
+    uint16_t                                   rnti         = SRSRAN_INVALID_RNTI;
+    stack_interface_phy_lte::ul_sched_grant_t* pusch_grant  = nullptr; ///< Null for PUCCH jobs
+    bool                                       uci_required = false;
+    srsran_ul_cfg_t                            ul_cfg       = {};
+    srsran_pusch_res_t                         pusch_res    = {};
+    srsran_pucch_res_t                         pucch_res    = {};
+    srsran_chest_ul_res_t                      chest_res    = {};
+    void*                                      pusch_llr    = nullptr; ///< Set if the first slot is demodulated early
+    int                                        ret          = SRSRAN_SUCCESS;
+  };
+
+  bool prepare_pusch(stack_interface_phy_lte::ul_sched_grant_t& ul_grant, ul_job_t& job);
+  bool prepare_pucch(uint16_t rnti, ul_job_t& job);
+  void decode_ul_job(srsran_enb_ul_t& decoder, ul_job_t& job);
+  bool report_pusch(ul_job_t& job);
+  void report_pucch(ul_job_t& job);
 
   /* Common objects */
   srslog::basic_logger& logger;
@@ -90,6 +110,14 @@ private:
   srsran_enb_dl_t enb_dl = {};
   srsran_enb_ul_t enb_ul = {};
 
+  ul_decoder_pool       ul_decoders;
+  std::vector<ul_job_t> ul_jobs;
+  uint32_t              nof_pusch_jobs = 0;
+
+  // Soft bits of the PUSCH demodulated slot by slot, shared by the grants of the subframe as they do not overlap
+  int16_t* ul_llr     = nullptr;
+  uint32_t ul_llr_len = 0;
+
   srsran_dl_sf_cfg_t dl_sf = {};
   srsran_ul_sf_cfg_t ul_sf = {};
 
@@ -22,11 +22,13 @@
 #ifndef SRSENB_PHCH_WORKER_H
 #define SRSENB_PHCH_WORKER_H
 
+#include <condition_variable>
 #include <mutex>
 #include <string.h>
 
 #include "../phy_common.h"
 #include "cc_worker.h"
+#include "srsran/common/time_prof.h"
 #include "srsran/srslog/srslog.h"
 #include "srsran/srsran.h"
 
@@ -36,13 +38,25 @@ namespace lte {
 class sf_worker : public srsran::thread_pool::worker
 {
 public:
-  sf_worker(srslog::basic_logger& logger) : logger(logger) {}
+  sf_worker(srslog::basic_logger& logger);
   ~sf_worker();
-  void init(phy_common* phy);
+  void init(phy_common* phy, srsran::task_thread_pool* ul_task_pool = nullptr);
 
   cf_t* get_buffer_rx(uint32_t cc_idx, uint32_t antenna_idx);
   void  set_context(const srsran::phy_common_interface::worker_context_t& w_ctx);
 
+  /**
+   * @brief Sets the number of UL slots available in the reception buffers for the current subframe.
+   *
+   * set_context() assumes the whole subframe was received. The reception thread can lower the count before starting
+   * the worker and raise it as it receives each slot, so the OFDM demodulation of a slot starts as soon as it is
+   * available rather than waiting for the entire subframe. The PUSCH of the first slot is then demodulated while the
+   * second one is being received.
+   *
+   * @param nof_slots Number of slots, from the beginning of the subframe, available in the reception buffers
+   */
+  void set_nof_rx_slots(uint32_t nof_slots);
+
   int      add_rnti(uint16_t rnti, uint32_t cc_idx);
   void     rem_rnti(uint16_t rnti);
   uint32_t get_nof_rnti();
@@ -60,6 +74,10 @@ public:
 
 private:
   void work_imp() final;
+  bool wait_rx_slot(uint32_t slot_idx);
+
+  /// Number of subframes between per-stage timing reports
+  constexpr static uint32_t STAGE_TPROF_PERIOD = 1000;
 
   /* Common objects */
   srslog::basic_logger& logger;
@@ -73,6 +91,20 @@ private:
   srsran::phy_common_interface::worker_context_t context = {};
 
   srsran_softbuffer_tx_t temp_mbsfn_softbuffer = {};
+
+  // UL slot reception synchronization with the reception thread
+  std::mutex              rx_slot_mutex;
+  std::condition_variable rx_slot_cvar;
+  uint32_t                nof_rx_slots      = SRSRAN_NOF_SLOTS_PER_SF;
+  bool                    ul_slot_streaming = false; ///< Set if the reception thread hands the subframe slot by slot
+
+  // Per-stage timing, only active when compiled with ENABLE_TIMEPROF
+  srsran::tprof<srsran::avg_time_stats> ul_fft_slot0_tprof;
+  srsran::tprof<srsran::avg_time_stats> ul_fft_slot1_tprof;
+  srsran::tprof<srsran::avg_time_stats> ul_demod_slot0_tprof;
+  srsran::tprof<srsran::avg_time_stats> ul_decode_tprof;
+  srsran::tprof<srsran::avg_time_stats> ul_latency_tprof;
+  srsran::tprof<srsran::avg_time_stats> dl_tprof;
 };
 
 } // namespace lte
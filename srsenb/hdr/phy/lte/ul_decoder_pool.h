@@ -0,0 +1,90 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSENB_LTE_UL_DECODER_POOL_H
+#define SRSENB_LTE_UL_DECODER_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "srsran/common/thread_pool.h"
+#include "srsran/srsran.h"
+
+namespace srsenb {
+namespace lte {
+
+/**
+ * @brief Spreads the PUSCH/PUCCH decoding of the UEs scheduled in a subframe across several decoders.
+ *
+ * All decoders read the resource grid demodulated by the carrier srsran_enb_ul_t object, which is also used as first
+ * decoder by the calling thread. The additional decoders run as tasks of a shared task_thread_pool. Jobs are handed out
+ * through an atomic index, so a decoder that finishes early takes the next pending job instead of idling.
+ */
+class ul_decoder_pool
+{
+public:
+  /// Decodes the job with the given index using the given decoder
+  using job_t = std::function<void(srsran_enb_ul_t& decoder, uint32_t job_idx)>;
+
+  ul_decoder_pool() = default;
+  ~ul_decoder_pool();
+  ul_decoder_pool(const ul_decoder_pool&) = delete;
+  ul_decoder_pool& operator=(const ul_decoder_pool&) = delete;
+
+  /**
+   * @brief Creates the additional decoders, sharing the resource grid of the given object
+   * @param enb_ul Carrier object, it must be initialised and its cell set
+   * @param dmrs_cfg PUSCH DMRS configuration for pre-generating the reference signals
+   * @param task_pool Pool running the additional decoders, if it is null all jobs run in the calling thread
+   * @return SRSRAN_SUCCESS if all the decoders are initialised, SRSRAN_ERROR otherwise
+   */
+  int init(srsran_enb_ul_t*                   enb_ul,
+           srsran_refsignal_dmrs_pusch_cfg_t* dmrs_cfg,
+           srsran::task_thread_pool*          task_pool);
+
+  /**
+   * @brief Runs the jobs [0, nof_jobs) and returns once all of them have finished
+   */
+  void run(uint32_t nof_jobs, const job_t& job);
+
+  uint32_t get_nof_decoders() const { return 1 + (uint32_t)decoders.size(); }
+
+private:
+  void run_decoder(srsran_enb_ul_t& decoder, const job_t& job, uint32_t nof_jobs);
+
+  srsran_enb_ul_t*                                 main_decoder = nullptr;
+  srsran::task_thread_pool*                        task_pool    = nullptr;
+  std::vector<std::unique_ptr<srsran_enb_ul_t> > decoders;
+
+  std::atomic<uint32_t>   next_job = {0};
+  std::mutex              mutex;
+  std::condition_variable cvar;
+  uint32_t                nof_pending_tasks = 0;
+};
+
+} // namespace lte
+} // namespace srsenb
+
+#endif // SRSENB_LTE_UL_DECODER_POOL_H
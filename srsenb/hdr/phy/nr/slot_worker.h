@@ -27,6 +27,8 @@
 #include "srsran/interfaces/phy_common_interface.h"
 #include "srsran/srslog/srslog.h"
 #include "srsran/srsran.h"
+#include <atomic>
+#include <condition_variable>
 
 namespace srsenb {
 namespace nr {
@@ -34,7 +36,10 @@ namespace nr {
 /**
  * The slot_worker class handles the PHY processing, UL and DL procedures associated with 1 slot.
  *
- * A slot_worker object is executed by a thread within the thread_pool.
+ * A slot_worker object is executed by a thread within the thread_pool. If a task pool is given, the UL reception is
+ * pushed to it as a task and runs concurrently with the DL transmission, which encodes the PDSCH of different UEs in
+ * parallel using the task pool too. The worker thread runs any of these tasks that has not started by the time it is
+ * done with the rest, so a busy task pool never delays the slot more than the sequential processing.
  */
 
 class slot_worker final : public srsran::thread_pool::worker
@@ -59,15 +64,23 @@ public:
   };
 
   struct args_t {
-    uint32_t                    cell_index       = 0;
-    uint32_t                    nof_max_prb      = SRSRAN_MAX_PRB_NR;
-    uint32_t                    nof_tx_ports     = 1;
-    uint32_t                    nof_rx_ports     = 1;
-    uint32_t                    rf_port          = 0;
-    srsran_subcarrier_spacing_t scs              = srsran_subcarrier_spacing_15kHz;
-    uint32_t                    pusch_max_its    = 10;
-    float                       pusch_min_snr_dB = -10.0f;
-    double                      srate_hz         = 0.0;
+    uint32_t                    cell_index         = 0;
+    uint32_t                    nof_max_prb        = SRSRAN_MAX_PRB_NR;
+    uint32_t                    nof_tx_ports       = 1;
+    uint32_t                    nof_rx_ports       = 1;
+    uint32_t                    rf_port            = 0;
+    uint32_t                    nof_pdsch_encoders = 1; ///< PDSCH encoded in parallel, only with a task pool
+    srsran_subcarrier_spacing_t scs                = srsran_subcarrier_spacing_15kHz;
+    uint32_t                    pusch_max_its      = 10;
+    float                       pusch_min_snr_dB   = -10.0f;
+    double                      srate_hz           = 0.0;
+    srsran::task_thread_pool*   task_pool          = nullptr; ///< Shared by all workers, sequential UL and DL if null
+  };
+
+  struct metrics_t {
+    uint32_t nof_slots           = 0;
+    double   avg_slot_latency_us = 0; ///< Processing time from the slot start until it is ready for transmission
+    double   max_slot_latency_us = 0;
   };
 
   slot_worker(srsran::phy_common_interface& common_,
@@ -88,17 +101,33 @@ public:
   uint32_t get_buffer_len();
   void     set_context(const srsran::phy_common_interface::worker_context_t& w_ctx);
 
+  /**
+   * @brief Gets the slot processing metrics accumulated since the last call
+   */
+  metrics_t get_metrics();
+
 private:
+  /**
+   * @brief Tasks of a slot pushed to the task pool. A task entering after the group is closed returns immediately,
+   * the worker thread has already done its work
+   */
+  struct task_group_t {
+    uint32_t run        = 0;     ///< Incremented every time the group is opened
+    bool     open       = false; ///< Tasks of the current run can still enter
+    uint32_t nof_active = 0;     ///< Tasks that entered and did not leave yet
+  };
+
   /**
    * @brief Inherited from thread_pool::worker. Function called every slot to run the DL/UL processing
    */
   void work_imp() override;
 
   /**
-   * @brief Retrieves the scheduling results for the UL processing and performs reception
+   * @brief Performs the UL reception of the given scheduling results
+   * @param ul_sched UL scheduling results, it is an error if it is null
    * @return True if no error occurs, false otherwise
    */
-  bool work_ul();
+  bool work_ul(stack_interface_phy_nr::ul_sched_t* ul_sched);
 
   /**
    * @brief Retrieves the scheduling results for the DL processing and performs transmission
@@ -106,6 +135,28 @@ private:
    */
   bool work_dl();
 
+  /**
+   * @brief Runs the UL in a task and the DL in the calling thread
+   * @return True if no error occurs, false otherwise
+   */
+  bool work_dl_ul_concurrent();
+
+  /**
+   * @brief Puts all the PDSCH of the DL scheduling results, encoding them in parallel if there is a task pool
+   * @return True if no error occurs, false otherwise
+   */
+  bool put_pdsch(const stack_interface_phy_nr::dl_sched_t& dl_sched);
+
+  /**
+   * @brief Puts PDSCH transmissions with the given encoder until none is left
+   */
+  void put_pdsch_jobs(uint32_t encoder_idx);
+
+  uint32_t open_task_group(task_group_t& group);
+  void     close_task_group(task_group_t& group);
+  bool     enter_task_group(task_group_t& group, uint32_t run);
+  void     leave_task_group(task_group_t& group);
+
   srsran::phy_common_interface& common;
   stack_interface_phy_nr&       stack;
   srslog::basic_logger&         logger;
@@ -123,6 +174,24 @@ private:
   std::vector<cf_t*>                             tx_buffer; ///< Baseband transmit buffers
   std::vector<cf_t*>                             rx_buffer; ///< Baseband receive buffers
   std::mutex mutex; ///< Protect concurrent access from workers (and main process that inits the class)
+
+  // Concurrent processing
+  srsran::task_thread_pool*                                task_pool = nullptr;
+  stack_interface_phy_nr::ul_sched_t                       ul_sched  = {}; ///< Copy read by the UL task
+  std::atomic<bool>                                        ul_claimed = {false};
+  bool                                                     ul_result  = false;
+  const stack_interface_phy_nr::dl_sched_t*                pdsch_sched   = nullptr;
+  std::array<uint32_t, stack_interface_phy_nr::MAX_GRANTS> pdsch_encoder = {}; ///< Encoder used by each PDSCH
+  std::atomic<uint32_t>                                    next_pdsch    = {0};
+  std::atomic<bool>                                        pdsch_error   = {false};
+  std::atomic<uint32_t>                                    next_pdsch_encoder = {1};
+  task_group_t                                             ul_tasks, pdsch_tasks;
+  std::mutex                                               task_mutex;
+  std::condition_variable                                  task_cvar;
+
+  // Metrics
+  std::mutex metrics_mutex;
+  metrics_t  metrics = {};
 };
 
 } // namespace nr
@@ -92,6 +92,7 @@ private:
   srslog::sink&                              log_sink;
   srsran::thread_pool                        pool;
   std::vector<std::unique_ptr<slot_worker> > workers;
+  std::unique_ptr<srsran::task_thread_pool>  task_pool; ///< Declared after the workers, its tasks reference them
   prach_worker_pool                          prach;
   uint32_t                                   current_tti = 0; ///< Current TTI, read and write from same thread
   srslog::basic_logger&                      logger;
@@ -103,6 +104,7 @@ public:
   struct args_t {
     double                 srate_hz          = 0.0;
     uint32_t               nof_phy_threads   = 3;
+    uint32_t               nof_slot_threads  = 0; ///< Threads processing UL and DL concurrently, sequential if 0
     uint32_t               nof_prach_workers = 0;
     uint32_t               prio              = 52;
     uint32_t               pusch_max_its     = 10;
@@ -121,6 +123,11 @@ public:
   void         start_worker(slot_worker* w);
   void         stop();
   int          set_common_cfg(const phy_interface_rrc_nr::common_cfg_t& common_cfg);
+
+  /**
+   * @brief Gets the slot processing metrics of all the workers, accumulated since the last call
+   */
+  slot_worker::metrics_t get_metrics();
 };
 
 } // namespace nr
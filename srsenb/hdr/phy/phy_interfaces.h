@@ -64,6 +64,7 @@ struct phy_args_t {
   uint32_t                pusch_max_its       = 10;
   uint32_t                nr_pusch_max_its    = 10;
   bool                    pusch_8bit_decoder  = false;
+  bool                    ul_slot_streaming   = false;
   float                   tx_amplitude        = 1.0f;
   uint32_t                nof_phy_threads     = 1;
   std::string             equalizer_mode      = "mmse";
@@ -71,8 +72,11 @@ struct phy_args_t {
   bool                    pusch_meas_epre     = true;
   bool                    pusch_meas_evm      = false;
   bool                    pusch_meas_ta       = true;
+  bool                    pusch_wiener        = false;
   bool                    pucch_meas_ta       = true;
   uint32_t                nof_prach_threads   = 1;
+  uint32_t                nof_ul_threads      = 0;
+  uint32_t                nr_nof_slot_threads = 0;
   bool                    extended_cp         = false;
   srsran::channel::args_t dl_channel_args;
   srsran::channel::args_t ul_channel_args;
@@ -34,6 +34,7 @@
 #include "upper/gtpu.h"
 #include "upper/pdcp.h"
 #include "upper/rlc.h"
+#include "upper/up_workers.h"
 
 #include "enb_stack_base.h"
 #include "srsran/common/bearer_manager.h"
@@ -179,12 +180,13 @@ private:
   enb_bearer_manager                 bearers; // helper to manage mapping between EPS and radio bearers
   std::unique_ptr<gtpu_pdcp_adapter> gtpu_adapter;
 
-  srsenb::mac  mac;
-  srsenb::rlc  rlc;
-  srsenb::pdcp pdcp;
-  srsenb::rrc  rrc;
-  srsenb::gtpu gtpu;
-  srsenb::s1ap s1ap;
+  srsenb::mac        mac;
+  srsenb::rlc        rlc;
+  srsenb::pdcp       pdcp;
+  srsenb::up_workers up_workers;
+  srsenb::rrc        rrc;
+  srsenb::gtpu       gtpu;
+  srsenb::s1ap       s1ap;
 
   // RAT-specific interfaces
   phy_interface_stack_lte* phy = nullptr;
@@ -74,6 +74,7 @@ public:
 
   // Metrics
   void get_metrics(pdcp_metrics_t& m, const uint32_t nof_tti);
+  void get_ue_metrics(std::map<uint16_t, srsran::pdcp_metrics_t>& ue_metrics, const uint32_t nof_tti);
 
 private:
   class user_interface_rlc : public srsue::rlc_interface_pdcp
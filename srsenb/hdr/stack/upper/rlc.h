@@ -26,6 +26,7 @@
 #include "srsran/rlc/rlc.h"
 #include "srsran/srslog/srslog.h"
 #include <map>
+#include <vector>
 
 #ifndef SRSENB_RLC_H
 #define SRSENB_RLC_H
@@ -47,8 +48,13 @@ class rlc : public rlc_interface_mac, public rlc_interface_rrc, public rlc_inter
 {
 public:
   explicit rlc(srslog::basic_logger& logger) : logger(logger) {}
-  void
-  init(pdcp_interface_rlc* pdcp_, rrc_interface_rlc* rrc_, mac_interface_rlc* mac_, srsran::timer_handler* timers_);
+  /// Users are spread by RNTI across nof_user_shards maps, each with its own lock, so that MAC reads of UEs in
+  /// different shards do not contend
+  void init(pdcp_interface_rlc*    pdcp_,
+            rrc_interface_rlc*     rrc_,
+            mac_interface_rlc*     mac_,
+            srsran::timer_handler* timers_,
+            uint32_t               nof_user_shards = 1);
   void stop();
   void get_metrics(rlc_metrics_t& m, const uint32_t nof_tti);
 
@@ -75,6 +81,7 @@ public:
   // rlc_interface_mac
   int  read_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes);
   void write_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes);
+  void write_pdu_slice(uint16_t rnti, uint32_t lcid, srsran::byte_buffer_slice pdu);
 
 private:
   class user_interface : public srsue::pdcp_interface_rlc, public srsue::rrc_interface_rlc
@@ -100,10 +107,14 @@ private:
 
   void update_bsr(uint32_t rnti, uint32_t lcid, uint32_t tx_queue, uint32_t retx_queue);
 
-  pthread_rwlock_t rwlock;
+  struct user_shard {
+    pthread_rwlock_t                   rwlock;
+    std::map<uint32_t, user_interface> users;
+  };
+  user_shard& get_shard(uint16_t rnti) { return shards[rnti % shards.size()]; }
 
-  std::map<uint32_t, user_interface> users;
-  std::vector<mch_service_t>         mch_services;
+  std::vector<user_shard>    shards;
+  std::vector<mch_service_t> mch_services;
 
   mac_interface_rlc*     mac  = nullptr;
   pdcp_interface_rlc*    pdcp = nullptr;
@@ -0,0 +1,162 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+/******************************************************************************
+ * File:        up_workers.h
+ * Description: Optional user-plane execution mode where the UEs are sharded by
+ *              RNTI across a pool of PDCP worker threads.
+ *****************************************************************************/
+
+#ifndef SRSENB_UP_WORKERS_H
+#define SRSENB_UP_WORKERS_H
+
+#include "srsenb/hdr/stack/upper/pdcp.h"
+#include "srsran/common/task_scheduler.h"
+#include "srsran/common/threads.h"
+#include "srsran/interfaces/enb_gtpu_interfaces.h"
+#include "srsran/interfaces/enb_pdcp_interfaces.h"
+#include "srsran/interfaces/enb_rrc_interface_pdcp.h"
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace srsenb {
+
+/**
+ * Pool of PDCP workers, each owning the PDCP state of the UEs whose RNTI maps to it (rnti % nof_workers).
+ * - Every worker has its own task scheduler, so the PDCP entities and their timers are only ever accessed by the
+ *   worker thread. No lock is shared between workers
+ * - Calls from the stack thread (RRC, GTP-U) and from RLC are enqueued in the worker of the RNTI, which preserves the
+ *   per-UE order. The calls returning a value block until the worker has processed them
+ * - PDUs towards RRC and GTP-U are handed back to the stack thread, which owns those layers. A worker never blocks
+ *   on the stack thread, which may itself be waiting for the worker, so PDUs that do not fit in the stack queue are
+ *   kept in a per-worker backlog and re-pushed in order
+ */
+class up_workers final : public pdcp_interface_rlc, public pdcp_interface_gtpu, public pdcp_interface_rrc
+{
+public:
+  up_workers(srsran::task_sched_handle stack_task_sched_, srslog::basic_logger& logger_);
+  ~up_workers();
+  void init(uint32_t nof_workers_, rlc_interface_pdcp* rlc_, rrc_interface_pdcp* rrc_, gtpu_interface_pdcp* gtpu_);
+  void stop();
+
+  /// Steps the timers of every worker. Called by the stack thread once per TTI
+  void tic();
+
+  // pdcp_interface_rlc
+  void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu) override;
+  void notify_delivery(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns) override;
+  void notify_failure(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns) override;
+
+  // pdcp_interface_rrc
+  void set_enabled(uint16_t rnti, uint32_t lcid, bool enabled) override;
+  void reset(uint16_t rnti) override;
+  void add_user(uint16_t rnti) override;
+  void rem_user(uint16_t rnti) override;
+  void write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu, int pdcp_sn = -1) override;
+  void add_bearer(uint16_t rnti, uint32_t lcid, const srsran::pdcp_config_t& cnfg) override;
+  void del_bearer(uint16_t rnti, uint32_t lcid) override;
+  void config_security(uint16_t rnti, uint32_t lcid, const srsran::as_security_config_t& cfg_sec) override;
+  void enable_integrity(uint16_t rnti, uint32_t lcid) override;
+  void enable_encryption(uint16_t rnti, uint32_t lcid) override;
+  bool get_bearer_state(uint16_t rnti, uint32_t lcid, srsran::pdcp_lte_state_t* state) override;
+  bool set_bearer_state(uint16_t rnti, uint32_t lcid, const srsran::pdcp_lte_state_t& state) override;
+  void send_status_report(uint16_t rnti) override;
+  void send_status_report(uint16_t rnti, uint32_t lcid) override;
+  void reestablish(uint16_t rnti) override;
+
+  // pdcp_interface_gtpu
+  std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus(uint16_t rnti, uint32_t lcid) override;
+
+  // Metrics
+  void get_metrics(pdcp_metrics_t& m, const uint32_t nof_tti);
+
+  uint32_t nof_workers() const { return workers.size(); }
+
+private:
+  /// Forwards the PDUs produced by one worker to the stack thread. Only accessed by the worker thread
+  class stack_adapter final : public rrc_interface_pdcp, public gtpu_interface_pdcp
+  {
+  public:
+    // rrc_interface_pdcp
+    void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu) override;
+    void notify_pdcp_integrity_error(uint16_t rnti, uint32_t lcid) override;
+
+    void push(srsran::move_task_t task);
+    /// Moves the backlogged tasks to the stack queue, for as long as it has room
+    void flush_backlog();
+
+    srsran::task_queue_handle       queue;
+    std::deque<srsran::move_task_t> backlog;
+    rrc_interface_pdcp*             rrc    = nullptr;
+    gtpu_interface_pdcp*            gtpu   = nullptr;
+    srslog::basic_logger*           logger = nullptr;
+  };
+
+  /// gtpu_interface_pdcp shares its method signature with rrc_interface_pdcp, so it needs its own object
+  class stack_gtpu_adapter final : public gtpu_interface_pdcp
+  {
+  public:
+    void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu) override;
+
+    stack_adapter* stack = nullptr;
+  };
+
+  class worker final : public srsran::thread
+  {
+  public:
+    worker(uint32_t id, srslog::basic_logger& logger);
+    void stop();
+    bool is_running() const { return running.load(std::memory_order_relaxed); }
+
+    srsran::task_scheduler    task_sched;
+    srsran::task_queue_handle queue;
+    srsenb::pdcp              pdcp;
+    stack_adapter             stack_itf;
+    stack_gtpu_adapter        gtpu_itf;
+
+    /// TTI ticks not yet applied to the timers. Ticks are coalesced, so that at most one tick task is enqueued
+    std::atomic<uint32_t> pending_tics{0};
+
+  private:
+    void run_thread() override;
+
+    std::atomic<bool> running{true};
+  };
+
+  worker& get_worker(uint16_t rnti) { return *workers[rnti % workers.size()]; }
+  void    push_task(uint16_t rnti, srsran::move_task_t task);
+
+  /// Runs func in the worker w and waits for its result. Returns default_ret if the worker stops before running func
+  template <typename R, typename F>
+  R run_blocking(worker& w, R default_ret, F&& func);
+
+  static const int WORKER_THREAD_PRIO = 4;
+
+  srsran::task_sched_handle            stack_task_sched;
+  srslog::basic_logger&                logger;
+  std::vector<std::unique_ptr<worker>> workers;
+};
+
+} // namespace srsenb
+
+#endif // SRSENB_UP_WORKERS_H
@@ -1538,6 +1538,9 @@ static int parse_nr_cell_list(all_args_t* args, rrc_nr_cfg_t* rrc_cfg_nr, rrc_cf
     HANDLEPARSERCODE(parse_required_field(cell_cfg.band, cellroot, "band"));
     // frequencies get derived from ARFCN
 
+    parse_opt_field(cell_cfg.sched_policy, cellroot, "sched_policy");
+    parse_opt_field(cell_cfg.sched_policy_args, cellroot, "sched_policy_args");
+
     // TODO: Add further cell-specific parameters
 
     rrc_cfg_nr->cell_list.push_back(cell_cfg);
@@ -2141,8 +2144,9 @@ int set_derived_args_nr(all_args_t* args_, rrc_nr_cfg_t* rrc_nr_cfg_, phy_cfg_t*
   }
 
   // MAC-NR PCAP options
-  args_->nr_stack.mac.pcap.enable = args_->stack.mac_pcap.enable;
-  args_->nr_stack.log             = args_->stack.log;
+  args_->nr_stack.mac.pcap.enable    = args_->stack.mac_pcap.enable;
+  args_->nr_stack.mac.pcap.file_args = args_->stack.mac_pcap.file_args;
+  args_->nr_stack.log                = args_->stack.log;
 
   // Sanity check for unsupported/untested configuration
   for (auto& cfg : rrc_nr_cfg_->cell_list) {
@@ -95,13 +95,24 @@ DECLARE_METRIC("nof_rach", metric_nof_rach, uint32_t, "");
 DECLARE_METRIC_LIST("ue_list", mlist_ues, std::vector<mset_ue_container>);
 DECLARE_METRIC_SET("cell_container", mset_cell_container, metric_carrier_id, metric_pci, metric_nof_rach, mlist_ues);
 
+/// MAC capture metrics.
+DECLARE_METRIC("written_pdus", metric_pcap_written_pdus, uint64_t, "");
+DECLARE_METRIC("written_bytes", metric_pcap_written_bytes, uint64_t, "");
+DECLARE_METRIC("dropped_pdus", metric_pcap_dropped_pdus, uint64_t, "");
+DECLARE_METRIC_SET("pcap_container",
+                   mset_pcap_container,
+                   metric_pcap_written_pdus,
+                   metric_pcap_written_bytes,
+                   metric_pcap_dropped_pdus);
+
 /// Metrics root object.
 DECLARE_METRIC("type", metric_type_tag, std::string, "");
 DECLARE_METRIC("timestamp", metric_timestamp_tag, double, "");
 DECLARE_METRIC_LIST("cell_list", mlist_cell, std::vector<mset_cell_container>);
 
 /// Metrics context.
-using metric_context_t = srslog::build_context_type<metric_type_tag, metric_timestamp_tag, mlist_cell>;
+using metric_context_t =
+    srslog::build_context_type<metric_type_tag, metric_timestamp_tag, mlist_cell, mset_pcap_container>;
 
 } // namespace
 
@@ -238,6 +249,11 @@ void metrics_json::set_metrics(const enb_metrics_t& m, const uint32_t period_use
     }
   }
 
+  auto& pcap = ctx.get<mset_pcap_container>();
+  pcap.write<metric_pcap_written_pdus>(m.stack.pcap.nof_written_pdus);
+  pcap.write<metric_pcap_written_bytes>(m.stack.pcap.nof_written_bytes);
+  pcap.write<metric_pcap_dropped_pdus>(m.stack.pcap.nof_dropped_pdus);
+
   // Log the context.
   ctx.write<metric_timestamp_tag>(get_time_stamp());
   log_c(ctx);
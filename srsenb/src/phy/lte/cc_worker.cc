@@ -66,6 +66,9 @@ cc_worker::~cc_worker()
   srsran_softbuffer_tx_free(&temp_mbsfn_softbuffer);
   srsran_enb_dl_free(&enb_dl);
   srsran_enb_ul_free(&enb_ul);
+  if (ul_llr) {
+    free(ul_llr);
+  }
 
   for (int p = 0; p < SRSRAN_MAX_PORTS; p++) {
     if (signal_buffer_rx[p]) {
@@ -86,7 +89,7 @@ cc_worker::~cc_worker()
 FILE* f;
 #endif
 
-void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
+void cc_worker::init(phy_common* phy_, uint32_t cc_idx_, srsran::task_thread_pool* ul_task_pool)
 {
   phy                         = phy_;
   cc_idx                      = cc_idx_;
@@ -132,6 +135,14 @@ void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
     return;
   }
 
+  // Room for the soft bits of all the PUSCH REs of the carrier, at most 6 bits each as 64QAM is the highest UL order
+  ul_llr_len = enb_ul.pusch.max_re * srsran_mod_bits_x_symbol(SRSRAN_MOD_64QAM);
+  ul_llr     = srsran_vec_i16_malloc(ul_llr_len);
+  if (!ul_llr) {
+    ERROR("Error allocating memory");
+    return;
+  }
+
   /* Setup SI-RNTI in PHY */
   add_rnti(SRSRAN_SIRNTI);
 
@@ -156,6 +167,12 @@ void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
     enb_ul.pusch.llr_is_8bit        = true;
     enb_ul.pusch.ul_sch.llr_is_8bit = true;
   }
+
+  // Additional decoders for processing UEs in parallel, they share the resource grid of enb_ul
+  if (ul_decoders.init(&enb_ul, &phy->dmrs_pusch_cfg, ul_task_pool) < SRSRAN_SUCCESS) {
+    ERROR("Error initiating UL decoders");
+    return;
+  }
   initiated = true;
 
 #ifdef DEBUG_WRITE_FILE
@@ -212,20 +229,95 @@ uint32_t cc_worker::get_nof_rnti()
   return ue_db.size();
 }
 
-void cc_worker::work_ul(const srsran_ul_sf_cfg_t& ul_sf_cfg, stack_interface_phy_lte::ul_sched_t& ul_grants)
+void cc_worker::work_ul_prepare(const srsran_ul_sf_cfg_t& ul_sf_cfg, stack_interface_phy_lte::ul_sched_t& ul_grants)
 {
   std::lock_guard<std::mutex> lock(mutex);
   ul_sf = ul_sf_cfg;
   logger.set_context(ul_sf.tti);
 
-  // Process UL signal
-  srsran_enb_ul_fft(&enb_ul);
+  ul_jobs.clear();
+
+  // Prepare pending UL grants for the tti they were scheduled, stops at the first grant that cannot be decoded
+  for (uint32_t i = 0; i < ul_grants.nof_grants; i++) {
+    ul_jobs.emplace_back();
+    if (!prepare_pusch(ul_grants.pusch[i], ul_jobs.back())) {
+      ul_jobs.pop_back();
+      break;
+    }
+  }
+  nof_pusch_jobs = ul_jobs.size();
+
+  // Prepare remaining PUCCH ACKs not associated with PUSCH transmission and SR signals
+  for (auto& iter : ue_db) {
+    uint16_t rnti = iter.first;
+
+    // If it's a User RNTI and doesn't have PUSCH grant in this TTI
+    if (SRSRAN_RNTI_ISUSER(rnti) and phy->ue_db.is_pcell(rnti, cc_idx)) {
+      ul_jobs.emplace_back();
+      if (!prepare_pucch(rnti, ul_jobs.back())) {
+        ul_jobs.pop_back();
+      }
+    }
+  }
+}
+
+void cc_worker::work_ul_fft_slot(uint32_t slot_idx)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  // Process UL signal, only the given slot needs to be in the reception buffer
+  srsran_enb_ul_fft_slot(&enb_ul, slot_idx);
+}
+
+void cc_worker::work_ul_demod_first_slot()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  // Give each PUSCH its soft bits, grants beyond the buffer are demodulated at once after the second slot
+  uint32_t llr_offset = 0;
+  for (uint32_t i = 0; i < nof_pusch_jobs; i++) {
+    ul_job_t& job      = ul_jobs[i];
+    uint32_t  nof_bits = job.ul_cfg.pusch.grant.nof_re * srsran_mod_bits_x_symbol(SRSRAN_MOD_64QAM);
+    if (job.pusch_res.data == nullptr or llr_offset + nof_bits > ul_llr_len) {
+      continue;
+    }
+    job.pusch_llr = enb_ul.pusch.llr_is_8bit ? (void*)&((int8_t*)ul_llr)[llr_offset] : (void*)&ul_llr[llr_offset];
+    llr_offset += nof_bits;
+  }
+
+  // The channel of the first slot is estimated from its own DMRS
+  ul_decoders.run(nof_pusch_jobs, [this](srsran_enb_ul_t& decoder, uint32_t job_idx) {
+    ul_job_t& job = ul_jobs[job_idx];
+    if (job.pusch_llr != nullptr) {
+      job.ret = srsran_enb_ul_get_pusch_slot(&decoder, &ul_sf, &job.ul_cfg.pusch, 0, job.pusch_llr, &job.pusch_res);
+    }
+  });
+}
+
+void cc_worker::work_ul_decode()
+{
+  std::lock_guard<std::mutex> lock(mutex);
 
-  // Decode pending UL grants for the tti they were scheduled
-  decode_pusch(ul_grants.pusch, ul_grants.nof_grants);
+  // Decode all the UEs, possibly in parallel
+  ul_decoders.run(ul_jobs.size(), [this](srsran_enb_ul_t& decoder, uint32_t job_idx) {
+    decode_ul_job(decoder, ul_jobs[job_idx]);
+  });
 
-  // Decode remaining PUCCH ACKs not associated with PUSCH transmission and SR signals
-  decode_pucch();
+  // Report results to the stack in the same order they were scheduled, all the grants need to report MAC the CRC
+  // status. The UEs removed while the subframe was being received are skipped
+  for (uint32_t i = 0; i < nof_pusch_jobs; i++) {
+    if (ue_db.count(ul_jobs[i].rnti) == 0) {
+      continue;
+    }
+    if (!report_pusch(ul_jobs[i])) {
+      break;
+    }
+  }
+  for (uint32_t i = nof_pusch_jobs; i < ul_jobs.size(); i++) {
+    if (ue_db.count(ul_jobs[i].rnti) > 0) {
+      report_pucch(ul_jobs[i]);
+    }
+  }
 }
 
 void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
@@ -283,9 +375,7 @@ void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
   }
 }
 
-bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_grant,
-                                  srsran_ul_cfg_t&                           ul_cfg,
-                                  srsran_pusch_res_t&                        pusch_res)
+bool cc_worker::prepare_pusch(stack_interface_phy_lte::ul_sched_grant_t& ul_grant, ul_job_t& job)
 {
   uint16_t rnti = ul_grant.dci.rnti;
 
@@ -299,7 +389,11 @@ bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_
     return false;
   }
 
+  job.rnti        = rnti;
+  job.pusch_grant = &ul_grant;
+
   // Get UE configuration
+  srsran_ul_cfg_t& ul_cfg = job.ul_cfg;
   if (phy->ue_db.get_ul_config(rnti, cc_idx, ul_cfg) < SRSRAN_SUCCESS) {
     // It could happen that the UL configuration is missing due to intra-enb HO which is not an error
     Info("Failed retrieving UL configuration for cc=%d rnti=0x%x", cc_idx, rnti);
@@ -307,7 +401,7 @@ bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_
   }
 
   // Fill UCI configuration
-  bool uci_required =
+  job.uci_required =
       phy->ue_db.fill_uci_cfg(tti_rx, cc_idx, rnti, ul_grant.dci.cqi_request, true, ul_cfg.pusch.uci_cfg);
 
   // Compute UL grant
@@ -338,20 +432,76 @@ bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_
     Error("Error setting last UL TB for RNTI %x, CC %d, PID %d", rnti, cc_idx, ul_grant.pid);
   }
 
-  // Run PUSCH decoder
   ul_cfg.pusch.softbuffers.rx = ul_grant.softbuffer_rx;
-  pusch_res.data              = ul_grant.data;
-  if (pusch_res.data) {
-    if (srsran_enb_ul_get_pusch(&enb_ul, &ul_sf, &ul_cfg.pusch, &pusch_res)) {
-      Error("Decoding PUSCH for RNTI %x", rnti);
-      return false;
+  job.pusch_res.data          = ul_grant.data;
+  return true;
+}
+
+bool cc_worker::prepare_pucch(uint16_t rnti, ul_job_t& job)
+{
+  job.rnti = rnti;
+
+  if (phy->ue_db.get_ul_config(rnti, cc_idx, job.ul_cfg) < SRSRAN_SUCCESS) {
+    Error("Error retrieving last UL configuration for RNTI %x, CC %d", rnti, cc_idx);
+    return false;
+  }
+
+  // Check if user needs to receive PUCCH
+  int ret = phy->ue_db.fill_uci_cfg(tti_rx, cc_idx, rnti, false, false, job.ul_cfg.pucch.uci_cfg);
+  if (ret < SRSRAN_SUCCESS) {
+    Error("Error retrieving UCI configuration for RNTI %x, CC %d", rnti, cc_idx);
+    return false;
+  }
+
+  // If ret is more than success, UCI is present
+  return ret > SRSRAN_SUCCESS;
+}
+
+void cc_worker::decode_ul_job(srsran_enb_ul_t& decoder, ul_job_t& job)
+{
+  if (job.pusch_grant == nullptr) {
+    job.ret = srsran_enb_ul_get_pucch(&decoder, &ul_sf, &job.ul_cfg.pucch, &job.pucch_res);
+    return;
+  }
+
+  // Run PUSCH decoder, the first slot may have been demodulated already
+  if (job.pusch_res.data and job.pusch_llr != nullptr) {
+    if (job.ret == SRSRAN_SUCCESS) {
+      job.ret = srsran_enb_ul_get_pusch_slot(&decoder, &ul_sf, &job.ul_cfg.pusch, 1, job.pusch_llr, &job.pusch_res);
+    }
+    if (job.ret == SRSRAN_SUCCESS) {
+      job.ret = srsran_enb_ul_decode_pusch_llr(&decoder, &ul_sf, &job.ul_cfg.pusch, job.pusch_llr, &job.pusch_res);
     }
+
+    // Keep the measurements only, the channel estimates belong to the decoder
+    job.chest_res    = decoder.chest_res;
+    job.chest_res.ce = nullptr;
+  } else if (job.pusch_res.data) {
+    job.ret = srsran_enb_ul_get_pusch(&decoder, &ul_sf, &job.ul_cfg.pusch, &job.pusch_res);
+
+    // Keep the measurements only, the channel estimates belong to the decoder
+    job.chest_res    = decoder.chest_res;
+    job.chest_res.ce = nullptr;
   }
+}
+
+bool cc_worker::report_pusch(ul_job_t& job)
+{
+  stack_interface_phy_lte::ul_sched_grant_t& ul_grant  = *job.pusch_grant;
+  srsran_ul_cfg_t&                           ul_cfg    = job.ul_cfg;
+  srsran_pusch_res_t&                        pusch_res = job.pusch_res;
+  uint16_t                                   rnti      = job.rnti;
+
+  if (job.ret != SRSRAN_SUCCESS) {
+    Error("Decoding PUSCH for RNTI %x", rnti);
+    return false;
+  }
+
   // Save PHICH scheduling for this user. Each user can have just 1 PUSCH dci per TTI
-  ue_db[rnti]->phich_grant.n_prb_lowest = grant.n_prb_tilde[0];
+  ue_db[rnti]->phich_grant.n_prb_lowest = ul_cfg.pusch.grant.n_prb_tilde[0];
   ue_db[rnti]->phich_grant.n_dmrs       = ul_grant.dci.n_dmrs;
 
-  float snr_db = enb_ul.chest_res.snr_db;
+  float snr_db = job.chest_res.snr_db;
 
   // Notify MAC of RL status
   if (snr_db >= PUSCH_RL_SNR_DB_TH) {
@@ -359,119 +509,72 @@ bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_
     phy->stack->snr_info(ul_sf.tti, rnti, cc_idx, snr_db, mac_interface_phy_lte::PUSCH);
 
     // Notify MAC of Time Alignment only if it enabled and valid measurement, ignore value otherwise
-    if (ul_cfg.pusch.meas_ta_en and not std::isnan(enb_ul.chest_res.ta_us) and not std::isinf(enb_ul.chest_res.ta_us)) {
-      phy->stack->ta_info(ul_sf.tti, rnti, enb_ul.chest_res.ta_us);
+    if (ul_cfg.pusch.meas_ta_en and not std::isnan(job.chest_res.ta_us) and not std::isinf(job.chest_res.ta_us)) {
+      phy->stack->ta_info(ul_sf.tti, rnti, job.chest_res.ta_us);
     }
   }
 
   // Send UCI data to MAC
-  if (uci_required) {
+  if (job.uci_required) {
     phy->ue_db.send_uci_data(tti_rx, rnti, cc_idx, ul_cfg.pusch.uci_cfg, pusch_res.uci);
   }
 
-  // Save statistics only if data was provided
+  // Notify MAC new received data and HARQ Indication value
   if (ul_grant.data != nullptr) {
     // Save metrics stats
     ue_db[rnti]->metrics_ul(ul_grant.dci.tb.mcs_idx,
-                            enb_ul.chest_res.epre_dBfs - phy->params.rx_gain_offset,
-                            enb_ul.chest_res.snr_db,
+                            job.chest_res.epre_dBfs - phy->params.rx_gain_offset,
+                            job.chest_res.snr_db,
                             pusch_res.avg_iterations_block);
-  }
-  return true;
-}
-
-void cc_worker::decode_pusch(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_pusch)
-{
-  // Iterate over all the grants, all the grants need to report MAC the CRC status
-  for (uint32_t i = 0; i < nof_pusch; i++) {
-    // Get grant itself and RNTI
-    stack_interface_phy_lte::ul_sched_grant_t& ul_grant = grants[i];
-    uint16_t                                   rnti     = ul_grant.dci.rnti;
-
-    srsran_pusch_res_t pusch_res = {};
-    srsran_ul_cfg_t    ul_cfg    = {};
-
-    // Decodes PUSCH for the given grant
-    if (!decode_pusch_rnti(ul_grant, ul_cfg, pusch_res)) {
-      return;
-    }
 
-    // Notify MAC new received data and HARQ Indication value
-    if (ul_grant.data != nullptr) {
-      // Inform MAC about the CRC result
-      phy->stack->crc_info(tti_rx, rnti, cc_idx, ul_cfg.pusch.grant.tb.tbs / 8, pusch_res.crc);
-      // Push PDU buffer
-      phy->stack->push_pdu(
-          tti_rx, rnti, cc_idx, ul_cfg.pusch.grant.tb.tbs / 8, pusch_res.crc, ul_cfg.pusch.grant.L_prb);
-      // Logging
-      if (logger.info.enabled()) {
-        char str[512];
-        srsran_pusch_rx_info(&ul_cfg.pusch, &pusch_res, &enb_ul.chest_res, str, sizeof(str));
-        logger.info("PUSCH: cc=%d, %s", cc_idx, str);
-      }
+    // Inform MAC about the CRC result
+    phy->stack->crc_info(tti_rx, rnti, cc_idx, ul_cfg.pusch.grant.tb.tbs / 8, pusch_res.crc);
+    // Push PDU buffer
+    phy->stack->push_pdu(tti_rx, rnti, cc_idx, ul_cfg.pusch.grant.tb.tbs / 8, pusch_res.crc, ul_cfg.pusch.grant.L_prb);
+    // Logging
+    if (logger.info.enabled()) {
+      char str[512];
+      srsran_pusch_rx_info(&ul_cfg.pusch, &pusch_res, &job.chest_res, str, sizeof(str));
+      logger.info("PUSCH: cc=%d, %s", cc_idx, str);
     }
   }
+  return true;
 }
 
-int cc_worker::decode_pucch()
+void cc_worker::report_pucch(ul_job_t& job)
 {
-  srsran_pucch_res_t pucch_res = {};
-
-  for (auto& iter : ue_db) {
-    uint16_t rnti = iter.first;
-
-    // If it's a User RNTI and doesn't have PUSCH grant in this TTI
-    if (SRSRAN_RNTI_ISUSER(rnti) and phy->ue_db.is_pcell(rnti, cc_idx)) {
-      srsran_ul_cfg_t ul_cfg = {};
+  srsran_pucch_res_t& pucch_res = job.pucch_res;
+  uint16_t            rnti      = job.rnti;
 
-      if (phy->ue_db.get_ul_config(rnti, cc_idx, ul_cfg) < SRSRAN_SUCCESS) {
-        Error("Error retrieving last UL configuration for RNTI %x, CC %d", rnti, cc_idx);
-        continue;
-      }
-
-      // Check if user needs to receive PUCCH
-      int ret = phy->ue_db.fill_uci_cfg(tti_rx, cc_idx, rnti, false, false, ul_cfg.pucch.uci_cfg);
-      if (ret < SRSRAN_SUCCESS) {
-        Error("Error retrieving UCI configuration for RNTI %x, CC %d", rnti, cc_idx);
-        continue;
-      }
-
-      // If ret is more than success, UCI is present
-      if (ret > SRSRAN_SUCCESS) {
-        // Decode PUCCH
-        if (srsran_enb_ul_get_pucch(&enb_ul, &ul_sf, &ul_cfg.pucch, &pucch_res)) {
-          Error("Error getting PUCCH");
-          continue;
-        }
+  if (job.ret != SRSRAN_SUCCESS) {
+    Error("Error getting PUCCH");
+    return;
+  }
 
-        // Send UCI data to MAC
-        if (phy->ue_db.send_uci_data(tti_rx, rnti, cc_idx, ul_cfg.pucch.uci_cfg, pucch_res.uci_data) < SRSRAN_SUCCESS) {
-          Error("Error sending UCI data for RNTI %x, CC %d", rnti, cc_idx);
-          continue;
-        }
+  // Send UCI data to MAC
+  if (phy->ue_db.send_uci_data(tti_rx, rnti, cc_idx, job.ul_cfg.pucch.uci_cfg, pucch_res.uci_data) < SRSRAN_SUCCESS) {
+    Error("Error sending UCI data for RNTI %x, CC %d", rnti, cc_idx);
+    return;
+  }
 
-        if (pucch_res.detected and pucch_res.ta_valid) {
-          phy->stack->ta_info(tti_rx, rnti, pucch_res.ta_us);
-          phy->stack->snr_info(tti_rx, rnti, cc_idx, pucch_res.snr_db, mac_interface_phy_lte::PUCCH);
-        }
+  if (pucch_res.detected and pucch_res.ta_valid) {
+    phy->stack->ta_info(tti_rx, rnti, pucch_res.ta_us);
+    phy->stack->snr_info(tti_rx, rnti, cc_idx, pucch_res.snr_db, mac_interface_phy_lte::PUCCH);
+  }
 
-        // Logging
-        if (logger.info.enabled()) {
-          char str[512];
-          srsran_pucch_rx_info(&ul_cfg.pucch, &pucch_res, str, sizeof(str));
-          logger.info("PUCCH: cc=%d; %s", cc_idx, str);
-        }
+  // Logging
+  if (logger.info.enabled()) {
+    char str[512];
+    srsran_pucch_rx_info(&job.ul_cfg.pucch, &pucch_res, str, sizeof(str));
+    logger.info("PUCCH: cc=%d; %s", cc_idx, str);
+  }
 
-        // Save metrics
-        if (pucch_res.detected) {
-          ue_db[rnti]->metrics_ul_pucch(pucch_res.rssi_dbFs - phy->params.rx_gain_offset,
-                                        pucch_res.ni_dbFs - -phy->params.rx_gain_offset,
-                                        pucch_res.snr_db);
-        }
-      }
-    }
+  // Save metrics
+  if (pucch_res.detected) {
+    ue_db[rnti]->metrics_ul_pucch(pucch_res.rssi_dbFs - phy->params.rx_gain_offset,
+                                  pucch_res.ni_dbFs - -phy->params.rx_gain_offset,
+                                  pucch_res.snr_db);
   }
-  return 0;
 }
 
 int cc_worker::encode_phich(stack_interface_phy_lte::ul_sched_ack_t* acks, uint32_t nof_acks)
@@ -72,7 +72,17 @@ namespace lte {
 FILE* f;
 #endif
 
-void sf_worker::init(phy_common* phy_)
+sf_worker::sf_worker(srslog::basic_logger& logger) :
+  logger(logger),
+  ul_fft_slot0_tprof("ul_fft_slot0_tprof", "PHY", STAGE_TPROF_PERIOD),
+  ul_fft_slot1_tprof("ul_fft_slot1_tprof", "PHY", STAGE_TPROF_PERIOD),
+  ul_demod_slot0_tprof("ul_demod_slot0_tprof", "PHY", STAGE_TPROF_PERIOD),
+  ul_decode_tprof("ul_decode_tprof", "PHY", STAGE_TPROF_PERIOD),
+  ul_latency_tprof("ul_latency_tprof", "PHY", STAGE_TPROF_PERIOD),
+  dl_tprof("dl_tprof", "PHY", STAGE_TPROF_PERIOD)
+{}
+
+void sf_worker::init(phy_common* phy_, srsran::task_thread_pool* ul_task_pool)
 {
   phy = phy_;
 
@@ -82,7 +92,7 @@ void sf_worker::init(phy_common* phy_)
     auto q = new cc_worker(logger);
 
     // Initialise
-    q->init(phy, i);
+    q->init(phy, i, ul_task_pool);
 
     // Create unique pointer
     cc_workers.push_back(std::unique_ptr<cc_worker>(q));
@@ -121,6 +131,33 @@ void sf_worker::set_context(const srsran::phy_common_interface::worker_context_t
   for (auto& w : cc_workers) {
     w->set_tti(w_ctx.sf_idx);
   }
+
+  {
+    std::lock_guard<std::mutex> lock(rx_slot_mutex);
+    ul_slot_streaming = false;
+  }
+  set_nof_rx_slots(SRSRAN_NOF_SLOTS_PER_SF);
+}
+
+void sf_worker::set_nof_rx_slots(uint32_t nof_slots)
+{
+  {
+    std::lock_guard<std::mutex> lock(rx_slot_mutex);
+    nof_rx_slots = SRSRAN_MIN(nof_slots, SRSRAN_NOF_SLOTS_PER_SF);
+    if (nof_rx_slots < SRSRAN_NOF_SLOTS_PER_SF) {
+      ul_slot_streaming = true;
+    }
+  }
+  rx_slot_cvar.notify_all();
+}
+
+bool sf_worker::wait_rx_slot(uint32_t slot_idx)
+{
+  std::unique_lock<std::mutex> lock(rx_slot_mutex);
+  while (nof_rx_slots <= slot_idx) {
+    rx_slot_cvar.wait(lock);
+  }
+  return ul_slot_streaming;
 }
 
 int sf_worker::add_rnti(uint16_t rnti, uint32_t cc_idx)
@@ -188,10 +225,42 @@ void sf_worker::work_imp()
     Info("Failed setting UL grants. Some grant's RNTI does not exist.");
   }
 
-  // Process UL
+  // Prepare the UL jobs before any slot is received
+  for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
+    cc_workers[cc]->work_ul_prepare(ul_sf, ul_grants[cc]);
+  }
+
+  // Demodulate each UL slot as soon as it is available in the reception buffers
+  for (uint32_t slot_idx = 0; slot_idx < SRSRAN_NOF_SLOTS_PER_SF; slot_idx++) {
+    bool streaming = wait_rx_slot(slot_idx);
+
+    auto& fft_tprof = (slot_idx == 0) ? ul_fft_slot0_tprof : ul_fft_slot1_tprof;
+    fft_tprof.start();
+    if (slot_idx == SRSRAN_NOF_SLOTS_PER_SF - 1) {
+      ul_latency_tprof.start();
+    }
+    for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
+      cc_workers[cc]->work_ul_fft_slot(slot_idx);
+    }
+    fft_tprof.stop();
+
+    // The PUSCH of the first slot is only worth demodulating on its own if the second one is still being received
+    if (slot_idx == 0 and streaming) {
+      ul_demod_slot0_tprof.start();
+      for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
+        cc_workers[cc]->work_ul_demod_first_slot();
+      }
+      ul_demod_slot0_tprof.stop();
+    }
+  }
+
+  // Process the rest of the UL, the PUSCH codewords and the PUCCH span both slots
+  ul_decode_tprof.start();
   for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
-    cc_workers[cc]->work_ul(ul_sf, ul_grants[cc]);
+    cc_workers[cc]->work_ul_decode();
   }
+  ul_decode_tprof.stop();
+  ul_latency_tprof.stop();
 
   // Get DL scheduling for the TX TTI from MAC
   if (sf_type == SRSRAN_SF_NORM) {
@@ -225,6 +294,7 @@ void sf_worker::work_imp()
   phy->ue_db.clear_tti_pending_ack(tti_tx_ul);
 
   // Process DL
+  dl_tprof.start();
   for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
     // Select CFI and make sure it is in the right range
     dl_sf.cfi = dl_grants[cc].cfi;
@@ -233,6 +303,7 @@ void sf_worker::work_imp()
 
     cc_workers[cc]->work_dl(dl_sf, dl_grants[cc], ul_grants_tx[cc], &mbsfn_cfg);
   }
+  dl_tprof.stop();
 
   // Save grants
   phy->set_ul_grants(tti_tx_ul, ul_grants_tx);
@@ -0,0 +1,111 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/phy/lte/ul_decoder_pool.h"
+
+namespace srsenb {
+namespace lte {
+
+ul_decoder_pool::~ul_decoder_pool()
+{
+  for (auto& d : decoders) {
+    srsran_enb_ul_free(d.get());
+  }
+}
+
+int ul_decoder_pool::init(srsran_enb_ul_t*                   enb_ul,
+                          srsran_refsignal_dmrs_pusch_cfg_t* dmrs_cfg,
+                          srsran::task_thread_pool*          task_pool_)
+{
+  main_decoder = enb_ul;
+  task_pool    = task_pool_;
+
+  if (task_pool == nullptr) {
+    return SRSRAN_SUCCESS;
+  }
+
+  // One additional decoder for each thread of the pool, the calling thread uses the carrier object
+  for (size_t i = 0; i < task_pool->nof_workers(); i++) {
+    std::unique_ptr<srsran_enb_ul_t> d(new srsran_enb_ul_t{});
+    if (srsran_enb_ul_init_shared(d.get(), main_decoder, main_decoder->cell.nof_prb) < SRSRAN_SUCCESS) {
+      ERROR("Error initiating shared ENB UL");
+      return SRSRAN_ERROR;
+    }
+    if (srsran_enb_ul_set_cell(d.get(), main_decoder->cell, dmrs_cfg, nullptr) < SRSRAN_SUCCESS) {
+      srsran_enb_ul_free(d.get());
+      ERROR("Error setting shared ENB UL cell");
+      return SRSRAN_ERROR;
+    }
+
+    // Inherit the decoder settings of the carrier object
+    d->pusch.llr_is_8bit        = main_decoder->pusch.llr_is_8bit;
+    d->pusch.ul_sch.llr_is_8bit = main_decoder->pusch.ul_sch.llr_is_8bit;
+
+    decoders.push_back(std::move(d));
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+void ul_decoder_pool::run_decoder(srsran_enb_ul_t& decoder, const job_t& job, uint32_t nof_jobs)
+{
+  uint32_t i = next_job.fetch_add(1, std::memory_order_relaxed);
+  while (i < nof_jobs) {
+    job(decoder, i);
+    i = next_job.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void ul_decoder_pool::run(uint32_t nof_jobs, const job_t& job)
+{
+  next_job.store(0, std::memory_order_relaxed);
+
+  // Dispatch as many additional decoders as jobs beyond the first one
+  uint32_t nof_tasks = SRSRAN_MIN((uint32_t)decoders.size(), nof_jobs > 0 ? nof_jobs - 1 : 0);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    nof_pending_tasks = nof_tasks;
+  }
+  for (uint32_t i = 0; i < nof_tasks; i++) {
+    srsran_enb_ul_t* decoder = decoders[i].get();
+    task_pool->push_task([this, decoder, &job, nof_jobs]() {
+      run_decoder(*decoder, job, nof_jobs);
+
+      std::lock_guard<std::mutex> lock(mutex);
+      nof_pending_tasks--;
+      if (nof_pending_tasks == 0) {
+        cvar.notify_one();
+      }
+    });
+  }
+
+  // The calling thread decodes too
+  run_decoder(*main_decoder, job, nof_jobs);
+
+  // Wait for all the tasks, they reference the job and the decoders
+  std::unique_lock<std::mutex> lock(mutex);
+  while (nof_pending_tasks > 0) {
+    cvar.wait(lock);
+  }
+}
+
+} // namespace lte
+} // namespace srsenb
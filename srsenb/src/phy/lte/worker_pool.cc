@@ -27,6 +27,12 @@ worker_pool::worker_pool(uint32_t max_workers) : pool(max_workers) {}
 
 bool worker_pool::init(const phy_args_t& args, phy_common* common, srslog::sink& log_sink, int prio)
 {
+  // Threads shared by all workers for decoding the UL of different UEs in parallel
+  if (args.nof_ul_threads > 0) {
+    ul_pool = std::unique_ptr<srsran::task_thread_pool>(new srsran::task_thread_pool(args.nof_ul_threads, true));
+    ul_pool->start(prio);
+  }
+
   // Add workers to workers pool and start threads.
   srslog::basic_levels log_level = srslog::str_to_basic_level(args.log.phy_level);
   for (uint32_t i = 0; i < args.nof_phy_threads; i++) {
@@ -35,7 +41,7 @@ bool worker_pool::init(const phy_args_t& args, phy_common* common, srslog::sink&
     log.set_hex_dump_max_size(args.log.phy_hex_limit);
 
     auto w = std::unique_ptr<lte::sf_worker>(new sf_worker(log));
-    w->init(common);
+    w->init(common, ul_pool.get());
     pool.init_worker(i, w.get(), prio);
     workers.push_back(std::move(w));
   }
@@ -61,6 +67,11 @@ sf_worker* worker_pool::wait_worker_id(uint32_t id)
 void worker_pool::stop()
 {
   pool.stop();
+
+  // Stop the UL threads after the workers, which could be waiting for them
+  if (ul_pool != nullptr) {
+    ul_pool->stop();
+  }
 }
 
 }; // namespace lte
@@ -22,6 +22,7 @@
 #include "srsenb/hdr/phy/nr/slot_worker.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
+#include <chrono>
 
 //#define DEBUG_WRITE_FILE
 
@@ -52,6 +53,7 @@ bool slot_worker::init(const args_t& args)
   // Copy common configurations
   cell_index = args.cell_index;
   rf_port    = args.rf_port;
+  task_pool  = args.task_pool;
 
   // Allocate Tx buffers
   tx_buffer.resize(args.nof_tx_ports);
@@ -81,6 +83,7 @@ bool slot_worker::init(const args_t& args)
   dl_args.nof_tx_antennas      = args.nof_tx_ports;
   dl_args.nof_max_prb          = args.nof_max_prb;
   dl_args.srate_hz             = args.srate_hz;
+  dl_args.nof_pdsch_encoders   = task_pool != nullptr ? args.nof_pdsch_encoders : 1;
 
   // Initialise DL
   if (srsran_gnb_dl_init(&gnb_dl, tx_buffer.data(), &dl_args) < SRSRAN_SUCCESS) {
@@ -164,9 +167,52 @@ void slot_worker::set_context(const srsran::phy_common_interface::worker_context
   context.copy(w_ctx);
 }
 
-bool slot_worker::work_ul()
+slot_worker::metrics_t slot_worker::get_metrics()
+{
+  std::lock_guard<std::mutex> lock(metrics_mutex);
+  metrics_t                   ret = metrics;
+  metrics                         = {};
+  return ret;
+}
+
+uint32_t slot_worker::open_task_group(task_group_t& group)
+{
+  std::lock_guard<std::mutex> lock(task_mutex);
+  group.run++;
+  group.open = true;
+  return group.run;
+}
+
+void slot_worker::close_task_group(task_group_t& group)
+{
+  std::unique_lock<std::mutex> lock(task_mutex);
+  group.open = false;
+  while (group.nof_active > 0) {
+    task_cvar.wait(lock);
+  }
+}
+
+bool slot_worker::enter_task_group(task_group_t& group, uint32_t run)
+{
+  std::lock_guard<std::mutex> lock(task_mutex);
+  if (not group.open or group.run != run) {
+    return false;
+  }
+  group.nof_active++;
+  return true;
+}
+
+void slot_worker::leave_task_group(task_group_t& group)
+{
+  std::lock_guard<std::mutex> lock(task_mutex);
+  group.nof_active--;
+  if (group.nof_active == 0) {
+    task_cvar.notify_all();
+  }
+}
+
+bool slot_worker::work_ul(stack_interface_phy_nr::ul_sched_t* ul_sched)
 {
-  stack_interface_phy_nr::ul_sched_t* ul_sched = stack.get_ul_sched(ul_slot_cfg);
   if (ul_sched == nullptr) {
     logger.error("Error retrieving UL scheduling");
     return false;
@@ -349,25 +395,99 @@ bool slot_worker::work_dl()
   }
 
   // Encode PDSCH
-  for (const stack_interface_phy_nr::pdsch_t& pdsch : dl_sched_ptr->pdsch) {
+  if (not put_pdsch(*dl_sched_ptr)) {
+    return false;
+  }
+
+  // Put NZP-CSI-RS
+  for (const srsran_csi_rs_nzp_resource_t& nzp_csi_rs : dl_sched_ptr->nzp_csi_rs) {
+    if (srsran_gnb_dl_nzp_csi_rs_put(&gnb_dl, &dl_slot_cfg, &nzp_csi_rs) < SRSRAN_SUCCESS) {
+      logger.error("NZP-CSI-RS: Error putting signal");
+      return false;
+    }
+  }
+
+  // Generate baseband signal
+  srsran_gnb_dl_gen_signal(&gnb_dl);
+
+  // Add SSB to the baseband signal
+  for (const stack_interface_phy_nr::ssb_t& ssb : dl_sched_ptr->ssb) {
+    if (srsran_gnb_dl_add_ssb(&gnb_dl, &ssb.pbch_msg, dl_slot_cfg.idx) < SRSRAN_SUCCESS) {
+      logger.error("SSB: Error putting signal");
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void slot_worker::put_pdsch_jobs(uint32_t encoder_idx)
+{
+  uint32_t i = next_pdsch.fetch_add(1, std::memory_order_relaxed);
+  while (i < (uint32_t)pdsch_sched->pdsch.size()) {
+    const stack_interface_phy_nr::pdsch_t& pdsch = pdsch_sched->pdsch[i];
+
     // convert MAC to PHY buffer data structures
     uint8_t* data[SRSRAN_MAX_TB] = {};
-    for (uint32_t i = 0; i < SRSRAN_MAX_TB; ++i) {
-      if (pdsch.data[i] != nullptr) {
-        data[i] = pdsch.data[i]->msg;
+    for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; ++tb) {
+      if (pdsch.data[tb] != nullptr) {
+        data[tb] = pdsch.data[tb]->msg;
       }
     }
 
-    // Put PDSCH message
-    if (srsran_gnb_dl_pdsch_put(&gnb_dl, &dl_slot_cfg, &pdsch.sch, data) < SRSRAN_SUCCESS) {
+    // Put PDSCH message, the grants of different PDSCH do not overlap
+    if (srsran_gnb_dl_pdsch_put_encoder(&gnb_dl, encoder_idx, &dl_slot_cfg, &pdsch.sch, data) < SRSRAN_SUCCESS) {
       logger.error("PDSCH: Error putting DL message");
-      return false;
+      pdsch_error.store(true, std::memory_order_relaxed);
     }
+    pdsch_encoder[i] = encoder_idx;
 
-    // Log PDSCH information
-    if (logger.info.enabled()) {
-      std::array<char, 512> str = {};
-      srsran_gnb_dl_pdsch_info(&gnb_dl, &pdsch.sch, str.data(), (uint32_t)str.size());
+    i = next_pdsch.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+bool slot_worker::put_pdsch(const stack_interface_phy_nr::dl_sched_t& dl_sched)
+{
+  uint32_t nof_pdsch = (uint32_t)dl_sched.pdsch.size();
+  pdsch_sched        = &dl_sched;
+  next_pdsch.store(0, std::memory_order_relaxed);
+  next_pdsch_encoder.store(1, std::memory_order_relaxed);
+  pdsch_error.store(false, std::memory_order_relaxed);
+
+  // Dispatch a task with its own encoder for each PDSCH beyond the first one, while there are encoders left
+  uint32_t nof_tasks = 0;
+  if (task_pool != nullptr and nof_pdsch > 1) {
+    nof_tasks = SRSRAN_MIN(gnb_dl.nof_pdsch_encoders, nof_pdsch) - 1;
+  }
+  if (nof_tasks > 0) {
+    uint32_t run = open_task_group(pdsch_tasks);
+    for (uint32_t i = 0; i < nof_tasks; i++) {
+      task_pool->push_task([this, run]() {
+        if (not enter_task_group(pdsch_tasks, run)) {
+          return;
+        }
+        put_pdsch_jobs(next_pdsch_encoder.fetch_add(1, std::memory_order_relaxed));
+        leave_task_group(pdsch_tasks);
+      });
+    }
+  }
+
+  // The worker thread encodes too, and waits for the tasks that started meanwhile
+  put_pdsch_jobs(0);
+  if (nof_tasks > 0) {
+    close_task_group(pdsch_tasks);
+  }
+
+  if (pdsch_error.load(std::memory_order_relaxed)) {
+    return false;
+  }
+
+  // Log PDSCH information
+  if (logger.info.enabled()) {
+    for (uint32_t i = 0; i < nof_pdsch; i++) {
+      const stack_interface_phy_nr::pdsch_t& pdsch = dl_sched.pdsch[i];
+      std::array<char, 512>                  str   = {};
+      srsran_gnb_dl_pdsch_encoder_info(&gnb_dl, pdsch_encoder[i], &pdsch.sch, str.data(), (uint32_t)str.size());
 
       if (logger.debug.enabled()) {
         std::array<char, 1024> str_extra = {};
@@ -379,30 +499,52 @@ bool slot_worker::work_dl()
     }
   }
 
-  // Put NZP-CSI-RS
-  for (const srsran_csi_rs_nzp_resource_t& nzp_csi_rs : dl_sched_ptr->nzp_csi_rs) {
-    if (srsran_gnb_dl_nzp_csi_rs_put(&gnb_dl, &dl_slot_cfg, &nzp_csi_rs) < SRSRAN_SUCCESS) {
-      logger.error("NZP-CSI-RS: Error putting signal");
-      return false;
-    }
+  return true;
+}
+
+bool slot_worker::work_dl_ul_concurrent()
+{
+  // The next worker overwrites the UL scheduling results of this slot as soon as this worker releases the scheduler
+  // synchronization, so the UL task works on a copy
+  stack_interface_phy_nr::ul_sched_t* ul_sched_ptr = stack.get_ul_sched(ul_slot_cfg);
+  if (ul_sched_ptr == nullptr) {
+    logger.error("Error retrieving UL scheduling");
+    sync.wait(this);
+    sync.release();
+    return false;
   }
+  ul_sched = *ul_sched_ptr;
+
+  // Process uplink in a task
+  ul_claimed.store(false, std::memory_order_relaxed);
+  ul_result    = false;
+  uint32_t run = open_task_group(ul_tasks);
+  task_pool->push_task([this, run]() {
+    if (not enter_task_group(ul_tasks, run)) {
+      return;
+    }
+    if (not ul_claimed.exchange(true)) {
+      ul_result = work_ul(&ul_sched);
+    }
+    leave_task_group(ul_tasks);
+  });
 
-  // Generate baseband signal
-  srsran_gnb_dl_gen_signal(&gnb_dl);
+  // Process downlink meanwhile
+  bool dl_result = work_dl();
 
-  // Add SSB to the baseband signal
-  for (const stack_interface_phy_nr::ssb_t& ssb : dl_sched_ptr->ssb) {
-    if (srsran_gnb_dl_add_ssb(&gnb_dl, &ssb.pbch_msg, dl_slot_cfg.idx) < SRSRAN_SUCCESS) {
-      logger.error("SSB: Error putting signal");
-      return false;
-    }
+  // Process uplink here if the task did not start yet, otherwise wait for it
+  if (not ul_claimed.exchange(true)) {
+    ul_result = work_ul(&ul_sched);
   }
+  close_task_group(ul_tasks);
 
-  return true;
+  return dl_result and ul_result;
 }
 
 void slot_worker::work_imp()
 {
+  std::chrono::steady_clock::time_point t_start = std::chrono::steady_clock::now();
+
   // Inform Scheduler about new slot
   stack.slot_indication(dl_slot_cfg);
 
@@ -414,22 +556,34 @@ void slot_worker::work_imp()
     tx_rf_buffer.set(rf_port, a, nof_ant, tx_buffer[a]);
   }
 
-  // Process uplink
-  if (not work_ul()) {
+  bool ret = false;
+  if (task_pool != nullptr) {
+    // Process uplink and downlink concurrently
+    ret = work_dl_ul_concurrent();
+  } else if (not work_ul(stack.get_ul_sched(ul_slot_cfg))) {
     // Wait and release synchronization
     sync.wait(this);
     sync.release();
-    common.worker_end(context, false, tx_rf_buffer);
-    return;
+  } else {
+    // Process downlink
+    ret = work_dl();
   }
 
-  // Process downlink
-  if (not work_dl()) {
-    common.worker_end(context, false, tx_rf_buffer);
-    return;
+  // Measure the slot latency, the transmission itself waits for the previous slots
+  {
+    double latency_us = std::chrono::duration_cast<std::chrono::duration<double, std::micro> >(
+                            std::chrono::steady_clock::now() - t_start)
+                            .count();
+    std::lock_guard<std::mutex> lock(metrics_mutex);
+    metrics.nof_slots++;
+    metrics.avg_slot_latency_us += (latency_us - metrics.avg_slot_latency_us) / metrics.nof_slots;
+    metrics.max_slot_latency_us = SRSRAN_MAX(metrics.max_slot_latency_us, latency_us);
   }
 
-  common.worker_end(context, true, tx_rf_buffer);
+  common.worker_end(context, ret, tx_rf_buffer);
+  if (not ret) {
+    return;
+  }
 
 #ifdef DEBUG_WRITE_FILE
   if (num_slots++ < slots_to_dump) {
@@ -53,6 +53,12 @@ bool worker_pool::init(const args_t& args, const phy_cell_cfg_list_nr_t& cell_li
   srslog::basic_levels log_level = srslog::str_to_basic_level(args.log.phy_level);
   logger.set_level(log_level);
 
+  // Threads shared by all workers for processing the UL concurrently with the DL and encoding PDSCH in parallel
+  if (args.nof_slot_threads > 0) {
+    task_pool = std::unique_ptr<srsran::task_thread_pool>(new srsran::task_thread_pool(args.nof_slot_threads, true));
+    task_pool->start(args.prio);
+  }
+
   // Add workers to workers pool and start threads
   for (uint32_t i = 0; i < args.nof_phy_threads; i++) {
     auto& log = srslog::fetch_basic_logger(fmt::format("{}PHY{}-NR", args.log.id_preamble, i), log_sink);
@@ -73,6 +79,8 @@ bool worker_pool::init(const args_t& args, const phy_cell_cfg_list_nr_t& cell_li
     w_args.srate_hz                = srate_hz;
     w_args.pusch_max_its           = args.pusch_max_its;
     w_args.pusch_min_snr_dB        = args.pusch_min_snr_dB;
+    w_args.task_pool               = task_pool.get();
+    w_args.nof_pdsch_encoders      = SRSRAN_MIN(1 + args.nof_slot_threads, SRSRAN_GNB_DL_MAX_PDSCH_ENCODERS);
 
     if (not w->init(w_args)) {
       return false;
@@ -114,6 +122,27 @@ void worker_pool::stop()
 {
   pool.stop();
   prach.stop();
+
+  // Stop the slot threads after the workers, which could be waiting for them
+  if (task_pool != nullptr) {
+    task_pool->stop();
+  }
+}
+
+slot_worker::metrics_t worker_pool::get_metrics()
+{
+  slot_worker::metrics_t ret = {};
+  for (auto& w : workers) {
+    slot_worker::metrics_t m = w->get_metrics();
+    if (m.nof_slots == 0) {
+      continue;
+    }
+    ret.avg_slot_latency_us =
+        (ret.avg_slot_latency_us * ret.nof_slots + m.avg_slot_latency_us * m.nof_slots) / (ret.nof_slots + m.nof_slots);
+    ret.max_slot_latency_us = SRSRAN_MAX(ret.max_slot_latency_us, m.max_slot_latency_us);
+    ret.nof_slots += m.nof_slots;
+  }
+  return ret;
 }
 
 int worker_pool::set_common_cfg(const phy_interface_rrc_nr::common_cfg_t& common_cfg)
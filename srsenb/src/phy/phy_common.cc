@@ -21,6 +21,7 @@
 
 #include "srsenb/hdr/phy/txrx.h"
 #include "srsran/common/threads.h"
+#include "srsran/phy/ch_estimation/wiener_ul.h"
 #include "srsran/phy/channel/channel.h"
 #include <sstream>
 
@@ -56,12 +57,17 @@ bool phy_common::init(const phy_cell_cfg_list_t&    cell_list_,
   // Instantiate DL channel emulator
   if (params.dl_channel_args.enable) {
     int channel_prbs = (cell_list_lte.empty()) ? cell_list_nr[0].carrier.nof_prb : cell_list_lte[0].cell.nof_prb;
-    dl_channel = srsran::channel_ptr(
-        new srsran::channel(params.dl_channel_args, get_nof_rf_channels(), srslog::fetch_basic_logger("PHY")));
+    dl_channel = srsran::channel_ptr(new srsran::channel(
+        params.dl_channel_args, get_nof_rf_channels(), srslog::fetch_basic_logger("PHY"), get_nof_ports(0)));
     dl_channel->set_srate((uint32_t)srsran_sampling_freq_hz(channel_prbs));
     dl_channel->set_signal_power_dBfs(srsran_enb_dl_get_maximum_signal_power_dBfs(channel_prbs));
   }
 
+  // The PUSCH Wiener filters are shared by all the workers, compute them before the first estimate
+  if (params.pusch_wiener && srsran_wiener_ul_get_default() == nullptr) {
+    srslog::fetch_basic_logger("PHY").error("Error computing the PUSCH Wiener filters, using pilot averaging");
+  }
+
   // Create grants
   for (auto& q : ul_grants) {
     q.resize(cell_list_lte.size());
@@ -64,8 +64,10 @@ bool txrx::init(enb_time_interface*          enb_,
 
   // Instantiate UL channel emulator
   if (worker_com->params.ul_channel_args.enable) {
-    ul_channel = srsran::channel_ptr(
-        new srsran::channel(worker_com->params.ul_channel_args, worker_com->get_nof_rf_channels(), logger));
+    srsran::channel::args_t ul_channel_args = worker_com->params.ul_channel_args;
+    ul_channel_args.fading_uplink           = true;
+    ul_channel = srsran::channel_ptr(new srsran::channel(
+        ul_channel_args, worker_com->get_nof_rf_channels(), logger, worker_com->get_nof_ports(0)));
   }
 
   start(prio_);
@@ -185,11 +187,16 @@ void txrx::run_thread()
       }
     }
 
-    buffer.set_nof_samples(sf_len);
+    // In LTE-only configurations the UL subframe can be received slot by slot, so the worker demodulates the first slot
+    // while the second is still being received
+    bool     ul_slot_streaming = worker_com->params.ul_slot_streaming and lte_worker != nullptr and nr_worker == nullptr;
+    uint32_t rx_len            = ul_slot_streaming ? sf_len / SRSRAN_NOF_SLOTS_PER_SF : sf_len;
+
+    buffer.set_nof_samples(rx_len);
     radio_h->rx_now(buffer, timestamp);
 
     if (ul_channel) {
-      ul_channel->run(buffer.to_cf_t(), buffer.to_cf_t(), sf_len, timestamp.get(0));
+      ul_channel->run(buffer.to_cf_t(), buffer.to_cf_t(), rx_len, timestamp.get(0));
     }
 
     // Compute TX time: Any transmission happens in TTI+4 thus advance 4 ms the reception time
@@ -201,11 +208,6 @@ void txrx::run_thread()
           timestamp.get(0).frac_secs,
           lte_worker ? lte_worker->get_id() : 0);
 
-    // Trigger prach worker execution
-    for (uint32_t cc = 0; cc < worker_com->get_nof_carriers_lte(); cc++) {
-      prach->new_tti(cc, tti, buffer.get(worker_com->get_rf_port(cc), 0, worker_com->get_nof_ports(0)));
-    }
-
     // Set NR worker context and start
     if (nr_worker != nullptr) {
       srsran::phy_common_interface::worker_context_t context;
@@ -230,12 +232,41 @@ void txrx::run_thread()
       context.tx_time.copy(timestamp);
 
       lte_worker->set_context(context);
+      if (ul_slot_streaming) {
+        lte_worker->set_nof_rx_slots(1);
+      }
 
       // Start LTE worker processing
       worker_com->semaphore.push(lte_worker);
       lte_workers->start_worker(lte_worker);
     }
 
+    // Receive the remaining slots of the subframe while the LTE worker demodulates the previous ones
+    if (ul_slot_streaming) {
+      srsran::rf_buffer_t    slot_buffer    = {};
+      srsran::rf_timestamp_t slot_timestamp = {};
+      for (uint32_t slot_idx = 1; slot_idx < SRSRAN_NOF_SLOTS_PER_SF; slot_idx++) {
+        for (uint32_t ch = 0; ch < SRSRAN_MAX_CHANNELS; ch++) {
+          cf_t* ptr = buffer.get(ch);
+          slot_buffer.set(ch, ptr != nullptr ? ptr + slot_idx * rx_len : nullptr);
+        }
+        slot_buffer.set_nof_samples(rx_len);
+        radio_h->rx_now(slot_buffer, slot_timestamp);
+
+        if (ul_channel) {
+          ul_channel->run(slot_buffer.to_cf_t(), slot_buffer.to_cf_t(), rx_len, slot_timestamp.get(0));
+        }
+
+        // The worker is released even if the reception failed, otherwise it would block forever
+        lte_worker->set_nof_rx_slots(slot_idx + 1);
+      }
+    }
+
+    // Trigger prach worker execution
+    for (uint32_t cc = 0; cc < worker_com->get_nof_carriers_lte(); cc++) {
+      prach->new_tti(cc, tti, buffer.get(worker_com->get_rf_port(cc), 0, worker_com->get_nof_ports(0)));
+    }
+
     // Advance in time
     enb->tti_clock();
   }
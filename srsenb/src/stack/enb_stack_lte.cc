@@ -43,6 +43,7 @@ enb_stack_lte::enb_stack_lte(srslog::sink& log_sink) :
   stack_logger(srslog::fetch_basic_logger("STCK", log_sink, false)),
   task_sched(512, 128),
   pdcp(&task_sched, pdcp_logger),
+  up_workers(&task_sched, pdcp_logger),
   mac(&task_sched, mac_logger),
   rlc(rlc_logger),
   gtpu(&task_sched, gtpu_logger, &get_rx_io_manager()),
@@ -100,7 +101,7 @@ int enb_stack_lte::init(const stack_args_t&      args_,
 
   // Set up pcap and trace
   if (args.mac_pcap.enable) {
-    mac_pcap.open(args.mac_pcap.filename);
+    mac_pcap.open(args.mac_pcap.filename, 0, args.mac_pcap.file_args);
     mac.start_pcap(&mac_pcap);
   }
 
@@ -125,17 +126,32 @@ int enb_stack_lte::init(const stack_args_t&      args_,
     x2_task_queue = task_sched.make_task_queue();
   }
 
+  // In the sharded user-plane mode, the PDCP of every UE runs in the worker selected by its RNTI
+  pdcp_interface_rlc*  pdcp_rlc  = &pdcp;
+  pdcp_interface_gtpu* pdcp_gtpu = &pdcp;
+  pdcp_interface_rrc*  pdcp_rrc  = &pdcp;
+  if (args.nof_up_workers > 0) {
+    pdcp_rlc  = &up_workers;
+    pdcp_gtpu = &up_workers;
+    pdcp_rrc  = &up_workers;
+  }
+
   // setup bearer managers
-  gtpu_adapter.reset(new gtpu_pdcp_adapter(stack_logger, &pdcp, x2_, &gtpu, bearers));
+  gtpu_adapter.reset(new gtpu_pdcp_adapter(stack_logger, pdcp_gtpu, x2_, &gtpu, bearers));
 
   // Init all LTE layers
   if (!mac.init(args.mac, rrc_cfg.cell_list, phy, &rlc, &rrc)) {
     stack_logger.error("Couldn't initialize MAC");
     return SRSRAN_ERROR;
   }
-  rlc.init(&pdcp, &rrc, &mac, task_sched.get_timer_handler());
-  pdcp.init(&rlc, &rrc, gtpu_adapter.get());
-  if (rrc.init(rrc_cfg, phy, &mac, &rlc, &pdcp, &s1ap, &gtpu, x2_) != SRSRAN_SUCCESS) {
+  // RLC users are sharded like the user-plane workers, so that each worker only takes the lock of its own shard
+  rlc.init(pdcp_rlc, &rrc, &mac, task_sched.get_timer_handler(), args.nof_up_workers);
+  if (args.nof_up_workers > 0) {
+    up_workers.init(args.nof_up_workers, &rlc, &rrc, gtpu_adapter.get());
+  } else {
+    pdcp.init(&rlc, &rrc, gtpu_adapter.get());
+  }
+  if (rrc.init(rrc_cfg, phy, &mac, &rlc, pdcp_rrc, &s1ap, &gtpu, x2_) != SRSRAN_SUCCESS) {
     stack_logger.error("Couldn't initialize RRC");
     return SRSRAN_ERROR;
   }
@@ -172,6 +188,7 @@ void enb_stack_lte::tti_clock()
 void enb_stack_lte::tti_clock_impl()
 {
   task_sched.tic();
+  up_workers.tic();
   rrc.tti_clock();
 }
 
@@ -190,6 +207,7 @@ void enb_stack_lte::stop_impl()
   s1ap.stop();
   gtpu.stop();
   mac.stop();
+  up_workers.stop();
   rlc.stop();
   pdcp.stop();
   rrc.stop();
@@ -220,10 +238,19 @@ bool enb_stack_lte::get_metrics(stack_metrics_t* metrics)
     mac.get_metrics(metrics.mac);
     if (not metrics.mac.ues.empty()) {
       rlc.get_metrics(metrics.rlc, metrics.mac.ues[0].nof_tti);
-      pdcp.get_metrics(metrics.pdcp, metrics.mac.ues[0].nof_tti);
+      if (up_workers.nof_workers() > 0) {
+        up_workers.get_metrics(metrics.pdcp, metrics.mac.ues[0].nof_tti);
+      } else {
+        pdcp.get_metrics(metrics.pdcp, metrics.mac.ues[0].nof_tti);
+      }
     }
     rrc.get_metrics(metrics.rrc);
     s1ap.get_metrics(metrics.s1ap);
+    if (args.mac_pcap.enable) {
+      mac_pcap.get_metrics(metrics.pcap);
+    } else if (args.mac_pcap_net.enable) {
+      mac_pcap_net.get_metrics(metrics.pcap);
+    }
     if (not pending_stack_metrics.try_push(metrics)) {
       stack_logger.error("Unable to push metrics to queue");
     }
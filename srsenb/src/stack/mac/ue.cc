@@ -300,6 +300,23 @@ uint32_t ue::set_ta(int ta_)
   return nof_cmd;
 }
 
+/**
+ * A slice of the TB keeps the whole TB allocated, e.g. while RLC AM waits for a missing PDU. SDUs much smaller than the
+ * TB, and all of them when the byte buffer pool is running out of buffers, are copied into their own buffer instead.
+ */
+static srsran::byte_buffer_slice
+make_sdu_slice(const srsran::byte_buffer_slice& tb, uint8_t* sdu, uint32_t nof_bytes, bool pool_low)
+{
+  const uint32_t min_tb_fraction = 8;
+  if (pool_low or nof_bytes * min_tb_fraction < tb.size()) {
+    srsran::byte_buffer_slice copy = srsran::retain_slice(srsran::byte_buffer_slice(nullptr, sdu, nof_bytes));
+    if (copy.size() == nof_bytes) {
+      return copy;
+    }
+  }
+  return tb.subslice(sdu - tb.data(), nof_bytes);
+}
+
 void ue::process_pdu(srsran::unique_byte_buffer_t pdu, uint32_t ue_cc_idx, uint32_t grant_nof_prbs)
 {
   // Unpack ULSCH MAC PDU
@@ -323,6 +340,11 @@ void ue::process_pdu(srsran::unique_byte_buffer_t pdu, uint32_t ue_cc_idx, uint3
   uint32_t lcid_most_data = 0;
   int      most_data      = -99;
 
+  // The SDUs are passed to RLC as slices of the TB, which is freed once RLC no longer needs any of them
+  srsran::byte_buffer_slice tb       = srsran::make_shared_slice(std::move(pdu));
+  srsran::byte_buffer_pool* pool     = srsran::byte_buffer_pool::get_instance();
+  bool                      pool_low = pool->nof_available_blocks() < pool->size() / 4;
+
   while (mac_msg_ul.next()) {
     assert(mac_msg_ul.get());
     if (mac_msg_ul.get()->is_sdu()) {
@@ -343,10 +365,10 @@ void ue::process_pdu(srsran::unique_byte_buffer_t pdu, uint32_t ue_cc_idx, uint3
       }
 
       if (route_pdu) {
-        rlc->write_pdu(rnti,
-                       mac_msg_ul.get()->get_sdu_lcid(),
-                       mac_msg_ul.get()->get_sdu_ptr(),
-                       mac_msg_ul.get()->get_payload_size());
+        rlc->write_pdu_slice(
+            rnti,
+            mac_msg_ul.get()->get_sdu_lcid(),
+            make_sdu_slice(tb, mac_msg_ul.get()->get_sdu_ptr(), mac_msg_ul.get()->get_payload_size(), pool_low));
       }
 
       // Indicate scheduler to update BSR counters
@@ -355,7 +377,7 @@ void ue::process_pdu(srsran::unique_byte_buffer_t pdu, uint32_t ue_cc_idx, uint3
       // Indicate DRB activity in UL to RRC
       if (mac_msg_ul.get()->get_sdu_lcid() > 2) {
         rrc->set_activity_user(rnti);
-        logger.debug("UL activity rnti=0x%x, n_bytes=%d", rnti, pdu->size());
+        logger.debug("UL activity rnti=0x%x, n_bytes=%d", rnti, tb.size());
       }
 
       if ((int)mac_msg_ul.get()->get_payload_size() > most_data) {
@@ -276,4 +276,11 @@ void pdcp::get_metrics(pdcp_metrics_t& m, const uint32_t nof_tti)
   }
 }
 
+void pdcp::get_ue_metrics(std::map<uint16_t, srsran::pdcp_metrics_t>& ue_metrics, const uint32_t nof_tti)
+{
+  for (auto& user : users) {
+    user.second.pdcp->get_metrics(ue_metrics[user.first], nof_tti);
+  }
+}
+
 } // namespace srsenb
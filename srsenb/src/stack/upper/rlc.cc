@@ -30,168 +30,193 @@ namespace srsenb {
 void rlc::init(pdcp_interface_rlc*    pdcp_,
                rrc_interface_rlc*     rrc_,
                mac_interface_rlc*     mac_,
-               srsran::timer_handler* timers_)
+               srsran::timer_handler* timers_,
+               uint32_t               nof_user_shards)
 {
   pdcp   = pdcp_;
   rrc    = rrc_;
   mac    = mac_;
   timers = timers_;
 
-  pthread_rwlock_init(&rwlock, nullptr);
+  // The shards are never resized after this point, so their locks do not move
+  shards = std::vector<user_shard>(std::max(nof_user_shards, 1U));
+  for (auto& shard : shards) {
+    pthread_rwlock_init(&shard.rwlock, nullptr);
+  }
 }
 
 void rlc::stop()
 {
-  pthread_rwlock_wrlock(&rwlock);
-  for (auto& user : users) {
-    user.second.rlc->stop();
+  for (auto& shard : shards) {
+    pthread_rwlock_wrlock(&shard.rwlock);
+    for (auto& user : shard.users) {
+      user.second.rlc->stop();
+    }
+    shard.users.clear();
+    pthread_rwlock_unlock(&shard.rwlock);
+    pthread_rwlock_destroy(&shard.rwlock);
   }
-  users.clear();
-  pthread_rwlock_unlock(&rwlock);
-  pthread_rwlock_destroy(&rwlock);
 }
 
 void rlc::get_metrics(rlc_metrics_t& m, const uint32_t nof_tti)
 {
-  m.ues.resize(users.size());
+  // Report the users ordered by RNTI, regardless of their shard
+  std::map<uint32_t, user_interface*> sorted_users;
+  for (auto& shard : shards) {
+    for (auto& user : shard.users) {
+      sorted_users.emplace(user.first, &user.second);
+    }
+  }
+  m.ues.resize(sorted_users.size());
   size_t count = 0;
-  for (auto& user : users) {
-    user.second.rlc->get_metrics(m.ues[count], nof_tti);
+  for (auto& user : sorted_users) {
+    user.second->rlc->get_metrics(m.ues[count], nof_tti);
     count++;
   }
 }
 
 void rlc::add_user(uint16_t rnti)
 {
-  pthread_rwlock_wrlock(&rwlock);
-  if (users.count(rnti) == 0) {
+  user_shard& shard = get_shard(rnti);
+  pthread_rwlock_wrlock(&shard.rwlock);
+  if (shard.users.count(rnti) == 0) {
     auto obj = make_rnti_obj<srsran::rlc>(rnti, logger.id().c_str());
-    obj->init(&users[rnti],
-              &users[rnti],
+    obj->init(&shard.users[rnti],
+              &shard.users[rnti],
               timers,
               srb_to_lcid(lte_srb::srb0),
               [rnti, this](uint32_t lcid, uint32_t tx_queue, uint32_t retx_queue) {
                 update_bsr(rnti, lcid, tx_queue, retx_queue);
               });
-    users[rnti].rnti   = rnti;
-    users[rnti].pdcp   = pdcp;
-    users[rnti].rrc    = rrc;
-    users[rnti].rlc    = std::move(obj);
-    users[rnti].parent = this;
+    shard.users[rnti].rnti   = rnti;
+    shard.users[rnti].pdcp   = pdcp;
+    shard.users[rnti].rrc    = rrc;
+    shard.users[rnti].rlc    = std::move(obj);
+    shard.users[rnti].parent = this;
   }
-  pthread_rwlock_unlock(&rwlock);
+  pthread_rwlock_unlock(&shard.rwlock);
 }
 
 void rlc::rem_user(uint16_t rnti)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
-    users[rnti].rlc->stop();
+  user_shard& shard = get_shard(rnti);
+  pthread_rwlock_rdlock(&shard.rwlock);
+  if (shard.users.count(rnti)) {
+    shard.users[rnti].rlc->stop();
   } else {
     logger.error("Removing rnti=0x%x. Already removed", rnti);
   }
-  pthread_rwlock_unlock(&rwlock);
+  pthread_rwlock_unlock(&shard.rwlock);
 
-  pthread_rwlock_wrlock(&rwlock);
-  users.erase(rnti);
-  pthread_rwlock_unlock(&rwlock);
+  pthread_rwlock_wrlock(&shard.rwlock);
+  shard.users.erase(rnti);
+  pthread_rwlock_unlock(&shard.rwlock);
 }
 
 void rlc::clear_buffer(uint16_t rnti)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
-    users[rnti].rlc->empty_queue();
+  user_shard& shard = get_shard(rnti);
+  pthread_rwlock_rdlock(&shard.rwlock);
+  if (shard.users.count(rnti)) {
+    shard.users[rnti].rlc->empty_queue();
     for (int i = 0; i < SRSRAN_N_RADIO_BEARERS; i++) {
-      if (users[rnti].rlc->has_bearer(i)) {
+      if (shard.users[rnti].rlc->has_bearer(i)) {
         mac->rlc_buffer_state(rnti, i, 0, 0);
       }
     }
     logger.info("Cleared buffer rnti=0x%x", rnti);
   }
-  pthread_rwlock_unlock(&rwlock);
+  pthread_rwlock_unlock(&shard.rwlock);
 }
 
 void rlc::add_bearer(uint16_t rnti, uint32_t lcid, srsran::rlc_config_t cnfg)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
-    users[rnti].rlc->add_bearer(lcid, cnfg);
+  user_shard& shard = get_shard(rnti);
+  pthread_rwlock_rdlock(&shard.rwlock);
+  if (shard.users.count(rnti)) {
+    shard.users[rnti].rlc->add_bearer(lcid, cnfg);
   }
-  pthread_rwlock_unlock(&rwlock);
+  pthread_rwlock_unlock(&shard.rwlock);
 }
 
 void rlc::add_bearer_mrb(uint16_t rnti, uint32_t lcid)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
-    users[rnti].rlc->add_bearer_mrb(lcid);
+  user_shard& shard = get_shard(rnti);
+  pthread_rwlock_rdlock(&shard.rwlock);
+  if (shard.users.count(rnti)) {
+    shard.users[rnti].rlc->add_bearer_mrb(lcid);
   }
-  pthread_rwlock_unlock(&rwlock);
+  pthread_rwlock_unlock(&shard.rwlock);
 }
 
 bool rlc::has_bearer(uint16_t rnti, uint32_t lcid)
 {
-  pthread_rwlock_rdlock(&rwlock);
+  user_shard& shard = get_shard(rnti);
+  pthread_rwlock_rdlock(&shard.rwlock);
   bool result = false;
-  if (users.count(rnti)) {
-    result = users[rnti].rlc->has_bearer(lcid);
+  if (shard.users.count(rnti)) {
+    result = shard.users[rnti].rlc->has_bearer(lcid);
   }
-  pthread_rwlock_unlock(&rwlock);
+  pthread_rwlock_unlock(&shard.rwlock);
   return result;
 }
 
 void rlc::del_bearer(uint16_t rnti, uint32_t lcid)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
-    users[rnti].rlc->del_bearer(lcid);
+  user_shard& shard = get_shard(rnti);
+  pthread_rwlock_rdlock(&shard.rwlock);
+  if (shard.users.count(rnti)) {
+    shard.users[rnti].rlc->del_bearer(lcid);
   }
-  pthread_rwlock_unlock(&rwlock);
+  pthread_rwlock_unlock(&shard.rwlock);
 }
 
 bool rlc::suspend_bearer(uint16_t rnti, uint32_t lcid)
 {
-  pthread_rwlock_rdlock(&rwlock);
+  user_shard& shard = get_shard(rnti);
+  pthread_rwlock_rdlock(&shard.rwlock);
   bool result = false;
-  if (users.count(rnti)) {
-    users[rnti].rlc->suspend_bearer(lcid);
+  if (shard.users.count(rnti)) {
+    shard.users[rnti].rlc->suspend_bearer(lcid);
     result = true;
   }
-  pthread_rwlock_unlock(&rwlock);
+  pthread_rwlock_unlock(&shard.rwlock);
   return result;
 }
 
 bool rlc::is_suspended(uint16_t rnti, uint32_t lcid)
 {
-  pthread_rwlock_rdlock(&rwlock);
+  user_shard& shard = get_shard(rnti);
+  pthread_rwlock_rdlock(&shard.rwlock);
   bool result = false;
-  if (users.count(rnti)) {
-    result = users[rnti].rlc->is_suspended(lcid);
+  if (shard.users.count(rnti)) {
+    result = shard.users[rnti].rlc->is_suspended(lcid);
   }
-  pthread_rwlock_unlock(&rwlock);
+  pthread_rwlock_unlock(&shard.rwlock);
   return result;
 }
 
 bool rlc::resume_bearer(uint16_t rnti, uint32_t lcid)
 {
-  pthread_rwlock_rdlock(&rwlock);
+  user_shard& shard = get_shard(rnti);
+  pthread_rwlock_rdlock(&shard.rwlock);
   bool result = false;
-  if (users.count(rnti)) {
-    users[rnti].rlc->resume_bearer(lcid);
+  if (shard.users.count(rnti)) {
+    shard.users[rnti].rlc->resume_bearer(lcid);
     result = true;
   }
-  pthread_rwlock_unlock(&rwlock);
+  pthread_rwlock_unlock(&shard.rwlock);
   return result;
 }
 
 void rlc::reestablish(uint16_t rnti)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
-    users[rnti].rlc->reestablish();
+  user_shard& shard = get_shard(rnti);
+  pthread_rwlock_rdlock(&shard.rwlock);
+  if (shard.users.count(rnti)) {
+    shard.users[rnti].rlc->reestablish();
   }
-  pthread_rwlock_unlock(&rwlock);
+  pthread_rwlock_unlock(&shard.rwlock);
 }
 
 // In the eNodeB, there is no polling for buffer state from the scheduler.
@@ -204,72 +229,88 @@ void rlc::update_bsr(uint32_t rnti, uint32_t lcid, uint32_t tx_queue, uint32_t p
 
 int rlc::read_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
 {
+  user_shard& shard = get_shard(rnti);
   int ret;
 
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  pthread_rwlock_rdlock(&shard.rwlock);
+  if (shard.users.count(rnti)) {
     if (rnti != SRSRAN_MRNTI) {
-      ret = users[rnti].rlc->read_pdu(lcid, payload, nof_bytes);
+      ret = shard.users[rnti].rlc->read_pdu(lcid, payload, nof_bytes);
     } else {
-      ret = users[rnti].rlc->read_pdu_mch(lcid, payload, nof_bytes);
+      ret = shard.users[rnti].rlc->read_pdu_mch(lcid, payload, nof_bytes);
     }
   } else {
     ret = SRSRAN_ERROR;
   }
-  pthread_rwlock_unlock(&rwlock);
+  pthread_rwlock_unlock(&shard.rwlock);
   return ret;
 }
 
 void rlc::write_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
-    users[rnti].rlc->write_pdu(lcid, payload, nof_bytes);
+  user_shard& shard = get_shard(rnti);
+  pthread_rwlock_rdlock(&shard.rwlock);
+  if (shard.users.count(rnti)) {
+    shard.users[rnti].rlc->write_pdu(lcid, payload, nof_bytes);
+  }
+  pthread_rwlock_unlock(&shard.rwlock);
+}
+
+void rlc::write_pdu_slice(uint16_t rnti, uint32_t lcid, srsran::byte_buffer_slice pdu)
+{
+  user_shard& shard = get_shard(rnti);
+  pthread_rwlock_rdlock(&shard.rwlock);
+  if (shard.users.count(rnti)) {
+    shard.users[rnti].rlc->write_pdu_slice(lcid, std::move(pdu));
   }
-  pthread_rwlock_unlock(&rwlock);
+  pthread_rwlock_unlock(&shard.rwlock);
 }
 
 void rlc::write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  user_shard& shard = get_shard(rnti);
+  pthread_rwlock_rdlock(&shard.rwlock);
+  if (shard.users.count(rnti)) {
     if (rnti != SRSRAN_MRNTI) {
-      users[rnti].rlc->write_sdu(lcid, std::move(sdu));
+      shard.users[rnti].rlc->write_sdu(lcid, std::move(sdu));
     } else {
-      users[rnti].rlc->write_sdu_mch(lcid, std::move(sdu));
+      shard.users[rnti].rlc->write_sdu_mch(lcid, std::move(sdu));
     }
   }
-  pthread_rwlock_unlock(&rwlock);
+  pthread_rwlock_unlock(&shard.rwlock);
 }
 
 void rlc::discard_sdu(uint16_t rnti, uint32_t lcid, uint32_t discard_sn)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
-    users[rnti].rlc->discard_sdu(lcid, discard_sn);
+  user_shard& shard = get_shard(rnti);
+  pthread_rwlock_rdlock(&shard.rwlock);
+  if (shard.users.count(rnti)) {
+    shard.users[rnti].rlc->discard_sdu(lcid, discard_sn);
   }
-  pthread_rwlock_unlock(&rwlock);
+  pthread_rwlock_unlock(&shard.rwlock);
 }
 
 bool rlc::rb_is_um(uint16_t rnti, uint32_t lcid)
 {
+  user_shard& shard = get_shard(rnti);
   bool ret = false;
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
-    ret = users[rnti].rlc->rb_is_um(lcid);
+  pthread_rwlock_rdlock(&shard.rwlock);
+  if (shard.users.count(rnti)) {
+    ret = shard.users[rnti].rlc->rb_is_um(lcid);
   }
-  pthread_rwlock_unlock(&rwlock);
+  pthread_rwlock_unlock(&shard.rwlock);
   return ret;
 }
 
 bool rlc::sdu_queue_is_full(uint16_t rnti, uint32_t lcid)
 {
+  user_shard& shard = get_shard(rnti);
   bool ret = false;
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
-    ret = users[rnti].rlc->sdu_queue_is_full(lcid);
+  pthread_rwlock_rdlock(&shard.rwlock);
+  if (shard.users.count(rnti)) {
+    ret = shard.users[rnti].rlc->sdu_queue_is_full(lcid);
   }
-  pthread_rwlock_unlock(&rwlock);
+  pthread_rwlock_unlock(&shard.rwlock);
   return ret;
 }
 
@@ -0,0 +1,331 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsenb/hdr/stack/upper/up_workers.h"
+#include <future>
+
+namespace srsenb {
+
+up_workers::worker::worker(uint32_t id, srslog::basic_logger& logger) :
+  thread("UP_WORKER" + std::to_string(id)), task_sched(512, 128), pdcp(&task_sched, logger)
+{
+  queue = task_sched.make_task_queue();
+}
+
+void up_workers::worker::run_thread()
+{
+  while (running.load(std::memory_order_relaxed)) {
+    task_sched.run_next_task();
+    stack_itf.flush_backlog();
+  }
+}
+
+void up_workers::worker::stop()
+{
+  if (not running.load(std::memory_order_relaxed)) {
+    return;
+  }
+  queue.push([this]() {
+    pdcp.stop();
+    running.store(false, std::memory_order_relaxed);
+  });
+  wait_thread_finish();
+  // Destroys the tasks still enqueued, which releases the callers waiting in run_blocking()
+  task_sched.stop();
+}
+
+up_workers::up_workers(srsran::task_sched_handle stack_task_sched_, srslog::basic_logger& logger_) :
+  stack_task_sched(stack_task_sched_), logger(logger_)
+{}
+
+up_workers::~up_workers()
+{
+  stop();
+}
+
+void up_workers::init(uint32_t             nof_workers_,
+                      rlc_interface_pdcp*  rlc_,
+                      rrc_interface_pdcp*  rrc_,
+                      gtpu_interface_pdcp* gtpu_)
+{
+  for (uint32_t i = 0; i < nof_workers_; ++i) {
+    workers.emplace_back(new worker(i, logger));
+    worker& w          = *workers.back();
+    w.stack_itf.queue  = stack_task_sched.make_task_queue();
+    w.stack_itf.rrc    = rrc_;
+    w.stack_itf.gtpu   = gtpu_;
+    w.stack_itf.logger = &logger;
+    w.gtpu_itf.stack   = &w.stack_itf;
+    w.pdcp.init(rlc_, &w.stack_itf, &w.gtpu_itf);
+    w.start(WORKER_THREAD_PRIO);
+  }
+  logger.info("Started %d user-plane workers", nof_workers_);
+}
+
+void up_workers::stop()
+{
+  // The workers are kept, so that calls arriving after the stop still find the worker of their RNTI
+  for (auto& w : workers) {
+    w->stop();
+  }
+}
+
+void up_workers::tic()
+{
+  for (auto& w : workers) {
+    // Only the first pending tick enqueues a task, which applies all the ticks accumulated until it runs. The push
+    // may block, but the workers never wait for the stack thread
+    if (w->pending_tics.fetch_add(1, std::memory_order_relaxed) == 0) {
+      worker* w_ptr = w.get();
+      w->queue.push([w_ptr]() {
+        uint32_t nof_tics = w_ptr->pending_tics.exchange(0, std::memory_order_relaxed);
+        for (uint32_t i = 0; i < nof_tics; ++i) {
+          w_ptr->task_sched.tic();
+        }
+      });
+    }
+  }
+}
+
+void up_workers::push_task(uint16_t rnti, srsran::move_task_t task)
+{
+  get_worker(rnti).queue.push(std::move(task));
+}
+
+template <typename R, typename F>
+R up_workers::run_blocking(worker& w, R default_ret, F&& func)
+{
+  if (not w.is_running()) {
+    return default_ret;
+  }
+  // The task owns the promise. If the worker stops before running it, the task is destroyed and the promise broken
+  std::promise<R> result;
+  std::future<R>  fut = result.get_future();
+  w.queue.push([result = std::move(result), &func]() mutable { result.set_value(func()); });
+  try {
+    return fut.get();
+  } catch (const std::future_error&) {
+    logger.warning("User-plane worker stopped before running the task");
+    return default_ret;
+  }
+}
+
+/*******************************************************************************
+  PDCP interfaces. The calls are forwarded to the worker owning the RNTI
+*******************************************************************************/
+
+void up_workers::write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu)
+{
+  worker* w    = &get_worker(rnti);
+  auto    task = [w, rnti, lcid](srsran::unique_byte_buffer_t& pdu) { w->pdcp.write_pdu(rnti, lcid, std::move(pdu)); };
+  push_task(rnti, std::bind(task, std::move(pdu)));
+}
+
+void up_workers::notify_delivery(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns)
+{
+  worker* w = &get_worker(rnti);
+  push_task(rnti, [w, rnti, lcid, pdcp_sns]() { w->pdcp.notify_delivery(rnti, lcid, pdcp_sns); });
+}
+
+void up_workers::notify_failure(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns)
+{
+  worker* w = &get_worker(rnti);
+  push_task(rnti, [w, rnti, lcid, pdcp_sns]() { w->pdcp.notify_failure(rnti, lcid, pdcp_sns); });
+}
+
+void up_workers::set_enabled(uint16_t rnti, uint32_t lcid, bool enabled)
+{
+  worker* w = &get_worker(rnti);
+  push_task(rnti, [w, rnti, lcid, enabled]() { w->pdcp.set_enabled(rnti, lcid, enabled); });
+}
+
+void up_workers::reset(uint16_t rnti)
+{
+  worker* w = &get_worker(rnti);
+  push_task(rnti, [w, rnti]() { w->pdcp.reset(rnti); });
+}
+
+void up_workers::add_user(uint16_t rnti)
+{
+  worker* w = &get_worker(rnti);
+  push_task(rnti, [w, rnti]() { w->pdcp.add_user(rnti); });
+}
+
+void up_workers::rem_user(uint16_t rnti)
+{
+  worker* w = &get_worker(rnti);
+  push_task(rnti, [w, rnti]() { w->pdcp.rem_user(rnti); });
+}
+
+void up_workers::write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu, int pdcp_sn)
+{
+  worker* w    = &get_worker(rnti);
+  auto    task = [w, rnti, lcid, pdcp_sn](srsran::unique_byte_buffer_t& sdu) {
+    w->pdcp.write_sdu(rnti, lcid, std::move(sdu), pdcp_sn);
+  };
+  push_task(rnti, std::bind(task, std::move(sdu)));
+}
+
+void up_workers::add_bearer(uint16_t rnti, uint32_t lcid, const srsran::pdcp_config_t& cnfg)
+{
+  worker* w = &get_worker(rnti);
+  push_task(rnti, [w, rnti, lcid, cnfg]() { w->pdcp.add_bearer(rnti, lcid, cnfg); });
+}
+
+void up_workers::del_bearer(uint16_t rnti, uint32_t lcid)
+{
+  worker* w = &get_worker(rnti);
+  push_task(rnti, [w, rnti, lcid]() { w->pdcp.del_bearer(rnti, lcid); });
+}
+
+void up_workers::config_security(uint16_t rnti, uint32_t lcid, const srsran::as_security_config_t& cfg_sec)
+{
+  worker* w = &get_worker(rnti);
+  push_task(rnti, [w, rnti, lcid, cfg_sec]() { w->pdcp.config_security(rnti, lcid, cfg_sec); });
+}
+
+void up_workers::enable_integrity(uint16_t rnti, uint32_t lcid)
+{
+  worker* w = &get_worker(rnti);
+  push_task(rnti, [w, rnti, lcid]() { w->pdcp.enable_integrity(rnti, lcid); });
+}
+
+void up_workers::enable_encryption(uint16_t rnti, uint32_t lcid)
+{
+  worker* w = &get_worker(rnti);
+  push_task(rnti, [w, rnti, lcid]() { w->pdcp.enable_encryption(rnti, lcid); });
+}
+
+bool up_workers::get_bearer_state(uint16_t rnti, uint32_t lcid, srsran::pdcp_lte_state_t* state)
+{
+  worker* w = &get_worker(rnti);
+  return run_blocking(*w, false, [w, rnti, lcid, state]() { return w->pdcp.get_bearer_state(rnti, lcid, state); });
+}
+
+bool up_workers::set_bearer_state(uint16_t rnti, uint32_t lcid, const srsran::pdcp_lte_state_t& state)
+{
+  worker* w = &get_worker(rnti);
+  return run_blocking(*w, false, [w, rnti, lcid, &state]() { return w->pdcp.set_bearer_state(rnti, lcid, state); });
+}
+
+void up_workers::send_status_report(uint16_t rnti)
+{
+  worker* w = &get_worker(rnti);
+  push_task(rnti, [w, rnti]() { w->pdcp.send_status_report(rnti); });
+}
+
+void up_workers::send_status_report(uint16_t rnti, uint32_t lcid)
+{
+  worker* w = &get_worker(rnti);
+  push_task(rnti, [w, rnti, lcid]() { w->pdcp.send_status_report(rnti, lcid); });
+}
+
+void up_workers::reestablish(uint16_t rnti)
+{
+  worker* w = &get_worker(rnti);
+  push_task(rnti, [w, rnti]() { w->pdcp.reestablish(rnti); });
+}
+
+std::map<uint32_t, srsran::unique_byte_buffer_t> up_workers::get_buffered_pdus(uint16_t rnti, uint32_t lcid)
+{
+  worker* w = &get_worker(rnti);
+  return run_blocking(*w, std::map<uint32_t, srsran::unique_byte_buffer_t>{}, [w, rnti, lcid]() {
+    return w->pdcp.get_buffered_pdus(rnti, lcid);
+  });
+}
+
+void up_workers::get_metrics(pdcp_metrics_t& m, const uint32_t nof_tti)
+{
+  // Gather the metrics of all workers, ordered by RNTI like in the single threaded PDCP
+  std::map<uint16_t, srsran::pdcp_metrics_t> ue_metrics;
+  for (auto& w_ptr : workers) {
+    worker* w = w_ptr.get();
+    run_blocking(*w, true, [w, &ue_metrics, nof_tti]() {
+      w->pdcp.get_ue_metrics(ue_metrics, nof_tti);
+      return true;
+    });
+  }
+  m.ues.clear();
+  for (auto& ue : ue_metrics) {
+    m.ues.push_back(ue.second);
+  }
+}
+
+/*******************************************************************************
+  Stack adapters. The RRC and GTP-U are only accessed from the stack thread
+*******************************************************************************/
+
+void up_workers::stack_adapter::push(srsran::move_task_t task)
+{
+  // Never block a worker on the stack thread, which may be waiting for this worker. While the queue is full, the tasks
+  // are kept in the backlog, which also keeps them behind the ones already waiting
+  if (backlog.empty()) {
+    auto ret = queue.try_push(std::move(task));
+    if (ret.has_value()) {
+      return;
+    }
+    if (not queue.active()) {
+      // The stack is stopping
+      return;
+    }
+    logger->warning("Stack task queue is full. Deferring PDUs from user-plane worker");
+    task = std::move(ret.error());
+  }
+  backlog.push_back(std::move(task));
+}
+
+void up_workers::stack_adapter::flush_backlog()
+{
+  while (not backlog.empty()) {
+    auto ret = queue.try_push(std::move(backlog.front()));
+    if (ret.is_error()) {
+      if (not queue.active()) {
+        backlog.clear();
+      } else {
+        backlog.front() = std::move(ret.error());
+      }
+      return;
+    }
+    backlog.pop_front();
+  }
+}
+
+void up_workers::stack_adapter::write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu)
+{
+  auto task = [this, rnti, lcid](srsran::unique_byte_buffer_t& pdu) { rrc->write_pdu(rnti, lcid, std::move(pdu)); };
+  push(std::bind(task, std::move(pdu)));
+}
+
+void up_workers::stack_adapter::notify_pdcp_integrity_error(uint16_t rnti, uint32_t lcid)
+{
+  push([this, rnti, lcid]() { rrc->notify_pdcp_integrity_error(rnti, lcid); });
+}
+
+void up_workers::stack_gtpu_adapter::write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu)
+{
+  auto task = [this, rnti, lcid](srsran::unique_byte_buffer_t& pdu) {
+    stack->gtpu->write_pdu(rnti, lcid, std::move(pdu));
+  };
+  stack->push(std::bind(task, std::move(pdu)));
+}
+
+} // namespace srsenb
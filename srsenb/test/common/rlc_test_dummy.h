@@ -30,6 +30,7 @@ class rlc_dummy : public rlc_interface_mac
 {
   int  read_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes) { return SRSRAN_SUCCESS; }
   void write_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes) {}
+  void write_pdu_slice(uint16_t rnti, uint32_t lcid, srsran::byte_buffer_slice pdu) {}
 };
 
 } // namespace srsenb
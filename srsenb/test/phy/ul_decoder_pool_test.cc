@@ -0,0 +1,275 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * @brief Benchmarks the parallel UL decoding of the eNb PHY while scaling the number of UEs per subframe.
+ *
+ * Each UE is given a disjoint PUSCH allocation in the same subframe. The resource grid is decoded once using only the
+ * carrier decoder and once using the additional decoders run by a task pool, the data of every UE must be recovered in
+ * both cases.
+ *
+ * The subframe is also decoded as when it is received slot by slot: the PUSCH of the first slot is demodulated before
+ * the timing starts, as it overlaps the reception of the second slot, so the time reported is the UL latency after the
+ * last slot is received.
+ */
+
+#include "srsenb/hdr/phy/lte/ul_decoder_pool.h"
+#include "srsran/common/test_common.h"
+#include "srsran/phy/utils/random.h"
+#include <chrono>
+#include <getopt.h>
+#include <memory>
+#include <vector>
+
+static srsran_cell_t cell = {
+    50,                 // nof_prb
+    1,                  // nof_ports
+    1,                  // cell_id
+    SRSRAN_CP_NORM,     // cyclic prefix
+    SRSRAN_PHICH_NORM,  // PHICH length
+    SRSRAN_PHICH_R_1_6, // PHICH resources
+    SRSRAN_FDD,
+};
+
+static uint32_t max_nof_ues   = 16;
+static uint32_t nof_threads   = 2;
+static uint32_t nof_subframes = 10;
+static uint32_t mcs_idx       = 16;
+static float    snr_db        = 30.0f;
+
+static srsran_refsignal_dmrs_pusch_cfg_t dmrs_cfg = {};
+
+struct test_ue_t {
+  srsran_pusch_cfg_t     cfg           = {};
+  srsran_softbuffer_tx_t softbuffer_tx = {};
+  srsran_softbuffer_rx_t softbuffer_rx = {};
+  srsran_pusch_res_t     res           = {};
+  std::vector<uint8_t>   data_tx;
+  std::vector<uint8_t>   data_rx;
+  std::vector<int16_t>   llr;
+};
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [nutsmS]\n", prog);
+  printf("\t-n number of PRB [Default %d]\n", cell.nof_prb);
+  printf("\t-u maximum number of UEs per subframe [Default %d]\n", max_nof_ues);
+  printf("\t-t number of additional decoding threads [Default %d]\n", nof_threads);
+  printf("\t-s number of subframes [Default %d]\n", nof_subframes);
+  printf("\t-m MCS index [Default %d]\n", mcs_idx);
+  printf("\t-S SNR in dB [Default %.1f]\n", snr_db);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "nutsmS")) != -1) {
+    switch (opt) {
+      case 'n':
+        cell.nof_prb = (uint32_t)strtol(argv[optind], nullptr, 10);
+        break;
+      case 'u':
+        max_nof_ues = (uint32_t)strtol(argv[optind], nullptr, 10);
+        break;
+      case 't':
+        nof_threads = (uint32_t)strtol(argv[optind], nullptr, 10);
+        break;
+      case 's':
+        nof_subframes = (uint32_t)strtol(argv[optind], nullptr, 10);
+        break;
+      case 'm':
+        mcs_idx = (uint32_t)strtol(argv[optind], nullptr, 10);
+        break;
+      case 'S':
+        snr_db = strtof(argv[optind], nullptr);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+/**
+ * @brief Encodes and decodes nof_subframes with nof_ues UEs
+ * @param task_pool Pool running the additional decoders, null for decoding in the calling thread only
+ * @param streamed Demodulate the first slot before the timing starts, as if the second one was being received
+ * @param decode_us Average decoding time per subframe after the last slot in microseconds
+ * @param tbs_bits Aggregated transport block size per subframe
+ */
+static int run_bench(uint32_t                  nof_ues,
+                     srsran::task_thread_pool* task_pool,
+                     bool                      streamed,
+                     double&                   decode_us,
+                     uint32_t&                 tbs_bits)
+{
+  int                    ret         = SRSRAN_ERROR;
+  srsran_random_t        random_h    = srsran_random_init(nof_ues);
+  srsran_enb_ul_t        enb_ul      = {};
+  srsran_pusch_t         pusch_tx    = {};
+  srsran_refsignal_ul_t  signals     = {};
+  cf_t*                  in_buffer   = srsran_vec_cf_malloc(SRSRAN_SF_LEN_PRB(cell.nof_prb));
+  cf_t*                  refsignal   = srsran_vec_cf_malloc(2 * SRSRAN_NRE * cell.nof_prb);
+  uint32_t               nof_re      = SRSRAN_SF_LEN_RE(cell.nof_prb, cell.cp);
+  uint32_t               L_prb       = srsran_dft_precoding_get_valid_prb(SRSRAN_MAX(cell.nof_prb / nof_ues, 1));
+  srsran_ul_sf_cfg_t     ul_sf       = {};
+  std::vector<test_ue_t> ues(nof_ues);
+
+  std::unique_ptr<srsenb::lte::ul_decoder_pool> decoders(new srsenb::lte::ul_decoder_pool);
+
+  TESTASSERT(in_buffer != nullptr && refsignal != nullptr);
+  TESTASSERT(nof_ues * L_prb <= cell.nof_prb);
+  TESTASSERT(srsran_enb_ul_init(&enb_ul, in_buffer, cell.nof_prb) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_enb_ul_set_cell(&enb_ul, cell, &dmrs_cfg, nullptr) == SRSRAN_SUCCESS);
+  TESTASSERT(decoders->init(&enb_ul, &dmrs_cfg, task_pool) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_pusch_init_ue(&pusch_tx, cell.nof_prb) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_pusch_set_cell(&pusch_tx, cell) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_refsignal_ul_set_cell(&signals, cell) == SRSRAN_SUCCESS);
+
+  // Give each UE a disjoint allocation
+  tbs_bits = 0;
+  for (uint32_t i = 0; i < nof_ues; i++) {
+    test_ue_t&                 ue      = ues[i];
+    srsran_dci_ul_t            dci     = {};
+    srsran_pusch_hopping_cfg_t hopping = {};
+
+    hopping.n_sb        = 1;
+    dci.rnti            = (uint16_t)(0x46 + i);
+    dci.type2_alloc.riv = srsran_ra_type2_to_riv(L_prb, i * L_prb, cell.nof_prb);
+    dci.tb.mcs_idx      = mcs_idx;
+    dci.freq_hop_fl     = srsran_dci_ul_t::SRSRAN_RA_PUSCH_HOP_DISABLED;
+    TESTASSERT(srsran_ra_ul_dci_to_grant(&cell, &ul_sf, &hopping, &dci, &ue.cfg.grant) == SRSRAN_SUCCESS);
+    ue.cfg.grant.n_prb_tilde[0] = ue.cfg.grant.n_prb[0];
+    ue.cfg.grant.n_prb_tilde[1] = ue.cfg.grant.n_prb[1];
+    ue.cfg.rnti                 = dci.rnti;
+    ue.cfg.uci_offset           = {6, 2, 9}; // I_offset_cqi, I_offset_ri and I_offset_ack
+
+    TESTASSERT(srsran_softbuffer_tx_init(&ue.softbuffer_tx, cell.nof_prb) == SRSRAN_SUCCESS);
+    TESTASSERT(srsran_softbuffer_rx_init(&ue.softbuffer_rx, cell.nof_prb) == SRSRAN_SUCCESS);
+    ue.data_tx.resize(ue.cfg.grant.tb.tbs / 8);
+    // The decoder writes whole code blocks, leave room for the last one
+    ue.data_rx.resize(ue.cfg.grant.tb.tbs / 8 + SRSRAN_TCOD_MAX_LEN_CB_BYTES);
+    ue.llr.resize(ue.cfg.grant.nof_re * srsran_mod_bits_x_symbol(SRSRAN_MOD_64QAM));
+    tbs_bits += ue.cfg.grant.tb.tbs;
+  }
+
+  decode_us = 0;
+  for (uint32_t sf = 0; sf < nof_subframes; sf++) {
+    ul_sf.tti = sf;
+
+    // Build the received resource grid with all the UEs
+    srsran_vec_cf_zero(enb_ul.sf_symbols, nof_re);
+    for (test_ue_t& ue : ues) {
+      for (uint8_t& b : ue.data_tx) {
+        b = (uint8_t)srsran_random_uniform_int_dist(random_h, 0, 255);
+      }
+      srsran_softbuffer_tx_reset(&ue.softbuffer_tx);
+      srsran_softbuffer_rx_reset(&ue.softbuffer_rx);
+
+      srsran_pusch_data_t data = {};
+      data.ptr                 = ue.data_tx.data();
+      ue.cfg.softbuffers.tx    = &ue.softbuffer_tx;
+      TESTASSERT(srsran_pusch_encode(&pusch_tx, &ul_sf, &ue.cfg, &data, enb_ul.sf_symbols) == SRSRAN_SUCCESS);
+      TESTASSERT(srsran_refsignal_dmrs_pusch_gen(
+                     &signals, &dmrs_cfg, ue.cfg.grant.L_prb, sf % SRSRAN_NOF_SF_X_FRAME, 0, refsignal) ==
+                 SRSRAN_SUCCESS);
+      srsran_refsignal_dmrs_pusch_put(&signals, &ue.cfg, refsignal, enb_ul.sf_symbols);
+
+      // The softbuffer pointers share storage, set the receive one once the UE is encoded
+      ue.cfg.softbuffers.rx = &ue.softbuffer_rx;
+      ue.res                = {};
+      ue.res.data           = ue.data_rx.data();
+    }
+    srsran_ch_awgn_c(enb_ul.sf_symbols, enb_ul.sf_symbols, srsran_convert_dB_to_power(-snr_db), nof_re);
+
+    // Demodulate the first slot of all the UEs while the second one would be received
+    if (streamed) {
+      decoders->run(nof_ues, [&ues, &ul_sf](srsran_enb_ul_t& decoder, uint32_t ue_idx) {
+        test_ue_t& ue = ues[ue_idx];
+        srsran_enb_ul_get_pusch_slot(&decoder, &ul_sf, &ue.cfg, 0, ue.llr.data(), &ue.res);
+      });
+    }
+
+    // Decode all the UEs
+    auto t_start = std::chrono::high_resolution_clock::now();
+    decoders->run(nof_ues, [&ues, &ul_sf, streamed](srsran_enb_ul_t& decoder, uint32_t ue_idx) {
+      test_ue_t& ue = ues[ue_idx];
+      if (streamed) {
+        srsran_enb_ul_get_pusch_slot(&decoder, &ul_sf, &ue.cfg, 1, ue.llr.data(), &ue.res);
+        srsran_enb_ul_decode_pusch_llr(&decoder, &ul_sf, &ue.cfg, ue.llr.data(), &ue.res);
+      } else {
+        srsran_enb_ul_get_pusch(&decoder, &ul_sf, &ue.cfg, &ue.res);
+      }
+    });
+    auto t_end = std::chrono::high_resolution_clock::now();
+    decode_us += std::chrono::duration_cast<std::chrono::microseconds>(t_end - t_start).count();
+
+    for (uint32_t i = 0; i < nof_ues; i++) {
+      if (!ues[i].res.crc || memcmp(ues[i].data_tx.data(), ues[i].data_rx.data(), ues[i].data_tx.size()) != 0) {
+        printf("Error decoding UE %d in subframe %d\n", i, sf);
+        goto clean_exit;
+      }
+    }
+  }
+  decode_us /= nof_subframes;
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  for (test_ue_t& ue : ues) {
+    srsran_softbuffer_tx_free(&ue.softbuffer_tx);
+    srsran_softbuffer_rx_free(&ue.softbuffer_rx);
+  }
+  decoders.reset();
+  srsran_enb_ul_free(&enb_ul);
+  srsran_pusch_free(&pusch_tx);
+  srsran_random_free(random_h);
+  free(in_buffer);
+  free(refsignal);
+  return ret;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srsran::task_thread_pool task_pool(SRSRAN_MAX(nof_threads, 1));
+
+  printf("%8s %8s %14s %14s %16s\n", "nof_ues", "threads", "decode_us/sf", "Mbps", "streamed_us/sf");
+  for (uint32_t nof_ues = 1; nof_ues <= SRSRAN_MIN(max_nof_ues, cell.nof_prb); nof_ues *= 2) {
+    for (uint32_t threads : {0u, nof_threads}) {
+      srsran::task_thread_pool* pool        = threads > 0 ? &task_pool : nullptr;
+      double                    decode_us   = 0;
+      double                    streamed_us = 0;
+      uint32_t                  tbs_bits    = 0;
+      if (run_bench(nof_ues, pool, false, decode_us, tbs_bits) < SRSRAN_SUCCESS or
+          run_bench(nof_ues, pool, true, streamed_us, tbs_bits) < SRSRAN_SUCCESS) {
+        printf("Failed nof_ues=%d, threads=%d\n", nof_ues, threads);
+        return SRSRAN_ERROR;
+      }
+      printf("%8d %8d %14.1f %14.2f %16.1f\n", nof_ues, threads, decode_us, (double)tbs_bits / decode_us, streamed_us);
+      if (nof_threads == 0) {
+        break;
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
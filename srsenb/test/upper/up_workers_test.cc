@@ -0,0 +1,437 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsenb/hdr/stack/upper/gtpu.h"
+#include "srsenb/hdr/stack/upper/pdcp.h"
+#include "srsenb/hdr/stack/upper/rlc.h"
+#include "srsenb/hdr/stack/upper/up_workers.h"
+#include "srsran/common/network_utils.h"
+#include "srsran/common/test_common.h"
+#include "srsran/interfaces/enb_mac_interfaces.h"
+#include "srsran/interfaces/enb_rrc_interface_rlc.h"
+#include "srsran/upper/gtpu.h"
+#include <chrono>
+#include <getopt.h>
+#include <linux/ip.h>
+#include <thread>
+
+/*
+ * Functional tests of the user-plane workers, followed by a benchmark of the eNB DL user-plane, from the GTP-U S1-U
+ * handler down to the MAC reading RLC PDUs.
+ * The stack thread pumps GTP-U packets to many UEs while a few threads, like the PHY workers, read one PDU per SDU
+ * from every UE. The run is repeated with PDCP in the stack thread and sharded across an increasing number of
+ * user-plane workers. Ciphering is enabled, so that the PDCP processing dominates.
+ */
+
+static uint32_t nof_ues         = 32;
+static uint32_t nof_sdus        = 50000;
+static uint32_t sdu_size        = 1400;
+static uint32_t max_workers     = 4;
+static uint32_t nof_mac_readers = 2;
+
+namespace srsenb {
+
+static const uint32_t drb1_lcid      = 3;
+static const int      gtpu_port      = 2152;
+static const uint32_t max_in_flight  = 1024;
+static const uint16_t first_rnti     = 0x46;
+static const char*    enb_addr_str   = "127.0.1.1";
+static const char*    sgw_addr_str   = "127.0.0.1";
+static const uint32_t pdcp_hdr_bytes = 2;
+static const uint32_t rlc_hdr_bytes  = 2;
+
+class mac_dummy : public mac_interface_rlc
+{
+public:
+  int rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint32_t retx_queue) override
+  {
+    return SRSRAN_SUCCESS;
+  }
+};
+
+class rrc_dummy : public rrc_interface_rlc, public rrc_interface_pdcp
+{
+public:
+  void max_retx_attempted(uint16_t rnti) override {}
+  void protocol_failure(uint16_t rnti) override {}
+  void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu) override {}
+  void notify_pdcp_integrity_error(uint16_t rnti, uint32_t lcid) override {}
+};
+
+class gtpu_dummy : public gtpu_interface_pdcp
+{
+public:
+  void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu) override {}
+};
+
+/// Records the UL SDUs delivered to GTP-U, which are handed back to the stack thread by the workers
+class gtpu_recorder : public gtpu_interface_pdcp
+{
+public:
+  void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu) override
+  {
+    uint32_t idx;
+    memcpy(&idx, pdu->msg, sizeof(idx));
+    rx_sdus[rnti].push_back(idx);
+    nof_rx++;
+  }
+
+  std::map<uint16_t, std::vector<uint32_t> > rx_sdus;
+  uint32_t                                   nof_rx = 0;
+};
+
+struct dummy_socket_manager : public srsran::socket_manager_itf {
+  dummy_socket_manager() : srsran::socket_manager_itf(srslog::fetch_basic_logger("TEST")) {}
+  bool add_socket_handler(int fd, recv_callback_t handler) final { return true; }
+  bool remove_socket(int fd) final { return true; }
+};
+
+srsran::unique_byte_buffer_t make_gtpu_packet(uint32_t teid)
+{
+  srsran::unique_byte_buffer_t pdu;
+  do {
+    pdu = srsran::make_byte_buffer();
+    if (pdu == nullptr) {
+      // wait until pool is not depleted
+      std::this_thread::yield();
+    }
+  } while (pdu == nullptr);
+
+  struct iphdr ip_pkt = {};
+  ip_pkt.version      = 4;
+  ip_pkt.tot_len      = htons(sdu_size);
+  pdu->append_bytes((uint8_t*)&ip_pkt, sizeof(struct iphdr));
+  memset(pdu->msg + pdu->N_bytes, 0xab, sdu_size - sizeof(struct iphdr));
+  pdu->N_bytes = sdu_size;
+
+  srsran::gtpu_header_t header = {};
+  header.flags                 = GTPU_FLAGS_VERSION_V1 | GTPU_FLAGS_GTP_PROTOCOL;
+  header.message_type          = GTPU_MSG_DATA_PDU;
+  header.length                = pdu->N_bytes;
+  header.teid                  = teid;
+  gtpu_write_header(&header, pdu.get(), srslog::fetch_basic_logger("GTPU"));
+  return pdu;
+}
+
+srsran::pdcp_config_t make_drb_config()
+{
+  return srsran::pdcp_config_t(drb1_lcid - 2,
+                               srsran::PDCP_RB_IS_DRB,
+                               srsran::SECURITY_DIRECTION_DOWNLINK,
+                               srsran::SECURITY_DIRECTION_UPLINK,
+                               srsran::PDCP_SN_LEN_12,
+                               srsran::pdcp_t_reordering_t::ms500,
+                               srsran::pdcp_discard_timer_t::infinity,
+                               false,
+                               srsran::srsran_rat_t::lte);
+}
+
+/// UL PDCP data PDU with a 12 bit SN, carrying idx as payload
+srsran::unique_byte_buffer_t make_ul_pdcp_pdu(uint32_t idx)
+{
+  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+  srsran_assert(pdu != nullptr, "Byte buffer pool depleted");
+  uint32_t sn  = idx % (1U << 12U);
+  pdu->msg[0]  = 0x80 | ((sn >> 8U) & 0x0f);
+  pdu->msg[1]  = sn & 0xff;
+  pdu->N_bytes = pdcp_hdr_bytes;
+  pdu->append_bytes((uint8_t*)&idx, sizeof(idx));
+  return pdu;
+}
+
+/// Runs the stack thread until all the UL SDUs have been delivered to GTP-U
+void run_stack_until_rx(srsran::task_scheduler& task_sched,
+                        up_workers&             workers,
+                        const gtpu_recorder&    gtpu_ul,
+                        uint32_t                nof_expected)
+{
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (gtpu_ul.nof_rx < nof_expected and std::chrono::steady_clock::now() < deadline) {
+    task_sched.run_pending_tasks();
+    // The ticks also wake up the workers, which retry pushing their backlog
+    workers.tic();
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+}
+
+/// Feeds UL PDUs of several UEs from the RLC side and checks that every UE receives its SDUs in order. With a stack
+/// queue smaller than the number of PDUs, the workers must defer the PDUs instead of dropping or blocking on them
+int test_ul_ordering(uint32_t stack_queue_size)
+{
+  const uint32_t nof_test_ues = 8, nof_pdus = 500;
+
+  srsran::task_scheduler task_sched(stack_queue_size);
+  mac_dummy              mac;
+  rrc_dummy              rrc;
+  gtpu_recorder          gtpu_ul;
+  srsenb::rlc            rlc(srslog::fetch_basic_logger("RLC", false));
+  srsenb::up_workers     up_workers(&task_sched, srslog::fetch_basic_logger("PDCP", false));
+  up_workers.init(2, &rlc, &rrc, &gtpu_ul);
+  rlc.init(&up_workers, &rrc, &mac, task_sched.get_timer_handler(), 2);
+
+  for (uint16_t rnti = first_rnti; rnti < first_rnti + nof_test_ues; ++rnti) {
+    rlc.add_user(rnti);
+    rlc.add_bearer(rnti, drb1_lcid, srsran::rlc_config_t::default_rlc_um_config());
+    up_workers.add_user(rnti);
+    up_workers.add_bearer(rnti, drb1_lcid, make_drb_config());
+  }
+  for (uint32_t i = 0; i < nof_pdus; ++i) {
+    for (uint16_t rnti = first_rnti; rnti < first_rnti + nof_test_ues; ++rnti) {
+      up_workers.write_pdu(rnti, drb1_lcid, make_ul_pdcp_pdu(i));
+    }
+  }
+
+  // The stack thread waits for the workers while they cannot push to the stack queue
+  pdcp_metrics_t metrics;
+  up_workers.get_metrics(metrics, 1);
+  TESTASSERT_EQ(nof_test_ues, metrics.ues.size());
+  for (const auto& ue : metrics.ues) {
+    TESTASSERT_EQ(nof_pdus, ue.bearer[drb1_lcid].num_rx_pdus);
+  }
+
+  run_stack_until_rx(task_sched, up_workers, gtpu_ul, nof_test_ues * nof_pdus);
+  TESTASSERT_EQ(nof_test_ues * nof_pdus, gtpu_ul.nof_rx);
+  for (const auto& ue : gtpu_ul.rx_sdus) {
+    TESTASSERT_EQ(nof_pdus, ue.second.size());
+    for (uint32_t i = 0; i < nof_pdus; ++i) {
+      TESTASSERT_EQ(i, ue.second[i]);
+    }
+  }
+
+  up_workers.stop();
+  rlc.stop();
+  task_sched.stop();
+  return SRSRAN_SUCCESS;
+}
+
+/// Stops the workers while other threads are waiting for the result of blocking calls, which must then return
+int test_stop_with_pending_blocking_calls()
+{
+  const uint32_t nof_callers = 4;
+
+  srsran::task_scheduler task_sched;
+  mac_dummy              mac;
+  rrc_dummy              rrc;
+  gtpu_dummy             gtpu_ul;
+  srsenb::rlc            rlc(srslog::fetch_basic_logger("RLC", false));
+  srsenb::up_workers     up_workers(&task_sched, srslog::fetch_basic_logger("PDCP", false));
+  up_workers.init(2, &rlc, &rrc, &gtpu_ul);
+  rlc.init(&up_workers, &rrc, &mac, task_sched.get_timer_handler(), 2);
+  rlc.add_user(first_rnti);
+  rlc.add_bearer(first_rnti, drb1_lcid, srsran::rlc_config_t::default_rlc_um_config());
+  up_workers.add_user(first_rnti);
+  up_workers.add_bearer(first_rnti, drb1_lcid, make_drb_config());
+
+  std::atomic<bool>        stopped{false};
+  std::atomic<uint32_t>    nof_calls{0};
+  std::vector<std::thread> callers;
+  for (uint32_t i = 0; i < nof_callers; ++i) {
+    callers.emplace_back([&up_workers, &stopped, &nof_calls, i]() {
+      srsran::pdcp_lte_state_t state = {};
+      while (not stopped.load()) {
+        up_workers.get_bearer_state(first_rnti + i, drb1_lcid, &state);
+        nof_calls++;
+      }
+    });
+  }
+  while (nof_calls.load() < 1000) {
+    std::this_thread::yield();
+  }
+  up_workers.stop();
+  stopped = true;
+  for (auto& t : callers) {
+    t.join();
+  }
+
+  // Calls after the stop return the default value right away
+  srsran::pdcp_lte_state_t state = {};
+  TESTASSERT(not up_workers.get_bearer_state(first_rnti, drb1_lcid, &state));
+  TESTASSERT(up_workers.get_buffered_pdus(first_rnti, drb1_lcid).empty());
+  up_workers.write_pdu(first_rnti, drb1_lcid, make_ul_pdcp_pdu(0));
+  up_workers.tic();
+
+  rlc.stop();
+  task_sched.stop();
+  return SRSRAN_SUCCESS;
+}
+
+/// Runs the DL user-plane of all UEs and returns the rate of SDUs read by the MAC, in SDUs per second
+double run_benchmark(uint32_t nof_workers)
+{
+  srslog::basic_logger&  pdcp_logger = srslog::fetch_basic_logger("PDCP", false);
+  srsran::task_scheduler task_sched;
+  dummy_socket_manager   rx_sockets;
+  mac_dummy              mac;
+  rrc_dummy              rrc;
+  gtpu_dummy             gtpu_ul;
+  srsenb::rlc            rlc(srslog::fetch_basic_logger("RLC", false));
+  srsenb::pdcp           pdcp(&task_sched, pdcp_logger);
+  srsenb::up_workers     up_workers(&task_sched, pdcp_logger);
+  srsenb::gtpu           gtpu(&task_sched, srslog::fetch_basic_logger("GTPU"), &rx_sockets);
+
+  pdcp_interface_rlc*  pdcp_rlc  = &pdcp;
+  pdcp_interface_gtpu* pdcp_gtpu = &pdcp;
+  pdcp_interface_rrc*  pdcp_rrc  = &pdcp;
+  if (nof_workers > 0) {
+    pdcp_rlc  = &up_workers;
+    pdcp_gtpu = &up_workers;
+    pdcp_rrc  = &up_workers;
+    up_workers.init(nof_workers, &rlc, &rrc, &gtpu_ul);
+  } else {
+    pdcp.init(&rlc, &rrc, &gtpu_ul);
+  }
+  rlc.init(pdcp_rlc, &rrc, &mac, task_sched.get_timer_handler(), nof_workers);
+
+  gtpu_args_t gtpu_args   = {};
+  gtpu_args.gtp_bind_addr = enb_addr_str;
+  gtpu_args.mme_addr      = sgw_addr_str;
+  int ret                 = gtpu.init(gtpu_args, pdcp_gtpu);
+  TESTASSERT(ret == SRSRAN_SUCCESS);
+
+  // Setup one ciphered DRB per UE. GTP-U forwards the SDUs to the LCID, as there is no bearer manager
+  struct sockaddr_in sgw_sockaddr = {};
+  srsran::net_utils::set_sockaddr(&sgw_sockaddr, sgw_addr_str, gtpu_port);
+  srsran::as_security_config_t sec_cfg = {};
+  sec_cfg.cipher_algo                  = srsran::CIPHERING_ALGORITHM_ID_128_EEA2;
+  sec_cfg.integ_algo                   = srsran::INTEGRITY_ALGORITHM_ID_128_EIA2;
+  srsran::pdcp_config_t pdcp_cfg       = make_drb_config();
+  std::vector<uint32_t> teids;
+  for (uint16_t rnti = first_rnti; rnti < first_rnti + nof_ues; ++rnti) {
+    rlc.add_user(rnti);
+    rlc.add_bearer(rnti, drb1_lcid, srsran::rlc_config_t::default_rlc_um_config());
+    pdcp_rrc->add_user(rnti);
+    pdcp_rrc->add_bearer(rnti, drb1_lcid, pdcp_cfg);
+    pdcp_rrc->config_security(rnti, drb1_lcid, sec_cfg);
+    pdcp_rrc->enable_encryption(rnti, drb1_lcid);
+    uint32_t                   addr_in;
+    srsran::expected<uint32_t> teid =
+        gtpu.add_bearer(rnti, drb1_lcid, ntohl(sgw_sockaddr.sin_addr.s_addr), rnti, addr_in);
+    TESTASSERT(teid.has_value());
+    teids.push_back(teid.value());
+  }
+
+  // MAC readers ask for exactly one SDU per PDU, so every PDU read accounts for one SDU
+  std::atomic<uint32_t>    nof_read{0};
+  std::vector<std::thread> readers;
+  for (uint32_t r = 0; r < nof_mac_readers; ++r) {
+    readers.emplace_back([&rlc, &nof_read, r]() {
+      std::vector<uint8_t> payload(sdu_size + pdcp_hdr_bytes + rlc_hdr_bytes);
+      while (nof_read.load(std::memory_order_relaxed) < nof_sdus) {
+        uint32_t count = 0;
+        for (uint16_t rnti = first_rnti + r; rnti < first_rnti + nof_ues; rnti += nof_mac_readers) {
+          count += rlc.read_pdu(rnti, drb1_lcid, payload.data(), payload.size()) > 0 ? 1 : 0;
+        }
+        if (count == 0) {
+          std::this_thread::yield();
+        }
+        nof_read.fetch_add(count, std::memory_order_relaxed);
+      }
+    });
+  }
+
+  // The stack thread keeps a bounded number of SDUs in flight, so that no RLC queue overflows
+  auto tic = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < nof_sdus; ++i) {
+    while (i - nof_read.load(std::memory_order_relaxed) >= max_in_flight) {
+      std::this_thread::yield();
+    }
+    gtpu.handle_gtpu_s1u_rx_packet(make_gtpu_packet(teids[i % nof_ues]), sgw_sockaddr);
+  }
+  for (auto& t : readers) {
+    t.join();
+  }
+  auto toc = std::chrono::steady_clock::now();
+  TESTASSERT(nof_read == nof_sdus);
+
+  gtpu.stop();
+  up_workers.stop();
+  rlc.stop();
+  pdcp.stop();
+  return nof_sdus / std::chrono::duration<double>(toc - tic).count();
+}
+
+} // namespace srsenb
+
+void usage(char* prog)
+{
+  printf("Usage: %s [unswr]\n", prog);
+  printf("\t-u number of UEs [Default %d]\n", nof_ues);
+  printf("\t-n number of SDUs per benchmark run [Default %d]\n", nof_sdus);
+  printf("\t-s SDU size in bytes [Default %d]\n", sdu_size);
+  printf("\t-w maximum number of user-plane workers [Default %d]\n", max_workers);
+  printf("\t-r number of MAC reader threads [Default %d]\n", nof_mac_readers);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "unswr")) != -1) {
+    switch (opt) {
+      case 'u':
+        nof_ues = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'n':
+        nof_sdus = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 's':
+        sdu_size = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'w':
+        max_workers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        nof_mac_readers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+  for (const char* name : {"PDCP", "RLC", "GTPU", "COMN", "TEST"}) {
+    srslog::fetch_basic_logger(name, false).set_level(srslog::basic_levels::warning);
+  }
+  srslog::init();
+
+  TESTASSERT(srsenb::test_ul_ordering(512) == SRSRAN_SUCCESS);
+  TESTASSERT(srsenb::test_ul_ordering(4) == SRSRAN_SUCCESS);
+  TESTASSERT(srsenb::test_stop_with_pending_blocking_calls() == SRSRAN_SUCCESS);
+
+  double stack_rate = srsenb::run_benchmark(0);
+  printf("UEs=%d, SDU size=%d, PDCP in stack thread: %.1f kSDU/s\n", nof_ues, sdu_size, stack_rate / 1e3);
+  for (uint32_t nof_workers = 1; nof_workers <= max_workers; nof_workers *= 2) {
+    double rate = srsenb::run_benchmark(nof_workers);
+    printf("UEs=%d, SDU size=%d, %d user-plane workers: %.1f kSDU/s (x%.2f)\n",
+           nof_ues,
+           sdu_size,
+           nof_workers,
+           rate / 1e3,
+           rate / stack_rate);
+  }
+
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
@@ -30,11 +30,17 @@
 
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/standard_streams.h"
+#include "srsran/common/thread_pool.h"
 #include "srsran/interfaces/epc_interfaces.h"
 #include "srsran/srslog/srslog.h"
 #include <cstddef>
+#include <cstdio>
 
+#include <deque>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #define LTE_FDD_ENB_IND_HE_N_BITS 5
 #define LTE_FDD_ENB_IND_HE_MASK 0x1FUL
@@ -43,10 +49,26 @@
 
 namespace srsepc {
 
+// Precomputed vectors are handed out in SQN order, each of them taking a different IND value. There are fewer
+// outstanding vectors than IND values, so that the IND of a vector is not reused before the UE has seen it
+// (TS 33.102 Annex C)
+const uint32_t HSS_MAX_AUTH_VECTORS = LTE_FDD_ENB_IND_HE_MAX_VALUE / 2;
+
+// The SQN journal is compacted to one entry per UE once it holds this many entries per UE
+const uint32_t HSS_SQN_JOURNAL_MAX_ENTRIES_PER_UE = 16;
+
 struct hss_args_t {
   std::string db_file;
   uint16_t    mcc;
   uint16_t    mnc;
+  uint32_t    nof_auth_vectors; // Vectors precomputed per UE after its first authentication. 0 disables precomputation
+};
+
+struct hss_auth_vector_t {
+  uint8_t rand[16];
+  uint8_t xres[16];
+  uint8_t autn[16];
+  uint8_t k_asme[32];
 };
 
 enum hss_auth_algo { HSS_ALGO_XOR, HSS_ALGO_MILENAGE };
@@ -66,6 +88,12 @@ struct hss_ue_ctx_t {
   uint8_t            last_rand[16];
   std::string        static_ip_addr;
 
+  // Precomputed authentication vectors, in SQN order. A resynchronization bumps the generation to discard the ones
+  // being computed with the old SQN
+  std::deque<hss_auth_vector_t> auth_vectors;
+  uint32_t                      auth_vectors_gen     = 0;
+  bool                          auth_vectors_pending = false;
+
   // Helper getters/setters
   void set_sqn(const uint8_t* sqn_);
   void set_last_rand(const uint8_t* rand_);
@@ -92,19 +120,22 @@ private:
   virtual ~hss();
   static hss* m_instance;
 
-  std::map<uint64_t, std::unique_ptr<hss_ue_ctx_t> > m_imsi_to_ue_ctx;
+  std::unordered_map<uint64_t, std::unique_ptr<hss_ue_ctx_t> > m_imsi_to_ue_ctx;
 
   void gen_rand(uint8_t rand_[16]);
 
-  void
-       gen_auth_info_answer_milenage(hss_ue_ctx_t* ue_ctx, uint8_t* k_asme, uint8_t* autn, uint8_t* rand, uint8_t* xres);
-  void gen_auth_info_answer_xor(hss_ue_ctx_t* ue_ctx, uint8_t* k_asme, uint8_t* autn, uint8_t* rand, uint8_t* xres);
+  void gen_auth_vectors(hss_ue_ctx_t* ue_ctx, uint32_t nof_vectors, uint8_t* sqn, hss_auth_vector_t* av);
+  void gen_auth_vectors_milenage(hss_ue_ctx_t* ue_ctx, uint32_t nof_vectors, uint8_t* sqn, hss_auth_vector_t* av);
+  void gen_auth_vectors_xor(hss_ue_ctx_t* ue_ctx, uint32_t nof_vectors, uint8_t* sqn, hss_auth_vector_t* av);
+  void schedule_auth_vectors(hss_ue_ctx_t* ue_ctx);
+  void precompute_auth_vectors(uint64_t imsi);
 
   void resync_sqn_milenage(hss_ue_ctx_t* ue_ctx, uint8_t* auts);
   void resync_sqn_xor(hss_ue_ctx_t* ue_ctx, uint8_t* auts);
 
   void                     get_uint_vec_from_hex_str(const std::string& key_str, uint8_t* key, uint len);
 
+  void reserve_ue_sqns(hss_ue_ctx_t* ue_ctx, uint32_t nof_sqns, uint8_t* sqn);
   void increment_ue_sqn(hss_ue_ctx_t* ue_ctx);
   void increment_seq_after_resync(hss_ue_ctx_t* ue_ctx);
   void increment_sqn(uint8_t* sqn, uint8_t* next_sqn);
@@ -112,12 +143,27 @@ private:
   bool          set_auth_algo(std::string auth_algo);
   bool          read_db_file(std::string db_file);
   bool          write_db_file(std::string db_file);
+  bool          read_sqn_journal(std::string journal_file);
+  void          write_sqn_journal(const hss_ue_ctx_t* ue_ctx);
+  void          write_sqn_journal_entry(FILE* journal, const hss_ue_ctx_t* ue_ctx);
+  void          compact_sqn_journal();
   hss_ue_ctx_t* get_ue_ctx(uint64_t imsi);
 
   std::string hex_string(uint8_t* hex, int size);
 
   std::string db_file;
 
+  // SQN updates are appended to the journal instead of rewriting the DB file, which is only rewritten at start-up
+  // and shutdown
+  std::string sqn_journal_file;
+  FILE*       m_sqn_journal         = nullptr;
+  uint32_t    m_sqn_journal_entries = 0;
+
+  // Protects the SQN, last RAND and precomputed vectors of all the UEs, as well as the journal
+  std::mutex m_sqn_mutex;
+
+  uint32_t m_nof_auth_vectors = 0;
+
   /*Logs*/
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("HSS");
 
@@ -125,6 +171,9 @@ private:
   uint16_t mnc;
 
   std::map<std::string, uint64_t> m_ip_to_imsi;
+
+  // Precomputes the vectors. Declared last, so that it is stopped before the UE contexts are destroyed
+  std::unique_ptr<srsran::task_worker> m_auth_vectors_worker;
 };
 
 inline void hss_ue_ctx_t::set_sqn(const uint8_t* sqn_)
@@ -31,13 +31,18 @@
 #include "s1ap.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/standard_streams.h"
+#include "srsran/common/thread_pool.h"
 #include "srsran/common/threads.h"
+#include <atomic>
 #include <cstddef>
+#include <memory>
+#include <mutex>
 
 namespace srsepc {
 
 typedef struct {
   s1ap_args_t s1ap_args;
+  uint32_t    nof_workers; // S1AP/NAS worker threads. With none, messages are processed by the receiving thread
   // diameter_args_t diameter_args;
   // gtpc_args_t gtpc_args;
 } mme_args_t;
@@ -71,14 +76,27 @@ private:
   s1ap*       m_s1ap;
   mme_gtpc*   m_mme_gtpc;
 
-  bool   m_running;
-  fd_set m_set;
+  std::atomic<bool> m_running;
+  int               m_epoll_fd;
+  int               m_stop_fd; // Wakes up the receiving thread on stop
 
-  // Timer map
+  // Timer map, NAS timers are added and removed by the UE workers
+  std::mutex               m_timers_mutex;
   std::vector<mme_timer_t> timers;
 
+  // UE workers, each one processes the S1AP, S11 and timer events of its own share of UEs
+  struct s1ap_rx_pdu_t {
+    s1ap_pdu_t             pdu;
+    struct sctp_sndrcvinfo enb_sri;
+  };
+  std::vector<std::unique_ptr<srsran::task_worker> > m_workers;
+
+  void handle_s1ap_rx_pdu(srsran::unique_byte_buffer_t pdu, const struct sctp_sndrcvinfo& enb_sri);
+  void handle_s11_rx_pdu(srsran::unique_byte_buffer_t pdu);
+  void sync_workers();
+
   // Timer Methods
-  void handle_timer_expire(int timer_fd);
+  void handle_timer_expire(enum nas_timer_type type, uint64_t imsi);
 
   // Logs
   srslog::basic_logger& m_s1ap_logger = srslog::fetch_basic_logger("S1AP");
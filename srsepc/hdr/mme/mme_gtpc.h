@@ -24,6 +24,7 @@
 #include "nas.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/common/buffer_pool.h"
+#include <mutex>
 #include <sys/socket.h>
 #include <sys/un.h>
 
@@ -47,6 +48,7 @@ public:
   bool init();
   bool send_s11_pdu(const srsran::gtpc_pdu& pdu);
   void handle_s11_pdu(srsran::byte_buffer_t* msg);
+  bool get_imsi_from_ctrl_teid(uint32_t mme_ctrl_teid, uint64_t* imsi);
 
   virtual bool send_create_session_request(uint64_t imsi);
   bool         handle_create_session_response(srsran::gtpc_pdu* cs_resp_pdu);
@@ -66,6 +68,8 @@ private:
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("MME GTPC");
   s1ap*                 m_s1ap;
 
+  // GTP-C contexts are shared by the UE workers and protected by m_ctx_mutex
+  std::mutex                          m_ctx_mutex;
   uint32_t                            m_next_ctrl_teid;
   std::map<uint32_t, uint64_t>        m_mme_ctr_teid_to_imsi;
   std::map<uint64_t, struct gtpc_ctx> m_imsi_to_gtpc_ctx;
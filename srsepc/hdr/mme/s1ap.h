@@ -39,12 +39,14 @@
 #include "srsran/srslog/srslog.h"
 #include <arpa/inet.h>
 #include <map>
+#include <mutex>
 #include <netinet/sctp.h>
 #include <set>
 #include <strings.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <unistd.h>
+#include <unordered_map>
 
 namespace srsepc {
 
@@ -67,7 +69,8 @@ public:
   void delete_enb_ctx(int32_t assoc_id);
 
   bool s1ap_tx_pdu(const s1ap_pdu_t& pdu, struct sctp_sndrcvinfo* enb_sri);
-  void handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu, struct sctp_sndrcvinfo* enb_sri);
+  bool unpack_s1ap_pdu(srsran::byte_buffer_t* pdu, s1ap_pdu_t* rx_pdu);
+  void handle_s1ap_rx_pdu(const s1ap_pdu_t& rx_pdu, struct sctp_sndrcvinfo* enb_sri);
   void handle_initiating_message(const asn1::s1ap::init_msg_s& msg, struct sctp_sndrcvinfo* enb_sri);
   void handle_successful_outcome(const asn1::s1ap::successful_outcome_s& msg);
 
@@ -96,6 +99,16 @@ public:
   uint32_t         allocate_m_tmsi(uint64_t imsi);
   virtual uint64_t find_imsi_from_m_tmsi(uint32_t m_tmsi);
 
+  // UE sharding. Every UE context belongs to the worker that created it, which is stored in the context. The Initial UE
+  // Message is routed through the IMSI or M-TMSI of the UE to the worker owning its context, and that worker allocates
+  // MME UE S1AP Ids whose value modulo the number of workers is its index. A negative shard means the message is not
+  // UE-associated.
+  void            set_nof_workers(uint32_t nof_workers);
+  void            set_worker_shard(uint32_t shard);
+  static uint32_t get_worker_shard();
+  int             get_ue_shard(const s1ap_pdu_t& pdu, int32_t enb_assoc);
+  int             get_ue_shard_from_imsi(uint64_t imsi);
+
   s1ap_args_t           m_s1ap_args;
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("S1AP");
 
@@ -105,8 +118,8 @@ public:
   s1ap_erab_mngmt_proc* m_s1ap_erab_mngmt_proc;
   s1ap_paging*          m_s1ap_paging;
 
-  std::map<uint32_t, uint64_t>   m_tmsi_to_imsi;
-  std::map<uint16_t, enb_ctx_t*> m_active_enbs;
+  std::unordered_map<uint32_t, uint64_t> m_tmsi_to_imsi; // Protected by m_ctx_mutex
+  std::map<uint16_t, enb_ctx_t*>         m_active_enbs;  // Only modified while the UE workers are idle
 
   // Interfaces
   virtual bool send_initial_context_setup_request(uint64_t imsi, uint16_t erab_to_setup);
@@ -134,6 +147,9 @@ private:
 
   static s1ap* m_instance;
 
+  // IMSI of the UE sending an Initial UE Message, from its S-TMSI or its Attach Request. 0 if unknown
+  uint64_t find_imsi_from_init_ue_msg(const asn1::s1ap::init_ue_msg_s& msg);
+
   uint32_t m_plmn;
 
   hss_interface_nas*                     m_hss;
@@ -141,17 +157,21 @@ private:
   std::map<int32_t, uint16_t>            m_sctp_to_enb_id;
   std::map<int32_t, std::set<uint32_t> > m_enb_assoc_to_ue_ids;
 
-  std::map<uint64_t, nas*> m_imsi_to_nas_ctx;
-  std::map<uint32_t, nas*> m_mme_ue_s1ap_id_to_nas_ctx;
+  // UE context tables, shared by all the workers and protected by m_ctx_mutex
+  std::mutex                         m_ctx_mutex;
+  std::unordered_map<uint64_t, nas*> m_imsi_to_nas_ctx;
+  std::unordered_map<uint32_t, nas*> m_mme_ue_s1ap_id_to_nas_ctx;
 
-  uint32_t m_next_mme_ue_s1ap_id;
-  uint32_t m_next_m_tmsi;
+  uint32_t              m_nof_shards;
+  std::vector<uint32_t> m_next_mme_ue_s1ap_id; // Next identifier of each shard, divided by the number of shards
+  uint32_t              m_next_m_tmsi;
 
   // GTP-C Interface
   mme_gtpc* m_mme_gtpc;
 
   // PCAP
   bool              m_pcap_enable;
+  std::mutex        m_pcap_mutex;
   srsran::s1ap_pcap m_pcap;
 };
 
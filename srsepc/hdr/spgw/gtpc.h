@@ -27,6 +27,7 @@
 #include "srsran/interfaces/epc_interfaces.h"
 #include "srsran/srslog/srslog.h"
 
+#include <mutex>
 #include <set>
 #include <sys/socket.h>
 #include <sys/un.h>
@@ -66,8 +67,11 @@ public:
       const srsran::gtpc_header&                                        header,
       const srsran::gtpc_downlink_data_notification_failure_indication& not_fail);
 
-  virtual bool queue_downlink_packet(uint32_t spgw_ctr_teid, srsran::unique_byte_buffer_t msg) override;
-  virtual bool send_downlink_data_notification(uint32_t spgw_ctr_teid) override;
+  virtual void handle_idle_ue_downlink_packet(uint32_t spgw_ctr_teid, srsran::unique_byte_buffer_t msg) override;
+
+  // Called with the GTP-C mutex held
+  bool queue_downlink_packet(uint32_t spgw_ctr_teid, srsran::unique_byte_buffer_t msg);
+  bool send_downlink_data_notification(uint32_t spgw_ctr_teid);
 
   spgw_tunnel_ctx_t* create_gtpc_ctx(const srsran::gtpc_create_session_request& cs_req);
   bool               delete_gtpc_ctx(uint32_t ctrl_teid);
@@ -85,6 +89,10 @@ public:
   uint64_t m_next_user_teid;
   uint32_t m_max_paging_queue;
 
+  // S11 signalling and the paging requests from the SGi thread share the GTP-C contexts.
+  // Always taken before the GTP-U tunnel mutex.
+  std::mutex m_mutex;
+
   std::map<uint64_t, uint32_t> m_imsi_to_ctr_teid;           // IMSI to control TEID map. Important to check if UE
                                                              // is previously connected
   std::map<uint32_t, spgw_tunnel_ctx*> m_teid_to_tunnel_ctx; // Map control TEID to tunnel ctx. Usefull to get
@@ -26,10 +26,16 @@
 #include "srsran/asn1/gtpc.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/standard_streams.h"
+#include "srsran/common/threads.h"
 #include "srsran/interfaces/epc_interfaces.h"
 #include "srsran/srslog/srslog.h"
+#include <atomic>
 #include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <queue>
+#include <unordered_map>
 
 namespace srsepc {
 
@@ -38,16 +44,23 @@ class spgw::gtpu : public gtpu_interface_gtpc
 public:
   gtpu();
   virtual ~gtpu();
-  int  init(spgw_args_t* args, spgw* spgw, gtpc_interface_gtpu* gtpc);
+  // An open SGi file descriptor, e.g. a socket in place of the TUN device, is used instead of creating the TUN device
+  int  init(spgw_args_t* args, spgw* spgw, gtpc_interface_gtpu* gtpc, int sgi = -1);
   void stop();
 
   int init_sgi(spgw_args_t* args);
+  int init_sgi(int sgi);
   int init_s1u(spgw_args_t* args);
   int get_sgi();
   int get_s1u();
 
-  void handle_sgi_pdu(srsran::unique_byte_buffer_t msg);
+  // The user plane runs on its own threads, one per direction, so that it is not delayed by GTP-C signalling
+  void run_s1u_thread();
+  void run_sgi_thread();
+
+  void handle_sgi_pdus(srsran::unique_byte_buffer_t* msgs, uint32_t nof_msgs);
   void handle_s1u_pdu(srsran::byte_buffer_t* msg);
+  bool write_s1u_header(const srsran::gtp_fteid_t& enb_fteid, srsran::byte_buffer_t* msg, struct sockaddr_in* enb_addr);
   void send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer_t* msg);
 
   virtual in_addr_t get_s1u_addr();
@@ -55,6 +68,7 @@ public:
   virtual bool modify_gtpu_tunnel(in_addr_t ue_ipv4, srsran::gtp_fteid_t dw_user_fteid, uint32_t up_ctr_fteid);
   virtual bool delete_gtpu_tunnel(in_addr_t ue_ipv4);
   virtual bool delete_gtpc_tunnel(in_addr_t ue_ipv4);
+  virtual bool send_downlink_pdu(in_addr_t ue_ipv4, srsran::byte_buffer_t* msg);
   virtual void send_all_queued_packets(srsran::gtp_fteid_t                       dw_user_fteid,
                                        std::queue<srsran::unique_byte_buffer_t>& pkt_queue);
 
@@ -68,10 +82,27 @@ public:
   int         m_s1u;
   sockaddr_in m_s1u_addr;
 
-  std::map<in_addr_t, srsran::gtp_fteid_t> m_ip_to_usr_teid; // Map IP to User-plane TEID for downlink traffic
-  std::map<in_addr_t, uint32_t>            m_ip_to_ctr_teid; // IP to control TEID map. Important to check if
-                                                             // UE is attached without an active user-plane
-                                                             // for downlink notifications.
+  // Tunnels are set up by GTP-C and looked up by the SGi thread, protected by m_tunnel_mutex
+  std::mutex                                         m_tunnel_mutex;
+  std::unordered_map<in_addr_t, srsran::gtp_fteid_t> m_ip_to_usr_teid; // Map IP to User-plane TEID for downlink traffic
+  std::unordered_map<in_addr_t, uint32_t>            m_ip_to_ctr_teid; // IP to control TEID map. Important to check if
+                                                                       // UE is attached without an active user-plane
+                                                                       // for downlink notifications.
+
+  class rx_thread : public srsran::thread
+  {
+  public:
+    rx_thread(const std::string& name_, std::function<void()> loop_) : thread(name_), loop(std::move(loop_)) {}
+    void run_thread() override { loop(); }
+
+  private:
+    std::function<void()> loop;
+  };
+
+  std::atomic<bool>          m_running;
+  int                        m_stop_fd; // Wakes up the user plane threads when stopping
+  std::unique_ptr<rx_thread> m_s1u_thread;
+  std::unique_ptr<rx_thread> m_sgi_thread;
 
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("GTPU");
 };
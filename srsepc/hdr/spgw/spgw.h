@@ -62,10 +62,10 @@ typedef struct spgw_tunnel_ctx {
 
 class spgw : public srsran::thread
 {
+public:
   class gtpc;
   class gtpu;
 
-public:
   static spgw* get_instance(void);
   static void  cleanup(void);
   int          init(spgw_args_t* args, const std::map<std::string, uint64_t>& ip_to_imsi);
@@ -21,13 +21,13 @@
 #include "srsepc/hdr/hss/hss.h"
 #include "srsran/common/security.h"
 #include "srsran/common/string_helpers.h"
+#include <algorithm>
 #include <arpa/inet.h>
 #include <inttypes.h> // for printing uint64_t
 #include <iomanip>
+#include <random>
 #include <sstream>
-#include <stdlib.h> /* srand, rand */
 #include <string>
-#include <time.h>
 
 namespace srsepc {
 
@@ -66,8 +66,6 @@ void hss::cleanup()
 
 int hss::init(hss_args_t* hss_args)
 {
-  srand(time(NULL));
-
   /*Read user information from DB*/
   if (read_db_file(hss_args->db_file) == false) {
     srsran::console("Error reading user database file %s\n", hss_args->db_file.c_str());
@@ -79,14 +77,46 @@ int hss::init(hss_args_t* hss_args)
 
   db_file = hss_args->db_file;
 
-  m_logger.info("HSS Initialized. DB file %s, MCC: %d, MNC: %d", hss_args->db_file.c_str(), mcc, mnc);
+  /*Apply the SQN updates of the previous run and start a new journal*/
+  sqn_journal_file = db_file + ".sqn";
+  if (read_sqn_journal(sqn_journal_file) && !write_db_file(db_file)) {
+    srsran::console("Error writing user database file %s\n", db_file.c_str());
+    return -1;
+  }
+  m_sqn_journal = fopen(sqn_journal_file.c_str(), "w");
+  if (m_sqn_journal == nullptr) {
+    srsran::console("Error opening SQN journal %s: %s\n", sqn_journal_file.c_str(), strerror(errno));
+    return -1;
+  }
+
+  m_nof_auth_vectors = std::min(hss_args->nof_auth_vectors, HSS_MAX_AUTH_VECTORS);
+  if (m_nof_auth_vectors > 0) {
+    // There is at most one pending precomputation per UE
+    m_auth_vectors_worker.reset(new srsran::task_worker("HSS_AV", std::max<size_t>(m_imsi_to_ue_ctx.size(), 1)));
+  }
+
+  m_logger.info("HSS Initialized. DB file %s, MCC: %d, MNC: %d, Precomputed vectors: %d",
+                hss_args->db_file.c_str(),
+                mcc,
+                mnc,
+                m_nof_auth_vectors);
   srsran::console("HSS Initialized.\n");
   return 0;
 }
 
 void hss::stop()
 {
-  write_db_file(db_file);
+  if (m_auth_vectors_worker != nullptr) {
+    m_auth_vectors_worker->stop();
+  }
+  if (m_sqn_journal != nullptr) {
+    fclose(m_sqn_journal);
+    m_sqn_journal = nullptr;
+    // The journal is only dropped once its updates are in the DB file
+    if (write_db_file(db_file)) {
+      remove(sqn_journal_file.c_str());
+    }
+  }
   return;
 }
 
@@ -189,11 +219,13 @@ bool hss::write_db_file(std::string db_filename)
 
   std::ofstream m_db_file;
 
-  m_db_file.open(db_filename.c_str(), std::ofstream::out);
+  // Write a temporary file and rename it, so that the DB is never left half written
+  std::string tmp_filename = db_filename + ".tmp";
+  m_db_file.open(tmp_filename.c_str(), std::ofstream::out);
   if (!m_db_file.is_open()) {
     return false;
   }
-  m_logger.info("Opened DB file: %s", db_filename.c_str());
+  m_logger.info("Opened DB file: %s", tmp_filename.c_str());
 
   // Write comment info
   m_db_file << "#                                                                                           \n"
@@ -216,44 +248,139 @@ bool hss::write_db_file(std::string db_filename)
             << "#                                                                                           \n"
             << "# Note: Lines starting by '#' are ignored and will be overwritten                           \n";
 
-  std::map<uint64_t, std::unique_ptr<hss_ue_ctx_t> >::iterator it = m_imsi_to_ue_ctx.begin();
-  while (it != m_imsi_to_ue_ctx.end()) {
-    m_db_file << it->second->name;
+  // Keep the users sorted by IMSI
+  std::vector<hss_ue_ctx_t*> ue_ctxs;
+  ue_ctxs.reserve(m_imsi_to_ue_ctx.size());
+  for (const auto& ue_ctx_it : m_imsi_to_ue_ctx) {
+    ue_ctxs.push_back(ue_ctx_it.second.get());
+  }
+  std::sort(ue_ctxs.begin(), ue_ctxs.end(), [](const hss_ue_ctx_t* a, const hss_ue_ctx_t* b) {
+    return a->imsi < b->imsi;
+  });
+
+  std::lock_guard<std::mutex> lock(m_sqn_mutex);
+  for (hss_ue_ctx_t* ue_ctx : ue_ctxs) {
+    m_db_file << ue_ctx->name;
     m_db_file << ",";
-    m_db_file << (it->second->algo == HSS_ALGO_XOR ? "xor" : "mil");
+    m_db_file << (ue_ctx->algo == HSS_ALGO_XOR ? "xor" : "mil");
     m_db_file << ",";
-    m_db_file << std::setfill('0') << std::setw(15) << it->second->imsi;
+    m_db_file << std::setfill('0') << std::setw(15) << ue_ctx->imsi;
     m_db_file << ",";
-    m_db_file << srsran::hex_string(it->second->key, 16);
+    m_db_file << srsran::hex_string(ue_ctx->key, 16);
     m_db_file << ",";
-    if (it->second->op_configured) {
+    if (ue_ctx->op_configured) {
       m_db_file << "op,";
-      m_db_file << srsran::hex_string(it->second->op, 16);
+      m_db_file << srsran::hex_string(ue_ctx->op, 16);
     } else {
       m_db_file << "opc,";
-      m_db_file << srsran::hex_string(it->second->opc, 16);
+      m_db_file << srsran::hex_string(ue_ctx->opc, 16);
     }
     m_db_file << ",";
-    m_db_file << srsran::hex_string(it->second->amf, 2);
+    m_db_file << srsran::hex_string(ue_ctx->amf, 2);
     m_db_file << ",";
-    m_db_file << srsran::hex_string(it->second->sqn, 6);
+    m_db_file << srsran::hex_string(ue_ctx->sqn, 6);
     m_db_file << ",";
-    m_db_file << it->second->qci;
-    if (it->second->static_ip_addr != "0.0.0.0") {
+    m_db_file << ue_ctx->qci;
+    if (ue_ctx->static_ip_addr != "0.0.0.0") {
       m_db_file << ",";
-      m_db_file << it->second->static_ip_addr;
+      m_db_file << ue_ctx->static_ip_addr;
     } else {
       m_db_file << ",dynamic";
     }
     m_db_file << std::endl;
-    it++;
   }
-  if (m_db_file.is_open()) {
-    m_db_file.close();
+  m_db_file.close();
+  if (m_db_file.fail() || rename(tmp_filename.c_str(), db_filename.c_str()) != 0) {
+    m_logger.error("Error writing DB file: %s", db_filename.c_str());
+    remove(tmp_filename.c_str());
+    return false;
   }
   return true;
 }
 
+bool hss::read_sqn_journal(std::string journal_filename)
+{
+  std::ifstream journal;
+
+  journal.open(journal_filename.c_str(), std::ifstream::in);
+  if (!journal.is_open()) {
+    return false;
+  }
+  m_logger.info("Opened SQN journal: %s", journal_filename.c_str());
+
+  // Each line holds the latest SQN of a UE, later lines override earlier ones
+  uint32_t    nof_updates = 0;
+  std::string line;
+  while (std::getline(journal, line)) {
+    std::vector<std::string> split = srsran::split_string(line, ',');
+    if (split.size() != 2 || split[1].length() != 12) {
+      // The last line may be truncated if the EPC did not exit cleanly
+      m_logger.warning("Ignoring malformed SQN journal entry: %s", line.c_str());
+      continue;
+    }
+    hss_ue_ctx_t* ue_ctx = get_ue_ctx(strtoull(split[0].c_str(), nullptr, 10));
+    if (ue_ctx != nullptr) {
+      srsran::get_uint_vec_from_hex_str(split[1], ue_ctx->sqn, 6);
+      nof_updates++;
+    }
+  }
+  m_logger.info("Applied %d SQN updates from journal", nof_updates);
+  return nof_updates > 0;
+}
+
+void hss::write_sqn_journal(const hss_ue_ctx_t* ue_ctx)
+{
+  if (m_sqn_journal == nullptr) {
+    return;
+  }
+  write_sqn_journal_entry(m_sqn_journal, ue_ctx);
+  fflush(m_sqn_journal);
+
+  m_sqn_journal_entries++;
+  if (m_sqn_journal_entries >= HSS_SQN_JOURNAL_MAX_ENTRIES_PER_UE * std::max<size_t>(m_imsi_to_ue_ctx.size(), 1)) {
+    compact_sqn_journal();
+  }
+}
+
+void hss::write_sqn_journal_entry(FILE* journal, const hss_ue_ctx_t* ue_ctx)
+{
+  fprintf(journal, "%015" PRIu64 ",", ue_ctx->imsi);
+  for (int i = 0; i < 6; i++) {
+    fprintf(journal, "%02x", ue_ctx->sqn[i]);
+  }
+  fprintf(journal, "\n");
+}
+
+void hss::compact_sqn_journal()
+{
+  // Replace the journal by the latest SQN of every UE. As with the DB file, a temporary file is renamed, so that a
+  // crash leaves either journal complete
+  std::string tmp_filename = sqn_journal_file + ".tmp";
+  FILE*       journal      = fopen(tmp_filename.c_str(), "w");
+  if (journal == nullptr) {
+    m_logger.error("Error compacting SQN journal %s: %s", sqn_journal_file.c_str(), strerror(errno));
+    return;
+  }
+  for (const auto& ue_ctx_it : m_imsi_to_ue_ctx) {
+    write_sqn_journal_entry(journal, ue_ctx_it.second.get());
+  }
+  if (fclose(journal) != 0 || rename(tmp_filename.c_str(), sqn_journal_file.c_str()) != 0) {
+    m_logger.error("Error compacting SQN journal %s: %s", sqn_journal_file.c_str(), strerror(errno));
+    remove(tmp_filename.c_str());
+    return;
+  }
+
+  // The open journal is the replaced file
+  fclose(m_sqn_journal);
+  m_sqn_journal = fopen(sqn_journal_file.c_str(), "a");
+  if (m_sqn_journal == nullptr) {
+    m_logger.error("Error opening SQN journal %s: %s", sqn_journal_file.c_str(), strerror(errno));
+    srsran::console("Error opening SQN journal %s: %s\n", sqn_journal_file.c_str(), strerror(errno));
+  }
+  m_sqn_journal_entries = m_imsi_to_ue_ctx.size();
+  m_logger.debug("Compacted SQN journal to %d entries", m_sqn_journal_entries);
+}
+
 bool hss::gen_auth_info_answer(uint64_t imsi, uint8_t* k_asme, uint8_t* autn, uint8_t* rand, uint8_t* xres)
 {
 
@@ -265,182 +392,192 @@ bool hss::gen_auth_info_answer(uint64_t imsi, uint8_t* k_asme, uint8_t* autn, ui
     return false;
   }
 
+  hss_auth_vector_t av;
+  uint8_t           sqn[6];
+  bool              precomputed = false;
+  {
+    std::lock_guard<std::mutex> lock(m_sqn_mutex);
+    if (!ue_ctx->auth_vectors.empty()) {
+      av = ue_ctx->auth_vectors.front();
+      ue_ctx->auth_vectors.pop_front();
+      ue_ctx->set_last_rand(av.rand);
+      precomputed = true;
+    } else {
+      // The vectors being precomputed have lower SQNs than this one. Discard them, so that the SQNs handed out to the
+      // UE always increase
+      if (ue_ctx->auth_vectors_pending) {
+        ue_ctx->auth_vectors_gen++;
+      }
+      reserve_ue_sqns(ue_ctx, 1, sqn);
+    }
+  }
+
+  if (precomputed) {
+    m_logger.debug("Using precomputed AUTH vector -- IMSI: %015" PRIu64 "", imsi);
+  } else {
+    gen_auth_vectors(ue_ctx, 1, sqn, &av);
+    std::lock_guard<std::mutex> lock(m_sqn_mutex);
+    ue_ctx->set_last_rand(av.rand);
+  }
+  schedule_auth_vectors(ue_ctx);
+
+  memcpy(k_asme, av.k_asme, 32);
+  memcpy(autn, av.autn, 16);
+  memcpy(rand, av.rand, 16);
+  memcpy(xres, av.xres, 16);
+  return true;
+}
+
+void hss::schedule_auth_vectors(hss_ue_ctx_t* ue_ctx)
+{
+  if (m_nof_auth_vectors == 0) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_sqn_mutex);
+    if (ue_ctx->auth_vectors_pending || ue_ctx->auth_vectors.size() >= m_nof_auth_vectors) {
+      return;
+    }
+    ue_ctx->auth_vectors_pending = true;
+  }
+  uint64_t imsi = ue_ctx->imsi;
+  m_auth_vectors_worker->push_task([this, imsi]() { precompute_auth_vectors(imsi); });
+}
+
+void hss::precompute_auth_vectors(uint64_t imsi)
+{
+  hss_ue_ctx_t* ue_ctx;
+  uint8_t       sqn[HSS_MAX_AUTH_VECTORS * 6];
+  uint32_t      nof_vectors;
+  uint32_t      gen;
+  {
+    std::lock_guard<std::mutex> lock(m_sqn_mutex);
+    ue_ctx = get_ue_ctx(imsi);
+    if (ue_ctx == nullptr) {
+      return;
+    }
+    nof_vectors = m_nof_auth_vectors - std::min(m_nof_auth_vectors, (uint32_t)ue_ctx->auth_vectors.size());
+    gen         = ue_ctx->auth_vectors_gen;
+    reserve_ue_sqns(ue_ctx, nof_vectors, sqn);
+  }
+
+  hss_auth_vector_t av[HSS_MAX_AUTH_VECTORS];
+  gen_auth_vectors(ue_ctx, nof_vectors, sqn, av);
+
+  std::lock_guard<std::mutex> lock(m_sqn_mutex);
+  ue_ctx->auth_vectors_pending = false;
+  if (gen != ue_ctx->auth_vectors_gen) {
+    m_logger.debug("Discarding AUTH vectors computed before SQN resync -- IMSI: %015" PRIu64 "", ue_ctx->imsi);
+    return;
+  }
+  ue_ctx->auth_vectors.insert(ue_ctx->auth_vectors.end(), av, av + nof_vectors);
+  m_logger.debug("Precomputed %d AUTH vectors -- IMSI: %015" PRIu64 "", nof_vectors, ue_ctx->imsi);
+}
+
+void hss::gen_auth_vectors(hss_ue_ctx_t* ue_ctx, uint32_t nof_vectors, uint8_t* sqn, hss_auth_vector_t* av)
+{
   switch (ue_ctx->algo) {
     case HSS_ALGO_XOR:
-      gen_auth_info_answer_xor(ue_ctx, k_asme, autn, rand, xres);
+      gen_auth_vectors_xor(ue_ctx, nof_vectors, sqn, av);
       break;
     case HSS_ALGO_MILENAGE:
-      gen_auth_info_answer_milenage(ue_ctx, k_asme, autn, rand, xres);
+      gen_auth_vectors_milenage(ue_ctx, nof_vectors, sqn, av);
       break;
   }
-  increment_ue_sqn(ue_ctx);
-  return true;
+
+  for (uint32_t n = 0; n < nof_vectors; n++) {
+    m_logger.debug(av[n].rand, 16, "User Rand : ");
+    m_logger.debug(av[n].xres, 8, "User XRES: ");
+    m_logger.debug(&sqn[6 * n], 6, "User SQN : ");
+    m_logger.debug(av[n].k_asme, 32, "User k_asme : ");
+    m_logger.debug(av[n].autn, 16, "User AUTN: ");
+  }
 }
 
-void hss::gen_auth_info_answer_milenage(hss_ue_ctx_t* ue_ctx,
-                                        uint8_t*      k_asme,
-                                        uint8_t*      autn,
-                                        uint8_t*      rand,
-                                        uint8_t*      xres)
+void hss::gen_auth_vectors_milenage(hss_ue_ctx_t*      ue_ctx,
+                                    uint32_t           nof_vectors,
+                                    uint8_t*           sqn,
+                                    hss_auth_vector_t* av)
 {
-  // Get K, AMF, OPC and SQN
+  // Get K, AMF and OPC
   uint8_t* k   = ue_ctx->key;
   uint8_t* amf = ue_ctx->amf;
   uint8_t* opc = ue_ctx->opc;
-  uint8_t* sqn = ue_ctx->sqn;
 
   // Temp variables
-  uint8_t ck[16];
-  uint8_t ik[16];
-  uint8_t ak[6];
-  uint8_t mac[8];
-
-  gen_rand(rand);
-
-  srsran::security_milenage_f2345(k, opc, rand, xres, ck, ik, ak);
+  uint8_t rand[HSS_MAX_AUTH_VECTORS * 16];
+  uint8_t res[HSS_MAX_AUTH_VECTORS * 8];
+  uint8_t ck[HSS_MAX_AUTH_VECTORS * 16];
+  uint8_t ik[HSS_MAX_AUTH_VECTORS * 16];
+  uint8_t ak[HSS_MAX_AUTH_VECTORS * 6];
+  uint8_t mac[HSS_MAX_AUTH_VECTORS * 8];
 
-  m_logger.debug(k, 16, "User Key : ");
-  m_logger.debug(opc, 16, "User OPc : ");
-  m_logger.debug(rand, 16, "User Rand : ");
-  m_logger.debug(xres, 8, "User XRES: ");
-  m_logger.debug(ck, 16, "User CK: ");
-  m_logger.debug(ik, 16, "User IK: ");
-  m_logger.debug(ak, 6, "User AK: ");
-
-  srsran::security_milenage_f1(k, opc, rand, sqn, amf, mac);
+  for (uint32_t n = 0; n < nof_vectors; n++) {
+    gen_rand(&rand[16 * n]);
+  }
 
-  m_logger.debug(sqn, 6, "User SQN : ");
-  m_logger.debug(mac, 8, "User MAC : ");
+  // All the vectors share K, so the AES round keys are only expanded once
+  srsran::security_milenage_f12345(k, opc, nof_vectors, rand, sqn, amf, mac, res, ck, ik, ak);
 
-  uint8_t ak_xor_sqn[6];
-  for (int i = 0; i < 6; i++) {
-    ak_xor_sqn[i] = sqn[i] ^ ak[i];
-  }
-  // Generate K_asme
-  srsran::security_generate_k_asme(ck, ik, ak_xor_sqn, mcc, mnc, k_asme);
+  for (uint32_t n = 0; n < nof_vectors; n++) {
+    memcpy(av[n].rand, &rand[16 * n], 16);
+    memcpy(av[n].xres, &res[8 * n], 8);
 
-  m_logger.debug("User MCC : %x  MNC : %x ", mcc, mnc);
-  m_logger.debug(k_asme, 32, "User k_asme : ");
+    // Generate AUTN (autn = sqn ^ ak |+| amf |+| mac)
+    for (int i = 0; i < 6; i++) {
+      av[n].autn[i] = sqn[6 * n + i] ^ ak[6 * n + i];
+    }
+    for (int i = 0; i < 2; i++) {
+      av[n].autn[6 + i] = amf[i];
+    }
+    for (int i = 0; i < 8; i++) {
+      av[n].autn[8 + i] = mac[8 * n + i];
+    }
 
-  // Generate AUTN (autn = sqn ^ ak |+| amf |+| mac)
-  for (int i = 0; i < 6; i++) {
-    autn[i] = sqn[i] ^ ak[i];
-  }
-  for (int i = 0; i < 2; i++) {
-    autn[6 + i] = amf[i];
-  }
-  for (int i = 0; i < 8; i++) {
-    autn[8 + i] = mac[i];
+    // Generate K_asme, the first 6 bytes of AUTN are SQN ^ AK
+    srsran::security_generate_k_asme(&ck[16 * n], &ik[16 * n], av[n].autn, mcc, mnc, av[n].k_asme);
   }
-  m_logger.debug(autn, 16, "User AUTN: ");
-
-  // Set last RAND
-  ue_ctx->set_last_rand(rand);
-  return;
 }
 
-void hss::gen_auth_info_answer_xor(hss_ue_ctx_t* ue_ctx, uint8_t* k_asme, uint8_t* autn, uint8_t* rand, uint8_t* xres)
+void hss::gen_auth_vectors_xor(hss_ue_ctx_t* ue_ctx, uint32_t nof_vectors, uint8_t* sqn, hss_auth_vector_t* av)
 {
-  // Get K, AMF, OPC and SQN
+  // Get K and AMF
   uint8_t* k   = ue_ctx->key;
   uint8_t* amf = ue_ctx->amf;
-  uint8_t* opc = ue_ctx->opc;
-  uint8_t* sqn = ue_ctx->sqn;
 
   // Temp variables
-  uint8_t xdout[16];
-  uint8_t cdout[8];
-
   uint8_t ck[16];
   uint8_t ik[16];
   uint8_t ak[6];
   uint8_t mac[8];
 
-  int i = 0;
-
-  // Gen RAND
-  gen_rand(rand);
-
-  // Use RAND and K to compute RES, CK, IK and AK
-  for (i = 0; i < 16; i++) {
-    xdout[i] = k[i] ^ rand[i];
-  }
+  for (uint32_t n = 0; n < nof_vectors; n++) {
+    // Gen RAND
+    gen_rand(av[n].rand);
 
-  for (i = 0; i < 16; i++) {
-    xres[i] = xdout[i];
-    ck[i]   = xdout[(i + 1) % 16];
-    ik[i]   = xdout[(i + 2) % 16];
-  }
-  for (i = 0; i < 6; i++) {
-    ak[i] = xdout[i + 3];
-  }
+    // Use RAND and K to compute RES, CK, IK, AK and MAC
+    srsran::security_xor_f2345(k, av[n].rand, av[n].xres, ck, ik, ak);
+    srsran::security_xor_f1(k, av[n].rand, &sqn[6 * n], amf, mac);
 
-  m_logger.debug(k, 16, "User Key : ");
-  m_logger.debug(opc, 16, "User OPc : ");
-  m_logger.debug(rand, 16, "User Rand : ");
-  m_logger.debug(xres, 8, "User XRES: ");
-  m_logger.debug(ck, 16, "User CK: ");
-  m_logger.debug(ik, 16, "User IK: ");
-  m_logger.debug(ak, 6, "User AK: ");
-
-  // Generate cdout
-  for (i = 0; i < 6; i++) {
-    cdout[i] = sqn[i];
-  }
-  for (i = 0; i < 2; i++) {
-    cdout[6 + i] = amf[i];
-  }
-
-  // Generate MAC
-  for (i = 0; i < 8; i++) {
-    mac[i] = xdout[i] ^ cdout[i];
-  }
-
-  m_logger.debug(sqn, 6, "User SQN : ");
-  m_logger.debug(mac, 8, "User MAC : ");
-
-  // Generate AUTN (autn = sqn ^ ak |+| amf |+| mac)
-  for (int i = 0; i < 6; i++) {
-    autn[i] = sqn[i] ^ ak[i];
-  }
-  for (int i = 0; i < 2; i++) {
-    autn[6 + i] = amf[i];
-  }
-  for (int i = 0; i < 8; i++) {
-    autn[8 + i] = mac[i];
-  }
-
-  uint8_t ak_xor_sqn[6];
-  for (int i = 0; i < 6; i++) {
-    ak_xor_sqn[i] = sqn[i] ^ ak[i];
-  }
-  // Generate K_asme
-  srsran::security_generate_k_asme(ck, ik, ak_xor_sqn, mcc, mnc, k_asme);
-
-  m_logger.debug("User MCC : %x  MNC : %x ", mcc, mnc);
-  m_logger.debug(k_asme, 32, "User k_asme : ");
+    // Generate AUTN (autn = sqn ^ ak |+| amf |+| mac)
+    for (int i = 0; i < 6; i++) {
+      av[n].autn[i] = sqn[6 * n + i] ^ ak[i];
+    }
+    for (int i = 0; i < 2; i++) {
+      av[n].autn[6 + i] = amf[i];
+    }
+    for (int i = 0; i < 8; i++) {
+      av[n].autn[8 + i] = mac[i];
+    }
 
-  // Generate AUTN (autn = sqn ^ ak |+| amf |+| mac)
-  for (int i = 0; i < 6; i++) {
-    autn[i] = sqn[i] ^ ak[i];
+    // Generate K_asme, the first 6 bytes of AUTN are SQN ^ AK
+    srsran::security_generate_k_asme(ck, ik, av[n].autn, mcc, mnc, av[n].k_asme);
   }
-  for (int i = 0; i < 2; i++) {
-    autn[6 + i] = amf[i];
-  }
-  for (int i = 0; i < 8; i++) {
-    autn[8 + i] = mac[i];
-  }
-
-  m_logger.debug(autn, 8, "User AUTN: ");
-
-  // Set last RAND
-  ue_ctx->set_last_rand(rand);
-  return;
 }
 
 bool hss::gen_update_loc_answer(uint64_t imsi, uint8_t* qci)
 {
-  std::map<uint64_t, std::unique_ptr<hss_ue_ctx_t> >::iterator ue_ctx_it = m_imsi_to_ue_ctx.find(imsi);
+  std::unordered_map<uint64_t, std::unique_ptr<hss_ue_ctx_t> >::iterator ue_ctx_it = m_imsi_to_ue_ctx.find(imsi);
   if (ue_ctx_it == m_imsi_to_ue_ctx.end()) {
     m_logger.info("User not found. IMSI: %015" PRIu64 "", imsi);
     srsran::console("User not found at HSS. IMSI: %015" PRIu64 "\n", imsi);
@@ -462,6 +599,7 @@ bool hss::resync_sqn(uint64_t imsi, uint8_t* auts)
     return false;
   }
 
+  std::lock_guard<std::mutex> lock(m_sqn_mutex);
   switch (ue_ctx->algo) {
     case HSS_ALGO_XOR:
       resync_sqn_xor(ue_ctx, auts);
@@ -472,6 +610,11 @@ bool hss::resync_sqn(uint64_t imsi, uint8_t* auts)
   }
 
   increment_seq_after_resync(ue_ctx);
+  write_sqn_journal(ue_ctx);
+
+  // Precomputed vectors use the old SQN
+  ue_ctx->auth_vectors.clear();
+  ue_ctx->auth_vectors_gen++;
   return true;
 }
 
@@ -535,6 +678,17 @@ void hss::resync_sqn_milenage(hss_ue_ctx_t* ue_ctx, uint8_t* auts)
   return;
 }
 
+void hss::reserve_ue_sqns(hss_ue_ctx_t* ue_ctx, uint32_t nof_sqns, uint8_t* sqn)
+{
+  for (uint32_t n = 0; n < nof_sqns; n++) {
+    memcpy(&sqn[6 * n], ue_ctx->sqn, 6);
+    increment_ue_sqn(ue_ctx);
+  }
+  if (nof_sqns > 0) {
+    write_sqn_journal(ue_ctx);
+  }
+}
+
 void hss::increment_ue_sqn(hss_ue_ctx_t* ue_ctx)
 {
   increment_sqn(ue_ctx->sqn, ue_ctx->sqn);
@@ -604,15 +758,18 @@ void hss::increment_seq_after_resync(hss_ue_ctx_t* ue_ctx)
 
 void hss::gen_rand(uint8_t rand_[16])
 {
+  // RANDs are generated by the NAS and precomputation threads concurrently, each one uses its own generator
+  static thread_local std::mt19937        generator(std::random_device{}());
+  std::uniform_int_distribution<uint32_t> dist(0, 255);
   for (int i = 0; i < 16; i++) {
-    rand_[i] = rand() % 256; // Pulls on byte at a time. It's slow, but does not depend on RAND_MAX.
+    rand_[i] = dist(generator);
   }
   return;
 }
 
 hss_ue_ctx_t* hss::get_ue_ctx(uint64_t imsi)
 {
-  std::map<uint64_t, std::unique_ptr<hss_ue_ctx_t> >::iterator ue_ctx_it = m_imsi_to_ue_ctx.find(imsi);
+  std::unordered_map<uint64_t, std::unique_ptr<hss_ue_ctx_t> >::iterator ue_ctx_it = m_imsi_to_ue_ctx.find(imsi);
   if (ue_ctx_it == m_imsi_to_ue_ctx.end()) {
     m_logger.info("User not found. IMSI: %015" PRIu64 "", imsi);
     return nullptr;
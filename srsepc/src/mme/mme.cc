@@ -20,9 +20,12 @@
  */
 
 #include "srsepc/hdr/mme/mme.h"
+#include "srsran/common/epoll_helper.h"
 #include <arpa/inet.h>
+#include <future>
 #include <inttypes.h> // for printing uint64_t
 #include <netinet/sctp.h>
+#include <sys/eventfd.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 
@@ -31,7 +34,16 @@ namespace srsepc {
 mme*            mme::m_instance    = NULL;
 pthread_mutex_t mme_instance_mutex = PTHREAD_MUTEX_INITIALIZER;
 
-mme::mme() : m_running(false), thread("MME")
+// Maximum number of pending S1AP, S11 and timer events per UE worker
+const uint32_t MME_WORKER_QUEUE_SIZE = 16384;
+
+// NAS timer events carry the timer type and IMSI instead of the fd, which may be closed and reused by the time the
+// event is handled. IMSIs take at most 50 bits
+const uint64_t MME_TIMER_EVENT_FLAG = 1ULL << 63;
+const uint32_t MME_TIMER_TYPE_SHIFT = 50;
+const uint64_t MME_TIMER_IMSI_MASK  = (1ULL << MME_TIMER_TYPE_SHIFT) - 1;
+
+mme::mme() : m_running(false), m_epoll_fd(-1), m_stop_fd(-1), thread("MME")
 {
   return;
 }
@@ -77,8 +89,28 @@ int mme::init(mme_args_t* args)
     exit(-1);
   }
 
+  /*Init S1-MME, S11, NAS timer and stop events*/
+  m_epoll_fd = epoll_create1(0);
+  m_stop_fd  = eventfd(0, EFD_NONBLOCK);
+  if (m_epoll_fd == -1 || m_stop_fd == -1 || add_epoll(m_s1ap->get_s1_mme(), m_epoll_fd) != SRSRAN_SUCCESS ||
+      add_epoll(m_mme_gtpc->get_s11(), m_epoll_fd) != SRSRAN_SUCCESS ||
+      add_epoll(m_stop_fd, m_epoll_fd) != SRSRAN_SUCCESS) {
+    srsran::console("Error initializing MME event polling\n");
+    exit(-1);
+  }
+
+  /*Init UE workers*/
+  m_s1ap->set_nof_workers(args->nof_workers);
+  for (uint32_t i = 0; i < args->nof_workers; i++) {
+    m_workers.emplace_back(new srsran::task_worker("MME_UE" + std::to_string(i), MME_WORKER_QUEUE_SIZE));
+    m_workers.back()->push_task([this, i]() { m_s1ap->set_worker_shard(i); });
+  }
+
   /*Log successful initialization*/
-  m_s1ap_logger.info("MME Initialized. MCC: 0x%x, MNC: 0x%x", args->s1ap_args.mcc, args->s1ap_args.mnc);
+  m_s1ap_logger.info("MME Initialized. MCC: 0x%x, MNC: 0x%x, UE workers: %d",
+                     args->s1ap_args.mcc,
+                     args->s1ap_args.mnc,
+                     args->nof_workers);
   srsran::console("MME Initialized. MCC: 0x%x, MNC: 0x%x\n", args->s1ap_args.mcc, args->s1ap_args.mnc);
   return 0;
 }
@@ -86,23 +118,35 @@ int mme::init(mme_args_t* args)
 void mme::stop()
 {
   if (m_running) {
+    // Stop receiving first, so that no more events are pushed to the UE workers
+    m_running     = false;
+    uint64_t stop = 1;
+    if (write(m_stop_fd, &stop, sizeof(stop)) == -1) {
+      m_s1ap_logger.error("Error waking up the MME thread: %s", strerror(errno));
+    }
+    wait_thread_finish();
+
+    // Finish the pending UE events before the UE contexts are deleted
+    sync_workers();
+    for (std::unique_ptr<srsran::task_worker>& worker : m_workers) {
+      worker->stop();
+    }
     m_s1ap->stop();
     m_s1ap->cleanup();
-    m_running = false;
-    thread_cancel();
-    wait_thread_finish();
+
+    for (mme_timer_t& timer : timers) {
+      close(timer.fd);
+    }
+    timers.clear();
+    close(m_stop_fd);
+    close(m_epoll_fd);
   }
   return;
 }
 
 void mme::run_thread()
 {
-  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer("mme::run_thread");
-  if (pdu == nullptr) {
-    m_s1ap_logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
-    return;
-  }
-  uint32_t                     sz  = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
+  uint32_t sz = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
 
   struct sockaddr_in     enb_addr;
   struct sctp_sndrcvinfo sri;
@@ -118,28 +162,40 @@ void mme::run_thread()
   int s1mme = m_s1ap->get_s1_mme();
   int s11   = m_mme_gtpc->get_s11();
 
+  const int          max_events = 32;
+  struct epoll_event events[max_events];
   while (m_running) {
-    pdu->clear();
-    int max_fd = std::max(s1mme, s11);
-
-    FD_ZERO(&m_set);
-    FD_SET(s1mme, &m_set);
-    FD_SET(s11, &m_set);
-
-    // Add timers to select
-    for (std::vector<mme_timer_t>::iterator it = timers.begin(); it != timers.end(); ++it) {
-      FD_SET(it->fd, &m_set);
-      max_fd = std::max(max_fd, it->fd);
-      m_s1ap_logger.debug("Adding Timer fd %d to fd_set", it->fd);
-    }
-
     m_s1ap_logger.debug("Waiting for S1-MME or S11 Message");
-    int n = select(max_fd + 1, &m_set, NULL, NULL, NULL);
+    int n = epoll_wait(m_epoll_fd, events, max_events, -1);
     if (n == -1) {
-      m_s1ap_logger.error("Error from select");
-    } else if (n) {
+      if (errno != EINTR) {
+        m_s1ap_logger.error("Error from epoll_wait: %s", strerror(errno));
+      }
+      continue;
+    }
+
+    for (int i = 0; i < n; i++) {
+      // Handle NAS Timers
+      if (events[i].data.u64 & MME_TIMER_EVENT_FLAG) {
+        handle_timer_expire((nas_timer_type)((events[i].data.u64 & ~MME_TIMER_EVENT_FLAG) >> MME_TIMER_TYPE_SHIFT),
+                            events[i].data.u64 & MME_TIMER_IMSI_MASK);
+        continue;
+      }
+
+      int fd = events[i].data.fd;
+      if (fd != s1mme && fd != s11) {
+        // Woken up by stop()
+        continue;
+      }
+
+      srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer("mme::run_thread");
+      if (pdu == nullptr) {
+        m_s1ap_logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
+        continue;
+      }
+
       // Handle S1-MME
-      if (FD_ISSET(s1mme, &m_set)) {
+      if (fd == s1mme) {
         rd_sz = sctp_recvmsg(s1mme, pdu->msg, sz, (struct sockaddr*)&enb_addr, &fromlen, &sri, &msg_flags);
         if (rd_sz == -1 && errno != EAGAIN) {
           m_s1ap_logger.error("Error reading from SCTP socket: %s", strerror(errno));
@@ -153,44 +209,113 @@ void mme::run_thread()
             if (notification->sn_header.sn_type == SCTP_SHUTDOWN_EVENT) {
               m_s1ap_logger.info("SCTP Association Shutdown. Association: %d", sri.sinfo_assoc_id);
               srsran::console("SCTP Association Shutdown. Association: %d\n", sri.sinfo_assoc_id);
+              sync_workers();
               m_s1ap->delete_enb_ctx(sri.sinfo_assoc_id);
             }
           } else {
             // Received data
             pdu->N_bytes = rd_sz;
             m_s1ap_logger.info("Received S1AP msg. Size: %d", pdu->N_bytes);
-            m_s1ap->handle_s1ap_rx_pdu(pdu.get(), &sri);
+            handle_s1ap_rx_pdu(std::move(pdu), sri);
           }
         }
       }
       // Handle S11
-      if (FD_ISSET(s11, &m_set)) {
+      if (fd == s11) {
         pdu->N_bytes = recvfrom(s11, pdu->msg, sz, 0, NULL, NULL);
-        m_mme_gtpc->handle_s11_pdu(pdu.get());
-      }
-      // Handle NAS Timers
-      for (std::vector<mme_timer_t>::iterator it = timers.begin(); it != timers.end();) {
-        if (FD_ISSET(it->fd, &m_set)) {
-          m_s1ap_logger.info("Timer expired");
-          uint64_t exp;
-          rd_sz = read(it->fd, &exp, sizeof(uint64_t));
-          m_s1ap->expire_nas_timer(it->type, it->imsi);
-          close(it->fd);
-          timers.erase(it);
-        } else {
-          ++it;
-        }
+        handle_s11_rx_pdu(std::move(pdu));
       }
-    } else {
-      m_s1ap_logger.debug("No data from select.");
     }
   }
   return;
 }
 
+void mme::handle_s1ap_rx_pdu(srsran::unique_byte_buffer_t pdu, const struct sctp_sndrcvinfo& enb_sri)
+{
+  std::unique_ptr<s1ap_rx_pdu_t> rx_pdu(new s1ap_rx_pdu_t);
+  if (not m_s1ap->unpack_s1ap_pdu(pdu.get(), &rx_pdu->pdu)) {
+    return;
+  }
+  rx_pdu->enb_sri = enb_sri;
+
+  int shard = m_workers.empty() ? -1 : m_s1ap->get_ue_shard(rx_pdu->pdu, enb_sri.sinfo_assoc_id);
+  if (shard < 0) {
+    // Non UE-associated procedures modify the eNB tables, they run once the UE workers are idle
+    sync_workers();
+    m_s1ap->handle_s1ap_rx_pdu(rx_pdu->pdu, &rx_pdu->enb_sri);
+    return;
+  }
+  m_workers[shard]->push_task([this, rx_pdu = std::move(rx_pdu)]() {
+    m_s1ap->handle_s1ap_rx_pdu(rx_pdu->pdu, &rx_pdu->enb_sri);
+  });
+}
+
+void mme::handle_s11_rx_pdu(srsran::unique_byte_buffer_t pdu)
+{
+  // S11 messages are routed to the worker of the UE owning the MME control TEID. Unknown TEIDs are rejected by the
+  // GTP-C handlers without touching any context
+  uint64_t imsi = 0;
+  if (m_workers.empty() ||
+      not m_mme_gtpc->get_imsi_from_ctrl_teid(((srsran::gtpc_pdu*)pdu->msg)->header.teid, &imsi)) {
+    m_mme_gtpc->handle_s11_pdu(pdu.get());
+    return;
+  }
+  m_workers[m_s1ap->get_ue_shard_from_imsi(imsi)]->push_task(
+      [this, pdu = std::move(pdu)]() { m_mme_gtpc->handle_s11_pdu(pdu.get()); });
+}
+
+void mme::sync_workers()
+{
+  // Every worker acknowledges once it has finished its pending events. Nothing else is queued meanwhile, since only
+  // this thread pushes events to the workers
+  std::vector<std::future<void> > idle;
+  for (std::unique_ptr<srsran::task_worker>& worker : m_workers) {
+    std::promise<void> promise;
+    idle.push_back(promise.get_future());
+    worker->push_task([promise = std::move(promise)]() mutable { promise.set_value(); });
+  }
+  for (std::future<void>& f : idle) {
+    f.wait();
+  }
+}
+
 /*
  * Timer Handling
  */
+void mme::handle_timer_expire(nas_timer_type type, uint64_t imsi)
+{
+  {
+    std::lock_guard<std::mutex>        lock(m_timers_mutex);
+    std::vector<mme_timer_t>::iterator it = timers.begin();
+    while (it != timers.end() && (it->type != type || it->imsi != imsi)) {
+      ++it;
+    }
+    if (it == timers.end()) {
+      // The timer was removed after it expired
+      return;
+    }
+    uint64_t exp;
+    if (read(it->fd, &exp, sizeof(uint64_t)) == -1) {
+      if (errno == EAGAIN) {
+        // The event belongs to a timer that was removed and restarted meanwhile, which has not expired yet
+        return;
+      }
+      m_s1ap_logger.warning("Error reading timer fd %d", it->fd);
+    }
+    m_s1ap_logger.info("Timer expired. IMSI %" PRIu64 ", Type %d", imsi, type);
+    del_epoll(it->fd, m_epoll_fd);
+    close(it->fd);
+    timers.erase(it);
+  }
+
+  if (m_workers.empty()) {
+    m_s1ap->expire_nas_timer(type, imsi);
+    return;
+  }
+  m_workers[m_s1ap->get_ue_shard_from_imsi(imsi)]->push_task(
+      [this, type, imsi]() { m_s1ap->expire_nas_timer(type, imsi); });
+}
+
 bool mme::add_nas_timer(int timer_fd, nas_timer_type type, uint64_t imsi)
 {
   m_s1ap_logger.debug("Adding NAS timer to MME. IMSI %" PRIu64 ", Type %d, Fd: %d", imsi, type, timer_fd);
@@ -200,12 +325,34 @@ bool mme::add_nas_timer(int timer_fd, nas_timer_type type, uint64_t imsi)
   timer.type = type;
   timer.imsi = imsi;
 
+  struct epoll_event event = {};
+  event.events             = EPOLLIN;
+  event.data.u64           = MME_TIMER_EVENT_FLAG | ((uint64_t)type << MME_TIMER_TYPE_SHIFT) | imsi;
+
+  std::lock_guard<std::mutex> lock(m_timers_mutex);
+
+  // A timer restarted before expiring replaces the previous one
+  for (std::vector<mme_timer_t>::iterator it = timers.begin(); it != timers.end(); ++it) {
+    if (it->type == type && it->imsi == imsi) {
+      del_epoll(it->fd, m_epoll_fd);
+      close(it->fd);
+      timers.erase(it);
+      break;
+    }
+  }
+  if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, timer_fd, &event) == -1) {
+    m_s1ap_logger.error("Error adding NAS timer to epoll: %s", strerror(errno));
+    close(timer_fd);
+    return false;
+  }
   timers.push_back(timer);
   return true;
 }
 
 bool mme::is_nas_timer_running(nas_timer_type type, uint64_t imsi)
 {
+  std::lock_guard<std::mutex> lock(m_timers_mutex);
+
   std::vector<mme_timer_t>::iterator it;
   for (it = timers.begin(); it != timers.end(); ++it) {
     if (it->type == type && it->imsi == imsi) {
@@ -217,6 +364,8 @@ bool mme::is_nas_timer_running(nas_timer_type type, uint64_t imsi)
 
 bool mme::remove_nas_timer(nas_timer_type type, uint64_t imsi)
 {
+  std::lock_guard<std::mutex> lock(m_timers_mutex);
+
   std::vector<mme_timer_t>::iterator it;
   for (it = timers.begin(); it != timers.end(); ++it) {
     if (it->type == type && it->imsi == imsi) {
@@ -230,7 +379,7 @@ bool mme::remove_nas_timer(nas_timer_type type, uint64_t imsi)
 
   // removing timer
   m_s1ap_logger.debug("Removing NAS timer from MME. IMSI %" PRIu64 ", Type %d, Fd: %d", imsi, type, it->fd);
-  FD_CLR(it->fd, &m_set);
+  del_epoll(it->fd, m_epoll_fd);
   close(it->fd);
   timers.erase(it);
   return true;
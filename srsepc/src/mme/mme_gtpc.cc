@@ -130,8 +130,22 @@ void mme_gtpc::handle_s11_pdu(srsran::byte_buffer_t* msg)
   return;
 }
 
+bool mme_gtpc::get_imsi_from_ctrl_teid(uint32_t mme_ctrl_teid, uint64_t* imsi)
+{
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+
+  std::map<uint32_t, uint64_t>::iterator it = m_mme_ctr_teid_to_imsi.find(mme_ctrl_teid);
+  if (it == m_mme_ctr_teid_to_imsi.end()) {
+    return false;
+  }
+  *imsi = it->second;
+  return true;
+}
+
 bool mme_gtpc::send_create_session_request(uint64_t imsi)
 {
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+
   m_logger.info("Sending Create Session Request.");
   srsran::console("Sending Create Session Request.\n");
   struct srsran::gtpc_pdu cs_req_pdu;
@@ -213,12 +227,11 @@ bool mme_gtpc::handle_create_session_response(srsran::gtpc_pdu* cs_resp_pdu)
   }
 
   // Get IMSI from the control TEID
-  std::map<uint32_t, uint64_t>::iterator id_it = m_mme_ctr_teid_to_imsi.find(cs_resp_pdu->header.teid);
-  if (id_it == m_mme_ctr_teid_to_imsi.end()) {
+  uint64_t imsi = 0;
+  if (not get_imsi_from_ctrl_teid(cs_resp_pdu->header.teid, &imsi)) {
     m_logger.warning("Could not find IMSI from Ctrl TEID.");
     return false;
   }
-  uint64_t imsi = id_it->second;
 
   m_logger.info("MME GTPC Ctrl TEID %" PRIu64 ", IMSI %" PRIu64 "", cs_resp_pdu->header.teid, imsi);
 
@@ -263,14 +276,17 @@ bool mme_gtpc::handle_create_session_response(srsran::gtpc_pdu* cs_resp_pdu)
   srsran::console("SPGW Allocated IP %s to IMSI %015" PRIu64 "\n", inet_ntoa(emm_ctx->ue_ip), emm_ctx->imsi);
 
   // Save SGW ctrl F-TEID in GTP-C context
-  std::map<uint64_t, struct gtpc_ctx>::iterator it_g = m_imsi_to_gtpc_ctx.find(imsi);
-  if (it_g == m_imsi_to_gtpc_ctx.end()) {
-    // Could not find GTP-C Context
-    m_logger.error("Could not find GTP-C context");
-    return false;
+  {
+    std::lock_guard<std::mutex>                   lock(m_ctx_mutex);
+    std::map<uint64_t, struct gtpc_ctx>::iterator it_g = m_imsi_to_gtpc_ctx.find(imsi);
+    if (it_g == m_imsi_to_gtpc_ctx.end()) {
+      // Could not find GTP-C Context
+      m_logger.error("Could not find GTP-C context");
+      return false;
+    }
+    gtpc_ctx_t* gtpc_ctx    = &it_g->second;
+    gtpc_ctx->sgw_ctr_fteid = sgw_ctr_fteid;
   }
-  gtpc_ctx_t* gtpc_ctx    = &it_g->second;
-  gtpc_ctx->sgw_ctr_fteid = sgw_ctr_fteid;
 
   // Set EPS bearer context
   // TODO default EPS bearer is hard-coded
@@ -284,6 +300,8 @@ bool mme_gtpc::handle_create_session_response(srsran::gtpc_pdu* cs_resp_pdu)
 
 bool mme_gtpc::send_modify_bearer_request(uint64_t imsi, uint16_t erab_to_modify, srsran::gtp_fteid_t* enb_fteid)
 {
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+
   m_logger.info("Sending GTP-C Modify bearer request");
   srsran::gtpc_pdu mb_req_pdu;
   std::memset(&mb_req_pdu, 0, sizeof(mb_req_pdu));
@@ -317,22 +335,24 @@ bool mme_gtpc::send_modify_bearer_request(uint64_t imsi, uint16_t erab_to_modify
 
 void mme_gtpc::handle_modify_bearer_response(srsran::gtpc_pdu* mb_resp_pdu)
 {
-  uint32_t                               mme_ctrl_teid = mb_resp_pdu->header.teid;
-  std::map<uint32_t, uint64_t>::iterator imsi_it       = m_mme_ctr_teid_to_imsi.find(mme_ctrl_teid);
-  if (imsi_it == m_mme_ctr_teid_to_imsi.end()) {
+  uint32_t mme_ctrl_teid = mb_resp_pdu->header.teid;
+  uint64_t imsi          = 0;
+  if (not get_imsi_from_ctrl_teid(mme_ctrl_teid, &imsi)) {
     m_logger.error("Could not find IMSI from control TEID");
     return;
   }
 
   uint8_t ebi = mb_resp_pdu->choice.modify_bearer_response.eps_bearer_context_modified.ebi;
   m_logger.debug("Activating EPS bearer with id %d", ebi);
-  m_s1ap->activate_eps_bearer(imsi_it->second, ebi);
+  m_s1ap->activate_eps_bearer(imsi, ebi);
 
   return;
 }
 
 bool mme_gtpc::send_delete_session_request(uint64_t imsi)
 {
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+
   m_logger.info("Sending GTP-C Delete Session Request request. IMSI %" PRIu64 "", imsi);
   srsran::gtpc_pdu del_req_pdu;
   std::memset(&del_req_pdu, 0, sizeof(del_req_pdu));
@@ -374,6 +394,8 @@ bool mme_gtpc::send_delete_session_request(uint64_t imsi)
 void mme_gtpc::send_release_access_bearers_request(uint64_t imsi)
 {
   // The GTP-C connection will not be torn down, just the user plane bearers.
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+
   m_logger.info("Sending GTP-C Release Access Bearers Request");
   srsran::gtpc_pdu rel_req_pdu;
   std::memset(&rel_req_pdu, 0, sizeof(rel_req_pdu));
@@ -406,8 +428,8 @@ bool mme_gtpc::handle_downlink_data_notification(srsran::gtpc_pdu* dl_not_pdu)
 {
   uint32_t                                 mme_ctrl_teid = dl_not_pdu->header.teid;
   srsran::gtpc_downlink_data_notification* dl_not        = &dl_not_pdu->choice.downlink_data_notification;
-  std::map<uint32_t, uint64_t>::iterator   imsi_it       = m_mme_ctr_teid_to_imsi.find(mme_ctrl_teid);
-  if (imsi_it == m_mme_ctr_teid_to_imsi.end()) {
+  uint64_t                                 imsi          = 0;
+  if (not get_imsi_from_ctrl_teid(mme_ctrl_teid, &imsi)) {
     m_logger.error("Could not find IMSI from control TEID");
     return false;
   }
@@ -417,14 +439,16 @@ bool mme_gtpc::handle_downlink_data_notification(srsran::gtpc_pdu* dl_not_pdu)
     return false;
   }
   uint8_t ebi = dl_not->eps_bearer_id;
-  m_logger.debug("Downlink Data Notification -- IMSI: %015" PRIu64 ", EBI %d", imsi_it->second, ebi);
+  m_logger.debug("Downlink Data Notification -- IMSI: %015" PRIu64 ", EBI %d", imsi, ebi);
 
-  m_s1ap->send_paging(imsi_it->second, ebi);
+  m_s1ap->send_paging(imsi, ebi);
   return true;
 }
 
 void mme_gtpc::send_downlink_data_notification_acknowledge(uint64_t imsi, enum srsran::gtpc_cause_value cause)
 {
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+
   m_logger.debug("Sending GTP-C Data Notification Acknowledge. Cause %d", cause);
   srsran::gtpc_pdu    not_ack_pdu;
   srsran::gtp_fteid_t sgw_ctr_fteid;
@@ -455,6 +479,8 @@ void mme_gtpc::send_downlink_data_notification_acknowledge(uint64_t imsi, enum s
 
 bool mme_gtpc::send_downlink_data_notification_failure_indication(uint64_t imsi, enum srsran::gtpc_cause_value cause)
 {
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+
   m_logger.debug("Sending GTP-C Data Notification Failure Indication. Cause %d", cause);
   srsran::gtpc_pdu    not_fail_pdu;
   srsran::gtp_fteid_t sgw_ctr_fteid;
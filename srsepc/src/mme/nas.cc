@@ -32,6 +32,7 @@
 namespace srsepc {
 
 nas::nas(const nas_init_t& args, const nas_if_t& itf) :
+  m_shard(s1ap::get_worker_shard()),
   m_gtpc(itf.gtpc),
   m_s1ap(itf.s1ap),
   m_hss(itf.hss),
@@ -2050,7 +2051,7 @@ bool nas::start_t3413()
     return false;
   }
 
-  int fdt = timerfd_create(CLOCK_MONOTONIC, 0);
+  int fdt = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
   if (fdt < 0) {
     m_logger.error("Error creating timer. %s", strerror(errno));
     return false;
@@ -22,6 +22,7 @@
 #include "srsepc/hdr/mme/s1ap.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/common/bcd_helpers.h"
+#include "srsran/common/int_helpers.h"
 #include "srsran/common/liblte_security.h"
 #include "srsran/common/network_utils.h"
 #include <cmath>
@@ -33,7 +34,10 @@ namespace srsepc {
 s1ap*           s1ap::m_instance    = NULL;
 pthread_mutex_t s1ap_instance_mutex = PTHREAD_MUTEX_INITIALIZER;
 
-s1ap::s1ap() : m_s1mme(-1), m_next_mme_ue_s1ap_id(1), m_mme_gtpc(NULL) {}
+// Shard of the UE worker running in the calling thread
+static thread_local uint32_t s1ap_worker_shard = 0;
+
+s1ap::s1ap() : m_s1mme(-1), m_nof_shards(1), m_next_mme_ue_s1ap_id(1, 1), m_mme_gtpc(NULL) {}
 
 s1ap::~s1ap()
 {
@@ -116,7 +120,7 @@ void s1ap::stop()
     m_active_enbs.erase(enb_it++);
   }
 
-  std::map<uint64_t, nas*>::iterator ue_it = m_imsi_to_nas_ctx.begin();
+  std::unordered_map<uint64_t, nas*>::iterator ue_it = m_imsi_to_nas_ctx.begin();
   while (ue_it != m_imsi_to_nas_ctx.end()) {
     m_logger.info("Deleting UE EMM context. IMSI: %015" PRIu64 "", ue_it->first);
     srsran::console("Deleting UE EMM context. IMSI: %015" PRIu64 "\n", ue_it->first);
@@ -143,7 +147,124 @@ int s1ap::get_s1_mme()
 
 uint32_t s1ap::get_next_mme_ue_s1ap_id()
 {
-  return m_next_mme_ue_s1ap_id++;
+  // Each worker only allocates identifiers mapping back to its own shard, no other thread uses its counter
+  uint32_t shard = s1ap_worker_shard;
+  return m_next_mme_ue_s1ap_id[shard]++ * m_nof_shards + shard;
+}
+
+void s1ap::set_nof_workers(uint32_t nof_workers)
+{
+  m_nof_shards = std::max(nof_workers, 1u);
+  m_next_mme_ue_s1ap_id.assign(m_nof_shards, 0);
+  m_next_mme_ue_s1ap_id[0] = 1; // MME UE S1AP Id 0 is not valid
+}
+
+void s1ap::set_worker_shard(uint32_t shard)
+{
+  s1ap_worker_shard = shard;
+}
+
+uint32_t s1ap::get_worker_shard()
+{
+  return s1ap_worker_shard;
+}
+
+int s1ap::get_ue_shard(const s1ap_pdu_t& pdu, int32_t enb_assoc)
+{
+  using init_msg_type_opts_t           = asn1::s1ap::s1ap_elem_procs_o::init_msg_c::types_opts;
+  using successful_outcome_type_opts_t = asn1::s1ap::s1ap_elem_procs_o::successful_outcome_c::types_opts;
+
+  uint32_t mme_ue_s1ap_id = 0;
+  if (pdu.type().value == s1ap_pdu_t::types_opts::init_msg) {
+    const asn1::s1ap::init_msg_s& msg = pdu.init_msg();
+    switch (msg.value.type().value) {
+      case init_msg_type_opts_t::init_ue_msg: {
+        // No MME UE S1AP Id yet. Known UEs go to the worker owning their context, which allocates an Id that maps back
+        // to itself. The rest are spread across the workers
+        uint64_t imsi = find_imsi_from_init_ue_msg(msg.value.init_ue_msg());
+        if (imsi != 0) {
+          return get_ue_shard_from_imsi(imsi);
+        }
+        return (msg.value.init_ue_msg()->enb_ue_s1ap_id.value.value + (uint32_t)enb_assoc * 0x9e3779b1u) %
+               m_nof_shards;
+      }
+      case init_msg_type_opts_t::ul_nas_transport:
+        mme_ue_s1ap_id = msg.value.ul_nas_transport()->mme_ue_s1ap_id.value.value;
+        break;
+      case init_msg_type_opts_t::ue_context_release_request:
+        mme_ue_s1ap_id = msg.value.ue_context_release_request()->mme_ue_s1ap_id.value.value;
+        break;
+      case init_msg_type_opts_t::ue_cap_info_ind:
+        mme_ue_s1ap_id = msg.value.ue_cap_info_ind()->mme_ue_s1ap_id.value.value;
+        break;
+      default:
+        return -1;
+    }
+  } else if (pdu.type().value == s1ap_pdu_t::types_opts::successful_outcome) {
+    const asn1::s1ap::successful_outcome_s& msg = pdu.successful_outcome();
+    switch (msg.value.type().value) {
+      case successful_outcome_type_opts_t::init_context_setup_resp:
+        mme_ue_s1ap_id = msg.value.init_context_setup_resp()->mme_ue_s1ap_id.value.value;
+        break;
+      case successful_outcome_type_opts_t::ue_context_release_complete:
+        mme_ue_s1ap_id = msg.value.ue_context_release_complete()->mme_ue_s1ap_id.value.value;
+        break;
+      default:
+        return -1;
+    }
+  } else {
+    return -1;
+  }
+  return mme_ue_s1ap_id % m_nof_shards;
+}
+
+int s1ap::get_ue_shard_from_imsi(uint64_t imsi)
+{
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+
+  // The shard of a context does not change, whether the UE is connected or idle. UEs without context are created by
+  // the worker of their IMSI
+  std::unordered_map<uint64_t, nas*>::iterator it = m_imsi_to_nas_ctx.find(imsi);
+  if (it == m_imsi_to_nas_ctx.end()) {
+    return imsi % m_nof_shards;
+  }
+  return it->second->m_shard;
+}
+
+uint64_t s1ap::find_imsi_from_init_ue_msg(const asn1::s1ap::init_ue_msg_s& msg)
+{
+  // UEs with a valid GUTI provide their S-TMSI
+  if (msg->s_tmsi_present) {
+    uint32_t m_tmsi = 0;
+    srsran::uint8_to_uint32(msg->s_tmsi.value.m_tmsi.data(), &m_tmsi);
+    return find_imsi_from_m_tmsi(m_tmsi);
+  }
+
+  // Otherwise, only the Attach Request carries an identity
+  srsran::unique_byte_buffer_t nas_msg = srsran::make_byte_buffer();
+  if (nas_msg == nullptr || msg->nas_pdu.value.size() > nas_msg->get_tailroom()) {
+    return 0;
+  }
+  memcpy(nas_msg->msg, msg->nas_pdu.value.data(), msg->nas_pdu.value.size());
+  nas_msg->N_bytes = msg->nas_pdu.value.size();
+
+  uint8_t pd, msg_type;
+  liblte_mme_parse_msg_header((LIBLTE_BYTE_MSG_STRUCT*)nas_msg.get(), &pd, &msg_type);
+  LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT attach_req = {};
+  if (msg_type != LIBLTE_MME_MSG_TYPE_ATTACH_REQUEST ||
+      liblte_mme_unpack_attach_request_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_msg.get(), &attach_req) != LIBLTE_SUCCESS) {
+    return 0;
+  }
+  if (attach_req.eps_mobile_id.type_of_id == LIBLTE_MME_EPS_MOBILE_ID_TYPE_GUTI) {
+    return find_imsi_from_m_tmsi(attach_req.eps_mobile_id.guti.m_tmsi);
+  }
+  uint64_t imsi = 0;
+  if (attach_req.eps_mobile_id.type_of_id == LIBLTE_MME_EPS_MOBILE_ID_TYPE_IMSI) {
+    for (int i = 0; i <= 14; i++) {
+      imsi += attach_req.eps_mobile_id.imsi[i] * std::pow(10, 14 - i);
+    }
+  }
+  return imsi;
 }
 
 int s1ap::enb_listen()
@@ -223,27 +344,32 @@ bool s1ap::s1ap_tx_pdu(const asn1::s1ap::s1ap_pdu_c& pdu, struct sctp_sndrcvinfo
   }
 
   if (m_pcap_enable) {
+    std::lock_guard<std::mutex> lock(m_pcap_mutex);
     m_pcap.write_s1ap(buf->msg, buf->N_bytes);
   }
 
   return true;
 }
 
-void s1ap::handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu, struct sctp_sndrcvinfo* enb_sri)
+bool s1ap::unpack_s1ap_pdu(srsran::byte_buffer_t* pdu, s1ap_pdu_t* rx_pdu)
 {
   // Save PCAP
   if (m_pcap_enable) {
+    std::lock_guard<std::mutex> lock(m_pcap_mutex);
     m_pcap.write_s1ap(pdu->msg, pdu->N_bytes);
   }
 
-  // Get PDU type
-  s1ap_pdu_t     rx_pdu;
   asn1::cbit_ref bref(pdu->msg, pdu->N_bytes);
-  if (rx_pdu.unpack(bref) != asn1::SRSASN_SUCCESS) {
+  if (rx_pdu->unpack(bref) != asn1::SRSASN_SUCCESS) {
     m_logger.error("Failed to unpack received PDU");
-    return;
+    return false;
   }
+  return true;
+}
 
+void s1ap::handle_s1ap_rx_pdu(const s1ap_pdu_t& rx_pdu, struct sctp_sndrcvinfo* enb_sri)
+{
+  // Get PDU type
   switch (rx_pdu.type().value) {
     case s1ap_pdu_t::types_opts::init_msg:
       m_logger.info("Received Initiating PDU");
@@ -319,6 +445,8 @@ void s1ap::add_new_enb_ctx(const enb_ctx_t& enb_ctx, const struct sctp_sndrcvinf
   *enb_ptr                   = enb_ctx;
   m_active_enbs.insert(std::pair<uint16_t, enb_ctx_t*>(enb_ptr->enb_id, enb_ptr));
   m_sctp_to_enb_id.insert(std::pair<int32_t, uint16_t>(enb_sri->sinfo_assoc_id, enb_ptr->enb_id));
+
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
   m_enb_assoc_to_ue_ids.insert(std::pair<int32_t, std::set<uint32_t> >(enb_sri->sinfo_assoc_id, ue_set));
 }
 
@@ -335,10 +463,14 @@ enb_ctx_t* s1ap::find_enb_ctx(uint16_t enb_id)
 void s1ap::delete_enb_ctx(int32_t assoc_id)
 {
   std::map<int32_t, uint16_t>::iterator it_assoc = m_sctp_to_enb_id.find(assoc_id);
-  uint16_t                              enb_id   = it_assoc->second;
+  if (it_assoc == m_sctp_to_enb_id.end()) {
+    m_logger.error("Could not find eNB to delete. Association: %d", assoc_id);
+    return;
+  }
+  uint16_t enb_id = it_assoc->second;
 
   std::map<uint16_t, enb_ctx_t*>::iterator it_ctx = m_active_enbs.find(enb_id);
-  if (it_ctx == m_active_enbs.end() || it_assoc == m_sctp_to_enb_id.end()) {
+  if (it_ctx == m_active_enbs.end()) {
     m_logger.error("Could not find eNB to delete. Association: %d", assoc_id);
     return;
   }
@@ -346,8 +478,12 @@ void s1ap::delete_enb_ctx(int32_t assoc_id)
   m_logger.info("Deleting eNB context. eNB Id: 0x%x", enb_id);
   srsran::console("Deleting eNB context. eNB Id: 0x%x\n", enb_id);
 
-  // Delete connected UEs ctx
+  // Delete connected UEs ctx. The association may be reused by the next eNB
   release_ues_ecm_ctx_in_enb(assoc_id);
+  {
+    std::lock_guard<std::mutex> lock(m_ctx_mutex);
+    m_enb_assoc_to_ue_ids.erase(assoc_id);
+  }
 
   // Delete eNB
   delete it_ctx->second;
@@ -359,13 +495,16 @@ void s1ap::delete_enb_ctx(int32_t assoc_id)
 // UE Context Management
 bool s1ap::add_nas_ctx_to_imsi_map(nas* nas_ctx)
 {
-  std::map<uint64_t, nas*>::iterator ctx_it = m_imsi_to_nas_ctx.find(nas_ctx->m_emm_ctx.imsi);
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+
+  std::unordered_map<uint64_t, nas*>::iterator ctx_it = m_imsi_to_nas_ctx.find(nas_ctx->m_emm_ctx.imsi);
   if (ctx_it != m_imsi_to_nas_ctx.end()) {
     m_logger.error("UE Context already exists. IMSI %015" PRIu64 "", nas_ctx->m_emm_ctx.imsi);
     return false;
   }
   if (nas_ctx->m_ecm_ctx.mme_ue_s1ap_id != 0) {
-    std::map<uint32_t, nas*>::iterator ctx_it2 = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
+    std::unordered_map<uint32_t, nas*>::iterator ctx_it2 =
+        m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
     if (ctx_it2 != m_mme_ue_s1ap_id_to_nas_ctx.end() && ctx_it2->second != nas_ctx) {
       m_logger.error("Context identified with IMSI does not match context identified by MME UE S1AP Id.");
       return false;
@@ -382,13 +521,18 @@ bool s1ap::add_nas_ctx_to_mme_ue_s1ap_id_map(nas* nas_ctx)
     m_logger.error("Could not add UE context to MME UE S1AP map. MME UE S1AP ID 0 is not valid.");
     return false;
   }
-  std::map<uint32_t, nas*>::iterator ctx_it = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
+
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+
+  std::unordered_map<uint32_t, nas*>::iterator ctx_it =
+      m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
   if (ctx_it != m_mme_ue_s1ap_id_to_nas_ctx.end()) {
     m_logger.error("UE Context already exists. MME UE S1AP Id %015" PRIu64 "", nas_ctx->m_emm_ctx.imsi);
     return false;
   }
   if (nas_ctx->m_emm_ctx.imsi != 0) {
-    std::map<uint32_t, nas*>::iterator ctx_it2 = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
+    std::unordered_map<uint32_t, nas*>::iterator ctx_it2 =
+        m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
     if (ctx_it2 != m_mme_ue_s1ap_id_to_nas_ctx.end() && ctx_it2->second != nas_ctx) {
       m_logger.error("Context identified with MME UE S1AP Id does not match context identified by IMSI.");
       return false;
@@ -401,6 +545,8 @@ bool s1ap::add_nas_ctx_to_mme_ue_s1ap_id_map(nas* nas_ctx)
 
 bool s1ap::add_ue_to_enb_set(int32_t enb_assoc, uint32_t mme_ue_s1ap_id)
 {
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+
   std::map<int32_t, std::set<uint32_t> >::iterator ues_in_enb = m_enb_assoc_to_ue_ids.find(enb_assoc);
   if (ues_in_enb == m_enb_assoc_to_ue_ids.end()) {
     m_logger.error("Could not find eNB from eNB SCTP association %d", enb_assoc);
@@ -418,7 +564,9 @@ bool s1ap::add_ue_to_enb_set(int32_t enb_assoc, uint32_t mme_ue_s1ap_id)
 
 nas* s1ap::find_nas_ctx_from_mme_ue_s1ap_id(uint32_t mme_ue_s1ap_id)
 {
-  std::map<uint32_t, nas*>::iterator it = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+
+  std::unordered_map<uint32_t, nas*>::iterator it = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
   if (it == m_mme_ue_s1ap_id_to_nas_ctx.end()) {
     return NULL;
   } else {
@@ -428,7 +576,9 @@ nas* s1ap::find_nas_ctx_from_mme_ue_s1ap_id(uint32_t mme_ue_s1ap_id)
 
 nas* s1ap::find_nas_ctx_from_imsi(uint64_t imsi)
 {
-  std::map<uint64_t, nas*>::iterator it = m_imsi_to_nas_ctx.find(imsi);
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+
+  std::unordered_map<uint64_t, nas*>::iterator it = m_imsi_to_nas_ctx.find(imsi);
   if (it == m_imsi_to_nas_ctx.end()) {
     return NULL;
   } else {
@@ -439,15 +589,25 @@ nas* s1ap::find_nas_ctx_from_imsi(uint64_t imsi)
 void s1ap::release_ues_ecm_ctx_in_enb(int32_t enb_assoc)
 {
   srsran::console("Releasing UEs context\n");
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+
   std::map<int32_t, std::set<uint32_t> >::iterator ues_in_enb = m_enb_assoc_to_ue_ids.find(enb_assoc);
-  std::set<uint32_t>::iterator                     ue_id      = ues_in_enb->second.begin();
+  if (ues_in_enb == m_enb_assoc_to_ue_ids.end()) {
+    m_logger.error("Could not find eNB from eNB SCTP association %d", enb_assoc);
+    return;
+  }
+  std::set<uint32_t>::iterator ue_id = ues_in_enb->second.begin();
   if (ue_id == ues_in_enb->second.end()) {
     srsran::console("No UEs to be released\n");
   } else {
     while (ue_id != ues_in_enb->second.end()) {
-      std::map<uint32_t, nas*>::iterator nas_ctx = m_mme_ue_s1ap_id_to_nas_ctx.find(*ue_id);
-      emm_ctx_t*                         emm_ctx = &nas_ctx->second->m_emm_ctx;
-      ecm_ctx_t*                         ecm_ctx = &nas_ctx->second->m_ecm_ctx;
+      std::unordered_map<uint32_t, nas*>::iterator nas_ctx = m_mme_ue_s1ap_id_to_nas_ctx.find(*ue_id);
+      if (nas_ctx == m_mme_ue_s1ap_id_to_nas_ctx.end()) {
+        ues_in_enb->second.erase(ue_id++);
+        continue;
+      }
+      emm_ctx_t* emm_ctx = &nas_ctx->second->m_emm_ctx;
+      ecm_ctx_t* ecm_ctx = &nas_ctx->second->m_ecm_ctx;
 
       m_logger.info(
           "Releasing UE context. IMSI: %015" PRIu64 ", UE-MME S1AP Id: %d", emm_ctx->imsi, ecm_ctx->mme_ue_s1ap_id);
@@ -459,6 +619,7 @@ void s1ap::release_ues_ecm_ctx_in_enb(int32_t enb_assoc)
       ecm_ctx->state          = ECM_STATE_IDLE;
       ecm_ctx->mme_ue_s1ap_id = 0;
       ecm_ctx->enb_ue_s1ap_id = 0;
+      m_mme_ue_s1ap_id_to_nas_ctx.erase(nas_ctx);
       ues_in_enb->second.erase(ue_id++);
     }
   }
@@ -473,6 +634,8 @@ bool s1ap::release_ue_ecm_ctx(uint32_t mme_ue_s1ap_id)
   }
   ecm_ctx_t* ecm_ctx = &nas_ctx->m_ecm_ctx;
 
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+
   // Delete UE within eNB UE set
   std::map<int32_t, uint16_t>::iterator it = m_sctp_to_enb_id.find(ecm_ctx->enb_sri.sinfo_assoc_id);
   if (it == m_sctp_to_enb_id.end()) {
@@ -511,7 +674,10 @@ bool s1ap::delete_ue_ctx(uint64_t imsi)
   }
 
   // Delete UE context
-  m_imsi_to_nas_ctx.erase(imsi);
+  {
+    std::lock_guard<std::mutex> lock(m_ctx_mutex);
+    m_imsi_to_nas_ctx.erase(imsi);
+  }
   delete nas_ctx;
   m_logger.info("Deleted UE Context.");
   return true;
@@ -520,21 +686,20 @@ bool s1ap::delete_ue_ctx(uint64_t imsi)
 // UE Bearer Managment
 void s1ap::activate_eps_bearer(uint64_t imsi, uint8_t ebi)
 {
-  std::map<uint64_t, nas*>::iterator ue_ctx_it = m_imsi_to_nas_ctx.find(imsi);
-  if (ue_ctx_it == m_imsi_to_nas_ctx.end()) {
+  nas* nas_ctx = find_nas_ctx_from_imsi(imsi);
+  if (nas_ctx == NULL) {
     m_logger.error("Could not activate EPS bearer: Could not find UE context");
     return;
   }
   // Make sure NAS is active
-  uint32_t                           mme_ue_s1ap_id = ue_ctx_it->second->m_ecm_ctx.mme_ue_s1ap_id;
-  std::map<uint32_t, nas*>::iterator it             = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
-  if (it == m_mme_ue_s1ap_id_to_nas_ctx.end()) {
+  uint32_t mme_ue_s1ap_id = nas_ctx->m_ecm_ctx.mme_ue_s1ap_id;
+  if (find_nas_ctx_from_mme_ue_s1ap_id(mme_ue_s1ap_id) == NULL) {
     m_logger.error("Could not activate EPS bearer: ECM context seems to be missing");
     return;
   }
 
-  ecm_ctx_t* ecm_ctx = &ue_ctx_it->second->m_ecm_ctx;
-  esm_ctx_t* esm_ctx = &ue_ctx_it->second->m_esm_ctx[ebi];
+  ecm_ctx_t* ecm_ctx = &nas_ctx->m_ecm_ctx;
+  esm_ctx_t* esm_ctx = &nas_ctx->m_esm_ctx[ebi];
   if (esm_ctx->state != ERAB_CTX_SETUP) {
     m_logger.error(
         "Could not be activate EPS Bearer, bearer in wrong state: MME S1AP Id %d, EPS Bearer id %d, state %d",
@@ -557,6 +722,8 @@ void s1ap::activate_eps_bearer(uint64_t imsi, uint8_t ebi)
 
 uint32_t s1ap::allocate_m_tmsi(uint64_t imsi)
 {
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+
   uint32_t m_tmsi = m_next_m_tmsi;
   m_next_m_tmsi   = (m_next_m_tmsi + 1) % UINT32_MAX;
 
@@ -567,7 +734,9 @@ uint32_t s1ap::allocate_m_tmsi(uint64_t imsi)
 
 uint64_t s1ap::find_imsi_from_m_tmsi(uint32_t m_tmsi)
 {
-  std::map<uint32_t, uint64_t>::iterator it = m_tmsi_to_imsi.find(m_tmsi);
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+
+  std::unordered_map<uint32_t, uint64_t>::iterator it = m_tmsi_to_imsi.find(m_tmsi);
   if (it != m_tmsi_to_imsi.end()) {
     m_logger.debug("Found IMSI %015" PRIu64 " from M-TMSI 0x%x", it->second, m_tmsi);
     return it->second;
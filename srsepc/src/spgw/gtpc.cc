@@ -150,6 +150,8 @@ bool spgw::gtpc::send_s11_pdu(const srsran::gtpc_pdu& pdu)
 
 void spgw::gtpc::handle_s11_pdu(srsran::byte_buffer_t* msg)
 {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
   // TODO add deserialization code here
   srsran::gtpc_pdu* pdu = (srsran::gtpc_pdu*)msg->msg;
   srsran::console("Received GTP-C PDU. Message type: %s\n", srsran::gtpc_msg_type_to_str(pdu->header.type));
@@ -334,6 +336,26 @@ void spgw::gtpc::handle_release_access_bearers_request(const srsran::gtpc_header
   return;
 }
 
+void spgw::gtpc::handle_idle_ue_downlink_packet(uint32_t spgw_ctr_teid, srsran::unique_byte_buffer_t msg)
+{
+  // The user plane tunnel is looked up again under the same lock as the Modify Bearer Request. Otherwise, the packet
+  // could be queued right after the queue was flushed to the reconnected UE, and stay there
+  std::lock_guard<std::mutex> lock(m_mutex);
+  std::map<uint32_t, spgw_tunnel_ctx_t*>::iterator tunnel_it = m_teid_to_tunnel_ctx.find(spgw_ctr_teid);
+  if (tunnel_it == m_teid_to_tunnel_ctx.end()) {
+    m_logger.warning("Could not find TEID 0x%x to handle downlink packet.", spgw_ctr_teid);
+    return;
+  }
+  if (m_gtpu->send_downlink_pdu(tunnel_it->second->ue_ipv4, msg.get())) {
+    // The UE was connected meanwhile
+    return;
+  }
+
+  m_logger.debug("Triggering Downlink Notification Request.");
+  send_downlink_data_notification(spgw_ctr_teid);
+  queue_downlink_packet(spgw_ctr_teid, std::move(msg));
+}
+
 bool spgw::gtpc::send_downlink_data_notification(uint32_t spgw_ctr_teid)
 {
   m_logger.debug("Sending Downlink Notification Request");
@@ -21,6 +21,7 @@
 
 #include "srsepc/hdr/spgw/gtpu.h"
 #include "srsepc/hdr/mme/mme_gtpc.h"
+#include "srsran/common/epoll_helper.h"
 #include "srsran/common/string_helpers.h"
 #include "srsran/common/network_utils.h"
 #include "srsran/upper/gtpu.h"
@@ -32,11 +33,15 @@
 #include <linux/if_tun.h>
 #include <linux/ip.h>
 #include <netinet/in.h>
+#include <sys/eventfd.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 
 namespace srsepc {
 
+// Maximum number of packets read or sent with a single system call
+const uint32_t GTPU_BATCH_SIZE = 32;
+
 /**************************************
  *
  * GTP-U class that handles the packet
@@ -44,7 +49,7 @@ namespace srsepc {
  *
  **************************************/
 
-spgw::gtpu::gtpu() : m_sgi_up(false), m_s1u_up(false)
+spgw::gtpu::gtpu() : m_sgi_up(false), m_s1u_up(false), m_running(false), m_stop_fd(-1)
 {
   return;
 }
@@ -54,7 +59,7 @@ spgw::gtpu::~gtpu()
   return;
 }
 
-int spgw::gtpu::init(spgw_args_t* args, spgw* spgw, gtpc_interface_gtpu* gtpc)
+int spgw::gtpu::init(spgw_args_t* args, spgw* spgw, gtpc_interface_gtpu* gtpc, int sgi)
 {
   int err;
 
@@ -63,7 +68,7 @@ int spgw::gtpu::init(spgw_args_t* args, spgw* spgw, gtpc_interface_gtpu* gtpc)
   m_gtpc = gtpc;
 
   // Init SGi interface
-  err = init_sgi(args);
+  err = sgi < 0 ? init_sgi(args) : init_sgi(sgi);
   if (err != SRSRAN_SUCCESS) {
     srsran::console("Could not initialize the SGi interface.\n");
     return err;
@@ -76,6 +81,18 @@ int spgw::gtpu::init(spgw_args_t* args, spgw* spgw, gtpc_interface_gtpu* gtpc)
     return err;
   }
 
+  // Start the user plane threads
+  m_stop_fd = eventfd(0, 0);
+  if (m_stop_fd < 0) {
+    m_logger.error("Failed to create eventfd: %s", strerror(errno));
+    return SRSRAN_ERROR_CANT_START;
+  }
+  m_running    = true;
+  m_s1u_thread = std::unique_ptr<rx_thread>(new rx_thread("SPGW_S1U", [this]() { run_s1u_thread(); }));
+  m_sgi_thread = std::unique_ptr<rx_thread>(new rx_thread("SPGW_SGI", [this]() { run_sgi_thread(); }));
+  m_s1u_thread->start();
+  m_sgi_thread->start();
+
   m_logger.info("SPGW GTP-U Initialized.");
   srsran::console("SPGW GTP-U Initialized.\n");
   return SRSRAN_SUCCESS;
@@ -83,6 +100,18 @@ int spgw::gtpu::init(spgw_args_t* args, spgw* spgw, gtpc_interface_gtpu* gtpc)
 
 void spgw::gtpu::stop()
 {
+  // Stop the user plane threads
+  if (m_running) {
+    m_running    = false;
+    uint64_t one = 1;
+    if (write(m_stop_fd, &one, sizeof(one)) != sizeof(one)) {
+      m_logger.error("Failed to wake up GTP-U threads: %s", strerror(errno));
+    }
+    m_s1u_thread->wait_thread_finish();
+    m_sgi_thread->wait_thread_finish();
+    close(m_stop_fd);
+  }
+
   // Clean up SGi interface
   if (m_sgi_up) {
     close(m_sgi);
@@ -122,6 +151,13 @@ int spgw::gtpu::init_sgi(spgw_args_t* args)
     return SRSRAN_ERROR_CANT_START;
   }
 
+  // The SGi thread reads packets until the TUN device is drained
+  if (fcntl(m_sgi, F_SETFL, fcntl(m_sgi, F_GETFL) | O_NONBLOCK) < 0) {
+    m_logger.error("Failed to set TUN device non-blocking: %s", strerror(errno));
+    close(m_sgi);
+    return SRSRAN_ERROR_CANT_START;
+  }
+
   // Bring up the interface
   sgi_sock = socket(AF_INET, SOCK_DGRAM, 0);
   if (ioctl(sgi_sock, SIOCGIFFLAGS, &ifr) < 0) {
@@ -173,6 +209,24 @@ int spgw::gtpu::init_sgi(spgw_args_t* args)
   return SRSRAN_SUCCESS;
 }
 
+int spgw::gtpu::init_sgi(int sgi)
+{
+  if (m_sgi_up) {
+    return SRSRAN_ERROR_ALREADY_STARTED;
+  }
+
+  // As with the TUN device, the SGi thread reads packets until the file descriptor is drained
+  if (fcntl(sgi, F_SETFL, fcntl(sgi, F_GETFL) | O_NONBLOCK) < 0) {
+    m_logger.error("Failed to set SGi file descriptor non-blocking: %s", strerror(errno));
+    return SRSRAN_ERROR_CANT_START;
+  }
+
+  m_sgi    = sgi;
+  m_sgi_up = true;
+  m_logger.info("Initialized SGi interface. File descriptor = %d", m_sgi);
+  return SRSRAN_SUCCESS;
+}
+
 int spgw::gtpu::init_s1u(spgw_args_t* args)
 {
   // Open S1-U socket
@@ -203,61 +257,209 @@ int spgw::gtpu::init_s1u(spgw_args_t* args)
   return SRSRAN_SUCCESS;
 }
 
-void spgw::gtpu::handle_sgi_pdu(srsran::unique_byte_buffer_t msg)
+void spgw::gtpu::run_s1u_thread()
 {
-  bool usr_found = false;
-  bool ctr_found = false;
-
-  std::map<uint32_t, srsran::gtpc_f_teid_ie>::iterator gtpu_fteid_it;
-  std::map<in_addr_t, uint32_t>::iterator              gtpc_teid_it;
-  srsran::gtpc_f_teid_ie                               enb_fteid;
-  uint32_t                                             spgw_teid;
-  struct iphdr*                                        iph = (struct iphdr*)msg->msg;
-  m_logger.debug("Received SGi PDU. Bytes %d", msg->N_bytes);
-
-  if (iph->version != 4) {
-    m_logger.info("IPv6 not supported yet.");
+  const size_t buf_len  = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
+  int          epoll_fd = epoll_create1(0);
+  if (epoll_fd < 0 || add_epoll(m_s1u, epoll_fd) != SRSRAN_SUCCESS ||
+      add_epoll(m_stop_fd, epoll_fd) != SRSRAN_SUCCESS) {
+    m_logger.error("Failed to set up S1-U epoll: %s", strerror(errno));
     return;
   }
-  if (ntohs(iph->tot_len) < 20) {
-    m_logger.warning("Invalid IP header length. IP length %d.", ntohs(iph->tot_len));
-    return;
+
+  srsran::unique_byte_buffer_t msgs[GTPU_BATCH_SIZE];
+  struct mmsghdr               hdrs[GTPU_BATCH_SIZE];
+  struct iovec                 iovs[GTPU_BATCH_SIZE];
+  for (uint32_t i = 0; i < GTPU_BATCH_SIZE; i++) {
+    msgs[i] = srsran::make_byte_buffer("spgw::gtpu::run_s1u_thread");
+    if (msgs[i] == nullptr) {
+      m_logger.error("Couldn't allocate S1-U buffers");
+      close(epoll_fd);
+      return;
+    }
   }
 
-  // Logging PDU info
-  m_logger.debug("SGi PDU -- IP version %d, Total length %d", int(iph->version), ntohs(iph->tot_len));
-  fmt::memory_buffer buffer;
-  srsran::gtpu_ntoa(buffer, iph->saddr);
-  m_logger.debug("SGi PDU -- IP src addr %s", srsran::to_c_str(buffer));
-  buffer.clear();
-  srsran::gtpu_ntoa(buffer, iph->daddr);
-  m_logger.debug("SGi PDU -- IP dst addr %s", srsran::to_c_str(buffer));
-
-  // Find user and control tunnel
-  gtpu_fteid_it = m_ip_to_usr_teid.find(iph->daddr);
-  if (gtpu_fteid_it != m_ip_to_usr_teid.end()) {
-    usr_found = true;
-    enb_fteid = gtpu_fteid_it->second;
-  }
-  gtpc_teid_it = m_ip_to_ctr_teid.find(iph->daddr);
-  if (gtpc_teid_it != m_ip_to_ctr_teid.end()) {
-    ctr_found = true;
-    spgw_teid = gtpc_teid_it->second;
-  }
-
-  // Handle SGi packet
-  if (usr_found == false && ctr_found == false) {
-    m_logger.debug("Packet for unknown UE.");
-  } else if (usr_found == false && ctr_found == true) {
-    m_logger.debug("Packet for attached UE that is not ECM connected.");
-    m_logger.debug("Triggering Donwlink Notification Requset.");
-    m_gtpc->send_downlink_data_notification(spgw_teid);
-    m_gtpc->queue_downlink_packet(spgw_teid, std::move(msg));
+  while (m_running) {
+    struct epoll_event event;
+    if (epoll_wait(epoll_fd, &event, 1, -1) < 0) {
+      if (errno != EINTR) {
+        m_logger.error("Error from epoll_wait: %s", strerror(errno));
+      }
+      continue;
+    }
+
+    // Drain the socket, GTPU_BATCH_SIZE packets at a time
+    int nof_msgs = GTPU_BATCH_SIZE;
+    while (m_running && nof_msgs == (int)GTPU_BATCH_SIZE) {
+      for (uint32_t i = 0; i < GTPU_BATCH_SIZE; i++) {
+        msgs[i]->clear();
+        iovs[i].iov_base = msgs[i]->msg;
+        iovs[i].iov_len  = buf_len;
+        memset(&hdrs[i], 0, sizeof(hdrs[i]));
+        hdrs[i].msg_hdr.msg_iov    = &iovs[i];
+        hdrs[i].msg_hdr.msg_iovlen = 1;
+      }
+      nof_msgs = recvmmsg(m_s1u, hdrs, GTPU_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+      if (nof_msgs < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+        m_logger.error("Error receiving from S1-U: %s", strerror(errno));
+      }
+      for (int i = 0; i < nof_msgs; i++) {
+        msgs[i]->N_bytes = hdrs[i].msg_len;
+        handle_s1u_pdu(msgs[i].get());
+      }
+    }
+  }
+  close(epoll_fd);
+}
+
+void spgw::gtpu::run_sgi_thread()
+{
+  const size_t buf_len  = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
+  int          epoll_fd = epoll_create1(0);
+  if (epoll_fd < 0 || add_epoll(m_sgi, epoll_fd) != SRSRAN_SUCCESS ||
+      add_epoll(m_stop_fd, epoll_fd) != SRSRAN_SUCCESS) {
+    m_logger.error("Failed to set up SGi epoll: %s", strerror(errno));
     return;
-  } else if (usr_found == true && ctr_found == false) {
-    m_logger.error("User plane tunnel found without a control plane tunnel present.");
-  } else {
-    send_s1u_pdu(enb_fteid, msg.get());
+  }
+
+  /*
+   * SGi messages may need to be queued when waiting for UE Paging procedure.
+   * For this reason, buffers for SGi pdus are allocated here and deallocated
+   * at the end of the thread, at handle_sgi_pdus() when the PDU is queued and dropped or at
+   * gtpc::free_all_queued_packets, which is called when the Downlink Data Notification
+   * procedure fails (see handle_downlink_data_notification_acknowledgment and
+   * handle_downlink_data_notification_failure)
+   */
+  srsran::unique_byte_buffer_t msgs[GTPU_BATCH_SIZE];
+
+  while (m_running) {
+    struct epoll_event event;
+    if (epoll_wait(epoll_fd, &event, 1, -1) < 0) {
+      if (errno != EINTR) {
+        m_logger.error("Error from epoll_wait: %s", strerror(errno));
+      }
+      continue;
+    }
+
+    // Drain the TUN device, GTPU_BATCH_SIZE packets at a time
+    uint32_t nof_msgs = GTPU_BATCH_SIZE;
+    while (m_running && nof_msgs == GTPU_BATCH_SIZE) {
+      for (nof_msgs = 0; nof_msgs < GTPU_BATCH_SIZE; nof_msgs++) {
+        if (msgs[nof_msgs] == nullptr) {
+          msgs[nof_msgs] = srsran::make_byte_buffer("spgw::gtpu::run_sgi_thread");
+          if (msgs[nof_msgs] == nullptr) {
+            m_logger.error("Couldn't allocate SGi buffer");
+            break;
+          }
+        }
+        msgs[nof_msgs]->clear();
+        int n = read(m_sgi, msgs[nof_msgs]->msg, buf_len);
+        if (n <= 0) {
+          if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+            m_logger.error("Error reading from TUN interface: %s", strerror(errno));
+          }
+          break;
+        }
+        msgs[nof_msgs]->N_bytes = n;
+      }
+      m_logger.debug("Message received at SPGW: %d SGi Messages", nof_msgs);
+      handle_sgi_pdus(msgs, nof_msgs);
+    }
+  }
+  close(epoll_fd);
+}
+
+void spgw::gtpu::handle_sgi_pdus(srsran::unique_byte_buffer_t* msgs, uint32_t nof_msgs)
+{
+  struct mmsghdr     hdrs[GTPU_BATCH_SIZE];
+  struct iovec       iovs[GTPU_BATCH_SIZE];
+  struct sockaddr_in enb_addrs[GTPU_BATCH_SIZE];
+  uint32_t           nof_tx = 0;
+  uint32_t           paging_idx[GTPU_BATCH_SIZE];
+  uint32_t           paging_teid[GTPU_BATCH_SIZE];
+  uint32_t           nof_paging = 0;
+
+  std::unique_lock<std::mutex> lock(m_tunnel_mutex);
+  for (uint32_t i = 0; i < nof_msgs; i++) {
+    srsran::byte_buffer_t* msg       = msgs[i].get();
+    bool                   usr_found = false;
+    bool                   ctr_found = false;
+
+    srsran::gtpc_f_teid_ie enb_fteid;
+    uint32_t               spgw_teid;
+    struct iphdr*          iph = (struct iphdr*)msg->msg;
+    m_logger.debug("Received SGi PDU. Bytes %d", msg->N_bytes);
+
+    if (iph->version != 4) {
+      m_logger.info("IPv6 not supported yet.");
+      continue;
+    }
+    if (ntohs(iph->tot_len) < 20) {
+      m_logger.warning("Invalid IP header length. IP length %d.", ntohs(iph->tot_len));
+      continue;
+    }
+
+    // Logging PDU info
+    if (m_logger.debug.enabled()) {
+      m_logger.debug("SGi PDU -- IP version %d, Total length %d", int(iph->version), ntohs(iph->tot_len));
+      fmt::memory_buffer buffer;
+      srsran::gtpu_ntoa(buffer, iph->saddr);
+      m_logger.debug("SGi PDU -- IP src addr %s", srsran::to_c_str(buffer));
+      buffer.clear();
+      srsran::gtpu_ntoa(buffer, iph->daddr);
+      m_logger.debug("SGi PDU -- IP dst addr %s", srsran::to_c_str(buffer));
+    }
+
+    // Find user and control tunnel
+    auto gtpu_fteid_it = m_ip_to_usr_teid.find(iph->daddr);
+    if (gtpu_fteid_it != m_ip_to_usr_teid.end()) {
+      usr_found = true;
+      enb_fteid = gtpu_fteid_it->second;
+    }
+    auto gtpc_teid_it = m_ip_to_ctr_teid.find(iph->daddr);
+    if (gtpc_teid_it != m_ip_to_ctr_teid.end()) {
+      ctr_found = true;
+      spgw_teid = gtpc_teid_it->second;
+    }
+
+    // Handle SGi packet
+    if (usr_found == false && ctr_found == false) {
+      m_logger.debug("Packet for unknown UE.");
+    } else if (usr_found == false && ctr_found == true) {
+      m_logger.debug("Packet for attached UE that is not ECM connected.");
+      paging_idx[nof_paging]  = i;
+      paging_teid[nof_paging] = spgw_teid;
+      nof_paging++;
+    } else if (usr_found == true && ctr_found == false) {
+      m_logger.error("User plane tunnel found without a control plane tunnel present.");
+    } else if (write_s1u_header(enb_fteid, msg, &enb_addrs[nof_tx])) {
+      iovs[nof_tx].iov_base = msg->msg;
+      iovs[nof_tx].iov_len  = msg->N_bytes;
+      memset(&hdrs[nof_tx], 0, sizeof(hdrs[nof_tx]));
+      hdrs[nof_tx].msg_hdr.msg_name    = &enb_addrs[nof_tx];
+      hdrs[nof_tx].msg_hdr.msg_namelen = sizeof(enb_addrs[nof_tx]);
+      hdrs[nof_tx].msg_hdr.msg_iov     = &iovs[nof_tx];
+      hdrs[nof_tx].msg_hdr.msg_iovlen  = 1;
+      nof_tx++;
+    }
+  }
+  lock.unlock();
+
+  // Send the packets of all the tunnels together
+  uint32_t nof_sent = 0;
+  while (nof_sent < nof_tx) {
+    int n = sendmmsg(m_s1u, &hdrs[nof_sent], nof_tx - nof_sent, 0);
+    if (n < 0) {
+      // Skip the packet that could not be sent
+      m_logger.error("Error sending packet to eNB: %s", strerror(errno));
+      n = 1;
+    }
+    nof_sent += n;
+  }
+
+  // Paging goes through GTP-C, which must not be called with the tunnel lock held
+  for (uint32_t i = 0; i < nof_paging; i++) {
+    m_gtpc->handle_idle_ue_downlink_packet(paging_teid[i], std::move(msgs[paging_idx[i]]));
   }
 }
 
@@ -277,13 +479,14 @@ void spgw::gtpu::handle_s1u_pdu(srsran::byte_buffer_t* msg)
   return;
 }
 
-void spgw::gtpu::send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer_t* msg)
+bool spgw::gtpu::write_s1u_header(const srsran::gtp_fteid_t& enb_fteid,
+                                  srsran::byte_buffer_t*     msg,
+                                  struct sockaddr_in*        enb_addr)
 {
   // Set eNB destination address
-  struct sockaddr_in enb_addr;
-  enb_addr.sin_family      = AF_INET;
-  enb_addr.sin_port        = htons(GTPU_RX_PORT);
-  enb_addr.sin_addr.s_addr = enb_fteid.ipv4;
+  enb_addr->sin_family      = AF_INET;
+  enb_addr->sin_port        = htons(GTPU_RX_PORT);
+  enb_addr->sin_addr.s_addr = enb_fteid.ipv4;
 
   // Setup GTP-U header
   srsran::gtpu_header_t header;
@@ -293,26 +496,41 @@ void spgw::gtpu::send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer
   header.teid         = enb_fteid.teid;
 
   m_logger.debug("User plane tunnel found SGi PDU. Forwarding packet to S1-U.");
-  m_logger.debug("eNB F-TEID -- eNB IP %s, eNB TEID 0x%x.", inet_ntoa(enb_addr.sin_addr), enb_fteid.teid);
+  m_logger.debug("eNB F-TEID -- eNB IP %s, eNB TEID 0x%x.", inet_ntoa(enb_addr->sin_addr), enb_fteid.teid);
 
   // Write header into packet
-  int n;
   if (!srsran::gtpu_write_header(&header, msg, m_logger)) {
     m_logger.error("Error writing GTP-U header on PDU");
-    goto out;
+    return false;
+  }
+  return true;
+}
+
+void spgw::gtpu::send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer_t* msg)
+{
+  struct sockaddr_in enb_addr;
+  if (!write_s1u_header(enb_fteid, msg, &enb_addr)) {
+    return;
   }
 
   // Send packet to destination
-  n = sendto(m_s1u, msg->msg, msg->N_bytes, 0, (struct sockaddr*)&enb_addr, sizeof(enb_addr));
+  int n = sendto(m_s1u, msg->msg, msg->N_bytes, 0, (struct sockaddr*)&enb_addr, sizeof(enb_addr));
   if (n < 0) {
     m_logger.error("Error sending packet to eNB");
   } else if ((unsigned int)n != msg->N_bytes) {
     m_logger.error("Mis-match between packet bytes and sent bytes: Sent: %d/%d", n, msg->N_bytes);
   }
+}
 
-out:
-  m_logger.debug("Deallocating packet after sending S1-U message");
-  return;
+bool spgw::gtpu::send_downlink_pdu(in_addr_t ue_ipv4, srsran::byte_buffer_t* msg)
+{
+  std::lock_guard<std::mutex> lock(m_tunnel_mutex);
+  auto                        gtpu_fteid_it = m_ip_to_usr_teid.find(ue_ipv4);
+  if (gtpu_fteid_it == m_ip_to_usr_teid.end()) {
+    return false;
+  }
+  send_s1u_pdu(gtpu_fteid_it->second, msg);
+  return true;
 }
 
 void spgw::gtpu::send_all_queued_packets(srsran::gtp_fteid_t                       dw_user_fteid,
@@ -340,6 +558,7 @@ bool spgw::gtpu::modify_gtpu_tunnel(in_addr_t ue_ipv4, srsran::gtpc_f_teid_ie dw
   srsran::gtpu_ntoa(buffer, dw_user_fteid.ipv4);
   m_logger.info("Downlink eNB addr %s, U-TEID 0x%x", srsran::to_c_str(buffer), dw_user_fteid.teid);
   m_logger.info("Uplink C-TEID: 0x%x", up_ctrl_teid);
+  std::lock_guard<std::mutex> lock(m_tunnel_mutex);
   m_ip_to_usr_teid[ue_ipv4] = dw_user_fteid;
   m_ip_to_ctr_teid[ue_ipv4] = up_ctrl_teid;
   return true;
@@ -348,6 +567,7 @@ bool spgw::gtpu::modify_gtpu_tunnel(in_addr_t ue_ipv4, srsran::gtpc_f_teid_ie dw
 bool spgw::gtpu::delete_gtpu_tunnel(in_addr_t ue_ipv4)
 {
   // Remove GTP-U connections, if any.
+  std::lock_guard<std::mutex> lock(m_tunnel_mutex);
   if (m_ip_to_usr_teid.count(ue_ipv4)) {
     m_ip_to_usr_teid.erase(ue_ipv4);
   } else {
@@ -360,6 +580,7 @@ bool spgw::gtpu::delete_gtpu_tunnel(in_addr_t ue_ipv4)
 bool spgw::gtpu::delete_gtpc_tunnel(in_addr_t ue_ipv4)
 {
   // Remove Ctrl TEID from IP mapping.
+  std::lock_guard<std::mutex> lock(m_tunnel_mutex);
   if (m_ip_to_ctr_teid.count(ue_ipv4)) {
     m_ip_to_ctr_teid.erase(ue_ipv4);
   } else {
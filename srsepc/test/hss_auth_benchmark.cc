@@ -0,0 +1,164 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsepc/hdr/hss/hss.h"
+#include "srsran/common/test_common.h"
+#include <algorithm>
+#include <chrono>
+#include <getopt.h>
+#include <inttypes.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace srsepc;
+
+static uint32_t bench_nof_ues          = 1000;
+static uint32_t bench_nof_auths        = 20000;
+static uint32_t bench_max_auth_vectors = 8;
+
+static const uint64_t first_imsi = 1010000000000;
+
+struct bench_result_t {
+  uint32_t nof_auth_vectors;
+  double   rate;
+  double   mean;
+  double   p50;
+  double   p99;
+  double   max;
+};
+
+/// Writes the subscribers of the benchmark to a temporary HSS database, all of them sharing K and OPc
+static bool write_db_file(const std::string& db_file)
+{
+  FILE* f = fopen(db_file.c_str(), "w");
+  if (f == nullptr) {
+    return false;
+  }
+  for (uint32_t i = 0; i < bench_nof_ues; i++) {
+    fprintf(f,
+            "ue%d,mil,%015" PRIu64 ",00112233445566778899aabbccddeeff,opc,63bfa50ee6523365ff14c1f45f88737d,8000,"
+            "000000001234,7,dynamic\n",
+            i,
+            first_imsi + i);
+  }
+  return fclose(f) == 0;
+}
+
+/// Authenticates the UEs in turn, as the NAS does on their attaches, and reports the time the NAS waits for each
+/// vector. With precomputation, the vectors of a UE are computed in the background after its first attach
+int run_benchmark(uint32_t nof_auth_vectors, bench_result_t& result)
+{
+  char db_path[] = "/tmp/hss_auth_benchmark_XXXXXX";
+  int  db_fd     = mkstemp(db_path);
+  TESTASSERT(db_fd >= 0);
+  close(db_fd);
+  std::string db_file = db_path;
+  TESTASSERT(write_db_file(db_file));
+
+  hss_args_t args       = {};
+  args.db_file          = db_file;
+  args.mcc              = 0xf001;
+  args.mnc              = 0xff01;
+  args.nof_auth_vectors = nof_auth_vectors;
+  hss* hss              = hss::get_instance();
+  TESTASSERT(hss->init(&args) == SRSRAN_SUCCESS);
+
+  std::vector<double> latencies;
+  latencies.reserve(bench_nof_auths);
+  uint8_t k_asme[32], autn[16], rand[16], xres[16];
+  auto    tic = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < bench_nof_auths; i++) {
+    auto start = std::chrono::steady_clock::now();
+    TESTASSERT(hss->gen_auth_info_answer(first_imsi + i % bench_nof_ues, k_asme, autn, rand, xres));
+    latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+  }
+  double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - tic).count();
+
+  hss->stop();
+  hss->cleanup();
+  unlink(db_file.c_str());
+
+  std::sort(latencies.begin(), latencies.end());
+  result.nof_auth_vectors = nof_auth_vectors;
+  result.rate             = bench_nof_auths / elapsed;
+  result.mean             = 0;
+  for (double latency : latencies) {
+    result.mean += latency / latencies.size();
+  }
+  result.p50 = latencies[latencies.size() / 2];
+  result.p99 = latencies[latencies.size() * 99 / 100];
+  result.max = latencies.back();
+  return SRSRAN_SUCCESS;
+}
+
+void usage(char* prog)
+{
+  printf("Usage: %s [unv]\n", prog);
+  printf("\t-u number of UEs in the HSS DB [Default %d]\n", bench_nof_ues);
+  printf("\t-n number of authentications per run [Default %d]\n", bench_nof_auths);
+  printf("\t-v maximum number of precomputed vectors per UE [Default %d]\n", bench_max_auth_vectors);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "unv")) != -1) {
+    switch (opt) {
+      case 'u':
+        bench_nof_ues = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'n':
+        bench_nof_auths = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'v':
+        bench_max_auth_vectors = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srslog::fetch_basic_logger("HSS", false).set_level(srslog::basic_levels::error);
+  srslog::init();
+
+  // The HSS prints to the console on start, the results are printed at the end
+  std::vector<bench_result_t> results(1);
+  TESTASSERT(run_benchmark(0, results.back()) == SRSRAN_SUCCESS);
+  for (uint32_t nof_auth_vectors = 1; nof_auth_vectors <= bench_max_auth_vectors; nof_auth_vectors *= 2) {
+    results.emplace_back();
+    TESTASSERT(run_benchmark(nof_auth_vectors, results.back()) == SRSRAN_SUCCESS);
+  }
+
+  printf("%d UEs, latency in us of the authentication vectors handed to the NAS\n", bench_nof_ues);
+  printf("%12s %12s %10s %10s %10s %10s\n", "precomputed", "kvectors/s", "mean", "p50", "p99", "max");
+  for (const bench_result_t& r : results) {
+    printf("%12d %12.1f %10.2f %10.2f %10.2f %10.2f\n", r.nof_auth_vectors, r.rate / 1e3, r.mean, r.p50, r.p99, r.max);
+  }
+
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
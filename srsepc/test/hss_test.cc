@@ -0,0 +1,320 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsepc/hdr/hss/hss.h"
+#include "srsran/common/security.h"
+#include "srsran/common/string_helpers.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <fstream>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace srsepc;
+
+static const uint64_t imsi     = 1010123456780;
+static const char*    db_entry = "ue2,mil,001010123456780,00112233445566778899aabbccddeeff,opc,"
+                                 "63bfa50ee6523365ff14c1f45f88737d,8000,000000001234,7,dynamic\n";
+static const uint64_t db_sqn   = 0x1234;
+
+static const uint8_t ue_key[16] =
+    {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff};
+static const uint8_t ue_opc[16] =
+    {0x63, 0xbf, 0xa5, 0x0e, 0xe6, 0x52, 0x33, 0x65, 0xff, 0x14, 0xc1, 0xf4, 0x5f, 0x88, 0x73, 0x7d};
+
+static uint64_t sqn_to_uint64(const uint8_t* sqn)
+{
+  uint64_t sqn64 = 0;
+  for (int i = 0; i < 6; i++) {
+    sqn64 = (sqn64 << 8) | sqn[i];
+  }
+  return sqn64;
+}
+
+static void uint64_to_sqn(uint64_t sqn64, uint8_t* sqn)
+{
+  for (int i = 5; i >= 0; i--) {
+    sqn[i] = sqn64 & 0xff;
+    sqn64 >>= 8;
+  }
+}
+
+// HSS reading a temporary DB file with a single milenage UE. The files are removed on destruction
+struct hss_tester {
+  std::string db_file;
+  std::string db_contents = db_entry;
+  hss*        m_hss       = nullptr;
+
+  // RAND of the last vector, needed to resynchronize
+  uint8_t last_rand[16] = {};
+
+  hss_tester()
+  {
+    char db_path[] = "/tmp/hss_test_XXXXXX";
+    int  fd        = mkstemp(db_path);
+    if (fd >= 0) {
+      close(fd);
+    }
+    db_file = db_path;
+    restore_db_file();
+  }
+
+  ~hss_tester()
+  {
+    hss::cleanup();
+    unlink(db_file.c_str());
+    unlink((db_file + ".tmp").c_str());
+    unlink((db_file + ".sqn").c_str());
+    unlink((db_file + ".sqn.tmp").c_str());
+  }
+
+  void restore_db_file()
+  {
+    std::ofstream f(db_file.c_str());
+    f << db_contents;
+  }
+
+  int init(uint32_t nof_auth_vectors)
+  {
+    hss_args_t args       = {};
+    args.db_file          = db_file;
+    args.mcc              = 0xf001;
+    args.mnc              = 0xff01;
+    args.nof_auth_vectors = nof_auth_vectors;
+    m_hss                 = hss::get_instance();
+    return m_hss->init(&args);
+  }
+
+  // Stops the HSS as on EPC shutdown
+  void stop()
+  {
+    m_hss->stop();
+    hss::cleanup();
+  }
+
+  // Drops the HSS without letting it write the DB file back, as if the EPC crashed
+  void crash() { hss::cleanup(); }
+
+  // Authenticates the UE, returning the SQN of the vector it is given. The UE must accept the vector
+  uint64_t authenticate()
+  {
+    uint8_t k_asme[32], autn[16], rand[16], xres[16];
+    TESTASSERT(m_hss->gen_auth_info_answer(imsi, k_asme, autn, rand, xres));
+
+    uint8_t k[16], opc[16], res[8], ck[16], ik[16], ak[6], sqn[6];
+    memcpy(k, ue_key, sizeof(k));
+    memcpy(opc, ue_opc, sizeof(opc));
+    srsran::security_milenage_f2345(k, opc, rand, res, ck, ik, ak);
+    TESTASSERT(memcmp(res, xres, sizeof(res)) == 0);
+    for (int i = 0; i < 6; i++) {
+      sqn[i] = autn[i] ^ ak[i];
+    }
+    memcpy(last_rand, rand, sizeof(last_rand));
+    return sqn_to_uint64(sqn);
+  }
+
+  // Resynchronizes the HSS to the SQN of the UE, as on an authentication failure with synch failure
+  void resync(uint64_t sqn_ms)
+  {
+    uint8_t k[16], opc[16], sqn[6], ak[6], amf[2] = {}, auts[14];
+    memcpy(k, ue_key, sizeof(k));
+    memcpy(opc, ue_opc, sizeof(opc));
+    uint64_to_sqn(sqn_ms, sqn);
+    srsran::security_milenage_f5_star(k, opc, last_rand, ak);
+    srsran::security_milenage_f1_star(k, opc, last_rand, sqn, amf, &auts[6]);
+    for (int i = 0; i < 6; i++) {
+      auts[i] = sqn[i] ^ ak[i];
+    }
+    TESTASSERT(m_hss->resync_sqn(imsi, auts));
+  }
+
+  uint64_t read_db_sqn()
+  {
+    std::ifstream f(db_file.c_str());
+    std::string   line;
+    while (std::getline(f, line)) {
+      std::vector<std::string> split = srsran::split_string(line, ',');
+      if (line[0] != '#' && split.size() == 10) {
+        return strtoull(split[7].c_str(), nullptr, 16);
+      }
+    }
+    return 0;
+  }
+
+  uint32_t nof_journal_entries()
+  {
+    std::ifstream f((db_file + ".sqn").c_str());
+    std::string   line;
+    uint32_t      nof_entries = 0;
+    while (std::getline(f, line)) {
+      nof_entries++;
+    }
+    return nof_entries;
+  }
+
+  bool file_exists(const std::string& filename) { return access(filename.c_str(), F_OK) == 0; }
+};
+
+/*
+ * The SQNs handed out always increase, with and without precomputed vectors, and the journal stays bounded
+ */
+int test_sqn_increase(uint32_t nof_auth_vectors)
+{
+  hss_tester tester;
+  TESTASSERT(tester.init(nof_auth_vectors) == SRSRAN_SUCCESS);
+
+  uint64_t last_sqn = db_sqn - 1;
+  for (uint32_t i = 0; i < 10 * HSS_SQN_JOURNAL_MAX_ENTRIES_PER_UE; i++) {
+    uint64_t sqn = tester.authenticate();
+    TESTASSERT(sqn > last_sqn);
+    last_sqn = sqn;
+    TESTASSERT(tester.nof_journal_entries() <= HSS_SQN_JOURNAL_MAX_ENTRIES_PER_UE);
+
+    // Let the precomputation finish every now and then, the vectors are otherwise computed as they are needed
+    if (i % 8 == 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+
+  // The DB file holds the next SQN and the journal is dropped
+  tester.stop();
+  TESTASSERT(tester.read_db_sqn() > last_sqn);
+  TESTASSERT(not tester.file_exists(tester.db_file + ".sqn"));
+  TESTASSERT(not tester.file_exists(tester.db_file + ".tmp"));
+  return SRSRAN_SUCCESS;
+}
+
+/*
+ * The SQNs reserved before a crash are replayed from the journal on the next start
+ */
+int test_journal_replay()
+{
+  hss_tester tester;
+  TESTASSERT(tester.init(4) == SRSRAN_SUCCESS);
+
+  // Enough authentications to compact the journal
+  uint64_t last_sqn = 0;
+  for (uint32_t i = 0; i < 2 * HSS_SQN_JOURNAL_MAX_ENTRIES_PER_UE + 3; i++) {
+    last_sqn = tester.authenticate();
+  }
+  tester.crash();
+  TESTASSERT(tester.read_db_sqn() == db_sqn);
+  TESTASSERT(tester.nof_journal_entries() > 0);
+
+  // The DB file is updated on start, and no SQN is reused
+  TESTASSERT(tester.init(4) == SRSRAN_SUCCESS);
+  TESTASSERT(tester.read_db_sqn() > last_sqn);
+  TESTASSERT(tester.authenticate() > last_sqn);
+
+  // A truncated last entry is ignored
+  last_sqn = tester.authenticate();
+  tester.crash();
+  {
+    std::ofstream journal((tester.db_file + ".sqn").c_str(), std::ofstream::app);
+    journal << "001010123456780,0000";
+  }
+  TESTASSERT(tester.init(4) == SRSRAN_SUCCESS);
+  TESTASSERT(tester.authenticate() > last_sqn);
+  tester.stop();
+  return SRSRAN_SUCCESS;
+}
+
+/*
+ * A resynchronization discards the vectors computed with the old SQN, whether they are queued or being computed
+ */
+int test_resync()
+{
+  hss_tester tester;
+  TESTASSERT(tester.init(4) == SRSRAN_SUCCESS);
+
+  uint64_t sqn_ms = db_sqn;
+  for (uint32_t i = 0; i < 8; i++) {
+    tester.authenticate();
+
+    // Resynchronize with the precomputed vectors queued, then while they are being computed
+    if (i % 2 == 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    sqn_ms += 0x1000 << LTE_FDD_ENB_IND_HE_N_BITS;
+    tester.resync(sqn_ms);
+
+    uint64_t last_sqn = sqn_ms;
+    for (uint32_t j = 0; j < 6; j++) {
+      uint64_t sqn = tester.authenticate();
+      TESTASSERT(sqn > last_sqn);
+      last_sqn = sqn;
+    }
+  }
+
+  // The resynchronized SQN is journaled as well
+  tester.crash();
+  TESTASSERT(tester.init(0) == SRSRAN_SUCCESS);
+  TESTASSERT(tester.authenticate() > sqn_ms);
+  tester.stop();
+  return SRSRAN_SUCCESS;
+}
+
+/*
+ * The DB file is never left half written. If it can not be replaced, the journal is kept for the next start
+ */
+int test_db_rename_failure()
+{
+  hss_tester tester;
+  TESTASSERT(tester.init(0) == SRSRAN_SUCCESS);
+
+  uint64_t last_sqn = 0;
+  for (uint32_t i = 0; i < 5; i++) {
+    last_sqn = tester.authenticate();
+  }
+
+  // A directory in place of the DB file makes the rename of the new DB file fail
+  TESTASSERT(unlink(tester.db_file.c_str()) == 0);
+  TESTASSERT(mkdir(tester.db_file.c_str(), 0700) == 0);
+  tester.stop();
+  TESTASSERT(rmdir(tester.db_file.c_str()) == 0);
+  TESTASSERT(not tester.file_exists(tester.db_file + ".tmp"));
+  TESTASSERT(tester.file_exists(tester.db_file + ".sqn"));
+
+  // With the old DB file back, the SQNs are taken from the journal
+  tester.restore_db_file();
+  TESTASSERT(tester.init(0) == SRSRAN_SUCCESS);
+  TESTASSERT(tester.authenticate() > last_sqn);
+  tester.stop();
+  TESTASSERT(not tester.file_exists(tester.db_file + ".sqn"));
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  srslog::fetch_basic_logger("HSS", false).set_level(srslog::basic_levels::error);
+  srslog::init();
+
+  TESTASSERT(test_sqn_increase(0) == SRSRAN_SUCCESS);
+  TESTASSERT(test_sqn_increase(4) == SRSRAN_SUCCESS);
+  TESTASSERT(test_journal_replay() == SRSRAN_SUCCESS);
+  TESTASSERT(test_resync() == SRSRAN_SUCCESS);
+  TESTASSERT(test_db_rename_failure() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,541 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsepc/hdr/hss/hss.h"
+#include "srsepc/hdr/mme/mme.h"
+#include "srsran/common/bcd_helpers.h"
+#include "srsran/common/network_utils.h"
+#include "srsran/common/security.h"
+#include "srsran/common/test_common.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <getopt.h>
+#include <map>
+#include <poll.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace srsepc;
+
+static uint32_t bench_nof_ues      = 1000;
+static uint32_t bench_nof_workers  = 4;
+static uint32_t bench_nof_inflight = 256;
+
+static const uint64_t first_imsi    = 1010000000000; // MCC 001, MNC 01
+static const uint16_t mcc           = 0xf001;
+static const uint16_t mnc           = 0xff01;
+static const uint16_t tac           = 7;
+static const uint32_t enb_id        = 0x19b;
+static const int      s1ap_ppid     = 18;
+static const int      s1ap_port     = 36412;
+static const int      rx_timeout_ms = 5000;
+
+static const uint8_t ue_key[16] =
+    {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff};
+static const uint8_t ue_opc[16] =
+    {0x63, 0xbf, 0xa5, 0x0e, 0xe6, 0x52, 0x33, 0x65, 0xff, 0x14, 0xc1, 0xf4, 0x5f, 0x88, 0x73, 0x7d};
+
+/// Answers the Create Session Requests of the MME on the S11 UNIX socket, the only SPGW message of an attach
+class spgw_s11_stub
+{
+public:
+  bool init()
+  {
+    m_s11 = socket(AF_UNIX, SOCK_DGRAM, 0);
+    if (m_s11 < 0) {
+      return false;
+    }
+    sockaddr_un addr = {};
+    addr.sun_family  = AF_UNIX;
+    snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", "@spgw_s11");
+    addr.sun_path[0] = '\0';
+    if (bind(m_s11, (const sockaddr*)&addr, sizeof(addr)) == -1) {
+      return false;
+    }
+    m_running = true;
+    m_thread  = std::thread([this]() { run(); });
+    return true;
+  }
+
+  void stop()
+  {
+    m_running = false;
+    if (m_thread.joinable()) {
+      m_thread.join();
+    }
+    close(m_s11);
+  }
+
+private:
+  void run()
+  {
+    srsran::gtpc_pdu pdu;
+    sockaddr_un      mme_addr;
+    while (m_running) {
+      pollfd pfd = {m_s11, POLLIN, 0};
+      if (poll(&pfd, 1, 100) <= 0) {
+        continue;
+      }
+      socklen_t addr_len = sizeof(mme_addr);
+      if (recvfrom(m_s11, &pdu, sizeof(pdu), 0, (sockaddr*)&mme_addr, &addr_len) != sizeof(pdu) ||
+          pdu.header.type != srsran::GTPC_MSG_TYPE_CREATE_SESSION_REQUEST) {
+        continue;
+      }
+      uint32_t mme_ctrl_teid = pdu.choice.create_session_request.sender_f_teid.teid;
+      m_next_teid++;
+
+      std::memset(&pdu, 0, sizeof(pdu));
+      pdu.header.teid_present                    = true;
+      pdu.header.teid                            = mme_ctrl_teid;
+      pdu.header.type                            = srsran::GTPC_MSG_TYPE_CREATE_SESSION_RESPONSE;
+      srsran::gtpc_create_session_response& resp = pdu.choice.create_session_response;
+      resp.cause.cause_value                     = srsran::GTPC_CAUSE_VALUE_REQUEST_ACCEPTED;
+      resp.sender_f_teid.ipv4_present            = true;
+      resp.sender_f_teid.teid                    = m_next_teid;
+      resp.paa_present                           = true;
+      resp.paa.pdn_type                          = srsran::GTPC_PDN_TYPE_IPV4;
+      resp.paa.ipv4_present                      = true;
+      resp.paa.ipv4                              = htonl(0xac100002 + m_next_teid);
+
+      srsran::gtpc_create_session_response::gtpc_bearer_context_created_ie& bearer = resp.eps_bearer_context_created;
+      bearer.ebi                                                                   = 5;
+      bearer.cause                                                                 = resp.cause;
+      bearer.s1_u_sgw_f_teid_present                                               = true;
+      bearer.s1_u_sgw_f_teid.ipv4                                                  = htonl(INADDR_LOOPBACK);
+      bearer.s1_u_sgw_f_teid.teid                                                  = m_next_teid;
+      sendto(m_s11, &pdu, sizeof(pdu), 0, (const sockaddr*)&mme_addr, addr_len);
+    }
+  }
+
+  int               m_s11       = -1;
+  uint32_t          m_next_teid = 0;
+  std::atomic<bool> m_running   = {false};
+  std::thread       m_thread;
+};
+
+/// UE being attached through the emulated eNB, identified by its eNB UE S1AP Id
+struct bench_ue_t {
+  uint64_t                              imsi;
+  uint32_t                              mme_ue_s1ap_id;
+  uint8_t                               k_asme[32];
+  std::chrono::steady_clock::time_point start;
+};
+
+/// Emulated eNB, attaching the UEs over a loopback SCTP association
+class enb_emulator
+{
+public:
+  bool connect()
+  {
+    return srsran::net_utils::sctp_init_socket(&m_socket, srsran::net_utils::socket_type::seqpacket, "127.0.0.1", 0) &&
+           m_socket.connect_to("127.0.0.1", s1ap_port, &m_mme_addr);
+  }
+
+  bool send_pdu(const s1ap_pdu_t& pdu, uint16_t stream)
+  {
+    srsran::unique_byte_buffer_t buf = srsran::make_byte_buffer();
+    if (buf == nullptr) {
+      return false;
+    }
+    asn1::bit_ref bref(buf->msg, buf->get_tailroom());
+    if (pdu.pack(bref) != asn1::SRSASN_SUCCESS) {
+      return false;
+    }
+    return sctp_sendmsg(m_socket.fd(),
+                        buf->msg,
+                        bref.distance_bytes(),
+                        (sockaddr*)&m_mme_addr,
+                        sizeof(m_mme_addr),
+                        htonl(s1ap_ppid),
+                        0,
+                        stream,
+                        0,
+                        0) != -1;
+  }
+
+  /// Waits for the next PDU from the MME. Fails on timeout, as the MME drops the attach on any error
+  bool recv_pdu(s1ap_pdu_t& pdu)
+  {
+    pollfd pfd = {m_socket.fd(), POLLIN, 0};
+    if (poll(&pfd, 1, rx_timeout_ms) <= 0) {
+      return false;
+    }
+    uint8_t                buf[SRSRAN_MAX_BUFFER_SIZE_BYTES];
+    sockaddr_in            from     = {};
+    socklen_t              from_len = sizeof(from);
+    struct sctp_sndrcvinfo sri      = {};
+    int                    flags    = 0;
+    int n = sctp_recvmsg(m_socket.fd(), buf, sizeof(buf), (sockaddr*)&from, &from_len, &sri, &flags);
+    if (n <= 0) {
+      return false;
+    }
+    if (flags & MSG_NOTIFICATION) {
+      return recv_pdu(pdu);
+    }
+    asn1::cbit_ref bref(buf, n);
+    return pdu.unpack(bref) == asn1::SRSASN_SUCCESS;
+  }
+
+  bool s1_setup()
+  {
+    uint32_t plmn;
+    srsran::s1ap_mccmnc_to_plmn(mcc, mnc, &plmn);
+    plmn = htonl(plmn);
+
+    s1ap_pdu_t pdu;
+    pdu.set_init_msg().load_info_obj(ASN1_S1AP_ID_S1_SETUP);
+    asn1::s1ap::s1_setup_request_s& container = pdu.init_msg().value.s1_setup_request();
+    container->global_enb_id.value.plm_nid[0] = ((uint8_t*)&plmn)[1];
+    container->global_enb_id.value.plm_nid[1] = ((uint8_t*)&plmn)[2];
+    container->global_enb_id.value.plm_nid[2] = ((uint8_t*)&plmn)[3];
+    container->global_enb_id.value.enb_id.set_macro_enb_id().from_number(enb_id);
+    container->supported_tas.value.resize(1);
+    uint16_t tmp16 = htons(tac);
+    memcpy(container->supported_tas.value[0].tac.data(), (uint8_t*)&tmp16, 2);
+    container->supported_tas.value[0].broadcast_plmns.resize(1);
+    container->supported_tas.value[0].broadcast_plmns[0][0] = ((uint8_t*)&plmn)[1];
+    container->supported_tas.value[0].broadcast_plmns[0][1] = ((uint8_t*)&plmn)[2];
+    container->supported_tas.value[0].broadcast_plmns[0][2] = ((uint8_t*)&plmn)[3];
+    container->default_paging_drx.value.value               = asn1::s1ap::paging_drx_opts::v128;
+    if (not send_pdu(pdu, 0) or not recv_pdu(pdu)) {
+      return false;
+    }
+    return pdu.type().value == asn1::s1ap::s1ap_pdu_c::types_opts::successful_outcome &&
+           pdu.successful_outcome().value.type().value ==
+               asn1::s1ap::s1ap_elem_procs_o::successful_outcome_c::types_opts::s1_setup_resp;
+  }
+
+  /// Sends the Initial UE Message carrying the Attach Request of the UE
+  bool start_attach(uint32_t enb_ue_s1ap_id, uint64_t imsi)
+  {
+    bench_ue_t& ue = m_ues[enb_ue_s1ap_id];
+    ue.imsi        = imsi;
+    ue.start       = std::chrono::steady_clock::now();
+
+    LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_MSG_STRUCT pdn_con_req = {};
+    LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT           attach_req  = {};
+    pdn_con_req.proc_transaction_id                            = 1;
+    pdn_con_req.request_type                                   = LIBLTE_MME_REQUEST_TYPE_INITIAL_REQUEST;
+    pdn_con_req.pdn_type                                       = LIBLTE_MME_PDN_TYPE_IPV4;
+    liblte_mme_pack_pdn_connectivity_request_msg(&pdn_con_req, &attach_req.esm_msg);
+    attach_req.eps_attach_type          = LIBLTE_MME_EPS_ATTACH_TYPE_EPS_ATTACH;
+    attach_req.eps_mobile_id.type_of_id = LIBLTE_MME_EPS_MOBILE_ID_TYPE_IMSI;
+    attach_req.nas_ksi.nas_ksi          = LIBLTE_MME_NAS_KEY_SET_IDENTIFIER_NO_KEY_AVAILABLE;
+    attach_req.ue_network_cap.eea[0]    = true;
+    attach_req.ue_network_cap.eia[2]    = true;
+    for (int i = 14; i >= 0; i--) {
+      attach_req.eps_mobile_id.imsi[i] = imsi % 10;
+      imsi /= 10;
+    }
+    srsran::unique_byte_buffer_t nas_msg = srsran::make_byte_buffer();
+    if (nas_msg == nullptr ||
+        liblte_mme_pack_attach_request_msg(&attach_req, (LIBLTE_BYTE_MSG_STRUCT*)nas_msg.get()) != LIBLTE_SUCCESS) {
+      return false;
+    }
+
+    s1ap_pdu_t pdu;
+    pdu.set_init_msg().load_info_obj(ASN1_S1AP_ID_INIT_UE_MSG);
+    asn1::s1ap::init_ue_msg_s& container = pdu.init_msg().value.init_ue_msg();
+    container->enb_ue_s1ap_id.value      = enb_ue_s1ap_id;
+    container->nas_pdu.value.resize(nas_msg->N_bytes);
+    memcpy(container->nas_pdu.value.data(), nas_msg->msg, nas_msg->N_bytes);
+    container->rrc_establishment_cause.value = asn1::s1ap::rrc_establishment_cause_opts::mo_sig;
+    return send_pdu(pdu, 1 + enb_ue_s1ap_id % 8);
+  }
+
+  /// Answers the DL NAS messages of the attach. Returns the finished attach latency in us, 0 if it goes on and -1 on
+  /// error
+  double handle_pdu(const s1ap_pdu_t& pdu)
+  {
+    if (pdu.type().value != asn1::s1ap::s1ap_pdu_c::types_opts::init_msg) {
+      return -1;
+    }
+    switch (pdu.init_msg().value.type().value) {
+      case asn1::s1ap::s1ap_elem_procs_o::init_msg_c::types_opts::dl_nas_transport:
+        return handle_dl_nas_transport(pdu.init_msg().value.dl_nas_transport()) ? 0 : -1;
+      case asn1::s1ap::s1ap_elem_procs_o::init_msg_c::types_opts::init_context_setup_request: {
+        auto it = m_ues.find(pdu.init_msg().value.init_context_setup_request()->enb_ue_s1ap_id.value.value);
+        if (it == m_ues.end()) {
+          return -1;
+        }
+        double latency =
+            std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - it->second.start).count();
+        m_ues.erase(it);
+        return latency;
+      }
+      default:
+        return -1;
+    }
+  }
+
+private:
+  bool handle_dl_nas_transport(const asn1::s1ap::dl_nas_transport_s& dl_xport)
+  {
+    uint32_t enb_ue_s1ap_id = dl_xport->enb_ue_s1ap_id.value.value;
+    auto     it             = m_ues.find(enb_ue_s1ap_id);
+    if (it == m_ues.end()) {
+      return false;
+    }
+    bench_ue_t& ue    = it->second;
+    ue.mme_ue_s1ap_id = dl_xport->mme_ue_s1ap_id.value.value;
+
+    srsran::unique_byte_buffer_t nas_rx = srsran::make_byte_buffer();
+    srsran::unique_byte_buffer_t nas_tx = srsran::make_byte_buffer();
+    if (nas_rx == nullptr || nas_tx == nullptr) {
+      return false;
+    }
+    memcpy(nas_rx->msg, dl_xport->nas_pdu.value.data(), dl_xport->nas_pdu.value.size());
+    nas_rx->N_bytes = dl_xport->nas_pdu.value.size();
+
+    uint8_t pd, msg_type;
+    liblte_mme_parse_msg_header((LIBLTE_BYTE_MSG_STRUCT*)nas_rx.get(), &pd, &msg_type);
+    switch (msg_type) {
+      case LIBLTE_MME_MSG_TYPE_AUTHENTICATION_REQUEST: {
+        LIBLTE_MME_AUTHENTICATION_REQUEST_MSG_STRUCT  auth_req  = {};
+        LIBLTE_MME_AUTHENTICATION_RESPONSE_MSG_STRUCT auth_resp = {};
+        if (liblte_mme_unpack_authentication_request_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_rx.get(), &auth_req) !=
+            LIBLTE_SUCCESS) {
+          return false;
+        }
+        uint8_t k[16], opc[16], ck[16], ik[16], ak[6];
+        memcpy(k, ue_key, sizeof(k));
+        memcpy(opc, ue_opc, sizeof(opc));
+        srsran::security_milenage_f2345(k, opc, auth_req.rand, auth_resp.res, ck, ik, ak);
+        srsran::security_generate_k_asme(ck, ik, auth_req.autn, mcc, mnc, ue.k_asme);
+        auth_resp.res_len = 8;
+        if (liblte_mme_pack_authentication_response_msg(
+                &auth_resp, LIBLTE_MME_SECURITY_HDR_TYPE_PLAIN_NAS, 0, (LIBLTE_BYTE_MSG_STRUCT*)nas_tx.get()) !=
+            LIBLTE_SUCCESS) {
+          return false;
+        }
+        break;
+      }
+      case LIBLTE_MME_MSG_TYPE_SECURITY_MODE_COMMAND: {
+        LIBLTE_MME_SECURITY_MODE_COMPLETE_MSG_STRUCT sm_comp = {};
+        uint8_t                                      k_nas_enc[32], k_nas_int[32];
+        srsran::security_generate_k_nas(ue.k_asme,
+                                        srsran::CIPHERING_ALGORITHM_ID_EEA0,
+                                        srsran::INTEGRITY_ALGORITHM_ID_128_EIA2,
+                                        k_nas_enc,
+                                        k_nas_int);
+        if (liblte_mme_pack_security_mode_complete_msg(
+                &sm_comp,
+                LIBLTE_MME_SECURITY_HDR_TYPE_INTEGRITY_AND_CIPHERED_WITH_NEW_EPS_SECURITY_CONTEXT,
+                0,
+                (LIBLTE_BYTE_MSG_STRUCT*)nas_tx.get()) != LIBLTE_SUCCESS) {
+          return false;
+        }
+        srsran::security_128_eia2(&k_nas_int[16],
+                                  0,
+                                  0,
+                                  srsran::SECURITY_DIRECTION_UPLINK,
+                                  &nas_tx->msg[5],
+                                  nas_tx->N_bytes - 5,
+                                  &nas_tx->msg[1]);
+        break;
+      }
+      default:
+        // Authentication or Attach Reject
+        return false;
+    }
+
+    s1ap_pdu_t pdu;
+    pdu.set_init_msg().load_info_obj(ASN1_S1AP_ID_UL_NAS_TRANSPORT);
+    asn1::s1ap::ul_nas_transport_s& container = pdu.init_msg().value.ul_nas_transport();
+    container->enb_ue_s1ap_id.value           = enb_ue_s1ap_id;
+    container->mme_ue_s1ap_id.value           = ue.mme_ue_s1ap_id;
+    container->nas_pdu.value.resize(nas_tx->N_bytes);
+    memcpy(container->nas_pdu.value.data(), nas_tx->msg, nas_tx->N_bytes);
+    return send_pdu(pdu, 1 + enb_ue_s1ap_id % 8);
+  }
+
+  srsran::unique_socket          m_socket;
+  sockaddr_in                    m_mme_addr = {};
+  std::map<uint32_t, bench_ue_t> m_ues;
+};
+
+/// Writes the subscribers of the benchmark to a temporary HSS database, all of them sharing K and OPc
+static bool write_db_file(const std::string& db_file)
+{
+  FILE* f = fopen(db_file.c_str(), "w");
+  if (f == nullptr) {
+    return false;
+  }
+  for (uint32_t i = 0; i < bench_nof_ues; i++) {
+    fprintf(f,
+            "ue%d,mil,%015" PRIu64 ",00112233445566778899aabbccddeeff,opc,63bfa50ee6523365ff14c1f45f88737d,8000,"
+            "000000001234,7,dynamic\n",
+            i,
+            first_imsi + i);
+  }
+  return fclose(f) == 0;
+}
+
+int run_benchmark()
+{
+  char db_path[] = "/tmp/mme_attach_benchmark_XXXXXX";
+  int  db_fd     = mkstemp(db_path);
+  TESTASSERT(db_fd >= 0);
+  close(db_fd);
+  std::string db_file = db_path;
+  TESTASSERT(write_db_file(db_file));
+
+  hss_args_t hss_args       = {};
+  hss_args.db_file          = db_file;
+  hss_args.mcc              = mcc;
+  hss_args.mnc              = mnc;
+  hss_args.nof_auth_vectors = 4;
+  hss* hss                  = hss::get_instance();
+  TESTASSERT(hss->init(&hss_args) == SRSRAN_SUCCESS);
+
+  spgw_s11_stub spgw;
+  TESTASSERT(spgw.init());
+
+  mme_args_t mme_args                     = {};
+  mme_args.s1ap_args.mme_code             = 1;
+  mme_args.s1ap_args.mme_group            = 1;
+  mme_args.s1ap_args.tac                  = tac;
+  mme_args.s1ap_args.mcc                  = mcc;
+  mme_args.s1ap_args.mnc                  = mnc;
+  mme_args.s1ap_args.paging_timer         = 2;
+  mme_args.s1ap_args.mme_bind_addr        = "127.0.0.1";
+  mme_args.s1ap_args.mme_name             = "srsmme01";
+  mme_args.s1ap_args.dns_addr             = "8.8.8.8";
+  mme_args.s1ap_args.full_net_name        = "Software Radio Systems RAN";
+  mme_args.s1ap_args.short_net_name       = "srsRAN";
+  mme_args.s1ap_args.mme_apn              = "srsapn";
+  mme_args.s1ap_args.encryption_algo      = srsran::CIPHERING_ALGORITHM_ID_EEA0;
+  mme_args.s1ap_args.integrity_algo       = srsran::INTEGRITY_ALGORITHM_ID_128_EIA2;
+  mme_args.s1ap_args.request_imeisv       = false;
+  mme_args.nof_workers                    = bench_nof_workers;
+  mme* mme                                = mme::get_instance();
+  TESTASSERT(mme->init(&mme_args) == SRSRAN_SUCCESS);
+  mme->start();
+
+  enb_emulator enb;
+  TESTASSERT(enb.connect());
+  TESTASSERT(enb.s1_setup());
+
+  // Keeps the given number of attaches in flight, starting the next one as soon as one finishes
+  std::vector<double> latencies;
+  uint32_t            nof_started = 0;
+  auto                tic         = std::chrono::steady_clock::now();
+  for (; nof_started < std::min(bench_nof_inflight, bench_nof_ues); nof_started++) {
+    TESTASSERT(enb.start_attach(nof_started, first_imsi + nof_started));
+  }
+  while (latencies.size() < bench_nof_ues) {
+    s1ap_pdu_t pdu;
+    TESTASSERT(enb.recv_pdu(pdu));
+    double latency = enb.handle_pdu(pdu);
+    TESTASSERT(latency >= 0);
+    if (latency > 0) {
+      latencies.push_back(latency);
+      if (nof_started < bench_nof_ues) {
+        TESTASSERT(enb.start_attach(nof_started, first_imsi + nof_started));
+        nof_started++;
+      }
+    }
+  }
+  double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - tic).count();
+
+  mme->stop();
+  mme->cleanup();
+  spgw.stop();
+  hss->stop();
+  hss->cleanup();
+  unlink(db_file.c_str());
+  unlink((db_file + ".sqn").c_str());
+
+  // The MME prints every NAS message to the console, the results come last
+  std::sort(latencies.begin(), latencies.end());
+  double mean = 0;
+  for (double latency : latencies) {
+    mean += latency / latencies.size();
+  }
+  printf("\nAttaches over loopback SCTP, latency in us from the Attach Request to the Initial Context Setup Request\n");
+  printf("%8s %8s %8s %12s %10s %10s %10s %10s\n",
+         "UEs",
+         "workers",
+         "parallel",
+         "attaches/s",
+         "mean",
+         "p50",
+         "p99",
+         "max");
+  printf("%8d %8d %8d %12.1f %10.1f %10.1f %10.1f %10.1f\n",
+         bench_nof_ues,
+         bench_nof_workers,
+         bench_nof_inflight,
+         bench_nof_ues / elapsed,
+         mean,
+         latencies[latencies.size() / 2],
+         latencies[latencies.size() * 99 / 100],
+         latencies.back());
+  return SRSRAN_SUCCESS;
+}
+
+void usage(char* prog)
+{
+  printf("Usage: %s [nwp]\n", prog);
+  printf("\t-n number of attached UEs [Default %d]\n", bench_nof_ues);
+  printf("\t-w number of MME UE workers [Default %d]\n", bench_nof_workers);
+  printf("\t-p number of attaches in progress [Default %d]\n", bench_nof_inflight);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "nwp")) != -1) {
+    switch (opt) {
+      case 'n':
+        bench_nof_ues = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'w':
+        bench_nof_workers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'p':
+        bench_nof_inflight = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srslog::fetch_basic_logger("S1AP", false).set_level(srslog::basic_levels::error);
+  srslog::fetch_basic_logger("NAS", false).set_level(srslog::basic_levels::error);
+  srslog::fetch_basic_logger("MME GTPC", false).set_level(srslog::basic_levels::error);
+  srslog::fetch_basic_logger("HSS", false).set_level(srslog::basic_levels::error);
+  srslog::init();
+
+  TESTASSERT(run_benchmark() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
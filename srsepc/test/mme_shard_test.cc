@@ -0,0 +1,388 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsepc/hdr/hss/hss.h"
+#include "srsepc/hdr/mme/mme.h"
+#include "srsepc/hdr/mme/mme_gtpc.h"
+#include "srsepc/hdr/mme/s1ap.h"
+#include "srsran/common/int_helpers.h"
+#include "srsran/common/test_common.h"
+
+using namespace srsepc;
+
+static const uint32_t nof_workers = 4;
+static const uint64_t first_imsi  = 1010123456780;
+
+// Emulates the MME UE workers. The contexts are created in the calling thread, as the worker of the given shard would
+struct mme_shard_tester {
+  s1ap*      m_s1ap;
+  mme_gtpc*  m_gtpc;
+  nas_init_t nas_args = {};
+  nas_if_t   nas_itf  = {};
+
+  std::vector<uint64_t> imsis;
+
+  mme_shard_tester()
+  {
+    // S1-MME is not used by the routing. The invalid bind address leaves it closed while the rest of S1AP is
+    // initialized
+    s1ap_args_t args     = {};
+    args.mcc             = 0xf001;
+    args.mnc             = 0xff01;
+    args.mme_bind_addr   = "invalid";
+    args.encryption_algo = srsran::CIPHERING_ALGORITHM_ID_EEA0;
+    args.integrity_algo  = srsran::INTEGRITY_ALGORITHM_ID_128_EIA2;
+
+    m_s1ap = s1ap::get_instance();
+    m_s1ap->init(args);
+    m_s1ap->set_nof_workers(nof_workers);
+
+    // Failing to bind S11 is fine too, the GTP-C messages are only needed to allocate the control TEIDs
+    m_gtpc = mme_gtpc::get_instance();
+    m_gtpc->init();
+
+    nas_args.mcc         = args.mcc;
+    nas_args.mnc         = args.mnc;
+    nas_args.cipher_algo = args.encryption_algo;
+    nas_args.integ_algo  = args.integrity_algo;
+    nas_itf.s1ap         = m_s1ap;
+    nas_itf.gtpc         = m_gtpc;
+    nas_itf.hss          = hss::get_instance();
+    nas_itf.mme          = mme::get_instance();
+  }
+
+  ~mme_shard_tester()
+  {
+    // GTP-C is not reset by its initialization, the next test allocates the same control TEIDs again
+    for (uint64_t imsi : imsis) {
+      m_gtpc->send_delete_session_request(imsi);
+    }
+    m_s1ap->stop();
+    s1ap::cleanup();
+    mme::cleanup();
+    hss::cleanup();
+  }
+
+  void add_enb(uint16_t enb_id, int32_t assoc)
+  {
+    enb_ctx_t              enb_ctx = {};
+    struct sctp_sndrcvinfo sri     = {};
+    enb_ctx.enb_id                 = enb_id;
+    sri.sinfo_assoc_id             = assoc;
+    enb_ctx.sri                    = sri;
+    m_s1ap->add_new_enb_ctx(enb_ctx, &sri);
+  }
+
+  // Creates the registered context of a UE connected to the eNB, as the worker of the shard does during the attach
+  nas* attach_ue(uint64_t imsi, uint32_t shard, int32_t assoc, uint32_t enb_ue_s1ap_id)
+  {
+    m_s1ap->set_worker_shard(shard);
+    nas* nas_ctx                              = new nas(nas_args, nas_itf);
+    nas_ctx->m_emm_ctx.imsi                   = imsi;
+    nas_ctx->m_emm_ctx.state                  = EMM_STATE_REGISTERED;
+    nas_ctx->m_ecm_ctx.state                  = ECM_STATE_CONNECTED;
+    nas_ctx->m_ecm_ctx.enb_ue_s1ap_id         = enb_ue_s1ap_id;
+    nas_ctx->m_ecm_ctx.mme_ue_s1ap_id         = m_s1ap->get_next_mme_ue_s1ap_id();
+    nas_ctx->m_ecm_ctx.enb_sri.sinfo_assoc_id = assoc;
+    nas_ctx->m_sec_ctx.guti.m_tmsi            = m_s1ap->allocate_m_tmsi(imsi);
+    TESTASSERT(m_s1ap->add_nas_ctx_to_imsi_map(nas_ctx));
+    TESTASSERT(m_s1ap->add_nas_ctx_to_mme_ue_s1ap_id_map(nas_ctx));
+    TESTASSERT(m_s1ap->add_ue_to_enb_set(assoc, nas_ctx->m_ecm_ctx.mme_ue_s1ap_id));
+    TESTASSERT(m_gtpc->send_create_session_request(imsi));
+    imsis.push_back(imsi);
+    m_s1ap->set_worker_shard(0);
+    return nas_ctx;
+  }
+
+  // New MME UE S1AP Id of a UE coming back from idle, as its worker allocates it for the Service Request
+  void connect_ue(nas* nas_ctx, int32_t assoc, uint32_t enb_ue_s1ap_id)
+  {
+    m_s1ap->set_worker_shard(nas_ctx->m_shard);
+    nas_ctx->m_ecm_ctx.state                  = ECM_STATE_CONNECTED;
+    nas_ctx->m_ecm_ctx.enb_ue_s1ap_id         = enb_ue_s1ap_id;
+    nas_ctx->m_ecm_ctx.mme_ue_s1ap_id         = m_s1ap->get_next_mme_ue_s1ap_id();
+    nas_ctx->m_ecm_ctx.enb_sri.sinfo_assoc_id = assoc;
+    TESTASSERT(m_s1ap->add_nas_ctx_to_mme_ue_s1ap_id_map(nas_ctx));
+    TESTASSERT(m_s1ap->add_ue_to_enb_set(assoc, nas_ctx->m_ecm_ctx.mme_ue_s1ap_id));
+    m_s1ap->set_worker_shard(0);
+  }
+
+  // Worker handling the S11 messages sent to the MME control TEID, as mme::handle_s11_rx_pdu() routes them
+  int get_s11_shard(uint32_t mme_ctrl_teid)
+  {
+    uint64_t imsi = 0;
+    if (not m_gtpc->get_imsi_from_ctrl_teid(mme_ctrl_teid, &imsi)) {
+      return -1;
+    }
+    return m_s1ap->get_ue_shard_from_imsi(imsi);
+  }
+};
+
+static s1ap_pdu_t make_attach_request(uint32_t enb_ue_s1ap_id, uint64_t imsi)
+{
+  LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_MSG_STRUCT pdn_con_req = {};
+  LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT           attach_req  = {};
+  pdn_con_req.proc_transaction_id                            = 1;
+  pdn_con_req.request_type                                   = LIBLTE_MME_REQUEST_TYPE_INITIAL_REQUEST;
+  pdn_con_req.pdn_type                                       = LIBLTE_MME_PDN_TYPE_IPV4;
+  liblte_mme_pack_pdn_connectivity_request_msg(&pdn_con_req, &attach_req.esm_msg);
+  attach_req.eps_attach_type          = LIBLTE_MME_EPS_ATTACH_TYPE_EPS_ATTACH;
+  attach_req.eps_mobile_id.type_of_id = LIBLTE_MME_EPS_MOBILE_ID_TYPE_IMSI;
+  attach_req.nas_ksi.nas_ksi          = LIBLTE_MME_NAS_KEY_SET_IDENTIFIER_NO_KEY_AVAILABLE;
+  for (int i = 14; i >= 0; i--) {
+    attach_req.eps_mobile_id.imsi[i] = imsi % 10;
+    imsi /= 10;
+  }
+  srsran::unique_byte_buffer_t nas_msg = srsran::make_byte_buffer();
+  TESTASSERT(nas_msg != nullptr);
+  TESTASSERT(liblte_mme_pack_attach_request_msg(&attach_req, (LIBLTE_BYTE_MSG_STRUCT*)nas_msg.get()) ==
+             LIBLTE_SUCCESS);
+
+  s1ap_pdu_t pdu;
+  pdu.set_init_msg().load_info_obj(ASN1_S1AP_ID_INIT_UE_MSG);
+  asn1::s1ap::init_ue_msg_s& container = pdu.init_msg().value.init_ue_msg();
+  container->enb_ue_s1ap_id.value      = enb_ue_s1ap_id;
+  container->nas_pdu.value.resize(nas_msg->N_bytes);
+  memcpy(container->nas_pdu.value.data(), nas_msg->msg, nas_msg->N_bytes);
+  return pdu;
+}
+
+// Initial UE Message of a UE coming back from idle. The routing does not look into the NAS message
+static s1ap_pdu_t make_service_request(uint32_t enb_ue_s1ap_id, uint32_t m_tmsi)
+{
+  s1ap_pdu_t pdu;
+  pdu.set_init_msg().load_info_obj(ASN1_S1AP_ID_INIT_UE_MSG);
+  asn1::s1ap::init_ue_msg_s& container = pdu.init_msg().value.init_ue_msg();
+  container->enb_ue_s1ap_id.value      = enb_ue_s1ap_id;
+  container->s_tmsi_present            = true;
+  srsran::uint32_to_uint8(m_tmsi, container->s_tmsi.value.m_tmsi.data());
+  return pdu;
+}
+
+// Every UE-associated message received once the UE has an MME UE S1AP Id
+static std::vector<s1ap_pdu_t> make_ue_msgs(uint32_t enb_ue_s1ap_id, uint32_t mme_ue_s1ap_id)
+{
+  std::vector<s1ap_pdu_t> pdus(5);
+  pdus[0].set_init_msg().load_info_obj(ASN1_S1AP_ID_UL_NAS_TRANSPORT);
+  pdus[0].init_msg().value.ul_nas_transport()->mme_ue_s1ap_id.value = mme_ue_s1ap_id;
+  pdus[0].init_msg().value.ul_nas_transport()->enb_ue_s1ap_id.value = enb_ue_s1ap_id;
+  pdus[1].set_init_msg().load_info_obj(ASN1_S1AP_ID_UE_CONTEXT_RELEASE_REQUEST);
+  pdus[1].init_msg().value.ue_context_release_request()->mme_ue_s1ap_id.value = mme_ue_s1ap_id;
+  pdus[1].init_msg().value.ue_context_release_request()->enb_ue_s1ap_id.value = enb_ue_s1ap_id;
+  pdus[2].set_init_msg().load_info_obj(ASN1_S1AP_ID_UE_CAP_INFO_IND);
+  pdus[2].init_msg().value.ue_cap_info_ind()->mme_ue_s1ap_id.value = mme_ue_s1ap_id;
+  pdus[2].init_msg().value.ue_cap_info_ind()->enb_ue_s1ap_id.value = enb_ue_s1ap_id;
+  pdus[3].set_successful_outcome().load_info_obj(ASN1_S1AP_ID_INIT_CONTEXT_SETUP);
+  pdus[3].successful_outcome().value.init_context_setup_resp()->mme_ue_s1ap_id.value = mme_ue_s1ap_id;
+  pdus[3].successful_outcome().value.init_context_setup_resp()->enb_ue_s1ap_id.value = enb_ue_s1ap_id;
+  pdus[4].set_successful_outcome().load_info_obj(ASN1_S1AP_ID_UE_CONTEXT_RELEASE);
+  pdus[4].successful_outcome().value.ue_context_release_complete()->mme_ue_s1ap_id.value = mme_ue_s1ap_id;
+  pdus[4].successful_outcome().value.ue_context_release_complete()->enb_ue_s1ap_id.value = enb_ue_s1ap_id;
+  return pdus;
+}
+
+/*
+ * The S1AP, S11 and timer events of a UE are all handled by the worker owning its context
+ */
+int test_ue_routing()
+{
+  mme_shard_tester tester;
+  s1ap*            s1ap = tester.m_s1ap;
+  tester.add_enb(1, 10);
+
+  std::vector<nas*> ues;
+  for (uint32_t i = 0; i < 4 * nof_workers; i++) {
+    uint64_t imsi = first_imsi + i;
+
+    // The Attach Request of an unknown UE goes to the worker of its IMSI, whatever the eNB UE S1AP Id
+    int shard = s1ap->get_ue_shard(make_attach_request(i, imsi), 10);
+    TESTASSERT(shard == (int)(imsi % nof_workers));
+    TESTASSERT(s1ap->get_ue_shard(make_attach_request(i + 1, imsi), 11) == shard);
+
+    ues.push_back(tester.attach_ue(imsi, shard, 10, i));
+    TESTASSERT(ues.back()->m_shard == (uint32_t)shard);
+    TESTASSERT(ues.back()->m_ecm_ctx.mme_ue_s1ap_id % nof_workers == (uint32_t)shard);
+  }
+
+  // MME UE S1AP Ids are unique across the workers
+  for (uint32_t i = 0; i < ues.size(); i++) {
+    TESTASSERT(ues[i]->m_ecm_ctx.mme_ue_s1ap_id != 0);
+    TESTASSERT(s1ap->find_nas_ctx_from_mme_ue_s1ap_id(ues[i]->m_ecm_ctx.mme_ue_s1ap_id) == ues[i]);
+  }
+
+  for (nas* ue : ues) {
+    int shard = (int)ue->m_shard;
+
+    // S1AP
+    for (const s1ap_pdu_t& pdu : make_ue_msgs(ue->m_ecm_ctx.enb_ue_s1ap_id, ue->m_ecm_ctx.mme_ue_s1ap_id)) {
+      TESTASSERT(s1ap->get_ue_shard(pdu, 10) == shard);
+    }
+    TESTASSERT(s1ap->get_ue_shard(make_attach_request(1234, ue->m_emm_ctx.imsi), 10) == shard);
+    TESTASSERT(s1ap->get_ue_shard(make_service_request(1234, ue->m_sec_ctx.guti.m_tmsi), 10) == shard);
+
+    // NAS timers
+    TESTASSERT(s1ap->get_ue_shard_from_imsi(ue->m_emm_ctx.imsi) == shard);
+  }
+
+  // S11, the control TEIDs are allocated in order from 1
+  uint32_t nof_teids = 0;
+  uint64_t imsi      = 0;
+  for (uint32_t teid = 1; tester.m_gtpc->get_imsi_from_ctrl_teid(teid, &imsi); teid++) {
+    nas* ue = s1ap->find_nas_ctx_from_imsi(imsi);
+    TESTASSERT(ue != nullptr);
+    TESTASSERT(tester.get_s11_shard(teid) == (int)ue->m_shard);
+    nof_teids++;
+  }
+  TESTASSERT(nof_teids == ues.size());
+
+  // Non UE-associated procedures are handled by the receiving thread
+  s1ap_pdu_t s1_setup;
+  s1_setup.set_init_msg().load_info_obj(ASN1_S1AP_ID_S1_SETUP);
+  TESTASSERT(s1ap->get_ue_shard(s1_setup, 10) < 0);
+  return SRSRAN_SUCCESS;
+}
+
+/*
+ * The Service Request of an idle UE goes to the worker that paged it, even if its context was created by a worker other
+ * than the one of its IMSI
+ */
+int test_service_request_after_paging()
+{
+  mme_shard_tester tester;
+  s1ap*            s1ap = tester.m_s1ap;
+  tester.add_enb(1, 10);
+
+  // The GUTI Attach of a UE unknown to the MME is not routed through its IMSI
+  uint64_t imsi   = first_imsi;
+  uint32_t shard  = (imsi + 1) % nof_workers;
+  nas*     ue     = tester.attach_ue(imsi, shard, 10, 1);
+  uint32_t m_tmsi = ue->m_sec_ctx.guti.m_tmsi;
+  TESTASSERT(ue->m_shard == shard);
+
+  // The UE goes idle
+  TESTASSERT(s1ap->release_ue_ecm_ctx(ue->m_ecm_ctx.mme_ue_s1ap_id));
+  TESTASSERT(ue->m_ecm_ctx.state == ECM_STATE_IDLE);
+  TESTASSERT(s1ap->find_nas_ctx_from_imsi(imsi) == ue);
+
+  // Downlink data, the S-GW notifies the MME control TEID of the UE and the worker owning it pages the UE
+  TESTASSERT(tester.get_s11_shard(1) == (int)shard);
+
+  // The paging timer of the UE
+  TESTASSERT(s1ap->get_ue_shard_from_imsi(imsi) == (int)shard);
+
+  // The Service Request carries the S-TMSI of the UE. It is routed to the same worker from any eNB UE S1AP Id and eNB
+  for (uint32_t enb_ue_s1ap_id = 0; enb_ue_s1ap_id < 2 * nof_workers; enb_ue_s1ap_id++) {
+    TESTASSERT(s1ap->get_ue_shard(make_service_request(enb_ue_s1ap_id, m_tmsi), 10) == (int)shard);
+    TESTASSERT(s1ap->get_ue_shard(make_service_request(enb_ue_s1ap_id, m_tmsi), 20) == (int)shard);
+  }
+
+  // The worker allocates a new MME UE S1AP Id, the rest of the procedure stays with it
+  tester.connect_ue(ue, 10, 2);
+  for (const s1ap_pdu_t& pdu : make_ue_msgs(2, ue->m_ecm_ctx.mme_ue_s1ap_id)) {
+    TESTASSERT(s1ap->get_ue_shard(pdu, 10) == (int)shard);
+  }
+
+  // An unknown S-TMSI is spread across the workers like any other unknown UE
+  std::set<int> shards;
+  for (uint32_t enb_ue_s1ap_id = 0; enb_ue_s1ap_id < 4 * nof_workers; enb_ue_s1ap_id++) {
+    int unknown_shard = s1ap->get_ue_shard(make_service_request(enb_ue_s1ap_id, m_tmsi + 1), 10);
+    TESTASSERT(unknown_shard >= 0 && unknown_shard < (int)nof_workers);
+    shards.insert(unknown_shard);
+  }
+  TESTASSERT(shards.size() > 1);
+  return SRSRAN_SUCCESS;
+}
+
+/*
+ * Releasing an eNB cleans the MME UE S1AP Ids of its UEs, keeping their EMM contexts
+ */
+int test_enb_release()
+{
+  mme_shard_tester tester;
+  s1ap*            s1ap = tester.m_s1ap;
+  tester.add_enb(1, 10);
+  tester.add_enb(2, 20);
+
+  std::vector<nas*> released_ues, other_ues;
+  for (uint32_t i = 0; i < 2 * nof_workers; i++) {
+    uint64_t imsi = first_imsi + 2 * i;
+    released_ues.push_back(tester.attach_ue(imsi, imsi % nof_workers, 10, i));
+    other_ues.push_back(tester.attach_ue(imsi + 1, (imsi + 1) % nof_workers, 20, i));
+  }
+  std::vector<uint32_t> released_ids;
+  for (nas* ue : released_ues) {
+    released_ids.push_back(ue->m_ecm_ctx.mme_ue_s1ap_id);
+  }
+
+  s1ap->delete_enb_ctx(10);
+  TESTASSERT(s1ap->find_enb_ctx(1) == nullptr);
+  TESTASSERT(s1ap->find_enb_ctx(2) != nullptr);
+
+  for (uint32_t i = 0; i < released_ues.size(); i++) {
+    nas* ue = released_ues[i];
+    TESTASSERT(s1ap->find_nas_ctx_from_mme_ue_s1ap_id(released_ids[i]) == nullptr);
+    TESTASSERT(ue->m_ecm_ctx.mme_ue_s1ap_id == 0);
+    TESTASSERT(ue->m_ecm_ctx.state == ECM_STATE_IDLE);
+    TESTASSERT(ue->m_emm_ctx.state == EMM_STATE_DEREGISTERED);
+    TESTASSERT(s1ap->find_nas_ctx_from_imsi(ue->m_emm_ctx.imsi) == ue);
+
+    // Its late messages are still routed to the worker of the Id, which finds no context
+    for (const s1ap_pdu_t& pdu : make_ue_msgs(i, released_ids[i])) {
+      TESTASSERT(s1ap->get_ue_shard(pdu, 10) == (int)(released_ids[i] % nof_workers));
+    }
+  }
+  for (nas* ue : other_ues) {
+    TESTASSERT(ue->m_ecm_ctx.state == ECM_STATE_CONNECTED);
+    TESTASSERT(s1ap->find_nas_ctx_from_mme_ue_s1ap_id(ue->m_ecm_ctx.mme_ue_s1ap_id) == ue);
+  }
+
+  // The released sessions no longer own control TEIDs
+  uint64_t imsi = 0;
+  for (uint32_t teid = 1; teid <= 2 * released_ues.size(); teid++) {
+    if (tester.m_gtpc->get_imsi_from_ctrl_teid(teid, &imsi)) {
+      TESTASSERT((imsi - first_imsi) % 2 == 1);
+    }
+  }
+
+  // The eNB connects again with the same association, its UEs come back with new Ids
+  tester.add_enb(1, 10);
+  for (uint32_t i = 0; i < released_ues.size(); i++) {
+    tester.connect_ue(released_ues[i], 10, i);
+    TESTASSERT(released_ues[i]->m_ecm_ctx.mme_ue_s1ap_id % nof_workers == released_ues[i]->m_shard);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  srslog::fetch_basic_logger("S1AP", false).set_level(srslog::basic_levels::warning);
+  srslog::fetch_basic_logger("NAS", false).set_level(srslog::basic_levels::warning);
+  srslog::fetch_basic_logger("MME GTPC", false).set_level(srslog::basic_levels::none);
+  srslog::init();
+
+  TESTASSERT(test_ue_routing() == SRSRAN_SUCCESS);
+  TESTASSERT(test_service_request_after_paging() == SRSRAN_SUCCESS);
+  TESTASSERT(test_enb_release() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
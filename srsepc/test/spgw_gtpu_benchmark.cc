@@ -0,0 +1,246 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsepc/hdr/spgw/gtpu.h"
+#include "srsran/common/test_common.h"
+#include "srsran/upper/gtpu.h"
+#include <arpa/inet.h>
+#include <chrono>
+#include <getopt.h>
+#include <linux/ip.h>
+#include <sys/socket.h>
+#include <thread>
+#include <vector>
+
+using namespace srsepc;
+
+static uint32_t bench_nof_ues     = 16;
+static uint32_t bench_nof_packets = 100000;
+static uint32_t bench_packet_size = 1400;
+
+static const uint32_t ip_hdr_size = 20;
+
+struct bench_result_t {
+  const char* direction;
+  uint32_t    nof_sent;
+  uint32_t    nof_received;
+  double      elapsed;
+};
+
+static in_addr_t ue_ipv4(uint32_t ue)
+{
+  return htonl(0xac100002 + ue); // 172.16.0.2 onwards
+}
+
+// IPv4 packet of the benchmark size to the UE
+static void make_ip_packet(uint32_t ue, srsran::byte_buffer_t* pdu)
+{
+  pdu->clear();
+  pdu->N_bytes      = bench_packet_size;
+  struct iphdr* iph = (struct iphdr*)pdu->msg;
+  memset(pdu->msg, 0, pdu->N_bytes);
+  iph->version  = 4;
+  iph->ihl      = 5;
+  iph->tot_len  = htons(pdu->N_bytes);
+  iph->ttl      = 64;
+  iph->protocol = IPPROTO_UDP;
+  iph->saddr    = inet_addr("8.8.8.8");
+  iph->daddr    = ue_ipv4(ue);
+}
+
+// All the UEs are connected, nothing is paged
+class gtpc_dummy : public gtpc_interface_gtpu
+{
+public:
+  void handle_idle_ue_downlink_packet(uint32_t spgw_ctr_teid, srsran::unique_byte_buffer_t msg) override {}
+};
+
+// Receives packets until the expected number arrived or nothing arrived for a while, returning how many arrived
+static uint32_t recv_packets(int fd, uint32_t nof_packets, std::chrono::steady_clock::time_point* last_rx)
+{
+  uint8_t  buf[SRSRAN_MAX_BUFFER_SIZE_BYTES];
+  uint32_t nof_received = 0;
+  while (nof_received < nof_packets && recv(fd, buf, sizeof(buf), 0) > 0) {
+    nof_received++;
+    *last_rx = std::chrono::steady_clock::now();
+  }
+  return nof_received;
+}
+
+/// Sends the packets from the internet side of SGi to the eNB UDP socket, through the SGi thread of GTP-U
+int run_downlink(int sgi, int enb, bench_result_t& result)
+{
+  std::vector<srsran::unique_byte_buffer_t> pdus(bench_nof_ues);
+  for (uint32_t ue = 0; ue < bench_nof_ues; ue++) {
+    pdus[ue] = srsran::make_byte_buffer();
+    make_ip_packet(ue, pdus[ue].get());
+  }
+
+  auto        tic     = std::chrono::steady_clock::now();
+  auto        last_rx = tic;
+  std::thread sender([&pdus, sgi]() {
+    for (uint32_t i = 0; i < bench_nof_packets; i++) {
+      const srsran::byte_buffer_t* pdu = pdus[i % bench_nof_ues].get();
+      if (write(sgi, pdu->msg, pdu->N_bytes) != (int)pdu->N_bytes) {
+        break;
+      }
+    }
+  });
+  result.direction    = "DL";
+  result.nof_sent     = bench_nof_packets;
+  result.nof_received = recv_packets(enb, bench_nof_packets, &last_rx);
+  sender.join();
+  result.elapsed = std::chrono::duration<double>(last_rx - tic).count();
+  return SRSRAN_SUCCESS;
+}
+
+/// Sends the packets from the eNB UDP socket to the S1-U socket of GTP-U, which writes them to SGi
+int run_uplink(spgw::gtpu& gtpu, int sgi, int enb, bench_result_t& result)
+{
+  std::vector<srsran::unique_byte_buffer_t> pdus(bench_nof_ues);
+  for (uint32_t ue = 0; ue < bench_nof_ues; ue++) {
+    pdus[ue] = srsran::make_byte_buffer();
+    make_ip_packet(ue, pdus[ue].get());
+    srsran::gtpu_header_t header = {};
+    header.flags                 = GTPU_FLAGS_VERSION_V1 | GTPU_FLAGS_GTP_PROTOCOL;
+    header.message_type          = GTPU_MSG_DATA_PDU;
+    header.length                = pdus[ue]->N_bytes;
+    header.teid                  = 0x200 + ue;
+    TESTASSERT(srsran::gtpu_write_header(&header, pdus[ue].get(), srslog::fetch_basic_logger("GTPU")));
+  }
+
+  sockaddr_in spgw_addr     = {};
+  spgw_addr.sin_family      = AF_INET;
+  spgw_addr.sin_port        = htons(GTPU_RX_PORT);
+  spgw_addr.sin_addr.s_addr = gtpu.get_s1u_addr();
+
+  auto        tic     = std::chrono::steady_clock::now();
+  auto        last_rx = tic;
+  std::thread sender([&pdus, &spgw_addr, enb]() {
+    for (uint32_t i = 0; i < bench_nof_packets; i++) {
+      const srsran::byte_buffer_t* pdu = pdus[i % bench_nof_ues].get();
+      sendto(enb, pdu->msg, pdu->N_bytes, 0, (sockaddr*)&spgw_addr, sizeof(spgw_addr));
+    }
+  });
+  result.direction    = "UL";
+  result.nof_sent     = bench_nof_packets;
+  result.nof_received = recv_packets(sgi, bench_nof_packets, &last_rx);
+  sender.join();
+  result.elapsed = std::chrono::duration<double>(last_rx - tic).count();
+  return SRSRAN_SUCCESS;
+}
+
+void usage(char* prog)
+{
+  printf("Usage: %s [uns]\n", prog);
+  printf("\t-u number of UE tunnels [Default %d]\n", bench_nof_ues);
+  printf("\t-n number of packets per direction [Default %d]\n", bench_nof_packets);
+  printf("\t-s IP packet size in bytes [Default %d]\n", bench_packet_size);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "uns")) != -1) {
+    switch (opt) {
+      case 'u':
+        bench_nof_ues = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'n':
+        bench_nof_packets = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 's':
+        bench_packet_size = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+  if (bench_nof_ues == 0 || bench_packet_size < ip_hdr_size ||
+      bench_packet_size > SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET) {
+    usage(argv[0]);
+    exit(-1);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  // The losses are counted by the benchmark, GTP-U would otherwise log each of them
+  srslog::fetch_basic_logger("GTPU", false).set_level(srslog::basic_levels::none);
+  srslog::init();
+
+  // A socket stands for the TUN device, the eNB listens on 127.0.0.2. The datagram queue of the socket is shorter than
+  // the one of a TUN device, the uplink losses are mostly writes to a full SGi socket
+  int sgi[2];
+  TESTASSERT(socketpair(AF_UNIX, SOCK_DGRAM, 0, sgi) == 0);
+  int         enb          = socket(AF_INET, SOCK_DGRAM, 0);
+  sockaddr_in enb_addr     = {};
+  enb_addr.sin_family      = AF_INET;
+  enb_addr.sin_port        = htons(GTPU_RX_PORT);
+  enb_addr.sin_addr.s_addr = inet_addr("127.0.0.2");
+  TESTASSERT(enb >= 0 && bind(enb, (sockaddr*)&enb_addr, sizeof(enb_addr)) == 0);
+
+  // The receivers stop once nothing arrived for 200 ms, what is still missing is lost
+  int            rcvbuf_size  = 8 * 1024 * 1024;
+  struct timeval idle_timeout = {0, 200000};
+  TESTASSERT(setsockopt(enb, SOL_SOCKET, SO_RCVBUF, &rcvbuf_size, sizeof(rcvbuf_size)) == 0);
+  TESTASSERT(setsockopt(enb, SOL_SOCKET, SO_RCVTIMEO, &idle_timeout, sizeof(idle_timeout)) == 0);
+  TESTASSERT(setsockopt(sgi[1], SOL_SOCKET, SO_RCVTIMEO, &idle_timeout, sizeof(idle_timeout)) == 0);
+
+  spgw::gtpu  gtpu;
+  gtpc_dummy  gtpc;
+  spgw_args_t args    = {};
+  args.gtpu_bind_addr = "127.0.0.1";
+  TESTASSERT(gtpu.init(&args, nullptr, &gtpc, sgi[0]) == SRSRAN_SUCCESS);
+  for (uint32_t ue = 0; ue < bench_nof_ues; ue++) {
+    srsran::gtp_fteid_t enb_fteid = {};
+    enb_fteid.ipv4                = enb_addr.sin_addr.s_addr;
+    enb_fteid.teid                = 0x100 + ue;
+    TESTASSERT(gtpu.modify_gtpu_tunnel(ue_ipv4(ue), enb_fteid, 1 + ue));
+  }
+
+  std::vector<bench_result_t> results(2);
+  TESTASSERT(run_downlink(sgi[1], enb, results[0]) == SRSRAN_SUCCESS);
+  TESTASSERT(run_uplink(gtpu, sgi[1], enb, results[1]) == SRSRAN_SUCCESS);
+  gtpu.stop();
+  close(sgi[1]);
+  close(enb);
+
+  // GTP-U prints to the console on start, the results are printed at the end
+  printf("%d UE tunnels, %d byte IP packets\n", bench_nof_ues, bench_packet_size);
+  printf("%4s %10s %10s %8s %10s %8s\n", "dir", "sent", "received", "lost %", "kpps", "Gbps");
+  for (const bench_result_t& r : results) {
+    double rate = r.elapsed > 0 ? r.nof_received / r.elapsed : 0;
+    printf("%4s %10d %10d %8.2f %10.1f %8.3f\n",
+           r.direction,
+           r.nof_sent,
+           r.nof_received,
+           100.0 * (r.nof_sent - r.nof_received) / r.nof_sent,
+           rate / 1e3,
+           rate * bench_packet_size * 8 / 1e9);
+  }
+
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
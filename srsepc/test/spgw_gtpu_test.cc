@@ -0,0 +1,371 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsepc/hdr/spgw/gtpu.h"
+#include "srsran/common/int_helpers.h"
+#include "srsran/common/test_common.h"
+#include "srsran/upper/gtpu.h"
+#include <arpa/inet.h>
+#include <chrono>
+#include <linux/ip.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <thread>
+
+using namespace srsepc;
+
+static const uint32_t nof_ues      = 4;
+static const uint32_t payload_size = 100;
+static const uint32_t ip_hdr_size  = 20;
+
+static in_addr_t ue_ipv4(uint32_t ue)
+{
+  return htonl(0xac100002 + ue); // 172.16.0.2 onwards
+}
+
+static srsran::gtp_fteid_t enb_fteid(uint32_t ue)
+{
+  srsran::gtp_fteid_t fteid = {};
+  fteid.ipv4                = inet_addr("127.0.0.2");
+  fteid.teid                = 0x100 + ue;
+  return fteid;
+}
+
+// Control TEID of the SPGW, passed to GTP-C when a packet arrives for an idle UE
+static uint32_t spgw_ctrl_teid(uint32_t ue)
+{
+  return 1 + ue;
+}
+
+// IPv4 packet to the UE, its payload holding the sequence number
+static void make_ip_packet(uint32_t ue, uint32_t sn, srsran::byte_buffer_t* pdu)
+{
+  pdu->clear();
+  pdu->N_bytes      = ip_hdr_size + payload_size;
+  struct iphdr* iph = (struct iphdr*)pdu->msg;
+  memset(iph, 0, ip_hdr_size);
+  iph->version  = 4;
+  iph->ihl      = 5;
+  iph->tot_len  = htons(pdu->N_bytes);
+  iph->ttl      = 64;
+  iph->protocol = IPPROTO_UDP;
+  iph->saddr    = inet_addr("8.8.8.8");
+  iph->daddr    = ue_ipv4(ue);
+  for (uint32_t i = 0; i < payload_size; i++) {
+    pdu->msg[ip_hdr_size + i] = i;
+  }
+  srsran::uint32_to_uint8(sn, &pdu->msg[ip_hdr_size]);
+}
+
+static bool check_ip_packet(uint32_t ue, uint32_t sn, const uint8_t* msg, uint32_t len)
+{
+  srsran::unique_byte_buffer_t expected = srsran::make_byte_buffer();
+  make_ip_packet(ue, sn, expected.get());
+  return len == expected->N_bytes && memcmp(msg, expected->msg, len) == 0;
+}
+
+// Stands for GTP-C, which queues the packets of the idle UEs while they are paged
+class gtpc_dummy : public gtpc_interface_gtpu
+{
+public:
+  void handle_idle_ue_downlink_packet(uint32_t spgw_ctr_teid, srsran::unique_byte_buffer_t msg) override
+  {
+    // GTP-C calls back into GTP-U, which takes the tunnel lock. The SGi thread must not be holding it
+    struct iphdr* iph = (struct iphdr*)msg->msg;
+    if (m_gtpu->send_downlink_pdu(iph->daddr, msg.get())) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    paging_teids.push_back(spgw_ctr_teid);
+    paging_queue.push_back(std::move(msg));
+  }
+
+  uint32_t nof_queued()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return paging_queue.size();
+  }
+
+  gtpu_interface_gtpc*                      m_gtpu = nullptr;
+  std::mutex                                mutex;
+  std::vector<uint32_t>                     paging_teids;
+  std::vector<srsran::unique_byte_buffer_t> paging_queue;
+};
+
+// GTP-U of the SPGW, with a socket in place of the TUN device and an emulated eNB listening on 127.0.0.2
+struct gtpu_tester {
+  spgw::gtpu gtpu;
+  gtpc_dummy gtpc;
+  int        sgi[2] = {-1, -1}; // SPGW and internet sides
+  int        enb    = -1;
+
+  int init()
+  {
+    TESTASSERT(socketpair(AF_UNIX, SOCK_DGRAM, 0, sgi) == 0);
+
+    enb                      = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in enb_addr     = {};
+    enb_addr.sin_family      = AF_INET;
+    enb_addr.sin_port        = htons(GTPU_RX_PORT);
+    enb_addr.sin_addr.s_addr = inet_addr("127.0.0.2");
+    TESTASSERT(enb >= 0 && bind(enb, (sockaddr*)&enb_addr, sizeof(enb_addr)) == 0);
+
+    // Nothing arriving within a second is lost
+    struct timeval timeout = {1, 0};
+    TESTASSERT(setsockopt(enb, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) == 0);
+    TESTASSERT(setsockopt(sgi[1], SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) == 0);
+
+    spgw_args_t args    = {};
+    args.gtpu_bind_addr = "127.0.0.1";
+    gtpc.m_gtpu         = &gtpu;
+    TESTASSERT(gtpu.init(&args, nullptr, &gtpc, sgi[0]) == SRSRAN_SUCCESS);
+    for (uint32_t ue = 0; ue < nof_ues; ue++) {
+      TESTASSERT(gtpu.modify_gtpu_tunnel(ue_ipv4(ue), enb_fteid(ue), spgw_ctrl_teid(ue)));
+    }
+    return SRSRAN_SUCCESS;
+  }
+
+  ~gtpu_tester()
+  {
+    // The SGi socket of the SPGW is closed by GTP-U
+    gtpu.stop();
+    close(sgi[1]);
+    close(enb);
+  }
+
+  // Sends the packets in a burst, so that the SGi thread reads them in batches
+  int send_sgi_packets(uint32_t nof_packets)
+  {
+    srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+    for (uint32_t i = 0; i < nof_packets; i++) {
+      make_ip_packet(i % nof_ues, i, pdu.get());
+      TESTASSERT(write(sgi[1], pdu->msg, pdu->N_bytes) == (int)pdu->N_bytes);
+    }
+    return SRSRAN_SUCCESS;
+  }
+
+  // Receives a packet at the eNB, returning its TEID and the bytes after the GTP-U header
+  int recv_enb_packet(srsran::byte_buffer_t* pdu, uint32_t* teid)
+  {
+    pdu->clear();
+    int n = recv(enb, pdu->msg, SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET, 0);
+    TESTASSERT(n > 0);
+    pdu->N_bytes = n;
+
+    srsran::gtpu_header_t header;
+    TESTASSERT(srsran::gtpu_read_header(pdu, &header, srslog::fetch_basic_logger("GTPU")));
+    TESTASSERT(header.message_type == GTPU_MSG_DATA_PDU);
+    TESTASSERT(header.length == pdu->N_bytes);
+    *teid = header.teid;
+    return SRSRAN_SUCCESS;
+  }
+
+  // Sends a GTP-U packet from the eNB to the S1-U socket of the SPGW
+  int send_enb_packet(uint32_t ue, uint32_t sn)
+  {
+    srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+    make_ip_packet(ue, sn, pdu.get());
+    srsran::gtpu_header_t header = {};
+    header.flags                 = GTPU_FLAGS_VERSION_V1 | GTPU_FLAGS_GTP_PROTOCOL;
+    header.message_type          = GTPU_MSG_DATA_PDU;
+    header.length                = pdu->N_bytes;
+    header.teid                  = 0x200 + ue;
+    TESTASSERT(srsran::gtpu_write_header(&header, pdu.get(), srslog::fetch_basic_logger("GTPU")));
+
+    sockaddr_in spgw_addr     = {};
+    spgw_addr.sin_family      = AF_INET;
+    spgw_addr.sin_port        = htons(GTPU_RX_PORT);
+    spgw_addr.sin_addr.s_addr = gtpu.get_s1u_addr();
+    TESTASSERT(sendto(enb, pdu->msg, pdu->N_bytes, 0, (sockaddr*)&spgw_addr, sizeof(spgw_addr)) ==
+               (int)pdu->N_bytes);
+    return SRSRAN_SUCCESS;
+  }
+};
+
+/*
+ * The SGi packets reach the eNB of their UE through the S1-U socket, in order, whatever the batches they are read in
+ */
+int test_downlink()
+{
+  gtpu_tester tester;
+  TESTASSERT(tester.init() == SRSRAN_SUCCESS);
+
+  const uint32_t nof_packets = 3 * 32 + 5;
+  TESTASSERT(tester.send_sgi_packets(nof_packets) == SRSRAN_SUCCESS);
+
+  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+  std::vector<uint32_t>        next_sn(nof_ues);
+  for (uint32_t ue = 0; ue < nof_ues; ue++) {
+    next_sn[ue] = ue;
+  }
+  for (uint32_t i = 0; i < nof_packets; i++) {
+    uint32_t teid;
+    TESTASSERT(tester.recv_enb_packet(pdu.get(), &teid) == SRSRAN_SUCCESS);
+    uint32_t ue = teid - enb_fteid(0).teid;
+    TESTASSERT(ue < nof_ues);
+    TESTASSERT(check_ip_packet(ue, next_sn[ue], pdu->msg, pdu->N_bytes));
+    next_sn[ue] += nof_ues;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+/*
+ * Packets for unknown UEs and non-IPv4 packets are dropped, without stopping the packets around them
+ */
+int test_downlink_drop()
+{
+  gtpu_tester tester;
+  TESTASSERT(tester.init() == SRSRAN_SUCCESS);
+
+  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+  make_ip_packet(nof_ues, 0, pdu.get());
+  TESTASSERT(write(tester.sgi[1], pdu->msg, pdu->N_bytes) == (int)pdu->N_bytes);
+  make_ip_packet(0, 1, pdu.get());
+  pdu->msg[0] = 0x60;
+  TESTASSERT(write(tester.sgi[1], pdu->msg, pdu->N_bytes) == (int)pdu->N_bytes);
+  make_ip_packet(1, 2, pdu.get());
+  TESTASSERT(write(tester.sgi[1], pdu->msg, pdu->N_bytes) == (int)pdu->N_bytes);
+
+  uint32_t teid;
+  TESTASSERT(tester.recv_enb_packet(pdu.get(), &teid) == SRSRAN_SUCCESS);
+  TESTASSERT(teid == enb_fteid(1).teid);
+  TESTASSERT(check_ip_packet(1, 2, pdu->msg, pdu->N_bytes));
+  TESTASSERT(recv(tester.enb, pdu->msg, pdu->get_tailroom(), MSG_DONTWAIT) < 0);
+  return SRSRAN_SUCCESS;
+}
+
+/*
+ * The packets of an idle UE go to GTP-C with the SPGW control TEID. GTP-C calls back into GTP-U, which would dead-lock
+ * if the SGi thread held the tunnel lock
+ */
+int test_downlink_paging()
+{
+  gtpu_tester tester;
+  TESTASSERT(tester.init() == SRSRAN_SUCCESS);
+
+  // The S1 release of UE 1 removes its user plane tunnel
+  TESTASSERT(tester.gtpu.delete_gtpu_tunnel(ue_ipv4(1)));
+  const uint32_t nof_packets = 2 * 32;
+  TESTASSERT(tester.send_sgi_packets(nof_packets) == SRSRAN_SUCCESS);
+
+  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+  for (uint32_t i = 0; i < nof_packets - nof_packets / nof_ues; i++) {
+    uint32_t teid;
+    TESTASSERT(tester.recv_enb_packet(pdu.get(), &teid) == SRSRAN_SUCCESS);
+    TESTASSERT(teid != enb_fteid(1).teid);
+  }
+
+  // GTP-C is called once the packets of the batch are sent
+  for (uint32_t i = 0; i < 100 && tester.gtpc.nof_queued() < nof_packets / nof_ues; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  std::lock_guard<std::mutex> lock(tester.gtpc.mutex);
+  TESTASSERT(tester.gtpc.paging_queue.size() == nof_packets / nof_ues);
+  for (uint32_t i = 0; i < tester.gtpc.paging_queue.size(); i++) {
+    const srsran::unique_byte_buffer_t& queued = tester.gtpc.paging_queue[i];
+    TESTASSERT(tester.gtpc.paging_teids[i] == spgw_ctrl_teid(1));
+    TESTASSERT(check_ip_packet(1, 1 + i * nof_ues, queued->msg, queued->N_bytes));
+  }
+  return SRSRAN_SUCCESS;
+}
+
+/*
+ * The S1-U packets are written to SGi without their GTP-U header
+ */
+int test_uplink()
+{
+  gtpu_tester tester;
+  TESTASSERT(tester.init() == SRSRAN_SUCCESS);
+
+  const uint32_t nof_packets = 3 * 32 + 5;
+  for (uint32_t i = 0; i < nof_packets; i++) {
+    TESTASSERT(tester.send_enb_packet(i % nof_ues, i) == SRSRAN_SUCCESS);
+  }
+  uint8_t buf[SRSRAN_MAX_BUFFER_SIZE_BYTES];
+  for (uint32_t i = 0; i < nof_packets; i++) {
+    int n = read(tester.sgi[1], buf, sizeof(buf));
+    TESTASSERT(n > 0);
+    TESTASSERT(check_ip_packet(i % nof_ues, i, buf, n));
+  }
+  return SRSRAN_SUCCESS;
+}
+
+/*
+ * GTP-C updates the tunnels while both user plane threads forward packets, and the threads stop promptly once idle
+ */
+int test_tunnel_updates_and_stop()
+{
+  std::chrono::steady_clock::time_point stop_start;
+  {
+    gtpu_tester tester;
+    TESTASSERT(tester.init() == SRSRAN_SUCCESS);
+
+    std::atomic<bool> running = {true};
+    std::thread       gtpc_thread([&tester, &running]() {
+      for (uint32_t i = 0; running; i++) {
+        uint32_t ue = i % nof_ues;
+        tester.gtpu.delete_gtpu_tunnel(ue_ipv4(ue));
+        tester.gtpu.modify_gtpu_tunnel(ue_ipv4(ue), enb_fteid(ue), spgw_ctrl_teid(ue));
+      }
+    });
+
+    // Each packet either reaches the eNB or GTP-C, depending on the tunnel state. They are sent one at a time, the
+    // eNB socket would otherwise drop them while the GTP-C thread takes the CPU
+    const uint32_t nof_packets  = 32 * 32;
+    uint32_t       nof_received = 0;
+    uint8_t        buf[SRSRAN_MAX_BUFFER_SIZE_BYTES];
+    for (uint32_t i = 0; i < nof_packets; i++) {
+      TESTASSERT(tester.send_sgi_packets(1) == SRSRAN_SUCCESS);
+      TESTASSERT(tester.send_enb_packet(0, i) == SRSRAN_SUCCESS);
+      for (uint32_t j = 0; j < 1000 && nof_received + tester.gtpc.nof_queued() <= i; j++) {
+        pollfd pfd = {tester.enb, POLLIN, 0};
+        if (poll(&pfd, 1, 1) > 0 && recv(tester.enb, buf, sizeof(buf), 0) > 0) {
+          nof_received++;
+        }
+      }
+      TESTASSERT(nof_received + tester.gtpc.nof_queued() == i + 1);
+      int n = read(tester.sgi[1], buf, sizeof(buf));
+      TESTASSERT(n > 0);
+      TESTASSERT(check_ip_packet(0, i, buf, n));
+    }
+    running = false;
+    gtpc_thread.join();
+    stop_start = std::chrono::steady_clock::now();
+  }
+  TESTASSERT(std::chrono::steady_clock::now() - stop_start < std::chrono::milliseconds(500));
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  srslog::fetch_basic_logger("GTPU", false).set_level(srslog::basic_levels::warning);
+  srslog::init();
+
+  TESTASSERT(test_downlink() == SRSRAN_SUCCESS);
+  TESTASSERT(test_downlink_drop() == SRSRAN_SUCCESS);
+  TESTASSERT(test_downlink_paging() == SRSRAN_SUCCESS);
+  TESTASSERT(test_uplink() == SRSRAN_SUCCESS);
+  TESTASSERT(test_tunnel_updates_and_stop() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -79,10 +79,10 @@ class rx_harq_softbuffer
 {
 public:
   rx_harq_softbuffer() { bzero(&buffer, sizeof(buffer)); }
-  explicit rx_harq_softbuffer(uint32_t nof_prb_)
+  rx_harq_softbuffer(uint32_t nof_prb_, srsran_softbuffer_slab_t* slab)
   {
-    // Note: for now we use same size regardless of nof_prb_
-    srsran_softbuffer_rx_init_guru(&buffer, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB);
+    // Note: the code blocks are taken from the slab on reset(tbs_bits), so the size does not depend on nof_prb_
+    srsran_softbuffer_rx_init_slab(&buffer, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, slab);
   }
   rx_harq_softbuffer(const rx_harq_softbuffer&) = delete;
   rx_harq_softbuffer(rx_harq_softbuffer&& other) noexcept
@@ -104,6 +104,8 @@ public:
 
   void reset() { srsran_softbuffer_rx_reset(&buffer); }
   void reset(uint32_t tbs_bits) { srsran_softbuffer_rx_reset_tbs(&buffer, tbs_bits); }
+  /// Returns the code blocks to the slab once the TB does not need to be combined anymore
+  void release() { srsran_softbuffer_rx_release(&buffer); }
 
   srsran_softbuffer_rx_t&       operator*() { return buffer; }
   const srsran_softbuffer_rx_t& operator*() const { return buffer; }
@@ -131,6 +133,9 @@ public:
   srsran::unique_pool_ptr<tx_harq_softbuffer> get_tx(uint32_t nof_prb);
   srsran::unique_pool_ptr<rx_harq_softbuffer> get_rx(uint32_t nof_prb);
 
+  /// Code block storage of the Rx soft-buffers, shared by all the cells and UEs
+  srsran_softbuffer_slab_t& get_rx_slab() { return rx_slab; }
+
   static harq_softbuffer_pool& get_instance()
   {
     static harq_softbuffer_pool pool;
@@ -139,8 +144,13 @@ public:
 
 private:
   const static uint32_t MAX_HARQ = 16;
+  /// Code blocks allocated at once by the Rx slab, around 7 MB of 8-bit soft bits
+  const static uint32_t RX_SLAB_SEGMENT_LEN = 256;
+
+  harq_softbuffer_pool();
+  ~harq_softbuffer_pool();
 
-  harq_softbuffer_pool() = default;
+  srsran_softbuffer_slab_t rx_slab = {};
 
   std::array<std::unique_ptr<srsran::obj_pool_itf<tx_harq_softbuffer> >, SRSRAN_MAX_PRB_NR> tx_pool;
   std::array<std::unique_ptr<srsran::obj_pool_itf<rx_harq_softbuffer> >, SRSRAN_MAX_PRB_NR> rx_pool;
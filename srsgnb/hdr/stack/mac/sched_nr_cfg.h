@@ -134,6 +134,8 @@ struct cell_config_manager {
   asn1::copy_ptr<asn1::rrc_nr::dl_cfg_common_sib_s> dl_cfg_common;
   asn1::copy_ptr<asn1::rrc_nr::ul_cfg_common_sib_s> ul_cfg_common;
   srsran_duplex_config_nr_t                         duplex = {};
+  std::string                                       sched_policy;
+  std::string                                       sched_policy_args;
   const sched_args_t&                               sched_args;
   const srsran::phy_cfg_nr_t                        default_ue_phy_cfg;
 
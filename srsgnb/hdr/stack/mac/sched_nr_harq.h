@@ -141,7 +141,7 @@ public:
   void new_slot(slot_point slot_rx_);
 
   int dl_ack_info(uint32_t pid, uint32_t tb_idx, bool ack) { return dl_harqs[pid].ack_info(tb_idx, ack); }
-  int ul_crc_info(uint32_t pid, bool ack) { return ul_harqs[pid].ack_info(0, ack); }
+  int ul_crc_info(uint32_t pid, bool ack);
 
   uint32_t            nof_dl_harqs() const { return dl_harqs.size(); }
   uint32_t            nof_ul_harqs() const { return ul_harqs.size(); }
@@ -52,6 +52,7 @@ struct sched_nr_ue_cc_cfg_t {
 struct sched_nr_ue_lc_ch_cfg_t {
   uint32_t        lcid; // 1..32
   mac_lc_ch_cfg_t cfg;
+  uint32_t        five_qi = 0; // 5QI of the DRB, 0 if unknown
 };
 
 struct sched_nr_ue_cfg_t {
@@ -107,6 +108,8 @@ struct sched_nr_cell_cfg_t {
   double                               dl_center_frequency_hz;
   double                               ul_center_frequency_hz;
   double                               ssb_center_freq_hz;
+  std::string                          sched_policy = "time_rr"; // DL and UL data scheduling policy (time_rr, time_pf)
+  std::string                          sched_policy_args;        // Scheduler policy-specific arguments
 };
 
 class sched_nr_interface
@@ -0,0 +1,127 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SCHED_NR_TIME_PF_H
+#define SRSRAN_SCHED_NR_TIME_PF_H
+
+#include "sched_nr_time_rr.h"
+#include <vector>
+
+namespace srsenb {
+namespace sched_nr_impl {
+
+/**
+ * Proportional-fair scheduler weighted by the QoS of the UE bearers.
+ *
+ * The priority of a UE is w(5QI) * (1 + waited_ms / PDB) * r / R^fairness_coeff, where r is the rate expected from the
+ * UE channel, R the rate served to the UE on average, w grows with the 5QI priority level and waited_ms is the time the
+ * UE has had pending data without being served. HARQ retransmissions go first. The UEs are ordered with a heap built
+ * in linear time, and the average rates are decayed lazily, so that the cost per slot is linear with the number of
+ * active UEs.
+ *
+ * In frequency-selective mode, the DL PRBs are assigned jointly to the UEs with highest priority, favouring for each UE
+ * the subbands where it reported a better CQI. The PRBs of a UE must be contiguous, as DCI format 1_0 only supports
+ * resource allocation type 1, so the subbands are assigned greedily by decreasing priority times subband spectral
+ * efficiency, each UE only growing its allocation with subbands adjacent to the ones it already got.
+ */
+class sched_nr_time_pf : public sched_nr_base
+{
+public:
+  sched_nr_time_pf(const bwp_params_t& bwp_cfg_, const std::string& policy_args, bool freq_selective_ = false);
+
+  void sched_dl_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc) override;
+  void sched_ul_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc) override;
+
+private:
+  /// Exponential average of the rate served to a UE in one direction. The stored value is scaled by the common
+  /// decay factor of the direction, so that the average of all UEs is decayed in one operation per slot
+  struct avg_rate {
+    double scaled_avg = 0;
+  };
+  struct ue_ctxt {
+    explicit ue_ctxt(uint16_t rnti_) : rnti(rnti_) {}
+
+    const uint16_t rnti;
+    avg_rate       dl_rate, ul_rate;
+    slot_point     dl_wait_start, ul_wait_start; ///< First slot with pending data not yet served
+    float          prio = 0;
+    bool           retx = false;
+    slot_ue*       s_ue = nullptr;
+  };
+  struct rate_decay {
+    double scale = 1; ///< Inverse of the accumulated decay, grows every slot
+    void   new_slot(rnti_map_t<ue_ctxt>& ue_db, avg_rate ue_ctxt::*rate);
+    double get(const avg_rate& r) const { return r.scaled_avg / scale; }
+    void   save_alloc(avg_rate& r, uint32_t nof_bytes) const { r.scaled_avg += alpha * nof_bytes * scale; }
+  };
+
+  /// UE being assigned DL subbands in frequency-selective mode
+  struct fs_candidate {
+    ue_ctxt*   ctxt;
+    uint32_t   ss_id;
+    prb_bitmap used_prbs;     ///< PRBs not available to the UE
+    float      bytes    = 0;  ///< Bytes expected from the assigned subbands
+    int        sb_start = -1; ///< First assigned subband, -1 if none
+    int        sb_stop  = -1; ///< Last assigned subband plus one
+  };
+  /// Metric of assigning a subband to a candidate UE
+  struct fs_metric {
+    float    metric;
+    uint32_t cand_idx;
+    uint32_t sb;
+  };
+
+  void         new_slot(slot_ue_map_t& ue_db, slot_point pdcch_slot);
+  float        compute_prio(ue_ctxt& ctxt, bool dl) const;
+  float        expected_bytes_per_prb(const slot_ue& ue, bool dl) const;
+  float        expected_dl_bytes_per_prb(const slot_ue& ue, uint32_t prb_idx) const;
+  uint32_t     try_dl_alloc(ue_ctxt& ctxt, bwp_slot_allocator& slot_alloc);
+  uint32_t     try_ul_alloc(ue_ctxt& ctxt, bwp_slot_allocator& slot_alloc);
+  void         sched_dl_freq_selective(bwp_slot_allocator& slot_alloc);
+  void         assign_subbands();
+  uint32_t     try_dl_freq_selective_alloc(fs_candidate& cand, bwp_slot_allocator& slot_alloc);
+  prb_interval subband_prbs(uint32_t sb) const;
+  static bool  prio_compare(const ue_ctxt* lhs, const ue_ctxt* rhs);
+
+  /// Weight of the average rate, per slot
+  static constexpr double alpha = 0.01;
+
+  const bwp_params_t*   bwp_cfg;
+  float                 fairness_coeff = 1;
+  slot_point            current_slot;
+  rnti_map_t<ue_ctxt>   ue_history_db;
+  rate_decay            dl_decay, ul_decay;
+  std::vector<ue_ctxt*> queue;
+
+  // Frequency-selective mode
+  bool                      freq_selective = false;
+  uint32_t                  sb_size        = 0; ///< Subband size in PRBs
+  uint32_t                  sb_offset      = 0; ///< PRBs of the BWP start that fall before the first subband boundary
+  uint32_t                  nof_sb         = 0;
+  std::vector<fs_candidate> fs_cands;
+  std::vector<fs_metric>    fs_metrics;
+  std::vector<int>          sb_owner; ///< Candidate assigned to each subband, -1 if none
+};
+
+} // namespace sched_nr_impl
+} // namespace srsenb
+
+#endif // SRSRAN_SCHED_NR_TIME_PF_H
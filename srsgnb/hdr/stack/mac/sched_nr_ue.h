@@ -109,6 +109,9 @@ public:
   // Channel state
   uint32_t dl_cqi = 1;
   uint32_t ul_cqi = 0;
+  /// DL CQI of each CSI subband of the BWP, empty if the UE does not report subband CQIs
+  srsran::bounded_vector<uint8_t, SRSRAN_CSI_MAX_NOF_SUBBANDS> dl_subband_cqi;
+  uint32_t                                                     dl_subband_size = 0; ///< CSI subband size in PRBs
 
   harq_entity harq_ent;
 
@@ -200,6 +203,11 @@ public:
   /// Channel Information Getters
   uint32_t dl_cqi() const { return ue->dl_cqi; }
   uint32_t ul_cqi() const { return ue->ul_cqi; }
+  bool     has_dl_subband_cqi() const { return not ue->dl_subband_cqi.empty(); }
+  /// DL CQI of a PRB of the BWP, taken from the subband CQIs when the UE reports them
+  uint32_t dl_prb_cqi(uint32_t prb_idx) const;
+  /// Effective DL CQI of the PRBs of a grant, i.e. the CQI of their average spectral efficiency
+  uint32_t dl_cqi(const prb_grant& grant) const;
 
   // UE parameters common to all sectors
   uint32_t dl_bytes = 0, ul_bytes = 0;
@@ -29,10 +29,21 @@ namespace sched_nr_impl {
 
 using ue_cc_cfg_list = srsran::bounded_vector<sched_nr_ue_cc_cfg_t, SCHED_NR_MAX_CARRIERS>;
 
+/// Standardized QoS characteristics of a 5QI. See TS 23.501, Table 5.7.4-1
+struct five_qi_qos_t {
+  uint32_t prio_level; ///< Lower value means higher priority
+  uint32_t pdb_ms;     ///< Packet Delay Budget
+};
+
+/// Get QoS characteristics of a 5QI. Unknown 5QIs are treated as 5QI 9 (default bearer)
+five_qi_qos_t get_five_qi_qos(uint32_t five_qi);
+
 struct ue_cfg_manager {
   uint32_t                                       maxharq_tx = 4;
   ue_cc_cfg_list                                 carriers;
   std::array<mac_lc_ch_cfg_t, SCHED_NR_MAX_LCID> ue_bearers = {};
+  std::array<uint32_t, SCHED_NR_MAX_LCID>        five_qis   = {}; ///< 5QI of each DRB, 0 if unknown
+  uint32_t                                       qos_lcid   = 0;  ///< DRB with the highest priority 5QI, 0 if none
   srsran::phy_cfg_nr_t                           phy_cfg    = {};
 
   explicit ue_cfg_manager(uint32_t enb_cc_idx = 0);
@@ -51,6 +51,8 @@ struct rrc_cell_cfg_nr_t {
   asn1::rrc_nr::pdcch_cfg_common_s pdcch_cfg_common;
   asn1::rrc_nr::pdcch_cfg_s        pdcch_cfg_ded;
   int8_t                           pdsch_rs_power;
+  std::string                      sched_policy;      // MAC data scheduling policy (time_rr, time_pf)
+  std::string                      sched_policy_args; // MAC scheduler policy-specific arguments
 };
 
 typedef std::vector<rrc_cell_cfg_nr_t> rrc_cell_list_nr_t;
@@ -24,6 +24,27 @@
 
 namespace srsenb {
 
+harq_softbuffer_pool::harq_softbuffer_pool()
+{
+  // Only the code blocks of the TBs being received take memory, and 8-bit soft bits are enough for the LDPC decoder
+  if (srsran_softbuffer_slab_init(&rx_slab,
+                                  RX_SLAB_SEGMENT_LEN,
+                                  SRSRAN_SOFTBUFFER_SLAB_MAX_SEGMENTS,
+                                  SRSRAN_LDPC_MAX_LEN_ENCODED_CB,
+                                  sizeof(int8_t)) < SRSRAN_SUCCESS) {
+    srsran_terminate("Failed to allocate Rx soft-buffer slab");
+  }
+}
+
+harq_softbuffer_pool::~harq_softbuffer_pool()
+{
+  // The Rx soft-buffers return their code blocks to the slab when destroyed
+  for (auto& pool : rx_pool) {
+    pool.reset();
+  }
+  srsran_softbuffer_slab_free(&rx_slab);
+}
+
 void harq_softbuffer_pool::init_pool(uint32_t nof_prb, uint32_t batch_size, uint32_t thres, uint32_t init_size)
 {
   srsran_assert(nof_prb <= SRSRAN_MAX_PRB_NR, "Invalid nof prb=%d", nof_prb);
@@ -42,7 +63,7 @@ void harq_softbuffer_pool::init_pool(uint32_t nof_prb, uint32_t batch_size, uint
   tx_pool[idx].reset(new srsran::background_obj_pool<tx_harq_softbuffer>(
       batch_size, thres, init_size, init_tx_softbuffers, recycle_tx_softbuffers));
 
-  auto init_rx_softbuffers    = [nof_prb](void* ptr) { new (ptr) rx_harq_softbuffer(nof_prb); };
+  auto init_rx_softbuffers    = [this, nof_prb](void* ptr) { new (ptr) rx_harq_softbuffer(nof_prb, &rx_slab); };
   auto recycle_rx_softbuffers = [](rx_harq_softbuffer& softbuffer) { softbuffer.reset(); };
   rx_pool[idx].reset(new srsran::background_obj_pool<rx_harq_softbuffer>(
       batch_size, thres, init_size, init_rx_softbuffers, recycle_rx_softbuffers));
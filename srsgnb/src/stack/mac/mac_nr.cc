@@ -28,6 +28,7 @@
 #include "srsran/common/string_helpers.h"
 #include "srsran/common/time_prof.h"
 #include "srsran/mac/mac_rar_pdu_nr.h"
+#include "srsran/phy/phch/csi.h"
 
 //#define WRITE_SIB_PCAP
 
@@ -242,7 +243,7 @@ int mac_nr::init(const mac_nr_args_t&    args_,
 
   if (args.pcap.enable) {
     pcap = std::unique_ptr<srsran::mac_pcap>(new srsran::mac_pcap());
-    pcap->open(args.pcap.filename);
+    pcap->open(args.pcap.filename, 0, args.pcap.file_args);
   }
 
   logger.info("Started");
@@ -599,12 +600,21 @@ bool mac_nr::handle_uci_data(uint16_t rnti, const srsran_uci_cfg_nr_t& cfg_, con
   for (uint32_t i = 0; i < cfg_.nof_csi; i++) {
     // Skip if invalid or not supported CSI report
     if (not value.valid or cfg_.csi[i].cfg.quantity != SRSRAN_CSI_REPORT_QUANTITY_CRI_RI_PMI_CQI or
-        cfg_.csi[i].cfg.freq_cfg != SRSRAN_CSI_REPORT_FREQ_WIDEBAND or value.csi[i].wideband_cri_ri_pmi_cqi.cqi == 0) {
+        value.csi[i].wideband_cri_ri_pmi_cqi.cqi == 0) {
       continue;
     }
 
     // 1. Pass CQI report to scheduler
     sched->dl_cqi_info(rnti, 0, value.csi->wideband_cri_ri_pmi_cqi.cqi);
+    if (cfg_.csi[i].cfg.freq_cfg == SRSRAN_CSI_REPORT_FREQ_SUBBAND) {
+      uint32_t nof_subbands = std::min(cfg_.csi[i].cfg.nof_subbands, (uint32_t)SRSRAN_CSI_MAX_NOF_SUBBANDS);
+      std::array<uint32_t, SRSRAN_CSI_MAX_NOF_SUBBANDS> subband_cqi;
+      for (uint32_t sb = 0; sb < nof_subbands; ++sb) {
+        subband_cqi[sb] = srsran_csi_subband_cqi(&value.csi[i], sb);
+      }
+      sched->dl_subband_cqi_info(
+          rnti, 0, cfg_.csi[i].cfg.subband_size, srsran::const_span<uint32_t>(subband_cqi.data(), nof_subbands));
+    }
 
     // 2. Save CQI report for metrics stats
     srsran::rwlock_read_guard rw_lock(rwmutex);
@@ -507,11 +507,34 @@ void sched_nr::dl_cqi_info(uint16_t rnti, uint32_t cc, uint32_t cqi_value)
 {
   auto callback = [cqi_value](ue_carrier& ue_cc, event_manager::logger& ev_logger) {
     ue_cc.dl_cqi = cqi_value;
+    // Subband CQIs are only valid until the next wideband report
+    ue_cc.dl_subband_cqi.clear();
     ev_logger.push("0x{:x}: dl_cqi_info(cqi={})", ue_cc.rnti, ue_cc.dl_cqi);
   };
   pending_events->enqueue_ue_cc_feedback("dl_cqi_info", rnti, cc, callback);
 }
 
+void sched_nr::dl_subband_cqi_info(uint16_t                     rnti,
+                                   uint32_t                     cc,
+                                   uint32_t                     subband_size,
+                                   srsran::const_span<uint32_t> cqi_values)
+{
+  if (subband_size == 0 or cqi_values.size() > SRSRAN_CSI_MAX_NOF_SUBBANDS) {
+    logger->warning("SCHED: Invalid subband CQI report for rnti=0x%x", rnti);
+    return;
+  }
+  srsran::bounded_vector<uint8_t, SRSRAN_CSI_MAX_NOF_SUBBANDS> cqis;
+  for (uint32_t cqi : cqi_values) {
+    cqis.push_back(cqi);
+  }
+  auto callback = [subband_size, cqis](ue_carrier& ue_cc, event_manager::logger& ev_logger) {
+    ue_cc.dl_subband_size = subband_size;
+    ue_cc.dl_subband_cqi  = cqis;
+    ev_logger.push("0x{:x}: dl_subband_cqi_info(cqi=[{}])", ue_cc.rnti, fmt::join(cqis.begin(), cqis.end(), ","));
+  };
+  pending_events->enqueue_ue_cc_feedback("dl_subband_cqi_info", rnti, cc, std::move(callback));
+}
+
 #define VERIFY_INPUT(cond, msg, ...)                                                                                   \
   do {                                                                                                                 \
     if (not(cond)) {                                                                                                   \
@@ -170,8 +170,24 @@ int ra_sched::dl_rach_info(const dl_sched_rar_info_t& rar_info)
   return SRSRAN_SUCCESS;
 }
 
+/// Create the data scheduler selected for the cell
+static std::unique_ptr<sched_nr_base> make_data_sched(const bwp_params_t& bwp_cfg)
+{
+  const cell_config_manager& cell = bwp_cfg.cell_cfg;
+  if (cell.sched_policy == "time_pf") {
+    return std::unique_ptr<sched_nr_base>(new sched_nr_time_pf(bwp_cfg, cell.sched_policy_args));
+  }
+  if (cell.sched_policy == "freq_pf") {
+    return std::unique_ptr<sched_nr_base>(new sched_nr_time_pf(bwp_cfg, cell.sched_policy_args, true));
+  }
+  if (cell.sched_policy != "time_rr") {
+    bwp_cfg.logger.warning("Unknown NR scheduler policy \"%s\". Using time_rr", cell.sched_policy.c_str());
+  }
+  return std::unique_ptr<sched_nr_base>(new sched_nr_time_rr());
+}
+
 bwp_manager::bwp_manager(const bwp_params_t& bwp_cfg) :
-  cfg(&bwp_cfg), ra(bwp_cfg), si(bwp_cfg), grid(bwp_cfg), data_sched(new sched_nr_time_rr())
+  cfg(&bwp_cfg), ra(bwp_cfg), si(bwp_cfg), grid(bwp_cfg), data_sched(make_data_sched(bwp_cfg))
 {}
 
 } // namespace sched_nr_impl
@@ -168,6 +168,10 @@ cell_config_manager::cell_config_manager(uint32_t                   cc_,
   // MIB
   make_mib_cfg(cell, &mib);
 
+  // Data scheduler
+  sched_policy      = cell.sched_policy;
+  sched_policy_args = cell.sched_policy_args;
+
   bwps.reserve(cell.bwps.size());
   for (uint32_t i = 0; i < cell.bwps.size(); ++i) {
     bwps.emplace_back(*this, i, cell.bwps[i]);
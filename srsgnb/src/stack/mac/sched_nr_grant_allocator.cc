@@ -341,7 +341,7 @@ alloc_result bwp_slot_allocator::alloc_pdsch(slot_ue& ue, uint32_t ss_id, const
   const static int min_MCS_ccch = 4;
   if (ue.h_dl->empty()) {
     if (mcs < 0) {
-      mcs = srsran_ra_nr_cqi_to_mcs(/* cqi */ ue.dl_cqi(),
+      mcs = srsran_ra_nr_cqi_to_mcs(/* cqi */ ue.dl_cqi(dl_grant),
                                     /* cqi_table_idx */ ue.cfg().phy().csi.reports->cqi_table,
                                     /* mcs_table */ pdsch.sch.sch_cfg.mcs_table,
                                     /* dci_format */ pdcch.dci.ctx.format,
@@ -222,8 +222,9 @@ void harq_entity::new_slot(slot_point slot_rx_)
                   dl_h.max_nof_retx());
     }
   }
-  for (harq_proc& ul_h : ul_harqs) {
+  for (ul_harq_proc& ul_h : ul_harqs) {
     if (ul_h.clear_if_maxretx(slot_rx)) {
+      ul_h.get_softbuffer().release();
       logger.info("SCHED: discarding rnti=0x%x, UL TB pid=%d. Cause: Maximum number of retx exceeded (%d)",
                   rnti,
                   ul_h.pid,
@@ -232,5 +233,15 @@ void harq_entity::new_slot(slot_point slot_rx_)
   }
 }
 
+int harq_entity::ul_crc_info(uint32_t pid, bool ack)
+{
+  int ret = ul_harqs[pid].ack_info(0, ack);
+  if (ack and ret >= 0) {
+    // The TB is decoded, its code blocks are not needed for combining anymore
+    ul_harqs[pid].get_softbuffer().release();
+  }
+  return ret;
+}
+
 } // namespace sched_nr_impl
 } // namespace srsenb
\ No newline at end of file
@@ -0,0 +1,438 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsgnb/hdr/stack/mac/sched_nr_time_pf.h"
+#include "srsran/phy/phch/csi.h"
+#include "srsran/phy/phch/ra_nr.h"
+#include <algorithm>
+#include <cmath>
+
+namespace srsenb {
+namespace sched_nr_impl {
+
+/// Resource elements of a PRB available for data in a slot, assuming 2 PDCCH symbols and 1 DMRS symbol
+static const uint32_t NOF_DATA_RE_PER_PRB = 12 * 11;
+/// 5QI priority level that gets weight 1, the one of 5QI 9
+static const float REF_QOS_PRIO_LEVEL = 90;
+/// QoS applied to UEs with pending SRB data, the one of 5QI 69 (mission critical signalling)
+static const five_qi_qos_t SRB_QOS = {5, 60};
+/// Scale of the average rates beyond which they are renormalized
+static const double MAX_RATE_SCALE = 1e9;
+/// Maximum number of UEs assigned subbands jointly in a slot. It bounds the time spent in the frequency-selective
+/// assignment, which grows with the number of UEs times the number of subbands
+static const uint32_t MAX_FREQ_SELECTIVE_UES = 8;
+
+sched_nr_time_pf::sched_nr_time_pf(const bwp_params_t& bwp_cfg_, const std::string& policy_args, bool freq_selective_) :
+  bwp_cfg(&bwp_cfg_), freq_selective(freq_selective_)
+{
+  if (not policy_args.empty()) {
+    fairness_coeff = std::stof(policy_args);
+  }
+  queue.reserve(SRSENB_MAX_UES);
+
+  if (freq_selective) {
+    // Subbands of the smallest size allowed in the BWP are contained in the subbands reported by any UE
+    srsran_csi_hl_report_cfg_t sb_cfg = {};
+    if (srsran_csi_set_subbands(&sb_cfg, bwp_cfg->cfg.start_rb, bwp_cfg->nof_prb, false) < SRSRAN_SUCCESS) {
+      bwp_cfg->logger.warning("SCHED: Frequency-selective scheduling is not supported in a BWP of %d PRBs",
+                              bwp_cfg->nof_prb);
+      freq_selective = false;
+      return;
+    }
+    sb_size   = sb_cfg.subband_size;
+    sb_offset = bwp_cfg->cfg.start_rb % sb_size;
+    nof_sb    = sb_cfg.nof_subbands;
+    fs_cands.reserve(MAX_FREQ_SELECTIVE_UES);
+    fs_metrics.reserve(MAX_FREQ_SELECTIVE_UES * nof_sb);
+    sb_owner.resize(nof_sb);
+  }
+}
+
+void sched_nr_time_pf::new_slot(slot_ue_map_t& ue_db, slot_point pdcch_slot)
+{
+  current_slot = pdcch_slot;
+
+  // remove deleted users from history
+  for (auto it = ue_history_db.begin(); it != ue_history_db.end();) {
+    if (not ue_db.contains(it->first)) {
+      it = ue_history_db.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  // add new users to history db
+  for (auto& u : ue_db) {
+    auto it = ue_history_db.find(u.first);
+    if (it == ue_history_db.end()) {
+      it = ue_history_db.insert(u.first, ue_ctxt{u.first}).value();
+    }
+    it->second.s_ue = &u.second;
+  }
+}
+
+void sched_nr_time_pf::rate_decay::new_slot(rnti_map_t<ue_ctxt>& ue_db, avg_rate ue_ctxt::*rate)
+{
+  scale /= (1 - alpha);
+  if (scale > MAX_RATE_SCALE) {
+    for (auto& u : ue_db) {
+      (u.second.*rate).scaled_avg /= scale;
+    }
+    scale = 1;
+  }
+}
+
+float sched_nr_time_pf::expected_bytes_per_prb(const slot_ue& ue, bool dl) const
+{
+  double se  = 0;
+  int    mcs = dl ? ue->fixed_pdsch_mcs() : ue->fixed_pusch_mcs();
+  if (mcs < 0) {
+    se = srsran_ra_nr_cqi_to_se(dl ? ue.dl_cqi() : ue.ul_cqi(), ue.cfg().phy().csi.reports->cqi_table);
+  } else {
+    srsran_mcs_table_t     mcs_table = dl ? ue.cfg().phy().pdsch.mcs_table : ue.cfg().phy().pusch.mcs_table;
+    srsran_dci_format_nr_t dci_fmt   = dl ? srsran_dci_format_nr_1_0 : srsran_dci_format_nr_0_0;
+    double       R   = srsran_ra_nr_R_from_mcs(mcs_table, dci_fmt, srsran_search_space_type_ue, srsran_rnti_type_c, mcs);
+    srsran_mod_t mod = srsran_ra_nr_mod_from_mcs(mcs_table, dci_fmt, srsran_search_space_type_ue, srsran_rnti_type_c, mcs);
+    if (not std::isnan(R) and mod != SRSRAN_MOD_NITEMS) {
+      se = R * srsran_mod_bits_x_symbol(mod);
+    }
+  }
+  // Keep a minimum rate, so that UEs with bad channel can still be scheduled
+  return std::max(se, 0.1) * NOF_DATA_RE_PER_PRB / 8;
+}
+
+float sched_nr_time_pf::expected_dl_bytes_per_prb(const slot_ue& ue, uint32_t prb_idx) const
+{
+  if (not ue.has_dl_subband_cqi() or ue->fixed_pdsch_mcs() >= 0) {
+    return expected_bytes_per_prb(ue, true);
+  }
+  double se = srsran_ra_nr_cqi_to_se(ue.dl_prb_cqi(prb_idx), ue.cfg().phy().csi.reports->cqi_table);
+  return std::max(se, 0.1) * NOF_DATA_RE_PER_PRB / 8;
+}
+
+float sched_nr_time_pf::compute_prio(ue_ctxt& ctxt, bool dl) const
+{
+  const slot_ue& ue            = *ctxt.s_ue;
+  uint32_t       pending_bytes = dl ? ue.dl_bytes : ue.ul_bytes;
+  slot_point&    wait_start    = dl ? ctxt.dl_wait_start : ctxt.ul_wait_start;
+  if (not(dl ? ue.dl_active : ue.ul_active)) {
+    // The pending bytes are not set in slots without DL (UL) resources, the UE keeps waiting
+    return 0;
+  }
+  if (pending_bytes == 0) {
+    wait_start.clear();
+    return 0;
+  }
+  if (not wait_start.valid()) {
+    wait_start = ue.pdcch_slot;
+  }
+
+  // QoS of the bearer with the highest priority. DL signalling takes precedence over data
+  five_qi_qos_t         qos   = get_five_qi_qos(0);
+  const ue_cfg_manager& uecfg = ue->ue_cfg();
+  if (dl and (ue.get_pending_bytes(srsran::srb_to_lcid(srsran::nr_srb::srb1)) or
+              ue.get_pending_bytes(srsran::srb_to_lcid(srsran::nr_srb::srb2)))) {
+    qos = SRB_QOS;
+  } else if (uecfg.qos_lcid != 0) {
+    qos = get_five_qi_qos(uecfg.five_qis[uecfg.qos_lcid]);
+  }
+  float waited_ms  = (ue.pdcch_slot - wait_start) / (float)ue.pdcch_slot.nof_slots_per_subframe();
+  float qos_weight = REF_QOS_PRIO_LEVEL / qos.prio_level * (1 + waited_ms / qos.pdb_ms);
+
+  // Proportional-fair metric
+  double avg_rate = dl ? dl_decay.get(ctxt.dl_rate) : ul_decay.get(ctxt.ul_rate);
+  if (avg_rate <= 0) {
+    return std::numeric_limits<float>::max();
+  }
+  float exp_rate = expected_bytes_per_prb(ue, dl) * bwp_cfg->nof_prb;
+  return qos_weight * exp_rate / std::pow(avg_rate, fairness_coeff);
+}
+
+bool sched_nr_time_pf::prio_compare(const ue_ctxt* lhs, const ue_ctxt* rhs)
+{
+  return (not lhs->retx and rhs->retx) or (lhs->retx == rhs->retx and lhs->prio < rhs->prio);
+}
+
+/*****************************************************************
+ *                         Downlink
+ *****************************************************************/
+
+void sched_nr_time_pf::sched_dl_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc)
+{
+  if (current_slot != slot_alloc.get_pdcch_tti()) {
+    new_slot(ue_db, slot_alloc.get_pdcch_tti());
+  }
+  dl_decay.new_slot(ue_history_db, &ue_ctxt::dl_rate);
+
+  // Compute UE priorities
+  queue.clear();
+  for (auto& u : ue_history_db) {
+    ue_ctxt& ctxt = u.second;
+    slot_ue& ue   = *ctxt.s_ue;
+    ctxt.prio     = compute_prio(ctxt, true);
+    if (ue.h_dl == nullptr) {
+      continue;
+    }
+    ctxt.retx = ue.h_dl->has_pending_retx(slot_alloc.get_tti_rx());
+    if (ctxt.retx or (ue.dl_bytes > 0 and ue.h_dl->empty())) {
+      queue.push_back(&ctxt);
+    }
+  }
+
+  // Allocate UEs in order of priority until resources are exhausted
+  std::make_heap(queue.begin(), queue.end(), prio_compare);
+  if (freq_selective) {
+    sched_dl_freq_selective(slot_alloc);
+  }
+  while (not queue.empty()) {
+    std::pop_heap(queue.begin(), queue.end(), prio_compare);
+    ue_ctxt& ctxt = *queue.back();
+    queue.pop_back();
+    dl_decay.save_alloc(ctxt.dl_rate, try_dl_alloc(ctxt, slot_alloc));
+  }
+}
+
+uint32_t sched_nr_time_pf::try_dl_alloc(ue_ctxt& ctxt, bwp_slot_allocator& slot_alloc)
+{
+  slot_ue& ue    = *ctxt.s_ue;
+  int      ss_id = ue->find_ss_id(srsran_dci_format_nr_1_0);
+  if (ss_id < 0) {
+    return 0;
+  }
+
+  if (ctxt.retx) {
+    alloc_result res = slot_alloc.alloc_pdsch(ue, ss_id, ue.h_dl->prbs());
+    return res == alloc_result::success ? ue.h_dl->tbs() / 8 : 0;
+  }
+
+  // Size the grant to the pending data, to leave PRBs for other UEs
+  prb_bitmap   used_prbs = slot_alloc.occupied_dl_prbs(ue.pdsch_slot, ss_id, srsran_dci_format_nr_1_0);
+  uint32_t     req_prbs  = std::ceil(ue.dl_bytes / expected_bytes_per_prb(ue, true));
+  prb_interval prbs      = find_empty_interval_of_length(used_prbs, std::max(req_prbs, 1U));
+  if (prbs.empty() or slot_alloc.alloc_pdsch(ue, ss_id, prbs) != alloc_result::success) {
+    return 0;
+  }
+  ctxt.dl_wait_start.clear();
+  return ue.h_dl->tbs() / 8;
+}
+
+prb_interval sched_nr_time_pf::subband_prbs(uint32_t sb) const
+{
+  uint32_t start = sb * sb_size > sb_offset ? sb * sb_size - sb_offset : 0;
+  return {start, std::min((sb + 1) * sb_size - sb_offset, bwp_cfg->nof_prb)};
+}
+
+void sched_nr_time_pf::sched_dl_freq_selective(bwp_slot_allocator& slot_alloc)
+{
+  // HARQ retxs keep their PRBs
+  while (not queue.empty() and queue.front()->retx) {
+    std::pop_heap(queue.begin(), queue.end(), prio_compare);
+    ue_ctxt& ctxt = *queue.back();
+    queue.pop_back();
+    dl_decay.save_alloc(ctxt.dl_rate, try_dl_alloc(ctxt, slot_alloc));
+  }
+
+  // Take the UEs with highest priority as candidates for the joint subband assignment
+  fs_cands.clear();
+  while (not queue.empty() and fs_cands.size() < MAX_FREQ_SELECTIVE_UES) {
+    std::pop_heap(queue.begin(), queue.end(), prio_compare);
+    ue_ctxt& ctxt = *queue.back();
+    queue.pop_back();
+    int ss_id = (*ctxt.s_ue)->find_ss_id(srsran_dci_format_nr_1_0);
+    if (ss_id < 0) {
+      continue;
+    }
+    fs_cands.emplace_back();
+    fs_candidate& cand = fs_cands.back();
+    cand.ctxt          = &ctxt;
+    cand.ss_id         = ss_id;
+    cand.used_prbs     = slot_alloc.occupied_dl_prbs(ctxt.s_ue->pdsch_slot, ss_id, srsran_dci_format_nr_1_0);
+  }
+  if (fs_cands.empty()) {
+    return;
+  }
+
+  assign_subbands();
+
+  // Allocate the PRBs of the assigned subbands. UEs without PRBs go back to the queue, to try the remaining gaps
+  for (fs_candidate& cand : fs_cands) {
+    uint32_t nof_bytes = try_dl_freq_selective_alloc(cand, slot_alloc);
+    if (nof_bytes > 0) {
+      dl_decay.save_alloc(cand.ctxt->dl_rate, nof_bytes);
+    } else {
+      queue.push_back(cand.ctxt);
+      std::push_heap(queue.begin(), queue.end(), prio_compare);
+    }
+  }
+}
+
+void sched_nr_time_pf::assign_subbands()
+{
+  // Metric of each candidate in each subband: its priority scaled by the subband spectral efficiency
+  fs_metrics.clear();
+  for (uint32_t i = 0; i < fs_cands.size(); ++i) {
+    const slot_ue& ue       = *fs_cands[i].ctxt->s_ue;
+    float          wideband = expected_bytes_per_prb(ue, true);
+    for (uint32_t sb = 0; sb < nof_sb; ++sb) {
+      float sb_rate = expected_dl_bytes_per_prb(ue, subband_prbs(sb).start());
+      fs_metrics.push_back(fs_metric{fs_cands[i].ctxt->prio * sb_rate / wideband, i, sb});
+    }
+  }
+  std::sort(fs_metrics.begin(), fs_metrics.end(), [](const fs_metric& lhs, const fs_metric& rhs) {
+    return lhs.metric > rhs.metric;
+  });
+
+  // Assign subbands by decreasing metric. A UE only grows its allocation with adjacent subbands, to keep its PRBs
+  // contiguous, and stops once the assigned subbands fit its pending data
+  std::fill(sb_owner.begin(), sb_owner.end(), -1);
+  bool assigned = true;
+  while (assigned) {
+    assigned = false;
+    for (const fs_metric& m : fs_metrics) {
+      fs_candidate& cand = fs_cands[m.cand_idx];
+      if (sb_owner[m.sb] >= 0 or cand.bytes >= cand.ctxt->s_ue->dl_bytes) {
+        continue;
+      }
+      if (cand.sb_start >= 0 and (int)m.sb != cand.sb_start - 1 and (int)m.sb != cand.sb_stop) {
+        continue;
+      }
+      prb_interval prbs     = subband_prbs(m.sb);
+      uint32_t     nof_free = 0;
+      for (uint32_t prb = prbs.start(); prb < prbs.stop(); ++prb) {
+        nof_free += cand.used_prbs.test(prb) ? 0 : 1;
+      }
+      if (nof_free == 0) {
+        continue;
+      }
+      sb_owner[m.sb] = m.cand_idx;
+      cand.sb_start  = cand.sb_start < 0 ? m.sb : std::min(cand.sb_start, (int)m.sb);
+      cand.sb_stop   = std::max(cand.sb_stop, (int)m.sb + 1);
+      cand.bytes += nof_free * expected_dl_bytes_per_prb(*cand.ctxt->s_ue, prbs.start());
+      assigned = true;
+      break;
+    }
+  }
+}
+
+uint32_t sched_nr_time_pf::try_dl_freq_selective_alloc(fs_candidate& cand, bwp_slot_allocator& slot_alloc)
+{
+  if (cand.sb_start < 0) {
+    return 0;
+  }
+  slot_ue& ue = *cand.ctxt->s_ue;
+
+  // Longest run of free PRBs in the assigned subbands
+  prb_interval span{subband_prbs(cand.sb_start).start(), subband_prbs(cand.sb_stop - 1).stop()};
+  prb_interval best;
+  for (uint32_t prb = span.start(); prb < span.stop();) {
+    if (cand.used_prbs.test(prb)) {
+      ++prb;
+      continue;
+    }
+    uint32_t start = prb;
+    while (prb < span.stop() and not cand.used_prbs.test(prb)) {
+      ++prb;
+    }
+    if (prb - start > best.length()) {
+      best = {start, prb};
+    }
+  }
+
+  // Shortest window of the run that fits the pending data, preferring the best subbands
+  float    bytes = 0, best_bytes = 0;
+  uint32_t start = best.start(), win_start = best.start(), win_stop = best.stop();
+  for (uint32_t stop = best.start(); stop < best.stop(); ++stop) {
+    bytes += expected_dl_bytes_per_prb(ue, stop);
+    while (start < stop and bytes - expected_dl_bytes_per_prb(ue, start) >= ue.dl_bytes) {
+      bytes -= expected_dl_bytes_per_prb(ue, start++);
+    }
+    if (bytes >= ue.dl_bytes and (stop + 1 - start < win_stop - win_start or
+                                  (stop + 1 - start == win_stop - win_start and bytes > best_bytes))) {
+      win_start  = start;
+      win_stop   = stop + 1;
+      best_bytes = bytes;
+    }
+  }
+
+  prb_interval prbs{win_start, win_stop};
+  if (prbs.empty() or slot_alloc.alloc_pdsch(ue, cand.ss_id, prbs) != alloc_result::success) {
+    return 0;
+  }
+  cand.ctxt->dl_wait_start.clear();
+  return ue.h_dl->tbs() / 8;
+}
+
+/*****************************************************************
+ *                          Uplink
+ *****************************************************************/
+
+void sched_nr_time_pf::sched_ul_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc)
+{
+  if (current_slot != slot_alloc.get_pdcch_tti()) {
+    new_slot(ue_db, slot_alloc.get_pdcch_tti());
+  }
+  ul_decay.new_slot(ue_history_db, &ue_ctxt::ul_rate);
+
+  // Compute UE priorities
+  queue.clear();
+  for (auto& u : ue_history_db) {
+    ue_ctxt& ctxt = u.second;
+    slot_ue& ue   = *ctxt.s_ue;
+    ctxt.prio     = compute_prio(ctxt, false);
+    if (ue.h_ul == nullptr) {
+      continue;
+    }
+    ctxt.retx = ue.h_ul->has_pending_retx(slot_alloc.get_tti_rx());
+    if (ctxt.retx or (ue.ul_bytes > 0 and ue.h_ul->empty())) {
+      queue.push_back(&ctxt);
+    }
+  }
+
+  // Allocate UEs in order of priority until resources are exhausted
+  std::make_heap(queue.begin(), queue.end(), prio_compare);
+  while (not queue.empty()) {
+    std::pop_heap(queue.begin(), queue.end(), prio_compare);
+    ue_ctxt& ctxt = *queue.back();
+    queue.pop_back();
+    ul_decay.save_alloc(ctxt.ul_rate, try_ul_alloc(ctxt, slot_alloc));
+  }
+}
+
+uint32_t sched_nr_time_pf::try_ul_alloc(ue_ctxt& ctxt, bwp_slot_allocator& slot_alloc)
+{
+  slot_ue& ue = *ctxt.s_ue;
+
+  if (ctxt.retx) {
+    alloc_result res = slot_alloc.alloc_pusch(ue, ue.h_ul->prbs());
+    return res == alloc_result::success ? ue.h_ul->tbs() / 8 : 0;
+  }
+
+  // Size the grant to the pending data, to leave PRBs for other UEs
+  uint32_t     req_prbs = std::ceil(ue.ul_bytes / expected_bytes_per_prb(ue, false));
+  prb_interval prbs = find_empty_interval_of_length(slot_alloc.occupied_ul_prbs(ue.pusch_slot), std::max(req_prbs, 1U));
+  if (prbs.empty() or slot_alloc.alloc_pusch(ue, prbs) != alloc_result::success) {
+    return 0;
+  }
+  ctxt.ul_wait_start.clear();
+  return ue.h_ul->tbs() / 8;
+}
+
+} // namespace sched_nr_impl
+} // namespace srsenb
@@ -23,6 +23,7 @@
 #include "srsgnb/hdr/stack/mac/sched_nr_helpers.h"
 #include "srsran/common/string_helpers.h"
 #include "srsran/mac/mac_sch_pdu_nr.h"
+#include "srsran/phy/phch/ra_nr.h"
 
 namespace srsenb {
 namespace sched_nr_impl {
@@ -108,6 +109,40 @@ slot_ue::slot_ue(ue_carrier& ue_, slot_point slot_tx_) : ue(&ue_), pdcch_slot(sl
   }
 }
 
+uint32_t slot_ue::dl_prb_cqi(uint32_t prb_idx) const
+{
+  if (not has_dl_subband_cqi()) {
+    return ue->dl_cqi;
+  }
+  // TS 38.214 5.2.1.4 - Subbands are aligned to the subband size in common resource blocks
+  uint32_t bwp_start = ue->bwp_cfg.active_bwp().cfg.start_rb;
+  uint32_t sb_idx    = (bwp_start + prb_idx) / ue->dl_subband_size - bwp_start / ue->dl_subband_size;
+  return ue->dl_subband_cqi[std::min(sb_idx, (uint32_t)ue->dl_subband_cqi.size() - 1)];
+}
+
+uint32_t slot_ue::dl_cqi(const prb_grant& grant) const
+{
+  if (not has_dl_subband_cqi() or grant.is_alloc_type0() or grant.prbs().empty()) {
+    // Note: RBG-based grants are not used by the scheduler yet
+    return ue->dl_cqi;
+  }
+
+  // Average the spectral efficiency of the allocated PRBs
+  srsran_csi_cqi_table_t cqi_table = ue->bwp_cfg.phy().csi.reports->cqi_table;
+  double                 avg_se    = 0;
+  for (uint32_t prb = grant.prbs().start(); prb < grant.prbs().stop(); ++prb) {
+    avg_se += srsran_ra_nr_cqi_to_se(dl_prb_cqi(prb), cqi_table);
+  }
+  avg_se /= grant.prbs().length();
+
+  // Highest CQI whose spectral efficiency does not exceed the average
+  uint32_t cqi = 1;
+  while (cqi < 15 and srsran_ra_nr_cqi_to_se(cqi + 1, cqi_table) <= avg_se) {
+    cqi++;
+  }
+  return cqi;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 ue_carrier::ue_carrier(uint16_t                              rnti_,
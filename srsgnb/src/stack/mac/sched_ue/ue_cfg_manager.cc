@@ -26,6 +26,57 @@
 namespace srsenb {
 namespace sched_nr_impl {
 
+five_qi_qos_t get_five_qi_qos(uint32_t five_qi)
+{
+  switch (five_qi) {
+    // GBR
+    case 1:
+      return {20, 100};
+    case 2:
+      return {40, 150};
+    case 3:
+      return {30, 50};
+    case 4:
+      return {50, 300};
+    case 65:
+      return {7, 75};
+    case 66:
+      return {20, 100};
+    case 67:
+      return {15, 100};
+    // Non-GBR
+    case 5:
+      return {10, 100};
+    case 6:
+      return {60, 300};
+    case 7:
+      return {70, 100};
+    case 8:
+      return {80, 300};
+    case 69:
+      return {5, 60};
+    case 70:
+      return {55, 200};
+    case 79:
+      return {65, 50};
+    case 80:
+      return {68, 10};
+    // Delay-critical GBR
+    case 82:
+      return {19, 10};
+    case 83:
+      return {22, 10};
+    case 84:
+      return {24, 30};
+    case 85:
+      return {21, 5};
+    case 86:
+      return {18, 5};
+    default:
+      return {90, 300};
+  }
+}
+
 ue_cfg_manager::ue_cfg_manager(uint32_t enb_cc_idx) : carriers(1)
 {
   carriers[enb_cc_idx].active = true;
@@ -51,10 +102,24 @@ int ue_cfg_manager::apply_config_request(const sched_nr_ue_cfg_t& cfg_req)
   for (uint32_t lcid : cfg_req.lc_ch_to_rem) {
     assert(lcid > 0 && "LCID=0 cannot be removed");
     ue_bearers[lcid] = {};
+    five_qis[lcid]   = 0;
   }
   for (const sched_nr_ue_lc_ch_cfg_t& lc_ch : cfg_req.lc_ch_to_add) {
     assert(lc_ch.lcid > 0 && "LCID=0 cannot be configured");
     ue_bearers[lc_ch.lcid] = lc_ch.cfg;
+    five_qis[lc_ch.lcid]   = lc_ch.five_qi;
+  }
+
+  // Cache the DRB that determines the UE QoS, so that schedulers do not have to search for it every slot
+  qos_lcid = 0;
+  for (uint32_t lcid = 0; lcid < five_qis.size(); ++lcid) {
+    if (five_qis[lcid] == 0 or not ue_bearers[lcid].is_active()) {
+      continue;
+    }
+    if (qos_lcid == 0 or
+        get_five_qi_qos(five_qis[lcid]).prio_level < get_five_qi_qos(five_qis[qos_lcid]).prio_level) {
+      qos_lcid = lcid;
+    }
   }
 
   return SRSRAN_SUCCESS;
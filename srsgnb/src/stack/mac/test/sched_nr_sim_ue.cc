@@ -528,6 +528,12 @@ int sched_nr_base_test_bench::apply_slot_events(sim_nr_ue_ctxt_t& ue_ctxt, const
       logger.info("EVENT: DL CQI rnti=0x%x, cqi=%d", ue_ctxt.rnti, cc_feedback.cqi);
       sched_ptr->dl_cqi_info(ue_ctxt.rnti, enb_cc_idx, cc_feedback.cqi);
     }
+    if (cc_feedback.cqi >= 0 and not cc_feedback.subband_cqi.empty()) {
+      logger.info("EVENT: DL subband CQI rnti=0x%x, sb_cqi=[%s]",
+                  ue_ctxt.rnti,
+                  fmt::format("{}", fmt::join(cc_feedback.subband_cqi, ", ")).c_str());
+      sched_ptr->dl_subband_cqi_info(ue_ctxt.rnti, enb_cc_idx, cc_feedback.subband_size, cc_feedback.subband_cqi);
+    }
   }
 
   return SRSRAN_SUCCESS;
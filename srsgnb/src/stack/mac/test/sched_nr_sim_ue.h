@@ -68,10 +68,12 @@ struct ue_nr_slot_events {
     bool     ack;
   };
   struct cc_data {
-    bool                                      configured = false;
-    srsran::bounded_vector<ack_t, MAX_GRANTS> dl_acks;
-    srsran::bounded_vector<ack_t, MAX_GRANTS> ul_acks;
-    int                                       cqi = -1;
+    bool                                                          configured = false;
+    srsran::bounded_vector<ack_t, MAX_GRANTS>                     dl_acks;
+    srsran::bounded_vector<ack_t, MAX_GRANTS>                     ul_acks;
+    int                                                           cqi          = -1;
+    uint32_t                                                      subband_size = 0;
+    srsran::bounded_vector<uint32_t, SRSRAN_CSI_MAX_NOF_SUBBANDS> subband_cqi; ///< Reported along with the CQI
   };
   slot_point           slot_rx;
   std::vector<cc_data> cc_list;
@@ -23,6 +23,7 @@
 #include "sched_nr_sim_ue.h"
 #include "srsran/common/phy_cfg_nr_default.h"
 #include "srsran/common/test_common.h"
+#include "srsran/phy/phch/csi.h"
 #include "srsran/support/emergency_handlers.h"
 #include <boost/program_options.hpp>
 #include <fstream>
@@ -40,6 +41,7 @@ struct sim_args_t {
   uint32_t    fixed_cqi;
   std::string mac_log_level;
   std::string test_log_level;
+  bool        run_benchmark;
 };
 
 class sched_tester : public sched_nr_base_test_bench
@@ -57,6 +59,8 @@ public:
   void process_slot_result(const sim_nr_enb_ctxt_t& enb_ctxt, srsran::const_span<cc_result_t> cc_out) override
   {
     for (auto& cc : cc_out) {
+      tot_latency_sched_ns += cc.cc_latency_ns.count();
+      cc_res_count++;
       for (auto& pdsch : cc.res.dl->phy.pdsch) {
         if (pdsch.sch.grant.rnti_type == srsran_rnti_type_c or pdsch.sch.grant.rnti_type == srsran_rnti_type_tc) {
           ue_metrics[pdsch.sch.grant.rnti].nof_dl_txs++;
@@ -79,10 +83,27 @@ public:
       // if CQI is expected, set it to fixed value
       if (cc_events.cqi >= 0) {
         cc_events.cqi = args.fixed_cqi;
+        if (nof_cqi_subbands > 0) {
+          set_subband_cqi(ue_ctxt.rnti, cc_events);
+        }
       }
     }
   }
 
+  /// Frequency-selective channel, whose CQI varies across the subbands around the wideband CQI, with the best
+  /// subbands of each UE at a different position
+  void set_subband_cqi(uint16_t rnti, ue_nr_slot_events::cc_data& cc_events) const
+  {
+    const float max_cqi_diff = 4;
+    cc_events.subband_size   = cqi_subband_size;
+    cc_events.subband_cqi.clear();
+    for (uint32_t sb = 0; sb < nof_cqi_subbands; ++sb) {
+      float phase = 2 * M_PI * (sb + rnti * 3) / nof_cqi_subbands;
+      int   cqi   = std::lround(args.fixed_cqi - max_cqi_diff + max_cqi_diff * std::cos(phase));
+      cc_events.subband_cqi.push_back(std::max(std::min(cqi, 15), 1));
+    }
+  }
+
   void print_results()
   {
     srslog::flush();
@@ -102,6 +123,11 @@ public:
     uint64_t nof_dl_bytes = 0, nof_ul_bytes = 0;
   };
   std::map<uint16_t, sched_ue_metrics> ue_metrics;
+
+  uint64_t tot_latency_sched_ns = 0;
+  uint32_t cc_res_count         = 0;
+  uint32_t cqi_subband_size     = 0;
+  uint32_t nof_cqi_subbands     = 0; ///< Wideband CQI only if zero
 };
 
 struct sched_event_t {
@@ -235,6 +261,150 @@ void test_sched_nr_data(sim_args_t args)
   TESTASSERT_EQ(1, tester.ue_metrics[rnti].nof_ul_txs);
 }
 
+/// Two UEs with backlogged DL data on bearers of different 5QI, scheduled with the QoS-weighted policy without
+/// proportional fairness. The UE with the higher priority 5QI is served first, and the other one is only served once it
+/// has waited long enough for its delay term to compensate the weight of the 5QI
+void test_sched_nr_pf_qos(sim_args_t args)
+{
+  const uint32_t nof_sectors = 1, drb_lcid = 4, nof_slots = 2000;
+  const uint16_t low_prio_rnti = 0x4601, high_prio_rnti = 0x4602;
+
+  sched_nr_interface::sched_args_t cfg;
+  cfg.auto_refill_buffer                     = false;
+  std::vector<sched_nr_cell_cfg_t> cells_cfg = get_default_cells_cfg(nof_sectors);
+  cells_cfg[0].sched_policy                  = "time_pf";
+  cells_cfg[0].sched_policy_args             = "0";
+
+  std::string  test_name = "Test of time_pf QoS weights";
+  sched_tester tester(args, cfg, cells_cfg, test_name);
+
+  for (uint16_t rnti : {low_prio_rnti, high_prio_rnti}) {
+    sched_nr_interface::ue_cfg_t uecfg = get_default_ue_cfg(nof_sectors);
+    uecfg.lc_ch_to_add.emplace_back();
+    uecfg.lc_ch_to_add.back().lcid          = drb_lcid;
+    uecfg.lc_ch_to_add.back().cfg.direction = mac_lc_ch_cfg_t::BOTH;
+    uecfg.lc_ch_to_add.back().five_qi       = rnti == high_prio_rnti ? 1 : 9;
+    tester.user_cfg(rnti, uecfg);
+  }
+
+  // Serve both UEs once, UEs that were never served take precedence regardless of their QoS
+  for (uint16_t rnti : {low_prio_rnti, high_prio_rnti}) {
+    tester.add_rlc_dl_bytes(rnti, drb_lcid, 100);
+  }
+  for (uint32_t count = 0; count < 50; ++count) {
+    tester.run_slot(slot_point(0, count) + TX_ENB_DELAY);
+  }
+  TESTASSERT(tester.ue_metrics[low_prio_rnti].nof_dl_txs > 0 and tester.ue_metrics[high_prio_rnti].nof_dl_txs > 0);
+
+  // Both UEs get more data than the cell can carry
+  for (uint16_t rnti : {low_prio_rnti, high_prio_rnti}) {
+    tester.add_rlc_dl_bytes(rnti, drb_lcid, 100000000);
+  }
+  slot_point backlog_slot = tester.get_slot_tx() + 1;
+  slot_point first_high_prio_tx, first_low_prio_tx;
+  for (uint32_t count = 0; count < nof_slots; ++count) {
+    tester.run_slot(tester.get_slot_tx() + 1);
+    for (auto& pdsch : tester.get_slot_results()[0].res.dl->phy.pdsch) {
+      uint16_t rnti = pdsch.sch.grant.rnti;
+      if (rnti != high_prio_rnti and rnti != low_prio_rnti) {
+        continue;
+      }
+      slot_point& first_tx = rnti == high_prio_rnti ? first_high_prio_tx : first_low_prio_tx;
+      if (not first_tx.valid()) {
+        first_tx = tester.get_slot_tx();
+      }
+    }
+  }
+  tester.stop();
+  srslog::flush();
+  tester.print_results();
+
+  // The 5QI 1 UE weighs 90 / 20 = 4.5 times the 5QI 9 UE, so the latter is starved until it has waited 3.5 times its
+  // PDB of 300 msec
+  TESTASSERT(first_high_prio_tx.valid() and first_low_prio_tx.valid());
+  TESTASSERT(first_high_prio_tx < first_low_prio_tx);
+  float starved_ms = (first_low_prio_tx - backlog_slot) / (float)backlog_slot.nof_slots_per_subframe();
+  TESTASSERT(starved_ms > 900 and starved_ms < 1200);
+  TESTASSERT(tester.ue_metrics[high_prio_rnti].nof_dl_bytes > 10 * tester.ue_metrics[low_prio_rnti].nof_dl_bytes);
+}
+
+/// Measures the time taken by the scheduler to generate a slot result and the cell throughput achieved by each
+/// scheduling policy, as the number of UEs with bursty DL traffic grows. The UEs report subband CQIs of a
+/// frequency-selective channel
+void bench_sched_nr_policies(sim_args_t args)
+{
+  const uint32_t nof_slots = 2000, nof_sectors = 1, burst_period = 20, drb_lcid = 4;
+  const uint16_t first_rnti = 0x4601;
+
+  fmt::memory_buffer results;
+  fmt::format_to(results,
+                 "  policy  | nof_ues | slot time (usec) | DL offered (Mbps) | DL TBS (Mbps) | UL TBS (Mbps) | ues served\n");
+  for (const char* policy : {"time_rr", "time_pf", "freq_pf"}) {
+    for (uint32_t nof_ues : {1, 8, 32, 64}) {
+      sched_nr_interface::sched_args_t cfg;
+      cfg.auto_refill_buffer                     = false;
+      std::vector<sched_nr_cell_cfg_t> cells_cfg = get_default_cells_cfg(nof_sectors);
+      cells_cfg[0].sched_policy                  = policy;
+
+      std::string  test_name = fmt::format("Benchmark of {} with {} UEs", policy, nof_ues);
+      sched_tester tester(args, cfg, cells_cfg, test_name);
+
+      srsran_csi_hl_report_cfg_t sb_cfg = {};
+      TESTASSERT_SUCCESS(srsran_csi_set_subbands(&sb_cfg, 0, cells_cfg[0].bwps[0].rb_width, false));
+      tester.cqi_subband_size = sb_cfg.subband_size;
+      tester.nof_cqi_subbands = sb_cfg.nof_subbands;
+
+      sched_nr_interface::ue_cfg_t uecfg = get_default_ue_cfg(nof_sectors);
+      uecfg.lc_ch_to_add.emplace_back();
+      uecfg.lc_ch_to_add.back().lcid          = drb_lcid;
+      uecfg.lc_ch_to_add.back().cfg.direction = mac_lc_ch_cfg_t::BOTH;
+      uecfg.lc_ch_to_add.back().five_qi       = 9;
+      for (uint16_t rnti = first_rnti; rnti < first_rnti + nof_ues; ++rnti) {
+        tester.user_cfg(rnti, uecfg);
+      }
+
+      // Each UE receives a burst of DL data every burst_period slots, with bursts of different UEs staggered in time
+      std::uniform_int_distribution<uint32_t> burst_size_dist{100, 4000};
+      uint64_t                                offered_bytes = 0;
+      for (uint32_t count = 0; count < nof_slots; ++count) {
+        slot_point slot_tx = slot_point(0, count % 10240) + TX_ENB_DELAY;
+        for (uint16_t rnti = first_rnti; rnti < first_rnti + nof_ues; ++rnti) {
+          if ((count + rnti) % burst_period == 0) {
+            uint32_t burst_size = burst_size_dist(rand_gen);
+            tester.add_rlc_dl_bytes(rnti, drb_lcid, burst_size);
+            offered_bytes += burst_size;
+          }
+        }
+        tester.run_slot(slot_tx);
+      }
+      tester.stop();
+      srslog::flush();
+
+      uint64_t dl_bytes = 0, ul_bytes = 0;
+      uint32_t nof_ues_served = 0;
+      for (auto& u : tester.ue_metrics) {
+        dl_bytes += u.second.nof_dl_bytes;
+        ul_bytes += u.second.nof_ul_bytes;
+        nof_ues_served += u.second.nof_dl_txs > 0 ? 1 : 0;
+      }
+      double duration_us = nof_slots * 1000.0 / tester.get_slot_tx().nof_slots_per_subframe();
+      fmt::format_to(results,
+                     "  {:7} | {:7} | {:16.2f} | {:17.2f} | {:13.2f} | {:13.2f} | {}\n",
+                     policy,
+                     nof_ues,
+                     tester.tot_latency_sched_ns / 1000.0 / tester.cc_res_count,
+                     offered_bytes * 8 / duration_us,
+                     dl_bytes * 8 / duration_us,
+                     ul_bytes * 8 / duration_us,
+                     nof_ues_served);
+
+      TESTASSERT(dl_bytes > 0);
+    }
+  }
+
+  fmt::print("== Scheduler benchmark ==\n{}", fmt::to_string(results));
+}
+
 sim_args_t handle_args(int argc, char** argv)
 {
   sim_args_t args;
@@ -250,6 +420,7 @@ sim_args_t handle_args(int argc, char** argv)
       ("cqi",            bpo::value<uint32_t>(&args.fixed_cqi)->default_value(15), "UE DL CQI")
       ("log.mac_level",  bpo::value<std::string>(&args.mac_log_level)->default_value("info"), "MAC log level")
       ("log.test_level", bpo::value<std::string>(&args.test_log_level)->default_value("info"), "TEST log level")
+      ("benchmark",      bpo::bool_switch(&args.run_benchmark), "Run the scheduling policies benchmark")
       ;
   options_conf_file.add_options()
       ("config_file", bpo::value<std::string>(&config_file), "Configuration file")
@@ -329,6 +500,10 @@ int main(int argc, char** argv)
 
   srsenb::test_sched_nr_no_data(args);
   srsenb::test_sched_nr_data(args);
+  srsenb::test_sched_nr_pf_qos(args);
+  if (args.run_benchmark) {
+    srsenb::bench_sched_nr_policies(args);
+  }
 
   fmt::print("TEST: Random Seed was {}", args.rand_seed);
 }
@@ -348,6 +348,8 @@ void rrc_nr::config_mac()
   cell.ssb_periodicity_ms     = du_cfg->cell(cc).serv_cell_cfg_common().ssb_periodicity_serving_cell.to_number();
   cell.ssb_scs.value          = (subcarrier_spacing_e::options)cfg.cell_list[0].phy_cell.carrier.scs;
   cell.ssb_offset             = du_cfg->cell(cc).mib.ssb_subcarrier_offset;
+  cell.sched_policy           = cfg.cell_list[cc].sched_policy;
+  cell.sched_policy_args      = cfg.cell_list[cc].sched_policy_args;
   if (not cfg.is_standalone) {
     const serving_cell_cfg_common_s& serv_cell =
         cell_ctxt->master_cell_group->sp_cell_cfg.recfg_with_sync.sp_cell_cfg_common;
@@ -127,6 +127,7 @@ void generate_default_nr_cell(rrc_cell_cfg_nr_t& cell)
   cell.coreset0_idx            = 7;
   cell.ssb_absolute_freq_point = 0; // auto derived
   cell.num_ra_preambles        = 8;
+  cell.sched_policy            = "time_rr";
   generate_default_nr_phy_cell(cell.phy_cell);
 
   // PDCCH
@@ -708,6 +708,7 @@ void rrc_nr::ue::crnti_ce_received()
       uecfg.lc_ch_to_add.back().lcid          = drb.lc_ch_id;
       uecfg.lc_ch_to_add.back().cfg.direction = mac_lc_ch_cfg_t::BOTH;
       uecfg.lc_ch_to_add.back().cfg.group     = drb.mac_lc_ch_cfg.ul_specific_params.lc_ch_group;
+      uecfg.lc_ch_to_add.back().five_qi       = drb1_five_qi;
     }
 
     // Update UE phy params
@@ -753,6 +754,7 @@ int rrc_nr::ue::add_drb(uint32_t five_qi)
   rlc_bearer.served_radio_bearer.drb_id() = 1;
   rlc_bearer.rlc_cfg_present              = true;
   rlc_bearer.rlc_cfg                      = parent->cfg.five_qi_cfg[five_qi].rlc_cfg;
+  drb1_five_qi                            = five_qi;
 
   // add RLC bearer
   srsran::rlc_config_t rlc_cfg;
@@ -1493,6 +1495,9 @@ int rrc_nr::ue::update_mac(const cell_group_cfg_s& cell_group_config, bool is_co
       uecfg.lc_ch_to_add.back().lcid = bearer.lc_ch_id;
       auto& lch                      = uecfg.lc_ch_to_add.back().cfg;
       lch.direction                  = mac_lc_ch_cfg_t::BOTH;
+      if (srsran::is_nr_drb(bearer.lc_ch_id)) {
+        uecfg.lc_ch_to_add.back().five_qi = drb1_five_qi;
+      }
       if (bearer.mac_lc_ch_cfg.ul_specific_params_present) {
         lch.priority = bearer.mac_lc_ch_cfg.ul_specific_params.prio;
         lch.pbr      = bearer.mac_lc_ch_cfg.ul_specific_params.prioritised_bit_rate.to_number();
@@ -40,6 +40,10 @@ public:
   cf_t*    get_tx_buffer(uint32_t antenna_idx);
   uint32_t get_buffer_len();
 
+  /* Resource grid of the primary cell, written directly when the subframe was demodulated by a shared front end */
+  cf_t* get_rx_grid(uint32_t antenna_idx);
+  void  set_rx_grid_ready(bool ready);
+
   void  set_tti(uint32_t tti);
   void  set_cfo_nolock(float cfo);
   float get_ref_cfo() const;
@@ -105,6 +109,7 @@ private:
   cf_t*    signal_buffer_rx[SRSRAN_MAX_PORTS] = {};
   cf_t*    signal_buffer_tx[SRSRAN_MAX_PORTS] = {};
   uint32_t signal_buffer_max_samples          = 0;
+  bool     rx_grid_ready                      = false;
 
   /* Objects for DL */
   srsran_ue_dl_t     ue_dl     = {};
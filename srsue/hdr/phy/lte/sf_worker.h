@@ -55,6 +55,10 @@ public:
   void     set_prach(cf_t* prach_ptr, float prach_power);
   void     set_cfo_nolock(const uint32_t& cc_idx, float cfo);
 
+  /* Functions used by the main PHY thread when the subframe is demodulated by a shared front end */
+  cf_t* get_rx_grid(uint32_t cc_idx, uint32_t antenna_idx);
+  void  set_rx_grid_ready(bool ready);
+
   void set_tdd_config_nolock(srsran_tdd_config_t config);
   void set_config_nolock(uint32_t cc_idx, const srsran::phy_cfg_t& phy_cfg);
 
@@ -94,8 +98,9 @@ private:
   std::condition_variable cell_init_cond;
   bool                    cell_initiated = false;
 
-  cf_t* prach_ptr   = nullptr;
-  float prach_power = 0;
+  cf_t* prach_ptr     = nullptr;
+  float prach_power   = 0;
+  bool  rx_grid_ready = false;
 
   srsran::phy_common_interface::worker_context_t context = {};
 };
@@ -0,0 +1,187 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSUE_MULTI_UE_FRONT_END_H
+#define SRSUE_MULTI_UE_FRONT_END_H
+
+#include "srsran/interfaces/radio_interfaces.h"
+#include "srsran/radio/rf_buffer.h"
+#include "srsran/srslog/srslog.h"
+#include "srsran/srsran.h"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace srsue {
+
+/**
+ * Radio front end shared by the LTE UEs emulated in a single process.
+ *
+ * The first UE (leader) owns the radio and the downlink synchronization. Every subframe it receives while camping is
+ * OFDM demodulated once and published, together with its TTI and reception time, in a ring of subframes read by the
+ * rest of UEs (followers). Followers do not search, synchronize nor demodulate, they take the cell from the leader and
+ * decode their PDCCH/PDSCH directly from the shared resource grid.
+ *
+ * Every UE transmits through its own port. The uplink signals are added at their transmission time and the sum is
+ * given to the radio as soon as every UE reported either its samples or the end of its burst for that time. A UE
+ * lagging more than TX_MAX_LAG_MS behind the others does not hold the rest, its late samples are discarded.
+ */
+class multi_ue_front_end
+{
+public:
+  /// Downlink subframe context given to the followers together with the resource grid
+  struct dl_subframe_t {
+    srsran_cell_t      cell;
+    uint32_t           earfcn;
+    uint32_t           tti;
+    float              cfo_hz;
+    srsran_timestamp_t rx_time; ///< Reception time of the subframe
+  };
+
+  explicit multi_ue_front_end(srslog::basic_logger& logger_);
+  ~multi_ue_front_end();
+
+  /**
+   * Initialises the front end
+   * @param radio_ Radio shared by all the UEs
+   * @param nof_ues_ Number of UEs, including the leader
+   * @param nof_rf_channels_ Number of radio channels used for transmission
+   * @param nof_rx_ant_ Number of receive antennas of the primary cell
+   * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR code otherwise
+   */
+  int  init(srsran::radio_interface_phy* radio_, uint32_t nof_ues_, uint32_t nof_rf_channels_, uint32_t nof_rx_ant_);
+  void stop();
+
+  /// Radio interface of a UE. Only the leader port (ue_idx 0) receives from and configures the radio
+  srsran::radio_interface_phy* get_port(uint32_t ue_idx);
+
+  /**
+   * Called by the leader for every synchronized subframe, demodulates it and makes it available to the followers
+   * @param sf Subframe context
+   * @param mib Last MIB decoded by the leader, given to the followers when they find the cell
+   * @param buffer Time domain samples of the subframe, the primary cell antennas come first
+   */
+  void write_dl(const dl_subframe_t&                               sf,
+                const std::array<uint8_t, SRSRAN_BCH_PAYLOAD_LEN>& mib,
+                srsran::rf_buffer_t&                               buffer);
+
+  /**
+   * Called by a follower to find the cell, it waits for the leader to publish a new subframe
+   * @return true if the leader is camping on a cell, false if it timed out
+   */
+  bool wait_cell(srsran_cell_t*                               cell,
+                 uint32_t*                                    earfcn,
+                 std::array<uint8_t, SRSRAN_BCH_PAYLOAD_LEN>& mib,
+                 uint32_t                                     timeout_ms);
+
+  /**
+   * Called by a follower without a cell to keep its stack running on the radio time
+   * @param rx_time Reception time of the latest samples received by the leader
+   * @return true if the leader received new samples before the timeout
+   */
+  bool wait_rx_time(srsran_timestamp_t* rx_time, uint32_t timeout_ms);
+
+  /**
+   * Called by a follower to get the next subframe. If the follower fell behind the ring, it skips to the newest one
+   * @param ue_idx Follower index
+   * @param grid Destination of the resource grid of every primary cell receive antenna
+   * @param sf Subframe context
+   * @param timeout_ms Maximum time to wait for the subframe
+   * @return true if the grid and context were copied, false if it timed out or the front end stopped
+   */
+  bool read_dl(uint32_t ue_idx, cf_t* grid[SRSRAN_MAX_PORTS], dl_subframe_t& sf, uint32_t timeout_ms);
+
+private:
+  class port;
+  friend class port;
+
+  const static uint32_t NOF_DL_SUBFRAMES = 16; ///< Subframes kept for the followers
+  const static uint32_t TX_RING_MS       = 10; ///< Length of the uplink combining buffer
+  const static uint32_t TX_MAX_LAG_MS    = 2;  ///< Maximum uplink delay of a UE before its samples are discarded
+
+  void set_rx_time(const srsran_timestamp_t& rx_time);
+
+  // Uplink combining, called from the ports
+  bool tx(uint32_t ue_idx, srsran::rf_buffer_interface& buffer, const srsran::rf_timestamp_interface& tx_time);
+  void tx_end(uint32_t ue_idx);
+  void set_tx_srate(double srate);
+  bool is_start_of_burst(uint32_t ue_idx);
+  void tx_flush_ready();
+  void tx_flush(uint64_t until);
+  void tx_reset();
+
+  srslog::basic_logger&               logger;
+  srsran::radio_interface_phy*        radio = nullptr;
+  std::vector<std::unique_ptr<port> > ports;
+  uint32_t                            nof_ues         = 0;
+  uint32_t                            nof_rf_channels = 0;
+  uint32_t                            nof_rx_ant      = 0;
+  std::atomic<bool>                   running         = {false};
+
+  // Downlink OFDM demodulation, only used by the leader thread
+  srsran_cell_t fft_cell                  = {};
+  srsran_ofdm_t fft[SRSRAN_MAX_PORTS]     = {};
+  cf_t*         fft_in[SRSRAN_MAX_PORTS]  = {};
+  cf_t*         fft_out[SRSRAN_MAX_PORTS] = {};
+
+  // Ring of demodulated subframes, each one protected by its own mutex so the leader only waits for a follower
+  // copying the same subframe
+  struct dl_slot_t {
+    std::mutex    mutex;
+    uint64_t      seq                    = 0; ///< Sequence number of the stored subframe, 0 if empty
+    uint32_t      nof_re                 = 0;
+    dl_subframe_t sf                     = {};
+    cf_t*         grid[SRSRAN_MAX_PORTS] = {};
+  };
+  std::array<dl_slot_t, NOF_DL_SUBFRAMES>     dl_slots;
+  std::mutex                                  dl_mutex;
+  std::condition_variable                     dl_cvar;
+  uint64_t                                    dl_seq    = 0;  ///< Sequence number of the newest subframe
+  std::vector<uint64_t>                       dl_next   = {}; ///< Next sequence number for every follower
+  srsran_cell_t                               dl_cell   = {};
+  uint32_t                                    dl_earfcn = 0;
+  std::array<uint8_t, SRSRAN_BCH_PAYLOAD_LEN> dl_mib    = {};
+  srsran_timestamp_t                          rx_time   = {}; ///< Latest reception time of the leader
+  uint64_t                                    rx_count  = 0;
+
+  // Uplink combining buffer, indexed by absolute sample number modulo its length
+  struct tx_state_t {
+    bool     active   = false; ///< The UE reported at least once, so the rest wait for its samples
+    bool     in_burst = false; ///< The last report of the UE was a transmission
+    uint64_t end      = 0;     ///< Sample following the last subframe reported by the UE
+  };
+  std::mutex                             tx_mutex;
+  double                                 tx_srate            = 0.0;
+  uint32_t                               tx_ring_sz          = 0;
+  std::array<cf_t*, SRSRAN_MAX_CHANNELS> tx_ring             = {};
+  bool                                   tx_started          = false;
+  uint64_t                               tx_flushed          = 0; ///< Samples before this one were given to the radio
+  uint64_t                               tx_newest           = 0; ///< Latest sample end provided by any UE
+  std::vector<tx_state_t>                tx_state            = {};
+  uint64_t                               tx_nof_late_samples = 0;
+};
+
+} // namespace srsue
+
+#endif // SRSUE_MULTI_UE_FRONT_END_H
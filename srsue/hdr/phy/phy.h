@@ -64,6 +64,14 @@ public:
   // Init for LTE PHYs
   int init(const phy_args_t& args_, stack_interface_phy_lte* stack_, srsran::radio_interface_phy* radio_);
 
+  /**
+   * Shares the radio and synchronization with other UEs in the same process, it must be called before init(). The
+   * radio given to init() must be the front end port of this UE
+   * @param front_end Front end shared by all the UEs
+   * @param ue_idx UE index in the front end
+   */
+  void set_front_end(multi_ue_front_end* front_end, uint32_t ue_idx) { sfsync.set_front_end(front_end, ue_idx); }
+
   void stop() final;
 
   void wait_initialize() final;
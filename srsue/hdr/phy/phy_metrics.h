@@ -47,12 +47,14 @@ struct sync_metrics_t {
   float speed_kmph  = 0.0;
   float cfo         = 0.0;
   float sfo         = 0.0;
+  float meas_cpu_us = 0.0; ///< Average CPU time of a neighbour cell measurement
 
   void set(const sync_metrics_t& other)
   {
     ta_us       = other.ta_us;
     distance_km = other.distance_km;
     speed_kmph  = other.speed_kmph;
+    meas_cpu_us = other.meas_cpu_us;
     PHY_METRICS_SET(cfo);
     PHY_METRICS_SET(sfo);
     count++;
@@ -66,6 +68,7 @@ struct sync_metrics_t {
     speed_kmph  = 0.0f;
     cfo         = 0.0f;
     sfo         = 0.0f;
+    meas_cpu_us = 0.0f;
   }
 
 private:
@@ -122,6 +122,19 @@ public:
    */
   virtual uint32_t get_earfcn() const = 0;
 
+  /**
+   * @brief Gets the average CPU time spent by the measurement thread on each measurement since the last initialization
+   * @return The CPU time per measurement in microseconds
+   */
+  uint32_t get_meas_cpu_us() const
+  {
+    uint32_t count = meas_cpu_count;
+    if (count == 0) {
+      return 0;
+    }
+    return (uint32_t)(meas_cpu_us / count);
+  }
+
   /**
    * @brief Synchronous wait mechanism, blocks the writer thread while it is in measure state. If the asynchronous
    * thread is too slow, use this method for stalling the writing thread and wait the asynchronous thread to clear the
@@ -311,6 +324,10 @@ private:
 
   std::vector<cf_t>   search_buffer;
   srsran_ringbuffer_t ring_buffer = {};
+
+  /// CPU usage of the measurements
+  std::atomic<uint64_t> meas_cpu_us    = {0}; ///< Accumulated CPU time in microseconds
+  std::atomic<uint32_t> meas_cpu_count = {0}; ///< Number of measurements
 };
 
 } // namespace scell
@@ -87,8 +87,10 @@ private:
   std::mutex            mutex;
 
   /// LTE-based measuring objects
-  scell_recv                 scell_rx;               ///< Secondary cell searcher
-  srsran_refsignal_dl_sync_t refsignal_dl_sync = {}; ///< Reference signal based measurement
+  scell_recv                                   scell_rx;               ///< Secondary cell searcher
+  srsran_refsignal_dl_sync_t                   refsignal_dl_sync = {}; ///< Reference signal based measurement
+  std::vector<uint32_t>                        batch_pci;              ///< Neighbour cells measured in the batch
+  std::vector<srsran_refsignal_dl_sync_meas_t> batch_meas;             ///< Measurement of each neighbour cell
 };
 
 } // namespace scell
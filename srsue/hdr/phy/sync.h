@@ -40,6 +40,7 @@
 #include "srsran/phy/channel/channel.h"
 #include "srsran/srsran.h"
 #include "srsue/hdr/phy/lte/worker_pool.h"
+#include "srsue/hdr/phy/multi_ue_front_end.h"
 #include "srsue/hdr/phy/nr/worker_pool.h"
 #include "sync_state.h"
 
@@ -75,6 +76,13 @@ public:
   void stop();
   void radio_overflow();
 
+  /**
+   * Shares the synchronization with other UEs in the same process, it must be called before init()
+   * @param front_end_ Front end shared by all the UEs
+   * @param ue_idx UE index in the front end, the UE with index 0 synchronizes for all the others
+   */
+  void set_front_end(multi_ue_front_end* front_end_, uint32_t ue_idx);
+
   // RRC interface for controling the SYNC state
   bool                                     cell_search_init();
   rrc_interface_phy_lte::cell_search_ret_t cell_search_start(phy_cell_t* cell, int earfcn);
@@ -162,6 +170,12 @@ private:
    */
   void run_idle_state();
 
+  /**
+   * Cell camping state of a UE following the synchronization of another one. Takes the demodulated subframes from
+   * the shared front end and calls the PHCH workers to process them
+   */
+  void run_camping_follower_state();
+
   /**
    * MAIN THREAD
    *
@@ -189,6 +203,13 @@ private:
   void
   run_camping_in_sync_state(lte::sf_worker* lte_worker, nr::sf_worker* nr_worker, srsran::rf_buffer_t& sync_buffer);
 
+  /**
+   * Helper method, sets the context of the workers for the current TTI and starts them
+   * @param lte_worker Selected LTE worker for the current TTI
+   * @param nr_worker Selected NR worker for the current TTI
+   */
+  void run_camping_workers(lte::sf_worker* lte_worker, nr::sf_worker* nr_worker);
+
   /**
    * Helper method, executed in a TTI basis for signaling to the stack a new TTI execution
    *
@@ -201,6 +222,8 @@ private:
 
   float get_tx_cfo();
 
+  bool is_follower() const { return front_end != nullptr and front_end_ue_idx > 0; }
+
   void set_sampling_rate();
   bool set_frequency();
   bool set_cell(float cfo);
@@ -227,6 +250,8 @@ private:
   phy_common*                  worker_com       = nullptr;
   prach*                       prach_buffer     = nullptr;
   srsran::channel_ptr          channel_emulator = nullptr;
+  multi_ue_front_end*          front_end        = nullptr;
+  uint32_t                     front_end_ue_idx = 0;
 
   // PRACH state
   uint32_t prach_nof_sf = 0;
@@ -370,10 +395,12 @@ private:
   float dl_freq = -1;
   float ul_freq = -1;
 
-  const static int MIN_TTI_JUMP       = 1;    ///< Time gap reported to stack after receiving subframe
-  const static int MAX_TTI_JUMP       = 1000; ///< Maximum time gap tolerance in RF stream metadata
-  const uint8_t    SYNC_CC_IDX        = 0;    ///< From the sync POV, the CC idx is always the first
-  const uint32_t   TIMEOUT_TO_IDLE_MS = 2000; ///< Timeout in milliseconds for transitioning to IDLE
+  const static int MIN_TTI_JUMP             = 1;    ///< Time gap reported to stack after receiving subframe
+  const static int MAX_TTI_JUMP             = 1000; ///< Maximum time gap tolerance in RF stream metadata
+  const uint8_t    SYNC_CC_IDX              = 0;    ///< From the sync POV, the CC idx is always the first
+  const uint32_t   TIMEOUT_TO_IDLE_MS       = 2000; ///< Timeout in milliseconds for transitioning to IDLE
+  const uint32_t   FOLLOWER_DL_TIMEOUT_MS   = 10;   ///< Maximum wait for a subframe of the shared front end
+  const uint32_t   FOLLOWER_CELL_TIMEOUT_MS = 100;  ///< Maximum wait for the shared front end to camp on a cell
 };
 
 } // namespace srsue
@@ -84,7 +84,7 @@ private:
   srsran::sch_pdu pending_mac_msg;
   uint8_t         mch_lcids[SRSRAN_N_MCH_LCIDS] = {};
   void            process_sch_pdu_rt(uint8_t* buff, uint32_t nof_bytes, uint32_t tti);
-  void            process_sch_pdu(srsran::sch_pdu* pdu);
+  void            process_sch_pdu(srsran::sch_pdu* pdu, const uint8_t* mac_pdu);
   void            process_mch_pdu(srsran::mch_pdu* pdu);
   bool            process_ce(srsran::sch_subh* subheader, uint32_t tti);
   void            parse_ta_cmd(srsran::sch_subh* subh, uint32_t tti);
@@ -25,7 +25,12 @@
 #include "srsran/asn1/liblte_mme.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/srslog/srslog.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
 #include <mutex>
+#include <vector>
 
 namespace srsue {
 
@@ -63,6 +68,25 @@ const uint8_t IPV6_ADDR_SIZE = 16;
 const uint8_t UDP_PROTOCOL   = 0x11;
 const uint8_t TCP_PROTOCOL   = 0x06;
 
+/**
+ * Fields of an outgoing IP packet inspected by the packet filters, in network byte order. The fields that do not
+ * apply to the packet are zero, so that it can be used as the key of a flow.
+ */
+struct tft_packet_fields_t {
+  uint8_t  version;
+  uint8_t  protocol; ///< Protocol (IPv4) or Next Header (IPv6)
+  uint8_t  tos;
+  uint8_t  reserved;
+  uint16_t local_port;  ///< UDP and TCP only
+  uint16_t remote_port; ///< UDP and TCP only
+  uint32_t ipv4_local_addr;
+  uint32_t ipv4_remote_addr;
+  uint64_t ipv6_remote_addr[2];
+
+  static tft_packet_fields_t parse(const uint8_t* ip_pkt);
+  bool operator==(const tft_packet_fields_t& other) const { return memcmp(this, &other, sizeof(other)) == 0; }
+};
+
 // TS 24.008 Table 10.5.162
 class tft_packet_filter_t
 {
@@ -70,8 +94,9 @@ public:
   tft_packet_filter_t(uint8_t                                eps_bearer_id_,
                       const LIBLTE_MME_PACKET_FILTER_STRUCT& tft_,
                       srslog::basic_logger&                  logger);
-  bool match(const srsran::unique_byte_buffer_t& pdu);
-  bool filter_contains(uint16_t filtertype);
+  bool match(const srsran::unique_byte_buffer_t& pdu) const;
+  bool match(const tft_packet_fields_t& pkt) const;
+  bool filter_contains(uint16_t filtertype) const;
 
   uint8_t  eps_bearer_id             = {};
   uint8_t  id                        = {};
@@ -97,13 +122,57 @@ public:
   uint8_t  type_of_service_mask      = {};
   uint8_t  flow_label[3]             = {};
 
+  // IPv6 remote address and mask as words, with the address already masked
+  uint64_t ipv6_remote_addr_masked_words[2] = {};
+  uint64_t ipv6_remote_addr_mask_words[2]   = {};
+
   srslog::basic_logger& logger;
 
-  bool match_ip(const srsran::unique_byte_buffer_t& pdu);
-  bool match_protocol(const srsran::unique_byte_buffer_t& pdu);
-  bool match_type_of_service(const srsran::unique_byte_buffer_t& pdu);
+  bool match_ip(const tft_packet_fields_t& pkt) const;
+  bool match_protocol(const tft_packet_fields_t& pkt) const;
+  bool match_type_of_service(const tft_packet_fields_t& pkt) const;
   bool match_flow_label(const srsran::unique_byte_buffer_t& pdu);
-  bool match_port(const srsran::unique_byte_buffer_t& pdu);
+  bool match_port(const tft_packet_fields_t& pkt) const;
+};
+
+/**
+ * Cache of the EPS bearer each flow was mapped to, evicting the least recently used flow when full.
+ * The flows are stored in a fixed array, indexed by an open addressing hash table and linked in order of use, so
+ * that lookups and insertions do not allocate.
+ */
+class tft_flow_cache
+{
+public:
+  explicit tft_flow_cache(uint32_t capacity);
+
+  /// Looks up a flow, marking it as the most recently used. Returns nullptr if not cached
+  const int* find(const tft_packet_fields_t& flow);
+  /// Stores the EPS bearer of a flow that is not cached, -1 if it matches no filter
+  void     insert(const tft_packet_fields_t& flow, int eps_bearer_id);
+  void     clear();
+  uint32_t size() const { return nof_entries; }
+
+private:
+  static const uint32_t none = UINT32_MAX;
+
+  struct entry_t {
+    tft_packet_fields_t flow;
+    int                 eps_bearer_id;
+    uint32_t            hash;
+    uint32_t            prev, next; ///< Neighbours in order of use
+  };
+
+  static uint32_t hash_flow(const tft_packet_fields_t& flow);
+  void            unlink(uint32_t idx);
+  void            push_front(uint32_t idx);
+  void            erase_slot(uint32_t slot);
+
+  std::vector<entry_t>  entries;
+  std::vector<uint32_t> slots; ///< Hash table of entry indexes, at most half full
+  uint32_t              slot_mask   = 0;
+  uint32_t              nof_entries = 0;
+  uint32_t              head        = none; ///< Most recently used
+  uint32_t              tail        = none; ///< Least recently used
 };
 
 /**
@@ -112,7 +181,11 @@ public:
 class tft_pdu_matcher
 {
 public:
-  explicit tft_pdu_matcher(srslog::basic_logger& logger) : logger(logger) {}
+  explicit tft_pdu_matcher(srslog::basic_logger& logger,
+                           uint32_t              flow_cache_size        = default_flow_cache_size,
+                           uint32_t              flow_cache_min_filters = default_flow_cache_min_filters) :
+    logger(logger), flow_cache(flow_cache_size), flow_cache_min_filters(flow_cache_min_filters)
+  {}
   ~tft_pdu_matcher(){};
 
   void reset();
@@ -122,11 +195,25 @@ public:
                                       const LIBLTE_MME_TRAFFIC_FLOW_TEMPLATE_STRUCT* tft);
   void    delete_tft_for_eps_bearer(const uint8_t eps_bearer_id);
 
+  static const uint32_t default_flow_cache_size = 256;
+  /// Below this number of filters, classifying a packet is cheaper than looking up its flow in the cache
+  static const uint32_t default_flow_cache_min_filters = 16;
+
 private:
+  void compile_filters();
+  int  classify(const tft_packet_fields_t& pkt);
+
   srslog::basic_logger&                           logger;
   std::mutex                                      tft_mutex;
   typedef std::map<uint16_t, tft_packet_filter_t> tft_filter_map_t;
   tft_filter_map_t                                tft_filter_map;
+
+  // Filters compiled from tft_filter_map whenever it changes. The filters that an IPv4 or IPv6 packet can match
+  // depend on the packet protocol, so they are listed per protocol, in order of evaluation precedence
+  std::vector<const tft_packet_filter_t*> filters;
+  std::array<std::vector<uint16_t>, 256>  filters_per_protocol;
+  tft_flow_cache                          flow_cache;
+  uint32_t                                flow_cache_min_filters;
 };
 
 } // namespace srsue
@@ -32,6 +32,7 @@
 #include <stdarg.h>
 #include <string>
 
+#include "phy/multi_ue_front_end.h"
 #include "phy/ue_phy_base.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/radio/radio.h"
@@ -75,6 +76,7 @@ typedef struct {
   bool        tracing_enable;
   std::string tracing_filename;
   std::size_t tracing_buffcapacity;
+  uint32_t    nof_ues;
 } general_args_t;
 
 typedef struct {
@@ -100,7 +102,14 @@ public:
   ue();
   ~ue();
 
-  int  init(const all_args_t& args_);
+  /**
+   * Initialises the UE
+   * @param args_ UE arguments
+   * @param front_end_ Front end created by the first UE when several UEs are emulated in the process, nullptr otherwise
+   * @param ue_idx_ Index of the UE among the emulated ones, the UE with index 0 owns the radio
+   * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR code otherwise
+   */
+  int  init(const all_args_t& args_, multi_ue_front_end* front_end_ = nullptr, uint32_t ue_idx_ = 0);
   void stop();
   bool switch_on();
   bool switch_off();
@@ -111,6 +120,9 @@ public:
 
   void radio_overflow();
 
+  /// Front end shared with the rest of emulated UEs, nullptr unless general.nof_ues is greater than 1
+  multi_ue_front_end* get_front_end() { return front_end.get(); }
+
 private:
   // UE consists of a radio, a PHY and a stack element
   std::unique_ptr<ue_phy_base>        phy;
@@ -118,6 +130,8 @@ private:
   std::unique_ptr<srsran::radio_base> radio;
   std::unique_ptr<ue_stack_base>      stack;
   std::unique_ptr<gw>                 gw_inst;
+  std::unique_ptr<multi_ue_front_end> front_end;
+  uint32_t                            ue_idx = 0;
 
   // Generic logger members
   srslog::basic_logger& logger;
@@ -39,12 +39,14 @@
 #include <boost/program_options/parsers.hpp>
 #include <csignal>
 #include <iostream>
+#include <memory>
 #include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string>
 #include <sys/mman.h>
 #include <unistd.h>
+#include <vector>
 
 extern std::atomic<bool> simulate_rlf;
 
@@ -216,6 +218,7 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
     ("channel.dl.awgn.signal_power", bpo::value<float>(&args->phy.dl_channel_args.awgn_signal_power_dBfs)->default_value(0.0f), "Received signal power in decibels full scale (dBfs)")
     ("channel.dl.fading.enable",     bpo::value<bool>(&args->phy.dl_channel_args.fading_enable)->default_value(false),          "Enable/Disable Fading model")
     ("channel.dl.fading.model",      bpo::value<std::string>(&args->phy.dl_channel_args.fading_model)->default_value("none"),   "Fading model + maximum doppler (E.g. none, epa5, eva70, etu300, etc)")
+    ("channel.dl.fading.corr",       bpo::value<std::string>(&args->phy.dl_channel_args.fading_corr)->default_value("none"),    "Spatial correlation between antennas (none, low, medium or high)")
     ("channel.dl.delay.enable",      bpo::value<bool>(&args->phy.dl_channel_args.delay_enable)->default_value(false),           "Enable/Disable Delay simulator")
     ("channel.dl.delay.period_s",    bpo::value<float>(&args->phy.dl_channel_args.delay_period_s)->default_value(3600),         "Delay period in seconds (integer)")
     ("channel.dl.delay.init_time_s", bpo::value<float>(&args->phy.dl_channel_args.delay_init_time_s)->default_value(0),         "Initial time in seconds")
@@ -236,6 +239,7 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
     ("channel.ul.awgn.signal_power", bpo::value<float>(&args->phy.ul_channel_args.awgn_signal_power_dBfs)->default_value(30.0f), "Transmitted signal power in decibels full scale (dBfs)")
     ("channel.ul.fading.enable",     bpo::value<bool>(&args->phy.ul_channel_args.fading_enable)->default_value(false),           "Enable/Disable Fading model")
     ("channel.ul.fading.model",      bpo::value<std::string>(&args->phy.ul_channel_args.fading_model)->default_value("none"),    "Fading model + maximum doppler (E.g. none, epa5, eva70, etu300, etc)")
+    ("channel.ul.fading.corr",       bpo::value<std::string>(&args->phy.ul_channel_args.fading_corr)->default_value("none"),     "Spatial correlation between antennas (none, low, medium or high)")
     ("channel.ul.delay.enable",      bpo::value<bool>(&args->phy.ul_channel_args.delay_enable)->default_value(false),            "Enable/Disable Delay simulator")
     ("channel.ul.delay.period_s",    bpo::value<float>(&args->phy.ul_channel_args.delay_period_s)->default_value(3600),          "Delay period in seconds (integer)")
     ("channel.ul.delay.init_time_s", bpo::value<float>(&args->phy.ul_channel_args.delay_init_time_s)->default_value(0),          "Initial time in seconds")
@@ -409,6 +413,10 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
       bpo::value<bool>(&args->phy.detect_cp)->default_value(false),
       "enable CP length detection")
 
+    ("phy.cell_search_single_pass",
+      bpo::value<bool>(&args->phy.cell_search_single_pass)->default_value(false),
+      "Search the three PSS on the same received frames during cell search")
+
     ("phy.in_sync_rsrp_dbm_th",
      bpo::value<float>(&args->phy.in_sync_rsrp_dbm_th)->default_value(-130.0f),
      "RSRP threshold (in dBm) above which the UE considers to be in-sync")
@@ -492,6 +500,10 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
            bpo::value<std::size_t>(&args->general.tracing_buffcapacity)->default_value(1000000),
            "Tracing buffer capcity")
 
+    ("general.nof_ues",
+           bpo::value<uint32_t>(&args->general.nof_ues)->default_value(1),
+           "Number of UEs emulated in the process sharing the radio")
+
     ("stack.have_tti_time_stats",
         bpo::value<bool>(&args->stack.have_tti_time_stats)->default_value(true),
         "Calculate TTI execution statistics")
@@ -768,6 +780,19 @@ int main(int argc, char* argv[])
     return SRSRAN_SUCCESS;
   }
 
+  // Create the UEs emulated through the front end of the first one
+  std::vector<std::unique_ptr<srsue::ue> > emulated_ues;
+  for (uint32_t i = 1; i < args.general.nof_ues; i++) {
+    emulated_ues.emplace_back(new srsue::ue);
+    if (emulated_ues.back()->init(args, ue.get_front_end(), i)) {
+      for (auto& emulated_ue : emulated_ues) {
+        emulated_ue->stop();
+      }
+      ue.stop();
+      return SRSRAN_SUCCESS;
+    }
+  }
+
   srsran::metrics_hub<ue_metrics_t> metricshub;
   metrics_stdout                    _metrics_screen;
 
@@ -802,6 +827,9 @@ int main(int argc, char* argv[])
 
   cout << "Attaching UE..." << endl;
   ue.switch_on();
+  for (auto& emulated_ue : emulated_ues) {
+    emulated_ue->switch_on();
+  }
 
   if (args.gui.enable) {
     ue.start_plot();
@@ -811,11 +839,17 @@ int main(int argc, char* argv[])
     sleep(1);
   }
 
+  for (auto& emulated_ue : emulated_ues) {
+    emulated_ue->switch_off();
+  }
   ue.switch_off();
   pthread_cancel(input);
   pthread_join(input, nullptr);
   metricshub.stop();
   metrics_file.stop();
+  for (auto& emulated_ue : emulated_ues) {
+    emulated_ue->stop();
+  }
   ue.stop();
   cout << "---  exiting  ---" << endl;
 
@@ -60,6 +60,7 @@ DECLARE_METRIC("ul_mcs", metric_ul_mcs, float, "");
 DECLARE_METRIC("ul_ta", metric_ul_ta, float, "");
 DECLARE_METRIC("distance_km", metric_distance_km, float, "");
 DECLARE_METRIC("speed_kmph", metric_speed_kmph, float, "");
+DECLARE_METRIC("meas_cpu_us", metric_meas_cpu_us, float, "");
 DECLARE_METRIC_SET("carrier_container",
                    mset_carrier_container,
                    metric_earfcn,
@@ -73,6 +74,7 @@ DECLARE_METRIC_SET("carrier_container",
                    metric_ul_ta,
                    metric_distance_km,
                    metric_speed_kmph,
+                   metric_meas_cpu_us,
                    mset_mac_container);
 DECLARE_METRIC_LIST("carrier_list", mlist_carriers, std::vector<mset_carrier_container>);
 
@@ -183,6 +185,7 @@ void metrics_json::set_metrics(const ue_metrics_t& metrics, const uint32_t perio
     carrier.write<metric_ul_ta>(metrics.phy.sync[i].ta_us);
     carrier.write<metric_distance_km>(metrics.phy.sync[i].distance_km);
     carrier.write<metric_speed_kmph>(metrics.phy.sync[i].speed_kmph);
+    carrier.write<metric_meas_cpu_us>(metrics.phy.sync[i].meas_cpu_us);
 
     // MAC
     carrier.get<mset_mac_container>().write<metric_dl_brate>(metrics.stack.mac[i].rx_brate /
@@ -175,6 +175,16 @@ cf_t* cc_worker::get_rx_buffer(uint32_t antenna_idx)
   return signal_buffer_rx[antenna_idx];
 }
 
+cf_t* cc_worker::get_rx_grid(uint32_t antenna_idx)
+{
+  return ue_dl.sf_symbols[antenna_idx];
+}
+
+void cc_worker::set_rx_grid_ready(bool ready)
+{
+  rx_grid_ready = ready;
+}
+
 cf_t* cc_worker::get_tx_buffer(uint32_t antenna_idx)
 {
   return signal_buffer_tx[antenna_idx];
@@ -245,8 +255,11 @@ bool cc_worker::work_dl_regular()
       srsran_ue_dl_set_mi_manual(&ue_dl, i);
     }
 
-    /* Do FFT and extract PDCCH LLR, or quit if no actions are required in this subframe */
-    if (srsran_ue_dl_decode_fft_estimate(&ue_dl, &sf_cfg_dl, &ue_dl_cfg) < 0) {
+    /* Do FFT and extract PDCCH LLR, or quit if no actions are required in this subframe. The FFT is skipped if the
+     * resource grid was already demodulated */
+    int ret = rx_grid_ready ? srsran_ue_dl_decode_estimate(&ue_dl, &sf_cfg_dl, &ue_dl_cfg)
+                            : srsran_ue_dl_decode_fft_estimate(&ue_dl, &sf_cfg_dl, &ue_dl_cfg);
+    if (ret < 0) {
       Error("Getting PDCCH FFT estimate");
       return false;
     }
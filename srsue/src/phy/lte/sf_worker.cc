@@ -104,6 +104,19 @@ cf_t* sf_worker::get_buffer(uint32_t carrier_idx, uint32_t antenna_idx)
   return cc_workers[carrier_idx]->get_rx_buffer(antenna_idx);
 }
 
+cf_t* sf_worker::get_rx_grid(uint32_t carrier_idx, uint32_t antenna_idx)
+{
+  return cc_workers[carrier_idx]->get_rx_grid(antenna_idx);
+}
+
+void sf_worker::set_rx_grid_ready(bool ready)
+{
+  rx_grid_ready = ready;
+  for (auto& w : cc_workers) {
+    w->set_rx_grid_ready(ready);
+  }
+}
+
 uint32_t sf_worker::get_buffer_len()
 {
   if (cc_workers.empty()) {
@@ -177,7 +190,8 @@ void sf_worker::work_imp()
       srsran_mbsfn_cfg_t mbsfn_cfg;
       ZERO_OBJECT(mbsfn_cfg);
 
-      if (carrier_idx == 0 && phy->is_mbsfn_sf(&mbsfn_cfg, tti)) {
+      // MBSFN subframes are not supported when the grid is demodulated by a shared front end
+      if (carrier_idx == 0 && !rx_grid_ready && phy->is_mbsfn_sf(&mbsfn_cfg, tti)) {
         rx_signal_ok =
             cc_workers[0]->work_dl_mbsfn(mbsfn_cfg); // Don't do chest_ok in mbsfn since it trigger measurements
       } else {
@@ -259,8 +273,8 @@ void sf_worker::update_measurements()
   std::vector<phy_meas_t> serving_cells = {};
   for (uint32_t cc_idx = 0; cc_idx < cc_workers.size(); cc_idx++) {
     cf_t* rssi_power_buffer = nullptr;
-    // Setting rssi_power_buffer to nullptr disables RSSI update. Do it only by worker 0
-    if (cc_idx == 0 && get_id() == 0) {
+    // Setting rssi_power_buffer to nullptr disables RSSI update. Do it only by worker 0 and if it received samples
+    if (cc_idx == 0 && get_id() == 0 && !rx_grid_ready) {
       rssi_power_buffer = cc_workers[0]->get_rx_buffer(0);
     }
     cc_workers[cc_idx]->update_measurements(serving_cells, rssi_power_buffer);
@@ -0,0 +1,564 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsue/hdr/phy/multi_ue_front_end.h"
+#include "srsran/radio/rf_timestamp.h"
+#include <chrono>
+
+namespace srsue {
+
+/// Radio interface given to every emulated UE. Only the leader port configures and receives from the actual radio
+class multi_ue_front_end::port : public srsran::radio_interface_phy
+{
+public:
+  port(multi_ue_front_end& parent_, uint32_t ue_idx_) : parent(parent_), ue_idx(ue_idx_) {}
+
+  void tx_end() override { parent.tx_end(ue_idx); }
+  bool tx(srsran::rf_buffer_interface& buffer, const srsran::rf_timestamp_interface& tx_time) override
+  {
+    return parent.tx(ue_idx, buffer, tx_time);
+  }
+  bool rx_now(srsran::rf_buffer_interface& buffer, srsran::rf_timestamp_interface& rxd_time) override
+  {
+    if (not is_leader() || not parent.radio->rx_now(buffer, rxd_time)) {
+      return false;
+    }
+    parent.set_rx_time(rxd_time.get(0));
+    return true;
+  }
+  void set_tx_freq(const uint32_t& carrier_idx, const double& freq) override
+  {
+    if (is_leader()) {
+      parent.radio->set_tx_freq(carrier_idx, freq);
+    }
+  }
+  void set_rx_freq(const uint32_t& carrier_idx, const double& freq) override
+  {
+    if (is_leader()) {
+      parent.radio->set_rx_freq(carrier_idx, freq);
+    }
+  }
+  void release_freq(const uint32_t& carrier_idx) override
+  {
+    if (is_leader()) {
+      parent.radio->release_freq(carrier_idx);
+    }
+  }
+  void set_tx_gain(const float& gain) override
+  {
+    if (is_leader()) {
+      parent.radio->set_tx_gain(gain);
+    }
+  }
+  void set_rx_gain_th(const float& gain) override
+  {
+    if (is_leader()) {
+      parent.radio->set_rx_gain_th(gain);
+    }
+  }
+  void set_rx_gain(const float& gain) override
+  {
+    if (is_leader()) {
+      parent.radio->set_rx_gain(gain);
+    }
+  }
+  void set_tx_srate(const double& srate) override
+  {
+    if (is_leader()) {
+      parent.radio->set_tx_srate(srate);
+      parent.set_tx_srate(srate);
+    }
+  }
+  void set_rx_srate(const double& srate) override
+  {
+    if (is_leader()) {
+      parent.radio->set_rx_srate(srate);
+    }
+  }
+  void set_channel_rx_offset(uint32_t ch, int32_t offset_samples) override
+  {
+    if (is_leader()) {
+      parent.radio->set_channel_rx_offset(ch, offset_samples);
+    }
+  }
+  void reset() override
+  {
+    if (is_leader()) {
+      parent.radio->reset();
+    }
+  }
+
+  double            get_freq_offset() override { return parent.radio->get_freq_offset(); }
+  float             get_rx_gain() override { return parent.radio->get_rx_gain(); }
+  bool              is_continuous_tx() override { return parent.radio->is_continuous_tx(); }
+  bool              get_is_start_of_burst() override { return parent.is_start_of_burst(ue_idx); }
+  bool              is_init() override { return parent.radio->is_init(); }
+  srsran_rf_info_t* get_info() override { return parent.radio->get_info(); }
+
+private:
+  bool is_leader() const { return ue_idx == 0; }
+
+  multi_ue_front_end& parent;
+  uint32_t            ue_idx;
+};
+
+multi_ue_front_end::multi_ue_front_end(srslog::basic_logger& logger_) : logger(logger_) {}
+
+multi_ue_front_end::~multi_ue_front_end()
+{
+  for (uint32_t ant = 0; ant < SRSRAN_MAX_PORTS; ant++) {
+    if (fft_in[ant] != nullptr) {
+      srsran_ofdm_rx_free(&fft[ant]);
+      free(fft_in[ant]);
+    }
+    if (fft_out[ant] != nullptr) {
+      free(fft_out[ant]);
+    }
+    for (dl_slot_t& slot : dl_slots) {
+      if (slot.grid[ant] != nullptr) {
+        free(slot.grid[ant]);
+      }
+    }
+  }
+  for (cf_t* ring : tx_ring) {
+    if (ring != nullptr) {
+      free(ring);
+    }
+  }
+}
+
+int multi_ue_front_end::init(srsran::radio_interface_phy* radio_,
+                             uint32_t                     nof_ues_,
+                             uint32_t                     nof_rf_channels_,
+                             uint32_t                     nof_rx_ant_)
+{
+  if (radio_ == nullptr || nof_ues_ == 0 || nof_rf_channels_ == 0 || nof_rf_channels_ > SRSRAN_MAX_CHANNELS ||
+      nof_rx_ant_ == 0 || nof_rx_ant_ > SRSRAN_MAX_PORTS) {
+    logger.error("Invalid multi-UE front end configuration (%d UEs, %d channels, %d antennas)",
+                 nof_ues_,
+                 nof_rf_channels_,
+                 nof_rx_ant_);
+    return SRSRAN_ERROR;
+  }
+
+  radio           = radio_;
+  nof_ues         = nof_ues_;
+  nof_rf_channels = nof_rf_channels_;
+  nof_rx_ant      = nof_rx_ant_;
+
+  // The OFDM demodulator is configured for the cell bandwidth when the first subframe is written
+  srsran_ofdm_cfg_t ofdm_cfg = {};
+  ofdm_cfg.nof_prb           = SRSRAN_MAX_PRB;
+  ofdm_cfg.cp                = SRSRAN_CP_NORM;
+  ofdm_cfg.rx_window_offset  = 0.0f;
+  ofdm_cfg.normalize         = false;
+  ofdm_cfg.sf_type           = SRSRAN_SF_NORM;
+  for (uint32_t ant = 0; ant < nof_rx_ant; ant++) {
+    fft_in[ant]  = srsran_vec_cf_malloc(SRSRAN_SF_LEN_MAX);
+    fft_out[ant] = srsran_vec_cf_malloc(SRSRAN_SF_LEN_RE(SRSRAN_MAX_PRB, SRSRAN_CP_NORM));
+    if (fft_in[ant] == nullptr || fft_out[ant] == nullptr) {
+      logger.error("Error allocating multi-UE front end buffers");
+      return SRSRAN_ERROR;
+    }
+    ofdm_cfg.in_buffer  = fft_in[ant];
+    ofdm_cfg.out_buffer = fft_out[ant];
+    if (srsran_ofdm_rx_init_cfg(&fft[ant], &ofdm_cfg) < SRSRAN_SUCCESS) {
+      logger.error("Error initiating multi-UE front end FFT");
+      return SRSRAN_ERROR;
+    }
+
+    for (dl_slot_t& slot : dl_slots) {
+      slot.grid[ant] = srsran_vec_cf_malloc(SRSRAN_SF_LEN_RE(SRSRAN_MAX_PRB, SRSRAN_CP_NORM));
+      if (slot.grid[ant] == nullptr) {
+        logger.error("Error allocating multi-UE front end buffers");
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+  fft_cell = {};
+
+  for (uint32_t ch = 0; ch < nof_rf_channels; ch++) {
+    tx_ring[ch] = srsran_vec_cf_malloc(TX_RING_MS * SRSRAN_SF_LEN_MAX);
+    if (tx_ring[ch] == nullptr) {
+      logger.error("Error allocating multi-UE front end buffers");
+      return SRSRAN_ERROR;
+    }
+    srsran_vec_cf_zero(tx_ring[ch], TX_RING_MS * SRSRAN_SF_LEN_MAX);
+  }
+
+  dl_next.assign(nof_ues, 0);
+  tx_state.assign(nof_ues, {});
+  for (uint32_t i = 0; i < nof_ues; i++) {
+    ports.emplace_back(new port(*this, i));
+  }
+
+  running = true;
+  logger.info("Multi-UE front end initiated for %d UEs", nof_ues);
+
+  return SRSRAN_SUCCESS;
+}
+
+void multi_ue_front_end::stop()
+{
+  if (not running) {
+    return;
+  }
+  running = false;
+
+  // Release the followers waiting for a subframe
+  {
+    std::lock_guard<std::mutex> lock(dl_mutex);
+    dl_cvar.notify_all();
+  }
+
+  // Transmit anything pending
+  std::lock_guard<std::mutex> lock(tx_mutex);
+  if (tx_started) {
+    tx_flush(tx_newest);
+    radio->tx_end();
+    tx_reset();
+  }
+  if (tx_nof_late_samples > 0) {
+    logger.info("Multi-UE front end discarded %" PRIu64 " late uplink samples", tx_nof_late_samples);
+  }
+}
+
+srsran::radio_interface_phy* multi_ue_front_end::get_port(uint32_t ue_idx)
+{
+  if (ue_idx >= ports.size()) {
+    return nullptr;
+  }
+  return ports[ue_idx].get();
+}
+
+void multi_ue_front_end::write_dl(const dl_subframe_t&                               sf,
+                                  const std::array<uint8_t, SRSRAN_BCH_PAYLOAD_LEN>& mib,
+                                  srsran::rf_buffer_t&                               buffer)
+{
+  if (not running || nof_ues < 2) {
+    return;
+  }
+
+  // Reconfigure the demodulator if the cell bandwidth or cyclic prefix changed
+  if (sf.cell.nof_prb != fft_cell.nof_prb || sf.cell.cp != fft_cell.cp) {
+    for (uint32_t ant = 0; ant < nof_rx_ant; ant++) {
+      if (srsran_ofdm_rx_set_prb(&fft[ant], sf.cell.cp, sf.cell.nof_prb) < SRSRAN_SUCCESS) {
+        logger.error("Error setting multi-UE front end FFT for %d PRB", sf.cell.nof_prb);
+        fft_cell = {};
+        return;
+      }
+    }
+    fft_cell = sf.cell;
+  }
+
+  uint32_t sf_len = SRSRAN_SF_LEN_PRB(sf.cell.nof_prb);
+  uint32_t nof_re = SRSRAN_SF_LEN_RE(sf.cell.nof_prb, sf.cell.cp);
+  uint64_t seq    = dl_seq + 1;
+
+  // Demodulate before taking the slot, so a follower copying the same slot is held for the minimum time
+  for (uint32_t ant = 0; ant < nof_rx_ant; ant++) {
+    srsran_vec_cf_copy(fft_in[ant], buffer.get(0, ant, nof_rx_ant), sf_len);
+    srsran_ofdm_rx_sf(&fft[ant]);
+  }
+
+  dl_slot_t& slot = dl_slots[seq % NOF_DL_SUBFRAMES];
+  {
+    std::lock_guard<std::mutex> lock(slot.mutex);
+    for (uint32_t ant = 0; ant < nof_rx_ant; ant++) {
+      srsran_vec_cf_copy(slot.grid[ant], fft_out[ant], nof_re);
+    }
+    slot.nof_re = nof_re;
+    slot.sf     = sf;
+    slot.seq    = seq;
+  }
+
+  std::lock_guard<std::mutex> lock(dl_mutex);
+  dl_seq    = seq;
+  dl_cell   = sf.cell;
+  dl_earfcn = sf.earfcn;
+  dl_mib    = mib;
+  dl_cvar.notify_all();
+}
+
+bool multi_ue_front_end::wait_cell(srsran_cell_t*                               cell,
+                                   uint32_t*                                    earfcn,
+                                   std::array<uint8_t, SRSRAN_BCH_PAYLOAD_LEN>& mib,
+                                   uint32_t                                     timeout_ms)
+{
+  std::unique_lock<std::mutex> lock(dl_mutex);
+
+  // The leader is camping if it keeps publishing subframes
+  uint64_t seq    = dl_seq;
+  auto     expire = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+  while (running && dl_seq == seq) {
+    if (dl_cvar.wait_until(lock, expire) == std::cv_status::timeout) {
+      return false;
+    }
+  }
+  if (not running) {
+    return false;
+  }
+
+  *cell   = dl_cell;
+  *earfcn = dl_earfcn;
+  mib     = dl_mib;
+  return true;
+}
+
+void multi_ue_front_end::set_rx_time(const srsran_timestamp_t& rx_time_)
+{
+  if (nof_ues < 2) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(dl_mutex);
+  rx_time = rx_time_;
+  rx_count++;
+  dl_cvar.notify_all();
+}
+
+bool multi_ue_front_end::wait_rx_time(srsran_timestamp_t* rx_time_, uint32_t timeout_ms)
+{
+  std::unique_lock<std::mutex> lock(dl_mutex);
+
+  uint64_t count  = rx_count;
+  auto     expire = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+  while (running && rx_count == count) {
+    if (dl_cvar.wait_until(lock, expire) == std::cv_status::timeout) {
+      return false;
+    }
+  }
+  if (not running) {
+    return false;
+  }
+
+  *rx_time_ = rx_time;
+  return true;
+}
+
+bool multi_ue_front_end::read_dl(uint32_t ue_idx, cf_t* grid[SRSRAN_MAX_PORTS], dl_subframe_t& sf, uint32_t timeout_ms)
+{
+  if (ue_idx == 0 || ue_idx >= nof_ues) {
+    return false;
+  }
+
+  uint64_t seq = 0;
+  {
+    std::unique_lock<std::mutex> lock(dl_mutex);
+    uint64_t&                    next   = dl_next[ue_idx];
+    auto                         expire = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (running && dl_seq < std::max(next, (uint64_t)1)) {
+      if (dl_cvar.wait_until(lock, expire) == std::cv_status::timeout) {
+        return false;
+      }
+    }
+    if (not running) {
+      return false;
+    }
+
+    // Start from the newest subframe, or jump to it if the leader is about to overwrite the next one
+    if (next == 0 || dl_seq - next >= NOF_DL_SUBFRAMES - 1) {
+      if (next != 0) {
+        logger.warning("Multi-UE: UE %d skipped %" PRIu64 " DL subframes", ue_idx, dl_seq - next);
+      }
+      next = dl_seq;
+    }
+    seq = next++;
+  }
+
+  dl_slot_t&                  slot = dl_slots[seq % NOF_DL_SUBFRAMES];
+  std::lock_guard<std::mutex> lock(slot.mutex);
+  if (slot.seq != seq) {
+    logger.warning("Multi-UE: UE %d DL subframe was overwritten", ue_idx);
+    return false;
+  }
+  for (uint32_t ant = 0; ant < nof_rx_ant; ant++) {
+    srsran_vec_cf_copy(grid[ant], slot.grid[ant], slot.nof_re);
+  }
+  sf = slot.sf;
+
+  return true;
+}
+
+bool multi_ue_front_end::tx(uint32_t                              ue_idx,
+                            srsran::rf_buffer_interface&          buffer,
+                            const srsran::rf_timestamp_interface& tx_time)
+{
+  std::lock_guard<std::mutex> lock(tx_mutex);
+  if (not running || tx_ring_sz == 0) {
+    return false;
+  }
+
+  uint32_t nof_samples = buffer.get_nof_samples();
+  uint64_t start       = srsran_timestamp_uint64(&tx_time.get(0), tx_srate);
+  uint64_t end         = start + nof_samples;
+  if (not tx_started) {
+    tx_flushed = start;
+    tx_newest  = start;
+    tx_started = true;
+  }
+
+  // Samples already given to the radio can not be added anymore
+  uint64_t first = std::max(start, tx_flushed);
+  if (first >= end) {
+    tx_nof_late_samples += nof_samples;
+    logger.debug("Multi-UE: UE %d transmission of %d samples is late", ue_idx, nof_samples);
+  } else {
+    tx_nof_late_samples += first - start;
+
+    // Make room in the ring for the new samples
+    if (end > tx_flushed + tx_ring_sz) {
+      tx_flush(end - tx_ring_sz);
+    }
+
+    for (uint64_t pos = first; pos < end;) {
+      uint32_t idx = pos % tx_ring_sz;
+      uint32_t n   = (uint32_t)std::min(end - pos, (uint64_t)(tx_ring_sz - idx));
+      for (uint32_t ch = 0; ch < nof_rf_channels; ch++) {
+        cf_t* ptr = buffer.get(ch);
+        if (ptr != nullptr) {
+          srsran_vec_sum_ccc(&tx_ring[ch][idx], &ptr[pos - start], &tx_ring[ch][idx], n);
+        }
+      }
+      pos += n;
+    }
+  }
+
+  tx_state[ue_idx].active   = true;
+  tx_state[ue_idx].in_burst = true;
+  tx_state[ue_idx].end      = end;
+  tx_newest                 = std::max(tx_newest, end);
+
+  tx_flush_ready();
+
+  return true;
+}
+
+void multi_ue_front_end::tx_end(uint32_t ue_idx)
+{
+  std::lock_guard<std::mutex> lock(tx_mutex);
+  if (not running) {
+    return;
+  }
+  // The UE reports once per subframe, so it will not transmit in the subframe following the last one reported
+  tx_state_t& state = tx_state[ue_idx];
+  uint64_t    sf_sz = (uint64_t)round(tx_srate / 1000.0);
+  state.end         = std::max(state.active ? state.end + sf_sz : 0, tx_newest);
+  state.active      = true;
+  state.in_burst    = false;
+
+  bool any_in_burst = false;
+  for (const tx_state_t& s : tx_state) {
+    any_in_burst |= s.in_burst;
+  }
+
+  if (any_in_burst) {
+    tx_flush_ready();
+  } else if (tx_started) {
+    // Close the burst once the last UE finished transmitting
+    tx_flush(tx_newest);
+    radio->tx_end();
+    tx_reset();
+  }
+}
+
+void multi_ue_front_end::set_tx_srate(double srate)
+{
+  std::lock_guard<std::mutex> lock(tx_mutex);
+  if (srate == tx_srate) {
+    return;
+  }
+
+  // Pending samples do not make sense at the new rate
+  tx_reset();
+  tx_srate   = srate;
+  tx_ring_sz = std::min(TX_RING_MS * (uint32_t)round(srate / 1000.0), TX_RING_MS * SRSRAN_SF_LEN_MAX);
+}
+
+bool multi_ue_front_end::is_start_of_burst(uint32_t ue_idx)
+{
+  std::lock_guard<std::mutex> lock(tx_mutex);
+  return not tx_state[ue_idx].in_burst;
+}
+
+void multi_ue_front_end::tx_flush_ready()
+{
+  // Every UE must have reported its samples or the end of its burst, unless it lags more than TX_MAX_LAG_MS behind
+  uint64_t until = tx_newest;
+  for (const tx_state_t& state : tx_state) {
+    if (state.active) {
+      until = std::min(until, state.end);
+    }
+  }
+  uint64_t max_lag = (uint64_t)TX_MAX_LAG_MS * (uint64_t)round(tx_srate / 1000.0);
+  if (tx_newest > max_lag) {
+    until = std::max(until, tx_newest - max_lag);
+  }
+  tx_flush(until);
+}
+
+void multi_ue_front_end::tx_flush(uint64_t until)
+{
+  // Give the combined samples to the radio, limited to one subframe at a time
+  uint64_t end = std::min(until, tx_newest);
+  while (tx_flushed < end) {
+    uint32_t idx = tx_flushed % tx_ring_sz;
+    uint32_t n   = (uint32_t)std::min({end - tx_flushed, (uint64_t)(tx_ring_sz - idx), (uint64_t)SRSRAN_SF_LEN_MAX});
+
+    srsran::rf_buffer_t    buffer;
+    srsran::rf_timestamp_t tx_time;
+    for (uint32_t ch = 0; ch < nof_rf_channels; ch++) {
+      buffer.set(ch, &tx_ring[ch][idx]);
+      srsran_timestamp_init_uint64(tx_time.get_ptr(ch), tx_flushed, tx_srate);
+    }
+    buffer.set_nof_samples(n);
+    radio->tx(buffer, tx_time);
+
+    for (uint32_t ch = 0; ch < nof_rf_channels; ch++) {
+      srsran_vec_cf_zero(&tx_ring[ch][idx], n);
+    }
+    tx_flushed += n;
+  }
+
+  // Nothing was written after the newest sample, skip the gap
+  if (until > tx_flushed) {
+    tx_flushed = until;
+    tx_newest  = std::max(tx_newest, until);
+  }
+}
+
+void multi_ue_front_end::tx_reset()
+{
+  // Flushed samples are zeroed already, clear the ring only if something was discarded
+  if (tx_newest > tx_flushed) {
+    for (uint32_t ch = 0; ch < nof_rf_channels; ch++) {
+      srsran_vec_cf_zero(tx_ring[ch], TX_RING_MS * SRSRAN_SF_LEN_MAX);
+    }
+  }
+  // The UE ends refer to the discarded burst, the UEs are waited for again once they report in the next one
+  for (tx_state_t& state : tx_state) {
+    state = {};
+  }
+  tx_started = false;
+  tx_flushed = 0;
+  tx_newest  = 0;
+}
+
+} // namespace srsue
@@ -62,8 +62,10 @@ void phy_common::init(phy_args_t*                  _args,
 
   // Instantiate UL channel emulator
   if (args->ul_channel_args.enable) {
+    srsran::channel::args_t ul_channel_args = args->ul_channel_args;
+    ul_channel_args.fading_uplink           = true;
     ul_channel = srsran::channel_ptr(
-        new srsran::channel(args->ul_channel_args, args->nof_lte_carriers * args->nof_rx_ant, logger));
+        new srsran::channel(ul_channel_args, args->nof_lte_carriers * args->nof_rx_ant, logger, args->nof_rx_ant));
   }
 
   // Init the CFR config struct with the CFR args
@@ -19,6 +19,7 @@
  *
  */
 #include "srsue/hdr/phy/scell/intra_measure_base.h"
+#include <time.h>
 
 #define Log(level, fmt, ...)                                                                                           \
   do {                                                                                                                 \
@@ -47,6 +48,10 @@ void intra_measure_base::init_generic(uint32_t cc_idx_, const args_t& args)
   context.trigger_tti_offset = args.tti_offset;
   rx_gain_offset_db          = args.rx_gain_offset_db;
 
+  // Reset CPU usage
+  meas_cpu_us    = 0;
+  meas_cpu_count = 0;
+
   // Compute subframe length from the sampling rate if available
   if (std::isnormal(args.srate_hz)) {
     context.sf_len = (uint32_t)round(args.srate_hz / 1000.0);
@@ -195,10 +200,20 @@ void intra_measure_base::measure_proc()
     state.set_state(internal_state::wait);
   }
 
-  // Perform measurements for the actual RAT
+  // Perform measurements for the actual RAT, accounting the CPU time of this thread
+  size_t          nof_pci = context_copy.active_pci.size();
+  struct timespec start   = {};
+  struct timespec end     = {};
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
   if (not measure_rat(std::move(context_copy), search_buffer, rx_gain_offset_db)) {
     Log(error, "Error measuring RAT");
   }
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &end);
+
+  int64_t cpu_us = (int64_t)(end.tv_sec - start.tv_sec) * 1000000 + (end.tv_nsec - start.tv_nsec) / 1000;
+  meas_cpu_us += (uint64_t)cpu_us;
+  meas_cpu_count++;
+  Log(debug, "Measured %zd active cells in %" PRId64 " us of CPU time", nof_pci, cpu_us);
 }
 
 void intra_measure_base::run_thread()
@@ -77,34 +77,37 @@ bool intra_measure_lte::measure_rat(measure_context_t context, std::vector<cf_t>
 
   context.new_cell_itf.cell_meas_reset(context.cc_idx);
 
-  // Use Cell Reference signal to measure cells in the time domain for all known active PCI
+  // Do not measure serving cell here since it's measured by workers
+  batch_pci.clear();
   for (const uint32_t& id : cells_to_measure) {
-    // Do not measure serving cell here since it's measured by workers
-    if (id == serving_cell_copy.id) {
-      continue;
-    }
-    srsran_cell_t cell = serving_cell_copy;
-    cell.id            = id;
-
-    if (srsran_refsignal_dl_sync_set_cell(&refsignal_dl_sync, cell) < SRSRAN_SUCCESS) {
-      Log(error, "Error setting refsignal DL cell");
-      return false;
-    }
-
-    if (srsran_refsignal_dl_sync_run(&refsignal_dl_sync, buffer.data(), context.meas_len_ms * context.sf_len) <
-        SRSRAN_SUCCESS) {
-      Log(error, "Error running refsignal DL measurements");
-      return false;
+    if (id != serving_cell_copy.id) {
+      batch_pci.push_back(id);
     }
+  }
+  batch_meas.resize(batch_pci.size());
+
+  // Use Cell Reference signal to measure cells in the time domain for all known active PCI. All of them are correlated
+  // against the same transform of the buffer
+  if (srsran_refsignal_dl_sync_run_batch(&refsignal_dl_sync,
+                                         serving_cell_copy,
+                                         batch_pci.data(),
+                                         (uint32_t)batch_pci.size(),
+                                         buffer.data(),
+                                         context.meas_len_ms * context.sf_len,
+                                         batch_meas.data()) < SRSRAN_SUCCESS) {
+    Log(error, "Error running refsignal DL measurements");
+    return false;
+  }
 
-    if (refsignal_dl_sync.found) {
+  for (const srsran_refsignal_dl_sync_meas_t& meas : batch_meas) {
+    if (meas.found) {
       phy_meas_t m = {};
       m.rat        = srsran::srsran_rat_t::lte;
-      m.pci        = cell.id;
+      m.pci        = meas.pci;
       m.earfcn     = current_earfcn;
-      m.rsrp       = refsignal_dl_sync.rsrp_dBfs - rx_gain_offset_db;
-      m.rsrq       = refsignal_dl_sync.rsrq_dB;
-      m.cfo_hz     = refsignal_dl_sync.cfo_Hz;
+      m.rsrp       = meas.rsrp_dBfs - rx_gain_offset_db;
+      m.rsrq       = meas.rsrq_dB;
+      m.cfo_hz     = meas.cfo_Hz;
       neighbour_cells.push_back(m);
 
       Log(info,
@@ -113,8 +116,8 @@ bool intra_measure_lte::measure_rat(measure_context_t context, std::vector<cf_t>
           m.pci,
           m.rsrp,
           m.rsrq,
-          refsignal_dl_sync.peak_index,
-          refsignal_dl_sync.cfo_Hz);
+          meas.peak_index,
+          meas.cfo_Hz);
     }
   }
 
@@ -124,6 +124,8 @@ search::ret_code search::run(srsran_cell_t* cell_, std::array<uint8_t, SRSRAN_BC
   if (force_N_id_2 >= 0 && force_N_id_2 < SRSRAN_NOF_NID_2) {
     ret           = srsran_ue_cellsearch_scan_N_id_2(&cs, force_N_id_2, &found_cells[force_N_id_2]);
     max_peak_cell = force_N_id_2;
+  } else if (single_pass) {
+    ret = srsran_ue_cellsearch_scan_single_pass(&cs, found_cells, &max_peak_cell);
   } else {
     ret = srsran_ue_cellsearch_scan(&cs, found_cells, &max_peak_cell);
   }
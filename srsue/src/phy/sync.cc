@@ -86,13 +86,14 @@ void sync::init(srsran::radio_interface_phy* _radio,
   srsran_ue_sync_cp_en(&ue_sync, worker_com->args->detect_cp);
 
   if (worker_com->args->dl_channel_args.enable) {
-    channel_emulator =
-        srsran::channel_ptr(new srsran::channel(worker_com->args->dl_channel_args, nof_rf_channels, phy_logger));
+    channel_emulator = srsran::channel_ptr(new srsran::channel(
+        worker_com->args->dl_channel_args, nof_rf_channels, phy_logger, worker_com->args->nof_rx_ant));
   }
 
   // Initialize cell searcher
   search_p.init(sf_buffer, nof_rf_channels, this, worker_com->args->force_N_id_2, worker_com->args->force_N_id_1);
   search_p.set_cp_en(worker_com->args->detect_cp);
+  search_p.set_single_pass(worker_com->args->cell_search_single_pass);
   // Initialize SFN synchronizer, it uses only pcell buffer
   sfn_p.init(&ue_sync, worker_com->args, sf_buffer, sf_buffer.size());
 
@@ -119,8 +120,8 @@ void sync::init(srsran::radio_interface_phy* _radio,
   reset();
   running = true;
 
-  // Enable AGC for primary cell receiver
-  set_agc_enable(worker_com->args->agc_enable);
+  // Enable AGC for primary cell receiver, the UEs following another one do not control the radio
+  set_agc_enable(worker_com->args->agc_enable and not is_follower());
 
   // Start main thread
   if (sync_cpu_affinity < 0) {
@@ -130,6 +131,12 @@ void sync::init(srsran::radio_interface_phy* _radio,
   }
 }
 
+void sync::set_front_end(multi_ue_front_end* front_end_, uint32_t ue_idx)
+{
+  front_end        = front_end_;
+  front_end_ue_idx = ue_idx;
+}
+
 sync::~sync()
 {
   srsran_ue_sync_free(&ue_sync);
@@ -422,6 +429,21 @@ bool sync::wait_idle()
 
 void sync::run_cell_search_state()
 {
+  // Followers take the cell the leader is camping on, provided it is in the searched frequency
+  if (is_follower()) {
+    srsran_cell_t leader_cell   = {};
+    uint32_t      leader_earfcn = 0;
+    cell_search_ret             = search::CELL_NOT_FOUND;
+    if (front_end->wait_cell(&leader_cell, &leader_earfcn, mib, FOLLOWER_CELL_TIMEOUT_MS) &&
+        (int)leader_earfcn == current_earfcn) {
+      cell.set(leader_cell);
+      stack->bch_decoded_ok(SYNC_CC_IDX, mib.data(), mib.size() / 8);
+      cell_search_ret = search::CELL_FOUND;
+    }
+    phy_state.state_exit();
+    return;
+  }
+
   srsran_cell_t tmp_cell = cell.get();
   cell_search_ret        = search_p.run(&tmp_cell, mib);
   if (cell_search_ret == search::CELL_FOUND) {
@@ -433,6 +455,21 @@ void sync::run_cell_search_state()
 
 void sync::run_sfn_sync_state()
 {
+  // Followers are synchronized if the leader is camping on the selected cell
+  if (is_follower()) {
+    srsran_cell_t leader_cell   = {};
+    uint32_t      leader_earfcn = 0;
+    if (not front_end->wait_cell(&leader_cell, &leader_earfcn, mib, FOLLOWER_CELL_TIMEOUT_MS) ||
+        (int)leader_earfcn != current_earfcn || not cell.equals(leader_cell)) {
+      Info("SYNC:  The shared front end is not camping on the selected cell");
+      phy_state.state_exit(false);
+      return;
+    }
+    stack->in_sync();
+    phy_state.state_exit();
+    return;
+  }
+
   srsran_cell_t old_cell = cell.get();
   switch (sfn_p.run_subframe(&old_cell, &tti, mib)) {
     case sfn_sync::SFN_FOUND:
@@ -509,6 +546,22 @@ void sync::run_camping_in_sync_state(lte::sf_worker*      lte_worker,
     }
   }
 
+  // Share the synchronized subframe with the UEs following this one
+  if (front_end != nullptr and not force_camping_sfn_sync) {
+    multi_ue_front_end::dl_subframe_t sf = {};
+    sf.cell                              = cell.get();
+    sf.earfcn                            = (uint32_t)current_earfcn;
+    sf.tti                               = tti;
+    sf.cfo_hz                            = cfo;
+    sf.rx_time                           = last_rx_time.get(0);
+    front_end->write_dl(sf, mib, sync_buffer);
+  }
+
+  run_camping_workers(lte_worker, nr_worker);
+}
+
+void sync::run_camping_workers(lte::sf_worker* lte_worker, nr::sf_worker* nr_worker)
+{
   Debug("SYNC:  Worker %d synchronized", lte_worker->get_id());
 
   // Collect and provide metrics from last successful sync
@@ -517,7 +570,15 @@ void sync::run_camping_in_sync_state(lte::sf_worker*      lte_worker,
   metrics.ta_us       = worker_com->ta.get_usec();
   metrics.distance_km = worker_com->ta.get_km();
   metrics.speed_kmph  = worker_com->ta.get_speed_kmph(tti);
+  std::array<uint32_t, SRSRAN_MAX_CARRIERS> meas_cpu_us = {};
+  {
+    std::lock_guard<std::mutex> lock(intra_freq_cfg_mutex);
+    for (uint32_t i = 0; i < intra_freq_meas.size() and i < SRSRAN_MAX_CARRIERS; i++) {
+      meas_cpu_us[i] = intra_freq_meas[i]->get_meas_cpu_us();
+    }
+  }
   for (uint32_t i = 0; i < worker_com->args->nof_lte_carriers; i++) {
+    metrics.meas_cpu_us = meas_cpu_us[i];
     worker_com->set_sync_metrics(i, metrics);
   }
 
@@ -587,8 +648,54 @@ void sync::run_camping_in_sync_state(lte::sf_worker*      lte_worker,
     lte_worker_pool->start_worker(lte_worker);
   }
 }
+
+void sync::run_camping_follower_state()
+{
+  lte::sf_worker* lte_worker = lte_worker_pool->wait_worker(tti);
+  if (lte_worker == nullptr) {
+    running = false;
+    return;
+  }
+
+  // Copy the demodulated subframe straight into the worker resource grid
+  cf_t* grid[SRSRAN_MAX_PORTS] = {};
+  for (uint32_t i = 0; i < worker_com->args->nof_rx_ant; i++) {
+    grid[i] = lte_worker->get_rx_grid(0, i);
+  }
+
+  multi_ue_front_end::dl_subframe_t sf = {};
+  if (front_end->read_dl(front_end_ue_idx, grid, sf, FOLLOWER_DL_TIMEOUT_MS) && cell.equals(sf.cell)) {
+    tti = sf.tti;
+    cfo = sf.cfo_hz;
+    sfo = 0.0f;
+    for (uint32_t ch = 0; ch < nof_rf_channels; ch++) {
+      *last_rx_time.get_ptr(ch) = sf.rx_time;
+    }
+    stack_tti_ts_new = sf.rx_time;
+
+    phy_lib_logger.set_context(tti);
+    phy_logger.set_context(tti);
+
+    lte_worker->set_rx_grid_ready(true);
+    run_camping_workers(lte_worker, nullptr);
+  } else {
+    Warning("SYNC:  No subframe from the shared front end");
+    out_of_sync();
+    lte_worker->release();
+  }
+
+  // Run stack
+  Debug("run_stack_tti: from main");
+  run_stack_tti();
+}
+
 void sync::run_camping_state()
 {
+  if (is_follower()) {
+    run_camping_follower_state();
+    return;
+  }
+
   lte::sf_worker*     lte_worker  = lte_worker_pool->wait_worker(tti);
   srsran::rf_buffer_t sync_buffer = {};
 
@@ -659,6 +766,15 @@ void sync::run_camping_state()
 
 void sync::run_idle_state()
 {
+  // Followers do not receive, they keep the stack running on the radio time of the leader
+  if (is_follower()) {
+    if (front_end->wait_rx_time(&stack_tti_ts_new, FOLLOWER_DL_TIMEOUT_MS)) {
+      run_stack_tti();
+    }
+    radio_h->tx_end();
+    return;
+  }
+
   if (radio_h->is_init()) {
     uint32_t nsamples = 1920;
     if (srate.is_normal()) {
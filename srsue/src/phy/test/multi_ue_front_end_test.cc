@@ -0,0 +1,218 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/radio/rf_timestamp.h"
+#include "srsue/hdr/phy/multi_ue_front_end.h"
+#include <vector>
+
+/*
+ * Tests the uplink combining of the multi-UE front end, with a radio recording the transmitted samples
+ */
+
+static const uint32_t nof_ues = 3;
+static const double   srate   = 1.92e6;
+static const uint32_t sf_len  = 1920;
+
+class radio_recorder : public srsran::radio_interface_phy
+{
+public:
+  struct tx_record_t {
+    uint64_t          start;
+    std::vector<cf_t> samples;
+  };
+
+  void tx_end() override { nof_tx_end++; }
+  bool tx(srsran::rf_buffer_interface& buffer, const srsran::rf_timestamp_interface& tx_time) override
+  {
+    tx_record_t record;
+    record.start = srsran_timestamp_uint64(&tx_time.get(0), tx_srate);
+    record.samples.assign(buffer.get(0), buffer.get(0) + buffer.get_nof_samples());
+    records.push_back(std::move(record));
+    return true;
+  }
+  bool rx_now(srsran::rf_buffer_interface& buffer, srsran::rf_timestamp_interface& rxd_time) override { return false; }
+  void set_tx_freq(const uint32_t& carrier_idx, const double& freq) override {}
+  void set_rx_freq(const uint32_t& carrier_idx, const double& freq) override {}
+  void release_freq(const uint32_t& carrier_idx) override {}
+  void set_tx_gain(const float& gain) override {}
+  void set_rx_gain_th(const float& gain) override {}
+  void set_rx_gain(const float& gain) override {}
+  void set_tx_srate(const double& srate_) override { tx_srate = srate_; }
+  void set_rx_srate(const double& srate_) override {}
+  void set_channel_rx_offset(uint32_t ch, int32_t offset_samples) override {}
+
+  double            get_freq_offset() override { return 0.0; }
+  float             get_rx_gain() override { return 0.0f; }
+  bool              is_continuous_tx() override { return false; }
+  bool              get_is_start_of_burst() override { return true; }
+  bool              is_init() override { return true; }
+  void              reset() override {}
+  srsran_rf_info_t* get_info() override { return nullptr; }
+
+  std::vector<tx_record_t> records;
+  uint32_t                 nof_tx_end = 0;
+  double                   tx_srate   = 0.0;
+};
+
+/// Transmits one subframe of constant samples from a UE
+static void ue_tx(srsue::multi_ue_front_end& fe, uint32_t ue_idx, uint64_t start, cf_t value, double rate = srate)
+{
+  uint32_t               len = (uint32_t)round(rate / 1000.0);
+  std::vector<cf_t>      samples(len, value);
+  srsran::rf_buffer_t    buffer(samples.data(), len);
+  srsran::rf_timestamp_t tx_time;
+  srsran_timestamp_init_uint64(tx_time.get_ptr(0), start, rate);
+  fe.get_port(ue_idx)->tx(buffer, tx_time);
+}
+
+static bool record_is(const radio_recorder::tx_record_t& record, uint64_t start, uint32_t len, cf_t value)
+{
+  if (record.start != start || record.samples.size() != len) {
+    return false;
+  }
+  for (const cf_t& s : record.samples) {
+    if (s != value) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// The slots are sent once every UE transmitted or reported the end of its burst, whatever the number transmitting
+int test_partial_ue_slots()
+{
+  radio_recorder            radio;
+  srsue::multi_ue_front_end fe(srslog::fetch_basic_logger("PHY", false));
+  TESTASSERT(fe.init(&radio, nof_ues, 1, 1) == SRSRAN_SUCCESS);
+  fe.get_port(0)->set_tx_srate(srate);
+
+  // Every UE reports, so the rest wait for it
+  for (uint32_t ue_idx = 0; ue_idx < nof_ues; ue_idx++) {
+    fe.get_port(ue_idx)->tx_end();
+  }
+
+  // Slot with two UEs transmitting
+  uint64_t t0 = 10 * sf_len;
+  ue_tx(fe, 0, t0, {1.0f, 0.0f});
+  ue_tx(fe, 1, t0, {2.0f, 0.0f});
+  TESTASSERT(radio.records.empty());
+  TESTASSERT(not fe.get_port(0)->get_is_start_of_burst());
+  TESTASSERT(fe.get_port(2)->get_is_start_of_burst());
+  fe.get_port(2)->tx_end();
+  TESTASSERT(radio.records.size() == 1);
+  TESTASSERT(record_is(radio.records[0], t0, sf_len, {3.0f, 0.0f}));
+
+  // Slot with one UE transmitting
+  ue_tx(fe, 0, t0 + sf_len, {1.0f, 0.0f});
+  fe.get_port(1)->tx_end();
+  TESTASSERT(radio.records.size() == 1);
+  fe.get_port(2)->tx_end();
+  TESTASSERT(radio.records.size() == 2);
+  TESTASSERT(record_is(radio.records[1], t0 + sf_len, sf_len, {1.0f, 0.0f}));
+
+  // The burst ends with the last UE transmitting
+  TESTASSERT(radio.nof_tx_end == 0);
+  fe.get_port(0)->tx_end();
+  TESTASSERT(radio.nof_tx_end == 1);
+  TESTASSERT(radio.records.size() == 2);
+
+  fe.stop();
+  return SRSRAN_SUCCESS;
+}
+
+/// A UE reporting the end of its burst after the burst was closed is waited for in the next burst, the UEs that did not
+/// report since then are not
+int test_late_tx_end()
+{
+  radio_recorder            radio;
+  srsue::multi_ue_front_end fe(srslog::fetch_basic_logger("PHY", false));
+  TESTASSERT(fe.init(&radio, nof_ues, 1, 1) == SRSRAN_SUCCESS);
+  fe.get_port(0)->set_tx_srate(srate);
+
+  // UE 0 is the only one transmitting, UE 1 reports during the burst
+  uint64_t t0 = 10 * sf_len;
+  ue_tx(fe, 0, t0, {1.0f, 0.0f});
+  TESTASSERT(radio.records.size() == 1);
+  fe.get_port(1)->tx_end();
+  fe.get_port(0)->tx_end();
+  TESTASSERT(radio.nof_tx_end == 1);
+
+  // UE 2 lags behind and reports the end of the burst once it is closed
+  fe.get_port(2)->tx_end();
+
+  uint64_t t1 = 20 * sf_len;
+  ue_tx(fe, 0, t1, {1.0f, 0.0f});
+  TESTASSERT(radio.records.size() == 1);
+  fe.get_port(2)->tx_end();
+  TESTASSERT(radio.records.size() == 2);
+  TESTASSERT(record_is(radio.records[1], t1, sf_len, {1.0f, 0.0f}));
+
+  fe.stop();
+  TESTASSERT(radio.nof_tx_end == 2);
+  return SRSRAN_SUCCESS;
+}
+
+/// A sampling rate change in the middle of a burst discards the pending samples and the state of every UE
+int test_mid_burst_reset()
+{
+  radio_recorder            radio;
+  srsue::multi_ue_front_end fe(srslog::fetch_basic_logger("PHY", false));
+  TESTASSERT(fe.init(&radio, nof_ues, 1, 1) == SRSRAN_SUCCESS);
+  fe.get_port(0)->set_tx_srate(srate);
+
+  fe.get_port(0)->tx_end();
+  fe.get_port(1)->tx_end();
+  uint64_t t0 = 10 * sf_len;
+  ue_tx(fe, 0, t0, {1.0f, 0.0f});
+  ue_tx(fe, 1, t0, {2.0f, 0.0f});
+  ue_tx(fe, 0, t0 + sf_len, {1.0f, 0.0f});
+  TESTASSERT(radio.records.size() == 1);
+  TESTASSERT(record_is(radio.records[0], t0, sf_len, {3.0f, 0.0f}));
+
+  // The second subframe of UE 0 is pending on UE 1 when the rate changes
+  double new_srate = 2 * srate;
+  fe.get_port(0)->set_tx_srate(new_srate);
+  TESTASSERT(fe.get_port(0)->get_is_start_of_burst());
+  TESTASSERT(fe.get_port(1)->get_is_start_of_burst());
+
+  // UE 1 does not hold the first burst at the new rate
+  uint64_t t1 = 40 * sf_len;
+  ue_tx(fe, 0, t1, {1.0f, 0.0f}, new_srate);
+  TESTASSERT(radio.records.size() == 2);
+  TESTASSERT(record_is(radio.records[1], t1, 2 * sf_len, {1.0f, 0.0f}));
+
+  fe.stop();
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  srslog::init();
+
+  TESTASSERT(test_partial_ue_slots() == SRSRAN_SUCCESS);
+  TESTASSERT(test_late_tx_end() == SRSRAN_SUCCESS);
+  TESTASSERT(test_mid_burst_reset() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  printf("Ok\n");
+  return SRSRAN_SUCCESS;
+}
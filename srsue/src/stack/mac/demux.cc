@@ -169,7 +169,7 @@ void demux::process_pdu(uint8_t* mac_pdu, uint32_t nof_bytes, srsran::pdu_queue:
         mac_msg.to_string(buffer);
         Info("%s", srsran::to_c_str(buffer));
       }
-      process_sch_pdu(&mac_msg);
+      process_sch_pdu(&mac_msg, mac_pdu);
       pdus.deallocate(mac_pdu);
       break;
     case srsran::pdu_queue::BCH:
@@ -204,7 +204,7 @@ void demux::process_sch_pdu_rt(uint8_t* buff, uint32_t nof_bytes, uint32_t tti)
   }
 }
 
-void demux::process_sch_pdu(srsran::sch_pdu* pdu_msg)
+void demux::process_sch_pdu(srsran::sch_pdu* pdu_msg, const uint8_t* mac_pdu)
 {
   while (pdu_msg->next()) {
     if (pdu_msg->get()->is_sdu()) {
@@ -225,8 +225,10 @@ void demux::process_sch_pdu(srsran::sch_pdu* pdu_msg)
         Debug(
             "Delivering PDU for lcid=%d, %d bytes", pdu_msg->get()->get_sdu_lcid(), pdu_msg->get()->get_payload_size());
         if (pdu_msg->get()->get_payload_size() < MAX_PDU_LEN) {
-          rlc->write_pdu(
-              pdu_msg->get()->get_sdu_lcid(), pdu_msg->get()->get_sdu_ptr(), pdu_msg->get()->get_payload_size());
+          // Hand the SDU to RLC as a slice of the MAC PDU buffer, so that it does not need to be copied
+          rlc->write_pdu_slice(
+              pdu_msg->get()->get_sdu_lcid(),
+              pdus.make_slice(mac_pdu, pdu_msg->get()->get_sdu_ptr(), pdu_msg->get()->get_payload_size()));
         } else {
           char tmp[1024];
           srsran_vec_sprint_hex(tmp, sizeof(tmp), pdu_msg->get()->get_sdu_ptr(), 32);
@@ -0,0 +1,208 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/asn1/liblte_mme.h"
+#include "srsran/common/int_helpers.h"
+#include "srsran/common/test_common.h"
+#include "srsue/hdr/stack/upper/tft_packet_filter.h"
+#include <chrono>
+#include <getopt.h>
+#include <vector>
+
+using namespace srsue;
+
+static uint32_t bench_nof_packets = 1000000;
+static uint32_t bench_max_filters = 120;
+static uint32_t bench_nof_flows   = 64;
+
+static const uint8_t first_eps_bearer_id = 5;
+
+/// Filter i takes the UDP packets to 10.0.<i>.1, remote port 5000 + i
+static void make_filter(LIBLTE_MME_PACKET_FILTER_STRUCT& filter, uint32_t i)
+{
+  uint8_t* ptr           = filter.filter;
+  filter.dir             = LIBLTE_MME_TFT_PACKET_FILTER_DIRECTION_BIDIRECTIONAL;
+  filter.id              = i % LIBLTE_MME_PACKET_FILTER_LIST_MAX_SIZE;
+  filter.eval_precedence = i;
+  *ptr++                 = IPV4_REMOTE_ADDR_TYPE;
+  srsran::uint32_to_uint8(0x0a000001 | (i << 8), ptr);
+  srsran::uint32_to_uint8(0xffffffff, ptr + 4);
+  ptr += 8;
+  *ptr++ = PROTOCOL_ID_TYPE;
+  *ptr++ = UDP_PROTOCOL;
+  *ptr++ = SINGLE_REMOTE_PORT_TYPE;
+  srsran::uint16_to_uint8(5000 + i, ptr);
+  ptr += 2;
+  filter.filter_size = ptr - filter.filter;
+}
+
+/// UDP packet of a flow towards the remote address and port of filter idx, from local port 2000 + flow
+static srsran::unique_byte_buffer_t make_packet(uint32_t idx, uint32_t flow)
+{
+  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+  if (pdu == nullptr) {
+    return pdu;
+  }
+  pdu->N_bytes = 28;
+  memset(pdu->msg, 0, pdu->N_bytes);
+  pdu->msg[0] = 0x45;
+  pdu->msg[9] = UDP_PROTOCOL;
+  srsran::uint32_to_uint8(0xc0a80101, &pdu->msg[12]);
+  srsran::uint32_to_uint8(0x0a000001 | (idx << 8), &pdu->msg[16]);
+  srsran::uint16_to_uint8(2000 + flow, &pdu->msg[20]);
+  srsran::uint16_to_uint8(5000 + idx, &pdu->msg[22]);
+  return pdu;
+}
+
+/// Classifies the packets of the flows in turn, returning the rate in packets/s
+template <typename F>
+static double run_benchmark(std::vector<srsran::unique_byte_buffer_t>& packets, const F& classify)
+{
+  auto tic = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < bench_nof_packets; i++) {
+    classify(packets[i % packets.size()]);
+  }
+  return bench_nof_packets / std::chrono::duration<double>(std::chrono::steady_clock::now() - tic).count();
+}
+
+int run_benchmarks(uint32_t nof_filters)
+{
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("TFT");
+
+  // The compiled matcher has no flow cache, the cached one looks up every flow whatever the number of filters
+  tft_pdu_matcher                  compiled(logger, 0);
+  tft_pdu_matcher                  cached(logger, tft_pdu_matcher::default_flow_cache_size, 0);
+  tft_pdu_matcher                  matcher(logger);
+  std::vector<tft_packet_filter_t> filters;
+
+  // Each EPS bearer takes as many filters as fit in a TFT
+  for (uint32_t i = 0; i < nof_filters; i += LIBLTE_MME_PACKET_FILTER_LIST_MAX_SIZE) {
+    LIBLTE_MME_TRAFFIC_FLOW_TEMPLATE_STRUCT tft = {};
+    tft.tft_op_code                             = LIBLTE_MME_TFT_OPERATION_CODE_CREATE_NEW_TFT;
+    tft.packet_filter_list_size = std::min(nof_filters - i, (uint32_t)LIBLTE_MME_PACKET_FILTER_LIST_MAX_SIZE);
+    for (uint32_t j = 0; j < tft.packet_filter_list_size; j++) {
+      make_filter(tft.packet_filter_list[j], i + j);
+      filters.emplace_back(first_eps_bearer_id + i / LIBLTE_MME_PACKET_FILTER_LIST_MAX_SIZE,
+                           tft.packet_filter_list[j],
+                           logger);
+    }
+    uint8_t eps_bearer_id = first_eps_bearer_id + i / LIBLTE_MME_PACKET_FILTER_LIST_MAX_SIZE;
+    TESTASSERT(compiled.apply_traffic_flow_template(eps_bearer_id, &tft) == SRSRAN_SUCCESS);
+    TESTASSERT(cached.apply_traffic_flow_template(eps_bearer_id, &tft) == SRSRAN_SUCCESS);
+    TESTASSERT(matcher.apply_traffic_flow_template(eps_bearer_id, &tft) == SRSRAN_SUCCESS);
+  }
+
+  // The flows are spread over the filters, one in four flows matching none of them
+  std::vector<srsran::unique_byte_buffer_t> packets;
+  for (uint32_t flow = 0; flow < bench_nof_flows; flow++) {
+    uint32_t idx = flow % 4 == 3 ? nof_filters : (flow * 7) % nof_filters;
+    packets.push_back(make_packet(idx, flow));
+    TESTASSERT(packets.back() != nullptr);
+  }
+
+  // The filters are evaluated one by one in order of precedence, each of them parsing the packet, as the matcher did
+  // before compiling them. The filters match with the current code, so this is not the previous implementation
+  auto classify_per_filter = [&filters](const srsran::unique_byte_buffer_t& pdu) {
+    for (const tft_packet_filter_t& filter : filters) {
+      if (filter.match(pdu)) {
+        return (int)filter.eps_bearer_id;
+      }
+    }
+    return -1;
+  };
+  auto classify_matcher = [](tft_pdu_matcher& matcher, const srsran::unique_byte_buffer_t& pdu) {
+    uint8_t eps_bearer_id = 0;
+    return matcher.check_tft_filter_match(pdu, eps_bearer_id) == SRSRAN_SUCCESS ? (int)eps_bearer_id : -1;
+  };
+
+  // All must agree
+  for (uint32_t i = 0; i < 2; i++) {
+    for (const srsran::unique_byte_buffer_t& pdu : packets) {
+      int expected = classify_per_filter(pdu);
+      TESTASSERT(classify_matcher(compiled, pdu) == expected);
+      TESTASSERT(classify_matcher(cached, pdu) == expected);
+      TESTASSERT(classify_matcher(matcher, pdu) == expected);
+    }
+  }
+
+  double per_filter_rate = run_benchmark(packets, classify_per_filter);
+  double compiled_rate   = run_benchmark(
+      packets, [&](const srsran::unique_byte_buffer_t& pdu) { return classify_matcher(compiled, pdu); });
+  double cached_rate =
+      run_benchmark(packets, [&](const srsran::unique_byte_buffer_t& pdu) { return classify_matcher(cached, pdu); });
+  double matcher_rate =
+      run_benchmark(packets, [&](const srsran::unique_byte_buffer_t& pdu) { return classify_matcher(matcher, pdu); });
+  printf("%8d %14.2f %14.2f %14.2f %14.2f\n",
+         nof_filters,
+         per_filter_rate / 1e6,
+         compiled_rate / 1e6,
+         cached_rate / 1e6,
+         matcher_rate / 1e6);
+  return SRSRAN_SUCCESS;
+}
+
+void usage(char* prog)
+{
+  printf("Usage: %s [nfl]\n", prog);
+  printf("\t-n number of packets classified per run [Default %d]\n", bench_nof_packets);
+  printf("\t-f maximum number of filters [Default %d]\n", bench_max_filters);
+  printf("\t-l number of flows [Default %d]\n", bench_nof_flows);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "nfl")) != -1) {
+    switch (opt) {
+      case 'n':
+        bench_nof_packets = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'f':
+        bench_max_filters = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'l':
+        bench_nof_flows = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srslog::fetch_basic_logger("TFT", false).set_level(srslog::basic_levels::error);
+  srslog::init();
+
+  printf("%d flows, classified Mpackets/s\n", bench_nof_flows);
+  printf("%8s %14s %14s %14s %14s\n", "filters", "per filter", "compiled", "flow cache", "default");
+  for (uint32_t nof_filters = 1; nof_filters <= bench_max_filters; nof_filters *= 2) {
+    TESTASSERT(run_benchmarks(nof_filters) == SRSRAN_SUCCESS);
+  }
+  if (bench_max_filters & (bench_max_filters - 1)) {
+    TESTASSERT(run_benchmarks(bench_max_filters) == SRSRAN_SUCCESS);
+  }
+
+  return SRSRAN_SUCCESS;
+}
@@ -171,6 +171,73 @@ int tft_filter_test_ipv6_combined()
   return 0;
 }
 
+int tft_filter_test_ipv6_remote_addr_prefix()
+{
+  srslog::basic_logger&        logger = srslog::fetch_basic_logger("TFT");
+  srsran::unique_byte_buffer_t ip_msg1, ip_msg2, ip_msg3;
+  ip_msg1 = make_byte_buffer();
+  TESTASSERT(ip_msg1 != nullptr);
+  ip_msg2 = make_byte_buffer();
+  TESTASSERT(ip_msg2 != nullptr);
+  ip_msg3 = make_byte_buffer();
+  TESTASSERT(ip_msg3 != nullptr);
+
+  // Destination 2a02:14f:ffc0:51::6
+  ip_msg1->N_bytes = sizeof(ipv6_matched_packet);
+  memcpy(ip_msg1->msg, ipv6_matched_packet, sizeof(ipv6_matched_packet));
+
+  // Destination 2a02:14f:ffc0:51::7
+  ip_msg2->N_bytes = sizeof(ipv6_unmatched_packet_daddr);
+  memcpy(ip_msg2->msg, ipv6_unmatched_packet_daddr, sizeof(ipv6_unmatched_packet_daddr));
+
+  // Destination 2a02:14f:ffc0:59::6
+  ip_msg3->N_bytes = sizeof(ipv6_matched_packet);
+  memcpy(ip_msg3->msg, ipv6_matched_packet, sizeof(ipv6_matched_packet));
+  ip_msg3->msg[31] = 0x59;
+
+  // Packet filter with an IPv6 remote address/prefix length component, the address is 2a02:14f:ffc0:50::6
+  LIBLTE_MME_PACKET_FILTER_STRUCT packet_filter = {};
+  packet_filter.dir                             = LIBLTE_MME_TFT_PACKET_FILTER_DIRECTION_BIDIRECTIONAL;
+  packet_filter.id                              = 1;
+  packet_filter.eval_precedence                 = 0;
+  packet_filter.filter_size                     = 1 + IPV6_ADDR_SIZE + 1;
+  packet_filter.filter[0]                       = IPV6_REMOTE_ADDR_LENGTH_TYPE;
+  memcpy(&packet_filter.filter[1], &ipv6_matched_packet[24], IPV6_ADDR_SIZE);
+  packet_filter.filter[1 + 7] = 0x50;
+
+  // Only the bits of the prefix are compared, whatever the rest of the address
+  packet_filter.filter[1 + IPV6_ADDR_SIZE] = 60;
+  srsue::tft_packet_filter_t filter_60(EPS_BEARER_ID, packet_filter, logger);
+  TESTASSERT(filter_60.match(ip_msg1));
+  TESTASSERT(filter_60.match(ip_msg2));
+  TESTASSERT(filter_60.match(ip_msg3));
+
+  packet_filter.filter[1 + IPV6_ADDR_SIZE] = 61;
+  srsue::tft_packet_filter_t filter_61(EPS_BEARER_ID, packet_filter, logger);
+  TESTASSERT(filter_61.match(ip_msg1));
+  TESTASSERT(filter_61.match(ip_msg2));
+  TESTASSERT(!filter_61.match(ip_msg3));
+
+  packet_filter.filter[1 + IPV6_ADDR_SIZE] = 64;
+  srsue::tft_packet_filter_t filter_64(EPS_BEARER_ID, packet_filter, logger);
+  TESTASSERT(!filter_64.match(ip_msg1));
+  TESTASSERT(!filter_64.match(ip_msg2));
+  TESTASSERT(!filter_64.match(ip_msg3));
+
+  // A full length prefix compares the whole address, also when the length is larger than the address
+  packet_filter.filter[1 + 7] = 0x51;
+  for (uint8_t prefix_len : {128, 200}) {
+    packet_filter.filter[1 + IPV6_ADDR_SIZE] = prefix_len;
+    srsue::tft_packet_filter_t filter_128(EPS_BEARER_ID, packet_filter, logger);
+    TESTASSERT(filter_128.match(ip_msg1));
+    TESTASSERT(!filter_128.match(ip_msg2));
+    TESTASSERT(!filter_128.match(ip_msg3));
+  }
+
+  printf("Test TFT filter ipv6 remote address prefix successfull\n");
+  return 0;
+}
+
 int tft_filter_test_single_local_port()
 {
   srslog::basic_logger& logger = srslog::fetch_basic_logger("TFT");
@@ -409,6 +476,119 @@ int tft_filter_test_ipv4_tos()
   return 0;
 }
 
+int tft_pdu_matcher_test_flow_cache()
+{
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("TFT");
+
+  srsran::unique_byte_buffer_t ip_msg1, ip_msg2;
+  ip_msg1 = make_byte_buffer();
+  TESTASSERT(ip_msg1 != nullptr);
+  ip_msg2 = make_byte_buffer();
+  TESTASSERT(ip_msg2 != nullptr);
+  ip_msg1->N_bytes = ip_message_len1;
+  memcpy(ip_msg1->msg, ip_tst_message1, ip_message_len1);
+  ip_msg2->N_bytes = ip_message_len2;
+  memcpy(ip_msg2->msg, ip_tst_message2, ip_message_len2);
+
+  // EPS bearer 6 takes the UDP packets from local port 2222, EPS bearer 7 any other UDP packet
+  LIBLTE_MME_TRAFFIC_FLOW_TEMPLATE_STRUCT tft1 = {}, tft2 = {};
+  tft1.tft_op_code                             = LIBLTE_MME_TFT_OPERATION_CODE_CREATE_NEW_TFT;
+  tft1.packet_filter_list_size                 = 1;
+  tft1.packet_filter_list[0].id                = 1;
+  tft1.packet_filter_list[0].eval_precedence   = 1;
+  tft1.packet_filter_list[0].filter_size       = 3;
+  tft1.packet_filter_list[0].filter[0]         = SINGLE_LOCAL_PORT_TYPE;
+  srsran::uint16_to_uint8(2222, &tft1.packet_filter_list[0].filter[1]);
+  tft2                                       = tft1;
+  tft2.packet_filter_list[0].id              = 2;
+  tft2.packet_filter_list[0].eval_precedence = 2;
+  tft2.packet_filter_list[0].filter_size     = 2;
+  tft2.packet_filter_list[0].filter[0]       = PROTOCOL_ID_TYPE;
+  tft2.packet_filter_list[0].filter[1]       = UDP_PROTOCOL;
+
+  // A single cached flow, so that the two flows evict each other. The cache is used whatever the number of filters
+  srsue::tft_pdu_matcher matcher(logger, 1, 0);
+  uint8_t                eps_bearer_id = 0;
+  TESTASSERT(matcher.check_tft_filter_match(ip_msg1, eps_bearer_id) == SRSRAN_ERROR);
+  TESTASSERT(matcher.apply_traffic_flow_template(EPS_BEARER_ID, &tft1) == SRSRAN_SUCCESS);
+  TESTASSERT(matcher.apply_traffic_flow_template(EPS_BEARER_ID + 1, &tft2) == SRSRAN_SUCCESS);
+
+  for (uint32_t i = 0; i < 2; i++) {
+    TESTASSERT(matcher.check_tft_filter_match(ip_msg1, eps_bearer_id) == SRSRAN_SUCCESS);
+    TESTASSERT(eps_bearer_id == EPS_BEARER_ID);
+    TESTASSERT(matcher.check_tft_filter_match(ip_msg2, eps_bearer_id) == SRSRAN_SUCCESS);
+    TESTASSERT(eps_bearer_id == EPS_BEARER_ID + 1);
+  }
+
+  // Cached flows must not outlive the filters
+  matcher.delete_tft_for_eps_bearer(EPS_BEARER_ID);
+  TESTASSERT(matcher.check_tft_filter_match(ip_msg1, eps_bearer_id) == SRSRAN_SUCCESS);
+  TESTASSERT(eps_bearer_id == EPS_BEARER_ID + 1);
+  matcher.delete_tft_for_eps_bearer(EPS_BEARER_ID + 1);
+  eps_bearer_id = 0;
+  TESTASSERT(matcher.check_tft_filter_match(ip_msg1, eps_bearer_id) == SRSRAN_ERROR);
+  TESTASSERT(eps_bearer_id == 0);
+
+  printf("Test TFT PDU matcher flow cache successfull\n");
+  return 0;
+}
+
+int tft_flow_cache_test_lru()
+{
+  const uint32_t capacity = 3;
+  tft_flow_cache cache(capacity);
+
+  // Flows of different local ports, mapped to EPS bearer 5 + port
+  std::vector<tft_packet_fields_t> flows(100);
+  for (uint32_t i = 0; i < flows.size(); i++) {
+    flows[i]            = {};
+    flows[i].version    = 4;
+    flows[i].protocol   = UDP_PROTOCOL;
+    flows[i].local_port = i;
+  }
+
+  for (uint32_t i = 0; i < capacity; i++) {
+    TESTASSERT(cache.find(flows[i]) == nullptr);
+    cache.insert(flows[i], 5 + i);
+  }
+  TESTASSERT(cache.size() == capacity);
+
+  // Flow 0 is used again, so flow 1 becomes the least recently used and is evicted by flow 3
+  TESTASSERT(cache.find(flows[0]) != nullptr && *cache.find(flows[0]) == 5);
+  cache.insert(flows[3], 8);
+  TESTASSERT(cache.size() == capacity);
+  TESTASSERT(cache.find(flows[1]) == nullptr);
+  for (uint32_t i : {0, 2, 3}) {
+    TESTASSERT(cache.find(flows[i]) != nullptr && *cache.find(flows[i]) == (int)(5 + i));
+  }
+
+  // Flow 0 is now the least recently used
+  cache.insert(flows[4], 9);
+  TESTASSERT(cache.find(flows[0]) == nullptr);
+  TESTASSERT(cache.find(flows[4]) != nullptr && *cache.find(flows[4]) == 9);
+
+  // Only the last flows inserted are kept, whatever the slots they collide in
+  for (uint32_t i = 5; i < flows.size(); i++) {
+    cache.insert(flows[i], 5 + i);
+    TESTASSERT(cache.size() == capacity);
+    for (uint32_t j = 0; j <= i; j++) {
+      const int* eps_bearer_id = cache.find(flows[j]);
+      if (j + capacity > i) {
+        TESTASSERT(eps_bearer_id != nullptr && *eps_bearer_id == (int)(5 + j));
+      } else {
+        TESTASSERT(eps_bearer_id == nullptr);
+      }
+    }
+  }
+
+  cache.clear();
+  TESTASSERT(cache.size() == 0);
+  TESTASSERT(cache.find(flows.back()) == nullptr);
+
+  printf("Test TFT flow cache LRU eviction successfull\n");
+  return 0;
+}
+
 int main(int argc, char** argv)
 {
   srslog::basic_logger& logger = srslog::fetch_basic_logger("TFT", false);
@@ -435,4 +615,13 @@ int main(int argc, char** argv)
   if (tft_filter_test_ipv6_combined()) {
     return -1;
   }
+  if (tft_filter_test_ipv6_remote_addr_prefix()) {
+    return -1;
+  }
+  if (tft_pdu_matcher_test_flow_cache()) {
+    return -1;
+  }
+  if (tft_flow_cache_test_lru()) {
+    return -1;
+  }
 }
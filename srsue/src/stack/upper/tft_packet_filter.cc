@@ -20,6 +20,7 @@
  */
 
 #include "srsue/hdr/stack/upper/tft_packet_filter.h"
+#include "srsran/adt/scope_exit.h"
 #include "srsran/upper/ipv6.h"
 
 extern "C" {
@@ -32,6 +33,51 @@ extern "C" {
 
 namespace srsue {
 
+static_assert(sizeof(tft_packet_fields_t) == 32, "The packet fields are hashed and compared as words without padding");
+
+static const uint16_t ip_flags = IPV4_REMOTE_ADDR_FLAG | IPV4_LOCAL_ADDR_FLAG | IPV6_REMOTE_ADDR_FLAG |
+                                 IPV6_REMOTE_ADDR_LENGTH_FLAG | IPV6_LOCAL_ADDR_LENGTH_FLAG;
+static const uint16_t port_flags =
+    SINGLE_LOCAL_PORT_FLAG | LOCAL_PORT_RANGE_FLAG | SINGLE_REMOTE_PORT_FLAG | REMOTE_PORT_RANGE_FLAG;
+
+tft_packet_fields_t tft_packet_fields_t::parse(const uint8_t* msg)
+{
+  const struct iphdr*   ip_pkt  = (const struct iphdr*)msg;
+  const struct ipv6hdr* ip6_pkt = (const struct ipv6hdr*)msg;
+  const uint8_t*        l4_hdr  = nullptr;
+
+  tft_packet_fields_t pkt = {};
+  pkt.version             = ip_pkt->version;
+  if (ip_pkt->version == 4) {
+    pkt.protocol         = ip_pkt->protocol;
+    pkt.tos              = ip_pkt->tos;
+    pkt.ipv4_local_addr  = ip_pkt->saddr;
+    pkt.ipv4_remote_addr = ip_pkt->daddr;
+    l4_hdr               = &msg[ip_pkt->ihl * 4];
+  } else if (ip_pkt->version == 6) {
+    pkt.protocol = ip6_pkt->nexthdr;
+    memcpy(pkt.ipv6_remote_addr, ip6_pkt->daddr.in6_u.u6_addr8, IPV6_ADDR_SIZE);
+    l4_hdr = &msg[sizeof(ipv6hdr)];
+  }
+
+  // The ports are at the same offset of the UDP and TCP headers
+  if (l4_hdr != nullptr and (pkt.protocol == UDP_PROTOCOL or pkt.protocol == TCP_PROTOCOL)) {
+    const struct udphdr* udp_pkt = (const struct udphdr*)l4_hdr;
+    pkt.local_port               = udp_pkt->source;
+    pkt.remote_port              = udp_pkt->dest;
+  }
+  return pkt;
+}
+
+/// Stores an IPv6 address and its mask as words, with the address masked
+static void set_ipv6_words(const uint8_t* addr, const uint8_t* mask, uint64_t* masked_words, uint64_t* mask_words)
+{
+  memcpy(masked_words, addr, IPV6_ADDR_SIZE);
+  memcpy(mask_words, mask, IPV6_ADDR_SIZE);
+  masked_words[0] &= mask_words[0];
+  masked_words[1] &= mask_words[1];
+}
+
 tft_packet_filter_t::tft_packet_filter_t(uint8_t                                eps_bearer_id_,
                                          const LIBLTE_MME_PACKET_FILTER_STRUCT& tft,
                                          srslog::basic_logger&                  logger) :
@@ -73,6 +119,8 @@ tft_packet_filter_t::tft_packet_filter_t(uint8_t
         memcpy(&ipv6_remote_addr_mask, &tft.filter[idx], IPV6_ADDR_SIZE);
         idx += IPV6_ADDR_SIZE;
         ipv6_remote_addr_length = IPV6_ADDR_SIZE;
+        set_ipv6_words(
+            ipv6_remote_addr, ipv6_remote_addr_mask, ipv6_remote_addr_masked_words, ipv6_remote_addr_mask_words);
         break;
 
       case IPV6_REMOTE_ADDR_LENGTH_TYPE: // "IPv6 remote address/prefix length type"
@@ -80,6 +128,10 @@ tft_packet_filter_t::tft_packet_filter_t(uint8_t
         memcpy(&ipv6_remote_addr, &tft.filter[idx], IPV6_ADDR_SIZE);
         idx += IPV6_ADDR_SIZE;
         ipv6_remote_addr_length = tft.filter[idx++];
+        if (ipv6_remote_addr_length > IPV6_ADDR_SIZE * 8) {
+          logger.warning("Invalid IPv6 remote address prefix length %d", ipv6_remote_addr_length);
+          ipv6_remote_addr_length = IPV6_ADDR_SIZE * 8;
+        }
         // convert address length to mask:
         length_in_bytes = ipv6_remote_addr_length / 8;
         remaining_bits  = ipv6_remote_addr_length % 8;
@@ -89,6 +141,8 @@ tft_packet_filter_t::tft_packet_filter_t(uint8_t
           ipv6_remote_addr_mask[i] = 0xff;
         if (remaining_bits > 0)
           ipv6_remote_addr_mask[length_in_bytes] = 0xff - ((1 << (8 - remaining_bits)) - 1);
+        set_ipv6_words(
+            ipv6_remote_addr, ipv6_remote_addr_mask, ipv6_remote_addr_masked_words, ipv6_remote_addr_mask_words);
         break;
 
       case IPV6_LOCAL_ADDR_LENGTH_TYPE:
@@ -96,6 +150,10 @@ tft_packet_filter_t::tft_packet_filter_t(uint8_t
         memcpy(&ipv6_local_addr, &tft.filter[idx], IPV6_ADDR_SIZE);
         idx += IPV6_ADDR_SIZE;
         ipv6_local_addr_length = tft.filter[idx++];
+        if (ipv6_local_addr_length > IPV6_ADDR_SIZE * 8) {
+          logger.warning("Invalid IPv6 local address prefix length %d", ipv6_local_addr_length);
+          ipv6_local_addr_length = IPV6_ADDR_SIZE * 8;
+        }
         // convert address length to mask:
         length_in_bytes = ipv6_local_addr_length / 8;
         remaining_bits  = ipv6_local_addr_length % 8;
@@ -178,11 +236,16 @@ tft_packet_filter_t::tft_packet_filter_t(uint8_t
   }
 }
 
-bool inline tft_packet_filter_t::filter_contains(uint16_t filtertype)
+bool tft_packet_filter_t::filter_contains(uint16_t filtertype) const
 {
   return (active_filters & filtertype) != 0;
 }
 
+bool tft_packet_filter_t::match(const srsran::unique_byte_buffer_t& pdu) const
+{
+  return match(tft_packet_fields_t::parse(pdu->msg));
+}
+
 /*
  * Implements packet matching against the packet filter componenets as specified in TS 24.008, section 10.5.6.12.
  *
@@ -191,70 +254,57 @@ bool inline tft_packet_filter_t::filter_contains(uint16_t filtertype)
  *
  * Note: 'active_filters' is a bitmask; bits set to '1' represent active filter components.
  */
-bool tft_packet_filter_t::match(const srsran::unique_byte_buffer_t& pdu)
+bool tft_packet_filter_t::match(const tft_packet_fields_t& pkt) const
 {
-  uint16_t ip_flags = IPV4_REMOTE_ADDR_FLAG | IPV4_LOCAL_ADDR_FLAG | IPV6_REMOTE_ADDR_FLAG |
-                      IPV6_REMOTE_ADDR_LENGTH_FLAG | IPV6_LOCAL_ADDR_LENGTH_FLAG;
-  uint16_t port_flags =
-      SINGLE_LOCAL_PORT_FLAG | LOCAL_PORT_RANGE_FLAG | SINGLE_REMOTE_PORT_FLAG | REMOTE_PORT_RANGE_FLAG;
-
   // Check if there is any active filter
   if (active_filters == 0) {
     return false;
   }
 
   // Match IP Header to active filters
-  if (filter_contains(ip_flags) && !match_ip(pdu)) {
+  if (filter_contains(ip_flags) && !match_ip(pkt)) {
     return false;
   }
 
   // Check Protocol ID/Next Header Field
-  if (filter_contains(PROTOCOL_ID_FLAG) && !match_protocol(pdu)) {
+  if (filter_contains(PROTOCOL_ID_FLAG) && !match_protocol(pkt)) {
     return false;
   }
 
   // Check Ports/Port Range
-  if (filter_contains(port_flags) && !match_port(pdu)) {
+  if (filter_contains(port_flags) && !match_port(pkt)) {
     return false;
   }
 
   // Check Type of Service/Traffic class
-  if (filter_contains(TYPE_OF_SERVICE_FLAG) && !match_type_of_service(pdu)) {
+  if (filter_contains(TYPE_OF_SERVICE_FLAG) && !match_type_of_service(pkt)) {
     return false;
   }
 
   return true;
 }
 
-bool tft_packet_filter_t::match_ip(const srsran::unique_byte_buffer_t& pdu)
+bool tft_packet_filter_t::match_ip(const tft_packet_fields_t& pkt) const
 {
-  struct iphdr*   ip_pkt  = (struct iphdr*)pdu->msg;
-  struct ipv6hdr* ip6_pkt = (struct ipv6hdr*)pdu->msg;
   // It is implied, that this is always an OUTGOING packet
-  if (ip_pkt->version == 4) {
+  if (pkt.version == 4) {
     // Check match on IPv4 packet
     if (filter_contains(IPV4_LOCAL_ADDR_FLAG)) {
-      if ((ip_pkt->saddr & ipv4_local_addr_mask) != (ipv4_local_addr & ipv4_local_addr_mask)) {
+      if ((pkt.ipv4_local_addr & ipv4_local_addr_mask) != (ipv4_local_addr & ipv4_local_addr_mask)) {
         return false;
       }
     }
 
     if (filter_contains(IPV4_REMOTE_ADDR_FLAG)) {
-      if ((ip_pkt->daddr & ipv4_remote_addr_mask) != (ipv4_remote_addr & ipv4_remote_addr_mask)) {
+      if ((pkt.ipv4_remote_addr & ipv4_remote_addr_mask) != (ipv4_remote_addr & ipv4_remote_addr_mask)) {
         return false;
       }
     }
-  } else if (ip_pkt->version == 6) {
-    // Check match on IPv6
+  } else if (pkt.version == 6) {
+    // Check match on IPv6, a word at a time. Only the 16 bytes of the address are compared, whatever the prefix length
     if (filter_contains(IPV6_REMOTE_ADDR_FLAG | IPV6_REMOTE_ADDR_LENGTH_FLAG)) {
-      bool match = true;
-      for (int i = 0; i < ipv6_remote_addr_length; i++) {
-        match &= ((ipv6_remote_addr[i] ^ ip6_pkt->daddr.in6_u.u6_addr8[i]) & ipv6_remote_addr_mask[i]) == 0;
-        if (!match) {
-          return false;
-        }
-      }
-      return true;
+      return (pkt.ipv6_remote_addr[0] & ipv6_remote_addr_mask_words[0]) == ipv6_remote_addr_masked_words[0] &&
+             (pkt.ipv6_remote_addr[1] & ipv6_remote_addr_mask_words[1]) == ipv6_remote_addr_masked_words[1];
     }
   } else {
     // Error
@@ -263,38 +313,24 @@ bool tft_packet_filter_t::match_ip(const srsran::unique_byte_buffer_t& pdu)
   return true;
 }
 
-bool tft_packet_filter_t::match_protocol(const srsran::unique_byte_buffer_t& pdu)
+bool tft_packet_filter_t::match_protocol(const tft_packet_fields_t& pkt) const
 {
-  struct iphdr*   ip_pkt  = (struct iphdr*)pdu->msg;
-  struct ipv6hdr* ip6_pkt = (struct ipv6hdr*)pdu->msg;
-
-  if (ip_pkt->version == 4) {
-    // Check match on IPv4 packet
-    if (ip_pkt->protocol != protocol_id) {
-      return false;
-    }
-  } else if (ip_pkt->version == 6) {
-    // Check match on IPv6 packet
-    if (ip6_pkt->nexthdr != protocol_id) {
-      return false;
-    }
-  } else {
+  if (pkt.version != 4 && pkt.version != 6) {
     // Error
     return false;
   }
-  return true;
+  // Protocol of IPv4 packets, Next Header of IPv6 packets
+  return pkt.protocol == protocol_id;
 }
 
-bool tft_packet_filter_t::match_type_of_service(const srsran::unique_byte_buffer_t& pdu)
+bool tft_packet_filter_t::match_type_of_service(const tft_packet_fields_t& pkt) const
 {
-  struct iphdr* ip_pkt = (struct iphdr*)pdu->msg;
-
-  if (ip_pkt->version == 4) {
+  if (pkt.version == 4) {
     // Check match on IPv4 packet
-    if ((ip_pkt->tos ^ type_of_service) & type_of_service_mask) {
+    if ((pkt.tos ^ type_of_service) & type_of_service_mask) {
       return false;
     }
-  } else if (ip_pkt->version == 6) {
+  } else if (pkt.version == 6) {
     // IPv6 traffic class not supported yet
     return false;
   }
@@ -314,87 +350,194 @@ bool tft_packet_filter_t::match_flow_label(const srsran::unique_byte_buffer_t& p
   return true;
 }
 
-bool tft_packet_filter_t::match_port(const srsran::unique_byte_buffer_t& pdu)
+bool tft_packet_filter_t::match_port(const tft_packet_fields_t& pkt) const
 {
-  struct iphdr*   ip_pkt  = (struct iphdr*)pdu->msg;
-  struct ipv6hdr* ip6_pkt = (struct ipv6hdr*)pdu->msg;
-  struct udphdr*  udp_pkt;
-  struct tcphdr*  tcp_pkt;
+  if (pkt.version != 4 && pkt.version != 6) {
+    return true;
+  }
+  if (pkt.protocol != UDP_PROTOCOL && pkt.protocol != TCP_PROTOCOL) {
+    return false;
+  }
+  if (filter_contains(SINGLE_LOCAL_PORT_FLAG) && pkt.local_port != single_local_port) {
+    return false;
+  }
+  if (filter_contains(SINGLE_REMOTE_PORT_FLAG) && pkt.remote_port != single_remote_port) {
+    return false;
+  }
+  return true;
+}
 
-  if (ip_pkt->version == 4) {
-    switch (ip_pkt->protocol) {
-      case UDP_PROTOCOL:
-        udp_pkt = (struct udphdr*)&pdu->msg[ip_pkt->ihl * 4];
-        if (active_filters & SINGLE_LOCAL_PORT_FLAG) {
-          if (udp_pkt->source != single_local_port) {
-            return false;
-          }
-        }
-        if (active_filters & SINGLE_REMOTE_PORT_FLAG) {
-          if (udp_pkt->dest != single_remote_port) {
-            return false;
-          }
-        }
-        break;
-      case TCP_PROTOCOL:
-        tcp_pkt = (struct tcphdr*)&pdu->msg[ip_pkt->ihl * 4];
-        if (active_filters & SINGLE_LOCAL_PORT_FLAG) {
-          if (tcp_pkt->source != single_local_port) {
-            return false;
-          }
-        }
-        if (active_filters & SINGLE_REMOTE_PORT_FLAG) {
-          if (tcp_pkt->dest != single_remote_port) {
-            return false;
-          }
-        }
-        break;
-      default:
-        return false;
+const uint32_t tft_flow_cache::none;
+
+tft_flow_cache::tft_flow_cache(uint32_t capacity) : entries(capacity)
+{
+  uint32_t nof_slots = 1;
+  while (nof_slots < 2 * capacity) {
+    nof_slots *= 2;
+  }
+  slots.assign(nof_slots, none);
+  slot_mask = nof_slots - 1;
+}
+
+uint32_t tft_flow_cache::hash_flow(const tft_packet_fields_t& flow)
+{
+  uint64_t words[sizeof(flow) / sizeof(uint64_t)];
+  memcpy(words, &flow, sizeof(flow));
+  uint64_t h = 0;
+  for (uint64_t w : words) {
+    // The upper half of the product depends on all the bits of the word, so it is folded into the slot bits
+    h = (h ^ w) * 0x9e3779b97f4a7c15ULL;
+    h ^= h >> 32;
+  }
+  return (uint32_t)h;
+}
+
+const int* tft_flow_cache::find(const tft_packet_fields_t& flow)
+{
+  if (entries.empty()) {
+    return nullptr;
+  }
+  uint32_t hash = hash_flow(flow);
+  for (uint32_t slot = hash & slot_mask; slots[slot] != none; slot = (slot + 1) & slot_mask) {
+    entry_t& entry = entries[slots[slot]];
+    if (entry.hash == hash and entry.flow == flow) {
+      if (head != slots[slot]) {
+        unlink(slots[slot]);
+        push_front(slots[slot]);
+      }
+      return &entry.eps_bearer_id;
     }
-  } else if (ip_pkt->version == 6) {
-    switch (ip6_pkt->nexthdr) {
-      case UDP_PROTOCOL:
-        udp_pkt = (struct udphdr*)&pdu->msg[sizeof(ipv6hdr)];
-        if (active_filters & SINGLE_LOCAL_PORT_FLAG) {
-          if (udp_pkt->source != single_local_port) {
-            return false;
-          }
-        }
-        if (active_filters & SINGLE_REMOTE_PORT_FLAG) {
-          if (udp_pkt->dest != single_remote_port) {
-            return false;
-          }
-        }
-        break;
-      case TCP_PROTOCOL:
-        tcp_pkt = (struct tcphdr*)&pdu->msg[sizeof(ipv6hdr)];
-        if (active_filters & SINGLE_LOCAL_PORT_FLAG) {
-          if (tcp_pkt->source != single_local_port) {
-            return false;
-          }
-        }
-        if (active_filters & SINGLE_REMOTE_PORT_FLAG) {
-          if (tcp_pkt->dest != single_remote_port) {
-            return false;
-          }
-        }
-        break;
-      default:
-        return false;
+  }
+  return nullptr;
+}
+
+void tft_flow_cache::insert(const tft_packet_fields_t& flow, int eps_bearer_id)
+{
+  if (entries.empty()) {
+    return;
+  }
+
+  uint32_t idx;
+  if (nof_entries == entries.size()) {
+    // Reuse the entry of the least recently used flow
+    idx           = tail;
+    uint32_t slot = entries[idx].hash & slot_mask;
+    while (slots[slot] != idx) {
+      slot = (slot + 1) & slot_mask;
     }
+    erase_slot(slot);
+    unlink(idx);
+  } else {
+    idx = nof_entries++;
   }
-  return true;
+
+  entry_t& entry      = entries[idx];
+  entry.flow          = flow;
+  entry.eps_bearer_id = eps_bearer_id;
+  entry.hash          = hash_flow(flow);
+  push_front(idx);
+
+  uint32_t slot = entry.hash & slot_mask;
+  while (slots[slot] != none) {
+    slot = (slot + 1) & slot_mask;
+  }
+  slots[slot] = idx;
+}
+
+void tft_flow_cache::clear()
+{
+  std::fill(slots.begin(), slots.end(), none);
+  nof_entries = 0;
+  head        = none;
+  tail        = none;
+}
+
+void tft_flow_cache::unlink(uint32_t idx)
+{
+  entry_t& entry = entries[idx];
+  (entry.prev != none ? entries[entry.prev].next : head) = entry.next;
+  (entry.next != none ? entries[entry.next].prev : tail) = entry.prev;
+}
+
+void tft_flow_cache::push_front(uint32_t idx)
+{
+  entries[idx].prev = none;
+  entries[idx].next = head;
+  (head != none ? entries[head].prev : tail) = idx;
+  head = idx;
+}
+
+/// Empties a slot, moving back the following entries of the probe sequence that would not be found otherwise
+void tft_flow_cache::erase_slot(uint32_t slot)
+{
+  for (uint32_t next = (slot + 1) & slot_mask; slots[next] != none; next = (next + 1) & slot_mask) {
+    uint32_t home = entries[slots[next]].hash & slot_mask;
+    if (((next - home) & slot_mask) >= ((next - slot) & slot_mask)) {
+      slots[slot] = slots[next];
+      slot        = next;
+    }
+  }
+  slots[slot] = none;
 }
 
 void tft_pdu_matcher::reset()
 {
+  std::lock_guard<std::mutex> lock(tft_mutex);
   tft_filter_map.clear();
+  compile_filters();
+}
+
+/// Rebuilds the filter lists from the TFT filters and flushes the flow cache. Must be called with tft_mutex held
+void tft_pdu_matcher::compile_filters()
+{
+  filters.clear();
+  for (const std::pair<const uint16_t, tft_packet_filter_t>& filter_pair : tft_filter_map) {
+    if (filter_pair.second.active_filters != 0) {
+      filters.push_back(&filter_pair.second);
+    }
+  }
+
+  // Drop the filters that a packet with the given protocol would fail on the protocol or the ports
+  for (uint32_t protocol = 0; protocol < filters_per_protocol.size(); protocol++) {
+    std::vector<uint16_t>& protocol_filters = filters_per_protocol[protocol];
+    protocol_filters.clear();
+    for (uint32_t i = 0; i < filters.size(); i++) {
+      if (filters[i]->filter_contains(PROTOCOL_ID_FLAG) && filters[i]->protocol_id != protocol) {
+        continue;
+      }
+      if (filters[i]->filter_contains(port_flags) && protocol != UDP_PROTOCOL && protocol != TCP_PROTOCOL) {
+        continue;
+      }
+      protocol_filters.push_back(i);
+    }
+  }
+
+  flow_cache.clear();
+}
+
+/// Returns the EPS bearer of the first filter matching the packet, -1 if there is none
+int tft_pdu_matcher::classify(const tft_packet_fields_t& pkt)
+{
+  if (pkt.version == 4 || pkt.version == 6) {
+    for (uint16_t idx : filters_per_protocol[pkt.protocol]) {
+      if (filters[idx]->match(pkt)) {
+        return filters[idx]->eps_bearer_id;
+      }
+    }
+    return -1;
+  }
+  for (const tft_packet_filter_t* filter : filters) {
+    if (filter->match(pkt)) {
+      return filter->eps_bearer_id;
+    }
+  }
+  return -1;
 }
 
 /**
  * Checks whether the provided PDU matches any configured TFT.
  * If it finds a match, it updates the eps_bearer_id parameter.
+ * With many filters, the result is kept per flow, so the filters are only evaluated for the first packet of a flow.
  * @param pdu           Reference to the PDU to check.
  * @param eps_bearer_id Reference to variable to store EPS bearer ID.
  * @return SRSRAN_SUCCESS if a reference could be found, SRSRAN_ERROR otherwise.
@@ -402,15 +545,27 @@ void tft_pdu_matcher::reset()
 int tft_pdu_matcher::check_tft_filter_match(const srsran::unique_byte_buffer_t& pdu, uint8_t& eps_bearer_id)
 {
   std::lock_guard<std::mutex> lock(tft_mutex);
-  for (std::pair<const uint16_t, tft_packet_filter_t>& filter_pair : tft_filter_map) {
-    bool match = filter_pair.second.match(pdu);
-    if (match) {
-      eps_bearer_id = filter_pair.second.eps_bearer_id;
-      logger.debug("Found filter match -- EPS bearer Id %d", filter_pair.second.eps_bearer_id);
-      return SRSRAN_SUCCESS;
+  if (filters.empty()) {
+    return SRSRAN_ERROR;
+  }
+
+  tft_packet_fields_t pkt = tft_packet_fields_t::parse(pdu->msg);
+  int                 match;
+  if (filters.size() < flow_cache_min_filters) {
+    match = classify(pkt);
+  } else {
+    const int* cached = flow_cache.find(pkt);
+    match             = cached != nullptr ? *cached : classify(pkt);
+    if (cached == nullptr) {
+      flow_cache.insert(pkt, match);
     }
   }
-  return SRSRAN_ERROR;
+  if (match < 0) {
+    return SRSRAN_ERROR;
+  }
+  eps_bearer_id = match;
+  logger.debug("Found filter match -- EPS bearer Id %d", match);
+  return SRSRAN_SUCCESS;
 }
 
 /**
@@ -421,6 +576,7 @@ int tft_pdu_matcher::check_tft_filter_match(const srsran::unique_byte_buffer_t&
 void tft_pdu_matcher::delete_tft_for_eps_bearer(const uint8_t eps_bearer_id)
 {
   std::lock_guard<std::mutex> lock(tft_mutex);
+  auto                        compile = srsran::make_scope_exit([this]() { compile_filters(); });
   auto                        old_filter = std::find_if(
       tft_filter_map.begin(), tft_filter_map.end(), [&](const std::pair<uint16_t, tft_packet_filter_t>& filter) {
         return filter.second.eps_bearer_id == eps_bearer_id;
@@ -435,6 +591,9 @@ int tft_pdu_matcher::apply_traffic_flow_template(const uint8_t&
                                                  const LIBLTE_MME_TRAFFIC_FLOW_TEMPLATE_STRUCT* tft)
 {
   std::lock_guard<std::mutex> lock(tft_mutex);
+
+  // The filters are recompiled on every exit, as a failed operation may have modified some of them
+  auto compile = srsran::make_scope_exit([this]() { compile_filters(); });
   switch (tft->tft_op_code) {
     case LIBLTE_MME_TFT_OPERATION_CODE_CREATE_NEW_TFT:
       for (int i = 0; i < tft->packet_filter_list_size; i++) {
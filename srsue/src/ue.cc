@@ -39,6 +39,65 @@ using namespace srsran;
 
 namespace srsue {
 
+/// Appends the UE index to a file name, before its extension
+static std::string ue_idx_filename(const std::string& filename, uint32_t idx)
+{
+  std::string            suffix = "_" + std::to_string(idx);
+  std::string::size_type dot    = filename.find_last_of('.');
+  std::string::size_type slash  = filename.find_last_of('/');
+  if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+    return filename + suffix;
+  }
+  return filename.substr(0, dot) + suffix + filename.substr(dot);
+}
+
+/// Adds the UE index to the digits [begin, end) of a decimal string. The carry never goes past begin, so the digits
+/// before are kept. Returns false when the digits overflow, as the identity would wrap onto the one of another UE
+static bool ue_idx_add_digits(std::string& digits, size_t begin, size_t end, uint32_t idx)
+{
+  uint32_t carry = idx;
+  for (size_t i = end; i > begin && carry > 0; i--) {
+    if (not isdigit(digits[i - 1])) {
+      return false;
+    }
+    uint32_t d    = (uint32_t)(digits[i - 1] - '0') + carry;
+    digits[i - 1] = (char)('0' + d % 10);
+    carry         = d / 10;
+  }
+  return carry == 0;
+}
+
+/// Gives every emulated UE its own IMSI. The index is only added to the MSIN, which starts at most after a 3 digit
+/// MCC and a 3 digit MNC
+static bool ue_idx_imsi(std::string& imsi, uint32_t idx)
+{
+  const size_t mcc_mnc_len = 6;
+  if (imsi.size() <= mcc_mnc_len) {
+    return false;
+  }
+  return ue_idx_add_digits(imsi, mcc_mnc_len, imsi.size(), idx);
+}
+
+/// Gives every emulated UE its own IMEI. The index is added to the serial number, after the 8 digit TAC, and the Luhn
+/// check digit is computed again (TS 23.003 Annex B)
+static bool ue_idx_imei(std::string& imei, uint32_t idx)
+{
+  const size_t tac_len  = 8;
+  const size_t imei_len = 15;
+  if (imei.size() != imei_len || not ue_idx_add_digits(imei, tac_len, imei_len - 1, idx)) {
+    return false;
+  }
+
+  // Every second digit, starting from the one before the check digit, is doubled and its digits are added
+  uint32_t sum = 0;
+  for (size_t i = 0; i < imei_len - 1; i++) {
+    uint32_t d = (uint32_t)(imei[i] - '0') * ((i % 2 == 1) ? 2 : 1);
+    sum += d / 10 + d % 10;
+  }
+  imei[imei_len - 1] = (char)('0' + (10 - sum % 10) % 10);
+  return true;
+}
+
 ue::ue() : logger(srslog::fetch_basic_logger("UE", false)), sys_proc(logger)
 {
   // print build info
@@ -50,9 +109,10 @@ ue::~ue()
   stack.reset();
 }
 
-int ue::init(const all_args_t& args_)
+int ue::init(const all_args_t& args_, multi_ue_front_end* front_end_, uint32_t ue_idx_)
 {
   int ret = SRSRAN_SUCCESS;
+  ue_idx  = ue_idx_;
 
   // Init UE log
   logger.set_level(srslog::basic_levels::info);
@@ -77,9 +137,16 @@ int ue::init(const all_args_t& args_)
     return SRSRAN_ERROR;
   }
 
-  std::unique_ptr<srsran::radio> lte_radio = std::unique_ptr<srsran::radio>(new srsran::radio);
-  if (!lte_radio) {
-    srsran::console("Error creating radio multi instance.\n");
+  // Emulated UEs other than the first one use the radio of the first through the shared front end
+  std::unique_ptr<srsran::radio> lte_radio;
+  if (ue_idx == 0) {
+    lte_radio = std::unique_ptr<srsran::radio>(new srsran::radio);
+    if (!lte_radio) {
+      srsran::console("Error creating radio multi instance.\n");
+      return SRSRAN_ERROR;
+    }
+  } else if (front_end_ == nullptr) {
+    srsran::console("Error: emulated UE %d requires the front end of the first UE.\n", ue_idx);
     return SRSRAN_ERROR;
   }
 
@@ -134,17 +201,34 @@ int ue::init(const all_args_t& args_)
       return SRSRAN_ERROR;
     }
 
-    if (lte_radio->init(args.rf, lte_phy.get())) {
+    if (lte_radio != nullptr && lte_radio->init(args.rf, lte_phy.get())) {
       srsran::console("Error initializing radio.\n");
       return SRSRAN_ERROR;
     }
+
+    // Share the radio, synchronization and OFDM demodulation if several UEs are emulated
+    srsran::radio_interface_phy* phy_radio = lte_radio.get();
+    if (args.general.nof_ues > 1) {
+      if (ue_idx == 0) {
+        front_end = std::unique_ptr<multi_ue_front_end>(new multi_ue_front_end(srslog::fetch_basic_logger("PHY")));
+        uint32_t nof_rf_channels = args.rf.nof_carriers * args.rf.nof_antennas;
+        if (front_end->init(lte_radio.get(), args.general.nof_ues, nof_rf_channels, args.rf.nof_antennas)) {
+          srsran::console("Error initializing multi-UE front end.\n");
+          return SRSRAN_ERROR;
+        }
+        front_end_ = front_end.get();
+      }
+      lte_phy->set_front_end(front_end_, ue_idx);
+      phy_radio = front_end_->get_port(ue_idx);
+    }
+
     // from here onwards do not exit immediately if something goes wrong as sub-layers may already use interfaces
-    if (lte_phy->init(args.phy, lte_stack.get(), lte_radio.get())) {
+    if (lte_phy->init(args.phy, lte_stack.get(), phy_radio)) {
       srsran::console("Error initializing PHY.\n");
       ret = SRSRAN_ERROR;
     }
     if (args.phy.nof_nr_carriers > 0) {
-      if (lte_phy->init(phy_args_nr, lte_stack.get(), lte_radio.get())) {
+      if (lte_phy->init(phy_args_nr, lte_stack.get(), phy_radio)) {
         srsran::console("Error initializing NR PHY.\n");
         ret = SRSRAN_ERROR;
       }
@@ -293,6 +377,37 @@ int ue::parse_args(const all_args_t& args_)
     args.stack.nas_5g.pdu_session_cfgs.push_back({args.stack.nas.apn_name});
   }
 
+  // Several UEs emulated in the process share the LTE primary cell of the first one
+  if (args.general.nof_ues > 1) {
+    if (args.phy.nof_lte_carriers != 1 || args.phy.nof_nr_carriers > 0) {
+      srsran::console("Error. Emulating several UEs requires a single LTE carrier and no NR carriers.\n");
+      return SRSRAN_ERROR;
+    }
+    if (args.stack.usim.mode != "soft") {
+      srsran::console("Error. Emulating several UEs requires the soft USIM.\n");
+      return SRSRAN_ERROR;
+    }
+
+    // Every emulated UE gets its own identity, network interface and captures
+    if (ue_idx > 0) {
+      if (not ue_idx_imsi(args.stack.usim.imsi, ue_idx)) {
+        srsran::console(
+            "Error. The MSIN of IMSI %s has no room for emulated UE %d.\n", args_.stack.usim.imsi.c_str(), ue_idx);
+        return SRSRAN_ERROR;
+      }
+      if (not ue_idx_imei(args.stack.usim.imei, ue_idx)) {
+        srsran::console("Error. The serial number of IMEI %s has no room for emulated UE %d.\n",
+                        args_.stack.usim.imei.c_str(),
+                        ue_idx);
+        return SRSRAN_ERROR;
+      }
+      args.gw.tun_dev_name                      = args.gw.tun_dev_name + "_" + std::to_string(ue_idx);
+      args.stack.pkt_trace.mac_pcap.filename    = ue_idx_filename(args.stack.pkt_trace.mac_pcap.filename, ue_idx);
+      args.stack.pkt_trace.nas_pcap.filename    = ue_idx_filename(args.stack.pkt_trace.nas_pcap.filename, ue_idx);
+      args.stack.pkt_trace.mac_nr_pcap.filename = ue_idx_filename(args.stack.pkt_trace.mac_nr_pcap.filename, ue_idx);
+    }
+  }
+
   // Validate the CFR args
   srsran_cfr_cfg_t cfr_test_cfg = {};
   cfr_test_cfg.cfr_enable       = args.phy.cfr_args.enable;
@@ -338,6 +453,11 @@ void ue::stop()
     phy->stop();
   }
 
+  // The emulated UEs must have been stopped before the one owning the front end
+  if (front_end) {
+    front_end->stop();
+  }
+
   if (radio) {
     radio->stop();
   }
@@ -385,7 +505,9 @@ bool ue::get_metrics(ue_metrics_t* m)
   *m = {};
   phy->get_metrics(srsran::srsran_rat_t::lte, &m->phy);
   phy->get_metrics(srsran::srsran_rat_t::nr, &m->phy_nr);
-  radio->get_metrics(&m->rf);
+  if (radio) {
+    radio->get_metrics(&m->rf);
+  }
   stack->get_metrics(&m->stack);
   gw_inst->get_metrics(m->gw, m->stack.mac[0].nof_tti);
   m->sys = sys_proc.get_metrics();
@@ -30,6 +30,7 @@
 #include "srsgnb/hdr/stack/mac/sched_nr.h"
 #include "srsgnb/src/stack/mac/test/sched_nr_cfg_generators.h"
 #include "srsran/srslog/srslog.h"
+#include <memory>
 #include <mutex>
 #include <set>
 #include <srsenb/hdr/stack/mac/common/mac_metrics.h>
@@ -86,6 +87,7 @@ private:
     uint32_t                                                             freq_res     = 0;
     std::set<uint32_t>                                                   slots        = {};
   } dl, ul;
+  std::vector<uint32_t>                                   extra_pdsch_freq_res; ///< Other UEs PDSCH resources
   srsran::circular_array<uint32_t, SRSRAN_NOF_SF_X_FRAME> dl_data_to_ul_ack;
   uint32_t                                                ss_id   = 0;
   srsran::phy_cfg_nr_t                                    phy_cfg = {};
@@ -172,8 +174,9 @@ private:
   };
   std::array<pending_pusch_t, TTIMOD_SZ> pending_pusch = {};
 
-  dummy_tx_harq_entity tx_harq_proc;
-  dummy_rx_harq_entity rx_harq_proc;
+  dummy_tx_harq_entity                               tx_harq_proc;
+  dummy_rx_harq_entity                               rx_harq_proc;
+  std::vector<std::unique_ptr<dummy_tx_harq_entity>> extra_tx_harq_proc;
 
   bool schedule_pdsch(const srsran_slot_cfg_t& slot_cfg, dl_sched_t& dl_sched)
   {
@@ -238,6 +241,28 @@ private:
     dl_sched.pdcch_dl.push_back(pdcch);
     dl_sched.pdsch.push_back(pdsch);
 
+    // Schedule PDSCH for other UEs next to the UE PDSCH. They have no PDCCH, so the UE never decodes them, but the gNb
+    // encodes all of them in the same slot
+    for (uint32_t i = 0; i < extra_pdsch_freq_res.size(); i++) {
+      srsran_dci_dl_nr_t extra_dci    = dci;
+      extra_dci.ctx.rnti              = rnti + 1 + i;
+      extra_dci.freq_domain_assigment = extra_pdsch_freq_res[i];
+
+      pdsch_t extra_pdsch = {};
+      if (not phy_cfg.get_pdsch_cfg(slot_cfg, extra_dci, extra_pdsch.sch)) {
+        logger.error("Error converting DCI to grant");
+        return false;
+      }
+
+      dummy_tx_harq_proc& harq_proc             = (*extra_tx_harq_proc[i])[slot_cfg.idx];
+      extra_pdsch.data[0]                       = harq_proc.get_tb(extra_pdsch.sch.grant.tb[0].tbs);
+      extra_pdsch.data[1]                       = nullptr;
+      extra_pdsch.sch.grant.tb[0].softbuffer.tx = &harq_proc.get_softbuffer(dci.ndi);
+      srsran_softbuffer_tx_reset(extra_pdsch.sch.grant.tb[0].softbuffer.tx);
+
+      dl_sched.pdsch.push_back(extra_pdsch);
+    }
+
     // Generate PDSCH HARQ Feedback
     srsran_harq_ack_resource_t ack_resource = {};
     if (not phy_cfg.get_pdsch_ack_resource(dci, ack_resource)) {
@@ -352,6 +377,7 @@ public:
     uint32_t pdcch_aggregation_level = 0;      ///< PDCCH aggregation level
     uint32_t pdcch_dl_candidate      = 0;      ///< PDCCH DL DCI candidate index
     uint32_t pdcch_ul_candidate      = 1;      ///< PDCCH UL DCI candidate index
+    uint32_t nof_extra_pdsch         = 0;      ///< Number of PDSCH for other UEs, placed after the UE PDSCH
     struct {
       uint32_t    rb_start  = 0;  ///< Start frequency domain resource block
       uint32_t    rb_length = 10; ///< Number of frequency domain resource blocks
@@ -442,6 +468,24 @@ public:
     // Select DL frequency domain resources
     dl.freq_res = srsran_ra_nr_type1_riv(args.phy_cfg.carrier.nof_prb, args.pdsch.rb_start, args.pdsch.rb_length);
 
+    // Select the other UEs DL frequency domain resources, each one with the same length as the UE PDSCH
+    if (args.nof_extra_pdsch >= (uint32_t)mac_interface_phy_nr::MAX_GRANTS) {
+      logger.error("The number of extra PDSCH (%d) exceeds the maximum (%d)",
+                   args.nof_extra_pdsch,
+                   mac_interface_phy_nr::MAX_GRANTS - 1);
+      return;
+    }
+    for (uint32_t i = 0; i < args.nof_extra_pdsch; i++) {
+      uint32_t rb_start = args.pdsch.rb_start + (i + 1) * args.pdsch.rb_length;
+      if (rb_start + args.pdsch.rb_length > args.phy_cfg.carrier.nof_prb) {
+        logger.error("Extra PDSCH %d does not fit in the carrier", i);
+        return;
+      }
+      extra_pdsch_freq_res.push_back(
+          srsran_ra_nr_type1_riv(args.phy_cfg.carrier.nof_prb, rb_start, args.pdsch.rb_length));
+      extra_tx_harq_proc.emplace_back(new dummy_tx_harq_entity);
+    }
+
     // Select DL frequency domain resources
     ul.freq_res = srsran_ra_nr_type1_riv(args.phy_cfg.carrier.nof_prb, args.pusch.rb_start, args.pusch.rb_length);
 
@@ -79,6 +79,7 @@ test_bench::args_t::args_t(int argc, char** argv)
         ("gnb.stack.pdsch.length",            bpo::value<uint32_t>(&gnb_stack.pdsch.rb_length)->default_value(gnb_stack.pdsch.rb_length),                 "PDSCH scheduling frequency allocation length")
         ("gnb.stack.pdsch.slots",             bpo::value<std::string>(&gnb_stack.pdsch.slots)->default_value(gnb_stack.pdsch.slots),                      "Slots enabled for PDSCH")
         ("gnb.stack.pdsch.mcs",               bpo::value<uint32_t>(&gnb_stack.pdsch.mcs)->default_value(gnb_stack.pdsch.mcs),                             "PDSCH scheduling modulation code scheme")
+        ("gnb.stack.pdsch.nof_extra",         bpo::value<uint32_t>(&gnb_stack.nof_extra_pdsch)->default_value(gnb_stack.nof_extra_pdsch),                 "Number of PDSCH for other UEs, placed after the UE PDSCH")
         ("gnb.stack.pusch.candidate",         bpo::value<uint32_t>(&gnb_stack.pdcch_ul_candidate)->default_value(gnb_stack.pdcch_ul_candidate),           "PDCCH candidate index for PUSCH")
         ("gnb.stack.pusch.start",             bpo::value<uint32_t>(&gnb_stack.pusch.rb_start)->default_value(0),                                          "PUSCH scheduling frequency allocation start")
         ("gnb.stack.pusch.length",            bpo::value<uint32_t>(&gnb_stack.pusch.rb_length)->default_value(gnb_stack.pusch.rb_length),                 "PUSCH scheduling frequency allocation length")
@@ -89,11 +90,12 @@ test_bench::args_t::args_t(int argc, char** argv)
         ;
 
   options_gnb_phy.add_options()
-        ("gnb.phy.nof_threads",     bpo::value<uint32_t>(&gnb_phy.nof_phy_threads)->default_value(1),          "Number of threads")
-        ("gnb.phy.log.level",       bpo::value<std::string>(&gnb_phy.log.phy_level)->default_value("warning"), "gNb PHY log level")
-        ("gnb.phy.log.hex_limit",   bpo::value<int>(&gnb_phy.log.phy_hex_limit)->default_value(0),             "gNb PHY log hex limit")
-        ("gnb.phy.log.id_preamble", bpo::value<std::string>(&gnb_phy.log.id_preamble)->default_value("GNB/"),  "gNb PHY log ID preamble")
-        ("gnb.phy.pusch.max_iter",  bpo::value<uint32_t>(&gnb_phy.pusch_max_its)->default_value(10),      "PUSCH LDPC max number of iterations")
+        ("gnb.phy.nof_threads",      bpo::value<uint32_t>(&gnb_phy.nof_phy_threads)->default_value(1),          "Number of threads")
+        ("gnb.phy.nof_slot_threads", bpo::value<uint32_t>(&gnb_phy.nof_slot_threads)->default_value(0),         "Number of threads processing UL and DL concurrently, 0 for sequential")
+        ("gnb.phy.log.level",        bpo::value<std::string>(&gnb_phy.log.phy_level)->default_value("warning"), "gNb PHY log level")
+        ("gnb.phy.log.hex_limit",    bpo::value<int>(&gnb_phy.log.phy_hex_limit)->default_value(0),             "gNb PHY log hex limit")
+        ("gnb.phy.log.id_preamble",  bpo::value<std::string>(&gnb_phy.log.id_preamble)->default_value("GNB/"),  "gNb PHY log ID preamble")
+        ("gnb.phy.pusch.max_iter",   bpo::value<uint32_t>(&gnb_phy.pusch_max_its)->default_value(10),      "PUSCH LDPC max number of iterations")
         ;
 
   options_ue_phy.add_options()
@@ -438,6 +440,14 @@ int main(int argc, char** argv)
   }
   srsran::console("   +------------+------------+------------+------------+------------+\n");
 
+  // Print gNb slot processing latency
+  if (metrics.gnb_phy.nof_slots > 0) {
+    srsran::console("gNb slot latency (%s): avg=%.1f us, max=%.1f us\n",
+                    args.gnb_phy.nof_slot_threads > 0 ? "concurrent UL/DL" : "sequential UL/DL",
+                    metrics.gnb_phy.avg_slot_latency_us,
+                    metrics.gnb_phy.max_slot_latency_us);
+  }
+
   // Assert metrics
   srsran_assert(metrics.gnb_stack.mac.tx_pkts == 0 or pdsch_bler <= assert_pdsch_bler_max,
                 "PDSCH BLER (%f) exceeds the assertion maximum (%f)",
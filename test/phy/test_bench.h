@@ -76,9 +76,10 @@ public:
   };
 
   struct metrics_t {
-    gnb_dummy_stack::metrics_t gnb_stack = {};
-    ue_dummy_stack::metrics_t  ue_stack  = {};
-    srsue::phy_metrics_t       ue_phy    = {};
+    gnb_dummy_stack::metrics_t         gnb_stack = {};
+    srsenb::nr::slot_worker::metrics_t gnb_phy   = {};
+    ue_dummy_stack::metrics_t          ue_stack  = {};
+    srsue::phy_metrics_t               ue_phy    = {};
   };
 
   test_bench(const args_t& args) :
@@ -267,6 +268,7 @@ public:
   {
     metrics_t metrics = {};
     metrics.gnb_stack = gnb_stack.get_metrics();
+    metrics.gnb_phy   = gnb_phy.get_metrics();
     metrics.ue_stack  = ue_stack.get_metrics();
     ue_phy.get_metrics(srsran::srsran_rat_t::nr, &metrics.ue_phy); // get the metrics from the ue_phy
     return metrics;